@@ -838,6 +838,13 @@ proc generate_lwip_opts {libhandle} {
 		}
 	}
 
+	# Gem zero-copy RX hands out custom pbufs
+	set rx_zero_copy [common::get_property CONFIG.gem_rx_zero_copy $libhandle]
+	if {$rx_zero_copy == true} {
+		puts $lwipopts_fd "\#define LWIP_SUPPORT_CUSTOM_PBUF 1"
+		puts $lwipopts_fd ""
+	}
+
 	# DHCP options
 	set lwip_dhcp 		[expr [common::get_property CONFIG.lwip_dhcp $libhandle] == true]
 	set dhcp_does_arp_check [expr [common::get_property CONFIG.dhcp_does_arp_check $libhandle] == true]
@@ -1506,6 +1513,19 @@ proc generate_adapterconfig_include {libhandle} {
 		puts $fd "\#define XLWIP_CONFIG_N_TX_COALESCE $ncoalesce"
 		set ncoalesce [common::get_property CONFIG.n_rx_coalesce $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_COALESCE $ncoalesce"
+		set rx_polling [common::get_property CONFIG.axieth_rx_polling $libhandle]
+		# RX polling is done by the AXI DMA instances only, the
+		# adapter is built for one of AXI DMA, FIFO or MCDMA
+		if {$rx_polling == true && $have_axi_ethernet_dma == 1 && \
+			$have_axi_ethernet_fifo == 0 && $have_axi_ethernet_mcdma == 0} {
+			set budget [common::get_property CONFIG.n_rx_poll_budget $libhandle]
+			if {$budget < 1} {
+				puts "WARNING: n_rx_poll_budget must be at least 1, using 1 \n"
+				set budget 1
+			}
+			puts $fd "\#define XLWIP_CONFIG_AXIETH_RX_POLLING 1"
+			puts $fd "\#define XLWIP_CONFIG_N_RX_POLL_BUDGET $budget"
+		}
 		puts $fd ""
 	}
 	if {$have_ps_ethernet == 1} {
@@ -1515,6 +1535,24 @@ proc generate_adapterconfig_include {libhandle} {
 		puts $fd "\#define XLWIP_CONFIG_N_TX_DESC $ndesc"
 		set ndesc [common::get_property CONFIG.n_rx_descriptors $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_DESC $ndesc"
+		set nrxbufs $ndesc
+		set rx_prio_queue [common::get_property CONFIG.gem_rx_prio_queue $libhandle]
+		if {$rx_prio_queue == true} {
+			set nprio [common::get_property CONFIG.n_rx_prio_descriptors $libhandle]
+			puts $fd "\#define XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE 1"
+			puts $fd "\#define XLWIP_CONFIG_N_RX_PRIO_DESC $nprio"
+			set nrxbufs [expr $ndesc + $nprio]
+		}
+		set rx_zero_copy [common::get_property CONFIG.gem_rx_zero_copy $libhandle]
+		if {$rx_zero_copy == true} {
+			set npool [common::get_property CONFIG.n_rx_pool_buffers $libhandle]
+			if {$npool < $nrxbufs} {
+				puts "WARNING: n_rx_pool_buffers is less than the RX descriptors, using $nrxbufs RX pool buffers \n"
+				set npool $nrxbufs
+			}
+			puts $fd "\#define XLWIP_CONFIG_EMACPS_RX_ZERO_COPY 1"
+			puts $fd "\#define XLWIP_CONFIG_N_RX_POOL $npool"
+		}
 		puts $fd ""
 	}
 
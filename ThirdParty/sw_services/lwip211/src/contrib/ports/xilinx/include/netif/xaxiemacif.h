@@ -78,6 +78,19 @@ unsigned phy_setup_axiemac (XAxiEthernet *xaxiemacp);
 /* xaxiemacif_hw.c */
 void 	xaxiemac_error_handler(XAxiEthernet * Temac);
 
+#ifdef XLWIP_CONFIG_AXIETH_RX_POLLING
+/* RX polling counters, interrupts per packet is irqs / packets */
+typedef struct {
+	u32_t irqs;		/* RX DMA interrupts which scheduled a poll */
+	u32_t packets;		/* frames passed to lwIP */
+	u32_t polls;		/* polls which found the ring scheduled */
+	u32_t budget_exhausted;	/* polls which stopped on the budget */
+	u32_t coalesce_changes;	/* updates of the RX coalescing settings */
+	u32_t coalesce_cnt;	/* current RX coalescing counter */
+	u32_t coalesce_timer;	/* current RX coalescing delay timer */
+} xaxiemacif_rx_stats;
+#endif
+
 /* structure within each netif, encapsulating all information required for
  * using a particular temac instance
  */
@@ -98,6 +111,16 @@ typedef struct {
 	/* pointers to memory holding buffer descriptors (used only with SDMA) */
 	void *rx_bdspace;
 	void *tx_bdspace;
+
+#ifdef XLWIP_CONFIG_AXIETH_RX_POLLING
+	/* frames are received by axidma_rx_poll() instead of recv_q */
+	u8_t rx_polling;
+	/* set by the RX interrupt, cleared when the poll drains the ring */
+	volatile u8_t rx_poll_pending;
+	/* frames received since the RX interrupt which scheduled the poll */
+	u32_t rx_round_packets;
+	xaxiemacif_rx_stats rx_stats;
+#endif
 } xaxiemacif_s;
 
 extern xaxiemacif_s xaxiemacif;
@@ -122,6 +145,16 @@ XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p);
 #endif
 #endif
 
+/* xaxiemacif_dma.c, RX polling of the AXI DMA instances */
+#ifdef XLWIP_CONFIG_AXIETH_RX_POLLING
+s32_t axidma_rx_poll(struct netif *netif, s32_t budget);
+void xaxiemacif_get_rx_stats(struct netif *netif, xaxiemacif_rx_stats *stats);
+void xaxiemacif_reset_rx_stats(struct netif *netif);
+#endif
+
+/* xaxiemacif.c */
+void xaxiemacif_input_frame(struct netif *netif, struct pbuf *p);
+
 #ifdef __cplusplus
 }
 #endif
@@ -104,6 +104,10 @@ void 	xemacpsif_setmac(u32_t index, u8_t *addr);
 u8_t*	xemacpsif_getmac(u32_t index);
 err_t 	xemacpsif_init(struct netif *netif);
 s32_t 	xemacpsif_input(struct netif *netif);
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+s32_t 	xemacpsif_prio_input(struct netif *netif);
+#endif
+XEmacPs *xemacpsif_get_emacps(struct netif *netif);
 
 /* xaxiemacif_hw.c */
 void 	xemacps_error_handler(XEmacPs * Temac);
@@ -117,6 +121,12 @@ typedef struct {
 	/* queue to store overflow packets */
 	pq_queue_t *recv_q;
 	pq_queue_t *send_q;
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+	/* queue to store packets received on priority queue 1 */
+	pq_queue_t *recv_prio_q;
+	/* set when the RX BD ring of priority queue 1 is in use */
+	u32_t rx_prio_enabled;
+#endif
 
 	/* pointers to memory holding buffer descriptors (used only with SDMA) */
 	void *rx_bdspace;
@@ -124,6 +134,10 @@ typedef struct {
 
 	unsigned int last_rx_frms_cntr;
 
+#ifdef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+	/* pool of RX buffers recycled to the RX BD ring */
+	void *rx_pool;
+#endif
 } xemacpsif_s;
 
 extern xemacpsif_s xemacpsif;
@@ -138,6 +152,9 @@ void detect_phy(XEmacPs *xemacpsp);
 void emacps_send_handler(void *arg);
 XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p);
 void emacps_recv_handler(void *arg);
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+void emacps_recv_prio_handler(void *arg);
+#endif
 void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord);
 void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring);
 void HandleTxErrors(struct xemac_s *xemac);
@@ -218,6 +218,51 @@ static err_t xaxiemacif_output(struct netif *netif, struct pbuf *p,
 	return etharp_output(netif, p, ipaddr);
 }
 
+/*
+ * xaxiemacif_input_frame():
+ *
+ * Passes a received frame to lwIP when it carries a protocol handled by
+ * the stack, and frees it otherwise.
+ *
+ */
+
+void xaxiemacif_input_frame(struct netif *netif, struct pbuf *p)
+{
+	struct eth_hdr *ethhdr;
+
+	/* points to packet payload, which starts with an Ethernet header */
+	ethhdr = p->payload;
+
+#if LINK_STATS
+	lwip_stats.link.recv++;
+#endif /* LINK_STATS */
+
+	switch (htons(ethhdr->type)) {
+		/* IP or ARP packet? */
+		case ETHTYPE_IP:
+		case ETHTYPE_ARP:
+#if LWIP_IPV6
+		/*IPv6 Packet?*/
+		case ETHTYPE_IPV6:
+#endif
+#if PPPOE_SUPPORT
+			/* PPPoE packet? */
+		case ETHTYPE_PPPOEDISC:
+		case ETHTYPE_PPPOE:
+#endif /* PPPOE_SUPPORT */
+			/* full packet send to tcpip_thread to process */
+			if (netif->input(p, netif) != ERR_OK) {
+				LWIP_DEBUGF(NETIF_DEBUG, ("xaxiemacif_input: IP input error\r\n"));
+				pbuf_free(p);
+			}
+			break;
+
+		default:
+			pbuf_free(p);
+			break;
+	}
+}
+
 /*
  * xaxiemacif_input():
  *
@@ -229,13 +274,23 @@ static err_t xaxiemacif_output(struct netif *netif, struct pbuf *p,
  * Returns the number of packets read (max 1 packet on success,
  * 0 if there are no packets)
  *
+ * With RX polling, the frames of AXI DMA instances are passed to lwIP
+ * directly from the RX BD ring, at most XLWIP_CONFIG_N_RX_POLL_BUDGET per
+ * call, and the number of frames is returned.
+ *
  */
 
 int xaxiemacif_input(struct netif *netif)
 {
-	struct eth_hdr *ethhdr;
 	struct pbuf *p;
 	SYS_ARCH_DECL_PROTECT(lev);
+#ifdef XLWIP_CONFIG_AXIETH_RX_POLLING
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+
+	if (xaxiemacif->rx_polling)
+		return axidma_rx_poll(netif, XLWIP_CONFIG_N_RX_POLL_BUDGET);
+#endif
 
 #if !NO_SYS
 	while (1)
@@ -250,39 +305,7 @@ int xaxiemacif_input(struct netif *netif)
 		if (p == NULL)
 			return 0;
 
-		/* points to packet payload, which starts with an Ethernet header */
-		ethhdr = p->payload;
-
-#if LINK_STATS
-		lwip_stats.link.recv++;
-#endif /* LINK_STATS */
-
-		switch (htons(ethhdr->type)) {
-			/* IP or ARP packet? */
-			case ETHTYPE_IP:
-			case ETHTYPE_ARP:
-#if LWIP_IPV6
-			/*IPv6 Packet?*/
-			case ETHTYPE_IPV6:
-#endif
-#if PPPOE_SUPPORT
-				/* PPPoE packet? */
-			case ETHTYPE_PPPOEDISC:
-			case ETHTYPE_PPPOE:
-#endif /* PPPOE_SUPPORT */
-				/* full packet send to tcpip_thread to process */
-				if (netif->input(p, netif) != ERR_OK) {
-					LWIP_DEBUGF(NETIF_DEBUG, ("xaxiemacif_input: IP input error\r\n"));
-					pbuf_free(p);
-					p = NULL;
-				}
-				break;
-
-			default:
-				pbuf_free(p);
-				p = NULL;
-				break;
-		}
+		xaxiemacif_input_frame(netif, p);
 	}
 	return 1;
 }
@@ -314,6 +337,10 @@ static err_t low_level_init(struct netif *netif)
 	xaxiemacif->recv_q = pq_create_queue();
 	if (!xaxiemacif->recv_q)
 		return ERR_MEM;
+#ifdef XLWIP_CONFIG_AXIETH_RX_POLLING
+	/* set by init_axi_dma(), FIFO and MCDMA instances use recv_q */
+	xaxiemacif->rx_polling = 0;
+#endif
 
 	/* maximum transfer unit */
 #ifdef USE_JUMBO_FRAMES
@@ -83,6 +83,19 @@
 /* Byte alignment of BDs */
 #define BD_ALIGNMENT (XAXIDMA_BD_MINIMUM_ALIGNMENT*2)
 
+#ifdef XLWIP_CONFIG_AXIETH_RX_POLLING
+/* Bounds of the RX coalescing counter adapted by the polls. The counter
+ * stays below half of the RX BDs, so that the ring is refilled before it
+ * runs empty.
+ */
+#define RX_COALESCE_MIN		XLWIP_CONFIG_N_RX_COALESCE
+#if (XLWIP_CONFIG_N_RX_DESC / 2) < 0xFF
+#define RX_COALESCE_MAX		(XLWIP_CONFIG_N_RX_DESC / 2)
+#else
+#define RX_COALESCE_MAX		0xFF
+#endif
+#endif
+
 #if XPAR_INTC_0_HAS_FAST == 1
 /*********** Function Prototypes *********************************************/
 /*
@@ -366,9 +379,7 @@ static void setup_rx_bds(XAxiDma_BdRing *rxring)
 
 static void axidma_recv_handler(void *arg)
 {
-	struct pbuf *p;
-	u32 irq_status, i, timeOut;
-	XAxiDma_Bd *rxbd, *rxbdset;
+	u32 irq_status, timeOut;
 	struct xemac_s *xemac;
 	xaxiemacif_s *xaxiemacif;
 	XAxiDma_BdRing *rxring;
@@ -416,7 +427,23 @@ static void axidma_recv_handler(void *arg)
 	 * to handle the processed BDs and then raise the according flag.
 	 */
 	if (irq_status & (XAXIDMA_IRQ_DELAY_MASK | XAXIDMA_IRQ_IOC_MASK)) {
-		u32 bd_processed;
+#ifdef XLWIP_CONFIG_AXIETH_RX_POLLING
+		/* The frames are processed by axidma_rx_poll(), which enables
+		 * the RX interrupts again once it has drained the ring.
+		 */
+		xaxiemacif->rx_stats.irqs++;
+		xaxiemacif->rx_poll_pending = 1;
+#if !NO_SYS
+		sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
+#ifdef OS_IS_FREERTOS
+		xInsideISR--;
+#endif
+		return;
+#else
+		struct pbuf *p;
+		XAxiDma_Bd *rxbd, *rxbdset;
+		u32 bd_processed, i;
 		u32 rx_bytes;
 
 		bd_processed = XAxiDma_BdRingFromHw(rxring, XAXIDMA_ALL_BDS, &rxbdset);
@@ -463,6 +490,7 @@ static void axidma_recv_handler(void *arg)
 		setup_rx_bds(rxring);
 #if !NO_SYS
 		sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
 #endif
 	}
 	XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
@@ -472,6 +500,148 @@ static void axidma_recv_handler(void *arg)
 
 }
 
+#ifdef XLWIP_CONFIG_AXIETH_RX_POLLING
+/*
+ * Adapts the RX coalescing to the frames received since the interrupt
+ * which scheduled the poll. The counter is doubled when at least twice as
+ * many frames arrived, and halved when less than half of them arrived,
+ * which means that the delay timer raised the interrupt. The delay timer
+ * follows the counter, to bound the latency of the last frames of a burst.
+ */
+static void rx_adapt_coalesce(xaxiemacif_s *xaxiemacif,
+		XAxiDma_BdRing *rxring)
+{
+	u32 cnt = xaxiemacif->rx_stats.coalesce_cnt;
+	u32 packets = xaxiemacif->rx_round_packets;
+
+	if ((packets >= (2 * cnt)) && (cnt < RX_COALESCE_MAX)) {
+		cnt = ((2 * cnt) < RX_COALESCE_MAX) ? (2 * cnt) : RX_COALESCE_MAX;
+	} else if (((2 * packets) < cnt) && (cnt > RX_COALESCE_MIN)) {
+		cnt = ((cnt / 2) > RX_COALESCE_MIN) ? (cnt / 2) : RX_COALESCE_MIN;
+	} else {
+		return;
+	}
+
+	if (XAxiDma_BdRingSetCoalesce(rxring, cnt, cnt) != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting coalescing settings\r\n"));
+		return;
+	}
+	xaxiemacif->rx_stats.coalesce_cnt = cnt;
+	xaxiemacif->rx_stats.coalesce_timer = cnt;
+	xaxiemacif->rx_stats.coalesce_changes++;
+}
+
+/*
+ * axidma_rx_poll():
+ *
+ * Passes at most budget received frames from the RX BD ring to lwIP and
+ * refills the ring. Does nothing until the RX interrupt has scheduled a
+ * poll. When the ring is drained within the budget, the RX coalescing is
+ * adapted and the RX interrupts are enabled again. Otherwise they stay
+ * disabled and the next call continues, the receive thread being woken
+ * up again when lwIP runs with an OS.
+ *
+ * Returns the number of frames received.
+ */
+s32_t axidma_rx_poll(struct netif *netif, s32_t budget)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	XAxiDma_BdRing *rxring = XAxiDma_GetRxRing(&xaxiemacif->axidma);
+	XAxiDma_Bd *rxbd, *rxbdset;
+	struct pbuf *p;
+	s32_t n_packets = 0;
+	u32 bd_processed, i;
+	u32 rx_bytes;
+
+	if (!xaxiemacif->rx_poll_pending)
+		return 0;
+
+	/* Frames completed from now on raise the interrupt again once it is
+	 * enabled, the ones completed before are received below.
+	 */
+	XAxiDma_BdRingAckIrq(rxring, XAXIDMA_IRQ_IOC_MASK |
+				XAXIDMA_IRQ_DELAY_MASK);
+
+	xaxiemacif->rx_stats.polls++;
+	while (n_packets < budget) {
+		bd_processed = XAxiDma_BdRingFromHw(rxring, budget - n_packets,
+						&rxbdset);
+		if (bd_processed == 0)
+			break;
+
+		for (i = 0, rxbd = rxbdset; i < bd_processed; i++) {
+			p = (struct pbuf *)(UINTPTR)XAxiDma_BdGetId(rxbd);
+			/* Adjust the buffer size to the actual number of bytes received.*/
+			rx_bytes = extract_packet_len(rxbd);
+			pbuf_realloc(p, rx_bytes);
+
+#ifdef USE_JUMBO_FRAMES
+#ifndef __aarch64__
+			XCACHE_INVALIDATE_DCACHE_RANGE(p->payload,
+							XAE_MAX_JUMBO_FRAME_SIZE);
+#endif
+#else
+#ifndef __aarch64__
+			XCACHE_INVALIDATE_DCACHE_RANGE(p->payload, XAE_MAX_FRAME_SIZE);
+#endif
+#endif
+
+#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
+			/* Verify for partial checksum offload case */
+			if (!is_checksum_valid(rxbd, p)) {
+				LWIP_DEBUGF(NETIF_DEBUG, ("Incorrect csum as calculated by the hw\r\n"));
+			}
+#endif
+			xaxiemacif_input_frame(netif, p);
+			rxbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(rxring, rxbd);
+		}
+		/* free up the BD's and return them to the hardware */
+		XAxiDma_BdRingFree(rxring, bd_processed, rxbdset);
+		setup_rx_bds(rxring);
+		n_packets += bd_processed;
+	}
+
+	xaxiemacif->rx_stats.packets += n_packets;
+	xaxiemacif->rx_round_packets += n_packets;
+
+	if (n_packets >= budget) {
+		xaxiemacif->rx_stats.budget_exhausted++;
+#if !NO_SYS
+		sys_sem_signal(&xemac->sem_rx_data_available);
+#endif
+		return n_packets;
+	}
+
+	rx_adapt_coalesce(xaxiemacif, rxring);
+	xaxiemacif->rx_round_packets = 0;
+	xaxiemacif->rx_poll_pending = 0;
+	XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
+
+	return n_packets;
+}
+
+void xaxiemacif_get_rx_stats(struct netif *netif, xaxiemacif_rx_stats *stats)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+
+	*stats = xaxiemacif->rx_stats;
+}
+
+void xaxiemacif_reset_rx_stats(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+
+	xaxiemacif->rx_stats.irqs = 0;
+	xaxiemacif->rx_stats.packets = 0;
+	xaxiemacif->rx_stats.polls = 0;
+	xaxiemacif->rx_stats.budget_exhausted = 0;
+	xaxiemacif->rx_stats.coalesce_changes = 0;
+}
+#endif
+
 s32_t is_tx_space_available(xaxiemacif_s *emac)
 {
 	XAxiDma_BdRing *txring;
@@ -775,6 +945,18 @@ XStatus init_axi_dma(struct xemac_s *xemac)
 		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting coalescing settings\r\n"));
 		return ERR_IF;
 	}
+#ifdef XLWIP_CONFIG_AXIETH_RX_POLLING
+	xaxiemacif->rx_stats.irqs = 0;
+	xaxiemacif->rx_stats.packets = 0;
+	xaxiemacif->rx_stats.polls = 0;
+	xaxiemacif->rx_stats.budget_exhausted = 0;
+	xaxiemacif->rx_stats.coalesce_changes = 0;
+	xaxiemacif->rx_stats.coalesce_cnt = XLWIP_CONFIG_N_RX_COALESCE;
+	xaxiemacif->rx_stats.coalesce_timer = 0x1;
+	xaxiemacif->rx_round_packets = 0;
+	xaxiemacif->rx_poll_pending = 0;
+	xaxiemacif->rx_polling = 1;
+#endif
 	/* start DMA */
 	status = XAxiDma_BdRingStart(txringptr);
 	if (status != XST_SUCCESS) {
@@ -168,6 +168,12 @@ static struct pbuf * low_level_input(struct netif *netif)
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 	struct pbuf *p;
 
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+	/* frames steered to the priority queue are processed first */
+	if (pq_qlength(xemacpsif->recv_prio_q) != 0)
+		return (struct pbuf *)pq_dequeue(xemacpsif->recv_prio_q);
+#endif
+
 	/* see if there is data to process */
 	if (pq_qlength(xemacpsif->recv_q) == 0)
 		return NULL;
@@ -193,6 +199,51 @@ static err_t xemacpsif_output(struct netif *netif, struct pbuf *p,
 	return etharp_output(netif, p, ipaddr);
 }
 
+/*
+ * xemacpsif_input_frame():
+ *
+ * Passes a received frame to the TCP/IP stack, or drops it if the stack
+ * does not handle its type.
+ *
+ */
+
+static void xemacpsif_input_frame(struct netif *netif, struct pbuf *p)
+{
+	struct eth_hdr *ethhdr;
+
+	/* points to packet payload, which starts with an Ethernet header */
+	ethhdr = p->payload;
+
+#if LINK_STATS
+	lwip_stats.link.recv++;
+#endif /* LINK_STATS */
+
+	switch (htons(ethhdr->type)) {
+		/* IP or ARP packet? */
+		case ETHTYPE_IP:
+		case ETHTYPE_ARP:
+#if LWIP_IPV6
+		/*IPv6 Packet?*/
+		case ETHTYPE_IPV6:
+#endif
+#if PPPOE_SUPPORT
+			/* PPPoE packet? */
+		case ETHTYPE_PPPOEDISC:
+		case ETHTYPE_PPPOE:
+#endif /* PPPOE_SUPPORT */
+			/* full packet send to tcpip_thread to process */
+			if (netif->input(p, netif) != ERR_OK) {
+				LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
+				pbuf_free(p);
+			}
+			break;
+
+		default:
+			pbuf_free(p);
+			break;
+	}
+}
+
 /*
  * xemacpsif_input():
  *
@@ -208,7 +259,6 @@ static err_t xemacpsif_output(struct netif *netif, struct pbuf *p,
 
 s32_t xemacpsif_input(struct netif *netif)
 {
-	struct eth_hdr *ethhdr;
 	struct pbuf *p;
 	SYS_ARCH_DECL_PROTECT(lev);
 
@@ -226,43 +276,66 @@ s32_t xemacpsif_input(struct netif *netif)
 			return 0;
 		}
 
-		/* points to packet payload, which starts with an Ethernet header */
-		ethhdr = p->payload;
-
-	#if LINK_STATS
-		lwip_stats.link.recv++;
-	#endif /* LINK_STATS */
-
-		switch (htons(ethhdr->type)) {
-			/* IP or ARP packet? */
-			case ETHTYPE_IP:
-			case ETHTYPE_ARP:
-	#if LWIP_IPV6
-			/*IPv6 Packet?*/
-			case ETHTYPE_IPV6:
-	#endif
-	#if PPPOE_SUPPORT
-				/* PPPoE packet? */
-			case ETHTYPE_PPPOEDISC:
-			case ETHTYPE_PPPOE:
-	#endif /* PPPOE_SUPPORT */
-				/* full packet send to tcpip_thread to process */
-				if (netif->input(p, netif) != ERR_OK) {
-					LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
-					pbuf_free(p);
-					p = NULL;
-				}
-				break;
-
-			default:
-				pbuf_free(p);
-				p = NULL;
-				break;
+		xemacpsif_input_frame(netif, p);
+	}
+
+	return 1;
+}
+
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+/*
+ * xemacpsif_prio_input():
+ *
+ * Same as xemacpsif_input(), for the packets received on priority queue 1
+ * only. It lets a separate task serve the flows the Gem screeners steer to
+ * queue 1, while xemacpsif_input() keeps serving both queues.
+ *
+ * Returns the number of packets read (max 1 packet on success,
+ * 0 if there are no packets)
+ *
+ */
+
+s32_t xemacpsif_prio_input(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	struct pbuf *p;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+#ifdef OS_IS_FREERTOS
+	while (1)
+#endif
+	{
+		SYS_ARCH_PROTECT(lev);
+		p = (struct pbuf *)pq_dequeue(xemacpsif->recv_prio_q);
+		SYS_ARCH_UNPROTECT(lev);
+
+		if (p == NULL) {
+			return 0;
 		}
+
+		xemacpsif_input_frame(netif, p);
 	}
 
 	return 1;
 }
+#endif
+
+/*
+ * xemacpsif_get_emacps():
+ *
+ * Returns the Gem driver instance of the interface, for example to program
+ * the screeners which steer flows to the priority queue.
+ *
+ */
+
+XEmacPs *xemacpsif_get_emacps(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	return &xemacpsif->emacps;
+}
 
 
 #if defined(OS_IS_FREERTOS) && defined(__arm__) && !defined(ARMR5)
@@ -308,9 +381,17 @@ static err_t low_level_init(struct netif *netif)
 	xemac->type = xemac_type_emacps;
 
 	xemacpsif->send_q = NULL;
+#ifdef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+	xemacpsif->rx_pool = NULL;
+#endif
 	xemacpsif->recv_q = pq_create_queue();
 	if (!xemacpsif->recv_q)
 		return ERR_MEM;
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+	xemacpsif->recv_prio_q = pq_create_queue();
+	if (!xemacpsif->recv_prio_q)
+		return ERR_MEM;
+#endif
 
 	/* maximum transfer unit */
 #ifdef ZYNQMP_USE_JUMBO
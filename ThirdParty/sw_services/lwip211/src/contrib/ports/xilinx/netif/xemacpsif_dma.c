@@ -64,6 +64,9 @@
 /* A max of 4 different ethernet interfaces are supported */
 static UINTPTR tx_pbufs_storage[4*XLWIP_CONFIG_N_TX_DESC];
 static UINTPTR rx_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC];
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+static UINTPTR rx_prio_pbufs_storage[4*XLWIP_CONFIG_N_RX_PRIO_DESC];
+#endif
 
 static s32_t emac_intr_num;
 
@@ -123,6 +126,139 @@ long xInsideISR = 0;
 #define XEMACPS_BD_TO_INDEX(ringptr, bdptr)				\
 	(((UINTPTR)bdptr - (UINTPTR)(ringptr)->BaseBdAddr) / (ringptr)->Separation)
 
+#ifdef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+/******************************************************************************
+ * Zero-copy receive path.
+ *
+ * Each GEM instance owns a pool of XLWIP_CONFIG_N_RX_POOL receive buffers.
+ * A received frame is handed to lwIP as a custom pbuf that points into the
+ * buffer the hardware wrote. When lwIP frees the pbuf, the buffer goes back
+ * to the pool and, once enough RX BDs are free, straight back to the BD ring.
+ * The ring is refilled in batches with one BdRingAlloc/BdRingToHw per batch.
+ *
+ * The hardware never writes more than the received length, so only the part
+ * of a buffer the CPU can have touched (the last received frame) needs to be
+ * invalidated when the buffer is posted again.
+ ******************************************************************************/
+#ifdef ZYNQMP_USE_JUMBO
+#define RX_POOL_BUF_SIZE	XEMACPS_RX_BUF_SIZE_JUMBO
+#else
+#define RX_POOL_BUF_SIZE	XEMACPS_RX_BUF_SIZE
+#endif
+
+/* Refill the RX BD ring from the pool freeing path in batches of this size */
+#if XLWIP_CONFIG_N_RX_DESC < 16
+#define RX_REFILL_BATCH		XLWIP_CONFIG_N_RX_DESC
+#else
+#define RX_REFILL_BATCH		16
+#endif
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+#if XLWIP_CONFIG_N_RX_PRIO_DESC < 16
+#define RX_PRIO_REFILL_BATCH	XLWIP_CONFIG_N_RX_PRIO_DESC
+#else
+#define RX_PRIO_REFILL_BATCH	16
+#endif
+#endif
+
+typedef struct xemacps_rx_buf {
+	struct pbuf_custom pc;		/* must be the first member */
+	struct xemacps_rx_buf *next;	/* link in the free list */
+	xemacpsif_s *xemacpsif;		/* owner of the buffer */
+	u8_t *data;
+	u32_t dirty_len;		/* bytes the CPU may hold in the cache */
+} xemacps_rx_buf;
+
+typedef struct {
+	xemacps_rx_buf bufs[XLWIP_CONFIG_N_RX_POOL];
+	xemacps_rx_buf *free_list;
+	u32_t free_cnt;
+} xemacps_rx_pool;
+
+static xemacps_rx_pool rx_pools[XPAR_XEMACPS_NUM_INSTANCES];
+static u8_t rx_pool_data[XPAR_XEMACPS_NUM_INSTANCES][XLWIP_CONFIG_N_RX_POOL][RX_POOL_BUF_SIZE]
+	__attribute__ ((aligned (64)));
+static u32_t rx_pool_index = 0;
+
+/* Interrupts must be disabled by the caller */
+static inline void rx_pool_put(xemacps_rx_pool *pool, xemacps_rx_buf *buf)
+{
+	buf->next = pool->free_list;
+	pool->free_list = buf;
+	pool->free_cnt++;
+}
+
+/* Interrupts must be disabled by the caller */
+static inline xemacps_rx_buf *rx_pool_get(xemacps_rx_pool *pool)
+{
+	xemacps_rx_buf *buf = pool->free_list;
+
+	if (buf != NULL) {
+		pool->free_list = buf->next;
+		pool->free_cnt--;
+	}
+	return buf;
+}
+
+/*
+ * Called by lwIP when the last reference to a received pbuf is released.
+ * Returns the buffer to the pool and refills the RX BD ring when a batch of
+ * BDs is waiting for buffers.
+ */
+static void rx_pool_pbuf_free(struct pbuf *p)
+{
+	xemacps_rx_buf *buf = (xemacps_rx_buf *)p;
+	xemacpsif_s *xemacpsif = buf->xemacpsif;
+	XEmacPs_BdRing *rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
+	u32_t lev;
+
+	lev = mfcpsr();
+	mtcpsr(lev | 0x000000C0);
+	rx_pool_put((xemacps_rx_pool *)xemacpsif->rx_pool, buf);
+	if (XEmacPs_BdRingGetFreeCnt(rxring) >= RX_REFILL_BATCH) {
+		setup_rx_bds(xemacpsif, rxring);
+	}
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+	rxring = &XEmacPs_GetRxQRing(&xemacpsif->emacps, 1);
+	if ((xemacpsif->rx_prio_enabled != 0) &&
+			(XEmacPs_BdRingGetFreeCnt(rxring) >= RX_PRIO_REFILL_BATCH)) {
+		setup_rx_bds(xemacpsif, rxring);
+	}
+#endif
+	mtcpsr(lev);
+}
+
+static XStatus rx_pool_init(xemacpsif_s *xemacpsif)
+{
+	xemacps_rx_pool *pool;
+	xemacps_rx_buf *buf;
+	u32_t i;
+
+	/* The pool of an instance is kept across re-initialization */
+	if (xemacpsif->rx_pool != NULL) {
+		return XST_SUCCESS;
+	}
+	if (rx_pool_index >= XPAR_XEMACPS_NUM_INSTANCES) {
+		return XST_FAILURE;
+	}
+
+	pool = &rx_pools[rx_pool_index];
+	pool->free_list = NULL;
+	pool->free_cnt = 0;
+	for (i = 0; i < XLWIP_CONFIG_N_RX_POOL; i++) {
+		buf = &pool->bufs[i];
+		buf->pc.custom_free_function = rx_pool_pbuf_free;
+		buf->xemacpsif = xemacpsif;
+		buf->data = rx_pool_data[rx_pool_index][i];
+		buf->dirty_len = RX_POOL_BUF_SIZE;
+		rx_pool_put(pool, buf);
+	}
+	rx_pool_index++;
+	xemacpsif->rx_pool = pool;
+
+	return XST_SUCCESS;
+}
+#endif
+
 
 s32_t is_tx_space_available(xemacpsif_s *emac)
 {
@@ -191,6 +327,22 @@ u32_t get_base_index_rxpbufsstorage (xemacpsif_s *xemacpsif)
 	return index;
 }
 
+/* Returns the pbufs stored for the BDs of an RX ring, queue 0 or queue 1 */
+static inline
+UINTPTR *get_rx_pbufs_storage (xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
+{
+	u32_t index;
+
+	index = get_base_index_rxpbufsstorage (xemacpsif);
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+	if (rxring != &XEmacPs_GetRxRing(&xemacpsif->emacps)) {
+		index = (index / XLWIP_CONFIG_N_RX_DESC) * XLWIP_CONFIG_N_RX_PRIO_DESC;
+		return &rx_prio_pbufs_storage[index];
+	}
+#endif
+	return &rx_pbufs_storage[index];
+}
+
 void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 {
 	XEmacPs_Bd *txbdset;
@@ -365,6 +517,88 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 	return status;
 }
 
+#ifdef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
+{
+	xemacps_rx_pool *pool = (xemacps_rx_pool *)xemacpsif->rx_pool;
+	xemacps_rx_buf *buf;
+	XEmacPs_Bd *rxbdset, *rxbd;
+	XStatus status;
+	u32_t nbds, k;
+	u32_t bdindex;
+	u32 *temp;
+	UINTPTR *storage;
+	u32_t lev;
+
+	storage = get_rx_pbufs_storage (xemacpsif, rxring);
+
+	lev = mfcpsr();
+	mtcpsr(lev | 0x000000C0);
+
+	/* post as many buffers as there are free BDs, in one batch */
+	nbds = XEmacPs_BdRingGetFreeCnt (rxring);
+	if (nbds > pool->free_cnt) {
+#if LINK_STATS
+		if (pool->free_cnt == 0) {
+			lwip_stats.link.memerr++;
+		}
+#endif
+		nbds = pool->free_cnt;
+	}
+	if (nbds == 0) {
+		mtcpsr(lev);
+		return;
+	}
+
+	status = XEmacPs_BdRingAlloc(rxring, nbds, &rxbdset);
+	if (status != XST_SUCCESS) {
+		mtcpsr(lev);
+		LWIP_DEBUGF(NETIF_DEBUG, ("setup_rx_bds: Error allocating RxBD\r\n"));
+		return;
+	}
+
+	for (k = 0, rxbd = rxbdset; k < nbds; k++) {
+		buf = rx_pool_get(pool);
+
+		/* Drop the lines the CPU may have dirtied while lwIP held it */
+		if ((xemacpsif->emacps.Config.IsCacheCoherent == 0) &&
+				(buf->dirty_len != 0)) {
+			Xil_DCacheInvalidateRange((UINTPTR)buf->data,
+					(UINTPTR)buf->dirty_len);
+		}
+		buf->dirty_len = 0;
+
+		bdindex = XEMACPS_BD_TO_INDEX(rxring, rxbd);
+		temp = (u32 *)rxbd;
+		temp++;
+		/* Status field should be cleared first to avoid drops */
+		*temp = 0;
+		dsb();
+
+		/* Set high address when required */
+#ifdef __aarch64__
+		XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_HI_OFFSET,
+			(((UINTPTR)buf->data) & ULONG64_HI_MASK) >> 32U);
+#endif
+		/* Set address field; add WRAP bit on last descriptor  */
+		if (bdindex == (rxring->AllCnt - 1)) {
+			XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_OFFSET, ((UINTPTR)buf->data | XEMACPS_RXBUF_WRAP_MASK));
+		} else {
+			XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_OFFSET, (UINTPTR)buf->data);
+		}
+
+		storage[bdindex] = (UINTPTR)buf;
+		rxbd = XEmacPs_BdRingNext(rxring, rxbd);
+	}
+	dsb();
+
+	status = XEmacPs_BdRingToHw(rxring, nbds, rxbdset);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error committing RxBD to hardware\r\n"));
+	}
+	mtcpsr(lev);
+}
+#else
 void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 {
 	XEmacPs_Bd *rxbd;
@@ -373,9 +607,9 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 	u32_t freebds;
 	u32_t bdindex;
 	u32 *temp;
-	u32_t index;
+	UINTPTR *storage;
 
-	index = get_base_index_rxpbufsstorage (xemacpsif);
+	storage = get_rx_pbufs_storage (xemacpsif, rxring);
 
 	freebds = XEmacPs_BdRingGetFreeCnt (rxring);
 	while (freebds > 0) {
@@ -435,53 +669,41 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 			(((UINTPTR)p->payload) & ULONG64_HI_MASK) >> 32U);
 #endif
 		/* Set address field; add WRAP bit on last descriptor  */
-		if (bdindex == (XLWIP_CONFIG_N_RX_DESC - 1)) {
+		if (bdindex == (rxring->AllCnt - 1)) {
 			XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_OFFSET, ((UINTPTR)p->payload | XEMACPS_RXBUF_WRAP_MASK));
 		} else {
 			XEmacPs_BdWrite(rxbd, XEMACPS_BD_ADDR_OFFSET, (UINTPTR)p->payload);
 		}
 
-		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
+		storage[bdindex] = (UINTPTR)p;
 	}
 }
+#endif
 
-void emacps_recv_handler(void *arg)
+/*
+ * Moves the frames received on an RX BD ring to a receive queue, where they
+ * are processed by xemacpsif_input(), and posts new buffers on the ring.
+ */
+static void process_recv_bds(struct xemac_s *xemac, XEmacPs_BdRing *rxring,
+		pq_queue_t *recv_q)
 {
 	struct pbuf *p;
+#ifdef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+	xemacps_rx_buf *buf;
+#endif
 	XEmacPs_Bd *rxbdset, *curbdptr;
-	struct xemac_s *xemac;
 	xemacpsif_s *xemacpsif;
-	XEmacPs_BdRing *rxring;
 	volatile s32_t bd_processed;
 	s32_t rx_bytes, k;
 	u32_t bdindex;
-	u32_t regval;
-	u32_t index;
-	u32_t gigeversion;
+	UINTPTR *storage;
 
-	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
-
-#ifdef OS_IS_FREERTOS
-	xInsideISR++;
-#endif
-
-	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
-	index = get_base_index_rxpbufsstorage (xemacpsif);
-	/*
-	 * If Reception done interrupt is asserted, call RX call back function
-	 * to handle the processed BDs and then raise the according flag.
-	 */
-	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET);
-	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET, regval);
-	if (gigeversion <= 2) {
-			resetrx_on_no_rxdata(xemacpsif);
-	}
+	storage = get_rx_pbufs_storage (xemacpsif, rxring);
 
 	while(1) {
 
-		bd_processed = XEmacPs_BdRingFromHwRx(rxring, XLWIP_CONFIG_N_RX_DESC, &rxbdset);
+		bd_processed = XEmacPs_BdRingFromHwRx(rxring, rxring->AllCnt, &rxbdset);
 		if (bd_processed <= 0) {
 			break;
 		}
@@ -489,7 +711,9 @@ void emacps_recv_handler(void *arg)
 		for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
 
 			bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
-			p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
+#ifndef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+			p = (struct pbuf *)storage[bdindex];
+#endif
 
 			/*
 			 * Adjust the buffer size to the actual number of bytes received.
@@ -499,7 +723,15 @@ void emacps_recv_handler(void *arg)
 #else
 			rx_bytes = XEmacPs_BdGetLength(curbdptr);
 #endif
+#ifdef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+			buf = (xemacps_rx_buf *)storage[bdindex];
+			storage[bdindex] = 0;
+			buf->dirty_len = rx_bytes;
+			p = pbuf_alloced_custom(PBUF_RAW, rx_bytes, PBUF_REF,
+					&buf->pc, buf->data, RX_POOL_BUF_SIZE);
+#else
 			pbuf_realloc(p, rx_bytes);
+#endif
 
 			/* Invalidate RX frame before queuing to handle
 			 * L1 cache prefetch conditions on any architecture.
@@ -509,12 +741,17 @@ void emacps_recv_handler(void *arg)
 			/* store it in the receive queue,
 			 * where it'll be processed by a different handler
 			 */
-			if (pq_enqueue(xemacpsif->recv_q, (void*)p) < 0) {
+			if (pq_enqueue(recv_q, (void*)p) < 0) {
 #if LINK_STATS
 				lwip_stats.link.memerr++;
 				lwip_stats.link.drop++;
 #endif
+#ifdef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+				/* the ring is refilled below */
+				rx_pool_put((xemacps_rx_pool *)xemacpsif->rx_pool, buf);
+#else
 				pbuf_free(p);
+#endif
 			}
 			curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
 		}
@@ -525,6 +762,35 @@ void emacps_recv_handler(void *arg)
 		sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
 	}
+}
+
+void emacps_recv_handler(void *arg)
+{
+	struct xemac_s *xemac;
+	xemacpsif_s *xemacpsif;
+	u32_t regval;
+	u32_t gigeversion;
+
+	xemac = (struct xemac_s *)(arg);
+	xemacpsif = (xemacpsif_s *)(xemac->state);
+
+#ifdef OS_IS_FREERTOS
+	xInsideISR++;
+#endif
+
+	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
+	/*
+	 * If Reception done interrupt is asserted, call RX call back function
+	 * to handle the processed BDs and then raise the according flag.
+	 */
+	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET);
+	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET, regval);
+	if (gigeversion <= 2) {
+			resetrx_on_no_rxdata(xemacpsif);
+	}
+
+	process_recv_bds(xemac, &XEmacPs_GetRxRing(&xemacpsif->emacps),
+			xemacpsif->recv_q);
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
@@ -532,6 +798,66 @@ void emacps_recv_handler(void *arg)
 	return;
 }
 
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+/*
+ * Called for the frames received on priority queue 1, the status of the
+ * queue is cleared by the driver.
+ */
+void emacps_recv_prio_handler(void *arg)
+{
+	struct xemac_s *xemac;
+	xemacpsif_s *xemacpsif;
+
+	xemac = (struct xemac_s *)(arg);
+	xemacpsif = (xemacpsif_s *)(xemac->state);
+
+#ifdef OS_IS_FREERTOS
+	xInsideISR++;
+#endif
+
+	process_recv_bds(xemac, &XEmacPs_GetRxQRing(&xemacpsif->emacps, 1),
+			xemacpsif->recv_prio_q);
+
+#ifdef OS_IS_FREERTOS
+	xInsideISR--;
+#endif
+}
+
+/*
+ * Sets up the RX BD ring of priority queue 1 in the given BD space, in place
+ * of the BD which parks the queue.
+ */
+static XStatus init_rx_prio_dma(xemacpsif_s *xemacpsif, void *bdspace)
+{
+	XEmacPs_Bd bdtemplate;
+	XEmacPs_BdRing *rxringptr;
+	XStatus status;
+
+	rxringptr = &XEmacPs_GetRxQRing(&xemacpsif->emacps, 1);
+	XEmacPs_BdClear(&bdtemplate);
+
+	status = XEmacPs_BdRingCreate(rxringptr, (UINTPTR)bdspace,
+				(UINTPTR)bdspace, BD_ALIGNMENT,
+				     XLWIP_CONFIG_N_RX_PRIO_DESC);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up priority RxBD space\r\n"));
+		return status;
+	}
+
+	status = XEmacPs_BdRingClone(rxringptr, &bdtemplate, XEMACPS_RECV);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error initializing priority RxBD space\r\n"));
+		return status;
+	}
+
+	setup_rx_bds(xemacpsif, rxringptr);
+	xemacpsif->rx_prio_enabled = 1;
+	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), rxringptr->BaseBdAddr, 1, XEMACPS_RECV);
+
+	return XST_SUCCESS;
+}
+#endif
+
 void clean_dma_txdescs(struct xemac_s *xemac)
 {
 	XEmacPs_Bd bdtemplate;
@@ -571,6 +897,10 @@ XStatus init_dma(struct xemac_s *xemac)
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 	struct xtopology_t *xtopologyp = &xtopology[xemac->topology_index];
 
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+	xemacpsif->rx_prio_enabled = 0;
+#endif
+
 	index = get_base_index_rxpbufsstorage (xemacpsif);
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
 	/*
@@ -669,6 +999,17 @@ XStatus init_dma(struct xemac_s *xemac)
 		return ERR_IF;
 	}
 
+#ifdef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+	/*
+	 * Post the RX buffers of the pool, the WRAP bit is set on the last BD.
+	 */
+	if (rx_pool_init(xemacpsif) != XST_SUCCESS) {
+		xil_printf("%s@%d: Error: Unable to allocate RX buffer pool",
+				__FILE__, __LINE__);
+		return ERR_IF;
+	}
+	setup_rx_bds(xemacpsif, rxringptr);
+#else
 	/*
 	 * Allocate RX descriptors, 1 RxBD at a time.
 	 */
@@ -723,6 +1064,7 @@ XStatus init_dma(struct xemac_s *xemac)
 
 		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
 	}
+#endif
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
 	if (gigeversion > 2) {
 		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 1, XEMACPS_SEND);
@@ -749,6 +1091,17 @@ XStatus init_dma(struct xemac_s *xemac)
 						XEMACPS_TXBUF_WRAP_MASK));
 		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_TXQBASE_OFFSET),
 				   (UINTPTR)bdtxterminate);
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+		/*
+		 * Receive the frames steered to queue 1 by the screeners on a
+		 * ring in the space of the parking BD.
+		 */
+		if (xemacpsif->emacps.NumQueues > 1) {
+			if (init_rx_prio_dma(xemacpsif, bdrxterminate) != XST_SUCCESS) {
+				return ERR_IF;
+			}
+		}
+#endif
 	}
 
 
@@ -805,6 +1158,26 @@ void resetrx_on_no_rxdata(xemacpsif_s *xemacpsif)
 	}
 }
 
+static void free_rx_pbufs(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
+{
+	UINTPTR *storage;
+	u32_t index;
+
+	storage = get_rx_pbufs_storage (xemacpsif, rxring);
+	for (index = 0; index < rxring->AllCnt; index++) {
+#ifdef XLWIP_CONFIG_EMACPS_RX_ZERO_COPY
+		/* Buffers still on the ring go back to the pool */
+		if (storage[index] != 0) {
+			rx_pool_put((xemacps_rx_pool *)xemacpsif->rx_pool,
+				(xemacps_rx_buf *)storage[index]);
+			storage[index] = 0;
+		}
+#else
+		pbuf_free((struct pbuf *)storage[index]);
+#endif
+	}
+}
+
 void free_txrx_pbufs(xemacpsif_s *xemacpsif)
 {
 	s32_t index;
@@ -821,12 +1194,12 @@ void free_txrx_pbufs(xemacpsif_s *xemacpsif)
 		}
 	}
 
-	index1 = get_base_index_rxpbufsstorage(xemacpsif);
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_RX_DESC); index++) {
-		p = (struct pbuf *)rx_pbufs_storage[index];
-		pbuf_free(p);
-
+	free_rx_pbufs(xemacpsif, &XEmacPs_GetRxRing(&xemacpsif->emacps));
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+	if (xemacpsif->rx_prio_enabled != 0) {
+		free_rx_pbufs(xemacpsif, &XEmacPs_GetRxQRing(&xemacpsif->emacps, 1));
 	}
+#endif
 }
 
 void free_onlytx_pbufs(xemacpsif_s *xemacpsif)
@@ -866,6 +1239,13 @@ void reset_dma(struct xemac_s *xemac)
 
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, txqueuenum, XEMACPS_SEND);
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+	if (xemacpsif->rx_prio_enabled != 0) {
+		rxringptr = &XEmacPs_GetRxQRing(&xemacpsif->emacps, 1);
+		XEmacPs_BdRingPtrReset(rxringptr, (void *)rxringptr->BaseBdAddr);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), rxringptr->BaseBdAddr, 1, XEMACPS_RECV);
+	}
+#endif
 }
 
 void emac_disable_intr(void)
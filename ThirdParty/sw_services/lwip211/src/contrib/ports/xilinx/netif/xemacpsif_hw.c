@@ -190,6 +190,13 @@ void setup_isr (struct xemac_s *xemac)
 	XEmacPs_SetHandler(&xemacpsif->emacps, XEMACPS_HANDLER_ERROR,
 				    (void *) emacps_error_handler,
 				    (void *) xemac);
+
+#ifdef XLWIP_CONFIG_EMACPS_RX_PRIO_QUEUE
+	/* Fails on a Gem without priority queues, which then stays unused */
+	XEmacPs_SetQueueHandler(&xemacpsif->emacps, 1, XEMACPS_HANDLER_DMARECV,
+				    (void *) emacps_recv_prio_handler,
+				    (void *) xemac);
+#endif
 }
 
 void start_emacps (xemacpsif_s *xemacps)
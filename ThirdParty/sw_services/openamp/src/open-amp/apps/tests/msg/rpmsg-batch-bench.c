@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2020 Xilinx, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * rpmsg-batch-bench.c
+ *
+ * Linux host loopback benchmark for batched rpmsg send, the receive budget
+ * and the zero-copy API. Two processes share an anonymous shared memory mapping holding
+ * the vrings and the rpmsg buffers: the parent is the virtio master and
+ * receives, the child is the virtio slave and sends. Notifications are
+ * doorbells in the shared memory which the other process polls, each one
+ * is counted as a kick.
+ *
+ * usage: rpmsg-batch-bench [-b batch] [-r rx_budget] [-n messages]
+ *                          [-l length] [-z]
+ *   -b  messages per rpmsg_trysend_batch() call, 1 uses rpmsg_trysend()
+ *   -r  messages handled per RX callback of the master, 0 for no limit,
+ *       see rpmsg_virtio_set_rx_budget()
+ *   -n  number of messages to send
+ *   -l  payload length in bytes
+ *   -z  zero-copy: the slave fills TX buffers from
+ *       rpmsg_get_tx_payload_buffer() and sends them with
+ *       rpmsg_send_nocopy(), the master holds the RX buffers and checks
+ *       them in place after the callback. Otherwise the slave builds each
+ *       payload in local memory and the master copies it out in the
+ *       callback. Messages are sent one at a time.
+ *
+ * It reports messages/sec, MB/sec and kicks/message in both directions, and
+ * the messages handled per RX callback. It fails if a message is lost,
+ * duplicated, reordered or corrupted, or if a callback exceeds the budget.
+ */
+
+#include <errno.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <metal/atomic.h>
+#include <metal/io.h>
+#include <metal/sys.h>
+#include <metal/time.h>
+#include <metal/utilities.h>
+#include <openamp/rpmsg_virtio.h>
+#include <openamp/virtqueue.h>
+
+#define VRING_NUM_DESCS		256
+#define VRING_ALIGN		4096
+#define VRING_SIZE		0x10000
+#define MSG_LEN			32
+#define MASTER_EPT_ADDR		0x20
+#define SLAVE_EPT_ADDR		0x21
+
+/* Control block shared by both processes, at the start of the mapping */
+struct bench_ctrl {
+	atomic_int status;
+	atomic_int doorbell_master;
+	atomic_int doorbell_slave;
+	atomic_long kicks_to_master;
+	atomic_long kicks_to_slave;
+};
+
+#define CTRL_SIZE		0x1000
+#define VRING0_OFFSET		CTRL_SIZE
+#define VRING1_OFFSET		(VRING0_OFFSET + VRING_SIZE)
+#define SHBUF_OFFSET		(VRING1_OFFSET + VRING_SIZE)
+#define SHBUF_SIZE		(2 * VRING_NUM_DESCS * RPMSG_BUFFER_SIZE)
+#define SHM_SIZE		(SHBUF_OFFSET + SHBUF_SIZE)
+
+struct bench_side {
+	struct virtio_device vdev;
+	struct virtio_vring_info vrings[2];
+	struct rpmsg_virtio_device rvdev;
+	struct rpmsg_endpoint ept;
+};
+
+static struct bench_ctrl *ctrl;
+static unsigned char *shm;
+/*
+ * Offsets are used as physical addresses so that both processes translate
+ * the descriptors the same way wherever the mapping lands.
+ */
+static metal_phys_addr_t shm_pa = 0;
+static struct metal_io_region shm_io;
+
+static long num_msgs = 1000000;
+static int msg_len = MSG_LEN;
+static int nocopy;
+static long received;
+static long dispatched;
+static uint32_t expected_seq;
+static int errors;
+
+/* RX buffers held by the master in zero-copy mode, checked in order */
+static struct rpmsg_batch_msg held[RPMSG_RX_HOLD_MAX];
+static int num_held;
+
+static unsigned char bench_get_status(struct virtio_device *vdev)
+{
+	(void)vdev;
+	return (unsigned char)atomic_load(&ctrl->status);
+}
+
+static void bench_set_status(struct virtio_device *vdev, unsigned char status)
+{
+	(void)vdev;
+	atomic_store(&ctrl->status, status);
+}
+
+static uint32_t bench_get_features(struct virtio_device *vdev)
+{
+	(void)vdev;
+	return 0;
+}
+
+static void bench_notify_slave(struct virtqueue *vq)
+{
+	(void)vq;
+	atomic_fetch_add(&ctrl->kicks_to_slave, 1);
+	atomic_store(&ctrl->doorbell_slave, 1);
+}
+
+static void bench_notify_master(struct virtqueue *vq)
+{
+	(void)vq;
+	atomic_fetch_add(&ctrl->kicks_to_master, 1);
+	atomic_store(&ctrl->doorbell_master, 1);
+}
+
+static const struct virtio_dispatch master_dispatch = {
+	.get_status = bench_get_status,
+	.set_status = bench_set_status,
+	.get_features = bench_get_features,
+	.notify = bench_notify_slave,
+};
+
+static const struct virtio_dispatch slave_dispatch = {
+	.get_status = bench_get_status,
+	.set_status = bench_set_status,
+	.get_features = bench_get_features,
+	.notify = bench_notify_master,
+};
+
+static int bench_setup_vdev(struct bench_side *side, unsigned int role,
+			    const struct virtio_dispatch *dispatch)
+{
+	static const unsigned long offsets[2] = {VRING0_OFFSET, VRING1_OFFSET};
+	int i;
+
+	side->vdev.role = role;
+	side->vdev.func = dispatch;
+	side->vdev.vrings_num = 2;
+	side->vdev.vrings_info = side->vrings;
+	for (i = 0; i < 2; i++) {
+		side->vrings[i].vq = virtqueue_allocate(VRING_NUM_DESCS);
+		if (!side->vrings[i].vq)
+			return -ENOMEM;
+		side->vrings[i].info.vaddr = shm + offsets[i];
+		side->vrings[i].info.num_descs = VRING_NUM_DESCS;
+		side->vrings[i].info.align = VRING_ALIGN;
+		side->vrings[i].io = &shm_io;
+	}
+	return 0;
+}
+
+static void fill_payload(unsigned char *buf, uint32_t seq)
+{
+	int i;
+
+	memcpy(buf, &seq, sizeof(seq));
+	for (i = sizeof(seq); i < msg_len; i++)
+		buf[i] = (unsigned char)(seq + i);
+}
+
+static void check_payload(const unsigned char *buf, size_t len)
+{
+	uint32_t seq;
+	size_t i;
+
+	memcpy(&seq, buf, sizeof(seq));
+	if (len != (size_t)msg_len || seq != expected_seq)
+		errors++;
+	for (i = sizeof(seq); i < len; i++) {
+		if (buf[i] != (unsigned char)(seq + i)) {
+			errors++;
+			break;
+		}
+	}
+	expected_seq = seq + 1;
+	received++;
+}
+
+static void release_held(struct rpmsg_endpoint *ept)
+{
+	int i;
+
+	for (i = 0; i < num_held; i++) {
+		check_payload(held[i].data, held[i].len);
+		rpmsg_release_rx_buffer(ept, (void *)held[i].data);
+	}
+	num_held = 0;
+}
+
+static int master_ept_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+			 uint32_t src, void *priv)
+{
+	unsigned char copy[RPMSG_BUFFER_SIZE];
+
+	(void)src;
+	(void)priv;
+	dispatched++;
+	if (nocopy) {
+		if (num_held == RPMSG_RX_HOLD_MAX)
+			release_held(ept);
+		rpmsg_hold_rx_buffer(ept, data);
+		held[num_held].data = data;
+		held[num_held].len = len;
+		num_held++;
+		return RPMSG_SUCCESS;
+	}
+
+	if (len > sizeof(copy)) {
+		errors++;
+		return RPMSG_SUCCESS;
+	}
+	memcpy(copy, data, len);
+	check_payload(copy, len);
+	return RPMSG_SUCCESS;
+}
+
+static int slave_ept_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
+			uint32_t src, void *priv)
+{
+	(void)ept;
+	(void)data;
+	(void)len;
+	(void)src;
+	(void)priv;
+	return RPMSG_SUCCESS;
+}
+
+static int run_slave(int batch)
+{
+	struct bench_side side;
+	unsigned char payload[RPMSG_BATCH_SIZE][RPMSG_BUFFER_SIZE];
+	struct rpmsg_batch_msg msgs[RPMSG_BATCH_SIZE];
+	unsigned char *buf;
+	uint32_t size;
+	long seq = 0;
+	int ret, i, n;
+
+	memset(&side, 0, sizeof(side));
+	ret = bench_setup_vdev(&side, VIRTIO_DEV_SLAVE, &slave_dispatch);
+	if (ret)
+		return ret;
+	/* Waits for the master to set DRIVER_OK */
+	ret = rpmsg_init_vdev(&side.rvdev, &side.vdev, NULL, &shm_io, NULL);
+	if (ret)
+		return ret;
+	ret = rpmsg_create_ept(&side.ept, &side.rvdev.rdev, "bench",
+			       SLAVE_EPT_ADDR, MASTER_EPT_ADDR, slave_ept_cb,
+			       NULL);
+	if (ret)
+		return ret;
+	if (msg_len > rpmsg_virtio_get_buffer_size(&side.rvdev.rdev))
+		return -EINVAL;
+
+	while (nocopy && seq < num_msgs) {
+		buf = rpmsg_get_tx_payload_buffer(&side.ept, &size, 0);
+		if (!buf) {
+			sched_yield();
+			continue;
+		}
+		fill_payload(buf, (uint32_t)seq);
+		ret = rpmsg_send_nocopy(&side.ept, buf, msg_len);
+		if (ret < 0)
+			return ret;
+		seq++;
+	}
+
+	while (seq < num_msgs) {
+		n = batch;
+		if (n > num_msgs - seq)
+			n = num_msgs - seq;
+		for (i = 0; i < n; i++) {
+			uint32_t s = (uint32_t)(seq + i);
+
+			fill_payload(payload[i], s);
+			msgs[i].data = payload[i];
+			msgs[i].len = msg_len;
+		}
+		if (batch == 1)
+			ret = rpmsg_trysend(&side.ept, payload[0], msg_len) > 0;
+		else
+			ret = rpmsg_trysend_batch(&side.ept, msgs, n);
+		if (ret > 0)
+			seq += ret;
+		else if (ret == 0 || ret == RPMSG_ERR_NO_BUFF)
+			sched_yield();
+		else
+			return ret;
+		/* Buffers come back through the avail ring, polled on send */
+		atomic_store(&ctrl->doorbell_slave, 0);
+	}
+	return 0;
+}
+
+static int run_master(unsigned int rx_budget)
+{
+	struct bench_side side;
+	struct rpmsg_virtio_shm_pool shpool;
+	unsigned long long start, elapsed;
+	long calls = 0, max_per_call = 0, before;
+	int ret;
+
+	memset(&side, 0, sizeof(side));
+	ret = bench_setup_vdev(&side, VIRTIO_DEV_MASTER, &master_dispatch);
+	if (ret)
+		return ret;
+	rpmsg_virtio_init_shm_pool(&shpool, shm + SHBUF_OFFSET, SHBUF_SIZE);
+	ret = rpmsg_init_vdev(&side.rvdev, &side.vdev, NULL, &shm_io, &shpool);
+	if (ret)
+		return ret;
+	rpmsg_virtio_set_rx_budget(&side.rvdev, rx_budget);
+	ret = rpmsg_create_ept(&side.ept, &side.rvdev.rdev, "bench",
+			       MASTER_EPT_ADDR, SLAVE_EPT_ADDR, master_ept_cb,
+			       NULL);
+	if (ret)
+		return ret;
+	if (msg_len > rpmsg_virtio_get_buffer_size(&side.rvdev.rdev))
+		return -EINVAL;
+
+	start = metal_get_timestamp();
+	bench_set_status(&side.vdev, VIRTIO_CONFIG_STATUS_DRIVER_OK);
+	while (received < num_msgs) {
+		/* Messages left by the receive budget need another call */
+		if (atomic_exchange(&ctrl->doorbell_master, 0) ||
+		    rpmsg_virtio_rx_pending(&side.rvdev)) {
+			before = dispatched;
+			virtqueue_notification(side.rvdev.rvq);
+			if (dispatched - before > max_per_call)
+				max_per_call = dispatched - before;
+			calls++;
+		} else if (num_held)
+			release_held(&side.ept);
+		else
+			sched_yield();
+	}
+	elapsed = metal_get_timestamp() - start;
+
+	printf("%ld msgs: %.0f msgs/sec, %.1f MB/sec, kicks/msg slave->master %.3f, master->slave %.3f\r\n",
+	       num_msgs, (double)num_msgs * 1e9 / (double)elapsed,
+	       (double)num_msgs * msg_len * 1e3 / (double)elapsed,
+	       (double)atomic_load(&ctrl->kicks_to_master) / num_msgs,
+	       (double)atomic_load(&ctrl->kicks_to_slave) / num_msgs);
+	printf("RX callbacks %ld, at most %ld msgs per callback\r\n", calls,
+	       max_per_call);
+	if (rx_budget && max_per_call > (long)rx_budget)
+		errors++;
+	return errors ? -EIO : 0;
+}
+
+int main(int argc, char *argv[])
+{
+	struct metal_init_params init_param = METAL_INIT_DEFAULTS;
+	unsigned int rx_budget = RPMSG_RX_BUDGET;
+	int batch = 1;
+	int opt, ret, status;
+	pid_t pid;
+
+	while ((opt = getopt(argc, argv, "b:r:n:l:z")) != -1) {
+		switch (opt) {
+		case 'b':
+			batch = atoi(optarg);
+			break;
+		case 'r':
+			rx_budget = (unsigned int)atoi(optarg);
+			break;
+		case 'n':
+			num_msgs = atol(optarg);
+			break;
+		case 'l':
+			msg_len = atoi(optarg);
+			break;
+		case 'z':
+			nocopy = 1;
+			break;
+		default:
+			fprintf(stderr,
+				"usage: %s [-b batch] [-r rx_budget] [-n messages] [-l length] [-z]\r\n",
+				argv[0]);
+			return -1;
+		}
+	}
+	if (batch < 1 || batch > RPMSG_BATCH_SIZE || num_msgs < 1 ||
+	    msg_len < (int)sizeof(uint32_t) || (nocopy && batch != 1)) {
+		fprintf(stderr,
+			"batch must be 1 to %d, or 1 with -z, messages at least 1, length at least %d\r\n",
+			RPMSG_BATCH_SIZE, (int)sizeof(uint32_t));
+		return -1;
+	}
+	printf("%s, batch %d, rx budget %u, %d byte messages\r\n",
+	       nocopy ? "zero-copy" : "copy", batch, rx_budget, msg_len);
+
+	ret = metal_init(&init_param);
+	if (ret) {
+		fprintf(stderr, "metal_init failed %d\r\n", ret);
+		return -1;
+	}
+
+	shm = mmap(NULL, SHM_SIZE, PROT_READ | PROT_WRITE,
+		   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shm == MAP_FAILED) {
+		perror("mmap");
+		metal_finish();
+		return -1;
+	}
+	ctrl = (struct bench_ctrl *)shm;
+	metal_io_init(&shm_io, shm, &shm_pa, SHM_SIZE, (unsigned int)-1, 0,
+		      NULL);
+
+	pid = fork();
+	if (pid < 0) {
+		perror("fork");
+		ret = -errno;
+	} else if (pid == 0) {
+		ret = run_slave(batch);
+		if (ret)
+			fprintf(stderr, "slave failed %d\r\n", ret);
+		_exit(ret ? 1 : 0);
+	} else {
+		ret = run_master(rx_budget);
+		if (ret) {
+			fprintf(stderr, "master failed %d\r\n", ret);
+			kill(pid, SIGKILL);
+		}
+		if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+		    WEXITSTATUS(status))
+			ret = -1;
+	}
+
+	munmap(shm, SHM_SIZE);
+	metal_finish();
+	return ret ? 1 : 0;
+}
@@ -78,14 +78,41 @@ struct rpmsg_endpoint {
 	void *priv;
 };
 
+/**
+ * struct rpmsg_batch_msg - one message of a batch
+ * @data: payload of the message
+ * @len: length of the payload
+ */
+struct rpmsg_batch_msg {
+	const void *data;
+	int len;
+};
+
 /**
  * struct rpmsg_device_ops - RPMsg device operations
  * @send_offchannel_raw: send RPMsg data
+ * @send_offchannel_batch: send several RPMsg messages with one notification,
+ *                         optional
+ * @hold_rx_buffer: hold RPMsg RX buffer, optional
+ * @release_rx_buffer: release RPMsg RX buffer, optional
+ * @get_tx_payload_buffer: get RPMsg TX buffer, optional
+ * @send_offchannel_nocopy: send RPMsg data without copy, optional
  */
 struct rpmsg_device_ops {
 	int (*send_offchannel_raw)(struct rpmsg_device *rdev,
 				   uint32_t src, uint32_t dst,
 				   const void *data, int size, int wait);
+	int (*send_offchannel_batch)(struct rpmsg_device *rdev,
+				     uint32_t src, uint32_t dst,
+				     const struct rpmsg_batch_msg *msgs,
+				     int num, int wait);
+	void (*hold_rx_buffer)(struct rpmsg_device *rdev, void *rxbuf);
+	void (*release_rx_buffer)(struct rpmsg_device *rdev, void *rxbuf);
+	void *(*get_tx_payload_buffer)(struct rpmsg_device *rdev,
+				       uint32_t *len, int wait);
+	int (*send_offchannel_nocopy)(struct rpmsg_device *rdev,
+				      uint32_t src, uint32_t dst,
+				      const void *data, int len);
 };
 
 /**
@@ -127,6 +154,29 @@ int rpmsg_send_offchannel_raw(struct rpmsg_endpoint *ept, uint32_t src,
 			      uint32_t dst, const void *data, int size,
 			      int wait);
 
+/**
+ * rpmsg_send_offchannel_batch() - send several messages across to the remote
+ * processor, specifying source and destination address.
+ * @ept: the rpmsg endpoint
+ * @src: source address
+ * @dst: destination address
+ * @msgs: messages to send
+ * @num: number of messages
+ * @wait: boolean, wait or not for the first buffer to become available
+ *
+ * The messages are placed in TX buffers and published to the remote
+ * processor together, which is notified once for the whole batch. Only the
+ * first message waits for a TX buffer; the batch stops at the first message
+ * without a free buffer, so fewer than @num messages may be sent.
+ *
+ * Returns number of messages it has sent or negative error value when no
+ * message was sent.
+ */
+int rpmsg_send_offchannel_batch(struct rpmsg_endpoint *ept, uint32_t src,
+				uint32_t dst,
+				const struct rpmsg_batch_msg *msgs, int num,
+				int wait);
+
 /**
  * rpmsg_send() - send a message across to the remote processor
  * @ept: the rpmsg endpoint
@@ -267,6 +317,157 @@ static inline int rpmsg_trysend_offchannel(struct rpmsg_endpoint *ept,
 	return rpmsg_send_offchannel_raw(ept, src, dst, data, len, false);
 }
 
+/**
+ * rpmsg_send_batch() - send several messages across to the remote processor
+ * @ept: the rpmsg endpoint
+ * @msgs: messages to send
+ * @num: number of messages
+ *
+ * This function sends the @num messages of @msgs based on the @ept, with a
+ * single notification of the remote processor.
+ * In case there are no TX buffers available, the function will block until
+ * one becomes available, or a timeout of 15 seconds elapses.
+ *
+ * Returns number of messages it has sent or negative error value on failure.
+ */
+static inline int rpmsg_send_batch(struct rpmsg_endpoint *ept,
+				   const struct rpmsg_batch_msg *msgs, int num)
+{
+	if (ept->dest_addr == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_ADDR;
+	return rpmsg_send_offchannel_batch(ept, ept->addr, ept->dest_addr,
+					   msgs, num, true);
+}
+
+/**
+ * rpmsg_trysend_batch() - send several messages across to the remote
+ * processor
+ * @ept: the rpmsg endpoint
+ * @msgs: messages to send
+ * @num: number of messages
+ *
+ * This function sends the @num messages of @msgs based on the @ept, with a
+ * single notification of the remote processor.
+ * In case there are no TX buffers available, the function will immediately
+ * return RPMSG_ERR_NO_BUFF without waiting until one becomes available.
+ *
+ * Returns number of messages it has sent or negative error value on failure.
+ */
+static inline int rpmsg_trysend_batch(struct rpmsg_endpoint *ept,
+				      const struct rpmsg_batch_msg *msgs,
+				      int num)
+{
+	if (ept->dest_addr == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_ADDR;
+	return rpmsg_send_offchannel_batch(ept, ept->addr, ept->dest_addr,
+					   msgs, num, false);
+}
+
+/**
+ * rpmsg_hold_rx_buffer() - hold the RX buffer
+ * @ept: the rpmsg endpoint
+ * @rxbuf: RX buffer with message payload
+ *
+ * Holds the RX buffer for usage outside the receive callback. The buffer
+ * is not returned to the remote processor when the callback returns, so the
+ * payload can be processed in place. Only @rxbuf passed to the endpoint
+ * callback may be held, and only from within that callback. The device
+ * keeps track of the held buffers in local memory; the virtio device holds
+ * at most RPMSG_RX_HOLD_MAX of them at a time.
+ *
+ * Every held buffer must be released with rpmsg_release_rx_buffer(),
+ * otherwise the remote processor runs out of TX buffers.
+ */
+void rpmsg_hold_rx_buffer(struct rpmsg_endpoint *ept, void *rxbuf);
+
+/**
+ * rpmsg_release_rx_buffer() - release a held RX buffer
+ * @ept: the rpmsg endpoint
+ * @rxbuf: RX buffer with message payload
+ *
+ * Returns a buffer held with rpmsg_hold_rx_buffer() to the remote
+ * processor. Releasing a buffer that is not held has no effect.
+ */
+void rpmsg_release_rx_buffer(struct rpmsg_endpoint *ept, void *rxbuf);
+
+/**
+ * rpmsg_get_tx_payload_buffer() - get a TX buffer to fill in place
+ * @ept: the rpmsg endpoint
+ * @len: pointer to store the size of the payload area of the buffer
+ * @wait: boolean, wait or not for a buffer to become available
+ *
+ * Hands the payload area of a free shared memory TX buffer to the
+ * application, which writes the message directly into it and then sends it
+ * with one of the rpmsg_send*_nocopy() functions. The buffer is owned by the
+ * application until it is sent and must not be accessed afterwards. A device
+ * hands out at most RPMSG_TX_PAYLOAD_MAX buffers which are not sent yet.
+ *
+ * Returns pointer to the payload area of the buffer, or NULL if no buffer is
+ * available.
+ */
+void *rpmsg_get_tx_payload_buffer(struct rpmsg_endpoint *ept,
+				  uint32_t *len, int wait);
+
+/**
+ * rpmsg_send_offchannel_nocopy() - send a message in a TX buffer across to
+ * the remote processor, specifying source and destination address.
+ * @ept: the rpmsg endpoint
+ * @src: source address
+ * @dst: destination address
+ * @data: payload area returned by rpmsg_get_tx_payload_buffer()
+ * @len: length of the payload
+ *
+ * This function sends @data of length @len to the remote @dst address from
+ * the source @src address, without copying it. The buffer must have been
+ * obtained with rpmsg_get_tx_payload_buffer() on the same device and @len
+ * must not exceed the size returned there. Other buffers, including buffers
+ * which were already sent, are rejected with RPMSG_ERR_PARAM.
+ *
+ * Returns number of bytes it has sent or negative error value on failure.
+ */
+int rpmsg_send_offchannel_nocopy(struct rpmsg_endpoint *ept, uint32_t src,
+				 uint32_t dst, const void *data, int len);
+
+/**
+ * rpmsg_sendto_nocopy() - send a message in a TX buffer across to the remote
+ * processor, specify dst
+ * @ept: the rpmsg endpoint
+ * @data: payload area returned by rpmsg_get_tx_payload_buffer()
+ * @len: length of the payload
+ * @dst: destination address
+ *
+ * This function sends @data of length @len to the remote @dst address,
+ * without copying it.
+ *
+ * Returns number of bytes it has sent or negative error value on failure.
+ */
+static inline int rpmsg_sendto_nocopy(struct rpmsg_endpoint *ept,
+				      const void *data, int len, uint32_t dst)
+{
+	return rpmsg_send_offchannel_nocopy(ept, ept->addr, dst, data, len);
+}
+
+/**
+ * rpmsg_send_nocopy() - send a message in a TX buffer across to the remote
+ * processor
+ * @ept: the rpmsg endpoint
+ * @data: payload area returned by rpmsg_get_tx_payload_buffer()
+ * @len: length of the payload
+ *
+ * This function sends @data of length @len based on the @ept, without
+ * copying it.
+ *
+ * Returns number of bytes it has sent or negative error value on failure.
+ */
+static inline int rpmsg_send_nocopy(struct rpmsg_endpoint *ept,
+				    const void *data, int len)
+{
+	if (ept->dest_addr == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_ADDR;
+	return rpmsg_send_offchannel_nocopy(ept, ept->addr, ept->dest_addr,
+					    data, len);
+}
+
 /**
  * rpmsg_init_ept - initialize rpmsg endpoint
  *
@@ -26,6 +26,26 @@ extern "C" {
 #define RPMSG_BUFFER_SIZE	(512)
 #endif
 
+/* Maximum number of messages sent with one notification */
+#ifndef RPMSG_BATCH_SIZE
+#define RPMSG_BATCH_SIZE	(16)
+#endif
+
+/* Received messages handled per RX callback, 0 for no limit */
+#ifndef RPMSG_RX_BUDGET
+#define RPMSG_RX_BUDGET		(0)
+#endif
+
+/* Maximum number of TX buffers held by the application for zero-copy send */
+#ifndef RPMSG_TX_PAYLOAD_MAX
+#define RPMSG_TX_PAYLOAD_MAX	(8)
+#endif
+
+/* Maximum number of RX buffers held by the application for zero-copy receive */
+#ifndef RPMSG_RX_HOLD_MAX
+#define RPMSG_RX_HOLD_MAX	(8)
+#endif
+
 /* The feature bitmap for virtio rpmsg */
 #define VIRTIO_RPMSG_F_NS	0 /* RP supports name service notifications */
 
@@ -49,6 +69,15 @@ struct rpmsg_virtio_shm_pool {
  * @svq: pointer to send virtqueue
  * @shbuf_io: pointer to the shared buffer I/O region
  * @shpool: pointer to the shared buffers pool
+ * @rx_budget: received messages handled per call of the RX callback,
+ *             RPMSG_RX_BUDGET by default, 0 for no limit
+ * @rx_next: received buffer left for the next call of the RX callback when
+ *           the budget ran out, NULL if none
+ * @rx_next_len: length of @rx_next
+ * @rx_next_idx: virtqueue index of @rx_next
+ * @rx_cur_buf: received buffer passed to the endpoint callback, only this
+ *              buffer can be held
+ * @rx_cur_idx: virtqueue index of @rx_cur_buf
  */
 struct rpmsg_virtio_device {
 	struct rpmsg_device rdev;
@@ -57,6 +86,18 @@ struct rpmsg_virtio_device {
 	struct virtqueue *svq;
 	struct metal_io_region *shbuf_io;
 	struct rpmsg_virtio_shm_pool *shpool;
+	unsigned int rx_budget;
+	void *rx_next;
+	uint32_t rx_next_len;
+	uint16_t rx_next_idx;
+	void *rx_cur_buf;
+	uint16_t rx_cur_idx;
+	/* RX buffers held by the application, see hold_rx_buffer */
+	void *rx_held[RPMSG_RX_HOLD_MAX];
+	uint16_t rx_held_idx[RPMSG_RX_HOLD_MAX];
+	/* TX buffers owned by the application, see get_tx_payload_buffer */
+	void *tx_owned[RPMSG_TX_PAYLOAD_MAX];
+	uint16_t tx_owned_idx[RPMSG_TX_PAYLOAD_MAX];
 };
 
 #define RPMSG_REMOTE	VIRTIO_DEV_SLAVE
@@ -153,6 +194,43 @@ void rpmsg_deinit_vdev(struct rpmsg_virtio_device *rvdev);
 void rpmsg_virtio_init_shm_pool(struct rpmsg_virtio_shm_pool *shpool,
 				void *shbuf, size_t size);
 
+/**
+ * rpmsg_virtio_set_rx_budget - set the receive budget
+ *
+ * The RX callback, called by virtqueue_notification() on the receive
+ * virtqueue, handles at most @budget messages and returns, which bounds the
+ * time spent in it, e.g. in an interrupt handler. The remaining messages
+ * are handled by the next call, the application checks for them with
+ * rpmsg_virtio_rx_pending(). rpmsg_init_vdev sets it to RPMSG_RX_BUDGET, so
+ * this must be called after rpmsg_init_vdev.
+ *
+ * @param rvdev - pointer to the rpmsg virtio device
+ * @param budget - number of messages, 0 for no limit
+ */
+static inline void
+rpmsg_virtio_set_rx_budget(struct rpmsg_virtio_device *rvdev,
+			   unsigned int budget)
+{
+	rvdev->rx_budget = budget;
+}
+
+/**
+ * rpmsg_virtio_rx_pending - check for messages left by the receive budget
+ *
+ * The other side does not notify again for messages it has already sent,
+ * so when this returns true the application calls virtqueue_notification()
+ * on the receive virtqueue again, e.g. from its main loop.
+ *
+ * @param rvdev - pointer to the rpmsg virtio device
+ *
+ * @return - true if the last RX callback stopped on the budget.
+ */
+static inline bool
+rpmsg_virtio_rx_pending(struct rpmsg_virtio_device *rvdev)
+{
+	return rvdev->rx_next != NULL;
+}
+
 /**
  * rpmsg_virtio_get_rpmsg_device - get RPMsg device from RPMsg virtio device
  *
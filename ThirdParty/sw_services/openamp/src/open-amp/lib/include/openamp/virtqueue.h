@@ -83,6 +83,14 @@ struct virtqueue {
 	 */
 	uint16_t vq_available_idx;
 
+	/*
+	 * Buffers placed in the ring inside a batch but not yet published,
+	 * and the ring index (avail or used) they are published in.
+	 */
+	uint16_t vq_batch_cnt;
+	volatile uint16_t *vq_batch_idx;
+	bool vq_batching;
+
 #ifdef VQUEUE_DEBUG
 	bool vq_inuse;
 #endif
@@ -197,6 +205,10 @@ int virtqueue_enable_cb(struct virtqueue *vq);
 
 void virtqueue_kick(struct virtqueue *vq);
 
+void virtqueue_batch_begin(struct virtqueue *vq);
+
+void virtqueue_batch_end(struct virtqueue *vq);
+
 static inline struct virtqueue *virtqueue_allocate(unsigned int num_desc_extra)
 {
 	struct virtqueue *vqs;
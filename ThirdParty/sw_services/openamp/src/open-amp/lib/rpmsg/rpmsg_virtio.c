@@ -354,6 +354,398 @@ static int rpmsg_virtio_send_offchannel_raw(struct rpmsg_device *rdev,
 	return size;
 }
 
+/**
+ * This function sends several rpmsg messages to remote device with one
+ * virtqueue update and one notification.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param src     - source address of channel
+ * @param dst     - destination address of channel
+ * @param msgs    - messages to transmit
+ * @param num     - number of messages
+ * @param wait    - boolean, wait or not for the first buffer to become
+ *                  available
+ *
+ * @return - number of messages sent or negative value for failure.
+ *
+ */
+static int rpmsg_virtio_send_offchannel_batch(struct rpmsg_device *rdev,
+					      uint32_t src, uint32_t dst,
+					      const struct rpmsg_batch_msg *msgs,
+					      int num, int wait)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr rp_hdr;
+	void *buffers[RPMSG_BATCH_SIZE];
+	uint32_t buff_lens[RPMSG_BATCH_SIZE];
+	uint16_t idxs[RPMSG_BATCH_SIZE];
+	int tick_count;
+	int avail_size;
+	int count = 0;
+	int i, status;
+	struct metal_io_region *io;
+
+	/* Get the associated remote device for channel. */
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+
+	status = rpmsg_virtio_get_status(rvdev);
+	/* Validate device state */
+	if (!(status & VIRTIO_CONFIG_STATUS_DRIVER_OK)) {
+		return RPMSG_ERR_DEV_STATE;
+	}
+
+	if (!msgs[0].data || msgs[0].len < 0)
+		return RPMSG_ERR_PARAM;
+	if (num > RPMSG_BATCH_SIZE)
+		num = RPMSG_BATCH_SIZE;
+
+	if (wait)
+		tick_count = RPMSG_TICK_COUNT / RPMSG_TICKS_PER_INTERVAL;
+	else
+		tick_count = 0;
+
+	/*
+	 * Take as many TX buffers as are free, only waiting for the first
+	 * one. The batch stops at the first message that does not fit.
+	 */
+	while (1) {
+		metal_mutex_acquire(&rdev->lock);
+		avail_size = _rpmsg_virtio_get_buffer_size(rvdev);
+		while (count < num && msgs[count].data &&
+		       msgs[count].len >= 0 && msgs[count].len <= avail_size) {
+			buffers[count] = rpmsg_virtio_get_tx_buffer(rvdev,
+							&buff_lens[count],
+							&idxs[count]);
+			if (!buffers[count])
+				break;
+			count++;
+			avail_size = _rpmsg_virtio_get_buffer_size(rvdev);
+		}
+		metal_mutex_release(&rdev->lock);
+		if (count || !tick_count)
+			break;
+		if (avail_size != 0 && msgs[0].len > avail_size)
+			return RPMSG_ERR_BUFF_SIZE;
+		metal_sleep_usec(RPMSG_TICKS_PER_INTERVAL);
+		tick_count--;
+	}
+	if (!count)
+		return (avail_size != 0 && msgs[0].len > avail_size) ?
+		       RPMSG_ERR_BUFF_SIZE : RPMSG_ERR_NO_BUFF;
+
+	/* Copy the messages to the rpmsg buffers. */
+	io = rvdev->shbuf_io;
+	rp_hdr.dst = dst;
+	rp_hdr.src = src;
+	rp_hdr.reserved = 0;
+	for (i = 0; i < count; i++) {
+		rp_hdr.len = msgs[i].len;
+		status = metal_io_block_write(io,
+					      metal_io_virt_to_offset(io,
+					      buffers[i]),
+					      &rp_hdr, sizeof(rp_hdr));
+		RPMSG_ASSERT(status == sizeof(rp_hdr),
+			     "failed to write header\r\n");
+
+		status = metal_io_block_write(io,
+					      metal_io_virt_to_offset(io,
+					      RPMSG_LOCATE_DATA(buffers[i])),
+					      msgs[i].data, msgs[i].len);
+		RPMSG_ASSERT(status == msgs[i].len,
+			     "failed to write buffer\r\n");
+	}
+
+	metal_mutex_acquire(&rdev->lock);
+
+	/* Enqueue the buffers and publish them with one index update. */
+	virtqueue_batch_begin(rvdev->svq);
+	for (i = 0; i < count; i++) {
+		status = rpmsg_virtio_enqueue_buffer(rvdev, buffers[i],
+						     buff_lens[i], idxs[i]);
+		RPMSG_ASSERT(status == VQUEUE_SUCCESS,
+			     "failed to enqueue buffer\r\n");
+	}
+	virtqueue_batch_end(rvdev->svq);
+	/* Let the other side know that there is a job to process. */
+	virtqueue_kick(rvdev->svq);
+
+	metal_mutex_release(&rdev->lock);
+
+	return count;
+}
+
+/**
+ * rpmsg_virtio_find_rx_held
+ *
+ * Looks up a RX buffer held by the application. Called with the device
+ * locked.
+ *
+ * @param rvdev  - pointer to rpmsg virtio device
+ * @param rp_hdr - header of the buffer, NULL to find a free slot
+ *
+ * @return - slot of the buffer, negative value if not found.
+ *
+ */
+static int rpmsg_virtio_find_rx_held(struct rpmsg_virtio_device *rvdev,
+				     void *rp_hdr)
+{
+	int i;
+
+	for (i = 0; i < RPMSG_RX_HOLD_MAX; i++) {
+		if (rvdev->rx_held[i] == rp_hdr)
+			return i;
+	}
+
+	return -1;
+}
+
+/**
+ * rpmsg_virtio_hold_rx_buffer
+ *
+ * Records a received buffer as held so that the RX callback does not return
+ * it to the remote side.
+ *
+ * @param rdev  - pointer to rpmsg device
+ * @param rxbuf - payload of the received buffer
+ *
+ */
+static void rpmsg_virtio_hold_rx_buffer(struct rpmsg_device *rdev,
+					void *rxbuf)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdr;
+	int slot;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	rp_hdr = RPMSG_LOCATE_HDR(rxbuf);
+
+	metal_mutex_acquire(&rdev->lock);
+	if (rp_hdr == rvdev->rx_cur_buf &&
+	    rpmsg_virtio_find_rx_held(rvdev, rp_hdr) < 0) {
+		slot = rpmsg_virtio_find_rx_held(rvdev, NULL);
+		RPMSG_ASSERT(slot >= 0, "too many held rx buffers\r\n");
+		rvdev->rx_held[slot] = rp_hdr;
+		rvdev->rx_held_idx[slot] = rvdev->rx_cur_idx;
+	}
+	metal_mutex_release(&rdev->lock);
+}
+
+/**
+ * rpmsg_virtio_release_rx_buffer
+ *
+ * Returns a held buffer to the remote side.
+ *
+ * @param rdev  - pointer to rpmsg device
+ * @param rxbuf - payload of the received buffer
+ *
+ */
+static void rpmsg_virtio_release_rx_buffer(struct rpmsg_device *rdev,
+					   void *rxbuf)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdr;
+	uint32_t len;
+	uint16_t idx;
+	int slot;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	rp_hdr = RPMSG_LOCATE_HDR(rxbuf);
+
+	metal_mutex_acquire(&rdev->lock);
+	/* Ignore buffers that are not held, e.g. a second release. */
+	slot = rpmsg_virtio_find_rx_held(rvdev, rp_hdr);
+	if (slot < 0) {
+		metal_mutex_release(&rdev->lock);
+		return;
+	}
+	idx = rvdev->rx_held_idx[slot];
+	rvdev->rx_held[slot] = NULL;
+	/* The RX callback returns the buffer it is still dispatching. */
+	if (rp_hdr == rvdev->rx_cur_buf) {
+		metal_mutex_release(&rdev->lock);
+		return;
+	}
+
+	/* Return buffer on virtqueue. */
+	len = virtqueue_get_buffer_length(rvdev->rvq, idx);
+	rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
+	/* Tell peer we return some rx buffers */
+	virtqueue_kick(rvdev->rvq);
+	metal_mutex_release(&rdev->lock);
+}
+
+/**
+ * rpmsg_virtio_find_tx_owned
+ *
+ * Looks up a TX buffer owned by the application. Called with the device
+ * locked.
+ *
+ * @param rvdev  - pointer to rpmsg virtio device
+ * @param rp_hdr - header of the buffer, NULL to find a free slot
+ *
+ * @return - slot of the buffer, negative value if not found.
+ *
+ */
+static int rpmsg_virtio_find_tx_owned(struct rpmsg_virtio_device *rvdev,
+				      void *rp_hdr)
+{
+	int i;
+
+	for (i = 0; i < RPMSG_TX_PAYLOAD_MAX; i++) {
+		if (rvdev->tx_owned[i] == rp_hdr)
+			return i;
+	}
+
+	return -1;
+}
+
+/**
+ * rpmsg_virtio_get_tx_payload_buffer
+ *
+ * Provides a TX buffer to be filled in place by the application.
+ *
+ * @param rdev - pointer to rpmsg device
+ * @param len  - pointer to store the size of the payload area
+ * @param wait - boolean, wait or not for buffer to become available
+ *
+ * @return - pointer to the payload area of the buffer, NULL on failure.
+ *
+ */
+static void *rpmsg_virtio_get_tx_payload_buffer(struct rpmsg_device *rdev,
+						uint32_t *len, int wait)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct rpmsg_hdr *rp_hdr = NULL;
+	uint16_t idx = 0;
+	int tick_count;
+	int status;
+	int slot;
+
+	/* Get the associated remote device for channel. */
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+
+	status = rpmsg_virtio_get_status(rvdev);
+	/* Validate device state */
+	if (!(status & VIRTIO_CONFIG_STATUS_DRIVER_OK)) {
+		return NULL;
+	}
+
+	if (wait)
+		tick_count = RPMSG_TICK_COUNT / RPMSG_TICKS_PER_INTERVAL;
+	else
+		tick_count = 0;
+
+	while (1) {
+		/* Lock the device to enable exclusive access to virtqueues */
+		metal_mutex_acquire(&rdev->lock);
+		/* Record the buffer as owned by the application. */
+		slot = rpmsg_virtio_find_tx_owned(rvdev, NULL);
+		if (slot >= 0) {
+			rp_hdr = rpmsg_virtio_get_tx_buffer(rvdev, len, &idx);
+			if (rp_hdr) {
+				rvdev->tx_owned[slot] = rp_hdr;
+				rvdev->tx_owned_idx[slot] = idx;
+			}
+		}
+		metal_mutex_release(&rdev->lock);
+		if (rp_hdr || !tick_count)
+			break;
+		metal_sleep_usec(RPMSG_TICKS_PER_INTERVAL);
+		tick_count--;
+	}
+
+	if (!rp_hdr)
+		return NULL;
+
+	/* Actual data buffer size is vring buffer size minus header length */
+	*len -= sizeof(struct rpmsg_hdr);
+
+	return RPMSG_LOCATE_DATA(rp_hdr);
+}
+
+/**
+ * rpmsg_virtio_send_offchannel_nocopy
+ *
+ * Sends a message placed in a buffer from
+ * rpmsg_virtio_get_tx_payload_buffer().
+ *
+ * @param rdev - pointer to rpmsg device
+ * @param src  - source address of channel
+ * @param dst  - destination address of channel
+ * @param data - payload area of the TX buffer
+ * @param len  - length of the payload
+ *
+ * @return - number of bytes sent or negative value for failure.
+ *
+ */
+static int rpmsg_virtio_send_offchannel_nocopy(struct rpmsg_device *rdev,
+					       uint32_t src, uint32_t dst,
+					       const void *data, int len)
+{
+	struct rpmsg_virtio_device *rvdev;
+	struct metal_io_region *io;
+	struct rpmsg_hdr rp_hdr;
+	struct rpmsg_hdr *hdr;
+	uint32_t buff_len = 0;
+	uint16_t idx;
+	int status;
+	int slot;
+
+	/* Get the associated remote device for channel. */
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	io = rvdev->shbuf_io;
+	hdr = RPMSG_LOCATE_HDR(data);
+
+	metal_mutex_acquire(&rdev->lock);
+	/* The buffer must be owned by the application, i.e. not sent yet. */
+	slot = rpmsg_virtio_find_tx_owned(rvdev, hdr);
+	if (slot < 0) {
+		metal_mutex_release(&rdev->lock);
+		return RPMSG_ERR_PARAM;
+	}
+	idx = rvdev->tx_owned_idx[slot];
+
+#ifndef VIRTIO_SLAVE_ONLY
+	if (rpmsg_virtio_get_role(rvdev) == RPMSG_MASTER)
+		buff_len = RPMSG_BUFFER_SIZE;
+#endif /*!VIRTIO_SLAVE_ONLY*/
+#ifndef VIRTIO_MASTER_ONLY
+	if (rpmsg_virtio_get_role(rvdev) == RPMSG_REMOTE)
+		buff_len = virtqueue_get_buffer_length(rvdev->svq, idx);
+#endif /*!VIRTIO_MASTER_ONLY*/
+	if (len < 0 || (uint32_t)len + sizeof(struct rpmsg_hdr) > buff_len) {
+		metal_mutex_release(&rdev->lock);
+		return RPMSG_ERR_BUFF_SIZE;
+	}
+	/* The buffer goes back to the device. */
+	rvdev->tx_owned[slot] = NULL;
+	metal_mutex_release(&rdev->lock);
+
+	/* Initialize RPMSG header. */
+	rp_hdr.dst = dst;
+	rp_hdr.src = src;
+	rp_hdr.len = len;
+	rp_hdr.reserved = 0;
+	rp_hdr.flags = 0;
+
+	/* Copy the header to the rpmsg buffer, the payload is in place. */
+	status = metal_io_block_write(io, metal_io_virt_to_offset(io, hdr),
+				      &rp_hdr, sizeof(rp_hdr));
+	RPMSG_ASSERT(status == sizeof(rp_hdr), "failed to write header\r\n");
+
+	metal_mutex_acquire(&rdev->lock);
+
+	/* Enqueue buffer on virtqueue. */
+	status = rpmsg_virtio_enqueue_buffer(rvdev, hdr, buff_len, idx);
+	RPMSG_ASSERT(status == VQUEUE_SUCCESS, "failed to enqueue buffer\r\n");
+	/* Let the other side know that there is a job to process. */
+	virtqueue_kick(rvdev->svq);
+
+	metal_mutex_release(&rdev->lock);
+
+	return len;
+}
+
 /**
  * rpmsg_virtio_tx_callback
  *
@@ -385,12 +777,21 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 	struct rpmsg_hdr *rp_hdr;
 	uint32_t len;
 	uint16_t idx;
+	unsigned int handled = 0;
 	int status;
 
 	metal_mutex_acquire(&rdev->lock);
 
-	/* Process the received data from remote node */
-	rp_hdr = rpmsg_virtio_get_rx_buffer(rvdev, &len, &idx);
+	/* Resume with the buffer left when the budget ran out. */
+	if (rvdev->rx_next) {
+		rp_hdr = rvdev->rx_next;
+		len = rvdev->rx_next_len;
+		idx = rvdev->rx_next_idx;
+		rvdev->rx_next = NULL;
+	} else {
+		/* Process the received data from remote node */
+		rp_hdr = rpmsg_virtio_get_rx_buffer(rvdev, &len, &idx);
+	}
 
 	metal_mutex_release(&rdev->lock);
 
@@ -398,6 +799,8 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 		/* Get the channel node from the remote device channels list. */
 		metal_mutex_acquire(&rdev->lock);
 		ept = rpmsg_get_ept_from_addr(rdev, rp_hdr->dst);
+		rvdev->rx_cur_buf = rp_hdr;
+		rvdev->rx_cur_idx = idx;
 		metal_mutex_release(&rdev->lock);
 
 		if (ept) {
@@ -417,12 +820,28 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 
 		metal_mutex_acquire(&rdev->lock);
 
-		/* Return used buffers. */
-		rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
+		/*
+		 * Return used buffers, they are published in batches. Held
+		 * buffers are returned by rpmsg_release_rx_buffer().
+		 */
+		virtqueue_batch_begin(rvdev->rvq);
+		if (rpmsg_virtio_find_rx_held(rvdev, rp_hdr) < 0)
+			rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
+		rvdev->rx_cur_buf = NULL;
+		handled++;
 
 		rp_hdr = rpmsg_virtio_get_rx_buffer(rvdev, &len, &idx);
-		if (rp_hdr == NULL) {
+		if (rp_hdr && rvdev->rx_budget &&
+		    handled >= rvdev->rx_budget) {
+			/* Left for the next call, see rpmsg_virtio_rx_pending */
+			rvdev->rx_next = rp_hdr;
+			rvdev->rx_next_len = len;
+			rvdev->rx_next_idx = idx;
+			rp_hdr = NULL;
+		}
+		if (rp_hdr == NULL || handled % RPMSG_BATCH_SIZE == 0) {
 			/* tell peer we return some rx buffer */
+			virtqueue_batch_end(rvdev->rvq);
 			virtqueue_kick(rvdev->rvq);
 		}
 		metal_mutex_release(&rdev->lock);
@@ -529,6 +948,16 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 	rdev->ns_bind_cb = ns_bind_cb;
 	vdev->priv = rvdev;
 	rdev->ops.send_offchannel_raw = rpmsg_virtio_send_offchannel_raw;
+	rdev->ops.send_offchannel_batch = rpmsg_virtio_send_offchannel_batch;
+	rdev->ops.hold_rx_buffer = rpmsg_virtio_hold_rx_buffer;
+	rdev->ops.release_rx_buffer = rpmsg_virtio_release_rx_buffer;
+	rdev->ops.get_tx_payload_buffer = rpmsg_virtio_get_tx_payload_buffer;
+	rdev->ops.send_offchannel_nocopy = rpmsg_virtio_send_offchannel_nocopy;
+	rvdev->rx_budget = RPMSG_RX_BUDGET;
+	rvdev->rx_next = NULL;
+	rvdev->rx_cur_buf = NULL;
+	memset(rvdev->rx_held, 0, sizeof(rvdev->rx_held));
+	memset(rvdev->tx_owned, 0, sizeof(rvdev->tx_owned));
 	role = rpmsg_virtio_get_role(rvdev);
 
 #ifndef VIRTIO_MASTER_ONLY
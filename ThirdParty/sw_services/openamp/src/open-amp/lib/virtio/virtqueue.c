@@ -15,6 +15,7 @@
 /* Prototype for internal functions. */
 static void vq_ring_init(struct virtqueue *, void *, int);
 static void vq_ring_update_avail(struct virtqueue *, uint16_t);
+static void vq_ring_publish(struct virtqueue *vq, volatile uint16_t *idx);
 static uint16_t vq_ring_add_buffer(struct virtqueue *, struct vring_desc *,
 				   uint16_t, struct virtqueue_buf *, int, int);
 static int vq_ring_enable_interrupt(struct virtqueue *, uint16_t);
@@ -77,6 +78,9 @@ int virtqueue_create(struct virtio_device *virt_dev, unsigned short id,
 		vq->vq_queue_index = id;
 		vq->vq_nentries = ring->num_descs;
 		vq->vq_free_cnt = vq->vq_nentries;
+		vq->vq_batch_cnt = 0;
+		vq->vq_batch_idx = NULL;
+		vq->vq_batching = false;
 		vq->callback = callback;
 		vq->notify = notify;
 
@@ -275,17 +279,16 @@ int virtqueue_add_consumed_buffer(struct virtqueue *vq, uint16_t head_idx,
 
 	VQUEUE_BUSY(vq);
 
-	used_idx = vq->vq_ring.used->idx & (vq->vq_nentries - 1);
+	used_idx = (vq->vq_ring.used->idx + vq->vq_batch_cnt) &
+		   (vq->vq_nentries - 1);
 	used_desc = &vq->vq_ring.used->ring[used_idx];
 	used_desc->id = head_idx;
 	used_desc->len = len;
 
-	atomic_thread_fence(memory_order_seq_cst);
-
-	vq->vq_ring.used->idx++;
-
-	/* Keep pending count until virtqueue_notify(). */
-	vq->vq_queued_cnt++;
+	vq->vq_batch_idx = &vq->vq_ring.used->idx;
+	vq->vq_batch_cnt++;
+	if (!vq->vq_batching)
+		vq_ring_publish(vq, vq->vq_batch_idx);
 
 	VQUEUE_IDLE(vq);
 
@@ -341,6 +344,39 @@ void virtqueue_disable_cb(struct virtqueue *vq)
 	VQUEUE_IDLE(vq);
 }
 
+/**
+ * virtqueue_batch_begin - Starts a batch of buffer updates. Buffers added
+ *                         with virtqueue_add_buffer() or
+ *                         virtqueue_add_consumed_buffer() are placed in the
+ *                         ring but only become visible to the other side
+ *                         with virtqueue_batch_end().
+ *
+ * @param vq             - Pointer to VirtIO queue control block
+ */
+void virtqueue_batch_begin(struct virtqueue *vq)
+{
+	vq->vq_batching = true;
+}
+
+/**
+ * virtqueue_batch_end - Publishes the buffers added since
+ *                       virtqueue_batch_begin() with a single index update.
+ *                       The other side still needs to be notified with
+ *                       virtqueue_kick().
+ *
+ * @param vq           - Pointer to VirtIO queue control block
+ */
+void virtqueue_batch_end(struct virtqueue *vq)
+{
+	VQUEUE_BUSY(vq);
+
+	vq->vq_batching = false;
+	if (vq->vq_batch_cnt)
+		vq_ring_publish(vq, vq->vq_batch_idx);
+
+	VQUEUE_IDLE(vq);
+}
+
 /**
  * virtqueue_kick - Notifies other side that there is buffer available for it.
  *
@@ -536,15 +572,35 @@ static void vq_ring_update_avail(struct virtqueue *vq, uint16_t desc_idx)
 	 * currently running on another CPU, we can keep it processing the new
 	 * descriptor.
 	 */
-	avail_idx = vq->vq_ring.avail->idx & (vq->vq_nentries - 1);
+	avail_idx = (vq->vq_ring.avail->idx + vq->vq_batch_cnt) &
+		    (vq->vq_nentries - 1);
 	vq->vq_ring.avail->ring[avail_idx] = desc_idx;
 
+	vq->vq_batch_idx = &vq->vq_ring.avail->idx;
+	vq->vq_batch_cnt++;
+	if (!vq->vq_batching)
+		vq_ring_publish(vq, vq->vq_batch_idx);
+}
+
+/**
+ *
+ * vq_ring_publish
+ *
+ * Makes the ring entries written since the last publication visible to the
+ * other side by advancing @idx, the avail index for buffers added with
+ * virtqueue_add_buffer() and the used index for buffers returned with
+ * virtqueue_add_consumed_buffer().
+ *
+ */
+static void vq_ring_publish(struct virtqueue *vq, volatile uint16_t *idx)
+{
 	atomic_thread_fence(memory_order_seq_cst);
 
-	vq->vq_ring.avail->idx++;
+	*idx += vq->vq_batch_cnt;
 
 	/* Keep pending count until virtqueue_notify(). */
-	vq->vq_queued_cnt++;
+	vq->vq_queued_cnt += vq->vq_batch_cnt;
+	vq->vq_batch_cnt = 0;
 }
 
 /**
@@ -25,16 +25,56 @@
 * 1.6   Tejus   06/03/2020  Fix compilation error for simulation.
 * 1.7   Tejus   06/10/2020  Switch to new io backend.
 * 1.8   Dishita 08/10/2020  Add calls to turn ECC on and off for PM and DM.
+* 1.9   Tejus   10/18/2020  Add apis to load one elf to multiple tiles.
 * </pre>
 *
 ******************************************************************************/
 /***************************** Include Files *********************************/
+#ifdef __AIELINUX__
+#include <pthread.h>
+#endif
+
 #include "xaie_elfloader.h"
 #include "xaie_ecc.h"
 /************************** Constant Definitions *****************************/
 #define XAIESIM_CMDIO_CMD_SETSTACK       0U
 #define XAIESIM_CMDIO_CMD_LOADSYM        1U
 
+/* Tiles loaded by each worker thread before another thread is started */
+#define XAIE_ELF_TILES_PER_THREAD	8U
+#define XAIE_ELF_MAX_THREADS		4U
+
+/**************************** Type Definitions *******************************/
+/*
+ * Typedef to capture one chunk of a loadable segment. Data memory segments are
+ * split at data memory boundaries so that each chunk targets a single tile.
+ */
+typedef struct {
+	u8 IsProgMem;			/* Chunk goes to program memory */
+	u32 Addr;			/* Address from the core's perspective */
+	u32 NumWords;			/* Number of 32-bit words */
+	const unsigned char *Data;	/* Chunk data, NULL to zero fill */
+} XAie_ElfChunk;
+
+/*
+ * Typedef to capture an elf decoded once for loading to multiple tiles.
+ */
+typedef struct {
+	u32 NumChunks;
+	XAie_ElfChunk *Chunks;
+} XAie_ElfImage;
+
+/*
+ * Typedef to capture the work of one elf loader thread.
+ */
+typedef struct {
+	XAie_DevInst *DevInst;
+	const XAie_ElfImage *Image;
+	XAie_LocType *Locs;
+	u32 NumTiles;
+	AieRC RC;
+} XAie_ElfLoadWork;
+
 /************************** Function Definitions *****************************/
 /*****************************************************************************/
 /**
@@ -416,6 +456,63 @@ AieRC XAie_LoadElfMem(XAie_DevInst *DevInst, XAie_LocType Loc,
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function reads an elf file into memory.
+*
+* @param	ElfPtr: Path to the elf file.
+* @param	ElfMem: Pointer to store the allocated buffer with the contents
+*		of the elf. The caller has to free the buffer.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static AieRC _XAie_ReadElfFile(const char *ElfPtr, unsigned char **ElfMem)
+{
+	FILE *Fd;
+	int Ret;
+	u64 ElfSz;
+
+	Fd = fopen(ElfPtr, "r");
+	if(Fd == XAIE_NULL) {
+		XAIE_ERROR("Unable to open elf file\n");
+		return XAIE_INVALID_ELF;
+	}
+
+	/* Get the file size of the elf */
+	Ret = fseek(Fd, 0L, SEEK_END);
+	if(Ret != 0U) {
+		XAIE_ERROR("Failed to get end of file\n");
+		fclose(Fd);
+		return XAIE_INVALID_ELF;
+	}
+
+	ElfSz = ftell(Fd);
+	rewind(Fd);
+	XAIE_DBG("Elf size is %ld bytes\n", ElfSz);
+
+	/* Read entire elf file into memory */
+	*ElfMem = (unsigned char*) malloc(ElfSz);
+	if(*ElfMem == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		fclose(Fd);
+		return XAIE_ERR;
+	}
+
+	Ret = fread((void*)*ElfMem, ElfSz, 1U, Fd);
+	fclose(Fd);
+	if(Ret == 0U) {
+		XAIE_ERROR("Failed to read Elf into memory\n");
+		free(*ElfMem);
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+}
+
 #ifdef __AIESIM__
 /*****************************************************************************/
 /**
@@ -490,11 +587,8 @@ static u32 XAieSim_GetStackRange(const char *MapPtr,
 AieRC XAie_LoadElf(XAie_DevInst *DevInst, XAie_LocType Loc, const char *ElfPtr,
 		u8 LoadSym)
 {
-	FILE *Fd;
-	int Ret;
 	unsigned char *ElfMem;
 	u8 TileType;
-	u64 ElfSz;
 	AieRC RC;
 
 	if((DevInst == XAIE_NULL) ||
@@ -554,46 +648,529 @@ AieRC XAie_LoadElf(XAie_DevInst *DevInst, XAie_LocType Loc, const char *ElfPtr,
 	}
 #endif
 	(void)LoadSym;
-	Fd = fopen(ElfPtr, "r");
-	if(Fd == XAIE_NULL) {
-		XAIE_ERROR("Unable to open elf file\n");
-		return XAIE_INVALID_ELF;
+	RC = _XAie_ReadElfFile(ElfPtr, &ElfMem);
+	if(RC != XAIE_OK) {
+		return RC;
 	}
 
-	/* Get the file size of the elf */
-	Ret = fseek(Fd, 0L, SEEK_END);
-	if(Ret != 0U) {
-		XAIE_ERROR("Failed to get end of file\n");
-		return XAIE_INVALID_ELF;
+	RC = XAie_LoadElfMem(DevInst, Loc, ElfMem);
+	if(RC != XAIE_OK) {
+		free(ElfMem);
+		return RC;
 	}
 
-	ElfSz = ftell(Fd);
-	rewind(Fd);
-	XAIE_DBG("Elf size is %ld bytes\n", ElfSz);
+	free(ElfMem);
+	return XAIE_OK;
+}
 
-	/* Read entire elf file into memory */
-	ElfMem = (unsigned char*) malloc(ElfSz);
-	if(ElfMem == NULL) {
+/*****************************************************************************/
+/**
+*
+* This function decodes the loadable segments of an elf once so that it can be
+* written to multiple tiles. The segments are validated against the program
+* and data memory layout and split into chunks targeting a single tile each.
+*
+* @param	DevInst: Device Instance.
+* @param	ElfMem: Pointer to the Elf contents in memory.
+* @param	Image: Pointer to the image to populate. The caller has to free
+*		Image->Chunks.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static AieRC _XAie_DecodeElf(XAie_DevInst *DevInst,
+		const unsigned char *ElfMem, XAie_ElfImage *Image)
+{
+	const Elf32_Ehdr *Ehdr = (const Elf32_Ehdr *)ElfMem;
+	const Elf32_Phdr *Phdr;
+	const XAie_CoreMod *CoreMod;
+	u32 MaxChunks = 0U;
+	u32 AddrMask;
+
+	CoreMod = DevInst->DevProp.DevMod[XAIEGBL_TILE_TYPE_AIETILE].CoreMod;
+	AddrMask = CoreMod->DataMemSize - 1U;
+
+	_XAie_PrintElfHdr(Ehdr);
+
+	/* Initialized and uninitialized parts, each split per tile */
+	for(u8 phnum = 0U; phnum < Ehdr->e_phnum; phnum++) {
+		Phdr = (const Elf32_Phdr *)(ElfMem + sizeof(*Ehdr) +
+			phnum * sizeof(*Phdr));
+		if(Phdr->p_type == PT_LOAD) {
+			MaxChunks += 2U * (Phdr->p_memsz /
+					CoreMod->DataMemSize + 2U);
+		}
+	}
+
+	Image->NumChunks = 0U;
+	Image->Chunks = (XAie_ElfChunk *)malloc((MaxChunks + 1U) *
+			sizeof(*Image->Chunks));
+	if(Image->Chunks == NULL) {
 		XAIE_ERROR("Memory allocation failed\n");
 		return XAIE_ERR;
 	}
 
-	Ret = fread((void*)ElfMem, ElfSz, 1U, Fd);
-	if(Ret == 0U) {
-		XAIE_ERROR("Failed to read Elf into memory\n");
-		return XAIE_ERR;
+	for(u8 phnum = 0U; phnum < Ehdr->e_phnum; phnum++) {
+		const unsigned char *SectionPtr;
+		u32 SectionAddr, SectionSize, BytesToWrite;
+		XAie_ElfChunk *Chunk;
+
+		Phdr = (const Elf32_Phdr *)(ElfMem + sizeof(*Ehdr) +
+			phnum * sizeof(*Phdr));
+		_XAie_PrintProgSectHdr(Phdr);
+		if(Phdr->p_type != PT_LOAD) {
+			continue;
+		}
+
+		SectionPtr = ElfMem + Phdr->p_offset;
+
+		if(Phdr->p_paddr < CoreMod->ProgMemSize) {
+			if((Phdr->p_paddr + Phdr->p_memsz) >
+					CoreMod->ProgMemSize) {
+				XAIE_ERROR("Overflow of program memory\n");
+				free(Image->Chunks);
+				return XAIE_INVALID_ELF;
+			}
+
+			Chunk = &Image->Chunks[Image->NumChunks++];
+			Chunk->IsProgMem = XAIE_ENABLE;
+			Chunk->Addr = Phdr->p_paddr;
+			Chunk->NumWords = (Phdr->p_memsz + 4U - 1U) / 4U;
+			Chunk->Data = SectionPtr;
+			continue;
+		}
+
+		if(((Phdr->p_paddr > CoreMod->ProgMemSize) &&
+				(Phdr->p_paddr < CoreMod->DataMemAddr)) ||
+				((Phdr->p_paddr + Phdr->p_memsz) >
+				 (CoreMod->DataMemAddr +
+				  CoreMod->DataMemSize * 4U))) {
+			XAIE_ERROR("Invalid section starting at 0x%x\n",
+					Phdr->p_paddr);
+			free(Image->Chunks);
+			return XAIE_INVALID_ELF;
+		}
+
+		/* Initialized section */
+		SectionSize = Phdr->p_filesz;
+		SectionAddr = Phdr->p_paddr;
+		while(SectionSize > 0U) {
+			BytesToWrite = SectionSize;
+			if(((SectionAddr & AddrMask) + SectionSize) >
+					CoreMod->DataMemSize) {
+				BytesToWrite = CoreMod->DataMemSize -
+					(SectionAddr & AddrMask);
+			}
+
+			Chunk = &Image->Chunks[Image->NumChunks++];
+			Chunk->IsProgMem = XAIE_DISABLE;
+			Chunk->Addr = SectionAddr;
+			Chunk->NumWords = (BytesToWrite + 4U - 1U) / 4U;
+			Chunk->Data = SectionPtr;
+
+			SectionSize -= BytesToWrite;
+			SectionAddr += BytesToWrite;
+			SectionPtr += BytesToWrite;
+		}
+
+		/* Un-initialized section */
+		SectionSize = Phdr->p_memsz - Phdr->p_filesz;
+		SectionAddr = Phdr->p_paddr + Phdr->p_filesz;
+		while(SectionSize > 0U) {
+			BytesToWrite = SectionSize;
+			if(((SectionAddr & AddrMask) + SectionSize) >
+					CoreMod->DataMemSize) {
+				BytesToWrite = CoreMod->DataMemSize -
+					(SectionAddr & AddrMask);
+			}
+
+			Chunk = &Image->Chunks[Image->NumChunks++];
+			Chunk->IsProgMem = XAIE_DISABLE;
+			Chunk->Addr = SectionAddr;
+			Chunk->NumWords = (BytesToWrite + 4U - 1U) / 4U;
+			Chunk->Data = NULL;
+
+			SectionSize -= BytesToWrite;
+			SectionAddr += BytesToWrite;
+		}
 	}
 
-	fclose(Fd);
+	return XAIE_OK;
+}
 
-	RC = XAie_LoadElfMem(DevInst, Loc, ElfMem);
+/*****************************************************************************/
+/**
+*
+* This function writes the chunks of a decoded elf to one tile.
+*
+* @param	DevInst: Device Instance.
+* @param	Image: Decoded elf.
+* @param	Loc: Location of AIE Tile.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Internal API only. ECC is handled by the caller, the function
+*		only issues block writes and may run in a worker thread.
+*
+*******************************************************************************/
+static AieRC _XAie_WriteElfImage(XAie_DevInst *DevInst,
+		const XAie_ElfImage *Image, XAie_LocType Loc)
+{
+	AieRC RC;
+	u64 Addr;
+	XAie_LocType TgtLoc;
+	const XAie_CoreMod *CoreMod;
+
+	CoreMod = DevInst->DevProp.DevMod[XAIEGBL_TILE_TYPE_AIETILE].CoreMod;
+
+	for(u32 i = 0U; i < Image->NumChunks; i++) {
+		const XAie_ElfChunk *Chunk = &Image->Chunks[i];
+
+		if(Chunk->IsProgMem == XAIE_ENABLE) {
+			Addr = CoreMod->ProgMemHostOffset + Chunk->Addr +
+				_XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col);
+			XAie_BlockWrite32(DevInst, Addr, (u32 *)Chunk->Data,
+					Chunk->NumWords);
+			continue;
+		}
+
+		RC = _XAie_GetTargetTileLoc(DevInst, Loc, Chunk->Addr, &TgtLoc);
+		if(RC != XAIE_OK) {
+			XAIE_ERROR("Failed to get target location for "
+					"p_paddr 0x%x\n", Chunk->Addr);
+			return RC;
+		}
+
+		Addr = (Chunk->Addr & (CoreMod->DataMemSize - 1U)) +
+			_XAie_GetTileAddr(DevInst, TgtLoc.Row, TgtLoc.Col);
+		if(Chunk->Data != NULL) {
+			XAie_BlockWrite32(DevInst, Addr, (u32 *)Chunk->Data,
+					Chunk->NumWords);
+		} else {
+			XAie_BlockSet32(DevInst, Addr, 0U, Chunk->NumWords);
+		}
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function prepares ECC of the program memory of a tile and the data
+* memories touched by a decoded elf before it is written.
+*
+* @param	DevInst: Device Instance.
+* @param	Image: Decoded elf.
+* @param	Loc: Location of AIE Tile.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static AieRC _XAie_PrepareElfImageEcc(XAie_DevInst *DevInst,
+		const XAie_ElfImage *Image, XAie_LocType Loc)
+{
+	AieRC RC;
+	XAie_LocType TgtLoc;
+
+	if((DevInst->DevProp.DevGen == XAIE_DEV_GEN_AIE) &&
+			(DevInst->EccStatus == XAIE_ENABLE)) {
+		_XAie_EccEvntResetPM(DevInst, Loc);
+	}
+
+	if(DevInst->EccStatus == 0U) {
+		return XAIE_OK;
+	}
+
+	for(u32 i = 0U; i < Image->NumChunks; i++) {
+		if(Image->Chunks[i].IsProgMem == XAIE_ENABLE) {
+			continue;
+		}
+
+		RC = _XAie_GetTargetTileLoc(DevInst, Loc,
+				Image->Chunks[i].Addr, &TgtLoc);
+		if(RC != XAIE_OK) {
+			XAIE_ERROR("Failed to get target location for "
+					"p_paddr 0x%x\n",
+					Image->Chunks[i].Addr);
+			return RC;
+		}
+
+		RC = _XAie_EccOnDM(DevInst, TgtLoc);
+		if(RC != XAIE_OK) {
+			XAIE_ERROR("Unable to turn ECC On for Data Memory\n");
+			return RC;
+		}
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the body of the elf loader worker threads and loads a
+* decoded elf to a slice of the tiles.
+*
+* @param	Arg: Pointer to the work of the thread.
+*
+* @return	Pointer to the work of the thread.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static void* _XAie_ElfLoadWorker(void *Arg)
+{
+	XAie_ElfLoadWork *Work = (XAie_ElfLoadWork *)Arg;
+
+	Work->RC = XAIE_OK;
+	for(u32 i = 0U; i < Work->NumTiles; i++) {
+		Work->RC = _XAie_WriteElfImage(Work->DevInst, Work->Image,
+				Work->Locs[i]);
+		if(Work->RC != XAIE_OK) {
+			break;
+		}
+	}
+
+	return Work;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes a decoded elf to a list of tiles. On the Linux backend,
+* program and data memories are mapped to user space and the writes are spread
+* over worker threads when the list is long enough.
+*
+* @param	DevInst: Device Instance.
+* @param	Image: Decoded elf.
+* @param	Locs: Array of AIE tile locations.
+* @param	NumTiles: Number of tiles in Locs.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Internal API only.
+*
+*******************************************************************************/
+static AieRC _XAie_WriteElfImageMultiTile(XAie_DevInst *DevInst,
+		const XAie_ElfImage *Image, XAie_LocType *Locs, u32 NumTiles)
+{
+	XAie_ElfLoadWork Work;
+
+#ifdef __AIELINUX__
+	/*
+	 * Recording transactions and the register shadow are not thread safe,
+	 * threads are only used when writes go straight to the backend.
+	 */
+	if((DevInst->Backend->Type == XAIE_IO_BACKEND_LINUX) &&
+			(DevInst->TxnInst == XAIE_NULL) &&
+			(DevInst->ShadowInst == XAIE_NULL) &&
+			(NumTiles > XAIE_ELF_TILES_PER_THREAD)) {
+		pthread_t Threads[XAIE_ELF_MAX_THREADS];
+		XAie_ElfLoadWork Works[XAIE_ELF_MAX_THREADS];
+		u32 NumThreads, TilesPerThread, Start = 0U;
+		AieRC RC = XAIE_OK;
+
+		NumThreads = NumTiles / XAIE_ELF_TILES_PER_THREAD;
+		if(NumThreads > XAIE_ELF_MAX_THREADS) {
+			NumThreads = XAIE_ELF_MAX_THREADS;
+		}
+		TilesPerThread = (NumTiles + NumThreads - 1U) / NumThreads;
+
+		for(u32 t = 0U; t < NumThreads; t++) {
+			Works[t].DevInst = DevInst;
+			Works[t].Image = Image;
+			Works[t].Locs = &Locs[Start];
+			Works[t].NumTiles = (NumTiles - Start < TilesPerThread) ?
+				(NumTiles - Start) : TilesPerThread;
+			Start += Works[t].NumTiles;
+
+			if(pthread_create(&Threads[t], NULL,
+						_XAie_ElfLoadWorker,
+						&Works[t]) != 0) {
+				/* Load the slice from this thread instead */
+				_XAie_ElfLoadWorker(&Works[t]);
+				Threads[t] = pthread_self();
+			}
+		}
+
+		for(u32 t = 0U; t < NumThreads; t++) {
+			if(!pthread_equal(Threads[t], pthread_self())) {
+				pthread_join(Threads[t], NULL);
+			}
+			if(Works[t].RC != XAIE_OK) {
+				RC = Works[t].RC;
+			}
+		}
+
+		return RC;
+	}
+#endif
+
+	Work.DevInst = DevInst;
+	Work.Image = Image;
+	Work.Locs = Locs;
+	Work.NumTiles = NumTiles;
+	_XAie_ElfLoadWorker(&Work);
+
+	return Work.RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function loads the elf from memory to multiple AIE Cores. The elf is
+* parsed and validated once, and the decoded program and data segments are
+* written to every tile in the list. The function writes 0 for the
+* unitialized data section.
+*
+* @param	DevInst: Device Instance.
+* @param	Locs: Array of AIE tile locations.
+* @param	NumTiles: Number of tiles in Locs.
+* @param	ElfMem: Pointer to the Elf contents in memory.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		Use this api instead of calling XAie_LoadElfMem() in a loop
+*		when the same kernel runs on many tiles.
+*
+*******************************************************************************/
+AieRC XAie_LoadElfMemMultiTile(XAie_DevInst *DevInst, XAie_LocType *Locs,
+		u32 NumTiles, const unsigned char *ElfMem)
+{
+	AieRC RC;
+	XAie_ElfImage Image;
+
+	if((DevInst == XAIE_NULL) || (ElfMem == XAIE_NULL) ||
+		(Locs == XAIE_NULL) || (NumTiles == 0U) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	for(u32 i = 0U; i < NumTiles; i++) {
+		if(_XAie_GetTileTypefromLoc(DevInst, Locs[i]) !=
+				XAIEGBL_TILE_TYPE_AIETILE) {
+			XAIE_ERROR("Invalid tile type\n");
+			return XAIE_INVALID_TILE;
+		}
+	}
+
+	RC = _XAie_DecodeElf(DevInst, ElfMem, &Image);
 	if(RC != XAIE_OK) {
-		free(ElfMem);
 		return RC;
 	}
 
-	free(ElfMem);
+	for(u32 i = 0U; i < NumTiles; i++) {
+		RC = _XAie_PrepareElfImageEcc(DevInst, &Image, Locs[i]);
+		if(RC != XAIE_OK) {
+			free(Image.Chunks);
+			return RC;
+		}
+	}
+
+	RC = _XAie_WriteElfImageMultiTile(DevInst, &Image, Locs, NumTiles);
+	free(Image.Chunks);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	/* Turn ECC On after program memory load */
+	if(DevInst->EccStatus) {
+		for(u32 i = 0U; i < NumTiles; i++) {
+			RC = _XAie_EccOnPM(DevInst, Locs[i]);
+			if(RC != XAIE_OK) {
+				XAIE_ERROR("Unable to turn ECC On for Program "
+						"Memory\n");
+				return RC;
+			}
+		}
+	}
+
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function loads the elf from file to multiple AIE Cores. The file is read
+* and parsed once. The function writes 0 for the unitialized data section.
+*
+* @param	DevInst: Device Instance.
+* @param	Locs: Array of AIE tile locations.
+* @param	NumTiles: Number of tiles in Locs.
+* @param	ElfPtr: Path to the elf file.
+* @param	LoadSym: Load symbols from .map file. This argument is valid
+*		when __AIESIM__ is defined.
+*
+* @return	XAIE_OK on success and error code for failure.
+*
+* @note		None.
+*
+*******************************************************************************/
+AieRC XAie_LoadElfMultiTile(XAie_DevInst *DevInst, XAie_LocType *Locs,
+		u32 NumTiles, const char *ElfPtr, u8 LoadSym)
+{
+	unsigned char *ElfMem;
+	AieRC RC;
+
+	if((DevInst == XAIE_NULL) || (Locs == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid device instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if (ElfPtr == XAIE_NULL) {
+		XAIE_ERROR("Invalid ElfPtr\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+#ifdef __AIESIM__
+	u32 Status;
+	char *MapPath;
+	const char *MapPathSuffix = ".map";
+	XAieSim_StackSz StackSz;
+
+	/* Get the stack range */
+	MapPath = malloc(strlen(ElfPtr) + strlen(MapPathSuffix) + 1);
+	if (MapPath == NULL) {
+		XAIE_ERROR("failed to malloc for .map file path.\n");
+		return XAIE_ERR;
+	}
+	strcpy(MapPath, ElfPtr);
+	strcat(MapPath, MapPathSuffix);
+	Status = XAieSim_GetStackRange(MapPath, &StackSz);
+	free(MapPath);
+	if(Status != XAIE_SUCCESS) {
+		XAIE_ERROR("Stack range definition failed\n");
+		return Status;
+	}
+
+	for(u32 i = 0U; i < NumTiles; i++) {
+		XAie_CmdWrite(DevInst, Locs[i].Col, Locs[i].Row,
+				XAIESIM_CMDIO_CMD_SETSTACK, StackSz.start,
+				StackSz.end, XAIE_NULL);
+		if(LoadSym == XAIE_ENABLE) {
+			XAie_CmdWrite(DevInst, Locs[i].Col, Locs[i].Row,
+					XAIESIM_CMDIO_CMD_LOADSYM, 0, 0,
+					ElfPtr);
+		}
+	}
+#endif
+	(void)LoadSym;
+	RC = _XAie_ReadElfFile(ElfPtr, &ElfMem);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	RC = XAie_LoadElfMemMultiTile(DevInst, Locs, NumTiles, ElfMem);
+	free(ElfMem);
+
+	return RC;
+}
+
 /** @} */
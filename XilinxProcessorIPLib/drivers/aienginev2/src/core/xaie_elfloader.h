@@ -19,6 +19,7 @@
 * 1.0   Tejus   09/24/2019  Initial creation
 * 1.1   Tejus   03/20/2020  Remove range apis
 * 1.2   Tejus   05/26/2020  Add API to load elf from memory.
+* 1.3   Tejus   10/18/2020  Add APIs to load one elf to multiple tiles.
 * </pre>
 *
 ******************************************************************************/
@@ -47,5 +48,9 @@ AieRC XAie_LoadElf(XAie_DevInst *DevInst, XAie_LocType Loc, const char *ElfPtr,
 		u8 LoadSym);
 AieRC XAie_LoadElfMem(XAie_DevInst *DevInst, XAie_LocType Loc,
 		const unsigned char* ElfMem);
+AieRC XAie_LoadElfMultiTile(XAie_DevInst *DevInst, XAie_LocType *Locs,
+		u32 NumTiles, const char *ElfPtr, u8 LoadSym);
+AieRC XAie_LoadElfMemMultiTile(XAie_DevInst *DevInst, XAie_LocType *Locs,
+		u32 NumTiles, const unsigned char *ElfMem);
 #endif		/* end of protection macro */
 /** @} */
@@ -24,6 +24,9 @@
 * 1.4   Dishita 07/28/2020  Add api to turn ECC On and Off.
 * 1.5   Nishad  09/15/2020  Add check to validate XAie_MemCacheProp value in
 *			    XAie_MemAllocate().
+* 1.6   Tejus   10/18/2020  Flush or drop active transaction on backend
+*			    switch and finish.
+* 1.7   Tejus   10/18/2020  Free register shadow on finish.
 * </pre>
 *
 ******************************************************************************/
@@ -33,6 +36,8 @@
 
 #include "xaie_helper.h"
 #include "xaie_io.h"
+#include "xaie_shadow.h"
+#include "xaie_txn.h"
 #include "xaiegbl.h"
 #include "xaiegbl_defs.h"
 #include "xaiegbl_regdef.h"
@@ -101,6 +106,8 @@ AieRC XAie_CfgInitialize(XAie_DevInst *InstPtr, XAie_Config *ConfigPtr)
 	InstPtr->AieTileRowStart = ConfigPtr->AieTileRowStart;
 	InstPtr->AieTileNumRows = ConfigPtr->AieTileNumRows;
 	InstPtr->EccStatus = XAIE_ENABLE;
+	InstPtr->TxnInst = XAIE_NULL;
+	InstPtr->ShadowInst = XAIE_NULL;
 
 	memcpy(&InstPtr->PartProp, &ConfigPtr->PartProp,
 		sizeof(ConfigPtr->PartProp));
@@ -137,6 +144,10 @@ AieRC XAie_Finish(XAie_DevInst *DevInst)
 		return XAIE_INVALID_ARGS;
 	}
 
+	/* Commands recorded but not submitted are dropped */
+	_XAie_TxnDiscard(DevInst);
+	(void)XAie_ShadowCacheDisable(DevInst);
+
 	CurrBackend = DevInst->Backend;
 	RC = CurrBackend->Ops.Finish(DevInst->IOInst);
 	if (RC != XAIE_OK) {
@@ -178,6 +189,14 @@ AieRC XAie_SetIOBackend(XAie_DevInst *DevInst, XAie_BackendType Backend)
 		return XAIE_INVALID_ARGS;
 	}
 
+	/* Issue recorded commands to the backend they were recorded for */
+	if(DevInst->TxnInst != XAIE_NULL) {
+		RC = _XAie_TxnFlush(DevInst);
+		if(RC != XAIE_OK) {
+			return RC;
+		}
+	}
+
 	/* Release resources for current backend */
 	CurrBackend = DevInst->Backend;
 	RC = CurrBackend->Ops.Finish((void *)(DevInst->IOInst));
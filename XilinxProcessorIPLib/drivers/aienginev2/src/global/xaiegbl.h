@@ -33,6 +33,8 @@
 * 2.1   Tejus   06/10/2020  Add IO backend data structures.
 * 2.2   Tejus   06/10/2020  Add ess simulation backend.
 * 2.3   Tejus   06/10/2020  Add api to change backend at runtime.
+* 2.4   Tejus   10/18/2020  Add transaction instance to device instance.
+* 2.5   Tejus   10/18/2020  Add register shadow instance to device instance.
 * </pre>
 *
 ******************************************************************************/
@@ -54,6 +56,8 @@ typedef struct XAie_TileMod XAie_TileMod;
 typedef struct XAie_DmaMod XAie_DmaMod;
 typedef struct XAie_LockMod XAie_LockMod;
 typedef struct XAie_Backend XAie_Backend;
+typedef struct XAie_TxnInst XAie_TxnInst;
+typedef struct XAie_ShadowInst XAie_ShadowInst;
 
 /*
  * This typedef captures all the properties of a AIE Device
@@ -114,6 +118,10 @@ typedef struct {
 	u32 CoreInUse[XAIE_TILES_BITMAP_SIZE];/* Bitmap for ECC status of PM */
 	const XAie_Backend *Backend; /* Backend IO properties */
 	void *IOInst;	       /* IO Instance for the backend */
+	XAie_TxnInst *TxnInst; /* Active transaction, NULL if IO is issued
+				  to the backend directly */
+	XAie_ShadowInst *ShadowInst; /* Configuration register shadow, NULL
+					if disabled */
 	XAie_DevProp DevProp; /* Pointer to the device property. To be
 				     setup to AIE prop during intialization*/
 	XAie_PartitionProp PartProp; /* Partition property */
@@ -0,0 +1,855 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_shadow.c
+* @{
+*
+* This file contains routines for the write-through shadow of the configuration
+* registers of a partition. When the shadow is enabled, the IO helpers keep the
+* last value written to stream switch, event broadcast, event group, L1
+* interrupt controller and tile DMA BD registers in a hash table. Reads of
+* those registers are served from the table, and mask writes become a local
+* update followed by a single write to the hardware. A write of the value a
+* register already holds is dropped, unless a transaction is recorded: the
+* transaction may be replayed on a partition in another state.
+*
+* Only registers which are not modified by the hardware are shadowed. Set and
+* clear style registers, such as interrupt enable and disable, and status
+* registers always go to the backend.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* 1.1   Tejus   10/18/2020 Drop writes of the value a register holds.
+* </pre>
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "xaie_helper.h"
+#include "xaie_shadow.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_SHADOW_INIT_SIZE		1024U
+
+#define XAIE_SHADOW_ENTRY_EMPTY		0U
+#define XAIE_SHADOW_ENTRY_VALID		1U
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This api adds a range of registers to the shadowed ranges of a tile type.
+*
+* @param	ShadowInst: Shadow instance.
+* @param	TileType: Tile type.
+* @param	Start: Start offset of the range within the tile.
+* @param	Size: Size of the range in bytes.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_ShadowAddRange(XAie_ShadowInst *ShadowInst, u8 TileType,
+		u32 Start, u32 Size)
+{
+	u32 Idx = ShadowInst->NumRanges[TileType];
+
+	if((Size == 0U) || (Idx >= XAIE_SHADOW_MAX_RANGES)) {
+		return;
+	}
+
+	ShadowInst->Ranges[TileType][Idx].Start = Start;
+	ShadowInst->Ranges[TileType][Idx].End = Start + Size;
+	ShadowInst->NumRanges[TileType]++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api adds the stream switch configuration registers of a tile type.
+*
+* @param	ShadowInst: Shadow instance.
+* @param	TileType: Tile type.
+* @param	StrmMod: Stream switch module of the tile type.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_ShadowAddStrmSw(XAie_ShadowInst *ShadowInst, u8 TileType,
+		const XAie_StrmMod *StrmMod)
+{
+	for(u8 i = 0U; i < SS_PORT_TYPE_MAX; i++) {
+		const XAie_StrmPort *Port;
+
+		Port = &StrmMod->MstrConfig[i];
+		_XAie_ShadowAddRange(ShadowInst, TileType, Port->PortBaseAddr,
+				Port->NumPorts * StrmMod->PortOffset);
+
+		Port = &StrmMod->SlvConfig[i];
+		_XAie_ShadowAddRange(ShadowInst, TileType, Port->PortBaseAddr,
+				Port->NumPorts * StrmMod->PortOffset);
+
+		Port = &StrmMod->SlvSlotConfig[i];
+		_XAie_ShadowAddRange(ShadowInst, TileType, Port->PortBaseAddr,
+				Port->NumPorts * StrmMod->SlotOffsetPerPort);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This api adds the event configuration registers of a tile type.
+*
+* @param	ShadowInst: Shadow instance.
+* @param	TileType: Tile type.
+* @param	EvntMod: Events module.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_ShadowAddEvents(XAie_ShadowInst *ShadowInst, u8 TileType,
+		const XAie_EvntMod *EvntMod)
+{
+	_XAie_ShadowAddRange(ShadowInst, TileType, EvntMod->BaseBroadcastRegOff,
+			EvntMod->NumBroadcastIds * 4U);
+	_XAie_ShadowAddRange(ShadowInst, TileType,
+			EvntMod->BaseGroupEventRegOff,
+			EvntMod->NumGroupEvents * 4U);
+	_XAie_ShadowAddRange(ShadowInst, TileType, EvntMod->ComboInputRegOff,
+			4U);
+	_XAie_ShadowAddRange(ShadowInst, TileType, EvntMod->ComboCtrlRegOff,
+			4U);
+
+	if(EvntMod->StrmPortSelectIdsPerReg != XAIE_FEATURE_UNAVAILABLE) {
+		_XAie_ShadowAddRange(ShadowInst, TileType,
+				EvntMod->BaseStrmPortSelectRegOff,
+				(EvntMod->NumStrmPortSelectIds /
+				 EvntMod->StrmPortSelectIdsPerReg) * 4U);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This api sorts the shadowed ranges of a tile type and merges adjacent ones.
+*
+* @param	ShadowInst: Shadow instance.
+* @param	TileType: Tile type.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_ShadowMergeRanges(XAie_ShadowInst *ShadowInst, u8 TileType)
+{
+	XAie_ShadowRange *Ranges = ShadowInst->Ranges[TileType];
+	u32 NumRanges = ShadowInst->NumRanges[TileType];
+	u32 Out = 0U;
+
+	/* Number of ranges is small, insertion sort is good enough */
+	for(u32 i = 1U; i < NumRanges; i++) {
+		XAie_ShadowRange Tmp = Ranges[i];
+		u32 j = i;
+
+		while((j > 0U) && (Ranges[j - 1U].Start > Tmp.Start)) {
+			Ranges[j] = Ranges[j - 1U];
+			j--;
+		}
+		Ranges[j] = Tmp;
+	}
+
+	for(u32 i = 0U; i < NumRanges; i++) {
+		if((Out > 0U) && (Ranges[i].Start <= Ranges[Out - 1U].End)) {
+			if(Ranges[i].End > Ranges[Out - 1U].End) {
+				Ranges[Out - 1U].End = Ranges[i].End;
+			}
+			continue;
+		}
+		Ranges[Out++] = Ranges[i];
+	}
+
+	ShadowInst->NumRanges[TileType] = Out;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api sets up the shadowed register ranges for all tile types from the
+* module properties of the device.
+*
+* @param	DevInst: Device Instance.
+* @param	ShadowInst: Shadow instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_ShadowSetupRanges(XAie_DevInst *DevInst,
+		XAie_ShadowInst *ShadowInst)
+{
+	for(u8 TileType = 0U; TileType < XAIEGBL_TILE_TYPE_MAX; TileType++) {
+		const XAie_TileMod *Mod = &DevInst->DevProp.DevMod[TileType];
+
+		if(Mod->StrmSw != NULL) {
+			_XAie_ShadowAddStrmSw(ShadowInst, TileType, Mod->StrmSw);
+		}
+
+		if(Mod->EvntMod != NULL) {
+			_XAie_ShadowAddEvents(ShadowInst, TileType,
+					&Mod->EvntMod[0U]);
+			if(TileType == XAIEGBL_TILE_TYPE_AIETILE) {
+				_XAie_ShadowAddEvents(ShadowInst, TileType,
+						&Mod->EvntMod[XAIE_CORE_MOD]);
+			}
+		}
+
+		if(Mod->L1IntrMod != NULL) {
+			const XAie_L1IntrMod *L1IntrMod = Mod->L1IntrMod;
+
+			/* Switch A and B of the first level controller */
+			for(u8 Sw = 0U; Sw < 2U; Sw++) {
+				_XAie_ShadowAddRange(ShadowInst, TileType,
+						L1IntrMod->BaseIrqRegOff +
+						Sw * L1IntrMod->SwOff, 4U);
+				_XAie_ShadowAddRange(ShadowInst, TileType,
+						L1IntrMod->BaseIrqEventRegOff +
+						Sw * L1IntrMod->SwOff, 4U);
+			}
+		}
+
+		/*
+		 * Shim DMA BDs are programmed by the kernel on some backends
+		 * and may hold translated addresses, only tile DMA BDs are
+		 * shadowed.
+		 */
+		if((TileType == XAIEGBL_TILE_TYPE_AIETILE) &&
+				(Mod->DmaMod != NULL)) {
+			_XAie_ShadowAddRange(ShadowInst, TileType,
+					Mod->DmaMod->BaseAddr,
+					Mod->DmaMod->NumBds *
+					Mod->DmaMod->IdxOffset);
+		}
+
+		_XAie_ShadowMergeRanges(ShadowInst, TileType);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This api returns the tile type of the tile a register belongs to.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset from the partition base address.
+*
+* @return	Tile type on success, XAIEGBL_TILE_TYPE_MAX if the register is
+*		outside of the partition.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static u8 _XAie_ShadowGetTileType(XAie_DevInst *DevInst, u64 RegOff)
+{
+	XAie_LocType Loc;
+
+	Loc.Col = (u8)(RegOff >> DevInst->DevProp.ColShift);
+	Loc.Row = (u8)((RegOff >> DevInst->DevProp.RowShift) &
+			((1U << (DevInst->DevProp.ColShift -
+				 DevInst->DevProp.RowShift)) - 1U));
+	if((Loc.Col >= DevInst->NumCols) || (Loc.Row >= DevInst->NumRows)) {
+		return XAIEGBL_TILE_TYPE_MAX;
+	}
+
+	return _XAie_GetTileTypefromLoc(DevInst, Loc);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api returns the shadowed range of a tile which contains a register.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset from the partition base address.
+*
+* @return	Pointer to the range on success, NULL if the register is not
+*		shadowed.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static const XAie_ShadowRange* _XAie_ShadowGetRange(XAie_DevInst *DevInst,
+		u64 RegOff)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	const XAie_ShadowRange *Ranges;
+	u32 TileOff, Low, High;
+	u8 TileType;
+
+	TileType = _XAie_ShadowGetTileType(DevInst, RegOff);
+	if(TileType >= XAIEGBL_TILE_TYPE_MAX) {
+		return NULL;
+	}
+
+	TileOff = (u32)(RegOff & ((1U << DevInst->DevProp.RowShift) - 1U));
+	Ranges = ShadowInst->Ranges[TileType];
+	Low = 0U;
+	High = ShadowInst->NumRanges[TileType];
+	while(Low < High) {
+		u32 Mid = (Low + High) / 2U;
+
+		if(TileOff < Ranges[Mid].Start) {
+			High = Mid;
+		} else if(TileOff >= Ranges[Mid].End) {
+			Low = Mid + 1U;
+		} else {
+			return &Ranges[Mid];
+		}
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api returns the slot of a register in the hash table. If the register is
+* not in the table, the empty slot where it would be inserted is returned.
+*
+* @param	ShadowInst: Shadow instance.
+* @param	RegOff: Register offset.
+*
+* @return	Pointer to the slot.
+*
+* @note		Internal only. The table always has free slots.
+*
+******************************************************************************/
+static XAie_ShadowEntry* _XAie_ShadowFindSlot(XAie_ShadowInst *ShadowInst,
+		u64 RegOff)
+{
+	u32 Mask = ShadowInst->Size - 1U;
+	u32 Idx = (u32)(((RegOff >> 2U) * 0x9E3779B97F4A7C15ULL) >> 32U) & Mask;
+
+	while(1) {
+		XAie_ShadowEntry *Entry = &ShadowInst->Entries[Idx];
+
+		if((Entry->State == XAIE_SHADOW_ENTRY_EMPTY) ||
+				(Entry->RegOff == RegOff)) {
+			return Entry;
+		}
+		Idx = (Idx + 1U) & Mask;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This api doubles the size of the hash table.
+*
+* @param	ShadowInst: Shadow instance.
+*
+* @return	XAIE_OK on success, XAIE_ERR on allocation failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static AieRC _XAie_ShadowGrow(XAie_ShadowInst *ShadowInst)
+{
+	XAie_ShadowEntry *Old = ShadowInst->Entries;
+	u32 OldSize = ShadowInst->Size;
+
+	ShadowInst->Entries = (XAie_ShadowEntry *)calloc(OldSize * 2U,
+			sizeof(*Old));
+	if(ShadowInst->Entries == NULL) {
+		ShadowInst->Entries = Old;
+		return XAIE_ERR;
+	}
+	ShadowInst->Size = OldSize * 2U;
+
+	for(u32 i = 0U; i < OldSize; i++) {
+		if(Old[i].State == XAIE_SHADOW_ENTRY_VALID) {
+			*_XAie_ShadowFindSlot(ShadowInst, Old[i].RegOff) =
+				Old[i];
+		}
+	}
+	free(Old);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api stores the value of a register in the hash table.
+*
+* @param	ShadowInst: Shadow instance.
+* @param	RegOff: Register offset.
+* @param	Value: Register value.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_ShadowStore(XAie_ShadowInst *ShadowInst, u64 RegOff,
+		u32 Value)
+{
+	XAie_ShadowEntry *Entry;
+
+	Entry = _XAie_ShadowFindSlot(ShadowInst, RegOff);
+	if(Entry->State == XAIE_SHADOW_ENTRY_EMPTY) {
+		/* Keep load factor below 3/4 */
+		if(((ShadowInst->NumUsed + 1U) * 4U) > (ShadowInst->Size * 3U)) {
+			if(_XAie_ShadowGrow(ShadowInst) != XAIE_OK) {
+				/* Table full, the register is not shadowed */
+				return;
+			}
+			Entry = _XAie_ShadowFindSlot(ShadowInst, RegOff);
+		}
+		Entry->RegOff = RegOff;
+		Entry->State = XAIE_SHADOW_ENTRY_VALID;
+		ShadowInst->NumUsed++;
+	}
+	Entry->Value = Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api looks up the value of a register in the hash table.
+*
+* @param	ShadowInst: Shadow instance.
+* @param	RegOff: Register offset.
+* @param	Value: Pointer to store the register value.
+*
+* @return	XAIE_OK if the register is in the table, XAIE_ERR otherwise.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static AieRC _XAie_ShadowLookup(XAie_ShadowInst *ShadowInst, u64 RegOff,
+		u32 *Value)
+{
+	XAie_ShadowEntry *Entry;
+
+	Entry = _XAie_ShadowFindSlot(ShadowInst, RegOff);
+	if(Entry->State != XAIE_SHADOW_ENTRY_VALID) {
+		return XAIE_ERR;
+	}
+
+	*Value = Entry->Value;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api updates the shadow for a register write.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Value: Value written to the register.
+*
+* @return	XAIE_OK if the register already holds the value and the write
+*		can be dropped, XAIE_ERR if it has to be issued.
+*
+* @note		Internal only. Called by XAie_Write32().
+*
+******************************************************************************/
+AieRC _XAie_ShadowWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	XAie_ShadowEntry *Entry;
+
+	if(_XAie_ShadowGetRange(DevInst, RegOff) == NULL) {
+		return XAIE_ERR;
+	}
+
+	ShadowInst->Stats.Writes++;
+	Entry = _XAie_ShadowFindSlot(ShadowInst, RegOff);
+	if((DevInst->TxnInst == XAIE_NULL) &&
+			(Entry->State == XAIE_SHADOW_ENTRY_VALID) &&
+			(Entry->Value == Value)) {
+		ShadowInst->Stats.WriteHits++;
+		return XAIE_OK;
+	}
+
+	_XAie_ShadowStore(ShadowInst, RegOff, Value);
+
+	return XAIE_ERR;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api reads a register from the shadow.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Value: Pointer to store the register value.
+*
+* @return	XAIE_OK if the read was served from the shadow, XAIE_ERR if
+*		the register has to be read from the hardware.
+*
+* @note		Internal only. Called by XAie_Read32().
+*
+******************************************************************************/
+AieRC _XAie_ShadowRead32(XAie_DevInst *DevInst, u64 RegOff, u32 *Value)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+
+	if(_XAie_ShadowLookup(ShadowInst, RegOff, Value) == XAIE_OK) {
+		ShadowInst->Stats.ReadHits++;
+		return XAIE_OK;
+	}
+
+	return XAIE_ERR;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api stores a value read from the hardware in the shadow if the register
+* is shadowed.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Value: Value read from the hardware.
+*
+* @return	None.
+*
+* @note		Internal only. Called by XAie_Read32().
+*
+******************************************************************************/
+void _XAie_ShadowFill32(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+
+	if(_XAie_ShadowGetRange(DevInst, RegOff) == NULL) {
+		return;
+	}
+
+	ShadowInst->Stats.ReadMisses++;
+	_XAie_ShadowStore(ShadowInst, RegOff, Value);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api computes the full register value for a mask write from the shadow.
+* On a miss outside of a transaction, the register is read from the hardware
+* once and kept in the shadow.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Mask: Mask to be applied to Value.
+* @param	Value: Value to write.
+* @param	RegVal: Pointer to store the full register value to write.
+*
+* @return	XAIE_OK if the mask write can be issued as a write of RegVal,
+*		XAIE_ERR if it has to be issued as a mask write.
+*
+* @note		Internal only. Called by XAie_MaskWrite32().
+*
+******************************************************************************/
+AieRC _XAie_ShadowMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 *RegVal)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	u32 OldVal;
+
+	if(_XAie_ShadowLookup(ShadowInst, RegOff, &OldVal) == XAIE_OK) {
+		ShadowInst->Stats.MaskWriteHits++;
+		*RegVal = (OldVal & ~Mask) | (Value & Mask);
+		return XAIE_OK;
+	}
+
+	/* Reading hardware would flush the recorded transaction */
+	if((DevInst->TxnInst != XAIE_NULL) ||
+			(_XAie_ShadowGetRange(DevInst, RegOff) == NULL)) {
+		return XAIE_ERR;
+	}
+
+	ShadowInst->Stats.MaskWriteMisses++;
+	OldVal = DevInst->Backend->Ops.Read32(DevInst->IOInst, RegOff);
+	*RegVal = (OldVal & ~Mask) | (Value & Mask);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api updates the shadow for the shadowed words of a block write.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Data: Pointer to the data buffer, NULL for a block set.
+* @param	Value: Value of a block set.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_ShadowBlockUpdate(XAie_DevInst *DevInst, u64 RegOff,
+		u32 *Data, u32 Value, u32 Size)
+{
+	XAie_ShadowInst *ShadowInst = DevInst->ShadowInst;
+	u32 TileSize = 1U << DevInst->DevProp.RowShift;
+	u32 i = 0U;
+
+	/*
+	 * Intersect the block with the shadowed ranges of each tile it covers
+	 * instead of looking up every word, block writes are mostly program
+	 * and data memory which is not shadowed.
+	 */
+	while(i < Size) {
+		u64 Off = RegOff + (u64)i * 4U;
+		u32 TileOff = (u32)(Off & (TileSize - 1U));
+		u32 Words = (TileSize - TileOff) / 4U;
+		u8 TileType;
+
+		if(Words > (Size - i)) {
+			Words = Size - i;
+		}
+
+		TileType = _XAie_ShadowGetTileType(DevInst, Off);
+		if(TileType < XAIEGBL_TILE_TYPE_MAX) {
+			for(u32 r = 0U; r < ShadowInst->NumRanges[TileType];
+					r++) {
+				const XAie_ShadowRange *Range;
+				u32 Start, End;
+
+				Range = &ShadowInst->Ranges[TileType][r];
+				Start = (Range->Start > TileOff) ?
+					Range->Start : TileOff;
+				End = (Range->End < (TileOff + Words * 4U)) ?
+					Range->End : (TileOff + Words * 4U);
+
+				for(u32 o = Start; o < End; o += 4U) {
+					u32 Idx = i + (o - TileOff) / 4U;
+
+					ShadowInst->Stats.Writes++;
+					_XAie_ShadowStore(ShadowInst,
+							Off - TileOff + o,
+							(Data != NULL) ?
+							Data[Idx] : Value);
+				}
+			}
+		}
+
+		i += Words;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This api updates the shadow for a block write.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Data: Pointer to the data buffer.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only. Called by XAie_BlockWrite32().
+*
+******************************************************************************/
+void _XAie_ShadowBlockWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	_XAie_ShadowBlockUpdate(DevInst, RegOff, Data, 0U, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api updates the shadow for a block set.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Data: Value to initialize the address range with.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only. Called by XAie_BlockSet32().
+*
+******************************************************************************/
+void _XAie_ShadowBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	_XAie_ShadowBlockUpdate(DevInst, RegOff, NULL, Data, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api enables the write-through shadow of configuration registers for the
+* partition. The shadow starts empty and is populated by writes and by the first
+* read of each register.
+*
+* @param	DevInst: Device Instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Registers written behind the back of the driver, for example
+*		by another process sharing the partition, are not seen by the
+*		shadow. Call XAie_ShadowCacheInvalidate() in that case.
+*
+******************************************************************************/
+AieRC XAie_ShadowCacheEnable(XAie_DevInst *DevInst)
+{
+	XAie_ShadowInst *ShadowInst;
+
+	if((DevInst == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->ShadowInst != XAIE_NULL) {
+		return XAIE_OK;
+	}
+
+	ShadowInst = (XAie_ShadowInst *)calloc(1U, sizeof(*ShadowInst));
+	if(ShadowInst == NULL) {
+		XAIE_ERROR("Failed to allocate shadow instance\n");
+		return XAIE_ERR;
+	}
+
+	ShadowInst->Entries = (XAie_ShadowEntry *)calloc(XAIE_SHADOW_INIT_SIZE,
+			sizeof(*ShadowInst->Entries));
+	if(ShadowInst->Entries == NULL) {
+		XAIE_ERROR("Failed to allocate shadow table\n");
+		free(ShadowInst);
+		return XAIE_ERR;
+	}
+	ShadowInst->Size = XAIE_SHADOW_INIT_SIZE;
+
+	_XAie_ShadowSetupRanges(DevInst, ShadowInst);
+	DevInst->ShadowInst = ShadowInst;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api disables the shadow and frees its memory.
+*
+* @param	DevInst: Device Instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_ShadowCacheDisable(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->ShadowInst != XAIE_NULL) {
+		free(DevInst->ShadowInst->Entries);
+		free(DevInst->ShadowInst);
+		DevInst->ShadowInst = XAIE_NULL;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api drops all the register values held in the shadow. The statistics
+* are preserved.
+*
+* @param	DevInst: Device Instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Called by XAie_ResetPartition().
+*
+******************************************************************************/
+AieRC XAie_ShadowCacheInvalidate(XAie_DevInst *DevInst)
+{
+	XAie_ShadowInst *ShadowInst;
+
+	if((DevInst == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	ShadowInst = DevInst->ShadowInst;
+	if(ShadowInst == XAIE_NULL) {
+		return XAIE_OK;
+	}
+
+	memset(ShadowInst->Entries, 0, ShadowInst->Size *
+			sizeof(*ShadowInst->Entries));
+	ShadowInst->NumUsed = 0U;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api returns the hit and miss counters of the shadow.
+*
+* @param	DevInst: Device Instance.
+* @param	Stats: Pointer to store the statistics.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		ReadHits + MaskWriteHits is the number of register reads
+*		saved by the shadow.
+*
+******************************************************************************/
+AieRC XAie_ShadowCacheGetStats(XAie_DevInst *DevInst, XAie_ShadowStats *Stats)
+{
+	if((DevInst == XAIE_NULL) || (Stats == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->ShadowInst == XAIE_NULL) {
+		XAIE_ERROR("Shadow cache is not enabled\n");
+		return XAIE_ERR;
+	}
+
+	*Stats = DevInst->ShadowInst->Stats;
+	Stats->NumEntries = DevInst->ShadowInst->NumUsed;
+
+	return XAIE_OK;
+}
+
+/** @} */
@@ -0,0 +1,97 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_shadow.h
+* @{
+*
+* This file contains the data structures and routines for the write-through
+* shadow of the configuration registers of a partition.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* 1.1   Tejus   10/18/2020 Count the writes dropped by the shadow.
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIE_SHADOW_H
+#define XAIE_SHADOW_H
+
+/***************************** Include Files *********************************/
+#include "xaiegbl.h"
+#include "xaiegbl_defs.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_SHADOW_MAX_RANGES		64U
+
+/****************************** Type Definitions *****************************/
+/*
+ * Typedef for structure to capture the shadow cache statistics
+ */
+typedef struct {
+	u64 ReadHits;		/* Reads served from the shadow */
+	u64 ReadMisses;		/* Reads of shadowed registers from hardware */
+	u64 MaskWriteHits;	/* Mask writes issued as plain writes */
+	u64 MaskWriteMisses;	/* Mask writes which had to read hardware */
+	u64 Writes;		/* Writes to shadowed registers */
+	u64 WriteHits;		/* Writes dropped, the register held the value */
+	u32 NumEntries;		/* Registers currently held in the shadow */
+} XAie_ShadowStats;
+
+/*
+ * Typedef for structure to capture a range of shadowed registers within a tile
+ */
+typedef struct {
+	u32 Start;
+	u32 End;
+} XAie_ShadowRange;
+
+/*
+ * Typedef for structure to capture one shadowed register
+ */
+typedef struct {
+	u64 RegOff;
+	u32 Value;
+	u8 State;
+} XAie_ShadowEntry;
+
+/*
+ * Typedef for structure to capture the shadow of a partition
+ */
+struct XAie_ShadowInst {
+	u32 NumRanges[XAIEGBL_TILE_TYPE_MAX];
+	XAie_ShadowRange Ranges[XAIEGBL_TILE_TYPE_MAX][XAIE_SHADOW_MAX_RANGES];
+	u32 Size;		/* Number of slots, power of 2 */
+	u32 NumUsed;		/* Number of occupied slots */
+	XAie_ShadowEntry *Entries;
+	XAie_ShadowStats Stats;
+};
+
+/************************** Function Prototypes  *****************************/
+AieRC XAie_ShadowCacheEnable(XAie_DevInst *DevInst);
+AieRC XAie_ShadowCacheDisable(XAie_DevInst *DevInst);
+AieRC XAie_ShadowCacheInvalidate(XAie_DevInst *DevInst);
+AieRC XAie_ShadowCacheGetStats(XAie_DevInst *DevInst, XAie_ShadowStats *Stats);
+
+/* Internal APIs used by the IO helpers */
+AieRC _XAie_ShadowWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value);
+AieRC _XAie_ShadowRead32(XAie_DevInst *DevInst, u64 RegOff, u32 *Value);
+void _XAie_ShadowFill32(XAie_DevInst *DevInst, u64 RegOff, u32 Value);
+AieRC _XAie_ShadowMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 *RegVal);
+void _XAie_ShadowBlockWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data,
+		u32 Size);
+void _XAie_ShadowBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size);
+
+#endif	/* End of protection macro */
+
+/** @} */
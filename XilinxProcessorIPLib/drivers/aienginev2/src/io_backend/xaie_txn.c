@@ -0,0 +1,766 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_txn.c
+* @{
+*
+* This file contains routines to record register IO operations of a partition
+* into a transaction buffer and to submit them to the IO backend. While a
+* transaction is active, the IO helpers append operations to the buffer instead
+* of calling the backend. Writes to consecutive registers are coalesced into
+* block writes so that the backend sees a few large operations instead of many
+* small ones.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* </pre>
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_shadow.h"
+#include "xaie_txn.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_TXN_INIT_CMDS		64U
+#define XAIE_TXN_INIT_WORDS		256U
+#define XAIE_TXN_DEDUP_WINDOW		16U
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This api allocates and initializes a transaction instance.
+*
+* @param	Flags: Transaction flags.
+*
+* @return	Pointer to transaction instance on success, NULL on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static XAie_TxnInst* _XAie_TxnAlloc(u32 Flags)
+{
+	XAie_TxnInst *TxnInst;
+
+	TxnInst = (XAie_TxnInst *)calloc(1U, sizeof(*TxnInst));
+	if(TxnInst == NULL) {
+		XAIE_ERROR("Failed to allocate transaction instance\n");
+		return NULL;
+	}
+
+	TxnInst->CmdBuf = (XAie_TxnCmd *)malloc(XAIE_TXN_INIT_CMDS *
+			sizeof(*TxnInst->CmdBuf));
+	TxnInst->DataBuf = (u32 *)malloc(XAIE_TXN_INIT_WORDS * sizeof(u32));
+	if((TxnInst->CmdBuf == NULL) || (TxnInst->DataBuf == NULL)) {
+		XAIE_ERROR("Failed to allocate transaction buffers\n");
+		free(TxnInst->CmdBuf);
+		free(TxnInst->DataBuf);
+		free(TxnInst);
+		return NULL;
+	}
+
+	TxnInst->Flags = Flags;
+	TxnInst->MaxCmds = XAIE_TXN_INIT_CMDS;
+	TxnInst->MaxWords = XAIE_TXN_INIT_WORDS;
+
+	return TxnInst;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api makes sure there is space for one more command and NumWords more
+* payload words in the transaction buffers. Buffers grow by doubling.
+*
+* @param	TxnInst: Transaction instance.
+* @param	NumWords: Number of payload words required.
+*
+* @return	XAIE_OK on success, XAIE_ERR on allocation failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static AieRC _XAie_TxnReserve(XAie_TxnInst *TxnInst, u32 NumWords)
+{
+	if(TxnInst->NumCmds == TxnInst->MaxCmds) {
+		XAie_TxnCmd *Tmp;
+		u32 MaxCmds = TxnInst->MaxCmds * 2U;
+
+		Tmp = (XAie_TxnCmd *)realloc(TxnInst->CmdBuf,
+				MaxCmds * sizeof(*Tmp));
+		if(Tmp == NULL) {
+			return XAIE_ERR;
+		}
+		TxnInst->CmdBuf = Tmp;
+		TxnInst->MaxCmds = MaxCmds;
+	}
+
+	if((TxnInst->MaxWords - TxnInst->NumWords) < NumWords) {
+		u32 *Tmp;
+		u32 MaxWords = TxnInst->MaxWords;
+
+		while((MaxWords - TxnInst->NumWords) < NumWords) {
+			MaxWords *= 2U;
+		}
+
+		Tmp = (u32 *)realloc(TxnInst->DataBuf, MaxWords * sizeof(u32));
+		if(Tmp == NULL) {
+			return XAIE_ERR;
+		}
+		TxnInst->DataBuf = Tmp;
+		TxnInst->MaxWords = MaxWords;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api issues the recorded commands of a transaction to the backend.
+*
+* @param	DevInst: Device Instance.
+* @param	TxnInst: Transaction instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_TxnReplay(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst)
+{
+	const XAie_BackendOps *Ops = &DevInst->Backend->Ops;
+	void *IOInst = DevInst->IOInst;
+
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
+
+		switch(Cmd->Opcode) {
+		case XAIE_TXN_OP_WRITE:
+			Ops->Write32(IOInst, Cmd->RegOff, Cmd->Value);
+			break;
+		case XAIE_TXN_OP_BLOCKWRITE:
+			if(Cmd->Size == 1U) {
+				Ops->Write32(IOInst, Cmd->RegOff,
+						TxnInst->DataBuf[Cmd->DataOff]);
+			} else {
+				Ops->BlockWrite32(IOInst, Cmd->RegOff,
+						&TxnInst->DataBuf[Cmd->DataOff],
+						Cmd->Size);
+			}
+			break;
+		case XAIE_TXN_OP_BLOCKSET:
+			Ops->BlockSet32(IOInst, Cmd->RegOff, Cmd->Value,
+					Cmd->Size);
+			break;
+		case XAIE_TXN_OP_MASKWRITE:
+			Ops->MaskWrite32(IOInst, Cmd->RegOff, Cmd->Mask,
+					Cmd->Value);
+			break;
+		default:
+			XAIE_ERROR("Invalid transaction opcode %u\n",
+					Cmd->Opcode);
+			break;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This api looks back through the most recent commands for the last value
+* recorded for a register. Only writes with a known full register value are
+* considered, the search stops at any other operation touching the register.
+*
+* @param	TxnInst: Transaction instance.
+* @param	RegOff: Register offset.
+* @param	Value: Pointer to store the recorded value.
+*
+* @return	XAIE_OK if a value was found, XAIE_ERR otherwise.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static AieRC _XAie_TxnLookupValue(XAie_TxnInst *TxnInst, u64 RegOff,
+		u32 *Value)
+{
+	u32 Window = XAIE_TXN_DEDUP_WINDOW;
+
+	for(u32 i = TxnInst->NumCmds; (i > 0U) && (Window > 0U); i--, Window--) {
+		XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i - 1U];
+		u64 End = Cmd->RegOff + ((u64)Cmd->Size * 4U);
+
+		switch(Cmd->Opcode) {
+		case XAIE_TXN_OP_WRITE:
+		case XAIE_TXN_OP_MASKWRITE:
+			if(Cmd->RegOff != RegOff) {
+				continue;
+			}
+			if(Cmd->Opcode == XAIE_TXN_OP_MASKWRITE) {
+				return XAIE_ERR;
+			}
+			*Value = Cmd->Value;
+			return XAIE_OK;
+		case XAIE_TXN_OP_BLOCKWRITE:
+			if((RegOff < Cmd->RegOff) || (RegOff >= End)) {
+				continue;
+			}
+			*Value = TxnInst->DataBuf[Cmd->DataOff +
+				(u32)((RegOff - Cmd->RegOff) / 4U)];
+			return XAIE_OK;
+		case XAIE_TXN_OP_BLOCKSET:
+			if((RegOff < Cmd->RegOff) || (RegOff >= End)) {
+				continue;
+			}
+			*Value = Cmd->Value;
+			return XAIE_OK;
+		default:
+			return XAIE_ERR;
+		}
+	}
+
+	return XAIE_ERR;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api is called when a command cannot be recorded because the transaction
+* buffers can't grow. The recorded commands are flushed so that the caller can
+* issue the operation to the backend directly without reordering.
+*
+* @param	DevInst: Device Instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_TxnFallback(XAie_DevInst *DevInst)
+{
+	XAIE_ERROR("Failed to grow transaction buffer, flushing\n");
+	(void)_XAie_TxnFlush(DevInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api records a 32-bit register write in the active transaction.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Value: Value to write.
+*
+* @return	None.
+*
+* @note		Internal only. Called by XAie_Write32().
+*
+******************************************************************************/
+void _XAie_TxnWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	XAie_TxnCmd *Cmd;
+	u32 OldValue;
+
+	TxnInst->NumRecordedOps++;
+
+	if((TxnInst->Flags & XAIE_TRANSACTION_ENABLE_DEDUP) &&
+			(_XAie_TxnLookupValue(TxnInst, RegOff, &OldValue) ==
+			 XAIE_OK) && (OldValue == Value)) {
+		TxnInst->NumDroppedOps++;
+		return;
+	}
+
+	if(TxnInst->NumCmds > 0U) {
+		Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds - 1U];
+
+		if((TxnInst->Flags & XAIE_TRANSACTION_ENABLE_DEDUP) &&
+				(Cmd->Opcode == XAIE_TXN_OP_WRITE) &&
+				(Cmd->RegOff == RegOff)) {
+			/* Back to back writes, last one wins */
+			Cmd->Value = Value;
+			TxnInst->NumDroppedOps++;
+			return;
+		}
+
+		/*
+		 * Extend the last block write, or turn the last single write
+		 * into a block write, if this write continues it. The payload
+		 * of the last block write is always at the end of DataBuf.
+		 */
+		if((TxnInst->Flags & XAIE_TRANSACTION_ENABLE_COALESCE) &&
+				((Cmd->Opcode == XAIE_TXN_OP_WRITE) ||
+				 (Cmd->Opcode == XAIE_TXN_OP_BLOCKWRITE)) &&
+				((Cmd->RegOff + (u64)Cmd->Size * 4U) == RegOff) &&
+				((Cmd->Opcode == XAIE_TXN_OP_WRITE) ||
+				 ((Cmd->DataOff + Cmd->Size) ==
+				  TxnInst->NumWords))) {
+			u32 Need = (Cmd->Opcode == XAIE_TXN_OP_WRITE) ? 2U : 1U;
+
+			if((TxnInst->MaxWords - TxnInst->NumWords) < Need) {
+				if(_XAie_TxnReserve(TxnInst, Need) != XAIE_OK) {
+					_XAie_TxnFallback(DevInst);
+					DevInst->Backend->Ops.Write32(
+							DevInst->IOInst,
+							RegOff, Value);
+					return;
+				}
+				Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds - 1U];
+			}
+
+			if(Cmd->Opcode == XAIE_TXN_OP_WRITE) {
+				Cmd->Opcode = XAIE_TXN_OP_BLOCKWRITE;
+				Cmd->DataOff = TxnInst->NumWords;
+				TxnInst->DataBuf[TxnInst->NumWords++] =
+					Cmd->Value;
+			}
+			TxnInst->DataBuf[TxnInst->NumWords++] = Value;
+			Cmd->Size++;
+			return;
+		}
+	}
+
+	if(_XAie_TxnReserve(TxnInst, 0U) != XAIE_OK) {
+		_XAie_TxnFallback(DevInst);
+		DevInst->Backend->Ops.Write32(DevInst->IOInst, RegOff, Value);
+		return;
+	}
+
+	Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds++];
+	Cmd->Opcode = XAIE_TXN_OP_WRITE;
+	Cmd->Mask = 0U;
+	Cmd->RegOff = RegOff;
+	Cmd->Value = Value;
+	Cmd->DataOff = 0U;
+	Cmd->Size = 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api records a masked 32-bit register write in the active transaction.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Mask: Mask to be applied to Value.
+* @param	Value: Value to write.
+*
+* @return	None.
+*
+* @note		Internal only. Called by XAie_MaskWrite32().
+*
+******************************************************************************/
+void _XAie_TxnMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	XAie_TxnCmd *Cmd;
+
+	TxnInst->NumRecordedOps++;
+
+	if((TxnInst->Flags & XAIE_TRANSACTION_ENABLE_DEDUP) &&
+			(TxnInst->NumCmds > 0U)) {
+		Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds - 1U];
+
+		if((Cmd->RegOff == RegOff) &&
+				((Cmd->Opcode == XAIE_TXN_OP_WRITE) ||
+				 (Cmd->Opcode == XAIE_TXN_OP_MASKWRITE))) {
+			/* Fold into the previous operation on the register */
+			Cmd->Value = (Cmd->Value & ~Mask) | (Value & Mask);
+			if(Cmd->Opcode == XAIE_TXN_OP_MASKWRITE) {
+				Cmd->Mask |= Mask;
+			}
+			TxnInst->NumDroppedOps++;
+			return;
+		}
+	}
+
+	if(_XAie_TxnReserve(TxnInst, 0U) != XAIE_OK) {
+		_XAie_TxnFallback(DevInst);
+		DevInst->Backend->Ops.MaskWrite32(DevInst->IOInst, RegOff, Mask,
+				Value);
+		return;
+	}
+
+	Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds++];
+	Cmd->Opcode = XAIE_TXN_OP_MASKWRITE;
+	Cmd->Mask = Mask;
+	Cmd->RegOff = RegOff;
+	Cmd->Value = Value & Mask;
+	Cmd->DataOff = 0U;
+	Cmd->Size = 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api records a block write in the active transaction. The payload is
+* copied, the caller may reuse the buffer after the call returns.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Data: Pointer to the data buffer.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only. Called by XAie_BlockWrite32().
+*
+******************************************************************************/
+void _XAie_TxnBlockWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	XAie_TxnCmd *Cmd;
+
+	if(Size == 0U) {
+		return;
+	}
+
+	TxnInst->NumRecordedOps++;
+
+	if(_XAie_TxnReserve(TxnInst, Size + 1U) != XAIE_OK) {
+		_XAie_TxnFallback(DevInst);
+		DevInst->Backend->Ops.BlockWrite32(DevInst->IOInst, RegOff,
+				Data, Size);
+		return;
+	}
+
+	if((TxnInst->Flags & XAIE_TRANSACTION_ENABLE_COALESCE) &&
+			(TxnInst->NumCmds > 0U)) {
+		Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds - 1U];
+
+		if((Cmd->RegOff + (u64)Cmd->Size * 4U) == RegOff) {
+			if(Cmd->Opcode == XAIE_TXN_OP_WRITE) {
+				Cmd->Opcode = XAIE_TXN_OP_BLOCKWRITE;
+				Cmd->DataOff = TxnInst->NumWords;
+				TxnInst->DataBuf[TxnInst->NumWords++] =
+					Cmd->Value;
+			}
+
+			if((Cmd->Opcode == XAIE_TXN_OP_BLOCKWRITE) &&
+					((Cmd->DataOff + Cmd->Size) ==
+					 TxnInst->NumWords)) {
+				memcpy(&TxnInst->DataBuf[TxnInst->NumWords],
+						Data, Size * sizeof(u32));
+				TxnInst->NumWords += Size;
+				Cmd->Size += Size;
+				return;
+			}
+		}
+	}
+
+	Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds++];
+	Cmd->Opcode = XAIE_TXN_OP_BLOCKWRITE;
+	Cmd->Mask = 0U;
+	Cmd->RegOff = RegOff;
+	Cmd->Value = 0U;
+	Cmd->DataOff = TxnInst->NumWords;
+	Cmd->Size = Size;
+
+	memcpy(&TxnInst->DataBuf[TxnInst->NumWords], Data, Size * sizeof(u32));
+	TxnInst->NumWords += Size;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api records a block set in the active transaction.
+*
+* @param	DevInst: Device Instance.
+* @param	RegOff: Register offset.
+* @param	Data: Value to initialize the address range with.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only. Called by XAie_BlockSet32().
+*
+******************************************************************************/
+void _XAie_TxnBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+	XAie_TxnCmd *Cmd;
+
+	if(Size == 0U) {
+		return;
+	}
+
+	TxnInst->NumRecordedOps++;
+
+	if(_XAie_TxnReserve(TxnInst, 0U) != XAIE_OK) {
+		_XAie_TxnFallback(DevInst);
+		DevInst->Backend->Ops.BlockSet32(DevInst->IOInst, RegOff, Data,
+				Size);
+		return;
+	}
+
+	Cmd = &TxnInst->CmdBuf[TxnInst->NumCmds++];
+	Cmd->Opcode = XAIE_TXN_OP_BLOCKSET;
+	Cmd->Mask = 0U;
+	Cmd->RegOff = RegOff;
+	Cmd->Value = Data;
+	Cmd->DataOff = 0U;
+	Cmd->Size = Size;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api issues all the commands recorded so far in the active transaction
+* to the backend and empties the buffers. Recording continues afterwards.
+*
+* @param	DevInst: Device Instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_TxnFlush(XAie_DevInst *DevInst)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+
+	if(TxnInst == XAIE_NULL) {
+		return XAIE_ERR;
+	}
+
+	/*
+	 * Detach the transaction while replaying so that the IO issued by the
+	 * backend itself is not recorded again.
+	 */
+	DevInst->TxnInst = XAIE_NULL;
+	_XAie_TxnReplay(DevInst, TxnInst);
+	DevInst->TxnInst = TxnInst;
+
+	if(TxnInst->NumCmds > 0U) {
+		TxnInst->NumFlushes++;
+	}
+	TxnInst->NumCmds = 0U;
+	TxnInst->NumWords = 0U;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api is called by the IO helpers before an operation which depends on
+* the state of the hardware, such as a read or a poll. Unless auto flush is
+* disabled for the transaction, the recorded commands are flushed first.
+*
+* @param	DevInst: Device Instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_TxnAutoFlush(XAie_DevInst *DevInst)
+{
+	XAie_TxnInst *TxnInst = DevInst->TxnInst;
+
+	if(TxnInst->Flags & XAIE_TRANSACTION_DISABLE_AUTO_FLUSH) {
+		return;
+	}
+
+	(void)_XAie_TxnFlush(DevInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api drops the active transaction without issuing the recorded commands.
+*
+* @param	DevInst: Device Instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_TxnDiscard(XAie_DevInst *DevInst)
+{
+	if(DevInst->TxnInst != XAIE_NULL) {
+		XAIE_DBG("Discarding %u transaction commands\n",
+				DevInst->TxnInst->NumCmds);
+		(void)XAie_FreeTransactionInstance(DevInst->TxnInst);
+		DevInst->TxnInst = XAIE_NULL;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This api starts recording register IO operations of the partition. Until the
+* transaction is submitted or exported, register writes issued by the driver
+* apis are buffered in memory instead of being issued to the backend.
+*
+* @param	DevInst: Device Instance.
+* @param	Flags: Transaction flags. XAIE_TRANSACTION_DEFAULT or a
+*		combination of XAIE_TRANSACTION_* flags.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Only one transaction can be active per device instance.
+*
+******************************************************************************/
+AieRC XAie_StartTransaction(XAie_DevInst *DevInst, u32 Flags)
+{
+	if((DevInst == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->TxnInst != XAIE_NULL) {
+		XAIE_ERROR("Transaction is already in progress\n");
+		return XAIE_ERR;
+	}
+
+	DevInst->TxnInst = _XAie_TxnAlloc(Flags);
+	if(DevInst->TxnInst == XAIE_NULL) {
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api submits a transaction to the backend of the device instance.
+*
+* @param	DevInst: Device Instance.
+* @param	TxnInst: Transaction instance returned by
+*		XAie_ExportTransaction() to replay, or NULL to submit and end
+*		the active transaction of the device instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		An exported transaction is not freed by this api and can be
+*		submitted any number of times.
+*
+******************************************************************************/
+AieRC XAie_SubmitTransaction(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst)
+{
+	XAie_TxnInst *ActiveTxn;
+
+	if((DevInst == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(TxnInst == XAIE_NULL) {
+		if(DevInst->TxnInst == XAIE_NULL) {
+			XAIE_ERROR("No transaction in progress\n");
+			return XAIE_ERR;
+		}
+
+		(void)_XAie_TxnFlush(DevInst);
+		_XAie_TxnDiscard(DevInst);
+
+		return XAIE_OK;
+	}
+
+	/* Keep order with commands recorded in an active transaction */
+	ActiveTxn = DevInst->TxnInst;
+	if(ActiveTxn != XAIE_NULL) {
+		(void)_XAie_TxnFlush(DevInst);
+		DevInst->TxnInst = XAIE_NULL;
+	}
+
+	_XAie_TxnReplay(DevInst, TxnInst);
+	DevInst->TxnInst = ActiveTxn;
+
+	/* Replayed writes bypass the register shadow */
+	(void)XAie_ShadowCacheInvalidate(DevInst);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api ends the active transaction without issuing it to the backend and
+* hands the recorded commands to the caller. The returned instance can be
+* submitted to any device instance with XAie_SubmitTransaction().
+*
+* @param	DevInst: Device Instance.
+*
+* @return	Pointer to transaction instance on success, NULL on failure.
+*
+* @note		The caller must free the instance with
+*		XAie_FreeTransactionInstance().
+*
+******************************************************************************/
+XAie_TxnInst* XAie_ExportTransaction(XAie_DevInst *DevInst)
+{
+	XAie_TxnInst *TxnInst;
+
+	if((DevInst == XAIE_NULL) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return NULL;
+	}
+
+	TxnInst = DevInst->TxnInst;
+	if(TxnInst == XAIE_NULL) {
+		XAIE_ERROR("No transaction in progress\n");
+		return NULL;
+	}
+
+	DevInst->TxnInst = XAIE_NULL;
+
+	/*
+	 * The register shadow was updated with the recorded writes, which
+	 * are not going to reach the hardware now.
+	 */
+	(void)XAie_ShadowCacheInvalidate(DevInst);
+
+	return TxnInst;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api frees a transaction instance returned by XAie_ExportTransaction().
+*
+* @param	TxnInst: Transaction instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_FreeTransactionInstance(XAie_TxnInst *TxnInst)
+{
+	if(TxnInst == XAIE_NULL) {
+		XAIE_ERROR("Invalid transaction instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	free(TxnInst->CmdBuf);
+	free(TxnInst->DataBuf);
+	free(TxnInst);
+
+	return XAIE_OK;
+}
+
+/** @} */
@@ -0,0 +1,114 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_txn.h
+* @{
+*
+* This file contains the data structures and routines for recording register
+* IO operations into a transaction buffer and submitting them to the backend
+* in one go.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIE_TXN_H
+#define XAIE_TXN_H
+
+/***************************** Include Files *********************************/
+#include "xaiegbl.h"
+
+/************************** Constant Definitions *****************************/
+/*
+ * Transaction flags passed to XAie_StartTransaction().
+ *
+ * XAIE_TRANSACTION_ENABLE_COALESCE: Merge writes to consecutive register
+ *	offsets into a single block write.
+ * XAIE_TRANSACTION_ENABLE_DEDUP: Drop writes which do not change the value
+ *	recorded earlier in the same transaction and fold back to back mask
+ *	writes to the same register into one operation. This must not be used
+ *	when the transaction touches registers with write side effects, such
+ *	as DMA start queues or lock registers.
+ * XAIE_TRANSACTION_DISABLE_AUTO_FLUSH: Do not flush the recorded operations
+ *	before reads, polls and backend operations. Reads and polls return the
+ *	current hardware state, and the transaction stays intact so that it can
+ *	be exported and replayed later.
+ */
+#define XAIE_TRANSACTION_ENABLE_COALESCE	(1U << 0)
+#define XAIE_TRANSACTION_ENABLE_DEDUP		(1U << 1)
+#define XAIE_TRANSACTION_DISABLE_AUTO_FLUSH	(1U << 2)
+#define XAIE_TRANSACTION_DEFAULT		XAIE_TRANSACTION_ENABLE_COALESCE
+
+/****************************** Type Definitions *****************************/
+/*
+ * Typedef for enum to capture the recorded IO operation
+ */
+typedef enum {
+	XAIE_TXN_OP_WRITE,
+	XAIE_TXN_OP_BLOCKWRITE,
+	XAIE_TXN_OP_BLOCKSET,
+	XAIE_TXN_OP_MASKWRITE,
+	XAIE_TXN_OP_MAX,
+} XAie_TxnOpcode;
+
+/*
+ * Typedef for structure to capture one recorded IO operation. Payload of block
+ * writes is stored in the data buffer of the transaction instance at DataOff,
+ * which keeps the command buffer relocatable.
+ */
+typedef struct {
+	XAie_TxnOpcode Opcode;
+	u32 Mask;	/* Mask for mask write */
+	u64 RegOff;	/* Register offset from the partition base address */
+	u32 Value;	/* Value for write, mask write and block set */
+	u32 DataOff;	/* Word offset of block write payload in DataBuf */
+	u32 Size;	/* Number of 32-bit words for block operations */
+} XAie_TxnCmd;
+
+/*
+ * Typedef for structure to capture a transaction
+ */
+struct XAie_TxnInst {
+	u32 Flags;		/* Transaction flags */
+	u32 NumCmds;		/* Number of commands in CmdBuf */
+	u32 MaxCmds;		/* Allocated size of CmdBuf */
+	XAie_TxnCmd *CmdBuf;	/* Recorded commands */
+	u32 NumWords;		/* Number of words in DataBuf */
+	u32 MaxWords;		/* Allocated size of DataBuf in words */
+	u32 *DataBuf;		/* Block write payload */
+	u32 NumRecordedOps;	/* IO operations issued by the driver */
+	u32 NumDroppedOps;	/* Operations removed by deduplication */
+	u32 NumFlushes;		/* Number of times the buffer was submitted */
+};
+
+/************************** Function Prototypes  *****************************/
+AieRC XAie_StartTransaction(XAie_DevInst *DevInst, u32 Flags);
+AieRC XAie_SubmitTransaction(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst);
+XAie_TxnInst* XAie_ExportTransaction(XAie_DevInst *DevInst);
+AieRC XAie_FreeTransactionInstance(XAie_TxnInst *TxnInst);
+
+/* Internal APIs used by the IO helpers */
+void _XAie_TxnWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value);
+void _XAie_TxnMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value);
+void _XAie_TxnBlockWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data,
+		u32 Size);
+void _XAie_TxnBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size);
+void _XAie_TxnAutoFlush(XAie_DevInst *DevInst);
+AieRC _XAie_TxnFlush(XAie_DevInst *DevInst);
+void _XAie_TxnDiscard(XAie_DevInst *DevInst);
+
+#endif	/* End of protection macro */
+
+/** @} */
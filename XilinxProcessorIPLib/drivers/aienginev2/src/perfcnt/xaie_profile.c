@@ -0,0 +1,915 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_profile.c
+* @{
+*
+* This file contains routines to profile a set of tiles with the performance
+* counters. A profile lists the events to count per tile, the routines assign
+* the counters of each module, sample all of them into a ring buffer, either
+* on request or periodically from a background thread on the Linux backend,
+* and export the samples as CSV or as a Chrome trace with one timeline per
+* tile.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* </pre>
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __AIELINUX__
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_perfcnt.h"
+#include "xaie_profile.h"
+#include "xaie_txn.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_PROFILE_NUM_MODULES	3U
+#define XAIE_TIMER_32BIT_SHIFT		32U
+
+/****************************** Type Definitions *****************************/
+#ifdef __AIELINUX__
+/*
+ * Typedef for structure to capture the state of the background sampler
+ */
+typedef struct {
+	pthread_t Thread;
+	pthread_mutex_t Lock;
+	pthread_cond_t Cond;
+	u32 PeriodUs;
+	u8 Stop;
+} XAie_ProfileSampler;
+#endif
+
+/************************** Variable Definitions *****************************/
+static const XAie_ProfileEvent XAie_ProfileStallEvents[] = {
+	{XAIE_CORE_MOD, XAIE_EVENT_ACTIVE_CORE, "core_active"},
+	{XAIE_CORE_MOD, XAIE_EVENT_LOCK_STALL_CORE, "core_lock_stall"},
+	{XAIE_CORE_MOD, XAIE_EVENT_STREAM_STALL_CORE, "core_stream_stall"},
+	{XAIE_CORE_MOD, XAIE_EVENT_MEMORY_STALL_CORE, "core_memory_stall"},
+	{XAIE_MEM_MOD, XAIE_EVENT_DMA_S2MM_0_STALLED_LOCK_ACQUIRE_MEM,
+		"dma_s2mm_0_lock_stall"},
+	{XAIE_MEM_MOD, XAIE_EVENT_DMA_MM2S_0_STALLED_LOCK_ACQUIRE_MEM,
+		"dma_mm2s_0_lock_stall"},
+};
+
+static const XAie_ProfileCfg XAie_ProfilePresets[XAIE_PROFILE_PRESET_MAX] = {
+	[XAIE_PROFILE_PRESET_STALLS] = {
+		.NumEvents = sizeof(XAie_ProfileStallEvents) /
+			sizeof(XAie_ProfileStallEvents[0U]),
+		.Events = XAie_ProfileStallEvents,
+	},
+};
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This api returns one of the predefined profiles.
+*
+* @param	Preset: Predefined profile.
+*
+* @return	Pointer to the profile on success, NULL on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+const XAie_ProfileCfg* XAie_ProfileGetPreset(XAie_ProfilePreset Preset)
+{
+	if(Preset >= XAIE_PROFILE_PRESET_MAX) {
+		XAIE_ERROR("Invalid profile preset\n");
+		return NULL;
+	}
+
+	return &XAie_ProfilePresets[Preset];
+}
+
+/*****************************************************************************/
+/**
+*
+* This api returns the performance counter module of a tile for a module type.
+*
+* @param	DevInst: Device Instance.
+* @param	Loc: Location of the tile.
+* @param	Module: Module of the tile.
+*
+* @return	Pointer to the performance counter module, NULL if the module
+*		does not exist in the tile.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static const XAie_PerfMod* _XAie_ProfileGetPerfMod(XAie_DevInst *DevInst,
+		XAie_LocType Loc, XAie_ModuleType Module)
+{
+	u8 TileType;
+
+	TileType = _XAie_GetTileTypefromLoc(DevInst, Loc);
+	if(TileType == XAIEGBL_TILE_TYPE_MAX) {
+		return NULL;
+	}
+
+	if(_XAie_CheckModule(DevInst, Loc, Module) != XAIE_OK) {
+		return NULL;
+	}
+
+	if(Module == XAIE_PL_MOD) {
+		return &DevInst->DevProp.DevMod[TileType].PerfMod[0U];
+	}
+
+	return &DevInst->DevProp.DevMod[TileType].PerfMod[Module];
+}
+
+/*****************************************************************************/
+/**
+*
+* This api assigns the performance counters of every tile to the events of the
+* profile and computes the addresses of the counter registers, so that a
+* sample is a plain sequence of register reads.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static AieRC _XAie_ProfileAssignCounters(XAie_ProfileInst *ProfInst)
+{
+	XAie_DevInst *DevInst = ProfInst->DevInst;
+	const XAie_TimerMod *TimerMod;
+	u8 TileType;
+
+	for(u32 t = 0U; t < ProfInst->NumTiles; t++) {
+		XAie_LocType Loc = ProfInst->Locs[t];
+		u8 NumUsed[XAIE_PROFILE_NUM_MODULES] = {0U};
+
+		for(u32 e = 0U; e < ProfInst->Cfg.NumEvents; e++) {
+			const XAie_ProfileEvent *Event = &ProfInst->Cfg.Events[e];
+			const XAie_PerfMod *PerfMod;
+			u32 Idx = t * ProfInst->Cfg.NumEvents + e;
+
+			PerfMod = _XAie_ProfileGetPerfMod(DevInst, Loc,
+					Event->Module);
+			if(PerfMod == NULL) {
+				XAIE_ERROR("Invalid module for event %s in "
+						"tile (%d, %d)\n", Event->Name,
+						Loc.Col, Loc.Row);
+				return XAIE_INVALID_ARGS;
+			}
+
+			if(NumUsed[Event->Module] >= PerfMod->MaxCounterVal) {
+				XAIE_ERROR("Out of performance counters for "
+						"event %s in tile (%d, %d)\n",
+						Event->Name, Loc.Col, Loc.Row);
+				return XAIE_ERR_OUTOFBOUND;
+			}
+
+			ProfInst->Counters[Idx] = NumUsed[Event->Module]++;
+			ProfInst->CounterAddrs[Idx] =
+				_XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col) +
+				PerfMod->PerfCounterBaseAddr +
+				ProfInst->Counters[Idx] *
+				PerfMod->PerfCounterOffsetAdd;
+		}
+	}
+
+	/* Timestamp the samples with the timer of the first tile */
+	TileType = _XAie_GetTileTypefromLoc(DevInst, ProfInst->Locs[0U]);
+	if(TileType == XAIEGBL_TILE_TYPE_AIETILE) {
+		TimerMod = &DevInst->DevProp.DevMod[TileType].TimerMod[XAIE_CORE_MOD];
+	} else {
+		TimerMod = &DevInst->DevProp.DevMod[TileType].TimerMod[0U];
+	}
+
+	ProfInst->TimerLowAddr = _XAie_GetTileAddr(DevInst,
+			ProfInst->Locs[0U].Row, ProfInst->Locs[0U].Col) +
+		TimerMod->LowOff;
+	ProfInst->TimerHighAddr = _XAie_GetTileAddr(DevInst,
+			ProfInst->Locs[0U].Row, ProfInst->Locs[0U].Col) +
+		TimerMod->HighOff;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api creates a profiling session for a list of tiles. The events of the
+* profile are counted on every tile of the list.
+*
+* @param	DevInst: Device Instance.
+* @param	Cfg: Events to profile, see XAie_ProfileGetPreset() for the
+*		predefined profiles.
+* @param	Locs: Array of tile locations.
+* @param	NumTiles: Number of tiles in Locs.
+* @param	MaxSamples: Size of the sample ring buffer.
+*
+* @return	Pointer to the profiling instance on success, NULL on failure.
+*
+* @note		The counters are not programmed until XAie_ProfileStart().
+*
+******************************************************************************/
+XAie_ProfileInst* XAie_ProfileCreate(XAie_DevInst *DevInst,
+		const XAie_ProfileCfg *Cfg, XAie_LocType *Locs, u32 NumTiles,
+		u32 MaxSamples)
+{
+	XAie_ProfileInst *ProfInst;
+	u32 NumValues;
+
+	if((DevInst == XAIE_NULL) || (Cfg == XAIE_NULL) ||
+		(Locs == XAIE_NULL) || (NumTiles == 0U) ||
+		(MaxSamples == 0U) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return NULL;
+	}
+
+	if((Cfg->NumEvents == 0U) ||
+			(Cfg->NumEvents > XAIE_PROFILE_MAX_EVENTS) ||
+			(Cfg->Events == XAIE_NULL)) {
+		XAIE_ERROR("Invalid number of profile events\n");
+		return NULL;
+	}
+
+	ProfInst = (XAie_ProfileInst *)calloc(1U, sizeof(*ProfInst));
+	if(ProfInst == NULL) {
+		XAIE_ERROR("Memory allocation for profile instance failed\n");
+		return NULL;
+	}
+
+	NumValues = NumTiles * Cfg->NumEvents;
+	ProfInst->DevInst = DevInst;
+	ProfInst->Cfg = *Cfg;
+	ProfInst->NumTiles = NumTiles;
+	ProfInst->MaxSamples = MaxSamples;
+	ProfInst->Locs = (XAie_LocType *)malloc(NumTiles * sizeof(*Locs));
+	ProfInst->Counters = (u8 *)malloc(NumValues * sizeof(u8));
+	ProfInst->CounterAddrs = (u64 *)malloc(NumValues * sizeof(u64));
+	ProfInst->Timestamps = (u64 *)malloc(MaxSamples * sizeof(u64));
+	ProfInst->Values = (u32 *)malloc((u64)MaxSamples * NumValues *
+			sizeof(u32));
+	if((ProfInst->Locs == NULL) || (ProfInst->Counters == NULL) ||
+			(ProfInst->CounterAddrs == NULL) ||
+			(ProfInst->Timestamps == NULL) ||
+			(ProfInst->Values == NULL)) {
+		XAIE_ERROR("Memory allocation for profile buffers failed\n");
+		XAie_ProfileFree(ProfInst);
+		return NULL;
+	}
+
+	memcpy(ProfInst->Locs, Locs, NumTiles * sizeof(*Locs));
+	if(_XAie_ProfileAssignCounters(ProfInst) != XAIE_OK) {
+		XAie_ProfileFree(ProfInst);
+		return NULL;
+	}
+
+	return ProfInst;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api programs the performance counters of all profiled tiles and clears
+* the sample buffer.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		The counters count the cycles the events are active. If no
+*		transaction is active, the programming is recorded in one
+*		transaction so that the backend sees a few block writes.
+*
+******************************************************************************/
+AieRC XAie_ProfileStart(XAie_ProfileInst *ProfInst)
+{
+	XAie_DevInst *DevInst;
+	u8 OwnTxn = XAIE_DISABLE;
+	AieRC RC = XAIE_OK;
+
+	if(ProfInst == XAIE_NULL) {
+		XAIE_ERROR("Invalid profile instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	DevInst = ProfInst->DevInst;
+	if(DevInst->TxnInst == XAIE_NULL) {
+		if(XAie_StartTransaction(DevInst,
+					XAIE_TRANSACTION_DEFAULT) == XAIE_OK) {
+			OwnTxn = XAIE_ENABLE;
+		}
+	}
+
+	for(u32 t = 0U; (t < ProfInst->NumTiles) && (RC == XAIE_OK); t++) {
+		for(u32 e = 0U; e < ProfInst->Cfg.NumEvents; e++) {
+			const XAie_ProfileEvent *Event = &ProfInst->Cfg.Events[e];
+			u8 Counter;
+
+			Counter = ProfInst->Counters[t * ProfInst->Cfg.NumEvents +
+				e];
+			RC = XAie_PerfCounterControlSet(DevInst,
+					ProfInst->Locs[t], Event->Module,
+					Counter, Event->Event, Event->Event);
+			if(RC != XAIE_OK) {
+				XAIE_ERROR("Unable to set event %s in tile "
+						"(%d, %d)\n", Event->Name,
+						ProfInst->Locs[t].Col,
+						ProfInst->Locs[t].Row);
+				break;
+			}
+
+			XAie_Write32(DevInst, ProfInst->CounterAddrs[t *
+					ProfInst->Cfg.NumEvents + e], 0U);
+		}
+	}
+
+	if(OwnTxn == XAIE_ENABLE) {
+		if(RC == XAIE_OK) {
+			RC = XAie_SubmitTransaction(DevInst, XAIE_NULL);
+		} else {
+			XAie_FreeTransactionInstance(
+					XAie_ExportTransaction(DevInst));
+		}
+	}
+
+	ProfInst->NumSamples = 0U;
+	ProfInst->Head = 0U;
+	ProfInst->NumDropped = 0U;
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api reads one register for a sample.
+*
+* @param	ProfInst: Profiling instance.
+* @param	RegOff: Address of the register.
+* @param	Direct: XAIE_ENABLE to read from the backend, bypassing the
+*		register shadow and transactions of the device instance.
+*
+* @return	Value of the register.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static inline u32 _XAie_ProfileRead32(XAie_ProfileInst *ProfInst, u64 RegOff,
+		u8 Direct)
+{
+	XAie_DevInst *DevInst = ProfInst->DevInst;
+
+	if(Direct == XAIE_ENABLE) {
+		return DevInst->Backend->Ops.Read32((void *)DevInst->IOInst,
+				RegOff);
+	}
+
+	return XAie_Read32(DevInst, RegOff);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api reads the 64-bit timer used to timestamp the samples.
+*
+* @param	ProfInst: Profiling instance.
+* @param	Direct: XAIE_ENABLE to read from the backend, bypassing the
+*		register shadow and transactions of the device instance.
+*
+* @return	Timer value.
+*
+* @note		Internal only. The timer has no latch for the high word, so
+*		the high word is read before and after the low word. If it
+*		changed, the low word wrapped in between and is read again,
+*		which gives a value at or after the second high word read.
+*
+******************************************************************************/
+static u64 _XAie_ProfileReadTimer(XAie_ProfileInst *ProfInst, u8 Direct)
+{
+	u32 High, Low, HighAgain;
+
+	High = _XAie_ProfileRead32(ProfInst, ProfInst->TimerHighAddr, Direct);
+	Low = _XAie_ProfileRead32(ProfInst, ProfInst->TimerLowAddr, Direct);
+	HighAgain = _XAie_ProfileRead32(ProfInst, ProfInst->TimerHighAddr,
+			Direct);
+	if(HighAgain != High) {
+		High = HighAgain;
+		Low = _XAie_ProfileRead32(ProfInst, ProfInst->TimerLowAddr,
+				Direct);
+	}
+
+	return ((u64)High << XAIE_TIMER_32BIT_SHIFT) | Low;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api reads all profiled counters into the next slot of the ring buffer.
+*
+* @param	ProfInst: Profiling instance.
+* @param	Direct: XAIE_ENABLE to read from the backend, bypassing the
+*		register shadow and transactions of the device instance.
+*
+* @return	None.
+*
+* @note		Internal only. The background sampler reads directly since the
+*		shadow and transactions belong to the thread driving the
+*		partition.
+*
+******************************************************************************/
+static void _XAie_ProfileSample(XAie_ProfileInst *ProfInst, u8 Direct)
+{
+	u32 NumValues = ProfInst->NumTiles * ProfInst->Cfg.NumEvents;
+	u32 *Values = &ProfInst->Values[(u64)ProfInst->Head * NumValues];
+
+	ProfInst->Timestamps[ProfInst->Head] =
+		_XAie_ProfileReadTimer(ProfInst, Direct);
+	for(u32 i = 0U; i < NumValues; i++) {
+		Values[i] = _XAie_ProfileRead32(ProfInst,
+				ProfInst->CounterAddrs[i], Direct);
+	}
+
+	ProfInst->Head = (ProfInst->Head + 1U) % ProfInst->MaxSamples;
+	if(ProfInst->NumSamples < ProfInst->MaxSamples) {
+		ProfInst->NumSamples++;
+	} else {
+		ProfInst->NumDropped++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This api takes one sample of all profiled counters.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Fails while the background sampler is running.
+*
+******************************************************************************/
+AieRC XAie_ProfileSample(XAie_ProfileInst *ProfInst)
+{
+	if(ProfInst == XAIE_NULL) {
+		XAIE_ERROR("Invalid profile instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(ProfInst->Sampler != NULL) {
+		XAIE_ERROR("Background sampler is running\n");
+		return XAIE_ERR;
+	}
+
+	_XAie_ProfileSample(ProfInst, XAIE_DISABLE);
+
+	return XAIE_OK;
+}
+
+#ifdef __AIELINUX__
+/*****************************************************************************/
+/**
+*
+* This is the body of the background sampler thread.
+*
+* @param	Arg: Profiling instance.
+*
+* @return	NULL.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void* _XAie_ProfileSamplerThread(void *Arg)
+{
+	XAie_ProfileInst *ProfInst = (XAie_ProfileInst *)Arg;
+	XAie_ProfileSampler *Sampler = (XAie_ProfileSampler *)ProfInst->Sampler;
+	struct timespec Next;
+
+	clock_gettime(CLOCK_MONOTONIC, &Next);
+
+	pthread_mutex_lock(&Sampler->Lock);
+	while(Sampler->Stop == 0U) {
+		_XAie_ProfileSample(ProfInst, XAIE_ENABLE);
+
+		Next.tv_nsec += (long)Sampler->PeriodUs * 1000L;
+		while(Next.tv_nsec >= 1000000000L) {
+			Next.tv_nsec -= 1000000000L;
+			Next.tv_sec++;
+		}
+
+		while((Sampler->Stop == 0U) &&
+			(pthread_cond_timedwait(&Sampler->Cond, &Sampler->Lock,
+						&Next) != ETIMEDOUT)) {
+		}
+	}
+	pthread_mutex_unlock(&Sampler->Lock);
+
+	return NULL;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* This api starts a background thread which samples the profiled counters
+* periodically.
+*
+* @param	ProfInst: Profiling instance.
+* @param	PeriodUs: Sampling period in microseconds.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Only supported on the Linux backend, where the counters are
+*		read through the mapped partition without going through the
+*		kernel. The application must not change the profiled counters
+*		while the sampler is running.
+*
+******************************************************************************/
+AieRC XAie_ProfileStartSampling(XAie_ProfileInst *ProfInst, u32 PeriodUs)
+{
+	if((ProfInst == XAIE_NULL) || (PeriodUs == 0U)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(ProfInst->Sampler != NULL) {
+		XAIE_ERROR("Background sampler is already running\n");
+		return XAIE_ERR;
+	}
+
+#ifdef __AIELINUX__
+	XAie_ProfileSampler *Sampler;
+	pthread_condattr_t CondAttr;
+
+	if(ProfInst->DevInst->Backend->Type != XAIE_IO_BACKEND_LINUX) {
+		XAIE_ERROR("Background sampling needs the Linux backend\n");
+		return XAIE_FEATURE_NOT_SUPPORTED;
+	}
+
+	Sampler = (XAie_ProfileSampler *)calloc(1U, sizeof(*Sampler));
+	if(Sampler == NULL) {
+		XAIE_ERROR("Memory allocation for sampler failed\n");
+		return XAIE_ERR;
+	}
+
+	Sampler->PeriodUs = PeriodUs;
+	pthread_mutex_init(&Sampler->Lock, NULL);
+	pthread_condattr_init(&CondAttr);
+	pthread_condattr_setclock(&CondAttr, CLOCK_MONOTONIC);
+	pthread_cond_init(&Sampler->Cond, &CondAttr);
+	pthread_condattr_destroy(&CondAttr);
+
+	ProfInst->Sampler = Sampler;
+	if(pthread_create(&Sampler->Thread, NULL, _XAie_ProfileSamplerThread,
+				ProfInst) != 0) {
+		XAIE_ERROR("Failed to create sampler thread\n");
+		ProfInst->Sampler = NULL;
+		pthread_cond_destroy(&Sampler->Cond);
+		pthread_mutex_destroy(&Sampler->Lock);
+		free(Sampler);
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+#else
+	XAIE_ERROR("Background sampling needs the Linux backend\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This api stops the background sampler thread.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_ProfileStopSampling(XAie_ProfileInst *ProfInst)
+{
+	if(ProfInst == XAIE_NULL) {
+		XAIE_ERROR("Invalid profile instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(ProfInst->Sampler == NULL) {
+		return XAIE_OK;
+	}
+
+#ifdef __AIELINUX__
+	XAie_ProfileSampler *Sampler = (XAie_ProfileSampler *)ProfInst->Sampler;
+
+	pthread_mutex_lock(&Sampler->Lock);
+	Sampler->Stop = 1U;
+	pthread_cond_signal(&Sampler->Cond);
+	pthread_mutex_unlock(&Sampler->Lock);
+	pthread_join(Sampler->Thread, NULL);
+
+	pthread_cond_destroy(&Sampler->Cond);
+	pthread_mutex_destroy(&Sampler->Lock);
+	free(Sampler);
+#endif
+	ProfInst->Sampler = NULL;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api stops the profiling and releases the performance counters of all
+* profiled tiles.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		The samples are kept for export.
+*
+******************************************************************************/
+AieRC XAie_ProfileStop(XAie_ProfileInst *ProfInst)
+{
+	AieRC RC;
+
+	RC = XAie_ProfileStopSampling(ProfInst);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	for(u32 t = 0U; t < ProfInst->NumTiles; t++) {
+		for(u32 e = 0U; e < ProfInst->Cfg.NumEvents; e++) {
+			RC = XAie_PerfCounterControlReset(ProfInst->DevInst,
+					ProfInst->Locs[t],
+					ProfInst->Cfg.Events[e].Module,
+					ProfInst->Counters[t *
+					ProfInst->Cfg.NumEvents + e]);
+			if(RC != XAIE_OK) {
+				return RC;
+			}
+		}
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api returns the counter values of a sample in the ring buffer.
+*
+* @param	ProfInst: Profiling instance.
+* @param	Sample: Index of the sample, 0 is the oldest one.
+*
+* @return	Pointer to the counter values of the sample.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static const u32* _XAie_ProfileGetValues(XAie_ProfileInst *ProfInst,
+		u32 Sample)
+{
+	u32 Slot;
+
+	Slot = (ProfInst->Head + ProfInst->MaxSamples - ProfInst->NumSamples +
+			Sample) % ProfInst->MaxSamples;
+
+	return &ProfInst->Values[(u64)Slot * ProfInst->NumTiles *
+		ProfInst->Cfg.NumEvents];
+}
+
+/*****************************************************************************/
+/**
+*
+* This api returns the timestamp of a sample in the ring buffer.
+*
+* @param	ProfInst: Profiling instance.
+* @param	Sample: Index of the sample, 0 is the oldest one.
+*
+* @return	Timer value of the sample.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static u64 _XAie_ProfileGetTimestamp(XAie_ProfileInst *ProfInst, u32 Sample)
+{
+	u32 Slot;
+
+	Slot = (ProfInst->Head + ProfInst->MaxSamples - ProfInst->NumSamples +
+			Sample) % ProfInst->MaxSamples;
+
+	return ProfInst->Timestamps[Slot];
+}
+
+/*****************************************************************************/
+/**
+*
+* This api exports the samples as CSV. Every line holds the timestamp, the
+* tile, the event, the counter value and the increment since the previous
+* sample.
+*
+* @param	ProfInst: Profiling instance.
+* @param	Path: Path of the output file.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		The sampler must be stopped before exporting.
+*
+******************************************************************************/
+AieRC XAie_ProfileExportCsv(XAie_ProfileInst *ProfInst, const char *Path)
+{
+	FILE *Fd;
+	u32 NumEvents;
+
+	if((ProfInst == XAIE_NULL) || (Path == XAIE_NULL) ||
+			(ProfInst->Sampler != NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	Fd = fopen(Path, "w");
+	if(Fd == NULL) {
+		XAIE_ERROR("Unable to open file %s\n", Path);
+		return XAIE_ERR;
+	}
+
+	NumEvents = ProfInst->Cfg.NumEvents;
+	fprintf(Fd, "timestamp,col,row,event,value,delta\n");
+	for(u32 s = 0U; s < ProfInst->NumSamples; s++) {
+		const u32 *Values = _XAie_ProfileGetValues(ProfInst, s);
+		const u32 *Prev = (s > 0U) ?
+			_XAie_ProfileGetValues(ProfInst, s - 1U) : NULL;
+		u64 Timestamp = _XAie_ProfileGetTimestamp(ProfInst, s);
+
+		for(u32 t = 0U; t < ProfInst->NumTiles; t++) {
+			for(u32 e = 0U; e < NumEvents; e++) {
+				u32 i = t * NumEvents + e;
+
+				fprintf(Fd, "%llu,%u,%u,%s,%u,%u\n",
+					(unsigned long long)Timestamp,
+					ProfInst->Locs[t].Col,
+					ProfInst->Locs[t].Row,
+					ProfInst->Cfg.Events[e].Name,
+					Values[i], (Prev != NULL) ?
+					(Values[i] - Prev[i]) : Values[i]);
+			}
+		}
+	}
+
+	if(fclose(Fd) != 0) {
+		XAIE_ERROR("Unable to write file %s\n", Path);
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api exports the samples in the Chrome trace event format. Every tile
+* gets a counter track with the increments of its events between two samples,
+* grouped by column.
+*
+* @param	ProfInst: Profiling instance.
+* @param	Path: Path of the output file.
+* @param	ClkFreqMhz: Frequency of the AIE clock in MHz, used to convert
+*		the timer to microseconds.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		The sampler must be stopped before exporting.
+*
+******************************************************************************/
+AieRC XAie_ProfileExportChromeTrace(XAie_ProfileInst *ProfInst,
+		const char *Path, u32 ClkFreqMhz)
+{
+	FILE *Fd;
+	u32 NumEvents;
+	const char *Sep = "";
+
+	if((ProfInst == XAIE_NULL) || (Path == XAIE_NULL) ||
+			(ClkFreqMhz == 0U) || (ProfInst->Sampler != NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	Fd = fopen(Path, "w");
+	if(Fd == NULL) {
+		XAIE_ERROR("Unable to open file %s\n", Path);
+		return XAIE_ERR;
+	}
+
+	NumEvents = ProfInst->Cfg.NumEvents;
+	fprintf(Fd, "{\"traceEvents\":[");
+	for(u32 t = 0U; t < ProfInst->NumTiles; t++) {
+		u32 First = 0U;
+
+		/* One process per column */
+		while(ProfInst->Locs[First].Col != ProfInst->Locs[t].Col) {
+			First++;
+		}
+		if(First != t) {
+			continue;
+		}
+
+		fprintf(Fd, "%s\n{\"name\":\"process_name\",\"ph\":\"M\","
+				"\"pid\":%u,\"args\":{\"name\":\"column %u\"}}",
+				Sep, ProfInst->Locs[t].Col,
+				ProfInst->Locs[t].Col);
+		Sep = ",";
+	}
+
+	for(u32 s = 1U; s < ProfInst->NumSamples; s++) {
+		const u32 *Values = _XAie_ProfileGetValues(ProfInst, s);
+		const u32 *Prev = _XAie_ProfileGetValues(ProfInst, s - 1U);
+		u64 Timestamp = _XAie_ProfileGetTimestamp(ProfInst, s - 1U);
+
+		for(u32 t = 0U; t < ProfInst->NumTiles; t++) {
+			fprintf(Fd, ",\n{\"name\":\"tile_%u_%u\",\"ph\":\"C\","
+					"\"ts\":%llu.%03llu,\"pid\":%u,"
+					"\"args\":{", ProfInst->Locs[t].Col,
+					ProfInst->Locs[t].Row,
+					(unsigned long long)(Timestamp /
+						ClkFreqMhz),
+					(unsigned long long)((Timestamp %
+						ClkFreqMhz) * 1000U /
+						ClkFreqMhz),
+					ProfInst->Locs[t].Col);
+			for(u32 e = 0U; e < NumEvents; e++) {
+				u32 i = t * NumEvents + e;
+
+				fprintf(Fd, "%s\"%s\":%u", (e > 0U) ? "," : "",
+						ProfInst->Cfg.Events[e].Name,
+						Values[i] - Prev[i]);
+			}
+			fprintf(Fd, "}}");
+		}
+	}
+	fprintf(Fd, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+	if(fclose(Fd) != 0) {
+		XAIE_ERROR("Unable to write file %s\n", Path);
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api frees a profiling instance. The background sampler is stopped if it
+* is running.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		The performance counters are left as they are, call
+*		XAie_ProfileStop() to release them.
+*
+******************************************************************************/
+AieRC XAie_ProfileFree(XAie_ProfileInst *ProfInst)
+{
+	if(ProfInst == XAIE_NULL) {
+		XAIE_ERROR("Invalid profile instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	XAie_ProfileStopSampling(ProfInst);
+
+	free(ProfInst->Locs);
+	free(ProfInst->Counters);
+	free(ProfInst->CounterAddrs);
+	free(ProfInst->Timestamps);
+	free(ProfInst->Values);
+	free(ProfInst);
+
+	return XAIE_OK;
+}
+
+/** @} */
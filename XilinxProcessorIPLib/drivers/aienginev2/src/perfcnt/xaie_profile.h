@@ -0,0 +1,105 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_profile.h
+* @{
+*
+* This file contains the data structures and routines to profile a set of tiles
+* with the performance counters and to export the sampled counters as a per
+* tile timeline.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIE_PROFILE_H
+#define XAIE_PROFILE_H
+
+/***************************** Include Files *********************************/
+#include "xaie_events.h"
+#include "xaiegbl.h"
+#include "xaiegbl_defs.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_PROFILE_MAX_EVENTS		8U
+
+/****************************** Type Definitions *****************************/
+/*
+ * Typedef for enum to capture the predefined profiles
+ *
+ * XAIE_PROFILE_PRESET_STALLS: Core active, lock, stream and memory stall
+ *	cycles and DMA lock acquire stall cycles of AIE tiles.
+ */
+typedef enum {
+	XAIE_PROFILE_PRESET_STALLS,
+	XAIE_PROFILE_PRESET_MAX,
+} XAie_ProfilePreset;
+
+/*
+ * Typedef for structure to capture one profiled event. A performance counter
+ * of the module counts the cycles the event is active.
+ */
+typedef struct {
+	XAie_ModuleType Module;
+	XAie_Events Event;
+	const char *Name;	/* Name used in the exported timeline */
+} XAie_ProfileEvent;
+
+/*
+ * Typedef for structure to capture the events profiled on every tile
+ */
+typedef struct {
+	u32 NumEvents;
+	const XAie_ProfileEvent *Events;
+} XAie_ProfileCfg;
+
+/*
+ * Typedef for structure to capture a profiling session. Samples are kept in a
+ * ring buffer, the oldest sample is dropped when the buffer is full.
+ */
+typedef struct {
+	XAie_DevInst *DevInst;
+	XAie_ProfileCfg Cfg;
+	u32 NumTiles;
+	XAie_LocType *Locs;	/* Profiled tiles */
+	u8 *Counters;		/* Counter per tile and event */
+	u64 *CounterAddrs;	/* Counter register per tile and event */
+	u64 TimerLowAddr;	/* Timer used to timestamp the samples */
+	u64 TimerHighAddr;
+	u32 MaxSamples;
+	u32 NumSamples;		/* Valid samples in the ring buffer */
+	u32 Head;		/* Slot of the next sample */
+	u64 NumDropped;		/* Samples overwritten in the ring buffer */
+	u64 *Timestamps;	/* Timer value per sample */
+	u32 *Values;		/* Counter values per sample, tile and event */
+	void *Sampler;		/* Background sampler, Linux backend only */
+} XAie_ProfileInst;
+
+/************************** Function Prototypes  *****************************/
+const XAie_ProfileCfg* XAie_ProfileGetPreset(XAie_ProfilePreset Preset);
+XAie_ProfileInst* XAie_ProfileCreate(XAie_DevInst *DevInst,
+		const XAie_ProfileCfg *Cfg, XAie_LocType *Locs, u32 NumTiles,
+		u32 MaxSamples);
+AieRC XAie_ProfileStart(XAie_ProfileInst *ProfInst);
+AieRC XAie_ProfileSample(XAie_ProfileInst *ProfInst);
+AieRC XAie_ProfileStartSampling(XAie_ProfileInst *ProfInst, u32 PeriodUs);
+AieRC XAie_ProfileStopSampling(XAie_ProfileInst *ProfInst);
+AieRC XAie_ProfileStop(XAie_ProfileInst *ProfInst);
+AieRC XAie_ProfileExportCsv(XAie_ProfileInst *ProfInst, const char *Path);
+AieRC XAie_ProfileExportChromeTrace(XAie_ProfileInst *ProfInst,
+		const char *Path, u32 ClkFreqMhz);
+AieRC XAie_ProfileFree(XAie_ProfileInst *ProfInst);
+
+#endif	/* End of protection macro */
+
+/** @} */
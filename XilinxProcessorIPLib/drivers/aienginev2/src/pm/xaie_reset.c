@@ -17,6 +17,7 @@
 #include "xaie_helper.h"
 #include "xaie_npi.h"
 #include "xaie_reset.h"
+#include "xaie_shadow.h"
 #include "xaiegbl.h"
 
 /*****************************************************************************/
@@ -237,6 +238,9 @@ AieRC XAie_ResetPartition(XAie_DevInst *DevInst)
 
 	_XAie_PmSetPartitionClock(DevInst, XAIE_DISABLE);
 
+	/* Reset brings the configuration registers back to default values */
+	XAie_ShadowCacheInvalidate(DevInst);
+
 	return XAIE_OK;
 }
 
@@ -18,10 +18,13 @@ extern "C" {
 #include <xaiengine/xaie_mem.h>
 #include <xaiengine/xaie_perfcnt.h>
 #include <xaiengine/xaie_plif.h>
+#include <xaiengine/xaie_profile.h>
 #include <xaiengine/xaie_reset.h>
+#include <xaiengine/xaie_shadow.h>
 #include <xaiengine/xaie_ss.h>
 #include <xaiengine/xaie_timer.h>
 #include <xaiengine/xaie_trace.h>
+#include <xaiengine/xaie_txn.h>
 #include <xaiengine/xaiegbl.h>
 #include <xaiengine/xaiegbl_defs.h>
 
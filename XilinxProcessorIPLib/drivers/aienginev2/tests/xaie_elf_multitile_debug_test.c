@@ -0,0 +1,488 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_elf_multitile_debug_test.c
+* @{
+*
+* This file contains the host test of the multi tile elf loader against the
+* debug backend. The test writes a small elf with program memory, data memory
+* sections crossing into the neighbouring tiles and an uninitialized section,
+* and loads it to N tiles with XAie_LoadElfMultiTile() and with one
+* XAie_LoadElf() call per tile, each on a fresh device instance so that both
+* start with the same ECC state. It checks that:
+*	- Both loads issue the same register operations; the multi tile
+*	  loader prepares ECC for all tiles before writing them, so the traces
+*	  are compared as sorted lists.
+*	- Both loads leave the registers in the same state.
+* It prints the load time of both for 1, 8, 32 and 128 tiles. The debug
+* backend prints every word, which dominates these times; the multi tile
+* loader only saves the file read and the elf decode per tile, and its
+* worker threads are only used on the Linux backend.
+*
+* The test is built and run on the build machine by the Makefile of this
+* directory.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <xaiengine.h>
+
+/************************** Constant Definitions *****************************/
+#define XAIE_BASE_ADDR		0x20000000000
+#define XAIE_COL_SHIFT		23
+#define XAIE_ROW_SHIFT		18
+#define XAIE_NUM_COLS		50
+#define XAIE_NUM_ROWS		9
+#define XAIE_SHIM_ROW		0
+#define XAIE_RES_TILE_ROW_START	0
+#define XAIE_RES_TILE_NUM_ROWS	0
+#define XAIE_AIE_TILE_ROW_START	1
+#define XAIE_AIE_TILE_NUM_ROWS	8
+
+#define TEST_MAX_TILES		128
+#define TEST_FIRST_COL		1
+#define TEST_FIRST_ROW		2
+#define TEST_TRACE_MAX		(64 << 20)
+#define TEST_REG_MAP_SIZE	(1 << 20)
+
+#define TEST_PM_SIZE		4096	/* Program memory section */
+#define TEST_DM_ADDR		0x27F00	/* Crosses from south to west */
+#define TEST_DM_SIZE		0x200
+#define TEST_BSS_ADDR		0x38000	/* East, partly initialized */
+#define TEST_BSS_FILESZ		0x100
+#define TEST_BSS_MEMSZ		0x1000
+#define TEST_NUM_PHDRS		4
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u64 Addr;
+	u32 Value;
+	u8 Valid;
+} RegEntry;
+
+typedef struct {
+	RegEntry Regs[TEST_REG_MAP_SIZE];
+	u32 NumWrites;
+	u32 NumReads;
+} RegModel;
+
+typedef struct {
+	XAie_DevInst *DevInst;
+	const char *ElfPath;
+	XAie_LocType *Locs;
+	u32 NumTiles;
+	u8 MultiTile;		/* Load with XAie_LoadElfMultiTile() */
+	double LoadUs;		/* Time spent loading */
+} TestRun;
+
+/************************** Variable Definitions *****************************/
+static char *TraceRef, *TraceMulti;
+static RegModel ModelRef, ModelMulti;
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This function creates a device instance on the debug backend.
+*
+* @param	DevInst: Device instance to initialize.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+*******************************************************************************/
+static AieRC InitDevice(XAie_DevInst *DevInst)
+{
+	XAie_SetupConfig(ConfigPtr, XAIE_DEV_GEN_AIE, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_RES_TILE_ROW_START, XAIE_RES_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+
+	memset(DevInst, 0, sizeof(*DevInst));
+
+	return XAie_CfgInitialize(DevInst, &ConfigPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes the test elf to a temporary file.
+*
+* @param	Path: Template of the file path, updated with the final path.
+*
+* @return	0 on success, -1 on failure.
+*
+*******************************************************************************/
+static int WriteElf(char *Path)
+{
+	static unsigned char Elf[sizeof(Elf32_Ehdr) +
+		TEST_NUM_PHDRS * sizeof(Elf32_Phdr) + TEST_PM_SIZE +
+		TEST_DM_SIZE + TEST_BSS_FILESZ];
+	Elf32_Ehdr *Ehdr = (Elf32_Ehdr *)Elf;
+	Elf32_Phdr *Phdr = (Elf32_Phdr *)(Elf + sizeof(*Ehdr));
+	u32 Offset = sizeof(*Ehdr) + TEST_NUM_PHDRS * sizeof(*Phdr);
+	FILE *Fd;
+	int Fdn;
+
+	memcpy(Ehdr->e_ident, ELFMAG, SELFMAG);
+	Ehdr->e_ident[EI_CLASS] = ELFCLASS32;
+	Ehdr->e_ident[EI_DATA] = ELFDATA2LSB;
+	Ehdr->e_type = ET_EXEC;
+	Ehdr->e_phoff = sizeof(*Ehdr);
+	Ehdr->e_phentsize = sizeof(*Phdr);
+	Ehdr->e_phnum = TEST_NUM_PHDRS;
+
+	Phdr[0] = (Elf32_Phdr){.p_type = PT_LOAD, .p_offset = Offset,
+		.p_paddr = 0U, .p_filesz = TEST_PM_SIZE,
+		.p_memsz = TEST_PM_SIZE};
+	Offset += TEST_PM_SIZE;
+	Phdr[1] = (Elf32_Phdr){.p_type = PT_NOTE};
+	Phdr[2] = (Elf32_Phdr){.p_type = PT_LOAD, .p_offset = Offset,
+		.p_paddr = TEST_DM_ADDR, .p_filesz = TEST_DM_SIZE,
+		.p_memsz = TEST_DM_SIZE};
+	Offset += TEST_DM_SIZE;
+	Phdr[3] = (Elf32_Phdr){.p_type = PT_LOAD, .p_offset = Offset,
+		.p_paddr = TEST_BSS_ADDR, .p_filesz = TEST_BSS_FILESZ,
+		.p_memsz = TEST_BSS_MEMSZ};
+
+	for(u32 i = sizeof(*Ehdr) + TEST_NUM_PHDRS * sizeof(*Phdr);
+			i < sizeof(Elf); i++)
+		Elf[i] = (unsigned char)(i * 7U + 1U);
+
+	Fdn = mkstemp(Path);
+	if(Fdn < 0)
+		return -1;
+	Fd = fdopen(Fdn, "w");
+	if(Fd == NULL) {
+		close(Fdn);
+		return -1;
+	}
+	if(fwrite(Elf, sizeof(Elf), 1U, Fd) != 1U) {
+		fclose(Fd);
+		return -1;
+	}
+
+	return (fclose(Fd) == 0) ? 0 : -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function loads the elf to the tiles of a test run and captures the
+* register trace printed by the debug backend.
+*
+* @param	Run: Test run.
+* @param	Trace: Buffer for the captured trace.
+*
+* @return	0 on success, -1 on failure.
+*
+*******************************************************************************/
+static int LoadCaptured(TestRun *Run, char *Trace)
+{
+	struct timespec Start, End;
+	FILE *Tmp;
+	size_t Len;
+	int SavedFd;
+	AieRC RC = XAIE_OK;
+
+	Tmp = tmpfile();
+	if(Tmp == NULL)
+		return -1;
+
+	fflush(stdout);
+	SavedFd = dup(STDOUT_FILENO);
+	dup2(fileno(Tmp), STDOUT_FILENO);
+
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+	if(Run->MultiTile) {
+		RC = XAie_LoadElfMultiTile(Run->DevInst, Run->Locs,
+				Run->NumTiles, Run->ElfPath, XAIE_DISABLE);
+	} else {
+		for(u32 i = 0U; i < Run->NumTiles && RC == XAIE_OK; i++)
+			RC = XAie_LoadElf(Run->DevInst, Run->Locs[i],
+					Run->ElfPath, XAIE_DISABLE);
+	}
+	fflush(stdout);
+	clock_gettime(CLOCK_MONOTONIC, &End);
+	Run->LoadUs = (End.tv_sec - Start.tv_sec) * 1e6 +
+		(End.tv_nsec - Start.tv_nsec) / 1e3;
+
+	dup2(SavedFd, STDOUT_FILENO);
+	close(SavedFd);
+
+	rewind(Tmp);
+	Len = fread(Trace, 1, TEST_TRACE_MAX - 1, Tmp);
+	Trace[Len] = '\0';
+	fclose(Tmp);
+	if(Len == TEST_TRACE_MAX - 1 || RC != XAIE_OK)
+		return -1;
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function compares two strings through pointers for qsort().
+*
+* @param	A: Pointer to the first string.
+* @param	B: Pointer to the second string.
+*
+* @return	Result of strcmp().
+*
+*******************************************************************************/
+static int CompareLines(const void *A, const void *B)
+{
+	return strcmp(*(char * const *)A, *(char * const *)B);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sorts the lines of a trace in place.
+*
+* @param	Trace: Trace to sort.
+*
+* @return	0 on success, -1 on failure.
+*
+*******************************************************************************/
+static int SortTrace(char *Trace)
+{
+	size_t Len = strlen(Trace), NumLines = 0U, Pos = 0U;
+	char **Lines, *Copy, *Line;
+
+	Copy = malloc(Len + 1U);
+	Lines = malloc((Len / 2U + 1U) * sizeof(*Lines));
+	if(Copy == NULL || Lines == NULL) {
+		free(Copy);
+		free(Lines);
+		return -1;
+	}
+	memcpy(Copy, Trace, Len + 1U);
+
+	for(Line = strtok(Copy, "\n"); Line != NULL; Line = strtok(NULL, "\n"))
+		Lines[NumLines++] = Line;
+	qsort(Lines, NumLines, sizeof(*Lines), CompareLines);
+
+	for(size_t i = 0U; i < NumLines; i++)
+		Pos += sprintf(Trace + Pos, "%s\n", Lines[i]);
+
+	free(Copy);
+	free(Lines);
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the register model entry of an address.
+*
+* @param	Model: Register model.
+* @param	Addr: Register address.
+*
+* @return	Pointer to the entry, NULL if the model is full.
+*
+*******************************************************************************/
+static RegEntry *ModelLookup(RegModel *Model, u64 Addr)
+{
+	u32 Idx = (u32)((Addr >> 2) * 2654435761U) & (TEST_REG_MAP_SIZE - 1);
+
+	for(u32 i = 0U; i < TEST_REG_MAP_SIZE; i++) {
+		RegEntry *Entry = &Model->Regs[(Idx + i) & (TEST_REG_MAP_SIZE - 1)];
+
+		if(!Entry->Valid) {
+			Entry->Valid = 1U;
+			Entry->Addr = Addr;
+			Entry->Value = 0U;
+			return Entry;
+		}
+		if(Entry->Addr == Addr)
+			return Entry;
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function applies a debug backend trace to a register model.
+*
+* @param	Model: Register model, cleared first.
+* @param	Trace: Captured trace.
+*
+* @return	0 on success, -1 on failure.
+*
+*******************************************************************************/
+static int ApplyTrace(RegModel *Model, const char *Trace)
+{
+	unsigned long Addr;
+	unsigned int Mask, Value;
+	RegEntry *Entry;
+
+	memset(Model, 0, sizeof(*Model));
+
+	while(*Trace != '\0') {
+		if(sscanf(Trace, "W: 0x%lx, 0x%x", &Addr, &Value) == 2) {
+			Entry = ModelLookup(Model, Addr);
+			if(Entry == NULL)
+				return -1;
+			Entry->Value = Value;
+			Model->NumWrites++;
+		} else if(sscanf(Trace, "MW: 0x%lx, 0x%x, 0x%x", &Addr,
+					&Mask, &Value) == 3) {
+			Entry = ModelLookup(Model, Addr);
+			if(Entry == NULL)
+				return -1;
+			Entry->Value = (Entry->Value & ~Mask) | (Value & Mask);
+			Model->NumWrites++;
+		} else if(strncmp(Trace, "R: ", 3) == 0 ||
+				strncmp(Trace, "MP: ", 4) == 0) {
+			Model->NumReads++;
+		}
+
+		Trace = strchr(Trace, '\n');
+		if(Trace == NULL)
+			break;
+		Trace++;
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function compares the register state of two models.
+*
+* @param	A: First register model.
+* @param	B: Second register model.
+*
+* @return	Number of registers which differ.
+*
+*******************************************************************************/
+static u32 CompareModels(RegModel *A, RegModel *B)
+{
+	u32 Diff = 0U;
+	RegEntry *Entry;
+
+	for(u32 i = 0U; i < TEST_REG_MAP_SIZE; i++) {
+		if(A->Regs[i].Valid) {
+			Entry = ModelLookup(B, A->Regs[i].Addr);
+			if(Entry == NULL || Entry->Value != A->Regs[i].Value)
+				Diff++;
+		}
+		if(B->Regs[i].Valid) {
+			Entry = ModelLookup(A, B->Regs[i].Addr);
+			if(Entry == NULL || Entry->Value != B->Regs[i].Value)
+				Diff++;
+		}
+	}
+
+	return Diff;
+}
+
+int main(void)
+{
+	static const u32 NumTiles[] = {1U, 8U, 32U, TEST_MAX_TILES};
+	XAie_LocType Locs[TEST_MAX_TILES];
+	XAie_DevInst DevRef, DevMulti;
+	char ElfPath[] = "/tmp/xaie_elf_testXXXXXX";
+	TestRun Ref, Multi;
+	int Errors = 0;
+
+	TraceRef = malloc(TEST_TRACE_MAX);
+	TraceMulti = malloc(TEST_TRACE_MAX);
+	if(TraceRef == NULL || TraceMulti == NULL || WriteElf(ElfPath) != 0) {
+		printf("Failed to prepare the test\n");
+		return 1;
+	}
+
+	/* Rows and columns which leave room for the neighbouring tiles */
+	for(u32 i = 0U; i < TEST_MAX_TILES; i++) {
+		u32 NumRows = XAIE_AIE_TILE_ROW_START + XAIE_AIE_TILE_NUM_ROWS -
+			TEST_FIRST_ROW;
+
+		Locs[i] = XAie_TileLoc(TEST_FIRST_COL + i / NumRows,
+				TEST_FIRST_ROW + i % NumRows);
+	}
+
+	for(u32 n = 0U; n < sizeof(NumTiles) / sizeof(NumTiles[0]); n++) {
+		if(InitDevice(&DevRef) != XAIE_OK ||
+				InitDevice(&DevMulti) != XAIE_OK) {
+			printf("Failed to initialize the device instances\n");
+			return 1;
+		}
+
+		Ref = (TestRun){.DevInst = &DevRef, .ElfPath = ElfPath,
+			.Locs = Locs, .NumTiles = NumTiles[n]};
+		Multi = Ref;
+		Multi.DevInst = &DevMulti;
+		Multi.MultiTile = 1U;
+
+		if(LoadCaptured(&Ref, TraceRef) != 0 ||
+				LoadCaptured(&Multi, TraceMulti) != 0) {
+			printf("%u tiles: failed to load the elf\n",
+					NumTiles[n]);
+			Errors++;
+			break;
+		}
+
+		if(ApplyTrace(&ModelRef, TraceRef) != 0 ||
+				ApplyTrace(&ModelMulti, TraceMulti) != 0 ||
+				CompareModels(&ModelRef, &ModelMulti) != 0U) {
+			printf("%u tiles: register state differs\n",
+					NumTiles[n]);
+			Errors++;
+		}
+
+		if(SortTrace(TraceRef) != 0 || SortTrace(TraceMulti) != 0 ||
+				strcmp(TraceRef, TraceMulti) != 0) {
+			printf("%u tiles: register operations differ\n",
+					NumTiles[n]);
+			Errors++;
+		}
+
+		printf("%u tiles: %u register writes, per tile %.0f us, "
+				"multi tile %.0f us\n", NumTiles[n],
+				ModelRef.NumWrites, Ref.LoadUs, Multi.LoadUs);
+
+		XAie_Finish(&DevRef);
+		XAie_Finish(&DevMulti);
+	}
+
+	unlink(ElfPath);
+	free(TraceRef);
+	free(TraceMulti);
+
+	if(Errors != 0) {
+		printf("Multi tile elf loader test against the debug backend "
+				"failed\n");
+		return 1;
+	}
+
+	printf("Successfully ran multi tile elf loader test against the debug "
+			"backend\n");
+	return 0;
+}
+
+/** @} */
@@ -0,0 +1,785 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_profile_debug_test.c
+* @{
+*
+* This file contains the host test of the profiling service against a
+* synthetic counter model on the debug backend. The register operations of
+* the debug backend are routed to a model of the AIE tile registers in which:
+*	- A global clock advances by TEST_CYCLES_PER_ACCESS cycles at every
+*	  register access, and is read through the core module timer.
+*	- A performance counter counts while its start event is programmed.
+*	  Every event of every tile is active for a different fraction of the
+*	  cycles, so a counter read from the wrong tile or counter, or counting
+*	  the wrong event, gives a different increment.
+* The test checks that:
+*	- XAie_ProfileStart() programs the events of the profile, with the
+*	  same start and stop event, and clears the counters.
+*	- Between two samples, every counter increments by the active fraction
+*	  of its event times the increment of the timestamps.
+*	- The timestamps are consistent when the low word of the timer wraps
+*	  in the middle of a sample.
+*	- The ring buffer keeps the newest samples, and the CSV and Chrome trace
+*	  exports hold these samples.
+*	- XAie_ProfileStop() releases the counters.
+*
+* The test is built and run on the build machine by the Makefile of this
+* directory.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <xaiengine.h>
+#include <xaiengine/xaie_io.h>
+#include <xaiengine/xaiegbl_params.h>
+
+/************************** Constant Definitions *****************************/
+#define XAIE_BASE_ADDR		0x20000000000
+#define XAIE_COL_SHIFT		23
+#define XAIE_ROW_SHIFT		18
+#define XAIE_NUM_COLS		50
+#define XAIE_NUM_ROWS		9
+#define XAIE_SHIM_ROW		0
+#define XAIE_RES_TILE_ROW_START	0
+#define XAIE_RES_TILE_NUM_ROWS	0
+#define XAIE_AIE_TILE_ROW_START	1
+#define XAIE_AIE_TILE_NUM_ROWS	8
+
+#define TEST_REG_MAP_SIZE	(1 << 12)
+#define TEST_TILE_ADDR_MASK	((1ULL << XAIE_ROW_SHIFT) - 1U)
+#define TEST_CYCLES_PER_ACCESS	37U
+#define TEST_SAMPLE_GAP		50000U
+#define TEST_NUM_SAMPLES	40U
+#define TEST_MAX_SAMPLES	16U
+#define TEST_CLK_FREQ_MHZ	1000U
+#define TEST_EVENT_MASK		0x7FU
+#define TEST_CSV_PATH		"xaie_profile_debug_test.csv"
+#define TEST_TRACE_PATH		"xaie_profile_debug_test.json"
+
+/*
+ * The increments of two samples are compared with the timestamps, which are
+ * read up to two register accesses later or earlier than a counter.
+ */
+#define TEST_TOLERANCE		(2U * TEST_CYCLES_PER_ACCESS + 1U)
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u64 Addr;
+	u32 Value;
+	u64 Cycle;		/* Clock when a counter was written */
+	u8 Valid;
+} RegEntry;
+
+typedef struct {
+	RegEntry Regs[TEST_REG_MAP_SIZE];
+	u64 Cycle;		/* Global clock */
+} RegModel;
+
+/************************** Variable Definitions *****************************/
+static RegModel Model;
+static XAie_Backend ModelBackend;
+static const XAie_LocType TestLocs[] = {
+	{.Row = 1U, .Col = 1U}, {.Row = 3U, .Col = 2U},
+	{.Row = 8U, .Col = 2U}, {.Row = 4U, .Col = 7U},
+};
+static u64 TimeBefore[TEST_NUM_SAMPLES];
+static u64 TimeAfter[TEST_NUM_SAMPLES];
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This function returns the entry of a register in the model.
+*
+* @param	Addr: Register offset.
+* @param	Create: Create the entry if the register was never written.
+*
+* @return	Pointer to the entry, NULL if not found and not created.
+*
+*******************************************************************************/
+static RegEntry *ModelLookup(u64 Addr, u8 Create)
+{
+	u32 Idx = (u32)((Addr >> 2) ^ (Addr >> XAIE_ROW_SHIFT)) &
+		(TEST_REG_MAP_SIZE - 1);
+
+	while(Model.Regs[Idx].Valid && Model.Regs[Idx].Addr != Addr)
+		Idx = (Idx + 1U) & (TEST_REG_MAP_SIZE - 1);
+
+	if(!Model.Regs[Idx].Valid) {
+		if(!Create)
+			return NULL;
+		Model.Regs[Idx].Valid = 1U;
+		Model.Regs[Idx].Addr = Addr;
+		Model.Regs[Idx].Value = 0U;
+		Model.Regs[Idx].Cycle = Model.Cycle;
+	}
+
+	return &Model.Regs[Idx];
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the value of a register of the model.
+*
+* @param	Addr: Register offset.
+*
+* @return	Register value, 0 if never written.
+*
+*******************************************************************************/
+static u32 ModelValue(u64 Addr)
+{
+	RegEntry *Entry = ModelLookup(Addr, 0U);
+
+	return (Entry != NULL) ? Entry->Value : 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the fraction of cycles, in sixteenths, an event of a
+* tile is active in the model.
+*
+* @param	TileAddr: Offset of the tile.
+* @param	Module: Module of the event.
+* @param	HwEvent: Event number of the module.
+*
+* @return	Active sixteenths of the cycles, 1 to 15.
+*
+*******************************************************************************/
+static u32 ModelDuty(u64 TileAddr, XAie_ModuleType Module, u8 HwEvent)
+{
+	u32 Col = (u32)(TileAddr >> XAIE_COL_SHIFT);
+	u32 Row = (u32)(TileAddr >> XAIE_ROW_SHIFT) & 0x1FU;
+
+	return (Col * 5U + Row * 3U + Module * 7U + HwEvent) % 15U + 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function decodes a performance counter address of an AIE tile.
+*
+* @param	Reg: Register offset within the tile.
+* @param	Module: Pointer to store the module of the counter.
+* @param	CtrlReg: Pointer to store the offset of the control register.
+* @param	Shift: Pointer to store the shift of the counter in the control
+*		register.
+*
+* @return	1 if the register is a counter, 0 otherwise.
+*
+*******************************************************************************/
+static int ModelDecodeCounter(u64 Reg, XAie_ModuleType *Module, u64 *CtrlReg,
+		u32 *Shift)
+{
+	u32 Counter;
+
+	if(Reg >= XAIEGBL_CORE_PERCOU0 && Reg < XAIEGBL_CORE_PERCOU0 + 16U) {
+		Counter = (u32)(Reg - XAIEGBL_CORE_PERCOU0) / 4U;
+		*Module = XAIE_CORE_MOD;
+		*CtrlReg = XAIEGBL_CORE_PERCTR0 + (Counter / 2U) * 4U;
+	} else if(Reg >= XAIEGBL_MEM_PERCOU0 &&
+			Reg < XAIEGBL_MEM_PERCOU0 + 8U) {
+		Counter = (u32)(Reg - XAIEGBL_MEM_PERCOU0) / 4U;
+		*Module = XAIE_MEM_MOD;
+		*CtrlReg = XAIEGBL_MEM_PERCTRL0;
+	} else {
+		return 0;
+	}
+
+	*Shift = 16U * (Counter % 2U);
+
+	return 1;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes a register of the model. Writing a counter restarts
+* its count from the written value.
+*
+* @param	IOInst: IO instance of the debug backend, unused.
+* @param	RegOff: Register offset.
+* @param	Value: Value to write.
+*
+* @return	None.
+*
+*******************************************************************************/
+static void ModelWrite32(void *IOInst, u64 RegOff, u32 Value)
+{
+	RegEntry *Entry = ModelLookup(RegOff, 1U);
+
+	(void)IOInst;
+	Entry->Value = Value;
+	Entry->Cycle = Model.Cycle;
+	Model.Cycle += TEST_CYCLES_PER_ACCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads a register of the model. The timer returns the global
+* clock, a counter returns its written value plus the cycles its start event
+* was active since then.
+*
+* @param	IOInst: IO instance of the debug backend, unused.
+* @param	RegOff: Register offset.
+*
+* @return	Register value.
+*
+*******************************************************************************/
+static u32 ModelRead32(void *IOInst, u64 RegOff)
+{
+	u64 TileAddr = RegOff & ~TEST_TILE_ADDR_MASK;
+	u64 Reg = RegOff & TEST_TILE_ADDR_MASK;
+	XAie_ModuleType Module;
+	u64 CtrlReg;
+	u32 Shift, Value;
+	u8 HwEvent;
+
+	(void)IOInst;
+	if(Reg == XAIEGBL_CORE_TIMLOW) {
+		Value = (u32)Model.Cycle;
+	} else if(Reg == XAIEGBL_CORE_TIMHIG) {
+		Value = (u32)(Model.Cycle >> 32);
+	} else if(ModelDecodeCounter(Reg, &Module, &CtrlReg, &Shift)) {
+		RegEntry *Entry = ModelLookup(RegOff, 1U);
+
+		HwEvent = (ModelValue(TileAddr + CtrlReg) >> Shift) &
+			TEST_EVENT_MASK;
+		Value = Entry->Value;
+		if(HwEvent != 0U)
+			Value += (u32)((Model.Cycle - Entry->Cycle) *
+					ModelDuty(TileAddr, Module, HwEvent) /
+					16U);
+	} else {
+		Value = ModelValue(RegOff);
+	}
+
+	Model.Cycle += TEST_CYCLES_PER_ACCESS;
+
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes a register field of the model.
+*
+* @param	IOInst: IO instance of the debug backend, unused.
+* @param	RegOff: Register offset.
+* @param	Mask: Mask of the field.
+* @param	Value: Value of the field.
+*
+* @return	None.
+*
+*******************************************************************************/
+static void ModelMaskWrite32(void *IOInst, u64 RegOff, u32 Mask, u32 Value)
+{
+	ModelWrite32(IOInst, RegOff,
+			(ModelValue(RegOff) & ~Mask) | (Value & Mask));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes consecutive registers of the model.
+*
+* @param	IOInst: IO instance of the debug backend, unused.
+* @param	RegOff: Offset of the first register.
+* @param	Data: Values to write.
+* @param	Size: Number of registers.
+*
+* @return	None.
+*
+*******************************************************************************/
+static void ModelBlockWrite32(void *IOInst, u64 RegOff, u32 *Data, u32 Size)
+{
+	for(u32 i = 0U; i < Size; i++)
+		ModelWrite32(IOInst, RegOff + i * 4U, Data[i]);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets consecutive registers of the model to one value.
+*
+* @param	IOInst: IO instance of the debug backend, unused.
+* @param	RegOff: Offset of the first register.
+* @param	Data: Value to write.
+* @param	Size: Number of registers.
+*
+* @return	None.
+*
+*******************************************************************************/
+static void ModelBlockSet32(void *IOInst, u64 RegOff, u32 Data, u32 Size)
+{
+	for(u32 i = 0U; i < Size; i++)
+		ModelWrite32(IOInst, RegOff + i * 4U, Data);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function creates a device instance on the debug backend and routes its
+* register operations to the counter model.
+*
+* @param	DevInst: Device instance to initialize.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+*******************************************************************************/
+static AieRC InitDevice(XAie_DevInst *DevInst)
+{
+	AieRC RC;
+
+	XAie_SetupConfig(ConfigPtr, XAIE_DEV_GEN_AIE, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_RES_TILE_ROW_START, XAIE_RES_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+
+	memset(DevInst, 0, sizeof(*DevInst));
+	RC = XAie_CfgInitialize(DevInst, &ConfigPtr);
+	if(RC != XAIE_OK)
+		return RC;
+
+	ModelBackend = *DevInst->Backend;
+	ModelBackend.Ops.Write32 = ModelWrite32;
+	ModelBackend.Ops.Read32 = ModelRead32;
+	ModelBackend.Ops.MaskWrite32 = ModelMaskWrite32;
+	ModelBackend.Ops.BlockWrite32 = ModelBlockWrite32;
+	ModelBackend.Ops.BlockSet32 = ModelBlockSet32;
+	DevInst->Backend = &ModelBackend;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks that every tile counts the events of the profile on
+* distinct counters, with the same start and stop event, starting from zero.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	Number of errors.
+*
+*******************************************************************************/
+static int CheckProgramming(XAie_ProfileInst *ProfInst)
+{
+	const XAie_ProfileCfg *Cfg = &ProfInst->Cfg;
+	int Errors = 0;
+
+	for(u32 t = 0U; t < ProfInst->NumTiles; t++) {
+		XAie_LocType Loc = ProfInst->Locs[t];
+		u64 TileAddr = ((u64)Loc.Col << XAIE_COL_SHIFT) |
+			((u64)Loc.Row << XAIE_ROW_SHIFT);
+		u32 Used = 0U;
+
+		for(u32 e = 0U; e < Cfg->NumEvents; e++) {
+			u64 Reg = ProfInst->CounterAddrs[t * Cfg->NumEvents + e] -
+				TileAddr;
+			XAie_ModuleType Module;
+			u64 CtrlReg;
+			u32 Shift, Ctrl, Bit;
+			u8 HwEvent;
+
+			if((Reg & ~TEST_TILE_ADDR_MASK) != 0U ||
+					!ModelDecodeCounter(Reg, &Module,
+						&CtrlReg, &Shift) ||
+					Module != Cfg->Events[e].Module) {
+				printf("Event %s of tile (%u, %u) is not on a "
+						"counter of its module\n",
+						Cfg->Events[e].Name, Loc.Col,
+						Loc.Row);
+				Errors++;
+				continue;
+			}
+
+			Bit = 1U << ((Module == XAIE_CORE_MOD ? 8U : 0U) +
+					(u32)(Reg & 0xFFU) / 4U);
+			if(Used & Bit) {
+				printf("Counter of event %s of tile (%u, %u) "
+						"is shared\n",
+						Cfg->Events[e].Name, Loc.Col,
+						Loc.Row);
+				Errors++;
+			}
+			Used |= Bit;
+
+			XAie_EventLogicalToPhysicalConv(ProfInst->DevInst, Loc,
+					Module, Cfg->Events[e].Event, &HwEvent);
+			Ctrl = ModelValue(TileAddr + CtrlReg) >> Shift;
+			if((Ctrl & TEST_EVENT_MASK) != HwEvent ||
+					((Ctrl >> 8) & TEST_EVENT_MASK) !=
+					HwEvent) {
+				printf("Event %s of tile (%u, %u) programmed "
+						"as 0x%x\n",
+						Cfg->Events[e].Name, Loc.Col,
+						Loc.Row, Ctrl & 0xFFFFU);
+				Errors++;
+			}
+
+			if(ModelValue(TileAddr + Reg) != 0U) {
+				printf("Counter of event %s of tile (%u, %u) "
+						"not cleared\n",
+						Cfg->Events[e].Name, Loc.Col,
+						Loc.Row);
+				Errors++;
+			}
+		}
+	}
+
+	return Errors;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function takes the samples. Before each sample the clock jumps ahead,
+* close to a wrap of the low word of the timer for most samples so that the
+* wrap falls between different reads of the sample.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	Number of errors.
+*
+*******************************************************************************/
+static int TakeSamples(XAie_ProfileInst *ProfInst)
+{
+	for(u32 s = 0U; s < TEST_NUM_SAMPLES; s++) {
+		u64 Next = Model.Cycle + TEST_SAMPLE_GAP;
+		u32 Pos = s % 5U;
+
+		if(Pos < 4U) {
+			Next = ((Next >> 32) + 1U) << 32;
+			Next -= (u64)Pos * TEST_CYCLES_PER_ACCESS + 1U;
+		}
+		Model.Cycle = Next;
+
+		TimeBefore[s] = Model.Cycle;
+		if(XAie_ProfileSample(ProfInst) != XAIE_OK) {
+			printf("Sample %u failed\n", s);
+			return 1;
+		}
+		TimeAfter[s] = Model.Cycle;
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks the samples left in the ring buffer against the model.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	Number of errors.
+*
+*******************************************************************************/
+static int CheckSamples(XAie_ProfileInst *ProfInst)
+{
+	const XAie_ProfileCfg *Cfg = &ProfInst->Cfg;
+	u32 NumValues = ProfInst->NumTiles * Cfg->NumEvents;
+	u32 First = TEST_NUM_SAMPLES - TEST_MAX_SAMPLES;
+	u32 Oldest = ProfInst->Head;
+	int Errors = 0;
+
+	if(ProfInst->NumSamples != TEST_MAX_SAMPLES ||
+			ProfInst->NumDropped != First) {
+		printf("%u samples kept and %llu dropped\n",
+				ProfInst->NumSamples,
+				(unsigned long long)ProfInst->NumDropped);
+		return 1;
+	}
+
+	for(u32 s = 0U; s < TEST_MAX_SAMPLES; s++) {
+		u32 Slot = (Oldest + s) % TEST_MAX_SAMPLES;
+		u32 PrevSlot = (Slot + TEST_MAX_SAMPLES - 1U) %
+			TEST_MAX_SAMPLES;
+		u64 Timestamp = ProfInst->Timestamps[Slot];
+		u64 Elapsed;
+
+		if(Timestamp < TimeBefore[First + s] ||
+				Timestamp >= TimeAfter[First + s]) {
+			printf("Timestamp 0x%llx of sample %u outside of "
+					"0x%llx to 0x%llx\n",
+					(unsigned long long)Timestamp,
+					First + s,
+					(unsigned long long)TimeBefore[First + s],
+					(unsigned long long)TimeAfter[First + s]);
+			Errors++;
+		}
+
+		if(s == 0U)
+			continue;
+
+		Elapsed = Timestamp - ProfInst->Timestamps[PrevSlot];
+		for(u32 i = 0U; i < NumValues; i++) {
+			XAie_LocType Loc = ProfInst->Locs[i / Cfg->NumEvents];
+			const XAie_ProfileEvent *Event =
+				&Cfg->Events[i % Cfg->NumEvents];
+			u64 TileAddr = ((u64)Loc.Col << XAIE_COL_SHIFT) |
+				((u64)Loc.Row << XAIE_ROW_SHIFT);
+			u32 Delta, Expected;
+			s32 Diff;
+			u8 HwEvent;
+
+			XAie_EventLogicalToPhysicalConv(ProfInst->DevInst, Loc,
+					Event->Module, Event->Event, &HwEvent);
+			Expected = (u32)(Elapsed * ModelDuty(TileAddr,
+						Event->Module, HwEvent) / 16U);
+			Delta = ProfInst->Values[(u64)Slot * NumValues + i] -
+				ProfInst->Values[(u64)PrevSlot * NumValues + i];
+			Diff = (s32)(Delta - Expected);
+			if(Diff > (s32)TEST_TOLERANCE ||
+					Diff < -(s32)TEST_TOLERANCE) {
+				printf("Event %s of tile (%u, %u) counted %u "
+						"instead of %u in sample %u\n",
+						Event->Name, Loc.Col, Loc.Row,
+						Delta, Expected, First + s);
+				Errors++;
+			}
+		}
+	}
+
+	return Errors;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks the CSV export: one line per sample, tile and event,
+* in the order of the samples, with the values of the ring buffer.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	Number of errors.
+*
+*******************************************************************************/
+static int CheckCsv(XAie_ProfileInst *ProfInst)
+{
+	const XAie_ProfileCfg *Cfg = &ProfInst->Cfg;
+	u32 NumValues = ProfInst->NumTiles * Cfg->NumEvents;
+	u32 First = TEST_NUM_SAMPLES - TEST_MAX_SAMPLES;
+	unsigned long long Timestamp;
+	unsigned int Col, Row, Value, Delta;
+	char Line[256], Name[64];
+	u32 NumLines = 0U;
+	int Errors = 0;
+	FILE *Fd;
+
+	if(XAie_ProfileExportCsv(ProfInst, TEST_CSV_PATH) != XAIE_OK) {
+		printf("CSV export failed\n");
+		return 1;
+	}
+
+	Fd = fopen(TEST_CSV_PATH, "r");
+	if(Fd == NULL || fgets(Line, sizeof(Line), Fd) == NULL) {
+		printf("Unable to read the CSV export\n");
+		return 1;
+	}
+
+	while(fgets(Line, sizeof(Line), Fd) != NULL) {
+		u32 s = NumLines / NumValues;
+		u32 i = NumLines % NumValues;
+		u32 Slot = (ProfInst->Head + s) % TEST_MAX_SAMPLES;
+		u32 Expected = ProfInst->Values[(u64)Slot * NumValues + i];
+		XAie_LocType Loc = ProfInst->Locs[i / Cfg->NumEvents];
+
+		if(s >= TEST_MAX_SAMPLES ||
+				sscanf(Line, "%llu,%u,%u,%63[^,],%u,%u",
+					&Timestamp, &Col, &Row, Name, &Value,
+					&Delta) != 6 ||
+				Timestamp < TimeBefore[First + s] ||
+				Timestamp >= TimeAfter[First + s] ||
+				Col != Loc.Col || Row != Loc.Row ||
+				strcmp(Name,
+					Cfg->Events[i % Cfg->NumEvents].Name) ||
+				Value != Expected) {
+			if(Errors++ == 0)
+				printf("Unexpected CSV line %u: %s", NumLines,
+						Line);
+		}
+		NumLines++;
+	}
+	fclose(Fd);
+	remove(TEST_CSV_PATH);
+
+	if(NumLines != TEST_MAX_SAMPLES * NumValues) {
+		printf("%u CSV lines instead of %u\n", NumLines,
+				TEST_MAX_SAMPLES * NumValues);
+		Errors++;
+	}
+
+	return Errors;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks the Chrome trace export: one process per column and one
+* counter event per tile for each pair of samples.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	Number of errors.
+*
+*******************************************************************************/
+static int CheckChromeTrace(XAie_ProfileInst *ProfInst)
+{
+	u32 NumCounters = 0U, NumProcesses = 0U;
+	char Line[1024];
+	int Errors = 0;
+	FILE *Fd;
+
+	if(XAie_ProfileExportChromeTrace(ProfInst, TEST_TRACE_PATH,
+				TEST_CLK_FREQ_MHZ) != XAIE_OK) {
+		printf("Chrome trace export failed\n");
+		return 1;
+	}
+
+	Fd = fopen(TEST_TRACE_PATH, "r");
+	if(Fd == NULL) {
+		printf("Unable to read the Chrome trace export\n");
+		return 1;
+	}
+
+	while(fgets(Line, sizeof(Line), Fd) != NULL) {
+		if(strstr(Line, "\"ph\":\"C\"") != NULL)
+			NumCounters++;
+		if(strstr(Line, "\"ph\":\"M\"") != NULL)
+			NumProcesses++;
+	}
+	fclose(Fd);
+	remove(TEST_TRACE_PATH);
+
+	/* The test tiles are in three columns */
+	if(NumProcesses != 3U ||
+			NumCounters != (TEST_MAX_SAMPLES - 1U) *
+			ProfInst->NumTiles) {
+		printf("Chrome trace with %u processes and %u counter events\n",
+				NumProcesses, NumCounters);
+		Errors++;
+	}
+
+	return Errors;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks that the profiled counters no longer count any event.
+*
+* @param	ProfInst: Profiling instance.
+*
+* @return	Number of errors.
+*
+*******************************************************************************/
+static int CheckReleased(XAie_ProfileInst *ProfInst)
+{
+	u32 NumValues = ProfInst->NumTiles * ProfInst->Cfg.NumEvents;
+	int Errors = 0;
+
+	for(u32 i = 0U; i < NumValues; i++) {
+		u64 RegOff = ProfInst->CounterAddrs[i];
+		u64 TileAddr = RegOff & ~TEST_TILE_ADDR_MASK;
+		XAie_ModuleType Module;
+		u64 CtrlReg;
+		u32 Shift;
+
+		ModelDecodeCounter(RegOff & TEST_TILE_ADDR_MASK, &Module,
+				&CtrlReg, &Shift);
+		if(((ModelValue(TileAddr + CtrlReg) >> Shift) &
+					TEST_EVENT_MASK) != 0U) {
+			Errors++;
+		}
+	}
+
+	if(Errors != 0)
+		printf("%d counters still count after stopping\n", Errors);
+
+	return Errors;
+}
+
+int main(void)
+{
+	XAie_DevInst DevInst;
+	XAie_ProfileInst *ProfInst;
+	int Errors = 0;
+
+	if(InitDevice(&DevInst) != XAIE_OK) {
+		printf("Failed to initialize the device instance\n");
+		return 1;
+	}
+
+	ProfInst = XAie_ProfileCreate(&DevInst,
+			XAie_ProfileGetPreset(XAIE_PROFILE_PRESET_STALLS),
+			(XAie_LocType *)TestLocs,
+			sizeof(TestLocs) / sizeof(TestLocs[0]),
+			TEST_MAX_SAMPLES);
+	if(ProfInst == NULL) {
+		printf("Failed to create the profiling instance\n");
+		return 1;
+	}
+
+	/* Start close to a wrap of the low word of the timer */
+	Model.Cycle = 0xFFFF0000U;
+	if(XAie_ProfileStart(ProfInst) != XAIE_OK) {
+		printf("Failed to start the profiling\n");
+		return 1;
+	}
+	Errors += CheckProgramming(ProfInst);
+
+	if(TakeSamples(ProfInst) != 0) {
+		XAie_ProfileFree(ProfInst);
+		return 1;
+	}
+	Errors += CheckSamples(ProfInst);
+	Errors += CheckCsv(ProfInst);
+	Errors += CheckChromeTrace(ProfInst);
+
+	if(XAie_ProfileStop(ProfInst) != XAIE_OK) {
+		printf("Failed to stop the profiling\n");
+		Errors++;
+	} else {
+		Errors += CheckReleased(ProfInst);
+	}
+
+	printf("%u tiles, %u events, %u samples kept of %u, clock at 0x%llx\n",
+			ProfInst->NumTiles, ProfInst->Cfg.NumEvents,
+			ProfInst->NumSamples, TEST_NUM_SAMPLES,
+			(unsigned long long)Model.Cycle);
+	XAie_ProfileFree(ProfInst);
+
+	if(Errors != 0) {
+		printf("Profiling test against the debug backend failed with %d errors\n",
+				Errors);
+		return 1;
+	}
+
+	printf("Profiling test against the debug backend passed\n");
+
+	return 0;
+}
+
+/** @} */
@@ -0,0 +1,391 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_shadow_debug_test.c
+* @{
+*
+* This file contains the host test of the register shadow against the debug
+* backend. The debug backend prints every register operation to stdout; the
+* test captures this trace for each register access and checks that:
+*	- A write of the value a shadowed register holds is dropped, a write of
+*	  a new value is issued.
+*	- Reads and mask writes of shadowed registers are served from the
+*	  shadow once the register is known, and read the hardware once
+*	  otherwise.
+*	- Registers which are not shadowed and writes recorded in a transaction
+*	  are always issued.
+*	- The hit and miss counters of the shadow match the issued operations.
+* It also prints the register writes of a stream switch route which is
+* configured twice, with and without the shadow.
+*
+* The test is built and run on the build machine by the Makefile of this
+* directory.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <xaiengine.h>
+#include <xaiengine/xaie_helper.h>
+
+/************************** Constant Definitions *****************************/
+#define XAIE_BASE_ADDR		0x20000000000
+#define XAIE_COL_SHIFT		23
+#define XAIE_ROW_SHIFT		18
+#define XAIE_NUM_COLS		50
+#define XAIE_NUM_ROWS		9
+#define XAIE_SHIM_ROW		0
+#define XAIE_RES_TILE_ROW_START	0
+#define XAIE_RES_TILE_NUM_ROWS	0
+#define XAIE_AIE_TILE_ROW_START	1
+#define XAIE_AIE_TILE_NUM_ROWS	8
+
+#define TEST_COL		2
+#define TEST_ROW		3
+#define TEST_DM_ADDR		0x1000
+#define TEST_TRACE_MAX		(1 << 16)
+
+/**************************** Type Definitions *******************************/
+typedef enum {
+	TEST_OP_WRITE,
+	TEST_OP_READ,
+	TEST_OP_MASK_WRITE,
+	TEST_OP_TXN_WRITE,
+	TEST_OP_ROUTE,
+} TestOpType;
+
+typedef struct {
+	XAie_DevInst *DevInst;
+	TestOpType Op;
+	u64 RegOff;
+	u32 Mask;
+	u32 Value;
+	u32 ReadVal;		/* Value returned by a read */
+} TestOp;
+
+typedef struct {
+	const char *Name;
+	TestOpType Op;
+	u64 RegOff;
+	u32 Mask;
+	u32 Value;
+	u32 NumWrites;		/* Expected W and MW lines */
+	u32 NumReads;		/* Expected R lines */
+} TestCase;
+
+/************************** Variable Definitions *****************************/
+static char Trace[TEST_TRACE_MAX];
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This function creates a device instance on the debug backend.
+*
+* @param	DevInst: Device instance to initialize.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+*******************************************************************************/
+static AieRC InitDevice(XAie_DevInst *DevInst)
+{
+	XAie_SetupConfig(ConfigPtr, XAIE_DEV_GEN_AIE, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_RES_TILE_ROW_START, XAIE_RES_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+
+	memset(DevInst, 0, sizeof(*DevInst));
+
+	return XAie_CfgInitialize(DevInst, &ConfigPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs a test step and captures the register trace printed by
+* the debug backend.
+*
+* @param	Step: Test step to run.
+* @param	Arg: Argument of the test step.
+* @param	Trace: Buffer for the captured trace.
+*
+* @return	Return value of the test step, -1 if capturing failed.
+*
+*******************************************************************************/
+static int RunCaptured(int (*Step)(void *Arg), void *Arg, char *Trace)
+{
+	FILE *Tmp;
+	size_t Len;
+	int SavedFd;
+	int Ret;
+
+	Tmp = tmpfile();
+	if(Tmp == NULL)
+		return -1;
+
+	fflush(stdout);
+	SavedFd = dup(STDOUT_FILENO);
+	dup2(fileno(Tmp), STDOUT_FILENO);
+
+	Ret = Step(Arg);
+
+	fflush(stdout);
+	dup2(SavedFd, STDOUT_FILENO);
+	close(SavedFd);
+
+	rewind(Tmp);
+	Len = fread(Trace, 1, TEST_TRACE_MAX - 1, Tmp);
+	Trace[Len] = '\0';
+	if(Len == TEST_TRACE_MAX - 1)
+		Ret = -1;
+	fclose(Tmp);
+
+	return Ret;
+}
+
+/*****************************************************************************/
+/**
+*
+* Test step which issues one register access, a write recorded and submitted
+* in a transaction, or configures a stream switch route through the AIE tile.
+*
+* @param	Arg: Pointer to TestOp.
+*
+* @return	0 on success, -1 on failure.
+*
+*******************************************************************************/
+static int StepOp(void *Arg)
+{
+	TestOp *Op = (TestOp *)Arg;
+	XAie_LocType Loc = XAie_TileLoc(TEST_COL, TEST_ROW);
+
+	switch(Op->Op) {
+	case TEST_OP_WRITE:
+		XAie_Write32(Op->DevInst, Op->RegOff, Op->Value);
+		break;
+	case TEST_OP_READ:
+		Op->ReadVal = XAie_Read32(Op->DevInst, Op->RegOff);
+		break;
+	case TEST_OP_MASK_WRITE:
+		XAie_MaskWrite32(Op->DevInst, Op->RegOff, Op->Mask, Op->Value);
+		break;
+	case TEST_OP_TXN_WRITE:
+		if(XAie_StartTransaction(Op->DevInst, XAIE_TRANSACTION_DEFAULT |
+					XAIE_TRANSACTION_DISABLE_AUTO_FLUSH) !=
+				XAIE_OK)
+			return -1;
+		XAie_Write32(Op->DevInst, Op->RegOff, Op->Value);
+		if(XAie_SubmitTransaction(Op->DevInst, NULL) != XAIE_OK)
+			return -1;
+		break;
+	case TEST_OP_ROUTE:
+		if(XAie_StrmConnCctEnable(Op->DevInst, Loc, SOUTH, 0, DMA,
+					0) != XAIE_OK ||
+				XAie_StrmConnCctEnable(Op->DevInst, Loc, DMA,
+					0, NORTH, 0) != XAIE_OK)
+			return -1;
+		break;
+	default:
+		return -1;
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function counts the writes and the reads of a captured trace.
+*
+* @param	Trace: Captured trace.
+* @param	NumWrites: Pointer to store the number of W and MW lines.
+* @param	NumReads: Pointer to store the number of R lines.
+*
+* @return	None.
+*
+*******************************************************************************/
+static void CountTrace(const char *Trace, u32 *NumWrites, u32 *NumReads)
+{
+	*NumWrites = 0U;
+	*NumReads = 0U;
+
+	while(*Trace != '\0') {
+		if(strncmp(Trace, "W: ", 3) == 0 ||
+				strncmp(Trace, "MW: ", 4) == 0)
+			(*NumWrites)++;
+		else if(strncmp(Trace, "R: ", 3) == 0)
+			(*NumReads)++;
+
+		Trace = strchr(Trace, '\n');
+		if(Trace == NULL)
+			break;
+		Trace++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs a register access and checks the operations it issues.
+*
+* @param	DevInst: Device instance.
+* @param	Case: Test case.
+*
+* @return	Number of errors.
+*
+*******************************************************************************/
+static int RunCase(XAie_DevInst *DevInst, const TestCase *Case)
+{
+	TestOp Op = {.DevInst = DevInst, .Op = Case->Op,
+		.RegOff = Case->RegOff, .Mask = Case->Mask,
+		.Value = Case->Value};
+	u32 NumWrites, NumReads;
+
+	if(RunCaptured(StepOp, &Op, Trace) != 0) {
+		printf("%s: failed to run\n", Case->Name);
+		return 1;
+	}
+
+	CountTrace(Trace, &NumWrites, &NumReads);
+	if(NumWrites != Case->NumWrites || NumReads != Case->NumReads) {
+		printf("%s: %u writes and %u reads, expected %u and %u\n",
+				Case->Name, NumWrites, NumReads,
+				Case->NumWrites, Case->NumReads);
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	XAie_DevInst DevInst;
+	XAie_ShadowStats Stats;
+	u64 TileAddr, Reg, Reg2, Reg3, DmReg;
+	u32 RouteWrites[2], NumReads;
+	TestOp Op;
+	int Errors = 0;
+
+	if(InitDevice(&DevInst) != XAIE_OK) {
+		printf("Failed to initialize the device instance\n");
+		return 1;
+	}
+
+	/* Stream switch route configured twice without the shadow */
+	Op = (TestOp){.DevInst = &DevInst, .Op = TEST_OP_ROUTE};
+	for(int Pass = 0; Pass < 2; Pass++) {
+		if(RunCaptured(StepOp, &Op, Trace) != 0) {
+			printf("Failed to configure the route\n");
+			return 1;
+		}
+		CountTrace(Trace, &RouteWrites[Pass], &NumReads);
+	}
+	printf("Route without shadow: %u writes, then %u writes\n",
+			RouteWrites[0], RouteWrites[1]);
+
+	if(XAie_ShadowCacheEnable(&DevInst) != XAIE_OK) {
+		printf("Failed to enable the shadow\n");
+		return 1;
+	}
+
+	/* Shadowed registers of the AIE tile, and its data memory */
+	TileAddr = _XAie_GetTileAddr(&DevInst, TEST_ROW, TEST_COL);
+	Reg = TileAddr +
+		DevInst.ShadowInst->Ranges[XAIEGBL_TILE_TYPE_AIETILE][0].Start;
+	Reg2 = Reg + 4U;
+	Reg3 = Reg + 8U;
+	DmReg = TileAddr + TEST_DM_ADDR;
+
+	const TestCase Cases[] = {
+		{"First write", TEST_OP_WRITE, Reg, 0U, 0x11U, 1U, 0U},
+		{"Same value", TEST_OP_WRITE, Reg, 0U, 0x11U, 0U, 0U},
+		{"New value", TEST_OP_WRITE, Reg, 0U, 0x22U, 1U, 0U},
+		{"Same value again", TEST_OP_WRITE, Reg, 0U, 0x22U, 0U, 0U},
+		{"Read hit", TEST_OP_READ, Reg, 0U, 0U, 0U, 0U},
+		{"Read miss", TEST_OP_READ, Reg2, 0U, 0U, 0U, 1U},
+		{"Read after miss", TEST_OP_READ, Reg2, 0U, 0U, 0U, 0U},
+		{"Write of read value", TEST_OP_WRITE, Reg2, 0U, 0U, 0U, 0U},
+		{"Mask write hit", TEST_OP_MASK_WRITE, Reg, 0xF0U, 0x30U, 1U,
+			0U},
+		{"Mask write no change", TEST_OP_MASK_WRITE, Reg, 0xF0U, 0x30U,
+			0U, 0U},
+		{"Mask write miss", TEST_OP_MASK_WRITE, Reg3, 0xFU, 0x5U, 1U,
+			1U},
+		{"Unshadowed write", TEST_OP_WRITE, DmReg, 0U, 0x33U, 1U, 0U},
+		{"Unshadowed same value", TEST_OP_WRITE, DmReg, 0U, 0x33U, 1U,
+			0U},
+		/* A recorded transaction may be replayed on another partition */
+		{"Same value in transaction", TEST_OP_TXN_WRITE, Reg, 0U,
+			0x32U, 1U, 0U},
+		{"Same value after transaction", TEST_OP_WRITE, Reg, 0U, 0x32U,
+			0U, 0U},
+	};
+
+	for(u32 i = 0U; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+		Errors += RunCase(&DevInst, &Cases[i]);
+
+	XAie_ShadowCacheGetStats(&DevInst, &Stats);
+	/* Writes: 6 direct, 1 of a read value, 3 from the mask writes */
+	if(Stats.Writes != 10U || Stats.WriteHits != 5U ||
+			Stats.ReadHits != 2U || Stats.ReadMisses != 1U ||
+			Stats.MaskWriteHits != 2U ||
+			Stats.MaskWriteMisses != 1U) {
+		printf("Unexpected shadow statistics\n");
+		Errors++;
+	}
+	printf("Shadow: %lu writes, %lu dropped, reads %lu hits %lu misses, "
+			"mask writes %lu hits %lu misses\n",
+			(unsigned long)Stats.Writes,
+			(unsigned long)Stats.WriteHits,
+			(unsigned long)Stats.ReadHits,
+			(unsigned long)Stats.ReadMisses,
+			(unsigned long)Stats.MaskWriteHits,
+			(unsigned long)Stats.MaskWriteMisses);
+
+	/* Stream switch route configured twice with the shadow */
+	XAie_ShadowCacheInvalidate(&DevInst);
+	Op = (TestOp){.DevInst = &DevInst, .Op = TEST_OP_ROUTE};
+	for(int Pass = 0; Pass < 2; Pass++) {
+		if(RunCaptured(StepOp, &Op, Trace) != 0) {
+			printf("Failed to configure the route\n");
+			return 1;
+		}
+		CountTrace(Trace, &RouteWrites[Pass], &NumReads);
+	}
+	printf("Route with shadow: %u writes, then %u writes\n",
+			RouteWrites[0], RouteWrites[1]);
+	if(RouteWrites[0] == 0U || RouteWrites[1] != 0U) {
+		printf("Route configured again was not dropped\n");
+		Errors++;
+	}
+
+	XAie_ShadowCacheDisable(&DevInst);
+	XAie_Finish(&DevInst);
+
+	if(Errors != 0) {
+		printf("Shadow test against the debug backend failed\n");
+		return 1;
+	}
+
+	printf("Successfully ran shadow test against the debug backend\n");
+	return 0;
+}
+
+/** @} */
@@ -0,0 +1,536 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_txn_debug_test.c
+* @{
+*
+* This file contains the host test of the register IO transactions against the
+* debug backend. The debug backend prints every register operation to stdout;
+* the test captures this trace and checks that:
+*	- A transaction with the default flags issues the same register trace
+*	  as the direct driver calls, including the reads and polls which flush
+*	  the transaction.
+*	- An exported transaction replays the same register writes on another
+*	  device instance, any number of times.
+*	- A transaction with deduplication leaves the registers in the same
+*	  state as the direct driver calls while dropping redundant writes.
+* It also prints the number of backend calls with and without transactions.
+*
+* The test is built and run on the build machine by the Makefile of this
+* directory.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   Tejus   10/18/2020 Initial creation.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <xaiengine.h>
+
+/************************** Constant Definitions *****************************/
+#define XAIE_BASE_ADDR		0x20000000000
+#define XAIE_COL_SHIFT		23
+#define XAIE_ROW_SHIFT		18
+#define XAIE_NUM_COLS		50
+#define XAIE_NUM_ROWS		9
+#define XAIE_SHIM_ROW		0
+#define XAIE_RES_TILE_ROW_START	0
+#define XAIE_RES_TILE_NUM_ROWS	0
+#define XAIE_AIE_TILE_ROW_START	1
+#define XAIE_AIE_TILE_NUM_ROWS	8
+
+#define TEST_NUM_COLS		8
+#define TEST_DM_ADDR		0x1000
+#define TEST_DM_SIZE		64
+#define TEST_TRACE_MAX		(1 << 20)
+#define TEST_REG_MAP_SIZE	(1 << 16)
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u64 Addr;
+	u32 Value;
+	u8 Valid;
+} RegEntry;
+
+typedef struct {
+	XAie_DevInst *DevInst;
+	XAie_TxnInst *TxnInst;	/* Exported or replayed transaction */
+	u32 Flags;		/* Transaction flags */
+	u32 Repeat;		/* Number of times each tile is configured */
+	u8 UseTxn;		/* Configure in a transaction */
+	u8 Export;		/* Export the transaction instead of submitting */
+	u8 UseLocks;		/* Release locks while configuring */
+} TestRun;
+
+typedef struct {
+	RegEntry Regs[TEST_REG_MAP_SIZE];
+	u32 NumWrites;
+	u32 NumReads;
+} RegModel;
+
+/************************** Variable Definitions *****************************/
+static char TraceRef[TEST_TRACE_MAX];
+static char TraceTxn[TEST_TRACE_MAX];
+static char TraceRec[TEST_TRACE_MAX];
+static RegModel ModelRef, ModelTxn;
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This function creates a device instance on the debug backend.
+*
+* @param	DevInst: Device instance to initialize.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+*******************************************************************************/
+static AieRC InitDevice(XAie_DevInst *DevInst)
+{
+	XAie_SetupConfig(ConfigPtr, XAIE_DEV_GEN_AIE, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_RES_TILE_ROW_START, XAIE_RES_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+
+	memset(DevInst, 0, sizeof(*DevInst));
+
+	return XAie_CfgInitialize(DevInst, &ConfigPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function configures an AIE tile: stream switch routes, DMA buffer
+* descriptors, data memory contents and core enable, optionally with a lock
+* release which reads or polls the hardware.
+*
+* @param	DevInst: Device instance.
+* @param	Loc: Location of the AIE tile.
+* @param	Data: Data memory contents, TEST_DM_SIZE bytes.
+* @param	UseLocks: Release a lock before enabling the core.
+*
+* @return	None.
+*
+*******************************************************************************/
+static void ConfigureTile(XAie_DevInst *DevInst, XAie_LocType Loc,
+		const u32 *Data, u8 UseLocks)
+{
+	XAie_DmaDesc DmaDesc;
+	u8 Bd;
+
+	XAie_StrmConnCctEnable(DevInst, Loc, SOUTH, 0, DMA, 0);
+	XAie_StrmConnCctEnable(DevInst, Loc, DMA, 0, NORTH, 0);
+
+	for(Bd = 0U; Bd < 4U; Bd++) {
+		XAie_DmaDescInit(DevInst, &DmaDesc, Loc);
+		XAie_DmaSetAddrLen(&DmaDesc, TEST_DM_ADDR + Bd * TEST_DM_SIZE,
+				TEST_DM_SIZE);
+		XAie_DmaWriteBd(DevInst, &DmaDesc, Loc, Bd);
+	}
+
+	XAie_DataMemBlockWrite(DevInst, Loc, TEST_DM_ADDR, Data, TEST_DM_SIZE);
+	XAie_DataMemWrWord(DevInst, Loc, TEST_DM_ADDR, Loc.Row);
+
+	if(UseLocks)
+		XAie_LockRelease(DevInst, Loc, XAie_LockInit(Loc.Row, 1), 0);
+
+	XAie_CoreEnable(DevInst, Loc);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function configures a small graph over the first TEST_NUM_COLS
+* columns: a route through each shim tile and the AIE tiles above it.
+*
+* @param	DevInst: Device instance.
+* @param	UseLocks: Release locks between the tile configurations.
+* @param	Repeat: Number of times each AIE tile is configured in a row.
+*
+* @return	None.
+*
+*******************************************************************************/
+static void ConfigureGraph(XAie_DevInst *DevInst, u8 UseLocks, u32 Repeat)
+{
+	u32 Data[TEST_DM_SIZE / 4];
+	u8 Col, Row;
+
+	for(u32 i = 0U; i < TEST_DM_SIZE / 4; i++)
+		Data[i] = 0xA5000000U | i;
+
+	for(Col = 0U; Col < TEST_NUM_COLS; Col++) {
+		XAie_StrmConnCctEnable(DevInst,
+				XAie_TileLoc(Col, XAIE_SHIM_ROW),
+				NORTH, 0, SOUTH, 0);
+
+		for(Row = XAIE_AIE_TILE_ROW_START;
+				Row < XAIE_AIE_TILE_ROW_START +
+				XAIE_AIE_TILE_NUM_ROWS; Row++) {
+			for(u32 Pass = 0U; Pass < Repeat; Pass++)
+				ConfigureTile(DevInst, XAie_TileLoc(Col, Row),
+						Data, UseLocks);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs a test step and captures the register trace printed by
+* the debug backend.
+*
+* @param	Step: Test step to run.
+* @param	Arg: Argument of the test step.
+* @param	Trace: Buffer for the captured trace.
+*
+* @return	Return value of the test step, -1 if capturing failed.
+*
+*******************************************************************************/
+static int RunCaptured(int (*Step)(void *Arg), void *Arg, char *Trace)
+{
+	FILE *Tmp;
+	size_t Len;
+	int SavedFd;
+	int Ret;
+
+	Tmp = tmpfile();
+	if(Tmp == NULL)
+		return -1;
+
+	fflush(stdout);
+	SavedFd = dup(STDOUT_FILENO);
+	dup2(fileno(Tmp), STDOUT_FILENO);
+
+	Ret = Step(Arg);
+
+	fflush(stdout);
+	dup2(SavedFd, STDOUT_FILENO);
+	close(SavedFd);
+
+	rewind(Tmp);
+	Len = fread(Trace, 1, TEST_TRACE_MAX - 1, Tmp);
+	Trace[Len] = '\0';
+	if(Len == TEST_TRACE_MAX - 1)
+		Ret = -1;
+	fclose(Tmp);
+
+	return Ret;
+}
+
+/*****************************************************************************/
+/**
+*
+* Test step which configures the graph by direct driver calls, or in a
+* transaction which is submitted or exported.
+*
+* @param	Arg: Pointer to TestRun.
+*
+* @return	0 on success, -1 on failure.
+*
+*******************************************************************************/
+static int StepConfigure(void *Arg)
+{
+	TestRun *Run = (TestRun *)Arg;
+
+	if(Run->UseTxn) {
+		if(XAie_StartTransaction(Run->DevInst, Run->Flags) != XAIE_OK)
+			return -1;
+	}
+
+	ConfigureGraph(Run->DevInst, Run->UseLocks, Run->Repeat);
+
+	if(Run->UseTxn) {
+		if(Run->Export) {
+			Run->TxnInst = XAie_ExportTransaction(Run->DevInst);
+			if(Run->TxnInst == NULL)
+				return -1;
+		} else if(XAie_SubmitTransaction(Run->DevInst, NULL) !=
+				XAIE_OK) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Test step which submits an exported transaction.
+*
+* @param	Arg: Pointer to TestRun.
+*
+* @return	0 on success, -1 on failure.
+*
+*******************************************************************************/
+static int StepSubmit(void *Arg)
+{
+	TestRun *Run = (TestRun *)Arg;
+
+	return (XAie_SubmitTransaction(Run->DevInst, Run->TxnInst) == XAIE_OK) ?
+		0 : -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the register model entry of an address.
+*
+* @param	Model: Register model.
+* @param	Addr: Register address.
+*
+* @return	Pointer to the entry, NULL if the model is full.
+*
+*******************************************************************************/
+static RegEntry *ModelLookup(RegModel *Model, u64 Addr)
+{
+	u32 Idx = (u32)((Addr >> 2) * 2654435761U) & (TEST_REG_MAP_SIZE - 1);
+
+	for(u32 i = 0U; i < TEST_REG_MAP_SIZE; i++) {
+		RegEntry *Entry = &Model->Regs[(Idx + i) & (TEST_REG_MAP_SIZE - 1)];
+
+		if(!Entry->Valid) {
+			Entry->Valid = 1U;
+			Entry->Addr = Addr;
+			Entry->Value = 0U;
+			return Entry;
+		}
+		if(Entry->Addr == Addr)
+			return Entry;
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function applies a debug backend trace to a register model.
+*
+* @param	Model: Register model, cleared first.
+* @param	Trace: Captured trace.
+*
+* @return	0 on success, -1 on failure.
+*
+*******************************************************************************/
+static int ApplyTrace(RegModel *Model, const char *Trace)
+{
+	unsigned long Addr;
+	unsigned int Mask, Value;
+	RegEntry *Entry;
+
+	memset(Model, 0, sizeof(*Model));
+
+	while(*Trace != '\0') {
+		if(sscanf(Trace, "W: 0x%lx, 0x%x", &Addr, &Value) == 2) {
+			Entry = ModelLookup(Model, Addr);
+			if(Entry == NULL)
+				return -1;
+			Entry->Value = Value;
+			Model->NumWrites++;
+		} else if(sscanf(Trace, "MW: 0x%lx, 0x%x, 0x%x", &Addr,
+					&Mask, &Value) == 3) {
+			Entry = ModelLookup(Model, Addr);
+			if(Entry == NULL)
+				return -1;
+			Entry->Value = (Entry->Value & ~Mask) | (Value & Mask);
+			Model->NumWrites++;
+		} else if(strncmp(Trace, "R: ", 3) == 0 ||
+				strncmp(Trace, "MP: ", 4) == 0) {
+			Model->NumReads++;
+		}
+
+		Trace = strchr(Trace, '\n');
+		if(Trace == NULL)
+			break;
+		Trace++;
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function compares the register state of two models.
+*
+* @param	A: First register model.
+* @param	B: Second register model.
+*
+* @return	Number of registers which differ.
+*
+*******************************************************************************/
+static u32 CompareModels(RegModel *A, RegModel *B)
+{
+	u32 Diff = 0U;
+	RegEntry *Entry;
+
+	for(u32 i = 0U; i < TEST_REG_MAP_SIZE; i++) {
+		if(A->Regs[i].Valid) {
+			Entry = ModelLookup(B, A->Regs[i].Addr);
+			if(Entry == NULL || Entry->Value != A->Regs[i].Value)
+				Diff++;
+		}
+		if(B->Regs[i].Valid) {
+			Entry = ModelLookup(A, B->Regs[i].Addr);
+			if(Entry == NULL || Entry->Value != B->Regs[i].Value)
+				Diff++;
+		}
+	}
+
+	return Diff;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function removes the read and poll lines from a trace.
+*
+* @param	Trace: Trace to filter in place.
+*
+* @return	None.
+*
+*******************************************************************************/
+static void DropReads(char *Trace)
+{
+	char *Src = Trace, *Dst = Trace, *End;
+	size_t Len;
+
+	while(*Src != '\0') {
+		End = strchr(Src, '\n');
+		Len = (End != NULL) ? (size_t)(End - Src + 1) : strlen(Src);
+		if(strncmp(Src, "R: ", 3) != 0 && strncmp(Src, "MP: ", 4) != 0) {
+			memmove(Dst, Src, Len);
+			Dst += Len;
+		}
+		Src += Len;
+	}
+	*Dst = '\0';
+}
+
+int main(void)
+{
+	XAie_DevInst DevRef, DevTxn, DevReplay;
+	TestRun Run;
+	int Errors = 0;
+
+	if(InitDevice(&DevRef) != XAIE_OK || InitDevice(&DevTxn) != XAIE_OK ||
+			InitDevice(&DevReplay) != XAIE_OK) {
+		printf("Failed to initialize the device instances\n");
+		return 1;
+	}
+
+	/* Default transaction against direct calls, with reads and polls */
+	Run = (TestRun){.DevInst = &DevRef, .Repeat = 1U, .UseLocks = 1U};
+	if(RunCaptured(StepConfigure, &Run, TraceRef) != 0) {
+		printf("Failed to run the direct configuration\n");
+		return 1;
+	}
+	Run = (TestRun){.DevInst = &DevTxn, .Flags = XAIE_TRANSACTION_DEFAULT,
+		.Repeat = 1U, .UseTxn = 1U, .UseLocks = 1U};
+	if(RunCaptured(StepConfigure, &Run, TraceTxn) != 0) {
+		printf("Failed to run the transaction\n");
+		return 1;
+	}
+	if(strcmp(TraceRef, TraceTxn) != 0) {
+		printf("Transaction trace differs from the direct trace\n");
+		Errors++;
+	}
+
+	/* Record without auto flush, export, and replay twice elsewhere */
+	Run = (TestRun){.DevInst = &DevTxn, .Flags = XAIE_TRANSACTION_DEFAULT |
+		XAIE_TRANSACTION_DISABLE_AUTO_FLUSH, .Repeat = 1U,
+		.UseTxn = 1U, .Export = 1U, .UseLocks = 1U};
+	if(RunCaptured(StepConfigure, &Run, TraceRec) != 0) {
+		printf("Failed to record the transaction\n");
+		return 1;
+	}
+	ApplyTrace(&ModelTxn, TraceRec);
+	if(ModelTxn.NumWrites != 0U) {
+		printf("%u writes issued while recording\n", ModelTxn.NumWrites);
+		Errors++;
+	}
+
+	DropReads(TraceRef);
+	ApplyTrace(&ModelRef, TraceRef);
+	printf("Graph: %u register writes\n", ModelRef.NumWrites);
+	printf("Transaction: %u backend calls recorded, submitted as %u commands\n",
+			Run.TxnInst->NumRecordedOps, Run.TxnInst->NumCmds);
+
+	Run.DevInst = &DevReplay;
+	for(int Pass = 0; Pass < 2; Pass++) {
+		if(RunCaptured(StepSubmit, &Run, TraceTxn) != 0 ||
+				strcmp(TraceRef, TraceTxn) != 0) {
+			printf("Replay %d differs from the direct trace\n", Pass);
+			Errors++;
+		}
+	}
+	XAie_FreeTransactionInstance(Run.TxnInst);
+
+	/* Deduplication of a configuration which is applied twice */
+	Run = (TestRun){.DevInst = &DevRef, .Repeat = 2U};
+	if(RunCaptured(StepConfigure, &Run, TraceRef) != 0) {
+		printf("Failed to run the direct configuration\n");
+		return 1;
+	}
+	Run = (TestRun){.DevInst = &DevTxn, .Flags =
+		XAIE_TRANSACTION_ENABLE_COALESCE | XAIE_TRANSACTION_ENABLE_DEDUP,
+		.Repeat = 2U, .UseTxn = 1U, .Export = 1U};
+	if(RunCaptured(StepConfigure, &Run, TraceRec) != 0) {
+		printf("Failed to record the deduplicating transaction\n");
+		return 1;
+	}
+	printf("Deduplication: %u backend calls recorded, %u dropped, "
+			"submitted as %u commands\n",
+			Run.TxnInst->NumRecordedOps, Run.TxnInst->NumDroppedOps,
+			Run.TxnInst->NumCmds);
+	if(Run.TxnInst->NumDroppedOps == 0U) {
+		printf("No redundant write was dropped\n");
+		Errors++;
+	}
+
+	Run.DevInst = &DevReplay;
+	if(RunCaptured(StepSubmit, &Run, TraceTxn) != 0) {
+		printf("Failed to submit the deduplicating transaction\n");
+		Errors++;
+	}
+	XAie_FreeTransactionInstance(Run.TxnInst);
+
+	ApplyTrace(&ModelRef, TraceRef);
+	ApplyTrace(&ModelTxn, TraceTxn);
+	if(CompareModels(&ModelRef, &ModelTxn) != 0U) {
+		printf("Deduplicated transaction leaves a different state\n");
+		Errors++;
+	}
+	printf("Register writes, direct: %u, deduplicated: %u\n",
+			ModelRef.NumWrites, ModelTxn.NumWrites);
+
+	XAie_Finish(&DevRef);
+	XAie_Finish(&DevTxn);
+	XAie_Finish(&DevReplay);
+
+	if(Errors != 0) {
+		printf("Transaction test against the debug backend failed\n");
+		return 1;
+	}
+
+	printf("Successfully ran transaction test against the debug backend\n");
+	return 0;
+}
+
+/** @} */
@@ -32,6 +32,9 @@
 * 3.8  mus  11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
 * 3.10 hk   05/16/19 Clear status registers properly in reset
 * 3.11 sd   02/14/20 Add clock support
+* 3.12 hk   11/16/20 Set up the receive queue pointers, buffer sizes and
+*                    interrupts of the priority queues. Read the number of
+*                    queues and screeners in reset.
 *
 * </pre>
 ******************************************************************************/
@@ -80,6 +83,8 @@ void XEmacPs_StubHandler(void);	/* Default handler routine */
 LONG XEmacPs_CfgInitialize(XEmacPs *InstancePtr, XEmacPs_Config * CfgPtr,
 			   UINTPTR EffectiveAddress)
 {
+	u32 Queue;
+
 	/* Verify arguments */
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(CfgPtr != NULL);
@@ -96,6 +101,12 @@ LONG XEmacPs_CfgInitialize(XEmacPs *InstancePtr, XEmacPs_Config * CfgPtr,
 	InstancePtr->SendHandler = ((XEmacPs_Handler)((void*)XEmacPs_StubHandler));
 	InstancePtr->RecvHandler = ((XEmacPs_Handler)(void*)XEmacPs_StubHandler);
 	InstancePtr->ErrorHandler = ((XEmacPs_ErrHandler)(void*)XEmacPs_StubHandler);
+	for (Queue = 0U; Queue < (XEMACPS_MAX_QUEUES - 1U); Queue++) {
+		InstancePtr->RecvQHandler[Queue] =
+			((XEmacPs_Handler)(void*)XEmacPs_StubHandler);
+	}
+	InstancePtr->NumQueues = 1U;
+	InstancePtr->RxQueueMask = 0U;
 
 	/* Reset the hardware and set default options */
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
@@ -135,6 +146,7 @@ LONG XEmacPs_CfgInitialize(XEmacPs *InstancePtr, XEmacPs_Config * CfgPtr,
 void XEmacPs_Start(XEmacPs *InstancePtr)
 {
 	u32 Reg;
+	u32 Queue;
 
 	/* Assert bad arguments and conditions */
 	Xil_AssertVoid(InstancePtr != NULL);
@@ -197,6 +209,19 @@ void XEmacPs_Start(XEmacPs *InstancePtr)
 	if (InstancePtr->Version > 2)
 		XEmacPs_IntQ1Enable(InstancePtr, XEMACPS_INTQ1_IXR_ALL_MASK);
 
+	/* Priority receive queues use the buffer size of queue 0 */
+	Reg = (XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_DMACR_OFFSET) & XEMACPS_DMACR_RXBUF_MASK) >>
+			XEMACPS_DMACR_RXBUF_SHIFT;
+	for (Queue = 1U; Queue < InstancePtr->NumQueues; Queue++) {
+		if ((InstancePtr->RxQueueMask & ((u32)1U << Queue)) != 0U) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_RXQBUFSIZE_OFFSET(Queue), Reg);
+			XEmacPs_IntQEnable(InstancePtr, Queue,
+				XEMACPS_INTQ_RX_IXR_ALL_MASK);
+		}
+	}
+
 	/* Mark as started */
 	InstancePtr->IsStarted = XIL_COMPONENT_IS_STARTED;
 
@@ -232,6 +257,7 @@ void XEmacPs_Start(XEmacPs *InstancePtr)
 void XEmacPs_Stop(XEmacPs *InstancePtr)
 {
 	u32 Reg;
+	u32 Queue;
 
 	Xil_AssertVoid(InstancePtr != NULL);
 	Xil_AssertVoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
@@ -239,6 +265,10 @@ void XEmacPs_Stop(XEmacPs *InstancePtr)
 	/* Disable all interrupts */
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress, XEMACPS_IDR_OFFSET,
 			   XEMACPS_IXR_ALL_MASK);
+	for (Queue = 1U; Queue < InstancePtr->NumQueues; Queue++) {
+		XEmacPs_IntQDisable(InstancePtr, Queue,
+				XEMACPS_INTQ_IXR_ALL_MASK);
+	}
 
 	/* Disable the receiver & transmitter */
 	Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
@@ -269,6 +299,7 @@ void XEmacPs_Stop(XEmacPs *InstancePtr)
 * - Clear all interrupt sources
 * - Clear phy (if there is any previously detected) address
 * - Clear MAC addresses (1-4) as well as Type IDs and hash value
+* - Clear the priority queue pointers and disable all screeners
 *
 * All options are placed in their default state. Any frames in the
 * descriptor lists will remain in the lists. The side effect of doing
@@ -292,6 +323,7 @@ void XEmacPs_Reset(XEmacPs *InstancePtr)
 {
 	u32 Reg;
 	u8 i;
+	u8 Queue;
 	s8 EmacPs_zero_MAC[6] = { 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 };
 
 	Xil_AssertVoid(InstancePtr != NULL);
@@ -305,6 +337,44 @@ void XEmacPs_Reset(XEmacPs *InstancePtr)
 
 	InstancePtr->Version = (InstancePtr->Version >> 16) & 0xFFF;
 
+	/* Priority queues and screeners of the design */
+	InstancePtr->NumQueues = 1U;
+	InstancePtr->NumScreenT1 = 0U;
+	InstancePtr->NumScreenT2 = 0U;
+	InstancePtr->NumScreenEType = 0U;
+	InstancePtr->NumScreenCmp = 0U;
+	if (InstancePtr->Version > 2) {
+		Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_DCFG6_OFFSET);
+		while ((InstancePtr->NumQueues < XEMACPS_MAX_QUEUES) &&
+			((Reg & XEMACPS_DCFG6_QUEUE_MASK &
+			((u32)1U << InstancePtr->NumQueues)) != 0U)) {
+			InstancePtr->NumQueues++;
+		}
+
+		Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_DCFG8_OFFSET);
+		InstancePtr->NumScreenT1 = (u8)((Reg &
+			XEMACPS_DCFG8_T1SCR_MASK) >> XEMACPS_DCFG8_T1SCR_SHIFT);
+		InstancePtr->NumScreenT2 = (u8)((Reg &
+			XEMACPS_DCFG8_T2SCR_MASK) >> XEMACPS_DCFG8_T2SCR_SHIFT);
+		InstancePtr->NumScreenEType = (u8)((Reg &
+			XEMACPS_DCFG8_ETYPE_MASK) >> XEMACPS_DCFG8_ETYPE_SHIFT);
+		InstancePtr->NumScreenCmp = (u8)(Reg & XEMACPS_DCFG8_CMP_MASK);
+		if (InstancePtr->NumScreenT1 > XEMACPS_MAX_SCREEN_T1) {
+			InstancePtr->NumScreenT1 = XEMACPS_MAX_SCREEN_T1;
+		}
+		if (InstancePtr->NumScreenT2 > XEMACPS_MAX_SCREEN_T2) {
+			InstancePtr->NumScreenT2 = XEMACPS_MAX_SCREEN_T2;
+		}
+		if (InstancePtr->NumScreenEType > XEMACPS_MAX_SCREEN_ETYPE) {
+			InstancePtr->NumScreenEType = XEMACPS_MAX_SCREEN_ETYPE;
+		}
+		if (InstancePtr->NumScreenCmp > XEMACPS_MAX_SCREEN_CMP) {
+			InstancePtr->NumScreenCmp = XEMACPS_MAX_SCREEN_CMP;
+		}
+	}
+
 	InstancePtr->MaxMtuSize = XEMACPS_MTU;
 	InstancePtr->MaxFrameSize = XEMACPS_MTU + XEMACPS_HDR_SIZE +
 					XEMACPS_TRL_SIZE;
@@ -362,6 +432,24 @@ void XEmacPs_Reset(XEmacPs *InstancePtr)
 	if (InstancePtr->Version > 2)
 		XEmacPs_SetQueuePtr(InstancePtr, 0, 0x01U, (u16)XEMACPS_SEND);
 	XEmacPs_SetQueuePtr(InstancePtr, 0, 0x00U, (u16)XEMACPS_RECV);
+	for (Queue = 1U; Queue < InstancePtr->NumQueues; Queue++) {
+		XEmacPs_SetQueuePtr(InstancePtr, 0, Queue, (u16)XEMACPS_RECV);
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_INTQ_IDR_OFFSET(Queue),
+				XEMACPS_INTQ_IXR_ALL_MASK);
+	}
+
+	/* Disable all screeners, frames are received on queue 0 */
+	for (i = 0U; i < InstancePtr->NumScreenT1; i++) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREENT1_REG_OFFSET(i), 0x00000000U);
+	}
+	for (i = 0U; i < InstancePtr->NumScreenT2; i++) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREENT2_REG_OFFSET(i), 0x00000000U);
+	}
+	InstancePtr->ScreenETypeUsed = 0U;
+	InstancePtr->ScreenCmpUsed = 0U;
 
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
 			   XEMACPS_RXSR_OFFSET, XEMACPS_SR_ALL_MASK);
@@ -434,6 +522,10 @@ void XEmacPs_StubHandler(void)
 * The buffer queue addresses has to be set before starting the transfer, so
 * this function has to be called in prior to XEmacPs_Start()
 *
+* A receive priority queue with a non zero address is set up and has its
+* interrupts enabled by XEmacPs_Start(). The upper 32 bits of the addresses
+* are shared by all the queues of a direction.
+*
 ******************************************************************************/
 void XEmacPs_SetQueuePtr(XEmacPs *InstancePtr, UINTPTR QPtr, u8 QueueNum,
 			 u16 Direction)
@@ -459,9 +551,21 @@ void XEmacPs_SetQueuePtr(XEmacPs *InstancePtr, UINTPTR QPtr, u8 QueueNum,
 		}
 	}
 	 else {
-		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
-			XEMACPS_TXQ1BASE_OFFSET,
-			(QPtr & ULONG64_LO_MASK));
+		Xil_AssertVoid(QueueNum < XEMACPS_MAX_QUEUES);
+		if (Direction == XEMACPS_SEND) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_TXQBASE_Q_OFFSET(QueueNum),
+				(QPtr & ULONG64_LO_MASK));
+		} else {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_RXQBASE_Q_OFFSET(QueueNum),
+				(QPtr & ULONG64_LO_MASK));
+			if (QPtr != 0U) {
+				InstancePtr->RxQueueMask |= ((u32)1U << QueueNum);
+			} else {
+				InstancePtr->RxQueueMask &= ~((u32)1U << QueueNum);
+			}
+		}
 	}
 #ifdef __aarch64__
 	if (Direction == XEMACPS_SEND) {
@@ -29,6 +29,7 @@
  *   - Pause frame support
  *   - Large frame support up to 1536 bytes
  *   - Checksum offload
+ *   - Priority receive queues with type 1 and type 2 screeners
  *
  * <b>Driver Description</b>
  *
@@ -212,6 +213,28 @@
  * If any of the checksums are verified incorrect by the hardware, the packet
  * is discarded and the appropriate statistics counter incremented.
  *
+ * <b>Priority Queues and Screeners</b>
+ *
+ * The GEM of Zynq Ultrascale+ MPSoC and Versal has priority queues besides
+ * queue 0. Each receive queue has its own BD ring, buffer descriptor base
+ * address and interrupt status, so frames steered to a priority queue are
+ * not held up behind the bulk traffic of queue 0.
+ *
+ * The ring of priority queue n is XEmacPs_GetRxQRing(InstancePtr, n). It is
+ * set up like the ring of queue 0 and its address is given to the hardware
+ * with XEmacPs_SetQueuePtr(). XEmacPs_SetQueueHandler() installs the callback
+ * of the queue, which is invoked when frames were received on the queue or
+ * when the queue ran out of buffers. XEmacPs_Start() enables the interrupts
+ * and sets the buffer size of every priority queue with a ring.
+ *
+ * Frames are steered with screeners. A type 1 screener matches the IP DS/TC
+ * field and/or the UDP destination port. A type 2 screener matches the VLAN
+ * priority, the EtherType and/or up to three 16 bit compares at an offset in
+ * the frame. The EtherType and compare registers used by type 2 screeners
+ * are allocated by the driver. Frames which match no screener are received
+ * on queue 0. The number of queues and screeners is read from the design
+ * configuration of the device.
+ *
  * <b>PHY Interfaces</b>
  *
  * RGMII 1.3 is the only interface supported.
@@ -308,6 +331,8 @@
  *	 hk   09/17/18 Fix PTP interrupt masks and cleanup comments.
  * 3.9   hk   01/23/19 Add RX watermark support
  * 3.11  sd   02/14/20 Add clock support
+ * 3.12  hk   11/16/20 Add priority receive queues with per queue BD rings and
+ *                     handlers, and type 1 and type 2 screener APIs.
  *
  * </pre>
  *
@@ -468,6 +493,25 @@ extern "C" {
 #define XEMACPS_8BYTE_BURST		0x00000008
 #define XEMACPS_16BYTE_BURST	0x00000010
 
+/* Queues and screeners */
+#define XEMACPS_MAX_QUEUES	2U	/**< Queue 0 and priority queue 1 */
+#define XEMACPS_MAX_SCREEN_T1	16U	/**< Type 1 screener registers */
+#define XEMACPS_MAX_SCREEN_T2	16U	/**< Type 2 screener registers */
+#define XEMACPS_MAX_SCREEN_ETYPE 8U	/**< Type 2 EtherType registers */
+#define XEMACPS_MAX_SCREEN_CMP	32U	/**< Type 2 Compare registers */
+#define XEMACPS_SCREEN_T2_CMPS	3U	/**< Compares of a type 2 screener */
+
+/** @name Type 2 screener compare offset types
+ *
+ * The offset of a compare counts from one of these points of the frame.
+ * @{
+ */
+#define XEMACPS_SCREEN_OFST_FRAME	0U /**< Start of the frame */
+#define XEMACPS_SCREEN_OFST_ETYPE	1U /**< End of the EtherType field */
+#define XEMACPS_SCREEN_OFST_IPHDR	2U /**< End of the IP header */
+#define XEMACPS_SCREEN_OFST_TCPUDP	3U /**< End of the TCP/UDP header */
+/*@}*/
+
 
 /**************************** Type Definitions ******************************/
 /** @name Typedefs for callback functions
@@ -503,6 +547,44 @@ typedef void (*XEmacPs_ErrHandler) (void *CallBackRef, u8 Direction,
 
 /*@}*/
 
+/**
+ * Type 1 screener rule. Frames which match all enabled fields are received on
+ * queue QueueNum.
+ */
+typedef struct {
+	u8 QueueNum;		/**< Receive queue of the matching frames */
+	u8 DsTcEnable;		/**< Match the IPv4 DS or IPv6 TC field */
+	u8 DsTc;		/**< DS/TC field value */
+	u8 UdpPortEnable;	/**< Match the UDP destination port */
+	u16 UdpPort;		/**< UDP destination port */
+} XEmacPs_Type1Screener;
+
+/**
+ * Compare of a type 2 screener rule. The 16 bits at Offset bytes from the
+ * point given by OffsetType, first frame byte in the upper bits, match when
+ * they are equal to Value in the bits set in Mask.
+ */
+typedef struct {
+	u16 Value;		/**< Value to compare */
+	u16 Mask;		/**< Bits of Value compared */
+	u8 Offset;		/**< Offset in bytes, 0 to 127 */
+	u8 OffsetType;		/**< XEMACPS_SCREEN_OFST_* */
+} XEmacPs_ScreenerCompare;
+
+/**
+ * Type 2 screener rule. Frames which match all enabled fields and all NumCmp
+ * compares are received on queue QueueNum.
+ */
+typedef struct {
+	u8 QueueNum;		/**< Receive queue of the matching frames */
+	u8 VlanPriorityEnable;	/**< Match the VLAN priority */
+	u8 VlanPriority;	/**< VLAN priority, 0 to 7 */
+	u8 EtherTypeEnable;	/**< Match the EtherType */
+	u16 EtherType;		/**< EtherType */
+	u8 NumCmp;		/**< Compares used in Cmp, 0 to 3 */
+	XEmacPs_ScreenerCompare Cmp[XEMACPS_SCREEN_T2_CMPS]; /**< Compares */
+} XEmacPs_Type2Screener;
+
 /**
  * This typedef contains configuration information for a device.
  */
@@ -544,6 +626,22 @@ typedef struct XEmacPs_Instance {
 	u32 MaxFrameSize;
 	u32 MaxVlanFrameSize;
 
+	/* Priority queues, index 0 is queue 1 */
+	XEmacPs_BdRing RxQBdRing[XEMACPS_MAX_QUEUES - 1U]; /* Receive BD
+							       rings */
+	XEmacPs_Handler RecvQHandler[XEMACPS_MAX_QUEUES - 1U];
+	void *RecvQRef[XEMACPS_MAX_QUEUES - 1U];
+	u32 NumQueues;		/* Queues of the device, including queue 0 */
+	u32 RxQueueMask;	/* Priority queues with a receive BD list */
+
+	/* Screeners */
+	u8 NumScreenT1;		/* Type 1 screeners of the device */
+	u8 NumScreenT2;		/* Type 2 screeners of the device */
+	u8 NumScreenEType;	/* Type 2 EtherType registers */
+	u8 NumScreenCmp;	/* Type 2 Compare registers */
+	u32 ScreenETypeUsed;	/* EtherType registers in use */
+	u32 ScreenCmpUsed;	/* Compare registers in use */
+
 } XEmacPs;
 
 
@@ -581,6 +679,24 @@ typedef struct XEmacPs_Instance {
 *****************************************************************************/
 #define XEmacPs_GetRxRing(InstancePtr) ((InstancePtr)->RxBdRing)
 
+/****************************************************************************/
+/**
+* Retrieve the Rx ring object of a priority queue. This object can be used in
+* the various Ring API functions.
+*
+* @param  InstancePtr is the DMA channel to operate on.
+* @param  Queue is the priority queue, 1 to XEMACPS_MAX_QUEUES - 1.
+*
+* @return RxQBdRing attribute of the queue
+*
+* @note
+* C-style signature:
+*    XEmacPs_BdRing XEmacPs_GetRxQRing(XEmacPs *InstancePtr, u8 Queue)
+*
+*****************************************************************************/
+#define XEmacPs_GetRxQRing(InstancePtr, Queue) \
+	((InstancePtr)->RxQBdRing[(Queue) - 1U])
+
 /****************************************************************************/
 /**
 *
@@ -665,6 +781,48 @@ typedef struct XEmacPs_Instance {
 		XEMACPS_INTQ1_IDR_OFFSET,                               \
 		((Mask) & XEMACPS_INTQ1_IXR_ALL_MASK));
 
+/****************************************************************************/
+/**
+*
+* Enable the interrupts of priority queue <i>Queue</i> specified in
+* <i>Mask</i>.
+*
+* @param InstancePtr is a pointer to the instance to be worked on.
+* @param Queue is the priority queue, 1 or above.
+* @param Mask contains a bit mask of interrupts to enable, formed from the
+*        XEMACPS_INTQSR_* values.
+*
+* @note
+* C-style signature
+*     void XEmacPs_IntQEnable(XEmacPs *InstancePtr, u8 Queue, u32 Mask)
+*
+*****************************************************************************/
+#define XEmacPs_IntQEnable(InstancePtr, Queue, Mask)                     \
+	XEmacPs_WriteReg((InstancePtr)->Config.BaseAddress,             \
+		XEMACPS_INTQ_IER_OFFSET(Queue),                         \
+		((Mask) & XEMACPS_INTQ_IXR_ALL_MASK));
+
+/****************************************************************************/
+/**
+*
+* Disable the interrupts of priority queue <i>Queue</i> specified in
+* <i>Mask</i>.
+*
+* @param InstancePtr is a pointer to the instance to be worked on.
+* @param Queue is the priority queue, 1 or above.
+* @param Mask contains a bit mask of interrupts to disable, formed from the
+*        XEMACPS_INTQSR_* values.
+*
+* @note
+* C-style signature
+*     void XEmacPs_IntQDisable(XEmacPs *InstancePtr, u8 Queue, u32 Mask)
+*
+*****************************************************************************/
+#define XEmacPs_IntQDisable(InstancePtr, Queue, Mask)                    \
+	XEmacPs_WriteReg((InstancePtr)->Config.BaseAddress,             \
+		XEMACPS_INTQ_IDR_OFFSET(Queue),                         \
+		((Mask) & XEMACPS_INTQ_IXR_ALL_MASK));
+
 /****************************************************************************/
 /**
 *
@@ -798,6 +956,8 @@ XEmacPs_Config *XEmacPs_LookupConfig(u16 DeviceId);
  */
 LONG XEmacPs_SetHandler(XEmacPs *InstancePtr, u32 HandlerType,
 			void *FuncPointer, void *CallBackRef);
+LONG XEmacPs_SetQueueHandler(XEmacPs *InstancePtr, u8 QueueNum,
+			u32 HandlerType, void *FuncPointer, void *CallBackRef);
 void XEmacPs_IntrHandler(void *XEmacPsPtr);
 
 /*
@@ -828,6 +988,13 @@ LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index);
 LONG XEmacPs_SendPausePacket(XEmacPs *InstancePtr);
 void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength);
 
+LONG XEmacPs_SetType1Screener(XEmacPs *InstancePtr, u8 Index,
+			      XEmacPs_Type1Screener *RulePtr);
+LONG XEmacPs_ClearType1Screener(XEmacPs *InstancePtr, u8 Index);
+LONG XEmacPs_SetType2Screener(XEmacPs *InstancePtr, u8 Index,
+			      XEmacPs_Type2Screener *RulePtr);
+LONG XEmacPs_ClearType2Screener(XEmacPs *InstancePtr, u8 Index);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@
  * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
  * 3.0   hk   02/20/15 Added support for jumbo frames.
  * 3.2   hk   02/22/16 Added SGMII support for Zynq Ultrascale+ MPSoC.
+ * 3.12  hk   11/16/20 Added type 1 and type 2 screener APIs.
  * </pre>
  *****************************************************************************/
 
@@ -44,6 +45,7 @@
 
 /************************** Function Prototypes ******************************/
 
+static void XEmacPs_ReleaseType2Screener(XEmacPs *InstancePtr, u8 Index);
 
 /************************** Variable Definitions *****************************/
 
@@ -1130,4 +1132,264 @@ void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength)
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress, XEMACPS_DMACR_OFFSET,
 																	Reg);
 }
+
+/*****************************************************************************/
+/**
+ * Set a type 1 screener. Frames which match the rule are received on the
+ * queue of the rule. The rule replaces the one set before at the same index.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener, 0 to the number of type 1 screeners - 1.
+ * @param RulePtr is a pointer to the rule.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was set
+ * - XST_INVALID_PARAM if the device does not have the screener or the queue
+ *
+ * @note
+ * A rule with no field enabled matches all IP frames.
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetType1Screener(XEmacPs *InstancePtr, u8 Index,
+			      XEmacPs_Type1Screener *RulePtr)
+{
+	u32 Reg;
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(RulePtr != NULL);
+
+	if ((Index >= InstancePtr->NumScreenT1) ||
+		(RulePtr->QueueNum >= InstancePtr->NumQueues)) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		Reg = (u32)RulePtr->QueueNum & XEMACPS_SCREENT1_QUEUE_MASK;
+		if (RulePtr->DsTcEnable != 0U) {
+			Reg |= XEMACPS_SCREENT1_DSTCEN_MASK |
+				(((u32)RulePtr->DsTc << XEMACPS_SCREENT1_DSTC_SHIFT) &
+				XEMACPS_SCREENT1_DSTC_MASK);
+		}
+		if (RulePtr->UdpPortEnable != 0U) {
+			Reg |= XEMACPS_SCREENT1_UDPEN_MASK |
+				(((u32)RulePtr->UdpPort <<
+				XEMACPS_SCREENT1_UDPPORT_SHIFT) &
+				XEMACPS_SCREENT1_UDPPORT_MASK);
+		}
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREENT1_REG_OFFSET(Index), Reg);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Disable a type 1 screener.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener, 0 to the number of type 1 screeners - 1.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was disabled
+ * - XST_INVALID_PARAM if the device does not have the screener
+ *
+ *****************************************************************************/
+LONG XEmacPs_ClearType1Screener(XEmacPs *InstancePtr, u8 Index)
+{
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (Index >= InstancePtr->NumScreenT1) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREENT1_REG_OFFSET(Index), 0x00000000U);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Disable a type 2 screener and release the EtherType and compare registers
+ * it uses.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener.
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XEmacPs_ReleaseType2Screener(XEmacPs *InstancePtr, u8 Index)
+{
+	u32 Reg;
+	u32 Field;
+	u32 Cmp;
+
+	Reg = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_SCREENT2_REG_OFFSET(Index));
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_SCREENT2_REG_OFFSET(Index), 0x00000000U);
+
+	if ((Reg & XEMACPS_SCREENT2_ETYPEEN_MASK) != 0U) {
+		InstancePtr->ScreenETypeUsed &= ~((u32)1U <<
+			((Reg & XEMACPS_SCREENT2_ETYPEIDX_MASK) >>
+			XEMACPS_SCREENT2_ETYPEIDX_SHIFT));
+	}
+	for (Cmp = 0U; Cmp < XEMACPS_SCREEN_T2_CMPS; Cmp++) {
+		Field = Reg >> (XEMACPS_SCREENT2_CMP_SHIFT +
+				(Cmp * XEMACPS_SCREENT2_CMP_WIDTH));
+		if ((Field & XEMACPS_SCREENT2_CMPEN_MASK) != 0U) {
+			InstancePtr->ScreenCmpUsed &= ~((u32)1U <<
+				(Field & XEMACPS_SCREENT2_CMPIDX_MASK));
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+ * Set a type 2 screener. Frames which match the rule are received on the
+ * queue of the rule. The rule replaces the one set before at the same index.
+ *
+ * The EtherType and the compares of the rule are programmed in free type 2
+ * EtherType and Compare registers, which stay allocated to the screener
+ * until it is set again or cleared.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener, 0 to the number of type 2 screeners - 1.
+ * @param RulePtr is a pointer to the rule.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was set
+ * - XST_INVALID_PARAM if the device does not have the screener or the queue
+ * - XST_FAILURE if there are not enough free EtherType or Compare registers.
+ *   The screener is left disabled.
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetType2Screener(XEmacPs *InstancePtr, u8 Index,
+			      XEmacPs_Type2Screener *RulePtr)
+{
+	u32 Reg;
+	u32 Cmp;
+	u32 RegIdx = 0U;
+	u32 ETypeUsed;
+	u32 CmpUsed;
+	const XEmacPs_ScreenerCompare *CmpPtr;
+	LONG Status = (LONG)(XST_SUCCESS);
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(RulePtr != NULL);
+	Xil_AssertNonvoid(RulePtr->NumCmp <= XEMACPS_SCREEN_T2_CMPS);
+	Xil_AssertNonvoid(RulePtr->VlanPriority <= 7U);
+
+	if ((Index >= InstancePtr->NumScreenT2) ||
+		(RulePtr->QueueNum >= InstancePtr->NumQueues)) {
+		return (LONG)(XST_INVALID_PARAM);
+	}
+
+	XEmacPs_ReleaseType2Screener(InstancePtr, Index);
+	ETypeUsed = InstancePtr->ScreenETypeUsed;
+	CmpUsed = InstancePtr->ScreenCmpUsed;
+
+	Reg = (u32)RulePtr->QueueNum & XEMACPS_SCREENT2_QUEUE_MASK;
+	if (RulePtr->VlanPriorityEnable != 0U) {
+		Reg |= XEMACPS_SCREENT2_VLANEN_MASK |
+			((u32)RulePtr->VlanPriority <<
+			XEMACPS_SCREENT2_VLANPRI_SHIFT);
+	}
+
+	if (RulePtr->EtherTypeEnable != 0U) {
+		while ((RegIdx < InstancePtr->NumScreenEType) &&
+			((ETypeUsed & ((u32)1U << RegIdx)) != 0U)) {
+			RegIdx++;
+		}
+		if (RegIdx == InstancePtr->NumScreenEType) {
+			Status = (LONG)(XST_FAILURE);
+		} else {
+			ETypeUsed |= (u32)1U << RegIdx;
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREENT2_ETYPE_REG_OFFSET(RegIdx),
+				(u32)RulePtr->EtherType &
+				XEMACPS_SCREENT2_ETYPE_MASK);
+			Reg |= XEMACPS_SCREENT2_ETYPEEN_MASK |
+				(RegIdx << XEMACPS_SCREENT2_ETYPEIDX_SHIFT);
+		}
+	}
+
+	RegIdx = 0U;
+	for (Cmp = 0U; (Cmp < RulePtr->NumCmp) &&
+			(Status == (LONG)(XST_SUCCESS)); Cmp++) {
+		CmpPtr = &RulePtr->Cmp[Cmp];
+		Xil_AssertNonvoid(CmpPtr->Offset <=
+				XEMACPS_SCREENT2_CMPW1_OFST_MASK);
+		Xil_AssertNonvoid(CmpPtr->OffsetType <=
+				XEMACPS_SCREEN_OFST_TCPUDP);
+
+		while ((RegIdx < InstancePtr->NumScreenCmp) &&
+			((CmpUsed & ((u32)1U << RegIdx)) != 0U)) {
+			RegIdx++;
+		}
+		if (RegIdx == InstancePtr->NumScreenCmp) {
+			Status = (LONG)(XST_FAILURE);
+		} else {
+			CmpUsed |= (u32)1U << RegIdx;
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREENT2_CMPW0_REG_OFFSET(RegIdx),
+				((u32)CmpPtr->Value <<
+				XEMACPS_SCREENT2_CMPW0_VAL_SHIFT) |
+				((u32)CmpPtr->Mask &
+				XEMACPS_SCREENT2_CMPW0_MASK_MASK));
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREENT2_CMPW1_REG_OFFSET(RegIdx),
+				((u32)CmpPtr->OffsetType <<
+				XEMACPS_SCREENT2_CMPW1_TYPE_SHIFT) |
+				(u32)CmpPtr->Offset);
+			Reg |= (RegIdx | XEMACPS_SCREENT2_CMPEN_MASK) <<
+				(XEMACPS_SCREENT2_CMP_SHIFT +
+				(Cmp * XEMACPS_SCREENT2_CMP_WIDTH));
+		}
+	}
+
+	/* Enable the screener once its registers are programmed */
+	if (Status == (LONG)(XST_SUCCESS)) {
+		InstancePtr->ScreenETypeUsed = ETypeUsed;
+		InstancePtr->ScreenCmpUsed = CmpUsed;
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_SCREENT2_REG_OFFSET(Index), Reg);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Disable a type 2 screener and release the EtherType and Compare registers
+ * it uses.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener, 0 to the number of type 2 screeners - 1.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was disabled
+ * - XST_INVALID_PARAM if the device does not have the screener
+ *
+ *****************************************************************************/
+LONG XEmacPs_ClearType2Screener(XEmacPs *InstancePtr, u8 Index)
+{
+	LONG Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (Index >= InstancePtr->NumScreenT2) {
+		Status = (LONG)(XST_INVALID_PARAM);
+	} else {
+		XEmacPs_ReleaseType2Screener(InstancePtr, Index);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
 /** @} */
@@ -38,6 +38,7 @@
 * 3.8  hk   09/17/18 Fix PTP interrupt masks.
 * 3.9  hk   01/23/19 Add RX watermark support
 * 3.10 hk   05/16/19 Clear status registers properly in reset
+* 3.12 hk   11/16/20 Add priority queue and type 1/type 2 screener registers.
 * </pre>
 *
 ******************************************************************************/
@@ -275,12 +276,19 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_PTPP_RXNANOSEC_OFFSET 0x000001FCU /**< 1588 PTP peer receive
 						      nanosecond counter */
 
+#define XEMACPS_DCFG6_OFFSET         0x00000294U /**< Design Configuration 6
+							reg */
+#define XEMACPS_DCFG8_OFFSET         0x0000029CU /**< Design Configuration 8
+							reg */
+
 #define XEMACPS_INTQ1_STS_OFFSET     0x00000400U /**< Interrupt Q1 Status
 							reg */
 #define XEMACPS_TXQ1BASE_OFFSET	     0x00000440U /**< TX Q1 Base address
 							reg */
 #define XEMACPS_RXQ1BASE_OFFSET	     0x00000480U /**< RX Q1 Base address
 							reg */
+#define XEMACPS_RXQ1BUFSIZE_OFFSET   0x000004A0U /**< RX Q1 Buffer Size
+							reg */
 #define XEMACPS_MSBBUF_TXQBASE_OFFSET  0x000004C8U /**< MSB Buffer TX Q Base
 							reg */
 #define XEMACPS_MSBBUF_RXQBASE_OFFSET  0x000004D4U /**< MSB Buffer RX Q Base
@@ -292,6 +300,46 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_INTQ1_IMR_OFFSET     0x00000640U /**< Interrupt Q1 Mask
 							reg */
 
+#define XEMACPS_SCREENT1_OFFSET      0x00000500U /**< Type 1 Screener reg 0 */
+#define XEMACPS_SCREENT2_OFFSET      0x00000540U /**< Type 2 Screener reg 0 */
+#define XEMACPS_SCREENT2_ETYPE_OFFSET 0x000006E0U /**< Type 2 Screener
+							EtherType reg 0 */
+#define XEMACPS_SCREENT2_CMPW0_OFFSET 0x00000700U /**< Type 2 Screener
+							Compare 0 word 0 reg */
+#define XEMACPS_SCREENT2_CMPW1_OFFSET 0x00000704U /**< Type 2 Screener
+							Compare 0 word 1 reg */
+
+/* Offsets of the registers of priority queue Queue, 1 and above */
+#define XEMACPS_INTQ_STS_OFFSET(Queue)	(XEMACPS_INTQ1_STS_OFFSET + \
+					 (((u32)(Queue) - 1U) * 4U))
+#define XEMACPS_TXQBASE_Q_OFFSET(Queue)	(XEMACPS_TXQ1BASE_OFFSET + \
+					 (((u32)(Queue) - 1U) * 4U))
+#define XEMACPS_RXQBASE_Q_OFFSET(Queue)	(XEMACPS_RXQ1BASE_OFFSET + \
+					 (((u32)(Queue) - 1U) * 4U))
+#define XEMACPS_RXQBUFSIZE_OFFSET(Queue) (XEMACPS_RXQ1BUFSIZE_OFFSET + \
+					 (((u32)(Queue) - 1U) * 4U))
+#define XEMACPS_INTQ_IER_OFFSET(Queue)	(XEMACPS_INTQ1_IER_OFFSET + \
+					 (((u32)(Queue) - 1U) * 4U))
+#define XEMACPS_INTQ_IDR_OFFSET(Queue)	(XEMACPS_INTQ1_IDR_OFFSET + \
+					 (((u32)(Queue) - 1U) * 4U))
+#define XEMACPS_INTQ_IMR_OFFSET(Queue)	(XEMACPS_INTQ1_IMR_OFFSET + \
+					 (((u32)(Queue) - 1U) * 4U))
+
+/* Offsets of the screener registers with index Index */
+#define XEMACPS_SCREENT1_REG_OFFSET(Index) (XEMACPS_SCREENT1_OFFSET + \
+					 ((u32)(Index) * 4U))
+#define XEMACPS_SCREENT2_REG_OFFSET(Index) (XEMACPS_SCREENT2_OFFSET + \
+					 ((u32)(Index) * 4U))
+#define XEMACPS_SCREENT2_ETYPE_REG_OFFSET(Index) \
+					(XEMACPS_SCREENT2_ETYPE_OFFSET + \
+					 ((u32)(Index) * 4U))
+#define XEMACPS_SCREENT2_CMPW0_REG_OFFSET(Index) \
+					(XEMACPS_SCREENT2_CMPW0_OFFSET + \
+					 ((u32)(Index) * 8U))
+#define XEMACPS_SCREENT2_CMPW1_REG_OFFSET(Index) \
+					(XEMACPS_SCREENT2_CMPW1_OFFSET + \
+					 ((u32)(Index) * 8U))
+
 /* Define some bit positions for registers. */
 
 /** @name network control register bit definitions
@@ -451,6 +499,86 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 
 /*@}*/
 
+/**
+ * @name Priority queue interrupt status register bit definitions
+ * Bits definitions are same in the status, enable, disable and mask
+ * registers of all priority queues.
+ * @{
+ */
+#define XEMACPS_INTQSR_TXCOMPL_MASK	XEMACPS_INTQ1SR_TXCOMPL_MASK
+#define XEMACPS_INTQSR_TXERR_MASK	XEMACPS_INTQ1SR_TXERR_MASK
+#define XEMACPS_INTQSR_RXUSED_MASK	0x00000004U /**< Rx buffer used bit
+							read */
+#define XEMACPS_INTQSR_RXCOMPL_MASK	0x00000002U /**< Frame received OK */
+
+#define XEMACPS_INTQ_RX_IXR_ALL_MASK	((u32)XEMACPS_INTQSR_RXCOMPL_MASK | \
+					 (u32)XEMACPS_INTQSR_RXUSED_MASK)
+
+#define XEMACPS_INTQ_IXR_ALL_MASK	((u32)XEMACPS_INTQ1_IXR_ALL_MASK | \
+					 (u32)XEMACPS_INTQ_RX_IXR_ALL_MASK)
+
+/*@}*/
+
+/** @name Design configuration register bit definitions
+ * @{
+ */
+#define XEMACPS_DCFG6_QUEUE_MASK	0x000000FEU /**< Priority queues
+							present, bit n for
+							queue n */
+#define XEMACPS_DCFG8_T1SCR_MASK	0xFF000000U /**< Type 1 screeners */
+#define XEMACPS_DCFG8_T1SCR_SHIFT	24U
+#define XEMACPS_DCFG8_T2SCR_MASK	0x00FF0000U /**< Type 2 screeners */
+#define XEMACPS_DCFG8_T2SCR_SHIFT	16U
+#define XEMACPS_DCFG8_ETYPE_MASK	0x0000FF00U /**< Type 2 EtherType
+							registers */
+#define XEMACPS_DCFG8_ETYPE_SHIFT	8U
+#define XEMACPS_DCFG8_CMP_MASK		0x000000FFU /**< Type 2 Compare
+							registers */
+/*@}*/
+
+/** @name Type 1 screener register bit definitions
+ * @{
+ */
+#define XEMACPS_SCREENT1_QUEUE_MASK	0x0000000FU /**< Queue number */
+#define XEMACPS_SCREENT1_DSTC_MASK	0x00000FF0U /**< DS/TC value */
+#define XEMACPS_SCREENT1_DSTC_SHIFT	4U
+#define XEMACPS_SCREENT1_UDPPORT_MASK	0x0FFFF000U /**< UDP port */
+#define XEMACPS_SCREENT1_UDPPORT_SHIFT	12U
+#define XEMACPS_SCREENT1_DSTCEN_MASK	0x10000000U /**< DS/TC match enable */
+#define XEMACPS_SCREENT1_UDPEN_MASK	0x20000000U /**< UDP port match
+							enable */
+/*@}*/
+
+/** @name Type 2 screener register bit definitions
+ *
+ * The compare fields A, B and C each hold a 5 bit compare register index
+ * followed by an enable bit, starting at XEMACPS_SCREENT2_CMP_SHIFT.
+ * @{
+ */
+#define XEMACPS_SCREENT2_QUEUE_MASK	0x0000000FU /**< Queue number */
+#define XEMACPS_SCREENT2_VLANPRI_MASK	0x00000070U /**< VLAN priority */
+#define XEMACPS_SCREENT2_VLANPRI_SHIFT	4U
+#define XEMACPS_SCREENT2_VLANEN_MASK	0x00000100U /**< VLAN priority match
+							enable */
+#define XEMACPS_SCREENT2_ETYPEIDX_MASK	0x00000E00U /**< EtherType register
+							index */
+#define XEMACPS_SCREENT2_ETYPEIDX_SHIFT	9U
+#define XEMACPS_SCREENT2_ETYPEEN_MASK	0x00001000U /**< EtherType match
+							enable */
+#define XEMACPS_SCREENT2_CMP_SHIFT	13U	/**< Shift of compare A */
+#define XEMACPS_SCREENT2_CMP_WIDTH	6U	/**< Bits of each compare */
+#define XEMACPS_SCREENT2_CMPIDX_MASK	0x0000001FU /**< Compare register
+							index */
+#define XEMACPS_SCREENT2_CMPEN_MASK	0x00000020U /**< Compare enable */
+
+#define XEMACPS_SCREENT2_ETYPE_MASK	0x0000FFFFU /**< EtherType value */
+
+#define XEMACPS_SCREENT2_CMPW0_MASK_MASK 0x0000FFFFU /**< Compare mask */
+#define XEMACPS_SCREENT2_CMPW0_VAL_SHIFT 16U	/**< Shift of compare value */
+#define XEMACPS_SCREENT2_CMPW1_OFST_MASK 0x0000007FU /**< Compare offset */
+#define XEMACPS_SCREENT2_CMPW1_TYPE_SHIFT 7U	/**< Shift of offset type */
+/*@}*/
+
 /**
  * @name interrupts bit definitions
  * Bits definitions are same in XEMACPS_ISR_OFFSET,
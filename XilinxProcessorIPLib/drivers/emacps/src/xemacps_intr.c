@@ -33,6 +33,8 @@
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.1   hk   07/27/15 Do not call error handler with '0' error code when
 *                     there is no error. CR# 869403
+* 3.12  hk   11/16/20 Add XEmacPs_SetQueueHandler() and handle the receive
+*                     interrupts of the priority queues.
 * </pre>
 ******************************************************************************/
 
@@ -107,6 +109,56 @@ LONG XEmacPs_SetHandler(XEmacPs *InstancePtr, u32 HandlerType,
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * Install an asynchronous handler function for the given HandlerType of a
+ * queue. The handlers of queue 0 are the ones of XEmacPs_SetHandler().
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param QueueNum is the queue of the handler.
+ * @param HandlerType indicates what interrupt handler type is. Only
+ *        XEMACPS_HANDLER_DMARECV is supported for the priority queues.
+ * @param FuncPointer is the pointer to the callback function
+ * @param CallBackRef is the upper layer callback reference passed back when
+ *        when the callback function is invoked.
+ *
+ * @return
+ * - XST_SUCCESS if the handler was installed
+ * - XST_NO_FEATURE if the device does not have the queue
+ * - XST_INVALID_PARAM if HandlerType is not supported for the queue
+ *
+ * @note
+ * The receive handler of a priority queue is invoked when frames were
+ * received on the queue and when the queue ran out of receive buffers, so
+ * that the upper layer can process the received BDs and give buffers back
+ * to the hardware. There is no assert on the CallBackRef since the driver
+ * doesn't know what it is.
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetQueueHandler(XEmacPs *InstancePtr, u8 QueueNum,
+			u32 HandlerType, void *FuncPointer, void *CallBackRef)
+{
+	LONG Status;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(FuncPointer != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+
+	if (QueueNum == 0U) {
+		Status = XEmacPs_SetHandler(InstancePtr, HandlerType,
+					FuncPointer, CallBackRef);
+	} else if (QueueNum >= InstancePtr->NumQueues) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else if (HandlerType == XEMACPS_HANDLER_DMARECV) {
+		Status = (LONG)(XST_SUCCESS);
+		InstancePtr->RecvQHandler[QueueNum - 1U] =
+			((XEmacPs_Handler)(void *)FuncPointer);
+		InstancePtr->RecvQRef[QueueNum - 1U] = CallBackRef;
+	} else {
+		Status = (LONG)(XST_INVALID_PARAM);
+	}
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 * Master interrupt handler for EMAC driver. This routine will query the
@@ -125,6 +177,8 @@ void XEmacPs_IntrHandler(void *XEmacPsPtr)
 	u32 RegSR;
 	u32 RegCtrl;
 	u32 RegQ1ISR = 0U;
+	u32 RegQISR;
+	u32 Queue;
 	XEmacPs *InstancePtr = (XEmacPs *) XEmacPsPtr;
 
 	Xil_AssertVoid(InstancePtr != NULL);
@@ -159,6 +213,29 @@ void XEmacPs_IntrHandler(void *XEmacPsPtr)
 		InstancePtr->RecvHandler(InstancePtr->RecvRef);
 	}
 
+	/* Priority queue receive interrupts */
+	for (Queue = 1U; Queue < InstancePtr->NumQueues; Queue++) {
+		if (Queue == 1U) {
+			RegQISR = RegQ1ISR;
+		} else {
+			RegQISR = XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+					XEMACPS_INTQ_STS_OFFSET(Queue));
+		}
+		RegQISR &= XEMACPS_INTQ_RX_IXR_ALL_MASK;
+		if (RegQISR != 0x00000000U) {
+			/* Clear the queue RX status, and the RX status register
+			 * RX complete and buffer not available indications */
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+					XEMACPS_INTQ_STS_OFFSET(Queue), RegQISR);
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+					XEMACPS_RXSR_OFFSET,
+					((u32)XEMACPS_RXSR_FRAMERX_MASK |
+					(u32)XEMACPS_RXSR_BUFFNA_MASK));
+			InstancePtr->RecvQHandler[Queue - 1U](
+					InstancePtr->RecvQRef[Queue - 1U]);
+		}
+	}
+
 	/* Transmit Q1 complete interrupt */
 	if ((InstancePtr->Version > 2) &&
 			((RegQ1ISR & XEMACPS_INTQ1SR_TXCOMPL_MASK) != 0x00000000U)) {
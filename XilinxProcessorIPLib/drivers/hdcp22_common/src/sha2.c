@@ -16,6 +16,10 @@
 * ----- ---- -------- -----------------------------------------------
 * 1.00  MH   10/30/15 First Release
 * 1.10  GM   10/14/19 Added "volatile" attribute to all "i" variables
+* 2.30  MH   10/18/20 Added word oriented, unrolled transform. Full blocks
+*                     are hashed in place from the input data. The byte
+*                     oriented one is built when XHDCP22_CMN_SHA256_BYTEWISE
+*                     is defined.
 *</pre>
 *
 *****************************************************************************/
@@ -45,6 +49,33 @@ typedef struct {
 #define SIG0(x) (ROTRIGHT(x,7) ^ ROTRIGHT(x,18) ^ ((x) >> 3))
 #define SIG1(x) (ROTRIGHT(x,17) ^ ROTRIGHT(x,19) ^ ((x) >> 10))
 
+#ifndef XHDCP22_CMN_SHA256_BYTEWISE
+// Big endian load of a message word
+#define SHA256_GETU32(p) (((u32)(p)[0] << 24) | ((u32)(p)[1] << 16) | \
+                          ((u32)(p)[2] << 8) | ((u32)(p)[3]))
+// Message schedule kept in a 16 word window
+#define SHA256_SCHED(W,i) (W[(i) & 15] += SIG1(W[((i) - 2) & 15]) + \
+                           W[((i) - 7) & 15] + SIG0(W[((i) - 15) & 15]))
+// One round, the working variables are rotated by the caller's argument order
+#define SHA256_ROUND(a,b,c,d,e,f,g,h,Ki,Wi) do { \
+      u32 T1 = (h) + EP1(e) + CH(e,f,g) + (Ki) + (Wi); \
+      (d) += T1; \
+      (h) = T1 + EP0(a) + MAJ(a,b,c); \
+   } while (0)
+#define SHA256_ROUND8(i,Wi) do { \
+      SHA256_ROUND(a,b,c,d,e,f,g,h,k[(i)],Wi((i))); \
+      SHA256_ROUND(h,a,b,c,d,e,f,g,k[(i)+1],Wi((i)+1)); \
+      SHA256_ROUND(g,h,a,b,c,d,e,f,k[(i)+2],Wi((i)+2)); \
+      SHA256_ROUND(f,g,h,a,b,c,d,e,k[(i)+3],Wi((i)+3)); \
+      SHA256_ROUND(e,f,g,h,a,b,c,d,k[(i)+4],Wi((i)+4)); \
+      SHA256_ROUND(d,e,f,g,h,a,b,c,k[(i)+5],Wi((i)+5)); \
+      SHA256_ROUND(c,d,e,f,g,h,a,b,k[(i)+6],Wi((i)+6)); \
+      SHA256_ROUND(b,c,d,e,f,g,h,a,k[(i)+7],Wi((i)+7)); \
+   } while (0)
+#define SHA256_W_LOAD(i) (m[(i)] = SHA256_GETU32(&Data[4 * (i)]))
+#define SHA256_W_SCHED(i) SHA256_SCHED(m,(i))
+#endif
+
 /************************** Variable Definitions ****************************/
 static const u32 k[64] = {
    0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
@@ -60,7 +91,7 @@ static const u32 k[64] = {
 /************************** Function Prototypes *****************************/
 
 /* SHA-256 Hashing */
-static void Sha256Transform(Sha256Type *Ctx, u8 *Data);
+static void Sha256Transform(Sha256Type *Ctx, const u8 *Data);
 static void Sha256Init(Sha256Type *Ctx);
 static void Sha256Update(Sha256Type *Ctx, const u8 *Data, u32 Len);
 static void Sha256Final(Sha256Type *Ctx, u8 *Hash);
@@ -103,7 +134,8 @@ void XHdcp22Cmn_Sha256Hash(const u8 *Data, u32 DataSize, u8 *HashedData)
 * @note   None.
 *
 ******************************************************************************/
-static void Sha256Transform(Sha256Type *Ctx, u8 *Data)
+#ifdef XHDCP22_CMN_SHA256_BYTEWISE
+static void Sha256Transform(Sha256Type *Ctx, const u8 *Data)
 {
   volatile u32 i;
   u32 a,b,c,d,e,f,g,h,j,t1,t2,m[64];
@@ -144,6 +176,41 @@ static void Sha256Transform(Sha256Type *Ctx, u8 *Data)
    Ctx->state[6] += g;
    Ctx->state[7] += h;
 }
+#else
+static void Sha256Transform(Sha256Type *Ctx, const u8 *Data)
+{
+   volatile u32 i;
+   u32 a,b,c,d,e,f,g,h,m[16];
+
+   a = Ctx->state[0];
+   b = Ctx->state[1];
+   c = Ctx->state[2];
+   d = Ctx->state[3];
+   e = Ctx->state[4];
+   f = Ctx->state[5];
+   g = Ctx->state[6];
+   h = Ctx->state[7];
+
+   // Rounds 0 to 15 use the message words as loaded
+   SHA256_ROUND8(0, SHA256_W_LOAD);
+   SHA256_ROUND8(8, SHA256_W_LOAD);
+
+   // Rounds 16 to 63 extend the message schedule in place
+   for (i = 16; i < 64; i += 16) {
+      SHA256_ROUND8(i, SHA256_W_SCHED);
+      SHA256_ROUND8(i + 8, SHA256_W_SCHED);
+   }
+
+   Ctx->state[0] += a;
+   Ctx->state[1] += b;
+   Ctx->state[2] += c;
+   Ctx->state[3] += d;
+   Ctx->state[4] += e;
+   Ctx->state[5] += f;
+   Ctx->state[6] += g;
+   Ctx->state[7] += h;
+}
+#endif
 
 /*****************************************************************************/
 /**
@@ -185,6 +252,7 @@ static void Sha256Init(Sha256Type *Ctx)
 * @note   None.
 *
 ******************************************************************************/
+#ifdef XHDCP22_CMN_SHA256_BYTEWISE
 static void Sha256Update(Sha256Type *Ctx, const u8 *Data, u32 Len)
 {
    volatile u32 i;
@@ -199,6 +267,41 @@ static void Sha256Update(Sha256Type *Ctx, const u8 *Data, u32 Len)
       }
    }
 }
+#else
+static void Sha256Update(Sha256Type *Ctx, const u8 *Data, u32 Len)
+{
+   u32 Fill;
+
+   // Complete a partially filled block first
+   if (Ctx->datalen != 0) {
+      Fill = 64 - Ctx->datalen;
+      if (Len < Fill) {
+         memcpy(&Ctx->data[Ctx->datalen], Data, Len);
+         Ctx->datalen += Len;
+         return;
+      }
+      memcpy(&Ctx->data[Ctx->datalen], Data, Fill);
+      Sha256Transform(Ctx, Ctx->data);
+      DBL_INT_ADD(Ctx->bitlen[0], Ctx->bitlen[1], 512);
+      Data += Fill;
+      Len -= Fill;
+      Ctx->datalen = 0;
+   }
+
+   // Hash full blocks straight from the input
+   while (Len >= 64) {
+      Sha256Transform(Ctx, Data);
+      DBL_INT_ADD(Ctx->bitlen[0], Ctx->bitlen[1], 512);
+      Data += 64;
+      Len -= 64;
+   }
+
+   if (Len != 0) {
+      memcpy(Ctx->data, Data, Len);
+      Ctx->datalen = Len;
+   }
+}
+#endif
 
 /*****************************************************************************/
 /**
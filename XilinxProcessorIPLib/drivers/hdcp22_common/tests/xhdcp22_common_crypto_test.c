@@ -0,0 +1,299 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xhdcp22_common_crypto_test.c
+*
+* Known answer test and benchmark of the HDCP 2.2 common AES-128, SHA-256
+* and HMAC-SHA256 functions, run on a host. The vectors are taken from
+* FIPS-197 appendix C.1, SP 800-38A F.1.1 (ECB), FIPS 180-2 appendix B and
+* RFC 4231 test cases 1 and 2. After the vectors pass, the time per AES block
+* and per SHA-256 hash of a few message sizes is printed.
+*
+* The Makefile of this directory builds the test twice, the second time with
+* XHDCP22_CMN_AES_BYTEWISE and XHDCP22_CMN_SHA256_BYTEWISE defined to build
+* the byte oriented implementations and compare the timings.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 2.30  MH   10/18/20 First Release
+*</pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "xil_types.h"
+#include "xhdcp22_common.h"
+
+/************************** Constant Definitions ****************************/
+#define BENCH_AES_BLOCKS   200000
+#define BENCH_SHA_BYTES    (4 * 1024 * 1024)
+
+/**************************** Type Definitions ******************************/
+typedef struct {
+   const char *Key;
+   const char *Plain;
+   const char *Cipher;
+} AesVector;
+
+typedef struct {
+   const char *Msg;
+   const char *Digest;
+} ShaVector;
+
+/************************** Variable Definitions ****************************/
+static const AesVector AesVectors[] = {
+   /* FIPS-197 C.1 */
+   {"000102030405060708090a0b0c0d0e0f", "00112233445566778899aabbccddeeff",
+    "69c4e0d86a7b0430d8cdb78070b4c55a"},
+   /* SP 800-38A F.1.1, blocks 1 to 4 */
+   {"2b7e151628aed2a6abf7158809cf4f3c", "6bc1bee22e409f96e93d7e117393172a",
+    "3ad77bb40d7a3660a89ecaf32466ef97"},
+   {"2b7e151628aed2a6abf7158809cf4f3c", "ae2d8a571e03ac9c9eb76fac45af8e51",
+    "f5d3d58503b9699de785895a96fdbaaf"},
+   {"2b7e151628aed2a6abf7158809cf4f3c", "30c81c46a35ce411e5fbc1191a0a52ef",
+    "43b1cd7f598ece23881b00e3ed030688"},
+   {"2b7e151628aed2a6abf7158809cf4f3c", "f69f2445df4f9b17ad2b417be66c3710",
+    "7b0c785e27e8ad3f8223207104725dd4"},
+};
+
+static const ShaVector ShaVectors[] = {
+   {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+   {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+   {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+};
+
+/* SHA-256 of one million times 'a', FIPS 180-2 B.3 */
+static const char *ShaMillionA =
+   "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0";
+
+/* RFC 4231 test case 1, key of 20 times 0x0b */
+static const char *HmacDigest1 =
+   "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7";
+/* RFC 4231 test case 2 */
+static const char *HmacDigest2 =
+   "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843";
+
+static u8 BenchData[BENCH_SHA_BYTES];
+
+/*****************************************************************************/
+/**
+*
+* This function converts a hex string to bytes.
+*
+* @param  Hex is the hex string.
+* @param  Out is the output buffer, half the string length in size.
+*
+* @return Number of bytes written.
+*
+******************************************************************************/
+static u32 HexToBytes(const char *Hex, u8 *Out)
+{
+   u32 Len = 0;
+   unsigned int Byte;
+
+   while (Hex[0] != '\0' && Hex[1] != '\0') {
+      sscanf(Hex, "%2x", &Byte);
+      Out[Len++] = (u8)Byte;
+      Hex += 2;
+   }
+
+   return Len;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function compares a buffer with the bytes of a hex string.
+*
+* @param  Data is the buffer.
+* @param  Hex is the expected value as hex string.
+*
+* @return 0 if equal, 1 otherwise.
+*
+******************************************************************************/
+static int CompareHex(const u8 *Data, const char *Hex)
+{
+   u8 Expected[64];
+   u32 Len;
+
+   Len = HexToBytes(Hex, Expected);
+
+   return (memcmp(Data, Expected, Len) != 0) ? 1 : 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the monotonic time in seconds.
+*
+* @return Time in seconds.
+*
+******************************************************************************/
+static double GetTime(void)
+{
+   struct timespec Ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &Ts);
+
+   return Ts.tv_sec + Ts.tv_nsec * 1e-9;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs the AES-128 encryption and decryption vectors.
+*
+* @return Number of failed vectors.
+*
+******************************************************************************/
+static int TestAes(void)
+{
+   u8 Key[16], Plain[16], Out[16];
+   int Errors = 0;
+   u32 i;
+
+   for (i = 0; i < sizeof(AesVectors)/sizeof(AesVectors[0]); i++) {
+      HexToBytes(AesVectors[i].Key, Key);
+      HexToBytes(AesVectors[i].Plain, Plain);
+
+      XHdcp22Cmn_Aes128Encrypt(Plain, Key, Out);
+      if (CompareHex(Out, AesVectors[i].Cipher)) {
+         printf("AES encryption vector %u failed\r\n", i);
+         Errors++;
+      }
+
+      XHdcp22Cmn_Aes128Decrypt(Out, Key, Out);
+      if (memcmp(Out, Plain, sizeof(Plain)) != 0) {
+         printf("AES decryption vector %u failed\r\n", i);
+         Errors++;
+      }
+   }
+
+   return Errors;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs the SHA-256 and HMAC-SHA256 vectors.
+*
+* @return Number of failed vectors.
+*
+******************************************************************************/
+static int TestSha256(void)
+{
+   u8 Hash[32];
+   u8 Key[20];
+   const char *Msg;
+   int Errors = 0;
+   u32 i;
+
+   for (i = 0; i < sizeof(ShaVectors)/sizeof(ShaVectors[0]); i++) {
+      Msg = ShaVectors[i].Msg;
+      XHdcp22Cmn_Sha256Hash((const u8 *)Msg, strlen(Msg), Hash);
+      if (CompareHex(Hash, ShaVectors[i].Digest)) {
+         printf("SHA-256 vector %u failed\r\n", i);
+         Errors++;
+      }
+   }
+
+   memset(BenchData, 'a', 1000000);
+   XHdcp22Cmn_Sha256Hash(BenchData, 1000000, Hash);
+   if (CompareHex(Hash, ShaMillionA)) {
+      printf("SHA-256 million 'a' vector failed\r\n");
+      Errors++;
+   }
+
+   memset(Key, 0x0b, sizeof(Key));
+   Msg = "Hi There";
+   XHdcp22Cmn_HmacSha256Hash((const u8 *)Msg, strlen(Msg), Key, sizeof(Key),
+                             Hash);
+   if (CompareHex(Hash, HmacDigest1)) {
+      printf("HMAC-SHA256 vector 1 failed\r\n");
+      Errors++;
+   }
+
+   Msg = "what do ya want for nothing?";
+   XHdcp22Cmn_HmacSha256Hash((const u8 *)Msg, strlen(Msg), (const u8 *)"Jefe",
+                             4, Hash);
+   if (CompareHex(Hash, HmacDigest2)) {
+      printf("HMAC-SHA256 vector 2 failed\r\n");
+      Errors++;
+   }
+
+   return Errors;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function prints the time per AES block and per SHA-256 hash.
+*
+* @return None.
+*
+******************************************************************************/
+static void Benchmark(void)
+{
+   static const u32 ShaSizes[] = {64, 256, 4096};
+   u8 Key[16] = {0}, Block[16] = {0}, Hash[32];
+   double Start, Time;
+   u32 Count;
+   u32 i, n;
+
+   Start = GetTime();
+   for (i = 0; i < BENCH_AES_BLOCKS; i++) {
+      XHdcp22Cmn_Aes128Encrypt(Block, Key, Block);
+   }
+   Time = GetTime() - Start;
+   printf("AES-128 encrypt: %.0f ns per block\r\n",
+          Time * 1e9 / BENCH_AES_BLOCKS);
+
+   Start = GetTime();
+   for (i = 0; i < BENCH_AES_BLOCKS; i++) {
+      XHdcp22Cmn_Aes128Decrypt(Block, Key, Block);
+   }
+   Time = GetTime() - Start;
+   printf("AES-128 decrypt: %.0f ns per block\r\n",
+          Time * 1e9 / BENCH_AES_BLOCKS);
+
+   for (n = 0; n < sizeof(ShaSizes)/sizeof(ShaSizes[0]); n++) {
+      Count = BENCH_SHA_BYTES / ShaSizes[n];
+      Start = GetTime();
+      for (i = 0; i < Count; i++) {
+         XHdcp22Cmn_Sha256Hash(&BenchData[i * ShaSizes[n]], ShaSizes[n], Hash);
+      }
+      Time = GetTime() - Start;
+      printf("SHA-256 of %u bytes: %.0f ns per hash, %.1f MB/s\r\n",
+             ShaSizes[n], Time * 1e9 / Count,
+             BENCH_SHA_BYTES / Time / 1e6);
+   }
+}
+
+int main(void)
+{
+   int Errors;
+
+   Errors = TestAes();
+   Errors += TestSha256();
+   if (Errors != 0) {
+      printf("HDCP 2.2 common crypto known answer test failed\r\n");
+      return 1;
+   }
+   printf("Successfully ran HDCP 2.2 common crypto known answer test\r\n");
+
+   Benchmark();
+
+   return 0;
+}
@@ -83,6 +83,15 @@
 *                       warnings.
 * 1.6	sd     06/02/20    Added Clock support
 * 1.6	sd     20/03/20    Added compilation flag
+* 1.7	akm    11/16/20    Added read cache sequential reads to
+*			   XNandPsu_Read(), added XNandPsu_ReadPages() which
+*			   interleaves the array reads of the LUNs and added
+*			   XNandPsu_EnableReadCache() and
+*			   XNandPsu_DisableReadCache().
+*	akm    11/16/20    Wait for the program to complete in
+*			   XNandPsu_WriteSpareBytes() and return its status.
+*	akm    11/16/20    Read cache sequential reads are off until
+*			   XNandPsu_EnableReadCache() is called.
 *
 * </pre>
 *
@@ -166,6 +175,18 @@ static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 							u32 Col, u8 *Buf);
 
+static s32 XNandPsu_ReadPageData(XNandPsu *InstancePtr, u32 Target, u32 Page,
+				u32 Col, u8 Cmd1, u8 Cmd2, u32 AddrCycles,
+				u32 ProgMask, u8 *Buf);
+
+static s32 XNandPsu_ReadCache(XNandPsu *InstancePtr, u32 Target, u32 Page,
+				u32 NumPages, u8 *Buf);
+
+static s32 XNandPsu_StartPageRead(XNandPsu *InstancePtr, u32 Target, u32 Page,
+				u32 ProgMask);
+
+static s32 XNandPsu_LunReady(XNandPsu *InstancePtr, u32 Target, u32 Page);
+
 static s32 XNandPsu_CheckOnDie(XNandPsu *InstancePtr, OnfiParamPage *Param);
 
 static void XNandPsu_SetEccAddrSize(XNandPsu *InstancePtr);
@@ -254,6 +275,9 @@ s32 XNandPsu_CfgInitialize(XNandPsu *InstancePtr, XNandPsu_Config *ConfigPtr,
 	 InstancePtr->Ecc_Stat_PerPage_flips = 0U;
 	 InstancePtr->Ecc_Stats_total_flips = 0U;
 
+	/* Read cache sequential reads are enabled by XNandPsu_EnableReadCache() */
+	InstancePtr->ReadCacheEn = 0U;
+
 	/*
 	 * Scan for the bad block table(bbt) stored in the flash & load it in
 	 * memory(RAM).  If bbt is not found, create bbt by scanning factory
@@ -519,6 +543,12 @@ static void XNandPsu_InitFeatures(XNandPsu *InstancePtr, OnfiParamPage *Param)
 								1U : 0U;
 	InstancePtr->Features.ExtPrmPage = ((Param->Features & (1U << 7)) != 0U) ?
 								1U : 0U;
+	InstancePtr->Features.ReadCache = ((Param->OptionalCmds &
+					(1U << 1)) != 0U) ? 1U : 0U;
+	InstancePtr->Features.RdStsEnh = ((Param->OptionalCmds &
+					(1U << 3)) != 0U) ? 1U : 0U;
+	InstancePtr->Features.ChngRdColEnh = ((Param->OptionalCmds &
+					(1U << 6)) != 0U) ? 1U : 0U;
 }
 
 /*****************************************************************************/
@@ -708,6 +738,53 @@ void XNandPsu_DisableEccMode(XNandPsu *InstancePtr)
 	InstancePtr->EccMode = XNANDPSU_NONE;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function enables read cache sequential reads of full pages in
+* XNandPsu_Read(), if the flash supports the Read Cache commands. They are
+* disabled after XNandPsu_CfgInitialize().
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+void XNandPsu_EnableReadCache(XNandPsu *InstancePtr)
+{
+	/* Assert the input arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	InstancePtr->ReadCacheEn = InstancePtr->Features.ReadCache;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function disables read cache sequential reads. XNandPsu_Read() then
+* reads every page with the Read Page command.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+void XNandPsu_DisableReadCache(XNandPsu *InstancePtr)
+{
+	/* Assert the input arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	InstancePtr->ReadCacheEn = 0U;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -1443,6 +1520,7 @@ s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *DestBuf)
 	u32 PartialBytes = 0U;
 	u32 RemLen;
 	u32 NumBytes;
+	u32 NumPages;
 	u8 *BufPtr;
 	u8 *DestBufPtr = (u8 *)DestBuf;
 	u64 OffsetVar = Offset;
@@ -1499,16 +1577,32 @@ s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *DestBuf)
 		if (PartialBytes > 0U) {
 			BufPtr = &InstancePtr->PartialDataBuf[0];
 			NumBytes = PartialBytes;
+			NumPages = 1U;
 		} else {
 			BufPtr = DestBufPtr;
 			NumBytes = (InstancePtr->Geometry.BytesPerPage <
 					(u32)LengthVar) ?
 					InstancePtr->Geometry.BytesPerPage :
 					(u32)LengthVar;
+			/* Full pages left in the block */
+			NumPages = InstancePtr->Geometry.PagesPerBlock -
+				(Page % InstancePtr->Geometry.PagesPerBlock);
+			if ((u64)NumPages * InstancePtr->Geometry.BytesPerPage >
+								LengthVar) {
+				NumPages = (u32)(LengthVar /
+					InstancePtr->Geometry.BytesPerPage);
+			}
+		}
+		if ((InstancePtr->ReadCacheEn != 0U) && (NumPages > 1U)) {
+			/* Read the full pages of the block from the cache */
+			NumBytes = NumPages * InstancePtr->Geometry.BytesPerPage;
+			Status = XNandPsu_ReadCache(InstancePtr, Target, Page,
+							NumPages, BufPtr);
+		} else {
+			/* Read page */
+			Status = XNandPsu_ReadPage(InstancePtr, Target, Page,
+								0U, BufPtr);
 		}
-		/* Read page */
-		Status = XNandPsu_ReadPage(InstancePtr, Target, Page, 0U,
-								BufPtr);
 		if (Status != XST_SUCCESS) {
 			goto Out;
 		}
@@ -1525,6 +1619,142 @@ Out:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function reads a list of full pages from the flash.
+*
+* When the flash has several LUNs supporting the Read Status Enhanced and
+* Change Read Column Enhanced commands, the array reads of up to
+* XNANDPSU_READ_LOOKAHEAD pages are started on the idle LUNs before the
+* data of the first page is transferred. The array reads on a LUN then
+* overlap the transfers from the other ones, so pages spread over the LUNs
+* are read faster than with XNandPsu_Read().
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Pages is the array of the page numbers to read.
+* @param	NumPages is the number of pages to read.
+* @param	DestBuf is the destination data buffer to fill in, NumPages
+*		pages long. Page Pages[i] is read at i times the page size.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		The pages are raw flash pages, bad blocks are not skipped.
+*
+******************************************************************************/
+s32 XNandPsu_ReadPages(XNandPsu *InstancePtr, const u32 *Pages, u32 NumPages,
+							u8 *DestBuf)
+{
+	s32 Status = XST_FAILURE;
+	u8 LunBusy[XNANDPSU_MAX_TARGETS * XNANDPSU_MAX_LUNS] = {0U};
+	u32 LunPages;
+	u32 NumLuns;
+	u32 Target;
+	u32 Page;
+	u32 Lun;
+	u32 Index;
+	u32 Started = 0U;
+	u32 AddrCycles;
+	u8 *BufPtr = DestBuf;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Pages != NULL);
+	Xil_AssertNonvoid(DestBuf != NULL);
+
+	AddrCycles = InstancePtr->Geometry.RowAddrCycles +
+				InstancePtr->Geometry.ColAddrCycles;
+	LunPages = InstancePtr->Geometry.PagesPerBlock *
+				InstancePtr->Geometry.BlocksPerLun;
+	NumLuns = InstancePtr->Geometry.NumLuns;
+
+	for (Index = 0U; Index < NumPages; Index++) {
+		Xil_AssertNonvoid(Pages[Index] < InstancePtr->Geometry.NumPages);
+	}
+
+	/* Read page by page when the array reads can not be overlapped */
+	if (((NumLuns * InstancePtr->Geometry.NumTargets) < 2U) ||
+			(NumLuns > XNANDPSU_MAX_LUNS) ||
+			(InstancePtr->Features.RdStsEnh == 0U) ||
+			(InstancePtr->Features.ChngRdColEnh == 0U)) {
+		for (Index = 0U; Index < NumPages; Index++) {
+			Target = Pages[Index] /
+				InstancePtr->Geometry.NumTargetPages;
+			Page = Pages[Index] %
+				InstancePtr->Geometry.NumTargetPages;
+			Status = XNandPsu_ReadPage(InstancePtr, Target, Page,
+								0U, BufPtr);
+			if (Status != XST_SUCCESS) {
+				goto Out;
+			}
+			BufPtr += InstancePtr->Geometry.BytesPerPage;
+		}
+		Status = XST_SUCCESS;
+		goto Out;
+	}
+
+	for (Index = 0U; Index < NumPages; Index++) {
+		/*
+		 * Start the array reads of the next pages, in order, until a
+		 * page of a busy LUN. The LUN of the page Index is idle as
+		 * the pages before it have been transferred.
+		 */
+		while ((Started < NumPages) &&
+			(Started < (Index + XNANDPSU_READ_LOOKAHEAD))) {
+			Target = Pages[Started] /
+				InstancePtr->Geometry.NumTargetPages;
+			Page = Pages[Started] %
+				InstancePtr->Geometry.NumTargetPages;
+			Lun = (Target * NumLuns) + (Page / LunPages);
+			if (LunBusy[Lun] != 0U) {
+				break;
+			}
+			Status = XNandPsu_StartPageRead(InstancePtr, Target,
+					Page, XNANDPSU_PROG_MUL_DIE_RD_MASK);
+			if (Status != XST_SUCCESS) {
+				goto Out;
+			}
+			LunBusy[Lun] = 1U;
+			Started++;
+		}
+
+		/* Wait for the page and transfer it from its LUN */
+		Target = Pages[Index] / InstancePtr->Geometry.NumTargetPages;
+		Page = Pages[Index] % InstancePtr->Geometry.NumTargetPages;
+		Lun = (Target * NumLuns) + (Page / LunPages);
+		Status = XNandPsu_LunReady(InstancePtr, Target, Page);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		Status = XNandPsu_ReadPageData(InstancePtr, Target, Page, 0U,
+				ONFI_CMD_CHNG_RD_COL_ENHCD1,
+				ONFI_CMD_CHNG_RD_COL_ENHCD2, AddrCycles,
+				XNANDPSU_PROG_CHNG_RD_COL_ENH_MASK, BufPtr);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		LunBusy[Lun] = 0U;
+		BufPtr += InstancePtr->Geometry.BytesPerPage;
+	}
+
+	Status = XST_SUCCESS;
+Out:
+	if ((Status != XST_SUCCESS) && (Started > 0U)) {
+#ifdef XNANDPSU_DEBUG
+		xil_printf("%s: Interleaved read failed\r\n", __func__);
+#endif
+		/* Reset the targets to abort the array reads started */
+		for (Target = 0U; Target < InstancePtr->Geometry.NumTargets;
+								Target++) {
+			(void)XNandPsu_OnfiReset(InstancePtr, Target);
+		}
+	}
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -1824,6 +2054,9 @@ s32 XNandPsu_WriteSpareBytes(XNandPsu *InstancePtr, u32 Page, u8 *Buf)
 
 	Status = XNandPsu_Data_ReadWrite(InstancePtr, (u8 *)BufPtr, PktCount,
 					 PktSize, 1, 1);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
 
 	if (InstancePtr->EccMode == XNANDPSU_HWECC) {
 		if (PostWrite > 0U) {
@@ -1837,6 +2070,9 @@ s32 XNandPsu_WriteSpareBytes(XNandPsu *InstancePtr, u32 Page, u8 *Buf)
 			}
 		}
 	}
+
+	/* Wait for the program to complete and check its status */
+	Status = XNandPsu_Device_Ready(InstancePtr, Target);
 Out:
 	return Status;
 }
@@ -1864,6 +2100,40 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 {
 	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
 				InstancePtr->Geometry.ColAddrCycles;
+
+	return XNandPsu_ReadPageData(InstancePtr, Target, Page, Col,
+				ONFI_CMD_RD1, ONFI_CMD_RD2, AddrCycles,
+				XNANDPSU_PROG_RD_MASK, Buf);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends a command reading a page from flash and reads the page
+* data, checking the ECC errors. It is used for the Read Page, Read Cache and
+* Change Read Column Enhanced commands.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the page address value to read.
+* @param	Col is the column address value to read.
+* @param	Cmd1 is the first Onfi Command.
+* @param	Cmd2 is the second Onfi Command.
+* @param	AddrCycles is the number of address cycles sent.
+* @param	ProgMask is the Program Register mask of the command.
+* @param	Buf is the data buffer to fill in.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_ReadPageData(XNandPsu *InstancePtr, u32 Target, u32 Page,
+				u32 Col, u8 Cmd1, u8 Cmd2, u32 AddrCycles,
+				u32 ProgMask, u8 *Buf)
+{
 	u32 PktSize;
 	u32 PktCount;
 	s32 Status = XST_FAILURE;
@@ -1880,8 +2150,7 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	}
 	PktCount = InstancePtr->Geometry.BytesPerPage/PktSize;
 
-	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_RD1, ONFI_CMD_RD2,
-					1U, 1U, (u8)AddrCycles);
+	XNandPsu_Prepare_Cmd(InstancePtr, Cmd1, Cmd2, 1U, 1U, (u8)AddrCycles);
 
 	if (InstancePtr->DmaMode == XNANDPSU_MDMA) {
 		RegVal = XNANDPSU_INTR_STS_EN_TRANS_COMP_STS_EN_MASK |
@@ -1918,7 +2187,7 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 
 	/* Set Read command in Program Register */
 	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
-				XNANDPSU_PROG_OFFSET,XNANDPSU_PROG_RD_MASK);
+				XNANDPSU_PROG_OFFSET, ProgMask);
 
 	Status = XNandPsu_Data_ReadWrite(InstancePtr, Buf, PktCount, PktSize, 0, 1);
 
@@ -1971,6 +2240,199 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function reads consecutive pages of a block with the Read Cache
+* Sequential command, so that the array read of the next page overlaps the
+* transfer of the current page.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the first page to read.
+* @param	NumPages is the number of pages to read, in the block of Page.
+* @param	Buf is the data buffer to fill in, NumPages pages long.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		The target is reset when a read fails, to end the cache read.
+*
+******************************************************************************/
+static s32 XNandPsu_ReadCache(XNandPsu *InstancePtr, u32 Target, u32 Page,
+				u32 NumPages, u8 *Buf)
+{
+	s32 Status = XST_FAILURE;
+	u32 Index;
+	u8 *BufPtr = Buf;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(NumPages > 1U);
+	Xil_AssertNonvoid(((Page % InstancePtr->Geometry.PagesPerBlock) +
+			NumPages) <= InstancePtr->Geometry.PagesPerBlock);
+
+	/* Read the first page to the page register */
+	Status = XNandPsu_StartPageRead(InstancePtr, Target, Page,
+					XNANDPSU_PROG_RD_CACHE_START_MASK);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+	Status = XNandPsu_Device_Ready(InstancePtr, Target);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+
+	/*
+	 * Every Read Cache command moves the page read to the cache register
+	 * to be transferred, the Read Cache Sequential command also starting
+	 * the read of the next page.
+	 */
+	for (Index = 0U; Index < NumPages; Index++) {
+		if (Index < (NumPages - 1U)) {
+			Status = XNandPsu_ReadPageData(InstancePtr, Target,
+					Page + Index, 0U, ONFI_CMD_RD_CACHE_SEQ,
+					ONFI_CMD_INVALID, 0U,
+					XNANDPSU_PROG_RD_CACHE_SEQ_MASK,
+					BufPtr);
+		} else {
+			Status = XNandPsu_ReadPageData(InstancePtr, Target,
+					Page + Index, 0U, ONFI_CMD_RD_CACHE_END,
+					ONFI_CMD_INVALID, 0U,
+					XNANDPSU_PROG_RD_CACHE_END_MASK,
+					BufPtr);
+		}
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		BufPtr += InstancePtr->Geometry.BytesPerPage;
+	}
+
+Out:
+	if (Status != XST_SUCCESS) {
+#ifdef XNANDPSU_DEBUG
+		xil_printf("%s: Read cache failed at page %d\r\n", __func__,
+							Page);
+#endif
+		(void)XNandPsu_OnfiReset(InstancePtr, Target);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends a Read Page command without transferring the data, to
+* start the read of a page to the page register of its LUN.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the page address value to read.
+* @param	ProgMask is the Program Register mask, for the Read Cache start
+*		or the Multi Die Read command.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		The LUN is busy when this function returns.
+*
+******************************************************************************/
+static s32 XNandPsu_StartPageRead(XNandPsu *InstancePtr, u32 Target, u32 Page,
+				u32 ProgMask)
+{
+	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
+				InstancePtr->Geometry.ColAddrCycles;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(Target < XNANDPSU_MAX_TARGETS);
+
+	/* Enable Transfer Complete Interrupt in Interrupt Status Register */
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+		XNANDPSU_INTR_STS_EN_OFFSET,
+		XNANDPSU_INTR_STS_EN_TRANS_COMP_STS_EN_MASK);
+	/* Program Command */
+	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_RD1, ONFI_CMD_RD2, 0U, 0U,
+						(u8)AddrCycles);
+	/* Program Column, Page, Block address */
+	XNandPsu_SetPageColAddr(InstancePtr, Page, 0U);
+	/* Program Memory Address Register2 for chip select */
+	XNandPsu_SelectChip(InstancePtr, Target);
+	/* Set Read command in Program Register */
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+				XNANDPSU_PROG_OFFSET, ProgMask);
+	/* Poll for Transfer Complete event */
+	return XNandPsu_WaitFor_Transfer_Complete(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function waits for the LUN of a page to be ready, with the ONFI Read
+* Status Enhanced command, which does not disturb the other LUNs.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is a page address of the LUN.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_LunReady(XNandPsu *InstancePtr, u32 Target, u32 Page)
+{
+	s32 Status = XST_FAILURE;
+	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles;
+	u16 OnfiStatus;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(Target < XNANDPSU_MAX_TARGETS);
+
+	do {
+		/* Enable Transfer Complete Interrupt */
+		XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+			XNANDPSU_INTR_STS_EN_OFFSET,
+			XNANDPSU_INTR_STS_EN_TRANS_COMP_STS_EN_MASK);
+		/* Program Command */
+		XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_RD_STS_ENHCD,
+				ONFI_CMD_INVALID, 0U, 0U, (u8)AddrCycles);
+		/* Program the row address, as done for block erase */
+		XNandPsu_SetPageColAddr(InstancePtr, (Page >> 16U) & 0xFFFFU,
+					(u16)(Page & 0xFFFFU));
+		/* Program Memory Address Register2 for chip select */
+		XNandPsu_SelectChip(InstancePtr, Target);
+		/* Program Packet Size and Packet Count */
+		if (InstancePtr->DataInterface == XNANDPSU_SDR) {
+			XNandPsu_SetPktSzCnt(InstancePtr, 1U, 1U);
+		} else {
+			XNandPsu_SetPktSzCnt(InstancePtr, 2U, 1U);
+		}
+		/* Set Read Status Enhanced in Program Register */
+		XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+				XNANDPSU_PROG_OFFSET,
+				XNANDPSU_PROG_RD_STS_ENH_MASK);
+		/* Poll for Transfer Complete event */
+		Status = XNandPsu_WaitFor_Transfer_Complete(InstancePtr);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		OnfiStatus = (u16)XNandPsu_ReadReg(
+					InstancePtr->Config.BaseAddress,
+					XNANDPSU_FLASH_STS_OFFSET);
+		if (((OnfiStatus & (1U << 6U)) != 0U) &&
+				((OnfiStatus & (1U << 0U)) != 0U)) {
+			Status = XST_FAILURE;
+			goto Out;
+		}
+	} while (((OnfiStatus >> 6U) & 0x1U) == 0U);
+
+Out:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -70,6 +70,19 @@
 * only after the erase operation is completed successfully or an error is
 * reported.
 *
+* <b>Read Cache and Multi-LUN Operations</b>
+*
+* When the ONFI parameter page advertises the Read Cache commands and
+* XNandPsu_EnableReadCache() was called, the read call reads the full pages of
+* a block with Read Cache Sequential, so that the array read of the next page
+* overlaps the transfer of the current page. Read cache is off by default and
+* can be turned off again with XNandPsu_DisableReadCache().
+*
+* XNandPsu_ReadPages() reads a list of pages. When the pages are spread over
+* LUNs supporting Read Status Enhanced and Change Read Column Enhanced, the
+* array reads are started on all LUNs before the data is transferred, so that
+* the array read on one LUN overlaps the transfer from another one.
+*
 * @note		Driver has been renamed to nandpsu after change in
 *		naming convention.
 *
@@ -147,6 +160,13 @@
 *                          warnings.
 # 1.6	sd     06/02/20    Added Clock support
 * 1.6	sd     20/03/20    Added compilation flag
+* 1.7	akm    11/16/20    Added read cache sequential reads, the
+*			   XNandPsu_ReadPages() API interleaving the reads
+*			   of the LUNs, and the XNandPsu_EnableReadCache()
+*			   and XNandPsu_DisableReadCache() APIs.
+*	akm    11/16/20    XNandPsu_WriteSpareBytes() waits for the program
+*			   to complete and returns its status.
+*	akm    11/16/20    Read cache is off by default.
 *
 * </pre>
 *
@@ -175,6 +195,11 @@ extern "C" {
 #define XNANDPSU_DEBUG
 
 #define XNANDPSU_MAX_TARGETS		1U	/**< ce_n0, ce_n1 */
+#define XNANDPSU_MAX_LUNS		8U	/**< LUNs per target interleaved
+						  by XNandPsu_ReadPages() */
+#define XNANDPSU_READ_LOOKAHEAD		16U	/**< Pages scanned ahead by
+						  XNandPsu_ReadPages() to start
+						  array reads */
 #define XNANDPSU_MAX_PKT_SIZE		0x7FFU	/**< Max packet size */
 #define XNANDPSU_MAX_PKT_COUNT		0xFFFU	/**< Max packet count */
 
@@ -329,6 +354,9 @@ typedef struct {
 	u32 EzNand;
 	u32 OnDie;
 	u32 ExtPrmPage;
+	u32 ReadCache;
+	u32 RdStsEnh;
+	u32 ChngRdColEnh;
 } XNandPsu_Features;
 
 /**
@@ -373,6 +401,7 @@ typedef struct {
 	XNandPsu_SWMode Mode;		/**< Driver operating mode */
 	XNandPsu_DmaMode DmaMode;	/**< MDMA mode enabled/disabled */
 	XNandPsu_EccMode EccMode;	/**< ECC Mode */
+	u32 ReadCacheEn;		/**< Read cache sequential enabled */
 	XNandPsu_EccCfg EccCfg;		/**< ECC configuration */
 	XNandPsu_Geometry Geometry;	/**< Flash geometry */
 	XNandPsu_Features Features;	/**< ONFI features */
@@ -530,6 +559,9 @@ s32 XNandPsu_Write(XNandPsu *InstancePtr, u64 Offset, u64 Length,
 s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length,
 							u8 *DestBuf);
 
+s32 XNandPsu_ReadPages(XNandPsu *InstancePtr, const u32 *Pages, u32 NumPages,
+							u8 *DestBuf);
+
 s32 XNandPsu_EraseBlock(XNandPsu *InstancePtr, u32 Target, u32 Block);
 
 s32 XNandPsu_WriteSpareBytes(XNandPsu *InstancePtr, u32 Page, u8 *Buf);
@@ -558,6 +590,10 @@ void XNandPsu_EnableEccMode(XNandPsu *InstancePtr);
 
 void XNandPsu_DisableEccMode(XNandPsu *InstancePtr);
 
+void XNandPsu_EnableReadCache(XNandPsu *InstancePtr);
+
+void XNandPsu_DisableReadCache(XNandPsu *InstancePtr);
+
 void XNandPsu_Prepare_Cmd(XNandPsu *InstancePtr, u8 Cmd1, u8 Cmd2, u8 EccState,
 			u8 DmaMode, u8 AddrCycles);
 
@@ -0,0 +1,1056 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+*******************************************************************************/
+/*****************************************************************************/
+/**
+* @file xnandpsu_emu_test.c
+*
+* This file contains a test running the NAND driver (XNandPsu) on a host,
+* against a behavioral model of the controller and of a two LUN ONFI flash,
+* using the register IO emulation of the standalone BSP.
+*
+* The model checks the command sequences sent by the driver against the LUN
+* states and reports the violations, like a command sent to a busy LUN or a
+* Read Cache Sequential command without a page read. It also keeps the time
+* the commands take on the flash interface, so that the test reports the
+* time taken by the page by page, read cache and interleaved reads, for the
+* DMA and the PIO modes, after checking the data read.
+*
+* The test is built and run on the build machine by the Makefile of this
+* directory.
+*
+* @note
+*
+* The model does not compute ECC, the data read is never corrected.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- ----------  -----------------------------------------------
+* 1.7  akm  11/16/2020  First release.
+*</pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include <xil_types.h>
+#include <xil_printf.h>
+#include "xil_io.h"
+#include "xnandpsu.h"
+#include "xnandpsu_onfi.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Address of the modeled controller, never accessed as host memory */
+#define NAND_BASEADDR		0xFF100000U
+#define NAND_REGS_SIZE		0x100U
+
+/* Geometry of the modeled flash */
+#define NAND_PAGE_SIZE		2048U
+#define NAND_SPARE_SIZE		64U
+#define NAND_PAGES_PER_BLOCK	64U
+#define NAND_BLOCKS_PER_LUN	64U
+#define NAND_NUM_LUNS		2U
+#define NAND_LUN_PAGES		(NAND_PAGES_PER_BLOCK * NAND_BLOCKS_PER_LUN)
+#define NAND_NUM_PAGES		(NAND_LUN_PAGES * NAND_NUM_LUNS)
+#define NAND_RAW_PAGE_SIZE	(NAND_PAGE_SIZE + NAND_SPARE_SIZE)
+#define NAND_ROW_CYCLES		3U
+#define NAND_COL_CYCLES		2U
+
+/* Timings of the modeled flash and controller, in ns */
+#define NAND_T_CYCLE		25U	/* Command or address cycle */
+#define NAND_T_BYTE		20U	/* Data byte, 50 MB/s */
+#define NAND_T_OP		500U	/* Controller operation setup */
+#define NAND_T_R		50000U	/* Page read */
+#define NAND_T_RCBSY		3000U	/* Read cache busy */
+#define NAND_T_PROG		300000U	/* Page program */
+#define NAND_T_BERS		2000000U /* Block erase */
+#define NAND_T_RST		5000U	/* Reset */
+
+/* Flash status bits */
+#define NAND_STS_FAIL		0x01U
+#define NAND_STS_ARDY		0x20U
+#define NAND_STS_RDY		0x40U
+#define NAND_STS_WP_N		0x80U
+
+#define NAND_MAX_XFER		(NAND_RAW_PAGE_SIZE + 4U)
+#define NAND_MAX_LOGS		8U	/* Violations printed */
+#define NAND_NO_PAGE		0xFFFFFFFFU
+
+/* Area read by the test, the first blocks of both LUNs */
+#define TEST_BLOCKS		4U
+#define TEST_PAGES		(TEST_BLOCKS * NAND_PAGES_PER_BLOCK)
+#define TEST_BUF_SIZE		(TEST_PAGES * NAND_PAGE_SIZE)
+#define TEST_LUN_OFFSET		((u64)NAND_LUN_PAGES * NAND_PAGE_SIZE)
+
+/**************************** Type Definitions *******************************/
+
+/* State of a LUN of the modeled flash */
+typedef struct {
+	u64 ReadyAt;		/* End of the busy time, RDY status bit */
+	u64 ArrayReadyAt;	/* End of the array operation, ARDY bit */
+	u32 PageReg;		/* Page read to the page register */
+	u32 DataPage;		/* Page in the data or cache register */
+	u32 CacheActive;	/* Read cache sequential in progress */
+} NandLun;
+
+/* State of the modeled controller and flash */
+typedef struct {
+	Xil_EmuRegion Region;
+	u32 Regs[NAND_REGS_SIZE / 4U];
+	NandLun Lun[NAND_NUM_LUNS];
+	u32 LastLun;		/* LUN returning the status */
+	u64 Now;		/* Time of the flash interface, ns */
+	u8 Xfer[NAND_MAX_XFER];	/* PIO data, packets padded to words */
+	u32 XferLen;		/* Bytes of the PIO transfer */
+	u32 XferPos;		/* Bytes of the PIO transfer done */
+	u32 PktLen;		/* PIO packet length padded to words */
+	u32 PktSize;		/* PIO packet size */
+	u32 XferWrite;		/* PIO transfer is a page program */
+	u32 WrPage;		/* Page of the PIO page program */
+	u32 WrCol;		/* Column of the PIO page program */
+	u32 Violations;		/* Protocol violations found */
+	u8 ParamPage[ONFI_MND_PRM_PGS * ONFI_PRM_PG_LEN];
+} NandModel;
+
+/************************** Function Prototypes ******************************/
+
+s32 NandEmuTest(void);
+static s32 NandEmu_TestReads(void);
+static s32 NandEmu_Check(const char *Name, const u32 *Pages, u32 NumPages,
+				u64 Start);
+static void NandEmu_Fill(u8 *Buf, u32 Page);
+static void Nand_Init(NandModel *Model);
+static u32 Nand_Read(void *CallBackRef, u32 Offset, u32 *RegsPtr);
+static u32 Nand_Write(void *CallBackRef, u32 Offset, u32 *RegsPtr, u32 Value);
+static void Nand_Prog(NandModel *Model, u32 Prog);
+static void Nand_DecodeAddr(const NandModel *Model, u32 Cycles, u32 *Row,
+				u32 *Col);
+static u32 Nand_CheckLun(NandModel *Model, u32 Page, const char *Cmd);
+static void Nand_CheckIdle(NandModel *Model);
+static void Nand_ReadData(NandModel *Model, u32 Page, u32 Col);
+static void Nand_SendData(NandModel *Model, const u8 *Data, u32 Len);
+static void Nand_ProgramData(NandModel *Model, u32 Page, u32 Col,
+				const u8 *Data, u32 Stride);
+static void Nand_Violation(NandModel *Model, const char *Msg, u32 Page);
+
+/************************** Variable Definitions *****************************/
+
+XNandPsu NandInstance;			/* XNand Instance */
+XNandPsu *NandInstPtr = &NandInstance;
+
+static NandModel Model;
+static u8 Flash[NAND_NUM_PAGES][NAND_RAW_PAGE_SIZE];
+
+u8 ReadBuffer[TEST_BUF_SIZE] __attribute__ ((aligned(64)));
+u8 WriteBuffer[TEST_BUF_SIZE] __attribute__ ((aligned(64)));
+u32 PageList[2U * TEST_PAGES];
+
+/************************** Function Definitions ******************************/
+
+/****************************************************************************/
+/**
+*
+* Main function to execute the Nand Flash emulation test.
+*
+* @param	None.
+*
+* @return
+*		- XST_SUCCESS if the test has completed successfully.
+*		- XST_FAILURE if the test has failed.
+*
+* @note		None.
+*
+*****************************************************************************/
+int main(void)
+{
+	int Status = XST_FAILURE;
+
+	xil_printf("Nand Flash Emulation Test\r\n");
+
+	Status = NandEmuTest();
+	if (Status != XST_SUCCESS) {
+		xil_printf("Nand Flash Emulation Test Failed\r\n");
+		goto Out;
+	}
+
+	Status = XST_SUCCESS;
+	xil_printf("Successfully ran Nand Flash Emulation Test\r\n");
+Out:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* This function initializes the driver on the modeled flash, writes the first
+* blocks of both LUNs and runs the read tests in DMA mode and in PIO mode.
+*
+* @param	None.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None.
+*
+****************************************************************************/
+s32 NandEmuTest(void)
+{
+	s32 Status = XST_FAILURE;
+	XNandPsu_Config Config;
+	u32 Page;
+	u32 Lun;
+
+	Nand_Init(&Model);
+	Status = Xil_EmuAddRegion(&Model.Region, "nand", NAND_BASEADDR,
+					NAND_REGS_SIZE, Model.Regs);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+	Xil_EmuSetHandlers(&Model.Region, Nand_Read, Nand_Write, &Model);
+
+	/* The host caches are coherent with the modeled DMA */
+	Config.DeviceId = 0U;
+	Config.BaseAddress = NAND_BASEADDR;
+	Config.IsCacheCoherent = 1U;
+	Status = XNandPsu_CfgInitialize(NandInstPtr, &Config,
+					Config.BaseAddress);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+	xil_printf("Flash: %d LUNs, read cache %d, read status enhanced %d, "
+		   "change read column enhanced %d\r\n",
+		   NandInstPtr->Geometry.NumLuns,
+		   NandInstPtr->Features.ReadCache,
+		   NandInstPtr->Features.RdStsEnh,
+		   NandInstPtr->Features.ChngRdColEnh);
+
+	/* Write the first blocks of both LUNs */
+	for (Lun = 0U; Lun < NAND_NUM_LUNS; Lun++) {
+		for (Page = 0U; Page < TEST_PAGES; Page++) {
+			NandEmu_Fill(&WriteBuffer[Page * NAND_PAGE_SIZE],
+					(Lun * NAND_LUN_PAGES) + Page);
+		}
+		Status = XNandPsu_Erase(NandInstPtr, Lun * TEST_LUN_OFFSET,
+					TEST_BUF_SIZE);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		Status = XNandPsu_Write(NandInstPtr, Lun * TEST_LUN_OFFSET,
+					TEST_BUF_SIZE, WriteBuffer);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+	}
+
+	xil_printf("DMA mode\r\n");
+	Status = NandEmu_TestReads();
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+	XNandPsu_DisableDmaMode(NandInstPtr);
+	xil_printf("PIO mode\r\n");
+	Status = NandEmu_TestReads();
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+
+	if (Model.Violations != 0U) {
+		xil_printf("%d protocol violations\r\n", Model.Violations);
+		Status = XST_FAILURE;
+	}
+Out:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads the blocks written in LUN 0 page by page and with the
+* read cache, and reads the pages of both LUNs alternately page by page and
+* with XNandPsu_ReadPages(), checking the data read.
+*
+* @param	None.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None.
+*
+****************************************************************************/
+static s32 NandEmu_TestReads(void)
+{
+	s32 Status = XST_FAILURE;
+	u64 Start;
+	u32 Page;
+	u32 Index;
+
+	for (Page = 0U; Page < TEST_PAGES; Page++) {
+		PageList[Page] = Page;
+	}
+
+	/* Sequential pages, page by page */
+	XNandPsu_DisableReadCache(NandInstPtr);
+	Start = Model.Now;
+	Status = XNandPsu_Read(NandInstPtr, 0U, TEST_BUF_SIZE, ReadBuffer);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+	Status = NandEmu_Check("Page by page read", PageList, TEST_PAGES,
+				Start);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+
+	/* Sequential pages, with the read cache */
+	XNandPsu_EnableReadCache(NandInstPtr);
+	Start = Model.Now;
+	Status = XNandPsu_Read(NandInstPtr, 0U, TEST_BUF_SIZE, ReadBuffer);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+	Status = NandEmu_Check("Read cache read", PageList, TEST_PAGES,
+				Start);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+
+	/* Pages of both LUNs alternately, page by page */
+	for (Page = 0U; Page < TEST_PAGES; Page++) {
+		PageList[2U * Page] = Page;
+		PageList[(2U * Page) + 1U] = NAND_LUN_PAGES + Page;
+	}
+	Start = Model.Now;
+	for (Index = 0U; Index < TEST_PAGES; Index++) {
+		Status = XNandPsu_Read(NandInstPtr,
+				(u64)PageList[Index] * NAND_PAGE_SIZE,
+				NAND_PAGE_SIZE,
+				&ReadBuffer[Index * NAND_PAGE_SIZE]);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+	}
+	Status = NandEmu_Check("Two LUN page by page read", PageList,
+				TEST_PAGES, Start);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+
+	/* Pages of both LUNs alternately, interleaved */
+	Start = Model.Now;
+	Status = XNandPsu_ReadPages(NandInstPtr, PageList, TEST_PAGES,
+					ReadBuffer);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+	Status = NandEmu_Check("Two LUN interleaved read", PageList,
+				TEST_PAGES, Start);
+Out:
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* This function checks the pages read to ReadBuffer and prints the time the
+* read took on the flash interface.
+*
+* @param	Name is the name of the read printed.
+* @param	Pages is the array of the pages read.
+* @param	NumPages is the number of pages read.
+* @param	Start is the time of the model when the read started.
+*
+* @return
+*		- XST_SUCCESS if the data read is correct.
+*		- XST_FAILURE if the data read is not correct.
+*
+* @note		None.
+*
+****************************************************************************/
+static s32 NandEmu_Check(const char *Name, const u32 *Pages, u32 NumPages,
+				u64 Start)
+{
+	u32 Time = (u32)((Model.Now - Start) / 1000U);
+	u32 Index;
+
+	for (Index = 0U; Index < NumPages; Index++) {
+		NandEmu_Fill(WriteBuffer, Pages[Index]);
+		if (memcmp(WriteBuffer, &ReadBuffer[Index * NAND_PAGE_SIZE],
+				NAND_PAGE_SIZE) != 0) {
+			xil_printf("%s: page %d differs\r\n", Name,
+					Pages[Index]);
+			return XST_FAILURE;
+		}
+	}
+	xil_printf("%s: %d pages in %d us, %d KB/s, %d violations\r\n",
+		   Name, NumPages, Time,
+		   (Time != 0U) ? (u32)(((u64)NumPages * NAND_PAGE_SIZE *
+					 1000000U) / ((u64)Time * 1024U)) : 0U,
+		   Model.Violations);
+
+	return (Model.Violations == 0U) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/****************************************************************************/
+/**
+*
+* This function fills a page buffer with the data written to a page.
+*
+* @param	Buf is the page buffer.
+* @param	Page is the page number.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void NandEmu_Fill(u8 *Buf, u32 Page)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < NAND_PAGE_SIZE; Index++) {
+		Buf[Index] = (u8)((Page * 7U) + (Index >> 2U) + (Index << 3U));
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function initializes the model with an erased flash and builds the
+* ONFI parameter page, advertising the Read Cache, Read Status Enhanced and
+* Change Read Column Enhanced commands.
+*
+* @param	Model is the model to initialize.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Nand_Init(NandModel *Model)
+{
+	OnfiParamPage *Param = (OnfiParamPage *)(void *)Model->ParamPage;
+	u32 Index;
+
+	memset(Model, 0, sizeof(*Model));
+	memset(Flash, 0xFF, sizeof(Flash));
+	for (Index = 0U; Index < NAND_NUM_LUNS; Index++) {
+		Model->Lun[Index].PageReg = NAND_NO_PAGE;
+		Model->Lun[Index].DataPage = NAND_NO_PAGE;
+	}
+
+	memcpy(Param->Signature, "ONFI", 4U);
+	Param->Revision = 0x1EU;
+	Param->OptionalCmds = (1U << 1) | (1U << 3) | (1U << 6);
+	Param->NumOfParamPages = ONFI_MND_PRM_PGS;
+	memcpy(Param->DeviceManufacturer, "EMULATED    ", 12U);
+	memcpy(Param->DeviceModel, "NAND MODEL          ", 20U);
+	Param->JedecManufacturerId = 0x01U;
+	Param->BytesPerPage = NAND_PAGE_SIZE;
+	Param->SpareBytesPerPage = NAND_SPARE_SIZE;
+	Param->PagesPerBlock = NAND_PAGES_PER_BLOCK;
+	Param->BlocksPerLun = NAND_BLOCKS_PER_LUN;
+	Param->NumLuns = NAND_NUM_LUNS;
+	Param->AddrCycles = (NAND_COL_CYCLES << 4U) | NAND_ROW_CYCLES;
+	Param->BitsPerCell = 1U;
+	Param->EccBits = 4U;
+	Param->TR = NAND_T_R / 1000U;
+	Param->Crc = (u16)XNandPsu_OnfiParamPageCrc(Model->ParamPage, 0U,
+							ONFI_CRC_LEN);
+	for (Index = 1U; Index < ONFI_MND_PRM_PGS; Index++) {
+		memcpy(&Model->ParamPage[Index * ONFI_PRM_PG_LEN],
+			Model->ParamPage, ONFI_PRM_PG_LEN);
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* Read handler of the controller model. The data port returns the data of
+* the PIO read in progress, the other registers return the register file.
+*
+* @param	CallBackRef is the model.
+* @param	Offset is the offset of the register read.
+* @param	RegsPtr is the register file of the controller.
+*
+* @return	The value read.
+*
+* @note		None.
+*
+****************************************************************************/
+static u32 Nand_Read(void *CallBackRef, u32 Offset, u32 *RegsPtr)
+{
+	NandModel *Model = (NandModel *)CallBackRef;
+	u32 Value;
+
+	if ((Offset != XNANDPSU_BUF_DATA_PORT_OFFSET) ||
+			(Model->XferPos >= Model->XferLen) ||
+			(Model->XferWrite != 0U)) {
+		return RegsPtr[Offset >> 2U];
+	}
+
+	memcpy(&Value, &Model->Xfer[Model->XferPos], 4U);
+	Model->XferPos += 4U;
+	if ((Model->XferPos % Model->PktLen) == 0U) {
+		if (Model->XferPos < Model->XferLen) {
+			RegsPtr[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_BUFF_RD_RDY_STS_EN_MASK;
+		} else {
+			RegsPtr[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK;
+		}
+	}
+
+	return Value;
+}
+
+/****************************************************************************/
+/**
+*
+* Write handler of the controller model. The interrupt status bits are write
+* one to clear, a write to the program register runs the operation and the
+* data port receives the data of the PIO page program in progress.
+*
+* @param	CallBackRef is the model.
+* @param	Offset is the offset of the register written.
+* @param	RegsPtr is the register file of the controller.
+* @param	Value is the value written.
+*
+* @return	The value held by the register after the write.
+*
+* @note		None.
+*
+****************************************************************************/
+static u32 Nand_Write(void *CallBackRef, u32 Offset, u32 *RegsPtr, u32 Value)
+{
+	NandModel *Model = (NandModel *)CallBackRef;
+
+	switch (Offset) {
+	case XNANDPSU_INTR_STS_OFFSET:
+		return RegsPtr[Offset >> 2U] & ~Value;
+	case XNANDPSU_PROG_OFFSET:
+		RegsPtr[Offset >> 2U] = Value;
+		Nand_Prog(Model, Value);
+		return 0U;
+	case XNANDPSU_BUF_DATA_PORT_OFFSET:
+		if ((Model->XferWrite == 0U) ||
+				(Model->XferPos >= Model->XferLen)) {
+			return Value;
+		}
+		memcpy(&Model->Xfer[Model->XferPos], &Value, 4U);
+		Model->XferPos += 4U;
+		if ((Model->XferPos % Model->PktLen) != 0U) {
+			return Value;
+		}
+		if (Model->XferPos < Model->XferLen) {
+			RegsPtr[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_BUFF_WR_RDY_STS_EN_MASK;
+		} else {
+			Model->XferWrite = 0U;
+			Nand_ProgramData(Model, Model->WrPage, Model->WrCol,
+					 Model->Xfer, Model->PktLen);
+			RegsPtr[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK;
+		}
+		return Value;
+	default:
+		return Value;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function runs the operation written to the program register, with the
+* commands, address and packets programmed in the other registers.
+*
+* Operations with a data phase wait for the LUN to be ready, as the
+* controller waits for the ready/busy signal, except the array reads started
+* by the Read Cache start and Multi Die Read operations which return while
+* the LUN is busy.
+*
+* @param	Model is the model.
+* @param	Prog is the value written to the program register.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Nand_Prog(NandModel *Model, u32 Prog)
+{
+	u32 CmdReg = Model->Regs[XNANDPSU_CMD_OFFSET >> 2U];
+	u32 PktReg = Model->Regs[XNANDPSU_PKT_OFFSET >> 2U];
+	u32 Cycles = (CmdReg & XNANDPSU_CMD_ADDR_CYCLES_MASK) >>
+			XNANDPSU_CMD_ADDR_CYCLES_SHIFT;
+	u32 Cmd1 = CmdReg & XNANDPSU_CMD_CMD1_MASK;
+	u32 Dma = (CmdReg & XNANDPSU_CMD_DMA_EN_MASK) != 0U;
+	u32 Cs = (Model->Regs[XNANDPSU_MEM_ADDR2_OFFSET >> 2U] &
+			XNANDPSU_MEM_ADDR2_CHIP_SEL_MASK) >>
+			XNANDPSU_MEM_ADDR2_CHIP_SEL_SHIFT;
+	u32 Row;
+	u32 Col;
+	u32 Lun;
+	u32 Index;
+	u8 Id[4];
+	u8 *Buf;
+	NandLun *LunPtr;
+
+	Model->PktSize = PktReg & XNANDPSU_PKT_PKT_SIZE_MASK;
+	Model->PktLen = (Model->PktSize + 3U) & ~3U;
+	Model->XferLen = Model->PktLen * ((PktReg &
+			XNANDPSU_PKT_PKT_CNT_MASK) >> XNANDPSU_PKT_PKT_CNT_SHIFT);
+	Model->XferPos = 0U;
+	Model->XferWrite = 0U;
+	Model->Now += NAND_T_OP + (NAND_T_CYCLE * (Cycles + 2U));
+	Nand_DecodeAddr(Model, Cycles, &Row, &Col);
+	if (Cs != 0U) {
+		Nand_Violation(Model, "Chip select of a missing target", Row);
+	}
+
+	switch (Prog) {
+	case XNANDPSU_PROG_RST_MASK:
+		for (Index = 0U; Index < NAND_NUM_LUNS; Index++) {
+			Model->Lun[Index].ReadyAt = Model->Now;
+			Model->Lun[Index].ArrayReadyAt = Model->Now;
+			Model->Lun[Index].PageReg = NAND_NO_PAGE;
+			Model->Lun[Index].DataPage = NAND_NO_PAGE;
+			Model->Lun[Index].CacheActive = 0U;
+		}
+		Model->Now += NAND_T_RST;
+		Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK;
+		break;
+
+	case XNANDPSU_PROG_RD_ID_MASK:
+		Nand_CheckIdle(Model);
+		if (Col == ONFI_READ_ID_ADDR) {
+			memcpy(Id, "ONFI", 4U);
+		} else {
+			Id[0] = 0x01U;
+			Id[1] = 0xDAU;
+			Id[2] = 0x90U;
+			Id[3] = 0x95U;
+		}
+		Nand_SendData(Model, Id, 4U);
+		break;
+
+	case XNANDPSU_PROG_RD_PRM_PG_MASK:
+		Nand_CheckIdle(Model);
+		Model->Now += NAND_T_R;
+		Nand_SendData(Model, Model->ParamPage,
+				sizeof(Model->ParamPage));
+		break;
+
+	case XNANDPSU_PROG_RD_STS_MASK:
+		/* Read Status returns the status of the last LUN selected */
+		for (Index = 0U; Index < NAND_NUM_LUNS; Index++) {
+			if ((Index != Model->LastLun) &&
+				(Model->Lun[Index].ReadyAt > Model->Now)) {
+				Nand_Violation(Model, "Read Status with "
+					"another LUN busy", Index);
+			}
+		}
+		Row = Model->LastLun * NAND_LUN_PAGES;
+		/* fallthrough */
+	case XNANDPSU_PROG_RD_STS_ENH_MASK:
+		Lun = (Row / NAND_LUN_PAGES) % NAND_NUM_LUNS;
+		LunPtr = &Model->Lun[Lun];
+		Model->LastLun = Lun;
+		Model->Regs[XNANDPSU_FLASH_STS_OFFSET >> 2U] = NAND_STS_WP_N |
+			((LunPtr->ReadyAt <= Model->Now) ? NAND_STS_RDY : 0U) |
+			((LunPtr->ArrayReadyAt <= Model->Now) ?
+							NAND_STS_ARDY : 0U);
+		Model->Now += NAND_T_CYCLE;
+		Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK;
+		break;
+
+	case XNANDPSU_PROG_RD_MASK:
+		if (Cmd1 != ONFI_CMD_RD1) {
+			Nand_Violation(Model, "Unexpected read command", Cmd1);
+		}
+		Lun = Nand_CheckLun(Model, Row, "Read Page");
+		LunPtr = &Model->Lun[Lun];
+		LunPtr->PageReg = NAND_NO_PAGE;
+		LunPtr->DataPage = Row;
+		LunPtr->ReadyAt = Model->Now + NAND_T_R;
+		LunPtr->ArrayReadyAt = LunPtr->ReadyAt;
+		Model->Now = LunPtr->ReadyAt;
+		Nand_ReadData(Model, Row, Col);
+		break;
+
+	case XNANDPSU_PROG_RD_CACHE_START_MASK:
+	case XNANDPSU_PROG_MUL_DIE_RD_MASK:
+		/* Array read without data phase, the LUN is left busy */
+		Lun = Nand_CheckLun(Model, Row, "Read Page");
+		LunPtr = &Model->Lun[Lun];
+		LunPtr->PageReg = Row;
+		LunPtr->DataPage = Row;
+		LunPtr->ReadyAt = Model->Now + NAND_T_R;
+		LunPtr->ArrayReadyAt = LunPtr->ReadyAt;
+		Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK;
+		break;
+
+	case XNANDPSU_PROG_RD_CACHE_SEQ_MASK:
+	case XNANDPSU_PROG_RD_CACHE_END_MASK:
+		/* The cache commands have no address, use the last LUN */
+		Lun = Model->LastLun;
+		LunPtr = &Model->Lun[Lun];
+		if (LunPtr->ReadyAt > Model->Now) {
+			Nand_Violation(Model, "Read Cache with LUN busy",
+					LunPtr->PageReg);
+		}
+		if (LunPtr->PageReg == NAND_NO_PAGE) {
+			Nand_Violation(Model, "Read Cache without page read",
+					Lun);
+			Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK;
+			break;
+		}
+		/* The page read moves to the cache register */
+		if (LunPtr->ArrayReadyAt > Model->Now) {
+			Model->Now = LunPtr->ArrayReadyAt;
+		}
+		LunPtr->DataPage = LunPtr->PageReg;
+		if (Prog == XNANDPSU_PROG_RD_CACHE_SEQ_MASK) {
+			if (Cmd1 != ONFI_CMD_RD_CACHE_SEQ) {
+				Nand_Violation(Model, "Unexpected read cache "
+					"command", Cmd1);
+			}
+			if (((LunPtr->PageReg + 1U) %
+				NAND_PAGES_PER_BLOCK) == 0U) {
+				Nand_Violation(Model, "Read Cache Sequential "
+					"at the end of a block",
+					LunPtr->PageReg);
+			}
+			LunPtr->PageReg++;
+			LunPtr->CacheActive = 1U;
+			LunPtr->ArrayReadyAt = Model->Now + NAND_T_RCBSY +
+						NAND_T_R;
+		} else {
+			if (Cmd1 != ONFI_CMD_RD_CACHE_END) {
+				Nand_Violation(Model, "Unexpected read cache "
+					"command", Cmd1);
+			}
+			LunPtr->PageReg = NAND_NO_PAGE;
+			LunPtr->CacheActive = 0U;
+			LunPtr->ArrayReadyAt = Model->Now + NAND_T_RCBSY;
+		}
+		LunPtr->ReadyAt = Model->Now + NAND_T_RCBSY;
+		Model->Now = LunPtr->ReadyAt;
+		Nand_ReadData(Model, LunPtr->DataPage, 0U);
+		break;
+
+	case XNANDPSU_PROG_CHNG_RD_COL_ENH_MASK:
+		Lun = (Row / NAND_LUN_PAGES) % NAND_NUM_LUNS;
+		LunPtr = &Model->Lun[Lun];
+		Model->LastLun = Lun;
+		if (LunPtr->ReadyAt > Model->Now) {
+			Nand_Violation(Model, "Change Read Column Enhanced "
+					"with LUN busy", Row);
+			Model->Now = LunPtr->ReadyAt;
+		}
+		if (LunPtr->DataPage != Row) {
+			Nand_Violation(Model, "Change Read Column Enhanced "
+					"for a page not read", Row);
+		}
+		LunPtr->PageReg = NAND_NO_PAGE;
+		Nand_ReadData(Model, LunPtr->DataPage, Col);
+		break;
+
+	case XNANDPSU_PROG_PG_PROG_MASK:
+		Lun = Nand_CheckLun(Model, Row, "Page Program");
+		Model->Lun[Lun].PageReg = NAND_NO_PAGE;
+		Model->Lun[Lun].DataPage = NAND_NO_PAGE;
+		Model->Now += NAND_T_PROG;
+		if (Dma != 0U) {
+			Buf = (u8 *)(UINTPTR)(((u64)Model->Regs[
+				XNANDPSU_DMA_SYS_ADDR1_OFFSET >> 2U] << 32U) |
+				Model->Regs[XNANDPSU_DMA_SYS_ADDR0_OFFSET >> 2U]);
+			Nand_ProgramData(Model, Row, Col, Buf,
+					 Model->PktSize);
+			Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK |
+				XNANDPSU_INTR_STS_DMA_INT_STS_EN_MASK;
+		} else {
+			Model->XferWrite = 1U;
+			Model->WrPage = Row;
+			Model->WrCol = Col;
+			Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_BUFF_WR_RDY_STS_EN_MASK;
+		}
+		break;
+
+	case XNANDPSU_PROG_BLK_ERASE_MASK:
+		Lun = Nand_CheckLun(Model, Row, "Block Erase");
+		Model->Lun[Lun].PageReg = NAND_NO_PAGE;
+		Model->Lun[Lun].DataPage = NAND_NO_PAGE;
+		if ((Row % NAND_PAGES_PER_BLOCK) == 0U) {
+			memset(Flash[Row], 0xFF, NAND_PAGES_PER_BLOCK *
+					NAND_RAW_PAGE_SIZE);
+		} else {
+			Nand_Violation(Model, "Block Erase of a page", Row);
+		}
+		Model->Now += NAND_T_BERS;
+		Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK;
+		break;
+
+	default:
+		Nand_Violation(Model, "Operation not modeled", Prog);
+		Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK;
+		break;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function decodes the address cycles sent from the memory address
+* registers, the bytes of the first register first.
+*
+* @param	Model is the model.
+* @param	Cycles is the number of address cycles.
+* @param	Row is the row address decoded, the target page.
+* @param	Col is the column address decoded.
+*
+* @return	None.
+*
+* @note		Operations without column address send the row address only,
+*		and the single address cycle of Read ID is returned as column.
+*
+****************************************************************************/
+static void Nand_DecodeAddr(const NandModel *Model, u32 Cycles, u32 *Row,
+				u32 *Col)
+{
+	u64 Addr = Model->Regs[XNANDPSU_MEM_ADDR1_OFFSET >> 2U] |
+		((u64)(Model->Regs[XNANDPSU_MEM_ADDR2_OFFSET >> 2U] &
+			XNANDPSU_MEM_ADDR2_MEM_ADDR_MASK) << 32U);
+
+	if (Cycles == (NAND_ROW_CYCLES + NAND_COL_CYCLES)) {
+		*Col = (u32)(Addr & 0xFFFFU);
+		*Row = (u32)((Addr >> 16U) & 0xFFFFFFU);
+	} else if (Cycles == NAND_ROW_CYCLES) {
+		*Col = 0U;
+		*Row = (u32)(Addr & 0xFFFFFFU);
+	} else {
+		*Col = (u32)(Addr & 0xFFU);
+		*Row = 0U;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function checks that an array operation is sent to a valid page of an
+* idle LUN, with no read cache in progress, and selects the LUN.
+*
+* @param	Model is the model.
+* @param	Page is the row address of the operation.
+* @param	Cmd is the name of the operation.
+*
+* @return	The LUN of the page.
+*
+* @note		None.
+*
+****************************************************************************/
+static u32 Nand_CheckLun(NandModel *Model, u32 Page, const char *Cmd)
+{
+	u32 Lun = (Page / NAND_LUN_PAGES) % NAND_NUM_LUNS;
+
+	if (Page >= NAND_NUM_PAGES) {
+		Nand_Violation(Model, Cmd, Page);
+	}
+	if (Model->Lun[Lun].ReadyAt > Model->Now) {
+		Nand_Violation(Model, "Operation with LUN busy", Page);
+		Model->Now = Model->Lun[Lun].ReadyAt;
+	}
+	Nand_CheckIdle(Model);
+	Model->LastLun = Lun;
+
+	return Lun;
+}
+
+/****************************************************************************/
+/**
+*
+* This function checks that no read cache is in progress, as only the read
+* cache and status commands are allowed until the Read Cache End command.
+*
+* @param	Model is the model.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Nand_CheckIdle(NandModel *Model)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < NAND_NUM_LUNS; Index++) {
+		if (Model->Lun[Index].CacheActive != 0U) {
+			Nand_Violation(Model, "Operation during read cache",
+					Index);
+			Model->Lun[Index].CacheActive = 0U;
+		}
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function starts the data phase of a page read, from the column given
+* to the end of the page and spare area.
+*
+* @param	Model is the model.
+* @param	Page is the page read.
+* @param	Col is the column of the first byte read.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Nand_ReadData(NandModel *Model, u32 Page, u32 Col)
+{
+	if ((Page >= NAND_NUM_PAGES) || (Col >= NAND_RAW_PAGE_SIZE)) {
+		Nand_Violation(Model, "Data read out of the flash", Page);
+		Page = 0U;
+		Col = 0U;
+	}
+	Nand_SendData(Model, &Flash[Page][Col], NAND_RAW_PAGE_SIZE - Col);
+}
+
+/****************************************************************************/
+/**
+*
+* This function transfers the data of a read, in the packets programmed. The
+* DMA writes the data to the buffer at the DMA system address. Otherwise the
+* data is read through the data port, the buffer read ready status being set
+* for each packet.
+*
+* @param	Model is the model.
+* @param	Data is the data read from the flash.
+* @param	Len is the number of bytes available, further bytes read
+*		return 0xFF.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Nand_SendData(NandModel *Model, const u8 *Data, u32 Len)
+{
+	u32 Dma = (Model->Regs[XNANDPSU_CMD_OFFSET >> 2U] &
+			XNANDPSU_CMD_DMA_EN_MASK) != 0U;
+	u32 Pos = 0U;
+	u32 Pkt;
+	u32 Size;
+	u8 *Buf;
+
+	if (Model->XferLen > NAND_MAX_XFER) {
+		Nand_Violation(Model, "Transfer too long", Model->XferLen);
+		Model->XferLen = 0U;
+	}
+	memset(Model->Xfer, 0xFF, sizeof(Model->Xfer));
+	for (Pkt = 0U; Pkt < Model->XferLen; Pkt += Model->PktLen) {
+		Size = (Len - Pos < Model->PktSize) ? Len - Pos :
+							Model->PktSize;
+		memcpy(&Model->Xfer[Pkt], &Data[Pos], Size);
+		Pos += Size;
+	}
+	Model->Now += (u64)Pos * NAND_T_BYTE;
+
+	if (Dma != 0U) {
+		Buf = (u8 *)(UINTPTR)(((u64)Model->Regs[
+			XNANDPSU_DMA_SYS_ADDR1_OFFSET >> 2U] << 32U) |
+			Model->Regs[XNANDPSU_DMA_SYS_ADDR0_OFFSET >> 2U]);
+		for (Pkt = 0U; Pkt < Model->XferLen; Pkt += Model->PktLen) {
+			memcpy(Buf, &Model->Xfer[Pkt], Model->PktSize);
+			Buf += Model->PktSize;
+		}
+		Model->XferLen = 0U;
+		Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK |
+				XNANDPSU_INTR_STS_DMA_INT_STS_EN_MASK;
+	} else if (Model->XferLen != 0U) {
+		Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_BUFF_RD_RDY_STS_EN_MASK;
+	} else {
+		Model->Regs[XNANDPSU_INTR_STS_OFFSET >> 2U] |=
+				XNANDPSU_INTR_STS_TRANS_COMP_STS_EN_MASK;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function programs data to a page, clearing the bits written as zero
+* like a flash program does.
+*
+* @param	Model is the model.
+* @param	Page is the page programmed.
+* @param	Col is the column of the first byte programmed.
+* @param	Data is the data programmed, in the packets programmed.
+* @param	Stride is the distance between the packets in Data, the
+*		packet size, or the packet size padded to words for PIO.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Nand_ProgramData(NandModel *Model, u32 Page, u32 Col,
+				const u8 *Data, u32 Stride)
+{
+	u32 Pkt;
+	u32 Index;
+	u32 Pos = Col;
+	const u8 *PktPtr = Data;
+
+	if (Page >= NAND_NUM_PAGES) {
+		Nand_Violation(Model, "Page Program out of the flash", Page);
+		return;
+	}
+	for (Pkt = 0U; Pkt < Model->XferLen; Pkt += Model->PktLen) {
+		for (Index = 0U; (Index < Model->PktSize) &&
+				(Pos < NAND_RAW_PAGE_SIZE); Index++) {
+			Flash[Page][Pos] &= PktPtr[Index];
+			Pos++;
+		}
+		PktPtr += Stride;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function reports a protocol violation.
+*
+* @param	Model is the model.
+* @param	Msg is the description of the violation.
+* @param	Page is a page or value printed with the description.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Nand_Violation(NandModel *Model, const char *Msg, u32 Page)
+{
+	if (Model->Violations < NAND_MAX_LOGS) {
+		xil_printf("Violation at %d us: %s (0x%x)\r\n",
+			   (u32)(Model->Now / 1000U), Msg, Page);
+	}
+	Model->Violations++;
+}
@@ -192,6 +192,7 @@
 *                       four LSBs of the CS Gain.
 *       cog    10/05/20 Change shutdown end state for Gen 3 Quad ADCs to reduce power
 *                       consumption.
+*       cog    11/16/20 Invalidate the PLL register shadow on initialization.
 *
 * </pre>
 *
@@ -599,6 +600,7 @@ static void XRFdc_UpdatePLLStruct(XRFdc *InstancePtr, u32 Type, u32 Tile_Id)
 			InstancePtr->RFdc_Config.ADCTile_Config[Tile_Id].OutputDiv;
 		InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.RefClkDivider =
 			InstancePtr->RFdc_Config.ADCTile_Config[Tile_Id].RefClkDiv;
+		InstancePtr->ADC_Tile[Tile_Id].PLL_Solution.FeedbackDivider = 0x0U;
 	} else {
 		InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.SampleRate =
 			InstancePtr->RFdc_Config.DACTile_Config[Tile_Id].SamplingRate;
@@ -612,6 +614,7 @@ static void XRFdc_UpdatePLLStruct(XRFdc *InstancePtr, u32 Type, u32 Tile_Id)
 			InstancePtr->RFdc_Config.DACTile_Config[Tile_Id].OutputDiv;
 		InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.RefClkDivider =
 			InstancePtr->RFdc_Config.DACTile_Config[Tile_Id].RefClkDiv;
+		InstancePtr->DAC_Tile[Tile_Id].PLL_Solution.FeedbackDivider = 0x0U;
 	}
 }
 
@@ -259,6 +259,10 @@
 *       cog    10/05/20 Change shutdown end state for Gen 3 Quad ADCs to reduce power
 *                       consumption.
 *       cog    10/14/20 Get I and Q data now supports warm bitstream swap.
+*       cog    11/16/20 Added XRFdc_CalcPLLSolution() and XRFdc_ApplyPLLSolution()
+*                       for retuning the PLL from precomputed settings.
+*       cog    11/16/20 Added XRFdc_CompileNCOHop() and XRFdc_CommitNCOHop() for
+*                       multi-block NCO frequency hopping.
 *
 * </pre>
 *
@@ -336,6 +340,22 @@ typedef struct {
 	u64 FractionalData; /* Fractional data is currently not supported */
 	u32 FractWidth; /* Fractional width is currently not supported */
 } XRFdc_PLL_Settings;
+/**
+ * Precomputed PLL solution, see XRFdc_CalcPLLSolution().
+ */
+typedef struct {
+	u32 Type; /* ADC or DAC tile the solution was computed for */
+	double RefClkFreq; /* Reference clock frequency in MHz */
+	double SampleRate; /* Requested sampling rate in MHz */
+	double CalcSampleRate; /* Achieved sampling rate in GHz */
+	u32 RefClkDivider;
+	u32 FeedbackDivider;
+	u32 OutputDivider;
+	u16 Divider0; /* PLL output divider register value */
+	u16 Spare0; /* PLL spare inputs LSB register value */
+	u16 LoopFilter0; /* PLL loop filter LSB register value */
+	u16 ChargePump; /* PLL charge pump register value */
+} XRFdc_PLL_Solution;
 /**
 * ClkIntraTile Settings.
 */
@@ -420,6 +440,44 @@ typedef struct {
 	u8 MixerType;
 } XRFdc_Mixer_Settings;
 
+/**
+ * NCO settings of one block for a frequency hop, see XRFdc_CompileNCOHop().
+ */
+typedef struct {
+	u32 Type; /* ADC or DAC */
+	u32 Tile_Id;
+	u32 Block_Id;
+	double Freq; /* NCO frequency in MHz */
+	double PhaseOffset; /* NCO phase offset in degrees */
+} XRFdc_NCO_Hop_Block;
+
+/**
+ * NCO register image of one converter block in a compiled hop.
+ */
+typedef struct {
+	u32 BaseAddr;
+	u32 Type;
+	u32 Tile_Id;
+	u32 Block_Id; /* Physical block the registers belong to */
+	double Freq;
+	double PhaseOffset;
+	u16 FreqWord[3]; /* NCO frequency word low, mid and upper */
+	u16 PhaseWord[2]; /* NCO phase offset low and upper */
+} XRFdc_NCO_Hop_Regs;
+
+/* Maximum number of converter blocks in one compiled hop */
+#define XRFDC_NCO_HOP_MAX_BLOCKS 32U
+
+/**
+ * Compiled NCO frequency hop, see XRFdc_CompileNCOHop().
+ */
+typedef struct {
+	u32 EventSource; /* XRFDC_EVNT_SRC_TILE or XRFDC_EVNT_SRC_SYSREF */
+	u32 TileMask; /* ADC tiles in bits 0-3, DAC tiles in bits 4-7 */
+	u32 NumRegs;
+	XRFdc_NCO_Hop_Regs Regs[XRFDC_NCO_HOP_MAX_BLOCKS];
+} XRFdc_NCO_Hop;
+
 /**
  * ADC block Threshold settings.
  */
@@ -673,6 +731,7 @@ typedef struct {
 	u32 TileBaseAddr; /* Tile  BaseAddress*/
 	u32 NumOfDACBlocks; /* Number of DAC block enabled */
 	XRFdc_PLL_Settings PLL_Settings;
+	XRFdc_PLL_Solution PLL_Solution; /* PLL registers last written by the driver */
 	u8 MultibandConfig;
 	XRFdc_DACBlock_AnalogDataPath DACBlock_Analog_Datapath[4];
 	XRFdc_DACBlock_DigitalDataPath DACBlock_Digital_Datapath[4];
@@ -685,6 +744,7 @@ typedef struct {
 	u32 TileBaseAddr;
 	u32 NumOfADCBlocks; /* Number of ADC block enabled */
 	XRFdc_PLL_Settings PLL_Settings;
+	XRFdc_PLL_Solution PLL_Solution; /* PLL registers last written by the driver */
 	u8 MultibandConfig;
 	XRFdc_ADCBlock_AnalogDataPath ADCBlock_Analog_Datapath[4];
 	XRFdc_ADCBlock_DigitalDataPath ADCBlock_Digital_Datapath[4];
@@ -2055,6 +2115,9 @@ u32 XRFdc_SetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_
 			   XRFdc_Mixer_Settings *MixerSettingsPtr);
 u32 XRFdc_GetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
 			   XRFdc_Mixer_Settings *MixerSettingsPtr);
+u32 XRFdc_CompileNCOHop(XRFdc *InstancePtr, const XRFdc_NCO_Hop_Block *BlocksPtr, u32 NumBlocks, u32 EventSource,
+			XRFdc_NCO_Hop *HopPtr);
+u32 XRFdc_CommitNCOHop(XRFdc *InstancePtr, const XRFdc_NCO_Hop *HopPtr);
 u32 XRFdc_SetQMCSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, XRFdc_QMC_Settings *QMCSettingsPtr);
 u32 XRFdc_GetQMCSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, XRFdc_QMC_Settings *QMCSettingsPtr);
 u32 XRFdc_GetCoarseDelaySettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
@@ -2114,6 +2177,9 @@ u32 XRFdc_GetPLLLockStatus(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 *LockS
 u32 XRFdc_GetPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, XRFdc_PLL_Settings *PLLSettings);
 u32 XRFdc_DynamicPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u8 Source, double RefClkFreq,
 			   double SamplingRate);
+u32 XRFdc_CalcPLLSolution(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double RefClkFreq, double SamplingRate,
+			  XRFdc_PLL_Solution *SolutionPtr);
+u32 XRFdc_ApplyPLLSolution(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, const XRFdc_PLL_Solution *SolutionPtr);
 u32 XRFdc_SetInvSincFIR(XRFdc *InstancePtr, u32 Tile_Id, u32 Block_Id, u16 Mode);
 u32 XRFdc_GetInvSincFIR(XRFdc *InstancePtr, u32 Tile_Id, u32 Block_Id, u16 *ModePtr);
 u32 XRFdc_GetLinkCoupling(XRFdc *InstancePtr, u32 Tile_Id, u32 Block_Id, u32 *ModePtr);
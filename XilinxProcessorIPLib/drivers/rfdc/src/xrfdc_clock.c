@@ -52,6 +52,11 @@
 *                       PLL must be used if using ADC0, ADC3, DAC0 or DAC3 as a
 *                       clock source.
 *                       PLL must be used if distributing from DAC to ADC.
+*       cog    11/16/20 Write the PLL registers once after the divider search
+*                       instead of on every search iteration.
+*       cog    11/16/20 Added XRFdc_CalcPLLSolution() and XRFdc_ApplyPLLSolution()
+*                       to retune from precomputed PLL settings, writing only
+*                       the PLL registers that change.
 * </pre>
 *
 ******************************************************************************/
@@ -75,7 +80,8 @@ static u32 PllTuningMatrix[8][4][2] = {
 
 /***************** Macros (Inline Functions) Definitions *********************/
 static u32 XRFdc_CheckClkDistValid(XRFdc *InstancePtr, XRFdc_Distribution_Settings *DistributionSettingsPtr);
-static u32 XRFdc_SetPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double RefClkFreq, double SamplingRate);
+static u32 XRFdc_SetPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double RefClkFreq, double SamplingRate,
+			      const XRFdc_PLL_Solution *SolutionPtr);
 
 /************************** Function Prototypes ******************************/
 
@@ -1199,64 +1205,38 @@ RETURN_PATH:
 /*****************************************************************************/
 /**
 *
-* This function used for configuring the internal PLL registers
-* based on reference clock and sampling rate
+* This function reads the reference clock divider of the tile PLL.
 *
 * @param    InstancePtr is a pointer to the XRfdc instance.
 * @param    Type indicates ADC/DAC.
 * @param    Tile_Id indicates Tile number (0-3).
-* @param    RefClkFreq Reference Clock Frequency MHz(50MHz - 1.2GHz)
-* @param    SamplingRate Sampling Rate in MHz(0.5- 4 GHz)
+* @param    RefClkDivPtr pointer to return the reference clock divider.
 *
 * @return
 *           - XRFDC_SUCCESS if successful.
-*           - XRFDC_FAILURE if error occurs.
+*           - XRFDC_FAILURE if the divider value is not supported.
 *
-* @note     None.
+* @note     Static API.
 *
 ******************************************************************************/
-static u32 XRFdc_SetPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double RefClkFreq, double SamplingRate)
+static u32 XRFdc_GetPLLRefClkDiv(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 *RefClkDivPtr)
 {
-	u32 BaseAddr;
 	u32 Status;
-	u32 FeedbackDiv;
-	u32 OutputDiv;
-	double CalcSamplingRate;
-	double PllFreq;
-	double SamplingError;
-	u32 Best_FeedbackDiv = 0x0U;
-	u32 Best_OutputDiv = 0x2U;
-	double Best_Error = 0xFFFFFFFFU;
-	u32 DivideMode = 0x0U;
-	u32 DivideValue = 0x0U;
-	u32 PllFreqIndex = 0x0U;
-	u32 FbDivIndex = 0x0U;
-	u32 RefClkDiv = 0x1;
 	u16 ReadReg;
-	u32 VCOMin;
-	u32 VCOMax;
-
-	if (Type == XRFDC_ADC_TILE) {
-		BaseAddr = XRFDC_ADC_TILE_DRP_ADDR(Tile_Id);
-	} else {
-		BaseAddr = XRFDC_DAC_TILE_DRP_ADDR(Tile_Id);
-	}
-
-	BaseAddr += XRFDC_HSCOM_ADDR;
 
-	ReadReg = XRFdc_ReadReg16(InstancePtr, BaseAddr, XRFDC_PLL_REFDIV);
+	ReadReg = XRFdc_ReadReg16(InstancePtr, XRFDC_DRP_BASE(Type, Tile_Id) + XRFDC_HSCOM_ADDR, XRFDC_PLL_REFDIV);
 	if (ReadReg & XRFDC_REFCLK_DIV_1_MASK) {
-		RefClkDiv = XRFDC_REF_CLK_DIV_1;
+		*RefClkDivPtr = XRFDC_REF_CLK_DIV_1;
 	} else {
 		switch (ReadReg & XRFDC_REFCLK_DIV_MASK) {
 		case XRFDC_REFCLK_DIV_2_MASK:
-			RefClkDiv = XRFDC_REF_CLK_DIV_2;
+			*RefClkDivPtr = XRFDC_REF_CLK_DIV_2;
 			break;
 		case XRFDC_REFCLK_DIV_3_MASK:
-			RefClkDiv = XRFDC_REF_CLK_DIV_3;
+			*RefClkDivPtr = XRFDC_REF_CLK_DIV_3;
 			break;
 		case XRFDC_REFCLK_DIV_4_MASK:
-			RefClkDiv = XRFDC_REF_CLK_DIV_4;
+			*RefClkDivPtr = XRFDC_REF_CLK_DIV_4;
 			break;
 		default:
 			/*
@@ -1267,11 +1247,55 @@ static u32 XRFdc_SetPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double
 				  "\n Unsupported Reference clock Divider value (%u) for %s %u in %s\r\n",
 				  (ReadReg & XRFDC_REFCLK_DIV_MASK), (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id,
 				  __func__);
-			return XRFDC_FAILURE;
+			Status = XRFDC_FAILURE;
+			goto RETURN_PATH;
 		}
 	}
 
-	RefClkFreq /= RefClkDiv;
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function searches the feedback and output divider values that give
+* the sampling rate closest to the requested one and derives the PLL
+* register values for them.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type indicates ADC/DAC.
+* @param    RefClkFreq Reference Clock Frequency in MHz after the reference
+*           clock divider.
+* @param    SamplingRate Sampling Rate in MHz.
+* @param    SolutionPtr pointer to return the dividers, the register values
+*           and the achieved sampling rate.
+*
+* @return   None
+*
+* @note     Static API.
+*
+******************************************************************************/
+static void XRFdc_CalcPLLDividers(XRFdc *InstancePtr, u32 Type, double RefClkFreq, double SamplingRate,
+				  XRFdc_PLL_Solution *SolutionPtr)
+{
+	u32 FeedbackDiv;
+	u32 OutputDiv;
+	double CalcSamplingRate;
+	double PllFreq;
+	double SamplingError;
+	u32 Best_FeedbackDiv = 0x0U;
+	u32 Best_OutputDiv = 0x2U;
+	double Best_Error = 0xFFFFFFFFU;
+	u32 DivideMode = 0x0U;
+	u32 DivideValue = 0x0U;
+	u32 PllFreqIndex = 0x0U;
+	u32 FbDivIndex = 0x0U;
+	u16 Divider0;
+	u16 Spare0;
+	u32 VCOMin;
+	u32 VCOMax;
 
 	/*
 	 * Sweep valid integer values of FeedbackDiv(N) and record a list
@@ -1346,7 +1370,160 @@ static u32 XRFdc_SetPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double
 				Best_Error = SamplingError;
 			}
 		}
+	}
+
+	/*
+	 * Output divisor value
+	 */
+	if (Best_OutputDiv == 1U) {
+		DivideMode = 0x0U;
+		/*if divisor is 1 bypass toatally*/
+		DivideValue = XRFDC_PLL_DIVIDER0_BYP_OPDIV_MASK;
+	} else if (Best_OutputDiv == 2U) {
+		DivideMode = 0x1U;
+	} else if (Best_OutputDiv == 3U) {
+		DivideMode = 0x2U;
+		DivideValue = 0x1U;
+	} else if (Best_OutputDiv >= 4U) {
+		DivideMode = 0x3U;
+		DivideValue = ((Best_OutputDiv - 4U) / 2U);
+	}
+
+	Divider0 = (u16)((DivideMode << XRFDC_PLL_DIVIDER0_SHIFT) | DivideValue) & XRFDC_PLL_DIVIDER0_MASK;
+	if (InstancePtr->RFdc_Config.IPType >= XRFDC_GEN3) {
+		Divider0 &= (u16)~XRFDC_PLL_DIVIDER0_ALT_MASK;
+		if (Best_OutputDiv <= PLL_DIVIDER_MIN_GEN3) {
+			Divider0 |= XRFDC_PLL_DIVIDER0_BYPDIV_MASK;
+		}
+	}
+
+	/*
+	 * Default PLL spare inputs LSB
+	 */
+	if (InstancePtr->RFdc_Config.IPType < XRFDC_GEN3) {
+		Spare0 = 0x507U;
+	} else {
+		Spare0 = 0x0D37U;
+	}
+
+	PllFreq = RefClkFreq * Best_FeedbackDiv;
+
+	if (PllFreq < 9400U) {
+		PllFreqIndex = 0U;
+		FbDivIndex = 2U;
+		if (Best_FeedbackDiv < 21U) {
+			FbDivIndex = 0U;
+		} else if (Best_FeedbackDiv < 30U) {
+			FbDivIndex = 1U;
+		}
+	} else if (PllFreq < 10070U) {
+		PllFreqIndex = 1U;
+		FbDivIndex = 2U;
+		if (Best_FeedbackDiv < 18U) {
+			FbDivIndex = 0U;
+		} else if (Best_FeedbackDiv < 30U) {
+			FbDivIndex = 1U;
+		}
+	} else if (PllFreq < 10690U) {
+		PllFreqIndex = 2U;
+		FbDivIndex = 3U;
+		if (Best_FeedbackDiv < 18U) {
+			FbDivIndex = 0U;
+		} else if (Best_FeedbackDiv < 25U) {
+			FbDivIndex = 1U;
+		} else if (Best_FeedbackDiv < 35U) {
+			FbDivIndex = 2U;
+		}
+	} else if (PllFreq < 10990U) {
+		PllFreqIndex = 3U;
+		FbDivIndex = 3U;
+		if (Best_FeedbackDiv < 19U) {
+			FbDivIndex = 0U;
+		} else if (Best_FeedbackDiv < 27U) {
+			FbDivIndex = 1U;
+		} else if (Best_FeedbackDiv < 38U) {
+			FbDivIndex = 2U;
+		}
+	} else if (PllFreq < 11430U) {
+		PllFreqIndex = 4U;
+		FbDivIndex = 3U;
+		if (Best_FeedbackDiv < 19U) {
+			FbDivIndex = 0U;
+		} else if (Best_FeedbackDiv < 27U) {
+			FbDivIndex = 1U;
+		} else if (Best_FeedbackDiv < 38U) {
+			FbDivIndex = 2U;
+		}
+	} else if (PllFreq < 12040U) {
+		PllFreqIndex = 5U;
+		FbDivIndex = 3U;
+		if (Best_FeedbackDiv < 20U) {
+			FbDivIndex = 0U;
+		} else if (Best_FeedbackDiv < 28U) {
+			FbDivIndex = 1U;
+		} else if (Best_FeedbackDiv < 40U) {
+			FbDivIndex = 2U;
+		}
+	} else if (PllFreq < 12530U) {
+		PllFreqIndex = 6U;
+		FbDivIndex = 3U;
+		if (Best_FeedbackDiv < 23U) {
+			FbDivIndex = 0U;
+		} else if (Best_FeedbackDiv < 30U) {
+			FbDivIndex = 1U;
+		} else if (Best_FeedbackDiv < 42U) {
+			FbDivIndex = 2U;
+		}
+	} else if (PllFreq < 20000U) {
+		PllFreqIndex = 7U;
+		FbDivIndex = 2U;
+		if (Best_FeedbackDiv < 20U) {
+			FbDivIndex = 0U;
+			/*
+			 * PLL spare inputs LSB
+			 */
+			if (InstancePtr->RFdc_Config.IPType < XRFDC_GEN3) {
+				Spare0 = 0x577U;
+			}
+		} else if (Best_FeedbackDiv < 39U) {
+			FbDivIndex = 1U;
+		}
+	}
+
+	CalcSamplingRate = (Best_FeedbackDiv * RefClkFreq) / Best_OutputDiv;
+	CalcSamplingRate /= XRFDC_MILLI;
+
+	SolutionPtr->CalcSampleRate = CalcSamplingRate;
+	SolutionPtr->FeedbackDivider = Best_FeedbackDiv;
+	SolutionPtr->OutputDivider = Best_OutputDiv;
+	SolutionPtr->Divider0 = Divider0;
+	SolutionPtr->Spare0 = Spare0;
+	SolutionPtr->LoopFilter0 = (u16)PllTuningMatrix[PllFreqIndex][FbDivIndex][0];
+	SolutionPtr->ChargePump = (u16)PllTuningMatrix[PllFreqIndex][FbDivIndex][1];
+}
 
+/*****************************************************************************/
+/**
+*
+* This function writes a PLL solution to the PLL registers of a tile.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    BaseAddr is the address of the HSCOM block of the tile.
+* @param    SolutionPtr pointer to the PLL solution to be written.
+* @param    CurrentPtr pointer to the PLL solution the tile is programmed
+*           with, or NULL if it is not known.
+*
+* @return   None
+*
+* @note     Static API. If CurrentPtr is not NULL the static configuration is
+*           already in place and only the registers that differ from
+*           CurrentPtr are written.
+*
+******************************************************************************/
+static void XRFdc_WritePLLSolution(XRFdc *InstancePtr, u32 BaseAddr, const XRFdc_PLL_Solution *SolutionPtr,
+				   const XRFdc_PLL_Solution *CurrentPtr)
+{
+	if (CurrentPtr == NULL) {
 		/*
 		 * PLL Static configuration
 		 */
@@ -1362,53 +1539,29 @@ static u32 XRFdc_SetPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double
 			XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_VREG, 0x2DU);
 			XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_VCO0, 0x5F03U);
 		}
-		/*
-		 * Set Feedback divisor value
-		 */
-		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_FPDIV, Best_FeedbackDiv - 2U);
+	}
 
-		/*
-		 * Set Output divisor value
-		 */
-		if (Best_OutputDiv == 1U) {
-			DivideMode = 0x0U;
-			/*if divisor is 1 bypass toatally*/
-			DivideValue = XRFDC_PLL_DIVIDER0_BYP_OPDIV_MASK;
-		} else if (Best_OutputDiv == 2U) {
-			DivideMode = 0x1U;
-		} else if (Best_OutputDiv == 3U) {
-			DivideMode = 0x2U;
-			DivideValue = 0x1U;
-		} else if (Best_OutputDiv >= 4U) {
-			DivideMode = 0x3U;
-			DivideValue = ((Best_OutputDiv - 4U) / 2U);
-		}
+	/*
+	 * Set Feedback divisor value
+	 */
+	if ((CurrentPtr == NULL) || (CurrentPtr->FeedbackDivider != SolutionPtr->FeedbackDivider)) {
+		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_FPDIV, SolutionPtr->FeedbackDivider - 2U);
+	}
 
+	/*
+	 * Set Output divisor value
+	 */
+	if ((CurrentPtr == NULL) || (CurrentPtr->Divider0 != SolutionPtr->Divider0)) {
 		XRFdc_ClrSetReg(InstancePtr, BaseAddr, XRFDC_PLL_DIVIDER0, XRFDC_PLL_DIVIDER0_MASK,
-				((DivideMode << XRFDC_PLL_DIVIDER0_SHIFT) | DivideValue));
+				SolutionPtr->Divider0);
+	}
 
-		if (InstancePtr->RFdc_Config.IPType >= XRFDC_GEN3) {
-			if (Best_OutputDiv > PLL_DIVIDER_MIN_GEN3) {
-				XRFdc_ClrSetReg(InstancePtr, BaseAddr, XRFDC_PLL_DIVIDER0, XRFDC_PLL_DIVIDER0_ALT_MASK,
-						XRFDC_DISABLED);
-			} else {
-				XRFdc_ClrSetReg(InstancePtr, BaseAddr, XRFDC_PLL_DIVIDER0, XRFDC_PLL_DIVIDER0_ALT_MASK,
-						XRFDC_PLL_DIVIDER0_BYPDIV_MASK);
-			}
-		}
+	if (CurrentPtr == NULL) {
 		/*
 		 * Enable fine sweep
 		 */
 		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_CRS2, XRFDC_PLL_CRS2_VAL);
 
-		/*
-		 * Set default PLL spare inputs LSB
-		 */
-		if (InstancePtr->RFdc_Config.IPType < XRFDC_GEN3) {
-			XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_SPARE0, 0x507U);
-		} else {
-			XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_SPARE0, 0x0D37U);
-		}
 		/*
 		 * Set PLL spare inputs MSB
 		 */
@@ -1417,135 +1570,131 @@ static u32 XRFdc_SetPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double
 		} else {
 			XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_SPARE1, 0x80U);
 		}
-		PllFreq = RefClkFreq * Best_FeedbackDiv;
+	}
 
-		if (PllFreq < 9400U) {
-			PllFreqIndex = 0U;
-			FbDivIndex = 2U;
-			if (Best_FeedbackDiv < 21U) {
-				FbDivIndex = 0U;
-			} else if (Best_FeedbackDiv < 30U) {
-				FbDivIndex = 1U;
-			}
-		} else if (PllFreq < 10070U) {
-			PllFreqIndex = 1U;
-			FbDivIndex = 2U;
-			if (Best_FeedbackDiv < 18U) {
-				FbDivIndex = 0U;
-			} else if (Best_FeedbackDiv < 30U) {
-				FbDivIndex = 1U;
-			}
-		} else if (PllFreq < 10690U) {
-			PllFreqIndex = 2U;
-			FbDivIndex = 3U;
-			if (Best_FeedbackDiv < 18U) {
-				FbDivIndex = 0U;
-			} else if (Best_FeedbackDiv < 25U) {
-				FbDivIndex = 1U;
-			} else if (Best_FeedbackDiv < 35U) {
-				FbDivIndex = 2U;
-			}
-		} else if (PllFreq < 10990U) {
-			PllFreqIndex = 3U;
-			FbDivIndex = 3U;
-			if (Best_FeedbackDiv < 19U) {
-				FbDivIndex = 0U;
-			} else if (Best_FeedbackDiv < 27U) {
-				FbDivIndex = 1U;
-			} else if (Best_FeedbackDiv < 38U) {
-				FbDivIndex = 2U;
-			}
-		} else if (PllFreq < 11430U) {
-			PllFreqIndex = 4U;
-			FbDivIndex = 3U;
-			if (Best_FeedbackDiv < 19U) {
-				FbDivIndex = 0U;
-			} else if (Best_FeedbackDiv < 27U) {
-				FbDivIndex = 1U;
-			} else if (Best_FeedbackDiv < 38U) {
-				FbDivIndex = 2U;
-			}
-		} else if (PllFreq < 12040U) {
-			PllFreqIndex = 5U;
-			FbDivIndex = 3U;
-			if (Best_FeedbackDiv < 20U) {
-				FbDivIndex = 0U;
-			} else if (Best_FeedbackDiv < 28U) {
-				FbDivIndex = 1U;
-			} else if (Best_FeedbackDiv < 40U) {
-				FbDivIndex = 2U;
-			}
-		} else if (PllFreq < 12530U) {
-			PllFreqIndex = 6U;
-			FbDivIndex = 3U;
-			if (Best_FeedbackDiv < 23U) {
-				FbDivIndex = 0U;
-			} else if (Best_FeedbackDiv < 30U) {
-				FbDivIndex = 1U;
-			} else if (Best_FeedbackDiv < 42U) {
-				FbDivIndex = 2U;
-			}
-		} else if (PllFreq < 20000U) {
-			PllFreqIndex = 7U;
-			FbDivIndex = 2U;
-			if (Best_FeedbackDiv < 20U) {
-				FbDivIndex = 0U;
-				/*
-				 * Set PLL spare inputs LSB
-				 */
-				if (InstancePtr->RFdc_Config.IPType < XRFDC_GEN3) {
-					XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_SPARE0, 0x577);
-				} else {
-					XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_SPARE0, 0x0D37U);
-				}
-			} else if (Best_FeedbackDiv < 39U) {
-				FbDivIndex = 1U;
-			}
-		}
+	/*
+	 * Set PLL spare inputs LSB
+	 */
+	if ((CurrentPtr == NULL) || (CurrentPtr->Spare0 != SolutionPtr->Spare0)) {
+		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_SPARE0, SolutionPtr->Spare0);
+	}
 
+	if (CurrentPtr == NULL) {
 		/*
 		 * Enable automatic selection of the VCO, this will work with the
 		 * IP version 2.0.1 and above and using older version of IP is
 		 * not likely to work.
 		 */
-
 		XRFdc_ClrSetReg(InstancePtr, BaseAddr, XRFDC_PLL_CRS1, XRFDC_PLL_VCO_SEL_AUTO_MASK,
 				XRFDC_PLL_VCO_SEL_AUTO_MASK);
 
-		/*
-		 * PLL bits for loop filters LSB
-		 */
-		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_LPF0, PllTuningMatrix[PllFreqIndex][FbDivIndex][0]);
-
 		/*
 		 * PLL bits for loop filters MSB
 		 */
 		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_LPF1, XRFDC_PLL_LPF1_VAL);
+	}
 
-		/*
-		 * Set PLL bits for charge pumps
-		 */
-		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_CHARGEPUMP,
-				 PllTuningMatrix[PllFreqIndex][FbDivIndex][1]);
+	/*
+	 * PLL bits for loop filters LSB
+	 */
+	if ((CurrentPtr == NULL) || (CurrentPtr->LoopFilter0 != SolutionPtr->LoopFilter0)) {
+		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_LPF0, SolutionPtr->LoopFilter0);
 	}
 
-	CalcSamplingRate = (Best_FeedbackDiv * RefClkFreq) / Best_OutputDiv;
-	CalcSamplingRate /= XRFDC_MILLI;
+	/*
+	 * Set PLL bits for charge pumps
+	 */
+	if ((CurrentPtr == NULL) || (CurrentPtr->ChargePump != SolutionPtr->ChargePump)) {
+		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_PLL_CHARGEPUMP, SolutionPtr->ChargePump);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function used for configuring the internal PLL registers
+* based on reference clock and sampling rate
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type indicates ADC/DAC.
+* @param    Tile_Id indicates Tile number (0-3).
+* @param    RefClkFreq Reference Clock Frequency MHz(50MHz - 1.2GHz)
+* @param    SamplingRate Sampling Rate in MHz(0.5- 4 GHz)
+* @param    SolutionPtr pointer to a PLL solution from
+*           XRFdc_CalcPLLSolution(), or NULL to compute it here.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     When a precomputed solution is given and the tile PLL still holds
+*           the solution last written by the driver, only the registers that
+*           differ between the two solutions are written.
+*
+******************************************************************************/
+static u32 XRFdc_SetPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double RefClkFreq, double SamplingRate,
+			      const XRFdc_PLL_Solution *SolutionPtr)
+{
+	u32 BaseAddr;
+	u32 Status;
+	u32 RefClkDiv = 0x1;
+	XRFdc_PLL_Solution Solution;
+	XRFdc_PLL_Solution *CurrentPtr = NULL;
+	XRFdc_PLL_Solution *ShadowPtr;
+	XRFdc_PLL_Settings *PLLSettingsPtr;
+
+	BaseAddr = XRFDC_DRP_BASE(Type, Tile_Id) + XRFDC_HSCOM_ADDR;
 
 	if (Type == XRFDC_ADC_TILE) {
-		InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.SampleRate = CalcSamplingRate;
-		InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.RefClkDivider = RefClkDiv;
-		InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.FeedbackDivider = Best_FeedbackDiv;
-		InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.OutputDivider = Best_OutputDiv;
+		ShadowPtr = &InstancePtr->ADC_Tile[Tile_Id].PLL_Solution;
+		PLLSettingsPtr = &InstancePtr->ADC_Tile[Tile_Id].PLL_Settings;
 	} else {
-		InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.SampleRate = CalcSamplingRate;
-		InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.RefClkDivider = RefClkDiv;
-		InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.FeedbackDivider = Best_FeedbackDiv;
-		InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.OutputDivider = Best_OutputDiv;
+		ShadowPtr = &InstancePtr->DAC_Tile[Tile_Id].PLL_Solution;
+		PLLSettingsPtr = &InstancePtr->DAC_Tile[Tile_Id].PLL_Settings;
 	}
 
-	Status = XRFDC_SUCCESS;
+	Status = XRFdc_GetPLLRefClkDiv(InstancePtr, Type, Tile_Id, &RefClkDiv);
+	if (Status != XRFDC_SUCCESS) {
+		goto RETURN_PATH;
+	}
 
+	if (SolutionPtr == NULL) {
+		XRFdc_CalcPLLDividers(InstancePtr, Type, RefClkFreq / RefClkDiv, SamplingRate, &Solution);
+		Solution.Type = Type;
+		Solution.RefClkFreq = RefClkFreq;
+		Solution.SampleRate = SamplingRate;
+		Solution.RefClkDivider = RefClkDiv;
+		SolutionPtr = &Solution;
+	} else {
+		if (SolutionPtr->RefClkDivider != RefClkDiv) {
+			metal_log(METAL_LOG_ERROR,
+				  "\n PLL solution computed for reference clock divider %u, tile uses %u for %s %u in %s\r\n",
+				  SolutionPtr->RefClkDivider, RefClkDiv, (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC",
+				  Tile_Id, __func__);
+			Status = XRFDC_FAILURE;
+			goto RETURN_PATH;
+		}
+		/*
+		 * The shadow is only trusted while the feedback divider still
+		 * reads back as written, a tile reset loses the PLL settings.
+		 */
+		if ((ShadowPtr->FeedbackDivider != 0U) &&
+		    (XRFdc_ReadReg16(InstancePtr, BaseAddr, XRFDC_PLL_FPDIV) ==
+		     (u16)(ShadowPtr->FeedbackDivider - 2U))) {
+			CurrentPtr = ShadowPtr;
+		}
+	}
+
+	XRFdc_WritePLLSolution(InstancePtr, BaseAddr, SolutionPtr, CurrentPtr);
+	*ShadowPtr = *SolutionPtr;
+
+	PLLSettingsPtr->SampleRate = SolutionPtr->CalcSampleRate;
+	PLLSettingsPtr->RefClkDivider = RefClkDiv;
+	PLLSettingsPtr->FeedbackDivider = SolutionPtr->FeedbackDivider;
+	PLLSettingsPtr->OutputDivider = SolutionPtr->OutputDivider;
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
 	return Status;
 }
 
@@ -1699,35 +1848,33 @@ RETURN_PATH:
 /*****************************************************************************/
 /**
 *
-* This function used for dynamically switch between internal PLL and
-* external clcok source and configuring the internal PLL
+* This function switches the tile between the internal PLL and the external
+* clock source and configures the internal PLL. The tile is stopped while
+* the clocking is changed and restarted afterwards.
 *
 * @param    InstancePtr is a pointer to the XRfdc instance.
 * @param    Type indicates ADC/DAC
 * @param    Tile_Id indicates Tile number (0-3)
 * @param    Source Clock source internal PLL or external clock source
-* @param    RefClkFreq Reference Clock Frequency in MHz(102.40625MHz - 1.2GHz)
-* @param    SamplingRate Sampling Rate in MHz(0.1- 6.554GHz for DAC and
-*           0.5/1.0 - 2.058/4.116GHz for ADC based on the device package).
+* @param    ClkSrc Clock source currently used by the tile
+* @param    RefClkFreq Reference Clock Frequency in MHz
+* @param    SamplingRate Sampling Rate in MHz
+* @param    SolutionPtr pointer to a precomputed PLL solution, or NULL.
 *
 * @return
 *           - XRFDC_SUCCESS if successful.
 *           - XRFDC_FAILURE if error occurs.
 *
-* @note     This API enables automatic selection of the VCO which will work in
-*           IP version 2.0.1 and above. Using older version of IP this API is
-*           not likely to work.
+* @note     Static API. The parameters must have been validated by the caller.
 *
 ******************************************************************************/
-u32 XRFdc_DynamicPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u8 Source, double RefClkFreq, double SamplingRate)
+static u32 XRFdc_ConfigurePLL(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u8 Source, u32 ClkSrc, double RefClkFreq,
+			      double SamplingRate, const XRFdc_PLL_Solution *SolutionPtr)
 {
-	u32 ClkSrc = 0U;
-	u32 Status;
+	u32 Status = XRFDC_SUCCESS;
 	u32 BaseAddr;
 	u32 PLLEnable = 0x0U;
 	u32 InitialPowerUpState;
-	double MaxSampleRate;
-	double MinSampleRate;
 	u32 OpDiv;
 	u32 PLLFreq;
 	u32 PLLFS;
@@ -1736,60 +1883,8 @@ u32 XRFdc_DynamicPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u8 Source,
 	u32 PLLBypVal;
 	u32 NetCtrlReg = 0x0U;
 
-	Xil_AssertNonvoid(InstancePtr != NULL);
-	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
-
-	if ((Source != XRFDC_INTERNAL_PLL_CLK) && (Source != XRFDC_EXTERNAL_CLK)) {
-		metal_log(METAL_LOG_ERROR, "\n Invalid Source value (%u) for %s %u in %s\r\n", Source,
-			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
-		Status = XRFDC_FAILURE;
-		goto RETURN_PATH;
-	}
-
-	Status = XRFdc_CheckTileEnabled(InstancePtr, Type, Tile_Id);
-	if (Status != XRFDC_SUCCESS) {
-		metal_log(METAL_LOG_ERROR, "\n Requested tile (%s %u) not available in %s\r\n",
-			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
-		goto RETURN_PATH;
-	}
-
-	/*
-	 * Get Tile clock source information
-	 */
-	if (XRFdc_GetClockSource(InstancePtr, Type, Tile_Id, &ClkSrc) != XRFDC_SUCCESS) {
-		Status = XRFDC_FAILURE;
-		goto RETURN_PATH;
-	}
-
-	if (XRFdc_GetMaxSampleRate(InstancePtr, Type, Tile_Id, &MaxSampleRate) != XRFDC_SUCCESS) {
-		Status = XRFDC_FAILURE;
-		goto RETURN_PATH;
-	}
-	if (XRFdc_GetMinSampleRate(InstancePtr, Type, Tile_Id, &MinSampleRate) != XRFDC_SUCCESS) {
-		Status = XRFDC_FAILURE;
-		goto RETURN_PATH;
-	}
-	if ((SamplingRate < MinSampleRate) || (SamplingRate > MaxSampleRate)) {
-		metal_log(METAL_LOG_ERROR, "\n Invalid sampling rate value (%lf) for %s %u in %s\r\n", SamplingRate,
-			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
-		Status = XRFDC_FAILURE;
-		goto RETURN_PATH;
-	}
-
 	BaseAddr = XRFDC_CTRL_STS_BASE(Type, Tile_Id);
 
-	if (Source == XRFDC_INTERNAL_PLL_CLK) {
-		if ((RefClkFreq < XRFDC_REFFREQ_MIN) || (RefClkFreq > XRFDC_REFFREQ_MAX)) {
-			metal_log(
-				METAL_LOG_ERROR,
-				"\n Input reference clock frequency (%lf MHz) does not respect the specifications for internal PLL usage. Please use a different frequency (%lf - %lf MHz) or bypass the internal PLL for %s %u in %s\r\n",
-				RefClkFreq, XRFDC_REFFREQ_MIN, XRFDC_REFFREQ_MAX,
-				(Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
-			Status = XRFDC_FAILURE;
-			goto RETURN_PATH;
-		}
-	}
-
 	PLLFreq = (u32)(RefClkFreq * 1000);
 	PLLFS = (u32)(SamplingRate * 1000);
 	XRFdc_WriteReg(InstancePtr, BaseAddr, XRFDC_PLL_FREQ, PLLFreq);
@@ -1847,7 +1942,7 @@ u32 XRFdc_DynamicPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u8 Source,
 		/*
 		 * Configure the PLL
 		 */
-		if (XRFdc_SetPLLConfig(InstancePtr, Type, Tile_Id, RefClkFreq, SamplingRate) != XRFDC_SUCCESS) {
+		if (XRFdc_SetPLLConfig(InstancePtr, Type, Tile_Id, RefClkFreq, SamplingRate, SolutionPtr) != XRFDC_SUCCESS) {
 			Status = XRFDC_FAILURE;
 			goto RETURN_PATH;
 		}
@@ -1905,11 +2000,13 @@ u32 XRFdc_DynamicPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u8 Source,
 			InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.RefClkDivider = 0x0U;
 			InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.FeedbackDivider = 0x0U;
 			InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.OutputDivider = OpDiv;
+			InstancePtr->ADC_Tile[Tile_Id].PLL_Solution.FeedbackDivider = 0x0U;
 		} else {
 			InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.SampleRate = SamplingRate;
 			InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.RefClkDivider = 0x0U;
 			InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.FeedbackDivider = 0x0U;
 			InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.OutputDivider = OpDiv;
+			InstancePtr->DAC_Tile[Tile_Id].PLL_Solution.FeedbackDivider = 0x0U;
 		}
 	}
 
@@ -1936,4 +2033,229 @@ u32 XRFdc_DynamicPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u8 Source,
 RETURN_PATH:
 	return Status;
 }
+
+/*****************************************************************************/
+/**
+*
+* This function used for dynamically switch between internal PLL and
+* external clcok source and configuring the internal PLL
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type indicates ADC/DAC
+* @param    Tile_Id indicates Tile number (0-3)
+* @param    Source Clock source internal PLL or external clock source
+* @param    RefClkFreq Reference Clock Frequency in MHz(102.40625MHz - 1.2GHz)
+* @param    SamplingRate Sampling Rate in MHz(0.1- 6.554GHz for DAC and
+*           0.5/1.0 - 2.058/4.116GHz for ADC based on the device package).
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     This API enables automatic selection of the VCO which will work in
+*           IP version 2.0.1 and above. Using older version of IP this API is
+*           not likely to work.
+*
+******************************************************************************/
+u32 XRFdc_DynamicPLLConfig(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u8 Source, double RefClkFreq, double SamplingRate)
+{
+	u32 ClkSrc = 0U;
+	u32 Status;
+	double MaxSampleRate;
+	double MinSampleRate;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	if ((Source != XRFDC_INTERNAL_PLL_CLK) && (Source != XRFDC_EXTERNAL_CLK)) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid Source value (%u) for %s %u in %s\r\n", Source,
+			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	Status = XRFdc_CheckTileEnabled(InstancePtr, Type, Tile_Id);
+	if (Status != XRFDC_SUCCESS) {
+		metal_log(METAL_LOG_ERROR, "\n Requested tile (%s %u) not available in %s\r\n",
+			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
+		goto RETURN_PATH;
+	}
+
+	/*
+	 * Get Tile clock source information
+	 */
+	if (XRFdc_GetClockSource(InstancePtr, Type, Tile_Id, &ClkSrc) != XRFDC_SUCCESS) {
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	if (XRFdc_GetMaxSampleRate(InstancePtr, Type, Tile_Id, &MaxSampleRate) != XRFDC_SUCCESS) {
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+	if (XRFdc_GetMinSampleRate(InstancePtr, Type, Tile_Id, &MinSampleRate) != XRFDC_SUCCESS) {
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+	if ((SamplingRate < MinSampleRate) || (SamplingRate > MaxSampleRate)) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid sampling rate value (%lf) for %s %u in %s\r\n", SamplingRate,
+			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	if (Source == XRFDC_INTERNAL_PLL_CLK) {
+		if ((RefClkFreq < XRFDC_REFFREQ_MIN) || (RefClkFreq > XRFDC_REFFREQ_MAX)) {
+			metal_log(
+				METAL_LOG_ERROR,
+				"\n Input reference clock frequency (%lf MHz) does not respect the specifications for internal PLL usage. Please use a different frequency (%lf - %lf MHz) or bypass the internal PLL for %s %u in %s\r\n",
+				RefClkFreq, XRFDC_REFFREQ_MIN, XRFDC_REFFREQ_MAX,
+				(Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
+			Status = XRFDC_FAILURE;
+			goto RETURN_PATH;
+		}
+	}
+
+	Status = XRFdc_ConfigurePLL(InstancePtr, Type, Tile_Id, Source, ClkSrc, RefClkFreq, SamplingRate, NULL);
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API computes the internal PLL settings for a reference clock and
+* sampling rate without touching the hardware, so they can be applied later
+* with XRFdc_ApplyPLLSolution(). Applications that switch between a known
+* set of sampling rates can compute a table of solutions once and retune
+* without the divider search.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type indicates ADC/DAC
+* @param    Tile_Id indicates Tile number (0-3)
+* @param    RefClkFreq Reference Clock Frequency in MHz(102.40625MHz - 1.2GHz)
+* @param    SamplingRate Sampling Rate in MHz(0.1- 6.554GHz for DAC and
+*           0.5/1.0 - 2.058/4.116GHz for ADC based on the device package).
+* @param    SolutionPtr pointer to return the PLL solution.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     The solution depends on the reference clock divider of the tile
+*           and must be recomputed if it changes.
+*
+******************************************************************************/
+u32 XRFdc_CalcPLLSolution(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, double RefClkFreq, double SamplingRate,
+			  XRFdc_PLL_Solution *SolutionPtr)
+{
+	u32 Status;
+	u32 RefClkDiv = 0x1U;
+	double MaxSampleRate;
+	double MinSampleRate;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(SolutionPtr != NULL);
+
+	Status = XRFdc_CheckTileEnabled(InstancePtr, Type, Tile_Id);
+	if (Status != XRFDC_SUCCESS) {
+		metal_log(METAL_LOG_ERROR, "\n Requested tile (%s %u) not available in %s\r\n",
+			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
+		goto RETURN_PATH;
+	}
+
+	if (XRFdc_GetMaxSampleRate(InstancePtr, Type, Tile_Id, &MaxSampleRate) != XRFDC_SUCCESS) {
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+	if (XRFdc_GetMinSampleRate(InstancePtr, Type, Tile_Id, &MinSampleRate) != XRFDC_SUCCESS) {
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+	if ((SamplingRate < MinSampleRate) || (SamplingRate > MaxSampleRate)) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid sampling rate value (%lf) for %s %u in %s\r\n", SamplingRate,
+			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	if ((RefClkFreq < XRFDC_REFFREQ_MIN) || (RefClkFreq > XRFDC_REFFREQ_MAX)) {
+		metal_log(
+			METAL_LOG_ERROR,
+			"\n Input reference clock frequency (%lf MHz) does not respect the specifications for internal PLL usage. Please use a different frequency (%lf - %lf MHz) for %s %u in %s\r\n",
+			RefClkFreq, XRFDC_REFFREQ_MIN, XRFDC_REFFREQ_MAX, (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC",
+			Tile_Id, __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	Status = XRFdc_GetPLLRefClkDiv(InstancePtr, Type, Tile_Id, &RefClkDiv);
+	if (Status != XRFDC_SUCCESS) {
+		goto RETURN_PATH;
+	}
+
+	XRFdc_CalcPLLDividers(InstancePtr, Type, RefClkFreq / RefClkDiv, SamplingRate, SolutionPtr);
+	SolutionPtr->Type = Type;
+	SolutionPtr->RefClkFreq = RefClkFreq;
+	SolutionPtr->SampleRate = SamplingRate;
+	SolutionPtr->RefClkDivider = RefClkDiv;
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API switches the tile to the internal PLL configured with a solution
+* from XRFdc_CalcPLLSolution(). It has the same effect as
+* XRFdc_DynamicPLLConfig() with XRFDC_INTERNAL_PLL_CLK, but skips the
+* parameter checks and the divider search, and if the tile PLL still holds
+* the settings last written by the driver only the PLL registers that change
+* are written.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type indicates ADC/DAC
+* @param    Tile_Id indicates Tile number (0-3)
+* @param    SolutionPtr pointer to the PLL solution.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     The solution must have been computed for the same converter type
+*           and the same reference clock divider.
+*
+******************************************************************************/
+u32 XRFdc_ApplyPLLSolution(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, const XRFdc_PLL_Solution *SolutionPtr)
+{
+	u32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(SolutionPtr != NULL);
+
+	if ((SolutionPtr->Type != Type) || (SolutionPtr->FeedbackDivider == 0U)) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid PLL solution for %s %u in %s\r\n",
+			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	Status = XRFdc_CheckTileEnabled(InstancePtr, Type, Tile_Id);
+	if (Status != XRFDC_SUCCESS) {
+		metal_log(METAL_LOG_ERROR, "\n Requested tile (%s %u) not available in %s\r\n",
+			  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
+		goto RETURN_PATH;
+	}
+
+	Status = XRFdc_ConfigurePLL(InstancePtr, Type, Tile_Id, XRFDC_INTERNAL_PLL_CLK, XRFDC_INTERNAL_PLL_CLK,
+				    SolutionPtr->RefClkFreq, SolutionPtr->SampleRate, SolutionPtr);
+
+RETURN_PATH:
+	return Status;
+}
 /** @} */
@@ -50,6 +50,8 @@
 *       cog    06/24/20 Explicitly set FIFO width when setting the mixer.
 *       cog    10/06/20 Should only get calibration mode when setting/getting the
 *                       mixer settings for Gen 1/2 devices.
+*       cog    11/16/20 Added XRFdc_CompileNCOHop() and XRFdc_CommitNCOHop() to
+*                       hop the NCOs of several blocks on one update event.
 * </pre>
 *
 ******************************************************************************/
@@ -68,6 +70,9 @@ static void XRFdc_SetCoarseMixer(XRFdc *InstancePtr, u32 Type, u32 BaseAddr, u32
 static u32 XRFdc_MixerRangeCheck(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id,
 				 XRFdc_Mixer_Settings *MixerSettingsPtr);
 static void XRFdc_MixersOff(XRFdc *InstancePtr, u32 BaseAddr);
+static u32 XRFdc_GetMixerBWDiv(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 *BWDivPtr);
+static u32 XRFdc_CalcNCOFreqWord(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, double SamplingRate,
+				 double NCOFreq, u8 CalibrationMode, s64 *FreqPtr);
 
 /************************** Function Prototypes ******************************/
 
@@ -111,10 +116,7 @@ u32 XRFdc_SetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_
 	XRFdc_Mixer_Settings *MixerConfigPtr;
 	u8 CalibrationMode = 0U;
 	u32 CoarseMixFreq;
-	double NCOFreq;
-	u32 NyquistZone = 0U;
 	u32 Offset;
-	u32 DatapathMode;
 	u32 BWDiv = XRFDC_FULL_BW_DIVISOR;
 
 	Xil_AssertNonvoid(InstancePtr != NULL);
@@ -125,26 +127,9 @@ u32 XRFdc_SetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_
 	if (Status != XRFDC_SUCCESS) {
 		goto RETURN_PATH;
 	}
-	if (InstancePtr->RFdc_Config.IPType >= XRFDC_GEN3) {
-		if (Type == XRFDC_DAC_TILE) {
-			DatapathMode = XRFdc_RDReg(InstancePtr, XRFDC_BLOCK_BASE(XRFDC_DAC_TILE, Tile_Id, Block_Id),
-						   XRFDC_DAC_DATAPATH_OFFSET, XRFDC_DATAPATH_MODE_MASK);
-			switch (DatapathMode) {
-			case XRFDC_DAC_INT_MODE_FULL_BW_BYPASS:
-				Status = XRFDC_FAILURE;
-				metal_log(METAL_LOG_ERROR,
-					  "\n Can't set mixer as DAC %u DUC %u is in bypass mode in %s\r\n", Tile_Id,
-					  Block_Id, __func__);
-				goto RETURN_PATH;
-			case XRFDC_DAC_INT_MODE_HALF_BW_IMR:
-				BWDiv = XRFDC_HALF_BW_DIVISOR;
-				break;
-			case XRFDC_DAC_INT_MODE_FULL_BW:
-			default:
-				BWDiv = XRFDC_FULL_BW_DIVISOR;
-				break;
-			}
-		}
+	Status = XRFdc_GetMixerBWDiv(InstancePtr, Type, Tile_Id, Block_Id, &BWDiv);
+	if (Status != XRFDC_SUCCESS) {
+		goto RETURN_PATH;
 	}
 
 	Status = XRFdc_MixerRangeCheck(InstancePtr, Type, Tile_Id, Block_Id, MixerSettingsPtr);
@@ -235,9 +220,8 @@ u32 XRFdc_SetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_
 			}
 		}
 
-		/* Update NCO, CoarseMix freq based on calibration mode */
+		/* Update CoarseMix freq based on calibration mode */
 		CoarseMixFreq = MixerSettingsPtr->CoarseMixFreq;
-		NCOFreq = MixerSettingsPtr->Freq;
 		if ((InstancePtr->RFdc_Config.IPType < XRFDC_GEN3) && (Type == XRFDC_ADC_TILE)) {
 			Status = XRFdc_GetCalibrationMode(InstancePtr, Tile_Id, Block_Id, &CalibrationMode);
 			if (Status != XRFDC_SUCCESS) {
@@ -261,31 +245,15 @@ u32 XRFdc_SetMixerSettings(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_
 					CoarseMixFreq = XRFDC_COARSE_MIX_OFF;
 					break;
 				}
-				NCOFreq -= SamplingRate / 2.0;
-			}
-		}
-
-		if ((NCOFreq < -(SamplingRate / 2.0)) || (NCOFreq > (SamplingRate / 2.0))) {
-			Status = XRFdc_GetNyquistZone(InstancePtr, Type, Tile_Id, Block_Id, &NyquistZone);
-			if (Status != XRFDC_SUCCESS) {
-				return XRFDC_FAILURE;
-			}
-			do {
-				if (NCOFreq < -(SamplingRate / 2.0)) {
-					NCOFreq += SamplingRate;
-				}
-				if (NCOFreq > (SamplingRate / 2.0)) {
-					NCOFreq -= SamplingRate;
-				}
-			} while ((NCOFreq < -(SamplingRate / 2.0)) || (NCOFreq > (SamplingRate / 2.0)));
-
-			if ((NyquistZone == XRFDC_EVEN_NYQUIST_ZONE) && (NCOFreq != 0)) {
-				NCOFreq *= -1;
 			}
 		}
 
 		/* NCO Frequency */
-		Freq = ((NCOFreq * XRFDC_NCO_FREQ_MULTIPLIER) / SamplingRate);
+		Status = XRFdc_CalcNCOFreqWord(InstancePtr, Type, Tile_Id, Block_Id, SamplingRate,
+					       MixerSettingsPtr->Freq, CalibrationMode, &Freq);
+		if (Status != XRFDC_SUCCESS) {
+			return XRFDC_FAILURE;
+		}
 		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_LOW_OFFSET, (u16)Freq);
 		ReadReg = (Freq >> XRFDC_NCO_FQWD_MID_SHIFT) & XRFDC_NCO_FQWD_MID_MASK;
 		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_MID_OFFSET, (u16)ReadReg);
@@ -356,6 +324,112 @@ RETURN_PATH:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* Static API used to get the divisor applied to the sampling rate of the tile
+* to get the sampling rate of the mixer.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
+* @param    Tile_Id Valid values are 0-3.
+* @param    Block_Id is ADC/DAC block number inside the tile. Valid values
+*           are 0-3.
+* @param    BWDivPtr Pointer to return the bandwidth divisor.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if the datapath is in bypass mode.
+*
+* @note     None.
+*
+******************************************************************************/
+static u32 XRFdc_GetMixerBWDiv(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, u32 *BWDivPtr)
+{
+	u32 Status = XRFDC_SUCCESS;
+	u32 DatapathMode;
+
+	*BWDivPtr = XRFDC_FULL_BW_DIVISOR;
+	if ((InstancePtr->RFdc_Config.IPType >= XRFDC_GEN3) && (Type == XRFDC_DAC_TILE)) {
+		DatapathMode = XRFdc_RDReg(InstancePtr, XRFDC_BLOCK_BASE(XRFDC_DAC_TILE, Tile_Id, Block_Id),
+					   XRFDC_DAC_DATAPATH_OFFSET, XRFDC_DATAPATH_MODE_MASK);
+		switch (DatapathMode) {
+		case XRFDC_DAC_INT_MODE_FULL_BW_BYPASS:
+			Status = XRFDC_FAILURE;
+			metal_log(METAL_LOG_ERROR, "\n Can't set mixer as DAC %u DUC %u is in bypass mode in %s\r\n",
+				  Tile_Id, Block_Id, __func__);
+			break;
+		case XRFDC_DAC_INT_MODE_HALF_BW_IMR:
+			*BWDivPtr = XRFDC_HALF_BW_DIVISOR;
+			break;
+		case XRFDC_DAC_INT_MODE_FULL_BW:
+		default:
+			*BWDivPtr = XRFDC_FULL_BW_DIVISOR;
+			break;
+		}
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Static API used to calculate the NCO frequency word. The frequency is
+* folded into the first Nyquist zone and negated for even Nyquist zones.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    Type is ADC or DAC. 0 for ADC and 1 for DAC
+* @param    Tile_Id Valid values are 0-3.
+* @param    Block_Id is ADC/DAC block number inside the tile. Valid values
+*           are 0-3.
+* @param    SamplingRate is the sampling rate of the mixer in MHz.
+* @param    NCOFreq is the NCO frequency in MHz.
+* @param    CalibrationMode is the calibration mode of Gen 1/2 ADCs, 0 for
+*           other converters.
+* @param    FreqPtr Pointer to return the frequency word.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if the Nyquist zone can't be read.
+*
+* @note     None.
+*
+******************************************************************************/
+static u32 XRFdc_CalcNCOFreqWord(XRFdc *InstancePtr, u32 Type, u32 Tile_Id, u32 Block_Id, double SamplingRate,
+				 double NCOFreq, u8 CalibrationMode, s64 *FreqPtr)
+{
+	u32 Status;
+	u32 NyquistZone = 0U;
+
+	if (CalibrationMode == XRFDC_CALIB_MODE1) {
+		NCOFreq -= SamplingRate / 2.0;
+	}
+
+	if ((NCOFreq < -(SamplingRate / 2.0)) || (NCOFreq > (SamplingRate / 2.0))) {
+		Status = XRFdc_GetNyquistZone(InstancePtr, Type, Tile_Id, Block_Id, &NyquistZone);
+		if (Status != XRFDC_SUCCESS) {
+			goto RETURN_PATH;
+		}
+		do {
+			if (NCOFreq < -(SamplingRate / 2.0)) {
+				NCOFreq += SamplingRate;
+			}
+			if (NCOFreq > (SamplingRate / 2.0)) {
+				NCOFreq -= SamplingRate;
+			}
+		} while ((NCOFreq < -(SamplingRate / 2.0)) || (NCOFreq > (SamplingRate / 2.0)));
+
+		if ((NyquistZone == XRFDC_EVEN_NYQUIST_ZONE) && (NCOFreq != 0)) {
+			NCOFreq *= -1;
+		}
+	}
+
+	*FreqPtr = ((NCOFreq * XRFDC_NCO_FREQ_MULTIPLIER) / SamplingRate);
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 * Static API used to do the Mixer Settings range check.
@@ -1037,4 +1111,249 @@ RETURN_PATH:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* The API compiles a frequency hop for several mixers into NCO register
+* images, so that XRFdc_CommitNCOHop() can apply it without any calculation.
+* All the mixers must already be set up with XRFdc_SetMixerSettings() as
+* fine mixers using the event source of the hop.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    BlocksPtr Pointer to the array of per block NCO settings.
+* @param    NumBlocks is the number of entries in BlocksPtr.
+* @param    EventSource is the update event source shared by all the blocks,
+*           XRFDC_EVNT_SRC_TILE or XRFDC_EVNT_SRC_SYSREF.
+* @param    HopPtr Pointer to the XRFdc_NCO_Hop structure in which the
+*           compiled hop is returned.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*           - XRFDC_FAILURE if error occurs.
+*
+* @note     The register images depend on the sampling rate, Nyquist zone,
+*           datapath mode and calibration mode of the blocks, a hop must be
+*           compiled again after any of them is changed.
+*
+******************************************************************************/
+u32 XRFdc_CompileNCOHop(XRFdc *InstancePtr, const XRFdc_NCO_Hop_Block *BlocksPtr, u32 NumBlocks, u32 EventSource,
+			XRFdc_NCO_Hop *HopPtr)
+{
+	u32 Status;
+	u32 Entry;
+	u32 Index;
+	u32 NoOfBlocks;
+	u32 BWDiv;
+	u32 Type;
+	u32 Tile_Id;
+	u32 Block_Id;
+	u8 CalibrationMode;
+	double SamplingRate;
+	s64 Freq;
+	s32 PhaseOffset;
+	XRFdc_Mixer_Settings *MixerConfigPtr;
+	XRFdc_NCO_Hop_Regs *RegsPtr;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(BlocksPtr != NULL);
+	Xil_AssertNonvoid(HopPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	HopPtr->EventSource = EventSource;
+	HopPtr->TileMask = 0U;
+	HopPtr->NumRegs = 0U;
+
+	if ((EventSource != XRFDC_EVNT_SRC_TILE) && (EventSource != XRFDC_EVNT_SRC_SYSREF)) {
+		metal_log(METAL_LOG_ERROR, "\n Invalid event source (%u) for NCO hop in %s\r\n", EventSource,
+			  __func__);
+		Status = XRFDC_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	for (Entry = 0U; Entry < NumBlocks; Entry++) {
+		Type = BlocksPtr[Entry].Type;
+		Tile_Id = BlocksPtr[Entry].Tile_Id;
+		Block_Id = BlocksPtr[Entry].Block_Id;
+
+		Status = XRFdc_CheckDigitalPathEnabled(InstancePtr, Type, Tile_Id, Block_Id);
+		if (Status != XRFDC_SUCCESS) {
+			metal_log(METAL_LOG_ERROR, "\n %s %u block %u not available in %s\r\n",
+				  (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, Block_Id, __func__);
+			goto RETURN_PATH;
+		}
+
+		if ((BlocksPtr[Entry].PhaseOffset >= XRFDC_MIXER_PHASE_OFFSET_UP_LIMIT) ||
+		    (BlocksPtr[Entry].PhaseOffset <= XRFDC_MIXER_PHASE_OFFSET_LOW_LIMIT)) {
+			metal_log(METAL_LOG_ERROR, "\n Invalid phase offset value (%lf) for %s %u block %u in %s\r\n",
+				  BlocksPtr[Entry].PhaseOffset, (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id,
+				  Block_Id, __func__);
+			Status = XRFDC_FAILURE;
+			goto RETURN_PATH;
+		}
+
+		Status = XRFdc_GetMixerBWDiv(InstancePtr, Type, Tile_Id, Block_Id, &BWDiv);
+		if (Status != XRFDC_SUCCESS) {
+			goto RETURN_PATH;
+		}
+
+		CalibrationMode = 0U;
+		if ((InstancePtr->RFdc_Config.IPType < XRFDC_GEN3) && (Type == XRFDC_ADC_TILE)) {
+			Status = XRFdc_GetCalibrationMode(InstancePtr, Tile_Id, Block_Id, &CalibrationMode);
+			if (Status != XRFDC_SUCCESS) {
+				goto RETURN_PATH;
+			}
+		}
+
+		Index = Block_Id;
+		if ((XRFdc_IsHighSpeedADC(InstancePtr, Tile_Id) == 1) && (Type == XRFDC_ADC_TILE)) {
+			NoOfBlocks = XRFDC_NUM_OF_BLKS2;
+			if (Block_Id == XRFDC_BLK_ID1) {
+				Index = XRFDC_BLK_ID2;
+				NoOfBlocks = XRFDC_NUM_OF_BLKS4;
+			}
+		} else {
+			NoOfBlocks = Block_Id + 1U;
+		}
+
+		for (; Index < NoOfBlocks; Index++) {
+			if (Type == XRFDC_ADC_TILE) {
+				MixerConfigPtr = &InstancePtr->ADC_Tile[Tile_Id]
+							  .ADCBlock_Digital_Datapath[Index]
+							  .Mixer_Settings;
+				SamplingRate = InstancePtr->ADC_Tile[Tile_Id].PLL_Settings.SampleRate;
+			} else {
+				MixerConfigPtr = &InstancePtr->DAC_Tile[Tile_Id]
+							  .DACBlock_Digital_Datapath[Index]
+							  .Mixer_Settings;
+				SamplingRate = InstancePtr->DAC_Tile[Tile_Id].PLL_Settings.SampleRate / BWDiv;
+			}
+
+			if ((MixerConfigPtr->MixerType != XRFDC_MIXER_TYPE_FINE) ||
+			    (MixerConfigPtr->EventSource != EventSource)) {
+				metal_log(
+					METAL_LOG_ERROR,
+					"\n Mixer must be a fine mixer with event source (%u) for %s %u block %u in %s\r\n",
+					EventSource, (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, Block_Id,
+					__func__);
+				Status = XRFDC_FAILURE;
+				goto RETURN_PATH;
+			}
+			if (SamplingRate <= 0) {
+				metal_log(METAL_LOG_ERROR, "\n Incorrect Sampling rate (%2.4f GHz) for %s %u in %s\r\n",
+					  SamplingRate, (Type == XRFDC_ADC_TILE) ? "ADC" : "DAC", Tile_Id, __func__);
+				Status = XRFDC_FAILURE;
+				goto RETURN_PATH;
+			}
+			if (HopPtr->NumRegs == XRFDC_NCO_HOP_MAX_BLOCKS) {
+				metal_log(METAL_LOG_ERROR, "\n Too many blocks in NCO hop in %s\r\n", __func__);
+				Status = XRFDC_FAILURE;
+				goto RETURN_PATH;
+			}
+
+			Status = XRFdc_CalcNCOFreqWord(InstancePtr, Type, Tile_Id, Block_Id,
+						       SamplingRate * XRFDC_MILLI, BlocksPtr[Entry].Freq,
+						       CalibrationMode, &Freq);
+			if (Status != XRFDC_SUCCESS) {
+				goto RETURN_PATH;
+			}
+			PhaseOffset = ((BlocksPtr[Entry].PhaseOffset * XRFDC_NCO_PHASE_MULTIPLIER) /
+				       XRFDC_MIXER_PHASE_OFFSET_UP_LIMIT);
+
+			RegsPtr = &HopPtr->Regs[HopPtr->NumRegs];
+			RegsPtr->BaseAddr = XRFDC_BLOCK_BASE(Type, Tile_Id, Index);
+			RegsPtr->Type = Type;
+			RegsPtr->Tile_Id = Tile_Id;
+			RegsPtr->Block_Id = Index;
+			RegsPtr->Freq = BlocksPtr[Entry].Freq;
+			RegsPtr->PhaseOffset = BlocksPtr[Entry].PhaseOffset;
+			RegsPtr->FreqWord[0] = (u16)Freq;
+			RegsPtr->FreqWord[1] = (u16)((Freq >> XRFDC_NCO_FQWD_MID_SHIFT) & XRFDC_NCO_FQWD_MID_MASK);
+			RegsPtr->FreqWord[2] = (u16)((Freq >> XRFDC_NCO_FQWD_UPP_SHIFT) & XRFDC_NCO_FQWD_UPP_MASK);
+			RegsPtr->PhaseWord[0] = (u16)PhaseOffset;
+			RegsPtr->PhaseWord[1] = (u16)((PhaseOffset >> XRFDC_NCO_PHASE_UPP_SHIFT) & XRFDC_NCO_PHASE_UPP_MASK);
+			HopPtr->NumRegs++;
+		}
+
+		HopPtr->TileMask |= (u32)XRFDC_ENABLED << ((Type == XRFDC_ADC_TILE) ? Tile_Id : (Tile_Id + 4U));
+	}
+
+	Status = XRFDC_SUCCESS;
+RETURN_PATH:
+	if (Status != XRFDC_SUCCESS) {
+		HopPtr->NumRegs = 0U;
+		HopPtr->TileMask = 0U;
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* The API applies a frequency hop compiled with XRFdc_CompileNCOHop(). The
+* NCO registers of all the blocks are written first and take effect together
+* on the update event. For tile events one update event is triggered per
+* tile, for SYSREF events the hop takes effect on the next SYSREF edge, which
+* is issued external to the driver.
+*
+* @param    InstancePtr is a pointer to the XRfdc instance.
+* @param    HopPtr Pointer to the compiled hop.
+*
+* @return
+*           - XRFDC_SUCCESS if successful.
+*
+* @note     None.
+*
+******************************************************************************/
+u32 XRFdc_CommitNCOHop(XRFdc *InstancePtr, const XRFdc_NCO_Hop *HopPtr)
+{
+	u32 Index;
+	u32 Tile_Id;
+	u32 BaseAddr;
+	const XRFdc_NCO_Hop_Regs *RegsPtr;
+	XRFdc_Mixer_Settings *MixerConfigPtr;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(HopPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XRFDC_COMPONENT_IS_READY);
+
+	for (Index = 0U; Index < HopPtr->NumRegs; Index++) {
+		RegsPtr = &HopPtr->Regs[Index];
+		BaseAddr = RegsPtr->BaseAddr;
+		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_LOW_OFFSET, RegsPtr->FreqWord[0]);
+		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_MID_OFFSET, RegsPtr->FreqWord[1]);
+		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_ADC_NCO_FQWD_UPP_OFFSET, RegsPtr->FreqWord[2]);
+		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_NCO_PHASE_LOW_OFFSET, RegsPtr->PhaseWord[0]);
+		XRFdc_WriteReg16(InstancePtr, BaseAddr, XRFDC_NCO_PHASE_UPP_OFFSET, RegsPtr->PhaseWord[1]);
+	}
+
+	if (HopPtr->EventSource == XRFDC_EVNT_SRC_TILE) {
+		for (Tile_Id = XRFDC_TILE_ID0; Tile_Id <= XRFDC_TILE_ID_MAX; Tile_Id++) {
+			if ((HopPtr->TileMask & ((u32)XRFDC_ENABLED << Tile_Id)) != 0U) {
+				XRFdc_WriteReg16(InstancePtr, XRFDC_ADC_TILE_DRP_ADDR(Tile_Id) + XRFDC_HSCOM_ADDR,
+						 XRFDC_HSCOM_UPDT_DYN_OFFSET, 0x1);
+			}
+			if ((HopPtr->TileMask & ((u32)XRFDC_ENABLED << (Tile_Id + 4U))) != 0U) {
+				XRFdc_WriteReg16(InstancePtr, XRFDC_DAC_TILE_DRP_ADDR(Tile_Id) + XRFDC_HSCOM_ADDR,
+						 XRFDC_HSCOM_UPDT_DYN_OFFSET, 0x1);
+			}
+		}
+	}
+
+	/* Update the instance with new values */
+	for (Index = 0U; Index < HopPtr->NumRegs; Index++) {
+		RegsPtr = &HopPtr->Regs[Index];
+		if (RegsPtr->Type == XRFDC_ADC_TILE) {
+			MixerConfigPtr = &InstancePtr->ADC_Tile[RegsPtr->Tile_Id]
+						  .ADCBlock_Digital_Datapath[RegsPtr->Block_Id]
+						  .Mixer_Settings;
+		} else {
+			MixerConfigPtr = &InstancePtr->DAC_Tile[RegsPtr->Tile_Id]
+						  .DACBlock_Digital_Datapath[RegsPtr->Block_Id]
+						  .Mixer_Settings;
+		}
+		MixerConfigPtr->Freq = RegsPtr->Freq;
+		MixerConfigPtr->PhaseOffset = RegsPtr->PhaseOffset;
+	}
+
+	return XRFDC_SUCCESS;
+}
+
 /** @} */
@@ -0,0 +1,530 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/****************************************************************************/
+/**
+*
+* @file xrfdc_nco_hop_test.c
+*
+* Host test of the compiled NCO hops against a register capture backend.
+* Two driver instances are backed by libmetal I/O regions whose accesses go
+* to plain memory, and the register writes of one of them are logged. All the
+* fine mixers of one instance are hopped block by block with
+* XRFdc_SetMixerSettings(), followed by XRFdc_UpdateEvent() for tile events,
+* and those of the other instance with XRFdc_CompileNCOHop() and
+* XRFdc_CommitNCOHop(). For tile and SYSREF event sources the test checks
+* that:
+*	- after every hop both register files and the mixer settings read back
+*	  with XRFdc_GetMixerSettings() are identical;
+*	- the commit reads no register and only writes the five NCO frequency
+*	  and phase registers of each block in the hop, followed by exactly one
+*	  update event per tile for tile events and none for SYSREF events;
+*	- a hop is not compiled for mixers set up with another event source.
+* It then prints the CPU time and the register writes per hop of both paths,
+* for Gen 1/2 and Gen 3 devices with and without 4 GSPS ADC tiles.
+*
+* The test is built and run by the Makefile of this directory.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 8.1   cog    11/16/20 First release
+*
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "xrfdc.h"
+
+/************************** Constant Definitions ****************************/
+#define REG_FILE_SIZE (1U << 20)
+#define WRITE_LOG_SIZE 1024U
+#define NUM_HOPS 2000U
+#define NCO_REGS_PER_BLOCK 5U
+#define ADC_SAMPLING_RATE 2.0
+#define DAC_SAMPLING_RATE 6.4
+
+/**************************** Type Definitions ******************************/
+typedef struct {
+	u32 Offset;
+	u32 Value;
+} RegWrite;
+
+typedef struct {
+	XRFdc Inst;
+	struct metal_io_region Io;
+	u8 Regs[REG_FILE_SIZE];
+	u32 NumReads;
+	u32 NumWrites;
+	RegWrite Log[WRITE_LOG_SIZE];
+} RegFileDev;
+
+/************************** Function Prototypes *****************************/
+static uint64_t RegFileRead(struct metal_io_region *io, unsigned long offset, memory_order order, int width);
+static void RegFileWrite(struct metal_io_region *io, unsigned long offset, uint64_t value, memory_order order,
+			 int width);
+
+/************************** Variable Definitions ****************************/
+static const struct metal_io_ops RegFileOps = {
+	.read = RegFileRead,
+	.write = RegFileWrite,
+};
+
+/* NCO register offsets written for each block of a hop */
+static const u32 NCORegs[NCO_REGS_PER_BLOCK] = {
+	XRFDC_ADC_NCO_FQWD_UPP_OFFSET, XRFDC_ADC_NCO_FQWD_MID_OFFSET, XRFDC_ADC_NCO_FQWD_LOW_OFFSET,
+	XRFDC_NCO_PHASE_UPP_OFFSET,    XRFDC_NCO_PHASE_LOW_OFFSET,
+};
+
+static RegFileDev DevPerBlock;
+static RegFileDev DevHop;
+static XRFdc_NCO_Hop_Block Blocks[XRFDC_NCO_HOP_MAX_BLOCKS];
+static XRFdc_NCO_Hop Hop;
+
+/****************************************************************************/
+/**
+*
+* This function reads a register of the emulated register file.
+*
+* @param	io is the I/O region of the register file.
+* @param	offset is the register offset.
+* @param	order is the memory order, unused.
+* @param	width is the access width in bytes.
+*
+* @return	Register value.
+*
+****************************************************************************/
+static uint64_t RegFileRead(struct metal_io_region *io, unsigned long offset, memory_order order, int width)
+{
+	RegFileDev *Dev = (RegFileDev *)((char *)io - offsetof(RegFileDev, Io));
+	uint64_t Value = 0U;
+
+	(void)order;
+	Dev->NumReads++;
+	memcpy(&Value, &Dev->Regs[offset], width);
+
+	return Value;
+}
+
+/****************************************************************************/
+/**
+*
+* This function writes a register of the emulated register file and logs
+* the write.
+*
+* @param	io is the I/O region of the register file.
+* @param	offset is the register offset.
+* @param	value is the value to write.
+* @param	order is the memory order, unused.
+* @param	width is the access width in bytes.
+*
+* @return	None
+*
+****************************************************************************/
+static void RegFileWrite(struct metal_io_region *io, unsigned long offset, uint64_t value, memory_order order,
+			 int width)
+{
+	RegFileDev *Dev = (RegFileDev *)((char *)io - offsetof(RegFileDev, Io));
+
+	(void)order;
+	if (Dev->NumWrites < WRITE_LOG_SIZE) {
+		Dev->Log[Dev->NumWrites].Offset = (u32)offset;
+		Dev->Log[Dev->NumWrites].Value = (u32)value;
+	}
+	Dev->NumWrites++;
+	memcpy(&Dev->Regs[offset], &value, width);
+}
+
+/****************************************************************************/
+/**
+*
+* This function sets up a driver instance on an emulated register file with
+* all tiles and converters enabled.
+*
+* @param	Dev is the device to set up.
+* @param	IPType is the IP generation.
+* @param	ADC4GSPS selects 4 GSPS ADC tiles with two blocks each.
+*
+* @return	None
+*
+****************************************************************************/
+static void SetupDevice(RegFileDev *Dev, u8 IPType, u32 ADC4GSPS)
+{
+	XRFdc *InstancePtr = &Dev->Inst;
+	metal_phys_addr_t Phys = 0;
+	u32 Tile;
+
+	memset(Dev, 0, sizeof(*Dev));
+	metal_io_init(&Dev->Io, Dev->Regs, &Phys, REG_FILE_SIZE, (unsigned)-1, 0, &RegFileOps);
+	InstancePtr->io = &Dev->Io;
+	InstancePtr->IsReady = XRFDC_COMPONENT_IS_READY;
+	InstancePtr->RFdc_Config.IPType = IPType;
+	InstancePtr->ADC4GSPS = ADC4GSPS;
+
+	XRFdc_WriteReg(InstancePtr, XRFDC_IP_BASE, XRFDC_TILES_ENABLED_OFFSET, 0xFFU);
+	XRFdc_WriteReg(InstancePtr, XRFDC_IP_BASE, XRFDC_ADC_PATHS_ENABLED_OFFSET, 0xFFFFFFFFU);
+	XRFdc_WriteReg(InstancePtr, XRFDC_IP_BASE, XRFDC_DAC_PATHS_ENABLED_OFFSET, 0xFFFFFFFFU);
+	for (Tile = 0U; Tile <= XRFDC_TILE_ID_MAX; Tile++) {
+		InstancePtr->ADC_Tile[Tile].PLL_Settings.SampleRate = ADC_SAMPLING_RATE;
+		InstancePtr->DAC_Tile[Tile].PLL_Settings.SampleRate = DAC_SAMPLING_RATE;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function sets the mixer of a block to a fine mixer.
+*
+* @param	InstancePtr is a pointer to the XRfdc instance.
+* @param	Type indicates ADC/DAC.
+* @param	Tile is the tile number.
+* @param	Block is the block number.
+* @param	Freq is the NCO frequency in MHz.
+* @param	PhaseOffset is the NCO phase offset in degrees.
+* @param	EventSource is the update event source.
+*
+* @return
+*		- XRFDC_SUCCESS if successful.
+*		- XRFDC_FAILURE otherwise.
+*
+****************************************************************************/
+static u32 SetFineMixer(XRFdc *InstancePtr, u32 Type, u32 Tile, u32 Block, double Freq, double PhaseOffset,
+			u32 EventSource)
+{
+	XRFdc_Mixer_Settings Mixer;
+
+	memset(&Mixer, 0, sizeof(Mixer));
+	Mixer.Freq = Freq;
+	Mixer.PhaseOffset = PhaseOffset;
+	Mixer.EventSource = EventSource;
+	Mixer.CoarseMixFreq = XRFDC_COARSE_MIX_OFF;
+	Mixer.MixerMode = (Type == XRFDC_ADC_TILE) ? XRFDC_MIXER_MODE_R2C : XRFDC_MIXER_MODE_C2R;
+	Mixer.MixerType = XRFDC_MIXER_TYPE_FINE;
+	Mixer.FineMixerScale = XRFDC_MIXER_SCALE_1P0;
+
+	return XRFdc_SetMixerSettings(InstancePtr, Type, Tile, Block, &Mixer);
+}
+
+/****************************************************************************/
+/**
+*
+* This function checks the writes logged during a commit against the blocks
+* of the hop. The NCO registers of every physical block must be written once
+* each, before the update events, and the update event of a tile must be
+* triggered once for tile events and never for SYSREF events.
+*
+* @param	NumBlocks is the number of entries in the hop.
+* @param	EventSource is the update event source of the hop.
+* @param	HopNum is the hop number, for the error message.
+*
+* @return
+*		- XRFDC_SUCCESS if the commit wrote the expected registers.
+*		- XRFDC_FAILURE otherwise.
+*
+****************************************************************************/
+static int CheckCommitWrites(u32 NumBlocks, u32 EventSource, u32 HopNum)
+{
+	u32 Expected[XRFDC_NCO_HOP_MAX_BLOCKS * NCO_REGS_PER_BLOCK];
+	u32 Events[2U * (XRFDC_TILE_ID_MAX + 1U)];
+	u32 NumExpected = 0U;
+	u32 NumEvents = 0U;
+	u32 Entry;
+	u32 Block;
+	u32 LastBlock;
+	u32 Index;
+	u32 Reg;
+	u32 Found;
+	const RegWrite *WritePtr;
+
+	memset(Events, 0, sizeof(Events));
+	for (Entry = 0U; Entry < NumBlocks; Entry++) {
+		Block = Blocks[Entry].Block_Id;
+		LastBlock = Block;
+		if ((Blocks[Entry].Type == XRFDC_ADC_TILE) && (DevHop.Inst.ADC4GSPS == XRFDC_ENABLED)) {
+			Block *= 2U;
+			LastBlock = Block + 1U;
+		}
+		for (; Block <= LastBlock; Block++) {
+			for (Reg = 0U; Reg < NCO_REGS_PER_BLOCK; Reg++) {
+				Expected[NumExpected++] =
+					XRFDC_BLOCK_BASE(Blocks[Entry].Type, Blocks[Entry].Tile_Id, Block) + NCORegs[Reg];
+			}
+		}
+		Index = (Blocks[Entry].Type == XRFDC_ADC_TILE) ? Blocks[Entry].Tile_Id :
+								 (Blocks[Entry].Tile_Id + XRFDC_TILE_ID_MAX + 1U);
+		Events[Index] = XRFDC_DRP_BASE(Blocks[Entry].Type, Blocks[Entry].Tile_Id) + XRFDC_HSCOM_ADDR +
+				XRFDC_HSCOM_UPDT_DYN_OFFSET;
+	}
+	if (EventSource == XRFDC_EVNT_SRC_TILE) {
+		for (Index = 0U; Index < 2U * (XRFDC_TILE_ID_MAX + 1U); Index++) {
+			if (Events[Index] != 0U) {
+				Events[NumEvents++] = Events[Index];
+			}
+		}
+	}
+
+	if (DevHop.NumReads != 0U) {
+		printf("Commit of hop %u read %u registers\r\n", HopNum, DevHop.NumReads);
+		return XRFDC_FAILURE;
+	}
+	if (DevHop.NumWrites != (NumExpected + NumEvents)) {
+		printf("Commit of hop %u wrote %u registers instead of %u\r\n", HopNum, DevHop.NumWrites,
+		       NumExpected + NumEvents);
+		return XRFDC_FAILURE;
+	}
+
+	/* The NCO registers first, in any order, each one exactly once */
+	for (Index = 0U; Index < NumExpected; Index++) {
+		WritePtr = &DevHop.Log[Index];
+		Found = 0U;
+		for (Reg = 0U; Reg < NumExpected; Reg++) {
+			if (Expected[Reg] == WritePtr->Offset) {
+				Expected[Reg] = 0U;
+				Found = 1U;
+				break;
+			}
+		}
+		if (Found == 0U) {
+			printf("Commit of hop %u wrote 0x%x to unexpected register 0x%05x\r\n", HopNum, WritePtr->Value,
+			       WritePtr->Offset);
+			return XRFDC_FAILURE;
+		}
+	}
+
+	/* Then one update event per tile */
+	for (Index = NumExpected; Index < DevHop.NumWrites; Index++) {
+		WritePtr = &DevHop.Log[Index];
+		Found = 0U;
+		for (Reg = 0U; Reg < NumEvents; Reg++) {
+			if ((Events[Reg] == WritePtr->Offset) && (WritePtr->Value == 0x1U)) {
+				Events[Reg] = 0U;
+				Found = 1U;
+				break;
+			}
+		}
+		if (Found == 0U) {
+			printf("Commit of hop %u wrote 0x%x to 0x%05x instead of an update event\r\n", HopNum,
+			       WritePtr->Value, WritePtr->Offset);
+			return XRFDC_FAILURE;
+		}
+	}
+
+	return XRFDC_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the monotonic time in nanoseconds.
+*
+* @param	None.
+*
+* @return	Time in nanoseconds.
+*
+****************************************************************************/
+static double GetTimeNs(void)
+{
+	struct timespec Ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &Ts);
+
+	return Ts.tv_sec * 1e9 + Ts.tv_nsec;
+}
+
+/****************************************************************************/
+/**
+*
+* This function hops all the mixers of both devices with one event source
+* and compares the results.
+*
+* @param	EventSource is the update event source.
+*
+* @return
+*		- XRFDC_SUCCESS if both paths always gave the same result.
+*		- XRFDC_FAILURE otherwise.
+*
+****************************************************************************/
+static int HopTest(u32 EventSource)
+{
+	XRFdc *PerBlockPtr = &DevPerBlock.Inst;
+	XRFdc *HopPtr = &DevHop.Inst;
+	XRFdc_Mixer_Settings MixerPerBlock;
+	XRFdc_Mixer_Settings MixerHop;
+	double TimePerBlock = 0;
+	double TimeCompile = 0;
+	double TimeCommit = 0;
+	double Start;
+	u32 WritesPerBlock = 0U;
+	u32 WritesCommit = 0U;
+	u32 NumBlocks = 0U;
+	u32 Type;
+	u32 Tile;
+	u32 Block;
+	u32 Entry;
+	u32 i;
+
+	for (Type = XRFDC_ADC_TILE; Type <= XRFDC_DAC_TILE; Type++) {
+		for (Tile = 0U; Tile <= XRFDC_TILE_ID_MAX; Tile++) {
+			for (Block = 0U; Block <= XRFDC_BLOCK_ID_MAX; Block++) {
+				if ((Type == XRFDC_ADC_TILE) && (PerBlockPtr->ADC4GSPS == XRFDC_ENABLED) &&
+				    (Block > XRFDC_BLK_ID1)) {
+					break;
+				}
+				if ((SetFineMixer(PerBlockPtr, Type, Tile, Block, 100.0, 0.0, EventSource) !=
+				     XRFDC_SUCCESS) ||
+				    (SetFineMixer(HopPtr, Type, Tile, Block, 100.0, 0.0, EventSource) !=
+				     XRFDC_SUCCESS)) {
+					printf("Setting up the mixers failed\r\n");
+					return XRFDC_FAILURE;
+				}
+				Blocks[NumBlocks].Type = Type;
+				Blocks[NumBlocks].Tile_Id = Tile;
+				Blocks[NumBlocks].Block_Id = Block;
+				NumBlocks++;
+			}
+		}
+	}
+
+	/* A hop is only compiled for mixers using its event source */
+	if (XRFdc_CompileNCOHop(HopPtr, Blocks, NumBlocks,
+				(EventSource == XRFDC_EVNT_SRC_TILE) ? XRFDC_EVNT_SRC_SYSREF : XRFDC_EVNT_SRC_TILE,
+				&Hop) != XRFDC_FAILURE) {
+		printf("Hop compiled for the wrong event source\r\n");
+		return XRFDC_FAILURE;
+	}
+
+	for (i = 0U; i < NUM_HOPS; i++) {
+		for (Entry = 0U; Entry < NumBlocks; Entry++) {
+			Blocks[Entry].Freq = -900.0 + 13.7 * ((i * 7U + Entry) % 131U);
+			Blocks[Entry].PhaseOffset = -179.0 + ((i + Entry) % 358U);
+		}
+
+		DevPerBlock.NumWrites = 0U;
+		Start = GetTimeNs();
+		for (Entry = 0U; Entry < NumBlocks; Entry++) {
+			if (SetFineMixer(PerBlockPtr, Blocks[Entry].Type, Blocks[Entry].Tile_Id, Blocks[Entry].Block_Id,
+					 Blocks[Entry].Freq, Blocks[Entry].PhaseOffset, EventSource) != XRFDC_SUCCESS) {
+				printf("XRFdc_SetMixerSettings failed in hop %u\r\n", i);
+				return XRFDC_FAILURE;
+			}
+			if (EventSource == XRFDC_EVNT_SRC_TILE) {
+				(void)XRFdc_UpdateEvent(PerBlockPtr, Blocks[Entry].Type, Blocks[Entry].Tile_Id,
+							Blocks[Entry].Block_Id, XRFDC_EVENT_MIXER);
+			}
+		}
+		TimePerBlock += GetTimeNs() - Start;
+		WritesPerBlock += DevPerBlock.NumWrites;
+
+		Start = GetTimeNs();
+		if (XRFdc_CompileNCOHop(HopPtr, Blocks, NumBlocks, EventSource, &Hop) != XRFDC_SUCCESS) {
+			printf("XRFdc_CompileNCOHop failed in hop %u\r\n", i);
+			return XRFDC_FAILURE;
+		}
+		TimeCompile += GetTimeNs() - Start;
+
+		DevHop.NumReads = DevHop.NumWrites = 0U;
+		Start = GetTimeNs();
+		(void)XRFdc_CommitNCOHop(HopPtr, &Hop);
+		TimeCommit += GetTimeNs() - Start;
+		WritesCommit += DevHop.NumWrites;
+
+		if (CheckCommitWrites(NumBlocks, EventSource, i) != XRFDC_SUCCESS) {
+			return XRFDC_FAILURE;
+		}
+		if (memcmp(DevPerBlock.Regs, DevHop.Regs, REG_FILE_SIZE) != 0) {
+			printf("Register files differ after hop %u\r\n", i);
+			return XRFDC_FAILURE;
+		}
+		for (Entry = 0U; Entry < NumBlocks; Entry++) {
+			(void)XRFdc_GetMixerSettings(PerBlockPtr, Blocks[Entry].Type, Blocks[Entry].Tile_Id,
+						     Blocks[Entry].Block_Id, &MixerPerBlock);
+			(void)XRFdc_GetMixerSettings(HopPtr, Blocks[Entry].Type, Blocks[Entry].Tile_Id,
+						     Blocks[Entry].Block_Id, &MixerHop);
+			if ((MixerPerBlock.Freq != MixerHop.Freq) ||
+			    (MixerPerBlock.PhaseOffset != MixerHop.PhaseOffset)) {
+				printf("Mixer settings differ after hop %u\r\n", i);
+				return XRFDC_FAILURE;
+			}
+		}
+	}
+
+	printf("Gen %s, %s ADC, %s events, %u blocks, per hop: XRFdc_SetMixerSettings %.0f ns, %.1f writes; "
+	       "XRFdc_CompileNCOHop %.0f ns; XRFdc_CommitNCOHop %.0f ns, %.1f writes\r\n",
+	       (PerBlockPtr->RFdc_Config.IPType < XRFDC_GEN3) ? "1/2" : "3",
+	       (PerBlockPtr->ADC4GSPS == XRFDC_ENABLED) ? "4 GSPS" : "2 GSPS",
+	       (EventSource == XRFDC_EVNT_SRC_TILE) ? "tile" : "SYSREF", NumBlocks, TimePerBlock / NUM_HOPS,
+	       (double)WritesPerBlock / NUM_HOPS, TimeCompile / NUM_HOPS, TimeCommit / NUM_HOPS,
+	       (double)WritesCommit / NUM_HOPS);
+
+	return XRFDC_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function runs the test for one device configuration.
+*
+* @param	IPType is the IP generation.
+* @param	ADC4GSPS selects 4 GSPS ADC tiles with two blocks each.
+*
+* @return
+*		- XRFDC_SUCCESS if the test passed.
+*		- XRFDC_FAILURE otherwise.
+*
+****************************************************************************/
+static int RFdcNCOHopTest(u8 IPType, u32 ADC4GSPS)
+{
+	SetupDevice(&DevPerBlock, IPType, ADC4GSPS);
+	SetupDevice(&DevHop, IPType, ADC4GSPS);
+
+	if ((HopTest(XRFDC_EVNT_SRC_TILE) != XRFDC_SUCCESS) || (HopTest(XRFDC_EVNT_SRC_SYSREF) != XRFDC_SUCCESS)) {
+		return XRFDC_FAILURE;
+	}
+
+	return XRFDC_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Main function that runs the test for Gen 1/2 and Gen 3 devices.
+*
+* @param	None.
+*
+* @return
+*		- XRFDC_SUCCESS if the test has completed successfully.
+*		- XRFDC_FAILURE if the test has failed.
+*
+* @note		None.
+*
+*****************************************************************************/
+int main(void)
+{
+	struct metal_init_params init_param = METAL_INIT_DEFAULTS;
+
+	printf("RFdc NCO Hop Test\r\n");
+
+	if (metal_init(&init_param)) {
+		printf("ERROR: Failed to run metal initialization\n");
+		return XRFDC_FAILURE;
+	}
+
+	if ((RFdcNCOHopTest(XRFDC_GEN3 - 1U, XRFDC_DISABLED) != XRFDC_SUCCESS) ||
+	    (RFdcNCOHopTest(XRFDC_GEN3 - 1U, XRFDC_ENABLED) != XRFDC_SUCCESS) ||
+	    (RFdcNCOHopTest(XRFDC_GEN3, XRFDC_DISABLED) != XRFDC_SUCCESS)) {
+		printf("NCO Hop Test failed\r\n");
+		return XRFDC_FAILURE;
+	}
+
+	printf("Successfully ran NCO Hop Test\r\n");
+	return XRFDC_SUCCESS;
+}
@@ -0,0 +1,460 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/****************************************************************************/
+/**
+*
+* @file xrfdc_pll_retune_test.c
+*
+* Host test of the precomputed PLL solutions against an emulated register
+* file. Two driver instances are backed by libmetal I/O regions whose
+* accesses go to plain memory. One instance retunes with
+* XRFdc_DynamicPLLConfig(), the other one with a table of solutions from
+* XRFdc_CalcPLLSolution() applied with XRFdc_ApplyPLLSolution(). The test
+* checks that:
+*	- after every retune both register files and the PLL settings of both
+*	  instances are identical, for ADC and DAC tiles, when switching to and
+*	  from the external clock, and when the feedback divider register was
+*	  changed behind the driver;
+*	- the table path writes fewer registers than XRFdc_DynamicPLLConfig().
+* It then prints the CPU time and the register accesses per retune of both
+* paths. The tiles are left powered down in the register file, so the tile
+* restart, which waits for the hardware, is not part of the measured time.
+*
+* The test is built and run by the Makefile of this directory.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 8.1   cog    11/16/20 First release
+*
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "xrfdc.h"
+
+/************************** Constant Definitions ****************************/
+#define REG_FILE_SIZE (1U << 20)
+#define NUM_RATES 6U
+#define NUM_TRACE_STEPS 48U
+#define NUM_BENCH_RETUNES 20000U
+#define REF_CLK_FREQ 245.76
+
+/**************************** Type Definitions ******************************/
+typedef struct {
+	XRFdc Inst;
+	struct metal_io_region Io;
+	u8 Regs[REG_FILE_SIZE];
+	u32 NumReads;
+	u32 NumWrites;
+} RegFileDev;
+
+/************************** Function Prototypes *****************************/
+static uint64_t RegFileRead(struct metal_io_region *io, unsigned long offset, memory_order order, int width);
+static void RegFileWrite(struct metal_io_region *io, unsigned long offset, uint64_t value, memory_order order,
+			 int width);
+
+/************************** Variable Definitions ****************************/
+static const struct metal_io_ops RegFileOps = {
+	.read = RegFileRead,
+	.write = RegFileWrite,
+};
+
+/* Sampling rates in MHz, valid for Gen 1/2 and Gen 3 devices */
+static const double Rates[2][NUM_RATES] = {
+	{ 2000.0, 1966.08, 1228.8, 1500.0, 1843.2, 1024.0 },
+	{ 4000.0, 3932.16, 4915.2, 3000.0, 6000.0, 2000.0 },
+};
+
+static RegFileDev DevDynamic;
+static RegFileDev DevTable;
+static XRFdc_PLL_Solution Table[2][XRFDC_TILE_ID_MAX + 1][NUM_RATES];
+
+/****************************************************************************/
+/**
+*
+* This function reads a register of the emulated register file.
+*
+* @param	io is the I/O region of the register file.
+* @param	offset is the register offset.
+* @param	order is the memory order, unused.
+* @param	width is the access width in bytes.
+*
+* @return	Register value.
+*
+****************************************************************************/
+static uint64_t RegFileRead(struct metal_io_region *io, unsigned long offset, memory_order order, int width)
+{
+	RegFileDev *Dev = (RegFileDev *)((char *)io - offsetof(RegFileDev, Io));
+	uint64_t Value = 0U;
+
+	(void)order;
+	Dev->NumReads++;
+	memcpy(&Value, &Dev->Regs[offset], width);
+
+	return Value;
+}
+
+/****************************************************************************/
+/**
+*
+* This function writes a register of the emulated register file.
+*
+* @param	io is the I/O region of the register file.
+* @param	offset is the register offset.
+* @param	value is the value to write.
+* @param	order is the memory order, unused.
+* @param	width is the access width in bytes.
+*
+* @return	None
+*
+****************************************************************************/
+static void RegFileWrite(struct metal_io_region *io, unsigned long offset, uint64_t value, memory_order order,
+			 int width)
+{
+	RegFileDev *Dev = (RegFileDev *)((char *)io - offsetof(RegFileDev, Io));
+
+	(void)order;
+	Dev->NumWrites++;
+	memcpy(&Dev->Regs[offset], &value, width);
+}
+
+/****************************************************************************/
+/**
+*
+* This function sets up a driver instance on an emulated register file with
+* all tiles enabled and the reference clock divider set to 1.
+*
+* @param	Dev is the device to set up.
+* @param	IPType is the IP generation.
+*
+* @return	None
+*
+****************************************************************************/
+static void SetupDevice(RegFileDev *Dev, u8 IPType)
+{
+	XRFdc *InstancePtr = &Dev->Inst;
+	metal_phys_addr_t Phys = 0;
+	u32 Tile;
+
+	memset(Dev, 0, sizeof(*Dev));
+	metal_io_init(&Dev->Io, Dev->Regs, &Phys, REG_FILE_SIZE, (unsigned)-1, 0, &RegFileOps);
+	InstancePtr->io = &Dev->Io;
+	InstancePtr->IsReady = XRFDC_COMPONENT_IS_READY;
+	InstancePtr->RFdc_Config.IPType = IPType;
+
+	XRFdc_WriteReg(InstancePtr, XRFDC_IP_BASE, XRFDC_TILES_ENABLED_OFFSET, 0xFFU);
+	for (Tile = 0U; Tile <= XRFDC_TILE_ID_MAX; Tile++) {
+		XRFdc_WriteReg16(InstancePtr, XRFDC_DRP_BASE(XRFDC_ADC_TILE, Tile) + XRFDC_HSCOM_ADDR, XRFDC_PLL_REFDIV,
+				 XRFDC_REFCLK_DIV_1_MASK);
+		XRFdc_WriteReg16(InstancePtr, XRFDC_DRP_BASE(XRFDC_DAC_TILE, Tile) + XRFDC_HSCOM_ADDR, XRFDC_PLL_REFDIV,
+				 XRFDC_REFCLK_DIV_1_MASK);
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function compares the register files and the PLL settings of a tile
+* of both devices.
+*
+* @param	Type indicates ADC/DAC.
+* @param	Tile is the tile number.
+* @param	Step is the retune step, for the error message.
+*
+* @return
+*		- XRFDC_SUCCESS if both devices are in the same state.
+*		- XRFDC_FAILURE otherwise.
+*
+****************************************************************************/
+static int CompareDevices(u32 Type, u32 Tile, u32 Step)
+{
+	XRFdc_PLL_Settings *DynamicPtr;
+	XRFdc_PLL_Settings *TablePtr;
+
+	if (Type == XRFDC_ADC_TILE) {
+		DynamicPtr = &DevDynamic.Inst.ADC_Tile[Tile].PLL_Settings;
+		TablePtr = &DevTable.Inst.ADC_Tile[Tile].PLL_Settings;
+	} else {
+		DynamicPtr = &DevDynamic.Inst.DAC_Tile[Tile].PLL_Settings;
+		TablePtr = &DevTable.Inst.DAC_Tile[Tile].PLL_Settings;
+	}
+
+	if (memcmp(DevDynamic.Regs, DevTable.Regs, REG_FILE_SIZE) != 0) {
+		printf("Register files differ after step %u\r\n", Step);
+		return XRFDC_FAILURE;
+	}
+
+	if ((DynamicPtr->Enabled != TablePtr->Enabled) || (DynamicPtr->SampleRate != TablePtr->SampleRate) ||
+	    (DynamicPtr->RefClkFreq != TablePtr->RefClkFreq) ||
+	    (DynamicPtr->RefClkDivider != TablePtr->RefClkDivider) ||
+	    (DynamicPtr->FeedbackDivider != TablePtr->FeedbackDivider) ||
+	    (DynamicPtr->OutputDivider != TablePtr->OutputDivider)) {
+		printf("PLL settings differ after step %u\r\n", Step);
+		return XRFDC_FAILURE;
+	}
+
+	return XRFDC_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function retunes a tile of both devices, one with
+* XRFdc_DynamicPLLConfig() and the other one from the table.
+*
+* @param	Type indicates ADC/DAC.
+* @param	Tile is the tile number.
+* @param	Rate is the index of the sampling rate.
+*
+* @return
+*		- XRFDC_SUCCESS if both retunes succeeded.
+*		- XRFDC_FAILURE otherwise.
+*
+****************************************************************************/
+static int Retune(u32 Type, u32 Tile, u32 Rate)
+{
+	if (XRFdc_DynamicPLLConfig(&DevDynamic.Inst, Type, Tile, XRFDC_INTERNAL_PLL_CLK, REF_CLK_FREQ,
+				   Rates[Type][Rate]) != XRFDC_SUCCESS) {
+		printf("XRFdc_DynamicPLLConfig failed for %.2f MHz\r\n", Rates[Type][Rate]);
+		return XRFDC_FAILURE;
+	}
+	if (XRFdc_ApplyPLLSolution(&DevTable.Inst, Type, Tile, &Table[Type][Tile][Rate]) != XRFDC_SUCCESS) {
+		printf("XRFdc_ApplyPLLSolution failed for %.2f MHz\r\n", Rates[Type][Rate]);
+		return XRFDC_FAILURE;
+	}
+
+	return XRFDC_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function runs the register file comparison of both retune paths.
+*
+* @param	None.
+*
+* @return
+*		- XRFDC_SUCCESS if the register files always matched.
+*		- XRFDC_FAILURE otherwise.
+*
+****************************************************************************/
+static int CheckRegisterFiles(void)
+{
+	XRFdc *DynamicPtr = &DevDynamic.Inst;
+	XRFdc *TablePtr = &DevTable.Inst;
+	u32 Step;
+	u32 Type;
+	u32 Tile;
+	u16 FbDiv;
+
+	for (Step = 0U; Step < NUM_TRACE_STEPS; Step++) {
+		Type = Step & 1U;
+		Tile = (Step >> 1) & XRFDC_TILE_ID_MAX;
+		if (Retune(Type, Tile, (Step * 7U) % NUM_RATES) != XRFDC_SUCCESS) {
+			return XRFDC_FAILURE;
+		}
+		if (CompareDevices(Type, Tile, Step) != XRFDC_SUCCESS) {
+			return XRFDC_FAILURE;
+		}
+	}
+
+	/* External clock and back to the PLL */
+	for (Type = XRFDC_ADC_TILE; Type <= XRFDC_DAC_TILE; Type++) {
+		if ((XRFdc_DynamicPLLConfig(DynamicPtr, Type, 0U, XRFDC_EXTERNAL_CLK, Rates[Type][0U],
+					    Rates[Type][0U]) != XRFDC_SUCCESS) ||
+		    (XRFdc_DynamicPLLConfig(TablePtr, Type, 0U, XRFDC_EXTERNAL_CLK, Rates[Type][0U], Rates[Type][0U]) !=
+		     XRFDC_SUCCESS)) {
+			printf("Switching to the external clock failed\r\n");
+			return XRFDC_FAILURE;
+		}
+		if (CompareDevices(Type, 0U, Step) != XRFDC_SUCCESS) {
+			return XRFDC_FAILURE;
+		}
+		if ((Retune(Type, 0U, 1U) != XRFDC_SUCCESS) || (CompareDevices(Type, 0U, Step + 1U) != XRFDC_SUCCESS)) {
+			return XRFDC_FAILURE;
+		}
+	}
+
+	/* Feedback divider changed behind the driver */
+	FbDiv = XRFdc_ReadReg16(TablePtr, XRFDC_DRP_BASE(XRFDC_DAC_TILE, 0U) + XRFDC_HSCOM_ADDR, XRFDC_PLL_FPDIV);
+	XRFdc_WriteReg16(DynamicPtr, XRFDC_DRP_BASE(XRFDC_DAC_TILE, 0U) + XRFDC_HSCOM_ADDR, XRFDC_PLL_FPDIV, FbDiv + 1U);
+	XRFdc_WriteReg16(TablePtr, XRFDC_DRP_BASE(XRFDC_DAC_TILE, 0U) + XRFDC_HSCOM_ADDR, XRFDC_PLL_FPDIV, FbDiv + 1U);
+	if ((Retune(XRFDC_DAC_TILE, 0U, 1U) != XRFDC_SUCCESS) ||
+	    (CompareDevices(XRFDC_DAC_TILE, 0U, Step + 2U) != XRFDC_SUCCESS)) {
+		return XRFDC_FAILURE;
+	}
+
+	return XRFDC_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the monotonic time in nanoseconds.
+*
+* @param	None.
+*
+* @return	Time in nanoseconds.
+*
+****************************************************************************/
+static double GetTimeNs(void)
+{
+	struct timespec Ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &Ts);
+
+	return Ts.tv_sec * 1e9 + Ts.tv_nsec;
+}
+
+/****************************************************************************/
+/**
+*
+* This function measures the retune latency of both paths, alternating
+* between ADC and DAC tile 0 and the sampling rates of the table.
+*
+* @param	IPType is the IP generation, for the report.
+*
+* @return
+*		- XRFDC_SUCCESS if the table path writes fewer registers.
+*		- XRFDC_FAILURE otherwise.
+*
+****************************************************************************/
+static int MeasureLatency(u8 IPType)
+{
+	double TimeDynamic = 0;
+	double TimeTable = 0;
+	double Start;
+	u32 WritesDynamic;
+	u32 WritesTable;
+	u32 ReadsDynamic;
+	u32 ReadsTable;
+	u32 Type;
+	u32 Rate;
+	u32 i;
+
+	DevDynamic.NumReads = DevDynamic.NumWrites = 0U;
+	DevTable.NumReads = DevTable.NumWrites = 0U;
+	for (i = 0U; i < NUM_BENCH_RETUNES; i++) {
+		Type = i & 1U;
+		Rate = (i * 7U / 2U) % NUM_RATES;
+
+		Start = GetTimeNs();
+		(void)XRFdc_DynamicPLLConfig(&DevDynamic.Inst, Type, 0U, XRFDC_INTERNAL_PLL_CLK, REF_CLK_FREQ,
+					     Rates[Type][Rate]);
+		TimeDynamic += GetTimeNs() - Start;
+
+		Start = GetTimeNs();
+		(void)XRFdc_ApplyPLLSolution(&DevTable.Inst, Type, 0U, &Table[Type][0U][Rate]);
+		TimeTable += GetTimeNs() - Start;
+	}
+
+	ReadsDynamic = DevDynamic.NumReads;
+	WritesDynamic = DevDynamic.NumWrites;
+	ReadsTable = DevTable.NumReads;
+	WritesTable = DevTable.NumWrites;
+	printf("Gen %s, per retune: XRFdc_DynamicPLLConfig %.0f ns, %.1f reads, %.1f writes; "
+	       "XRFdc_ApplyPLLSolution %.0f ns, %.1f reads, %.1f writes\r\n",
+	       (IPType < XRFDC_GEN3) ? "1/2" : "3", TimeDynamic / NUM_BENCH_RETUNES,
+	       (double)ReadsDynamic / NUM_BENCH_RETUNES, (double)WritesDynamic / NUM_BENCH_RETUNES,
+	       TimeTable / NUM_BENCH_RETUNES, (double)ReadsTable / NUM_BENCH_RETUNES,
+	       (double)WritesTable / NUM_BENCH_RETUNES);
+
+	if (WritesTable >= WritesDynamic) {
+		printf("The table path does not write fewer registers\r\n");
+		return XRFDC_FAILURE;
+	}
+
+	return XRFDC_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function runs the test for one IP generation.
+*
+* @param	IPType is the IP generation.
+*
+* @return
+*		- XRFDC_SUCCESS if the test passed.
+*		- XRFDC_FAILURE otherwise.
+*
+****************************************************************************/
+static int RFdcPLLRetuneTest(u8 IPType)
+{
+	u32 Type;
+	u32 Tile;
+	u32 Rate;
+
+	SetupDevice(&DevDynamic, IPType);
+	SetupDevice(&DevTable, IPType);
+
+	for (Type = XRFDC_ADC_TILE; Type <= XRFDC_DAC_TILE; Type++) {
+		for (Tile = 0U; Tile <= XRFDC_TILE_ID_MAX; Tile++) {
+			for (Rate = 0U; Rate < NUM_RATES; Rate++) {
+				if (XRFdc_CalcPLLSolution(&DevTable.Inst, Type, Tile, REF_CLK_FREQ, Rates[Type][Rate],
+							  &Table[Type][Tile][Rate]) != XRFDC_SUCCESS) {
+					printf("XRFdc_CalcPLLSolution failed for %.2f MHz\r\n", Rates[Type][Rate]);
+					return XRFDC_FAILURE;
+				}
+			}
+		}
+	}
+
+	/* Computing the table must not touch the hardware */
+	if (DevTable.NumWrites != DevDynamic.NumWrites) {
+		printf("XRFdc_CalcPLLSolution wrote to the registers\r\n");
+		return XRFDC_FAILURE;
+	}
+
+	if (CheckRegisterFiles() != XRFDC_SUCCESS) {
+		return XRFDC_FAILURE;
+	}
+
+	return MeasureLatency(IPType);
+}
+
+/****************************************************************************/
+/**
+*
+* Main function that runs the test for Gen 1/2 and Gen 3 devices.
+*
+* @param	None.
+*
+* @return
+*		- XRFDC_SUCCESS if the test has completed successfully.
+*		- XRFDC_FAILURE if the test has failed.
+*
+* @note		None.
+*
+*****************************************************************************/
+int main(void)
+{
+	struct metal_init_params init_param = METAL_INIT_DEFAULTS;
+
+	printf("RFdc PLL Retune Test\r\n");
+
+	if (metal_init(&init_param)) {
+		printf("ERROR: Failed to run metal initialization\n");
+		return XRFDC_FAILURE;
+	}
+
+	if ((RFdcPLLRetuneTest(XRFDC_GEN3 - 1U) != XRFDC_SUCCESS) ||
+	    (RFdcPLLRetuneTest(XRFDC_GEN3) != XRFDC_SUCCESS)) {
+		printf("PLL Retune Test failed\r\n");
+		return XRFDC_FAILURE;
+	}
+
+	printf("Successfully ran PLL Retune Test\r\n");
+	return XRFDC_SUCCESS;
+}
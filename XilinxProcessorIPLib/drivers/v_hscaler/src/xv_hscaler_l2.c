@@ -30,6 +30,8 @@
 *       rco   02/09/17   Fix c++ compilation warnings
 *	jsr   09/07/18 Fix for 64-bit driver support
 * 3.3   vsa   04/07/20   Improve quality with better coefficient tables
+* 3.4   vsa   11/16/20   Split coefficient and phase calculation out of
+*                        XV_HScalerSetup() into XV_HScalerComputeSetup()
 * </pre>
 *
 ******************************************************************************/
@@ -583,6 +585,45 @@ static void XV_HScalerSetCoeff(XV_Hscaler_l2 *HscPtr)
   }
 }
 
+/*****************************************************************************/
+/**
+* This function computes the filter coefficients and the phases of a line for
+* the given scaling ratio in the instance, without accessing the core. It is
+* the calculation part of XV_HScalerSetup() and is also used by the software
+* scaler.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  WidthIn is the input stream width
+* @param  WidthOut is the output stream width
+*
+* @return Pixel rate (input to output width ratio in 16.16 fixed point)
+*
+******************************************************************************/
+u32 XV_HScalerComputeSetup(XV_Hscaler_l2 *InstancePtr,
+                           u32 WidthIn,
+                           u32 WidthOut)
+{
+  u32 PixelRate;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid((WidthIn>0) && (WidthIn<=InstancePtr->Hsc.Config.MaxWidth));
+  Xil_AssertNonvoid((WidthOut>0) && (WidthOut<=InstancePtr->Hsc.Config.MaxWidth));
+
+  PixelRate = (WidthIn * STEP_PRECISION)/WidthOut;
+
+  if((InstancePtr->Hsc.Config.ScalerType == XV_HSCALER_POLYPHASE) &&
+     (!InstancePtr->UseExtCoeff))  //No user defined coefficients
+  {
+    /* Determine coefficient table to use */
+    XV_HScalerSelectCoeff(InstancePtr, WidthIn, WidthOut);
+  }
+
+  /* Compute Phase for 1 line */
+  CalculatePhases(InstancePtr, WidthIn, WidthOut, PixelRate);
+
+  return(PixelRate);
+}
+
 /*****************************************************************************/
 /**
 * This function configures the scaler core registers with the specified
@@ -623,22 +664,14 @@ int XV_HScalerSetup(XV_Hscaler_l2  *InstancePtr,
     return XST_FAILURE;
   }
 
-  PixelRate = (WidthIn * STEP_PRECISION)/WidthOut;
+  PixelRate = XV_HScalerComputeSetup(InstancePtr, WidthIn, WidthOut);
 
   if(InstancePtr->Hsc.Config.ScalerType == XV_HSCALER_POLYPHASE)
   {
-    if(!InstancePtr->UseExtCoeff)  //No user defined coefficients
-    {
-      /* Determine coefficient table to use */
-      XV_HScalerSelectCoeff(InstancePtr, WidthIn, WidthOut);
-    }
     /* Program generated coefficients into the IP register bank */
     XV_HScalerSetCoeff(InstancePtr);
   }
 
-  /* Compute Phase for 1 line */
-  CalculatePhases(InstancePtr, WidthIn, WidthOut, PixelRate);
-
   /* Program computed Phase into the IP register bank */
   XV_HScalerSetPhase(InstancePtr);
 
@@ -58,6 +58,13 @@
 * This driver is not thread safe. Any needs for threads or thread mutual
 * exclusion must be satisfied by the layer above this driver.
 *
+* <b>Software Scaler</b>
+*
+* XV_HScalerSwScalePlane() scales a plane of one color component in software
+* with the coefficients and phases XV_HScalerSetup() would program, for
+* polyphase scaler instances. It can be used to check or preview the output of
+* the core, or as a CPU fallback for small images.
+*
 * <b>Limitations</b>
 *
 * <pre>
@@ -70,6 +77,8 @@
 *       dmc   12/17/15   Add macro to query the Is422Enabled flag that was
 *                        added to the XV_hscaler_Config structure
 * 3.0   mpe   04/28/16   Added optional color format conversion handling
+* 3.4   vsa   11/16/20   Added XV_HScalerComputeSetup() and the software
+*                        scaler XV_HScalerSwScalePlane()
 * </pre>
 *
 ******************************************************************************/
@@ -174,6 +183,9 @@ void XV_HScalerLoadExtCoeff(XV_Hscaler_l2 *InstancePtr,
                             u16 num_phases,
                             u16 num_taps,
                             const short *Coeff);
+u32 XV_HScalerComputeSetup(XV_Hscaler_l2 *InstancePtr,
+                           u32 WidthIn,
+                           u32 WidthOut);
 int XV_HScalerSetup(XV_Hscaler_l2  *InstancePtr,
                      u32 HeightIn,
                      u32 WidthIn,
@@ -184,6 +196,14 @@ int XV_HScalerValidateConfig(XV_Hscaler_l2 *InstancePtr,
                              u32 ColorFormatIn,
                              u32 ColorFormatOut);
 void XV_HScalerDbgReportStatus(XV_Hscaler_l2 *InstancePtr);
+int XV_HScalerSwScalePlane(XV_Hscaler_l2 *InstancePtr,
+                           u32 WidthIn,
+                           u32 WidthOut,
+                           u32 Height,
+                           const u16 *SrcPtr,
+                           u32 SrcStride,
+                           u16 *DstPtr,
+                           u32 DstStride);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,300 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xv_hscaler_sw_test.c
+*
+* Golden vector check of the software horizontal scaler, run on a host. The
+* expected outputs are read off the coefficient tables of the driver, so the
+* check does not depend on the software scaler itself:
+*  - at 1:1 every output pixel uses phase 0 of the Lanczos2 table, which only
+*    passes the sample at the filter position, so the output equals the input;
+*  - at 1:2 the output pixels alternate between phase 0 and phase 32 of the
+*    Lanczos2 table, and an impulse sample on a flat background gives the
+*    background plus the coefficients of these phases;
+*  - at 3:4 the output pixels step through phases 0, 48, 32 and 16 of the
+*    Lanczos2 table, reading a new input sample at each phase but 48;
+*  - at 2:1 every output pixel uses phase 0 of the 6 tap table for a scaling
+*    ratio of 2, and an impulse sample gives the background plus the
+*    coefficients of that phase.
+* The checks are run for each number of pixels per clock, which changes the
+* layout of the phase words computed by XV_HScalerSetup(). The 1:1, 1:2 and
+* 3:4 checks are also run for each tap count, which selects the same 6 tap
+* table placed at the center of the wider filter.
+*
+* After the checks, the test prints the time the software scaler takes to
+* scale the 3 planes of a frame with 6 and 12 taps, from 1920 to 1280 pixels
+* on 720 lines and from 1280 to 1920 pixels on 1080 lines, which are the
+* horizontal passes of 1080p to 720p and 720p to 1080p after the vertical
+* pass. Time is measured with XTime_GetTime().
+*
+* The test is built and run on the build machine by the Makefile of this
+* directory.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 3.4   vsa   11/16/20   Initial Release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include "xtime_l.h"
+#include "xv_hscaler_l2.h"
+
+/************************** Constant Definitions *****************************/
+#define TEST_WIDTH          (16)
+#define TEST_HEIGHT         (21)
+#define TEST_DATA_WIDTH     (16)
+#define TEST_BACKGROUND     (8192)
+#define TEST_IMPULSE        (4096)
+#define PERF_WIDTH          (1920)
+#define PERF_HEIGHT         (1080)
+#define PERF_DATA_WIDTH     (10)
+#define PERF_FRAMES         (10)
+#define PERF_PLANES         (3)
+
+/**************************** Local Global *******************************/
+static XV_Hscaler_l2 Hsc;
+static u16 SrcPlane[TEST_HEIGHT * TEST_WIDTH];
+static u16 DstPlane[TEST_HEIGHT * 2 * TEST_WIDTH];
+static u16 PerfSrcPlane[PERF_HEIGHT * PERF_WIDTH];
+static u16 PerfDstPlane[PERF_HEIGHT * PERF_WIDTH];
+
+/*
+ * 1:2 of an impulse at sample 8: the odd pixels 11 to 21 are interpolated
+ * with phase 32 of XV_hscaler_Lanczos2_taps6,
+ * {-97, -268, 2413, 2413, -268, -97}
+ */
+static const u16 GoldenUp[TEST_WIDTH * 2] = {
+  8192, 8192, 8192, 8192, 8192, 8192, 8192, 8192,
+  8192, 8192, 8192, 8095, 8192, 7924, 8192, 10605,
+  12288, 10605, 8192, 7924, 8192, 8095, 8192, 8192,
+  8192, 8192, 8192, 8192, 8192, 8192, 8192, 8192,
+};
+
+/*
+ * 3:4 of an impulse at sample 6: output pixels 5 to 11 are filtered with
+ * phases 48, 32, 16 and 0 of XV_hscaler_Lanczos2_taps6, phase 16 being
+ * {-45, -353, 3661, 982, -75, -74} and phase 48 its mirror
+ * {-73, -75, 982, 3661, -353, -46}
+ */
+static const u16 GoldenUp34[TEST_WIDTH] = {
+  8192, 8192, 8192, 8192, 8192, 8146, 7924, 9174,
+  12288, 9174, 7924, 8147, 8192, 8192, 8192, 8192,
+};
+
+/*
+ * 2:1 of an impulse at sample 9: output pixels 3 to 5 are filtered with
+ * phase 0 of XV_hscaler_fixedcoeff_taps6_ScalingRatio2,
+ * {0, 970, 2235, 970, 0, -79}
+ */
+static const u16 GoldenDown[TEST_WIDTH / 2] = {
+  8192, 8192, 8192, 8113, 9162, 9162, 8192, 8192,
+};
+
+/*****************************************************************************/
+/**
+* This function sets up the instance for a polyphase core with the given
+* number of pixels per clock and taps, without accessing the core.
+*
+* @param  PixPerClk is the number of pixels per clock of the core
+* @param  NumTaps is the number of taps of the core
+*
+* @return None
+*
+******************************************************************************/
+static void ConfigScaler(u16 PixPerClk, u16 NumTaps)
+{
+  memset(&Hsc, 0, sizeof(Hsc));
+  Hsc.Hsc.Config.PixPerClk = PixPerClk;
+  Hsc.Hsc.Config.NumVidComponents = 3;
+  Hsc.Hsc.Config.MaxWidth = TEST_WIDTH * 2;
+  Hsc.Hsc.Config.MaxHeight = TEST_HEIGHT;
+  Hsc.Hsc.Config.MaxDataWidth = TEST_DATA_WIDTH;
+  Hsc.Hsc.Config.PhaseShift = 6;
+  Hsc.Hsc.Config.ScalerType = XV_HSCALER_POLYPHASE;
+  Hsc.Hsc.Config.NumTaps = NumTaps;
+  Hsc.Hsc.IsReady = XIL_COMPONENT_IS_READY;
+}
+
+/*****************************************************************************/
+/**
+* This function scales the source plane and compares each line of the output
+* with the golden vector.
+*
+* @param  WidthIn is the input frame width
+* @param  WidthOut is the scaled frame width
+* @param  GoldenPtr is the expected output line, NULL if the output must be
+*         the input
+*
+* @return Number of output samples which differ from the golden vector
+*
+******************************************************************************/
+static u32 CheckScaler(u32 WidthIn, u32 WidthOut, const u16 *GoldenPtr)
+{
+  u32 Errors = 0;
+  u32 x, y;
+  u16 Expected;
+
+  if (XV_HScalerSwScalePlane(&Hsc, WidthIn, WidthOut, TEST_HEIGHT, SrcPlane,
+                             WidthIn, DstPlane, WidthOut) != XST_SUCCESS)
+  {
+    return(WidthOut * TEST_HEIGHT);
+  }
+
+  for (y = 0; y < TEST_HEIGHT; y++)
+  {
+    for (x = 0; x < WidthOut; x++)
+    {
+      Expected = (GoldenPtr == NULL) ? SrcPlane[y * WidthIn + x] :
+                                       GoldenPtr[x];
+      if (DstPlane[y * WidthOut + x] != Expected)
+      {
+        Errors++;
+      }
+    }
+  }
+
+  return(Errors);
+}
+
+/*****************************************************************************/
+/**
+* This function fills the lines of the source plane with a flat background and
+* one impulse sample.
+*
+* @param  WidthIn is the input frame width
+* @param  Sample is the sample of the impulse
+*
+* @return None
+*
+******************************************************************************/
+static void FillImpulse(u32 WidthIn, u32 Sample)
+{
+  u32 x, y;
+
+  for (y = 0; y < TEST_HEIGHT; y++)
+  {
+    for (x = 0; x < WidthIn; x++)
+    {
+      SrcPlane[y * WidthIn + x] = TEST_BACKGROUND;
+    }
+    SrcPlane[y * WidthIn + Sample] = TEST_BACKGROUND + TEST_IMPULSE;
+  }
+}
+
+/*****************************************************************************/
+/**
+* This function times the software scaler on the planes of a frame and prints
+* the time per frame.
+*
+* @param  NumTaps is the number of taps of the core
+* @param  SizeIn is the input frame width
+* @param  SizeOut is the scaled frame width
+* @param  Lines is the frame height
+*
+* @return 0 if the planes were scaled, 1 otherwise
+*
+******************************************************************************/
+static u32 TimeScaler(u16 NumTaps, u32 SizeIn, u32 SizeOut, u32 Lines)
+{
+  XTime Start, End;
+  u64 Usec;
+  u32 f, p, i;
+
+  memset(&Hsc, 0, sizeof(Hsc));
+  Hsc.Hsc.Config.PixPerClk = XVIDC_PPC_2;
+  Hsc.Hsc.Config.NumVidComponents = 3;
+  Hsc.Hsc.Config.MaxWidth = PERF_WIDTH;
+  Hsc.Hsc.Config.MaxHeight = PERF_HEIGHT;
+  Hsc.Hsc.Config.MaxDataWidth = PERF_DATA_WIDTH;
+  Hsc.Hsc.Config.PhaseShift = 6;
+  Hsc.Hsc.Config.ScalerType = XV_HSCALER_POLYPHASE;
+  Hsc.Hsc.Config.NumTaps = NumTaps;
+  Hsc.Hsc.IsReady = XIL_COMPONENT_IS_READY;
+
+  for (i = 0; i < PERF_HEIGHT * PERF_WIDTH; i++)
+  {
+    PerfSrcPlane[i] = (u16)((i * 7) & ((1 << PERF_DATA_WIDTH) - 1));
+  }
+
+  XTime_GetTime(&Start);
+  for (f = 0; f < PERF_FRAMES; f++)
+  {
+    for (p = 0; p < PERF_PLANES; p++)
+    {
+      if (XV_HScalerSwScalePlane(&Hsc, SizeIn, SizeOut, Lines, PerfSrcPlane,
+                                 SizeIn, PerfDstPlane, SizeOut) != XST_SUCCESS)
+      {
+        return(1);
+      }
+    }
+  }
+  XTime_GetTime(&End);
+
+  Usec = ((End - Start) * 1000000U) / COUNTS_PER_SECOND / PERF_FRAMES;
+  printf("%u taps, %u to %u pixels on %u lines: %u us per frame\r\n",
+         NumTaps, SizeIn, SizeOut, Lines, (u32)Usec);
+  return(0);
+}
+
+int main(void)
+{
+  static const u16 Ppc[] = {XVIDC_PPC_1, XVIDC_PPC_2, XVIDC_PPC_4,
+                            XVIDC_PPC_8};
+  static const u16 Taps[] = {XV_HSCALER_TAPS_6, XV_HSCALER_TAPS_8,
+                             XV_HSCALER_TAPS_10, XV_HSCALER_TAPS_12};
+  u32 Errors = 0;
+  u32 Seed = 1;
+  u32 i, p, t;
+
+  for (p = 0; p < sizeof(Ppc)/sizeof(Ppc[0]); p++)
+  {
+    for (t = 0; t < sizeof(Taps)/sizeof(Taps[0]); t++)
+    {
+      ConfigScaler(Ppc[p], Taps[t]);
+
+      for (i = 0; i < TEST_HEIGHT * TEST_WIDTH; i++)
+      {
+        Seed = Seed * 1103515245 + 12345;
+        SrcPlane[i] = (u16)(Seed >> 16);
+      }
+      Errors += CheckScaler(TEST_WIDTH, TEST_WIDTH, NULL);
+
+      FillImpulse(TEST_WIDTH, 8);
+      Errors += CheckScaler(TEST_WIDTH, TEST_WIDTH * 2, GoldenUp);
+
+      FillImpulse(TEST_WIDTH * 3 / 4, 6);
+      Errors += CheckScaler(TEST_WIDTH * 3 / 4, TEST_WIDTH, GoldenUp34);
+    }
+
+    ConfigScaler(Ppc[p], XV_HSCALER_TAPS_6);
+    FillImpulse(TEST_WIDTH, 9);
+    Errors += CheckScaler(TEST_WIDTH, TEST_WIDTH / 2, GoldenDown);
+  }
+
+  Errors += TimeScaler(XV_HSCALER_TAPS_6, 1920, 1280, 720);
+  Errors += TimeScaler(XV_HSCALER_TAPS_6, 1280, 1920, 1080);
+  Errors += TimeScaler(XV_HSCALER_TAPS_12, 1920, 1280, 720);
+  Errors += TimeScaler(XV_HSCALER_TAPS_12, 1280, 1920, 1080);
+
+  if (Errors != 0)
+  {
+    printf("%u samples differ from the golden vectors\r\n", Errors);
+    printf("Software horizontal scaler golden vector check failed\r\n");
+    return(1);
+  }
+
+  printf("Successfully ran software horizontal scaler golden vector check\r\n");
+  return(0);
+}
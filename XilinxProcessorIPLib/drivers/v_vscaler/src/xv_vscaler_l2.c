@@ -27,6 +27,9 @@
 *       rco   02/09/17   Fix c++ compilation warnings
 *	jsr   09/07/18 Fix for 64-bit driver support
 * 3.1   vsa   04/07/20   Improve quality with new coefficients
+* 3.2   vsa   11/16/20   Split coefficient calculation out of
+*                        XV_VScalerSetup() into XV_VScalerComputeSetup(),
+*                        added XV_VScalerComputePhases()
 *
 * </pre>
 *
@@ -46,6 +49,8 @@
 /**************************** Type Definitions *******************************/
 
 /**************************** Local Global *******************************/
+static const int STEP_PRECISION_SHIFT = 16;
+
 extern const short XV_vscaler_Lanczos2_taps6[XV_VSCALER_MAX_V_PHASES][XV_VSCALER_TAPS_6];
 extern const short XV_vscaler_fixedcoeff_taps6_ScalingRatio1p2[XV_VSCALER_MAX_V_PHASES][XV_VSCALER_TAPS_6];
 extern const short XV_vscaler_fixedcoeff_taps6_ScalingRatio2[XV_VSCALER_MAX_V_PHASES][XV_VSCALER_TAPS_6];
@@ -353,6 +358,98 @@ static void XV_VScalerSetCoeff(XV_Vscaler_l2 *VscPtr)
   }
 }
 
+/*****************************************************************************/
+/**
+* This function computes the filter coefficients for the given scaling ratio in
+* the instance, without accessing the core. It is the calculation part of
+* XV_VScalerSetup() and is also used by the software scaler.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  HeightIn is the input stream height
+* @param  HeightOut is the output stream height
+*
+* @return Line rate (input to output height ratio in 16.16 fixed point)
+*
+******************************************************************************/
+u32 XV_VScalerComputeSetup(XV_Vscaler_l2 *InstancePtr,
+                           u32 HeightIn,
+                           u32 HeightOut)
+{
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid((HeightIn>0) && (HeightIn<=InstancePtr->Vsc.Config.MaxHeight));
+  Xil_AssertNonvoid((HeightOut>0) && (HeightOut<=InstancePtr->Vsc.Config.MaxHeight));
+
+  if((InstancePtr->Vsc.Config.ScalerType == XV_VSCALER_POLYPHASE) &&
+     (!InstancePtr->UseExtCoeff)) //No user defined coefficients
+  {
+    /* Determine coefficient table to use */
+    XV_VScalerSelectCoeff(InstancePtr,  HeightIn, HeightOut);
+  }
+
+  return((HeightIn * STEP_PRECISION)/HeightOut);
+}
+
+/*****************************************************************************/
+/**
+* This function computes the phase word of each step of the line loop of the
+* core for the given line rate. The core steps through the lines the same way
+* the horizontal scaler steps through the pixels of a line, see
+* CalculatePhases() of the horizontal scaler driver, with one line per step.
+* The phase of a step is taken before the step reads a new input line.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  HeightIn is the input stream height
+* @param  HeightOut is the output stream height
+* @param  LineRate is the line rate returned by XV_VScalerComputeSetup()
+* @param  PhasesV is the array the phase words are written to, it must hold
+*         the larger of HeightIn and HeightOut entries
+*
+* @return Number of steps of the line loop
+*
+******************************************************************************/
+u32 XV_VScalerComputePhases(XV_Vscaler_l2 *InstancePtr,
+                            u32 HeightIn,
+                            u32 HeightOut,
+                            u32 LineRate,
+                            u8 *PhasesV)
+{
+  u32 LoopHeight;
+  u32 y;
+  u32 offset = 0;
+  u32 yWritePos = 0;
+  u32 PhaseV;
+  u32 MaxPhases;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(PhasesV != NULL);
+
+  MaxPhases = (1<<InstancePtr->Vsc.Config.PhaseShift);
+  LoopHeight = ((HeightIn > HeightOut) ? HeightIn : HeightOut);
+
+  for (y=0; y<LoopHeight; y++)
+  {
+    PhaseV = (offset>>(STEP_PRECISION_SHIFT-InstancePtr->Vsc.Config.PhaseShift)) & (MaxPhases-1);
+    if ((offset >> STEP_PRECISION_SHIFT) != 0)
+    {
+      // read a new input line
+      PhaseV |= XV_VSCALER_PHASE_NEW_LINE;
+      offset = offset - (1<<STEP_PRECISION_SHIFT);
+    }
+
+    if (((offset >> STEP_PRECISION_SHIFT) == 0) && (yWritePos < HeightOut))
+    {
+      // produce a new output line
+      PhaseV |= XV_VSCALER_PHASE_WRITE_EN;
+      offset += LineRate;
+      yWritePos++;
+    }
+
+    PhasesV[y] = (u8)PhaseV;
+  }
+
+  return(LoopHeight);
+}
+
 /*****************************************************************************/
 /**
 * This function configures the scaler core registers with the specified
@@ -389,20 +486,14 @@ int XV_VScalerSetup(XV_Vscaler_l2  *InstancePtr,
     return(XST_FAILURE);
   }
 
+  LineRate = XV_VScalerComputeSetup(InstancePtr, HeightIn, HeightOut);
+
   if(InstancePtr->Vsc.Config.ScalerType == XV_VSCALER_POLYPHASE)
   {
-    if(!InstancePtr->UseExtCoeff) //No user defined coefficients
-    {
-      /* Determine coefficient table to use */
-      XV_VScalerSelectCoeff(InstancePtr,  HeightIn, HeightOut);
-    }
-
     /* Program coefficients into the IP register bank */
     XV_VScalerSetCoeff(InstancePtr);
   }
 
-  LineRate = (HeightIn * STEP_PRECISION)/HeightOut;
-
   XV_vscaler_Set_HwReg_HeightIn(&InstancePtr->Vsc,   HeightIn);
   XV_vscaler_Set_HwReg_Width(&InstancePtr->Vsc,      WidthIn);
   XV_vscaler_Set_HwReg_HeightOut(&InstancePtr->Vsc,  HeightOut);
@@ -58,6 +58,14 @@
 * This driver is not thread safe. Any needs for threads or thread mutual
 * exclusion must be satisfied by the layer above this driver.
 *
+* <b>Software Scaler</b>
+*
+* XV_VScalerSwScalePlane() scales a plane of one color component in software
+* with the coefficients XV_VScalerSetup() would program and the line phases
+* the core derives from the programmed line rate, for polyphase scaler
+* instances. It can be used to check or preview the output of the core, or as
+* a CPU fallback for small images.
+*
 * <b>Limitations</b>
 *
 * <pre>
@@ -69,6 +77,9 @@
 * 2.00  rco   11/05/15   Integrate layer-1 with layer-2
 * 3.0   mpe   04/28/16   Added optional color format conversion handling
 * 3.1   vsa   04/07/20   Improve quality with new coefficients
+* 3.2   vsa   11/16/20   Added XV_VScalerComputeSetup(),
+*                        XV_VScalerComputePhases() and the software scaler
+*                        XV_VScalerSwScalePlane()
 *
 * </pre>
 *
@@ -92,6 +103,18 @@ extern "C" {
  #define XV_VSCALER_MAX_V_TAPS           (12)
  #define XV_VSCALER_MAX_V_PHASES         (64)
 
+ /** @name Line Phase Word
+  * @{
+  * Each step of the line loop of the core, as computed by
+  * XV_VScalerComputePhases(), is described by a phase word holding the phase,
+  * a flag set when a new input line is read and a flag set when an output
+  * line is written
+  */
+ #define XV_VSCALER_PHASE_MASK           (0x3F)
+ #define XV_VSCALER_PHASE_NEW_LINE       (0x40)
+ #define XV_VSCALER_PHASE_WRITE_EN       (0x80)
+ /*@}*/
+
 /**************************** Type Definitions *******************************/
 /**
  * This typedef eumerates the Scaler Type
@@ -148,12 +171,28 @@ void XV_VScalerLoadExtCoeff(XV_Vscaler_l2 *InstancePtr,
                             u16 num_phases,
                             u16 num_taps,
                             const short *Coeff);
+u32 XV_VScalerComputeSetup(XV_Vscaler_l2 *InstancePtr,
+                           u32 HeightIn,
+                           u32 HeightOut);
+u32 XV_VScalerComputePhases(XV_Vscaler_l2 *InstancePtr,
+                            u32 HeightIn,
+                            u32 HeightOut,
+                            u32 LineRate,
+                            u8 *PhasesV);
 int XV_VScalerSetup(XV_Vscaler_l2  *InstancePtr,
                     u32 WidthIn,
                     u32 HeightIn,
                     u32 HeightOut,
                     u32 ColorFormat);
 void XV_VScalerDbgReportStatus(XV_Vscaler_l2 *InstancePtr);
+int XV_VScalerSwScalePlane(XV_Vscaler_l2 *InstancePtr,
+                           u32 Width,
+                           u32 HeightIn,
+                           u32 HeightOut,
+                           const u16 *SrcPtr,
+                           u32 SrcStride,
+                           u16 *DstPtr,
+                           u32 DstStride);
 
 #ifdef __cplusplus
 }
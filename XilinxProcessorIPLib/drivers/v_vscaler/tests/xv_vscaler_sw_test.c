@@ -0,0 +1,289 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xv_vscaler_sw_test.c
+*
+* Golden vector check of the software vertical scaler, run on a host. The
+* expected outputs are read off the coefficient tables of the driver, so the
+* check does not depend on the software scaler itself:
+*  - at 1:1 every output line uses phase 0 of the Lanczos2 table, which only
+*    passes the line at the filter position, so the output equals the input;
+*  - at 1:2 the output lines alternate between phase 0 and phase 32 of the
+*    Lanczos2 table, and an impulse line on a flat background gives the
+*    background plus the coefficients of these phases;
+*  - at 3:4 the output lines step through phases 0, 48, 32 and 16 of the
+*    Lanczos2 table, reading a new input line at each phase but 48;
+*  - at 2:1 every output line uses phase 0 of the 6 tap table for a scaling
+*    ratio of 2, and an impulse line gives the background plus the
+*    coefficients of that phase.
+* The 1:1, 1:2 and 3:4 checks are run for each tap count, which selects the
+* same 6 tap table placed at the center of the wider filter.
+*
+* After the checks, the test prints the time the software scaler takes to
+* scale the 3 planes of a frame with 6 and 12 taps, from 1080 to 720 lines of
+* 1920 pixels and from 720 to 1080 lines of 1280 pixels, which are the
+* vertical passes of 1080p to 720p and 720p to 1080p. Time is measured with
+* XTime_GetTime().
+*
+* The test is built and run on the build machine by the Makefile of this
+* directory.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 3.2   vsa   11/16/20   Initial Release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <string.h>
+#include "xtime_l.h"
+#include "xv_vscaler_l2.h"
+
+/************************** Constant Definitions *****************************/
+#define TEST_WIDTH          (37)
+#define TEST_HEIGHT         (16)
+#define TEST_DATA_WIDTH     (16)
+#define TEST_BACKGROUND     (8192)
+#define TEST_IMPULSE        (4096)
+#define PERF_WIDTH          (1920)
+#define PERF_HEIGHT         (1080)
+#define PERF_DATA_WIDTH     (10)
+#define PERF_FRAMES         (10)
+#define PERF_PLANES         (3)
+
+/**************************** Local Global *******************************/
+static XV_Vscaler_l2 Vsc;
+static u16 SrcPlane[TEST_HEIGHT * 2 * TEST_WIDTH];
+static u16 DstPlane[TEST_HEIGHT * 2 * TEST_WIDTH];
+static u16 PerfSrcPlane[PERF_HEIGHT * PERF_WIDTH];
+static u16 PerfDstPlane[PERF_HEIGHT * PERF_WIDTH];
+
+/*
+ * 1:2 of an impulse at line 8: the odd lines 11 to 21 are interpolated with
+ * phase 32 of XV_vscaler_Lanczos2_taps6, {-97, -268, 2413, 2413, -268, -97}
+ */
+static const u16 GoldenUp[TEST_HEIGHT * 2] = {
+  8192, 8192, 8192, 8192, 8192, 8192, 8192, 8192,
+  8192, 8192, 8192, 8095, 8192, 7924, 8192, 10605,
+  12288, 10605, 8192, 7924, 8192, 8095, 8192, 8192,
+  8192, 8192, 8192, 8192, 8192, 8192, 8192, 8192,
+};
+
+/*
+ * 3:4 of an impulse at line 6: output lines 5 to 11 are filtered with
+ * phases 48, 32, 16 and 0 of XV_vscaler_Lanczos2_taps6, phase 16 being
+ * {-45, -353, 3661, 982, -75, -74} and phase 48 its mirror
+ * {-73, -75, 982, 3661, -353, -46}
+ */
+static const u16 GoldenUp34[TEST_HEIGHT] = {
+  8192, 8192, 8192, 8192, 8192, 8146, 7924, 9174,
+  12288, 9174, 7924, 8147, 8192, 8192, 8192, 8192,
+};
+
+/*
+ * 2:1 of an impulse at line 9: output lines 3 to 5 are filtered with phase 0
+ * of XV_vscaler_fixedcoeff_taps6_ScalingRatio2, {0, 970, 2235, 970, 0, -79}
+ */
+static const u16 GoldenDown[TEST_HEIGHT / 2] = {
+  8192, 8192, 8192, 8113, 9162, 9162, 8192, 8192,
+};
+
+/*****************************************************************************/
+/**
+* This function sets up the instance for a polyphase core with the given
+* number of taps, without accessing the core.
+*
+* @param  NumTaps is the number of taps of the core
+*
+* @return None
+*
+******************************************************************************/
+static void ConfigScaler(u16 NumTaps)
+{
+  memset(&Vsc, 0, sizeof(Vsc));
+  Vsc.Vsc.Config.PixPerClk = XVIDC_PPC_1;
+  Vsc.Vsc.Config.NumVidComponents = 3;
+  Vsc.Vsc.Config.MaxWidth = TEST_WIDTH;
+  Vsc.Vsc.Config.MaxHeight = TEST_HEIGHT * 2;
+  Vsc.Vsc.Config.MaxDataWidth = TEST_DATA_WIDTH;
+  Vsc.Vsc.Config.PhaseShift = 6;
+  Vsc.Vsc.Config.ScalerType = XV_VSCALER_POLYPHASE;
+  Vsc.Vsc.Config.NumTaps = NumTaps;
+  Vsc.Vsc.IsReady = XIL_COMPONENT_IS_READY;
+}
+
+/*****************************************************************************/
+/**
+* This function scales the source plane and compares each column of the output
+* with the golden vector.
+*
+* @param  HeightIn is the input frame height
+* @param  HeightOut is the scaled frame height
+* @param  GoldenPtr is the expected output column, NULL if the output must be
+*         the input
+*
+* @return Number of output samples which differ from the golden vector
+*
+******************************************************************************/
+static u32 CheckScaler(u32 HeightIn, u32 HeightOut, const u16 *GoldenPtr)
+{
+  u32 Errors = 0;
+  u32 x, y;
+  u16 Expected;
+
+  if (XV_VScalerSwScalePlane(&Vsc, TEST_WIDTH, HeightIn, HeightOut, SrcPlane,
+                             TEST_WIDTH, DstPlane, TEST_WIDTH) != XST_SUCCESS)
+  {
+    return(TEST_WIDTH * HeightOut);
+  }
+
+  for (y = 0; y < HeightOut; y++)
+  {
+    for (x = 0; x < TEST_WIDTH; x++)
+    {
+      Expected = (GoldenPtr == NULL) ? SrcPlane[y * TEST_WIDTH + x] :
+                                       GoldenPtr[y];
+      if (DstPlane[y * TEST_WIDTH + x] != Expected)
+      {
+        Errors++;
+      }
+    }
+  }
+
+  return(Errors);
+}
+
+/*****************************************************************************/
+/**
+* This function fills the source plane with a flat background and one impulse
+* line.
+*
+* @param  Line is the line of the impulse
+*
+* @return None
+*
+******************************************************************************/
+static void FillImpulse(u32 Line)
+{
+  u32 i;
+
+  for (i = 0; i < TEST_HEIGHT * TEST_WIDTH; i++)
+  {
+    SrcPlane[i] = TEST_BACKGROUND;
+  }
+  for (i = 0; i < TEST_WIDTH; i++)
+  {
+    SrcPlane[Line * TEST_WIDTH + i] = TEST_BACKGROUND + TEST_IMPULSE;
+  }
+}
+
+/*****************************************************************************/
+/**
+* This function times the software scaler on the planes of a frame and prints
+* the time per frame.
+*
+* @param  NumTaps is the number of taps of the core
+* @param  Width is the frame width
+* @param  SizeIn is the input frame height
+* @param  SizeOut is the scaled frame height
+*
+* @return 0 if the planes were scaled, 1 otherwise
+*
+******************************************************************************/
+static u32 TimeScaler(u16 NumTaps, u32 Width, u32 SizeIn, u32 SizeOut)
+{
+  XTime Start, End;
+  u64 Usec;
+  u32 f, p, i;
+
+  memset(&Vsc, 0, sizeof(Vsc));
+  Vsc.Vsc.Config.PixPerClk = XVIDC_PPC_2;
+  Vsc.Vsc.Config.NumVidComponents = 3;
+  Vsc.Vsc.Config.MaxWidth = PERF_WIDTH;
+  Vsc.Vsc.Config.MaxHeight = PERF_HEIGHT;
+  Vsc.Vsc.Config.MaxDataWidth = PERF_DATA_WIDTH;
+  Vsc.Vsc.Config.PhaseShift = 6;
+  Vsc.Vsc.Config.ScalerType = XV_VSCALER_POLYPHASE;
+  Vsc.Vsc.Config.NumTaps = NumTaps;
+  Vsc.Vsc.IsReady = XIL_COMPONENT_IS_READY;
+
+  for (i = 0; i < PERF_HEIGHT * PERF_WIDTH; i++)
+  {
+    PerfSrcPlane[i] = (u16)((i * 7) & ((1 << PERF_DATA_WIDTH) - 1));
+  }
+
+  XTime_GetTime(&Start);
+  for (f = 0; f < PERF_FRAMES; f++)
+  {
+    for (p = 0; p < PERF_PLANES; p++)
+    {
+      if (XV_VScalerSwScalePlane(&Vsc, Width, SizeIn, SizeOut, PerfSrcPlane,
+                                 Width, PerfDstPlane, Width) != XST_SUCCESS)
+      {
+        return(1);
+      }
+    }
+  }
+  XTime_GetTime(&End);
+
+  Usec = ((End - Start) * 1000000U) / COUNTS_PER_SECOND / PERF_FRAMES;
+  printf("%u taps, %u to %u lines of %u pixels: %u us per frame\r\n",
+         NumTaps, SizeIn, SizeOut, Width, (u32)Usec);
+  return(0);
+}
+
+int main(void)
+{
+  static const u16 Taps[] = {XV_VSCALER_TAPS_6, XV_VSCALER_TAPS_8,
+                             XV_VSCALER_TAPS_10, XV_VSCALER_TAPS_12};
+  u32 Errors = 0;
+  u32 Seed = 1;
+  u32 i, t;
+
+  for (t = 0; t < sizeof(Taps)/sizeof(Taps[0]); t++)
+  {
+    ConfigScaler(Taps[t]);
+
+    for (i = 0; i < TEST_HEIGHT * TEST_WIDTH; i++)
+    {
+      Seed = Seed * 1103515245 + 12345;
+      SrcPlane[i] = (u16)(Seed >> 16);
+    }
+    Errors += CheckScaler(TEST_HEIGHT, TEST_HEIGHT, NULL);
+
+    FillImpulse(8);
+    Errors += CheckScaler(TEST_HEIGHT, TEST_HEIGHT * 2, GoldenUp);
+
+    FillImpulse(6);
+    Errors += CheckScaler(TEST_HEIGHT * 3 / 4, TEST_HEIGHT, GoldenUp34);
+  }
+
+  ConfigScaler(XV_VSCALER_TAPS_6);
+  FillImpulse(9);
+  Errors += CheckScaler(TEST_HEIGHT, TEST_HEIGHT / 2, GoldenDown);
+
+  Errors += TimeScaler(XV_VSCALER_TAPS_6, 1920, 1080, 720);
+  Errors += TimeScaler(XV_VSCALER_TAPS_6, 1280, 720, 1080);
+  Errors += TimeScaler(XV_VSCALER_TAPS_12, 1920, 1080, 720);
+  Errors += TimeScaler(XV_VSCALER_TAPS_12, 1280, 720, 1080);
+
+  if (Errors != 0)
+  {
+    printf("%u samples differ from the golden vectors\r\n", Errors);
+    printf("Software vertical scaler golden vector check failed\r\n");
+    return(1);
+  }
+
+  printf("Successfully ran software vertical scaler golden vector check\r\n");
+  return(0);
+}
@@ -41,6 +41,8 @@
  * 4.3   eb   26/01/18 Added API XVidC_GetVideoModeIdExtensive
  *       jsr  02/22/18 Added XVIDC_CSF_YCBCR_420 color space format
  *       vyc  04/04/18 Added BGR8 memory format
+ * 4.10  vyc  11/16/20 Look up video mode IDs through a hashed index instead
+ *                     of searching the timing tables.
  * </pre>
  *
 *******************************************************************************/
@@ -51,17 +53,55 @@
 #include "xstatus.h"
 #include "xvidc.h"
 
+/************************** Constant Definitions ******************************/
+
+/* Number of hash buckets in the video mode index, must be a power of 2. */
+#define XVIDC_VM_INDEX_BUCKETS		256
+/* Largest custom table added to the index, larger ones are searched
+ * linearly. */
+#define XVIDC_VM_INDEX_CUSTOM_MAX	64
+#define XVIDC_VM_INDEX_NODES		(XVIDC_VM_NUM_SUPPORTED + \
+					 XVIDC_VM_INDEX_CUSTOM_MAX)
+#define XVIDC_VM_INDEX_END		0xFFFF
+
+/**************************** Type Definitions ********************************/
+
+/**
+ * Hashed index over the pre-defined and custom video timing tables, keyed on
+ * active width, active height and frame rate. Nodes below
+ * XVIDC_VM_NUM_SUPPORTED are entries of XVidC_VideoTimingModes, the others
+ * are entries of the custom table. Each chain lists the custom entries first,
+ * followed by the pre-defined entries, both in table order, so that the first
+ * match in a chain is the one the table search would return.
+ */
+typedef struct {
+	const XVidC_VideoTimingMode *CustomTable; /**< Custom table indexed */
+	int NumCustomModes;			/**< Size of the custom table */
+	u8 IsBuilt;				/**< Index has been built */
+	u16 Head[XVIDC_VM_INDEX_BUCKETS];	/**< First node of each chain */
+	u16 Next[XVIDC_VM_INDEX_NODES];		/**< Next node in the chain */
+} XVidC_VideoModeIndex;
+
 /*************************** Variable Declarations ****************************/
 extern const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED];
 
 const XVidC_VideoTimingMode *XVidC_CustomTimingModes = NULL;
 int XVidC_NumCustomModes = 0;
 
+static XVidC_VideoModeIndex XVidC_VmIndex;
+
 /**************************** Function Prototypes *****************************/
 
 static const XVidC_VideoTimingMode *XVidC_GetCustomVideoModeData(
 		XVidC_VideoMode VmId);
 static u8 XVidC_IsVtmRb(const char *VideoModeStr, u8 RbN);
+static u32 XVidC_VideoModeHash(u32 Width, u32 Height, u32 FrameRate);
+static void XVidC_BuildVideoModeIndex(void);
+static u8 XVidC_IsTimingMatch(const XVidC_VideoTimingMode *VmPtr, u32 Width,
+		u32 Height, u32 FrameRate, u8 IsInterlaced,
+		const XVidC_VideoTiming *Timing);
+static XVidC_VideoMode XVidC_FindVideoMode(u32 Width, u32 Height,
+		u32 FrameRate, u8 IsInterlaced, const XVidC_VideoTiming *Timing);
 
 /*************************** Function Definitions *****************************/
 
@@ -81,7 +121,9 @@ static u8 XVidC_IsVtmRb(const char *VideoModeStr, u8 RbN);
  *		- XST_FAILURE if an existing custom table is already present.
  *
  * @note	IDs in the custom table may not conflict with IDs reserved by
- *		the XVidC_VideoMode enum.
+ *		the XVidC_VideoMode enum. The table is indexed on the next
+ *		video mode search and must not be modified while it is
+ *		registered.
  *
 *******************************************************************************/
 u32 XVidC_RegisterCustomTimingModes(const XVidC_VideoTimingMode *CustomTable,
@@ -317,106 +359,7 @@ XVidC_VideoMode XVidC_GetVideoModeIdWBlanking(const XVidC_VideoTiming *Timing,
 XVidC_VideoMode XVidC_GetVideoModeId(u32 Width, u32 Height, u32 FrameRate,
 					u8 IsInterlaced)
 {
-	u32 Low;
-	u32 High;
-	u32 Mid;
-	u32 HActive;
-	u32 VActive;
-	u32 Rate;
-	u32 ResFound = (FALSE);
-	XVidC_VideoMode Mode;
-	u16 Index;
-
-	/* First, attempt a linear search on the custom video timing table. */
-	if(XVidC_CustomTimingModes) {
-	  for (Index = 0; Index < XVidC_NumCustomModes; Index++) {
-		HActive = XVidC_CustomTimingModes[Index].Timing.HActive;
-		VActive = XVidC_CustomTimingModes[Index].Timing.VActive;
-		Rate = XVidC_CustomTimingModes[Index].FrameRate;
-		if ((Width  == HActive) &&
-			(Height == VActive) &&
-			(FrameRate == Rate)) {
-			   return XVidC_CustomTimingModes[Index].VmId;
-		}
-	  }
-	}
-
-	if (IsInterlaced) {
-		Low = (XVIDC_VM_INTL_START);
-		High = (XVIDC_VM_INTL_END);
-	}
-	else {
-		Low = (XVIDC_VM_PROG_START);
-		High = (XVIDC_VM_PROG_END);
-	}
-
-	HActive = VActive = Rate = 0;
-
-	/* Binary search finds item in sorted array.
-	 * And returns index (zero based) of item
-	 * If item is not found returns flag remains
-	 * FALSE. Search key is "width or HActive"
-	 */
-	while (Low <= High) {
-		Mid = (Low + High) / 2;
-		HActive = XVidC_VideoTimingModes[Mid].Timing.HActive;
-		if (Width == HActive) {
-			ResFound = (TRUE);
-			break;
-		}
-		else if (Width < HActive) {
-			if (Mid == 0) {
-				break;
-			}
-			else {
-				High = Mid - 1;
-			}
-		}
-		else {
-			Low = Mid + 1;
-		}
-	}
-
-	 /* HActive matched at middle */
-	if (ResFound) {
-		/* Rewind to start index of mode with matching width */
-		while ((Mid > 0) &&
-			(XVidC_VideoTimingModes[Mid - 1].Timing.HActive ==
-								Width)) {
-			--Mid;
-		}
-
-		ResFound = (FALSE);
-		VActive = XVidC_VideoTimingModes[Mid].Timing.VActive;
-		Rate = XVidC_VideoTimingModes[Mid].FrameRate;
-
-		/* Now do a linear search for matching VActive and Frame
-		 * Rate
-		 */
-		while (HActive == Width) {
-			/* check current entry */
-			if ((VActive == Height) && (Rate == FrameRate)) {
-				ResFound = (TRUE);
-				break;
-			}
-			/* Check next entry */
-			else {
-				Mid = Mid + 1;
-				HActive =
-				XVidC_VideoTimingModes[Mid].Timing.HActive;
-				VActive =
-				XVidC_VideoTimingModes[Mid].Timing.VActive;
-				Rate = XVidC_VideoTimingModes[Mid].FrameRate;
-			}
-		}
-		Mode =
-		(ResFound) ? (XVidC_VideoMode)Mid : (XVIDC_VM_NOT_SUPPORTED);
-	}
-	else {
-		Mode = (XVIDC_VM_NOT_SUPPORTED);
-	}
-
-	return (Mode);
+	return XVidC_FindVideoMode(Width, Height, FrameRate, IsInterlaced, NULL);
 }
 
 /******************************************************************************/
@@ -444,156 +387,8 @@ XVidC_VideoMode XVidC_GetVideoModeIdExtensive(XVidC_VideoTiming *Timing,
 											  u8 IsInterlaced,
 											  u8 IsExtensive)
 {
-	u32 Low;
-	u32 High;
-	u32 Mid;
-	u32 HActive;
-	u32 VActive;
-	u32 Rate;
-	u32 ResFound = (FALSE);
-	XVidC_VideoMode Mode;
-	u16 Index;
-
-	/* First, attempt a linear search on the custom video timing table. */
-	if(XVidC_CustomTimingModes) {
-	  for (Index = 0; Index < XVidC_NumCustomModes; Index++) {
-		HActive = XVidC_CustomTimingModes[Index].Timing.HActive;
-		VActive = XVidC_CustomTimingModes[Index].Timing.VActive;
-		Rate = XVidC_CustomTimingModes[Index].FrameRate;
-		if ((HActive == Timing->HActive) && (VActive == Timing->VActive) &&
-				(Rate == FrameRate) && (IsExtensive == 0 || (
-			XVidC_CustomTimingModes[Index].Timing.HTotal == Timing->HTotal &&
-			XVidC_CustomTimingModes[Index].Timing.F0PVTotal ==
-					Timing->F0PVTotal &&
-			XVidC_CustomTimingModes[Index].Timing.HFrontPorch ==
-					Timing->HFrontPorch &&
-			XVidC_CustomTimingModes[Index].Timing.F0PVFrontPorch ==
-					Timing->F0PVFrontPorch &&
-			XVidC_CustomTimingModes[Index].Timing.HSyncWidth ==
-					Timing->HSyncWidth &&
-			XVidC_CustomTimingModes[Index].Timing.F0PVSyncWidth ==
-					Timing->F0PVSyncWidth &&
-			XVidC_CustomTimingModes[Index].Timing.VSyncPolarity ==
-					Timing->VSyncPolarity))) {
-				if (!IsInterlaced || IsExtensive == 0 || (
-						XVidC_CustomTimingModes[Index].Timing.F1VTotal ==
-						Timing->F1VTotal &&
-						XVidC_CustomTimingModes[Index].Timing.F1VFrontPorch ==
-								Timing->F1VFrontPorch &&
-						XVidC_CustomTimingModes[Index].Timing.F1VSyncWidth ==
-								Timing->F1VSyncWidth)) {
-					return XVidC_CustomTimingModes[Index].VmId;
-				}
-		}
-	  }
-	}
-
-	if (IsInterlaced) {
-		Low = (XVIDC_VM_INTL_START);
-		High = (XVIDC_VM_INTL_END);
-	}
-	else {
-		Low = (XVIDC_VM_PROG_START);
-		High = (XVIDC_VM_PROG_END);
-	}
-
-	HActive = VActive = Rate = 0;
-
-	/* Binary search finds item in sorted array.
-	 * And returns index (zero based) of item
-	 * If item is not found returns flag remains
-	 * FALSE. Search key is "Timing->HActive or HActive"
-	 */
-	while (Low <= High) {
-		Mid = (Low + High) / 2;
-		HActive = XVidC_VideoTimingModes[Mid].Timing.HActive;
-		if (Timing->HActive == HActive) {
-			ResFound = (TRUE);
-			break;
-		}
-		else if (Timing->HActive < HActive) {
-			if (Mid == 0) {
-				break;
-			}
-			else {
-				High = Mid - 1;
-			}
-		}
-		else {
-			Low = Mid + 1;
-		}
-	}
-
-	 /* HActive matched at middle */
-	if (ResFound) {
-		/* Rewind to start index of mode with matching Timing->HActive */
-		while ((Mid > 0) &&
-			(XVidC_VideoTimingModes[Mid - 1].Timing.HActive ==
-								Timing->HActive)) {
-			--Mid;
-		}
-
-		ResFound = (FALSE);
-		VActive = XVidC_VideoTimingModes[Mid].Timing.VActive;
-		Rate = XVidC_VideoTimingModes[Mid].FrameRate;
-
-		/* Now do a linear search for matching VActive and Frame
-		 * Rate
-		 */
-		while (HActive == Timing->HActive) {
-			/* check current entry */
-			if ((VActive == Timing->VActive) && (Rate == FrameRate) &&
-					(IsExtensive == 0 ||
-					(XVidC_VideoTimingModes[Mid].Timing.HTotal ==
-							Timing->HTotal &&
-					XVidC_VideoTimingModes[Mid].Timing.F0PVTotal ==
-							Timing->F0PVTotal &&
-					XVidC_VideoTimingModes[Mid].Timing.HFrontPorch ==
-							Timing->HFrontPorch &&
-					XVidC_VideoTimingModes[Mid].Timing.F0PVFrontPorch ==
-							Timing->F0PVFrontPorch &&
-					XVidC_VideoTimingModes[Mid].Timing.HSyncWidth ==
-							Timing->HSyncWidth &&
-					XVidC_VideoTimingModes[Mid].Timing.F0PVSyncWidth ==
-							Timing->F0PVSyncWidth &&
-					XVidC_VideoTimingModes[Mid].Timing.VSyncPolarity ==
-							Timing->VSyncPolarity))) {
-				if (!IsInterlaced || IsExtensive == 0 || (
-						XVidC_VideoTimingModes[Mid].Timing.F1VTotal ==
-								Timing->F1VTotal &&
-						XVidC_VideoTimingModes[Mid].Timing.F1VFrontPorch ==
-								Timing->F1VFrontPorch &&
-						XVidC_VideoTimingModes[Mid].Timing.F1VSyncWidth ==
-								Timing->F1VSyncWidth)) {
-					ResFound = (TRUE);
-					break;
-				} else {
-					Mid = Mid + 1;
-					HActive =
-					XVidC_VideoTimingModes[Mid].Timing.HActive;
-					VActive =
-					XVidC_VideoTimingModes[Mid].Timing.VActive;
-					Rate = XVidC_VideoTimingModes[Mid].FrameRate;
-				}
-			}
-			/* Check next entry */
-			else {
-				Mid = Mid + 1;
-				HActive =
-				XVidC_VideoTimingModes[Mid].Timing.HActive;
-				VActive =
-				XVidC_VideoTimingModes[Mid].Timing.VActive;
-				Rate = XVidC_VideoTimingModes[Mid].FrameRate;
-			}
-		}
-		Mode =
-		(ResFound) ? (XVidC_VideoMode)Mid : (XVIDC_VM_NOT_SUPPORTED);
-	}
-	else {
-		Mode = (XVIDC_VM_NOT_SUPPORTED);
-	}
-
-	return (Mode);
+	return XVidC_FindVideoMode(Timing->HActive, Timing->VActive, FrameRate,
+			IsInterlaced, (IsExtensive != 0) ? Timing : NULL);
 }
 
 /******************************************************************************/
@@ -1200,4 +995,207 @@ static u8 XVidC_IsVtmRb(const char *VideoModeStr, u8 RbN)
 	}
 	return 0;
 }
+
+/******************************************************************************/
+/**
+ * This function returns the hash bucket of the video mode index for the given
+ * active resolution and frame rate.
+ *
+ * @param	Width specifies the number pixels per scanline.
+ * @param	Height specifies the number of scanline's.
+ * @param	FrameRate specifies refresh rate in HZ
+ *
+ * @return	Bucket number.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static u32 XVidC_VideoModeHash(u32 Width, u32 Height, u32 FrameRate)
+{
+	u32 Key = (Width << 16) ^ (Height << 4) ^ FrameRate;
+
+	return ((Key * 2654435761U) >> 16) & (XVIDC_VM_INDEX_BUCKETS - 1);
+}
+
+/******************************************************************************/
+/**
+ * This function builds the video mode index over the pre-defined video timing
+ * table and the registered custom video timing table.
+ *
+ * @return	None.
+ *
+ * @note	Nodes are inserted at the head of the chains, so the tables
+ *		are walked backwards to keep the chains in table order.
+ *
+*******************************************************************************/
+static void XVidC_BuildVideoModeIndex(void)
+{
+	const XVidC_VideoTimingMode *VmPtr;
+	u32 Bucket;
+	u16 Index;
+
+	for (Bucket = 0; Bucket < XVIDC_VM_INDEX_BUCKETS; Bucket++) {
+		XVidC_VmIndex.Head[Bucket] = XVIDC_VM_INDEX_END;
+	}
+
+	for (Index = XVIDC_VM_NUM_SUPPORTED; Index > 0; Index--) {
+		VmPtr = &XVidC_VideoTimingModes[Index - 1];
+		Bucket = XVidC_VideoModeHash(VmPtr->Timing.HActive,
+				VmPtr->Timing.VActive, VmPtr->FrameRate);
+		XVidC_VmIndex.Next[Index - 1] = XVidC_VmIndex.Head[Bucket];
+		XVidC_VmIndex.Head[Bucket] = Index - 1;
+	}
+
+	if (XVidC_CustomTimingModes &&
+			(XVidC_NumCustomModes <= XVIDC_VM_INDEX_CUSTOM_MAX)) {
+		for (Index = XVidC_NumCustomModes; Index > 0; Index--) {
+			VmPtr = &XVidC_CustomTimingModes[Index - 1];
+			Bucket = XVidC_VideoModeHash(VmPtr->Timing.HActive,
+					VmPtr->Timing.VActive, VmPtr->FrameRate);
+			XVidC_VmIndex.Next[XVIDC_VM_NUM_SUPPORTED + Index - 1] =
+					XVidC_VmIndex.Head[Bucket];
+			XVidC_VmIndex.Head[Bucket] = XVIDC_VM_NUM_SUPPORTED + Index - 1;
+		}
+	}
+
+	XVidC_VmIndex.CustomTable    = XVidC_CustomTimingModes;
+	XVidC_VmIndex.NumCustomModes = XVidC_NumCustomModes;
+	XVidC_VmIndex.IsBuilt        = 1;
+}
+
+/******************************************************************************/
+/**
+ * This function checks whether a video timing table entry matches the
+ * supplied resolution, frame rate and, optionally, blanking.
+ *
+ * @param	VmPtr is the video timing table entry to check.
+ * @param	Width specifies the number pixels per scanline.
+ * @param	Height specifies the number of scanline's.
+ * @param	FrameRate specifies refresh rate in HZ
+ * @param	IsInterlaced is flag, the field 1 blanking is only matched
+ *		for interlaced timing.
+ * @param	Timing is the timing to match the blanking against, or NULL
+ *		to only match the resolution and frame rate.
+ *
+ * @return
+ *		- 1 if the entry matches.
+ *		- 0 otherwise.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static u8 XVidC_IsTimingMatch(const XVidC_VideoTimingMode *VmPtr, u32 Width,
+		u32 Height, u32 FrameRate, u8 IsInterlaced,
+		const XVidC_VideoTiming *Timing)
+{
+	const XVidC_VideoTiming *StdTiming = &VmPtr->Timing;
+
+	if ((StdTiming->HActive != Width) || (StdTiming->VActive != Height) ||
+			(VmPtr->FrameRate != FrameRate)) {
+		return 0;
+	}
+
+	if (!Timing) {
+		return 1;
+	}
+
+	if ((StdTiming->HTotal         != Timing->HTotal) ||
+			(StdTiming->F0PVTotal      != Timing->F0PVTotal) ||
+			(StdTiming->HFrontPorch    != Timing->HFrontPorch) ||
+			(StdTiming->F0PVFrontPorch != Timing->F0PVFrontPorch) ||
+			(StdTiming->HSyncWidth     != Timing->HSyncWidth) ||
+			(StdTiming->F0PVSyncWidth  != Timing->F0PVSyncWidth) ||
+			(StdTiming->VSyncPolarity  != Timing->VSyncPolarity)) {
+		return 0;
+	}
+
+	if (IsInterlaced &&
+			((StdTiming->F1VTotal      != Timing->F1VTotal) ||
+			(StdTiming->F1VFrontPorch  != Timing->F1VFrontPorch) ||
+			(StdTiming->F1VSyncWidth   != Timing->F1VSyncWidth))) {
+		return 0;
+	}
+
+	return 1;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the video mode ID that matches the supplied
+ * resolution, frame rate, I/P flag and, optionally, blanking. The custom
+ * video timing table is checked first, regardless of the I/P flag, followed
+ * by the interlaced or progressive part of the pre-defined video timing
+ * table. The first matching entry in table order is returned.
+ *
+ * @param	Width specifies the number pixels per scanline.
+ * @param	Height specifies the number of scanline's.
+ * @param	FrameRate specifies refresh rate in HZ
+ * @param	IsInterlaced is flag.
+ *		- 0 = Progressive
+ *		- 1 = Interlaced.
+ * @param	Timing is the timing to match the blanking against, or NULL
+ *		to only match the resolution and frame rate.
+ *
+ * @return	Id of a supported video mode.
+ *
+ * @note	The video mode index is (re)built on the first search after
+ *		the custom video timing table has changed.
+ *
+*******************************************************************************/
+static XVidC_VideoMode XVidC_FindVideoMode(u32 Width, u32 Height,
+		u32 FrameRate, u8 IsInterlaced, const XVidC_VideoTiming *Timing)
+{
+	const XVidC_VideoTimingMode *VmPtr;
+	u32 Low;
+	u32 High;
+	u16 Node;
+	u16 Index;
+
+	if (!XVidC_VmIndex.IsBuilt ||
+			(XVidC_VmIndex.CustomTable != XVidC_CustomTimingModes) ||
+			(XVidC_VmIndex.NumCustomModes != XVidC_NumCustomModes)) {
+		XVidC_BuildVideoModeIndex();
+	}
+
+	/* Custom tables too large for the index are searched linearly. */
+	if (XVidC_CustomTimingModes &&
+			(XVidC_NumCustomModes > XVIDC_VM_INDEX_CUSTOM_MAX)) {
+		for (Index = 0; Index < XVidC_NumCustomModes; Index++) {
+			VmPtr = &XVidC_CustomTimingModes[Index];
+			if (XVidC_IsTimingMatch(VmPtr, Width, Height, FrameRate,
+						IsInterlaced, Timing)) {
+				return VmPtr->VmId;
+			}
+		}
+	}
+
+	if (IsInterlaced) {
+		Low = (XVIDC_VM_INTL_START);
+		High = (XVIDC_VM_INTL_END);
+	}
+	else {
+		Low = (XVIDC_VM_PROG_START);
+		High = (XVIDC_VM_PROG_END);
+	}
+
+	Node = XVidC_VmIndex.Head[XVidC_VideoModeHash(Width, Height, FrameRate)];
+	while (Node != XVIDC_VM_INDEX_END) {
+		if (Node >= XVIDC_VM_NUM_SUPPORTED) {
+			VmPtr = &XVidC_CustomTimingModes[Node - XVIDC_VM_NUM_SUPPORTED];
+			if (XVidC_IsTimingMatch(VmPtr, Width, Height, FrameRate,
+						IsInterlaced, Timing)) {
+				return VmPtr->VmId;
+			}
+		}
+		else if ((Node >= Low) && (Node <= High) &&
+				XVidC_IsTimingMatch(&XVidC_VideoTimingModes[Node],
+					Width, Height, FrameRate, IsInterlaced,
+					Timing)) {
+			return (XVidC_VideoMode)Node;
+		}
+		Node = XVidC_VmIndex.Next[Node];
+	}
+
+	return (XVIDC_VM_NOT_SUPPORTED);
+}
 /** @} */
@@ -0,0 +1,236 @@
+/*******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+*******************************************************************************/
+
+/******************************************************************************/
+/**
+ *
+ * @file xvidc_vm_lookup_test.c
+ *
+ * Contains a test that looks up the video mode ID of every entry of the
+ * pre-defined video timing table, checks the result against a linear search
+ * of the table and prints the average lookup time.
+ *
+ * The test is built and run on the build machine by the Makefile of this
+ * directory. Time is measured with XTime_GetTime(), which the shared host
+ * stubs of the standalone BSP implement with the host clock, so the test
+ * also runs on ARM processors.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -----------------------------------------------
+ * 4.10  vyc  11/16/20 Initial release.
+ * </pre>
+ *
+*******************************************************************************/
+
+/******************************* Include Files ********************************/
+
+#include "xil_printf.h"
+#include "xstatus.h"
+#include "xtime_l.h"
+#include "xvidc.h"
+
+/************************** Constant Definitions ******************************/
+
+#define LOOKUP_PASSES	100
+
+/**************************** Function Prototypes *****************************/
+
+static XVidC_VideoMode Vm_LinearSearch(const XVidC_VideoTiming *Timing,
+		u32 FrameRate, u8 IsInterlaced, u8 IsExtensive);
+static u32 Vm_CheckLookups(void);
+static void Vm_TimeLookups(void);
+
+/*************************** Variable Declarations ****************************/
+
+extern const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED];
+
+/*************************** Function Definitions *****************************/
+
+/******************************************************************************/
+/**
+ * Main function to call the video mode lookup test.
+ *
+ * @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+int main(void)
+{
+	xil_printf("Video Mode Lookup Test\r\n");
+
+	if (Vm_CheckLookups() != XST_SUCCESS) {
+		xil_printf("Video Mode Lookup Test failed\r\n");
+		return XST_FAILURE;
+	}
+
+	Vm_TimeLookups();
+
+	xil_printf("Successfully ran Video Mode Lookup Test\r\n");
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the first entry of the interlaced or progressive part
+ * of the pre-defined video timing table that matches the supplied timing.
+ *
+ * @param	Timing is the timing to match.
+ * @param	FrameRate specifies refresh rate in HZ
+ * @param	IsInterlaced is flag.
+ *		- 0 = Progressive
+ *		- 1 = Interlaced.
+ * @param	IsExtensive selects matching of the blanking in addition to
+ *		the resolution and frame rate.
+ *
+ * @return	Id of a supported video mode.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static XVidC_VideoMode Vm_LinearSearch(const XVidC_VideoTiming *Timing,
+		u32 FrameRate, u8 IsInterlaced, u8 IsExtensive)
+{
+	const XVidC_VideoTiming *StdTiming;
+	u32 Index;
+	u32 High;
+
+	Index = IsInterlaced ? XVIDC_VM_INTL_START : XVIDC_VM_PROG_START;
+	High = IsInterlaced ? XVIDC_VM_INTL_END : XVIDC_VM_PROG_END;
+
+	for (; Index <= High; Index++) {
+		StdTiming = &XVidC_VideoTimingModes[Index].Timing;
+		if ((StdTiming->HActive != Timing->HActive) ||
+				(StdTiming->VActive != Timing->VActive) ||
+				(XVidC_VideoTimingModes[Index].FrameRate != FrameRate)) {
+			continue;
+		}
+		if (IsExtensive &&
+				((StdTiming->HTotal != Timing->HTotal) ||
+				(StdTiming->F0PVTotal != Timing->F0PVTotal) ||
+				(StdTiming->HFrontPorch != Timing->HFrontPorch) ||
+				(StdTiming->F0PVFrontPorch != Timing->F0PVFrontPorch) ||
+				(StdTiming->HSyncWidth != Timing->HSyncWidth) ||
+				(StdTiming->F0PVSyncWidth != Timing->F0PVSyncWidth) ||
+				(StdTiming->VSyncPolarity != Timing->VSyncPolarity))) {
+			continue;
+		}
+		if (IsExtensive && IsInterlaced &&
+				((StdTiming->F1VTotal != Timing->F1VTotal) ||
+				(StdTiming->F1VFrontPorch != Timing->F1VFrontPorch) ||
+				(StdTiming->F1VSyncWidth != Timing->F1VSyncWidth))) {
+			continue;
+		}
+		return (XVidC_VideoMode)Index;
+	}
+
+	return XVIDC_VM_NOT_SUPPORTED;
+}
+
+/******************************************************************************/
+/**
+ * This function checks the video mode lookup APIs against a linear search for
+ * every entry of the pre-defined video timing table.
+ *
+ * @return	XST_SUCCESS if all the lookups match, otherwise XST_FAILURE.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static u32 Vm_CheckLookups(void)
+{
+	const XVidC_VideoTimingMode *VmPtr;
+	XVidC_VideoTiming Timing;
+	XVidC_VideoMode Expected;
+	XVidC_VideoMode VmId;
+	u32 Errors = 0;
+	u32 Index;
+	u8 IsInterlaced;
+
+	for (Index = 0; Index < XVIDC_VM_NUM_SUPPORTED; Index++) {
+		VmPtr = &XVidC_VideoTimingModes[Index];
+		IsInterlaced = XVidC_IsInterlaced((XVidC_VideoMode)Index);
+		Timing = VmPtr->Timing;
+
+		Expected = Vm_LinearSearch(&Timing, VmPtr->FrameRate,
+				IsInterlaced, 0);
+		VmId = XVidC_GetVideoModeId(Timing.HActive, Timing.VActive,
+				VmPtr->FrameRate, IsInterlaced);
+		if (VmId != Expected) {
+			xil_printf("%s: XVidC_GetVideoModeId returned %d, "
+					"expected %d\r\n", VmPtr->Name, VmId, Expected);
+			Errors++;
+		}
+
+		Expected = Vm_LinearSearch(&Timing, VmPtr->FrameRate,
+				IsInterlaced, 1);
+		VmId = XVidC_GetVideoModeIdExtensive(&Timing, VmPtr->FrameRate,
+				IsInterlaced, 1);
+		if (VmId != Expected) {
+			xil_printf("%s: XVidC_GetVideoModeIdExtensive returned %d, "
+					"expected %d\r\n", VmPtr->Name, VmId, Expected);
+			Errors++;
+		}
+	}
+
+	return (Errors == 0) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/******************************************************************************/
+/**
+ * This function prints the average time of a video mode lookup over all the
+ * entries of the pre-defined video timing table.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static void Vm_TimeLookups(void)
+{
+	const XVidC_VideoTimingMode *VmPtr;
+	XVidC_VideoTiming Timing;
+	XTime Start, End;
+	u32 Pass;
+	u32 Index;
+	u32 Lookups = 0;
+	u64 Nsec;
+
+	XTime_GetTime(&Start);
+	for (Pass = 0; Pass < LOOKUP_PASSES; Pass++) {
+		for (Index = 0; Index < XVIDC_VM_NUM_SUPPORTED; Index++) {
+			VmPtr = &XVidC_VideoTimingModes[Index];
+			(void)XVidC_GetVideoModeId(VmPtr->Timing.HActive,
+					VmPtr->Timing.VActive, VmPtr->FrameRate,
+					XVidC_IsInterlaced((XVidC_VideoMode)Index));
+			Lookups++;
+		}
+	}
+	XTime_GetTime(&End);
+	Nsec = ((End - Start) * 1000000000U) / COUNTS_PER_SECOND;
+	xil_printf("XVidC_GetVideoModeId: %d ns per lookup\r\n",
+			(u32)(Nsec / Lookups));
+
+	Lookups = 0;
+	XTime_GetTime(&Start);
+	for (Pass = 0; Pass < LOOKUP_PASSES; Pass++) {
+		for (Index = 0; Index < XVIDC_VM_NUM_SUPPORTED; Index++) {
+			VmPtr = &XVidC_VideoTimingModes[Index];
+			Timing = VmPtr->Timing;
+			(void)XVidC_GetVideoModeIdExtensive(&Timing,
+					VmPtr->FrameRate,
+					XVidC_IsInterlaced((XVidC_VideoMode)Index), 1);
+			Lookups++;
+		}
+	}
+	XTime_GetTime(&End);
+	Nsec = ((End - Start) * 1000000000U) / COUNTS_PER_SECOND;
+	xil_printf("XVidC_GetVideoModeIdExtensive: %d ns per lookup\r\n",
+			(u32)(Nsec / Lookups));
+}
@@ -29,6 +29,8 @@
 *                         xil_io.h and made them as static inline
 *       am       10/13/20 Changed the return type of Xil_SecureOut32 function
 *                         from u32 to int
+*       mus      11/16/20 Route the accesses to the register IO emulation of
+*                         xil_io_emu.h when XIL_IO_EMULATION is defined
 *
 * </pre>
 ******************************************************************************/
@@ -46,7 +48,9 @@ extern "C" {
 #include "xil_printf.h"
 #include "xstatus.h"
 
-#if defined (__MICROBLAZE__)
+#if defined (XIL_IO_EMULATION)
+#include "xil_io_emu.h"
+#elif defined (__MICROBLAZE__)
 #include "mb_interface.h"
 #else
 #include "xpseudo_asm.h"
@@ -59,7 +63,7 @@ extern u32 XStl_RegUpdate(u32 RegAddr, u32 RegVal);
 
 /***************** Macros (Inline Functions) Definitions *********************/
 #if defined __GNUC__
-#if defined (__MICROBLAZE__)
+#if defined (__MICROBLAZE__) && !defined (XIL_IO_EMULATION)
 #  define INST_SYNC		mbar(0)
 #  define DATA_SYNC		mbar(1)
 # else
@@ -96,7 +100,11 @@ extern u32 XStl_RegUpdate(u32 RegAddr, u32 RegVal);
 ******************************************************************************/
 static INLINE u8 Xil_In8(UINTPTR Addr)
 {
+#ifdef XIL_IO_EMULATION
+	return Xil_EmuIn8(Addr);
+#else
 	return *(volatile u8 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -113,7 +121,11 @@ static INLINE u8 Xil_In8(UINTPTR Addr)
 ******************************************************************************/
 static INLINE u16 Xil_In16(UINTPTR Addr)
 {
+#ifdef XIL_IO_EMULATION
+	return Xil_EmuIn16(Addr);
+#else
 	return *(volatile u16 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -130,7 +142,11 @@ static INLINE u16 Xil_In16(UINTPTR Addr)
 ******************************************************************************/
 static INLINE u32 Xil_In32(UINTPTR Addr)
 {
+#ifdef XIL_IO_EMULATION
+	return Xil_EmuIn32(Addr);
+#else
 	return *(volatile u32 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -147,7 +163,11 @@ static INLINE u32 Xil_In32(UINTPTR Addr)
 ******************************************************************************/
 static INLINE u64 Xil_In64(UINTPTR Addr)
 {
+#ifdef XIL_IO_EMULATION
+	return Xil_EmuIn64(Addr);
+#else
 	return *(volatile u64 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -165,8 +185,12 @@ static INLINE u64 Xil_In64(UINTPTR Addr)
 ******************************************************************************/
 static INLINE void Xil_Out8(UINTPTR Addr, u8 Value)
 {
+#ifdef XIL_IO_EMULATION
+	Xil_EmuOut8(Addr, Value);
+#else
 	volatile u8 *LocalAddr = (volatile u8 *)Addr;
 	*LocalAddr = Value;
+#endif
 }
 
 /*****************************************************************************/
@@ -183,8 +207,12 @@ static INLINE void Xil_Out8(UINTPTR Addr, u8 Value)
 ******************************************************************************/
 static INLINE void Xil_Out16(UINTPTR Addr, u16 Value)
 {
+#ifdef XIL_IO_EMULATION
+	Xil_EmuOut16(Addr, Value);
+#else
 	volatile u16 *LocalAddr = (volatile u16 *)Addr;
 	*LocalAddr = Value;
+#endif
 }
 
 /*****************************************************************************/
@@ -202,7 +230,9 @@ static INLINE void Xil_Out16(UINTPTR Addr, u16 Value)
 ******************************************************************************/
 static INLINE void Xil_Out32(UINTPTR Addr, u32 Value)
 {
-#ifndef ENABLE_SAFETY
+#if defined (XIL_IO_EMULATION)
+	Xil_EmuOut32(Addr, Value);
+#elif !defined (ENABLE_SAFETY)
 	volatile u32 *LocalAddr = (volatile u32 *)Addr;
 	*LocalAddr = Value;
 #else
@@ -224,8 +254,12 @@ static INLINE void Xil_Out32(UINTPTR Addr, u32 Value)
 ******************************************************************************/
 static INLINE void Xil_Out64(UINTPTR Addr, u64 Value)
 {
+#ifdef XIL_IO_EMULATION
+	Xil_EmuOut64(Addr, Value);
+#else
 	volatile u64 *LocalAddr = (volatile u64 *)Addr;
 	*LocalAddr = Value;
+#endif
 }
 
 /*****************************************************************************/
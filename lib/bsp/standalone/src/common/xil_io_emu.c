@@ -0,0 +1,547 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xil_io_emu.c
+*
+* This file contains the register IO emulation used by the Xil_In and Xil_Out
+* functions when the BSP is built with XIL_IO_EMULATION defined. It is empty
+* in the other builds.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 7.3   mus      11/16/20 First release
+*
+* </pre>
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+#include "xstatus.h"
+
+#ifdef XIL_IO_EMULATION
+#include "xil_io_emu.h"
+
+/************************** Variable Definitions *****************************/
+
+static Xil_EmuRegion *Xil_EmuRegions[XIL_EMU_MAX_REGIONS];
+static u32 Xil_EmuNumRegions;
+static Xil_EmuRegion *Xil_EmuLastRegion;
+static Xil_EmuStats Xil_EmuCnt;
+static Xil_EmuTraceHandler Xil_EmuTrace;
+static void *Xil_EmuTraceRef;
+
+/************************** Function Prototypes ******************************/
+
+static Xil_EmuRegion *Xil_EmuFindRegion(UINTPTR Addr);
+static u32 Xil_EmuRegRead(Xil_EmuRegion *RegionPtr, u32 Offset);
+static void Xil_EmuRegWrite(Xil_EmuRegion *RegionPtr, u32 Offset, u32 Value);
+
+/*****************************************************************************/
+/**
+*
+* @brief    Registers a region of emulated registers. Accesses from Addr to
+*           Addr + Size - 1 go to the register file of the region, which
+*           holds the reset values of the registers when the region is
+*           registered. The region has no handlers until
+*           Xil_EmuSetHandlers() is called.
+*
+* @param	RegionPtr: region to be registered, kept by the emulation
+*           until it is removed
+* @param	Name: name of the region, used by trace handlers
+* @param	BaseAddr: address of the first register, 4 byte aligned
+* @param	Size: size of the region in bytes, a multiple of 4
+* @param	Regs: register file of Size / 4 words
+*
+* @return	XST_SUCCESS if the region was registered, XST_FAILURE if the
+*           parameters are invalid, the region overlaps a registered region
+*           or XIL_EMU_MAX_REGIONS regions are registered.
+*
+******************************************************************************/
+s32 Xil_EmuAddRegion(Xil_EmuRegion *RegionPtr, const char *Name,
+		     UINTPTR BaseAddr, u32 Size, u32 *Regs)
+{
+	Xil_EmuRegion *OtherPtr;
+	u32 Index;
+
+	if ((RegionPtr == NULL) || (Regs == NULL) || (Size == 0U) ||
+	    ((Size & 0x3U) != 0U) || ((BaseAddr & 0x3U) != 0U) ||
+	    (Xil_EmuNumRegions == XIL_EMU_MAX_REGIONS)) {
+		return XST_FAILURE;
+	}
+
+	for (Index = 0U; Index < Xil_EmuNumRegions; Index++) {
+		OtherPtr = Xil_EmuRegions[Index];
+		if ((BaseAddr < (OtherPtr->BaseAddr + OtherPtr->Size)) &&
+		    (OtherPtr->BaseAddr < (BaseAddr + Size))) {
+			return XST_FAILURE;
+		}
+	}
+
+	RegionPtr->Name = Name;
+	RegionPtr->BaseAddr = BaseAddr;
+	RegionPtr->Size = Size;
+	RegionPtr->Regs = Regs;
+	RegionPtr->ReadHandler = NULL;
+	RegionPtr->WriteHandler = NULL;
+	RegionPtr->CallBackRef = NULL;
+	RegionPtr->ReadCnt = 0U;
+	RegionPtr->WriteCnt = 0U;
+	Xil_EmuRegions[Xil_EmuNumRegions] = RegionPtr;
+	Xil_EmuNumRegions++;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Sets the handlers which model the side effects of the registers
+*           of a region.
+*
+* @param	RegionPtr: registered region
+* @param	ReadHandler: read handler, NULL to read the register file
+* @param	WriteHandler: write handler, NULL to store the values written
+* @param	CallBackRef: argument passed to the handlers
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_EmuSetHandlers(Xil_EmuRegion *RegionPtr,
+			Xil_EmuReadHandler ReadHandler,
+			Xil_EmuWriteHandler WriteHandler, void *CallBackRef)
+{
+	RegionPtr->ReadHandler = ReadHandler;
+	RegionPtr->WriteHandler = WriteHandler;
+	RegionPtr->CallBackRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Removes a registered region. Its addresses are host memory again.
+*
+* @param	RegionPtr: registered region
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_EmuRemoveRegion(Xil_EmuRegion *RegionPtr)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Xil_EmuNumRegions; Index++) {
+		if (Xil_EmuRegions[Index] == RegionPtr) {
+			Xil_EmuNumRegions--;
+			Xil_EmuRegions[Index] = Xil_EmuRegions[Xil_EmuNumRegions];
+			break;
+		}
+	}
+	if (Xil_EmuLastRegion == RegionPtr) {
+		Xil_EmuLastRegion = NULL;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Sets the handler called for every access, after the access.
+*
+* @param	Handler: trace handler, NULL to stop tracing
+* @param	CallBackRef: argument passed to the handler
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_EmuSetTraceHandler(Xil_EmuTraceHandler Handler, void *CallBackRef)
+{
+	Xil_EmuTrace = Handler;
+	Xil_EmuTraceRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Returns the access counts since the last Xil_EmuResetStats().
+*
+* @param	StatsPtr: filled with the access counts
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_EmuGetStats(Xil_EmuStats *StatsPtr)
+{
+	*StatsPtr = Xil_EmuCnt;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Clears the access counts, in total and of every region.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_EmuResetStats(void)
+{
+	u32 Index;
+
+	Xil_EmuCnt.RegReads = 0U;
+	Xil_EmuCnt.RegWrites = 0U;
+	Xil_EmuCnt.MemReads = 0U;
+	Xil_EmuCnt.MemWrites = 0U;
+	for (Index = 0U; Index < Xil_EmuNumRegions; Index++) {
+		Xil_EmuRegions[Index]->ReadCnt = 0U;
+		Xil_EmuRegions[Index]->WriteCnt = 0U;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Finds the region of an address. Drivers mostly access one IP at a
+*           time, so the region found last is checked first.
+*
+* @param	Addr: address accessed
+*
+* @return	The region, NULL for host memory.
+*
+******************************************************************************/
+static Xil_EmuRegion *Xil_EmuFindRegion(UINTPTR Addr)
+{
+	Xil_EmuRegion *RegionPtr = Xil_EmuLastRegion;
+	u32 Index;
+
+	if ((RegionPtr != NULL) && (Addr >= RegionPtr->BaseAddr) &&
+	    ((Addr - RegionPtr->BaseAddr) < RegionPtr->Size)) {
+		return RegionPtr;
+	}
+
+	for (Index = 0U; Index < Xil_EmuNumRegions; Index++) {
+		RegionPtr = Xil_EmuRegions[Index];
+		if ((Addr >= RegionPtr->BaseAddr) &&
+		    ((Addr - RegionPtr->BaseAddr) < RegionPtr->Size)) {
+			Xil_EmuLastRegion = RegionPtr;
+			return RegionPtr;
+		}
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Reads a register of a region.
+*
+* @param	RegionPtr: region accessed
+* @param	Offset: offset of the register, 4 byte aligned
+*
+* @return	The value read.
+*
+******************************************************************************/
+static u32 Xil_EmuRegRead(Xil_EmuRegion *RegionPtr, u32 Offset)
+{
+	RegionPtr->ReadCnt++;
+	Xil_EmuCnt.RegReads++;
+
+	if (RegionPtr->ReadHandler != NULL) {
+		return RegionPtr->ReadHandler(RegionPtr->CallBackRef, Offset,
+					      RegionPtr->Regs);
+	}
+	return RegionPtr->Regs[Offset >> 2U];
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Writes a register of a region.
+*
+* @param	RegionPtr: region accessed
+* @param	Offset: offset of the register, 4 byte aligned
+* @param	Value: value written
+*
+* @return	None.
+*
+******************************************************************************/
+static void Xil_EmuRegWrite(Xil_EmuRegion *RegionPtr, u32 Offset, u32 Value)
+{
+	u32 NewValue = Value;
+
+	RegionPtr->WriteCnt++;
+	Xil_EmuCnt.RegWrites++;
+
+	if (RegionPtr->WriteHandler != NULL) {
+		NewValue = RegionPtr->WriteHandler(RegionPtr->CallBackRef,
+						   Offset, RegionPtr->Regs,
+						   Value);
+	}
+	RegionPtr->Regs[Offset >> 2U] = NewValue;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Emulates an 8 bit input operation.
+*
+* @param	Addr: contains the address to perform the input operation
+*
+* @return	The 8 bit Value read from the specified input address.
+*
+******************************************************************************/
+u8 Xil_EmuIn8(UINTPTR Addr)
+{
+	Xil_EmuRegion *RegionPtr = Xil_EmuFindRegion(Addr);
+	u32 Offset;
+	u8 Value;
+
+	if (RegionPtr != NULL) {
+		Offset = (u32)(Addr - RegionPtr->BaseAddr);
+		Value = (u8)(Xil_EmuRegRead(RegionPtr, Offset & ~0x3U) >>
+			     ((Offset & 0x3U) * 8U));
+	} else {
+		Xil_EmuCnt.MemReads++;
+		Value = *(volatile u8 *)Addr;
+	}
+
+	if (Xil_EmuTrace != NULL) {
+		Xil_EmuTrace(Xil_EmuTraceRef, RegionPtr, Addr, Value, 1U,
+			     (RegionPtr == NULL) ? XIL_EMU_ACCESS_MEM : 0U);
+	}
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Emulates a 16 bit input operation.
+*
+* @param	Addr: contains the address to perform the input operation
+*
+* @return	The 16 bit Value read from the specified input address.
+*
+******************************************************************************/
+u16 Xil_EmuIn16(UINTPTR Addr)
+{
+	Xil_EmuRegion *RegionPtr = Xil_EmuFindRegion(Addr);
+	u32 Offset;
+	u16 Value;
+
+	if (RegionPtr != NULL) {
+		Offset = (u32)(Addr - RegionPtr->BaseAddr);
+		Value = (u16)(Xil_EmuRegRead(RegionPtr, Offset & ~0x3U) >>
+			      ((Offset & 0x2U) * 8U));
+	} else {
+		Xil_EmuCnt.MemReads++;
+		Value = *(volatile u16 *)Addr;
+	}
+
+	if (Xil_EmuTrace != NULL) {
+		Xil_EmuTrace(Xil_EmuTraceRef, RegionPtr, Addr, Value, 2U,
+			     (RegionPtr == NULL) ? XIL_EMU_ACCESS_MEM : 0U);
+	}
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Emulates a 32 bit input operation.
+*
+* @param	Addr: contains the address to perform the input operation
+*
+* @return	The 32 bit Value read from the specified input address.
+*
+******************************************************************************/
+u32 Xil_EmuIn32(UINTPTR Addr)
+{
+	Xil_EmuRegion *RegionPtr = Xil_EmuFindRegion(Addr);
+	u32 Value;
+
+	if (RegionPtr != NULL) {
+		Value = Xil_EmuRegRead(RegionPtr,
+				(u32)(Addr - RegionPtr->BaseAddr) & ~0x3U);
+	} else {
+		Xil_EmuCnt.MemReads++;
+		Value = *(volatile u32 *)Addr;
+	}
+
+	if (Xil_EmuTrace != NULL) {
+		Xil_EmuTrace(Xil_EmuTraceRef, RegionPtr, Addr, Value, 4U,
+			     (RegionPtr == NULL) ? XIL_EMU_ACCESS_MEM : 0U);
+	}
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Emulates a 64 bit input operation.
+*
+* @param	Addr: contains the address to perform the input operation
+*
+* @return	The 64 bit Value read from the specified input address.
+*
+******************************************************************************/
+u64 Xil_EmuIn64(UINTPTR Addr)
+{
+	Xil_EmuRegion *RegionPtr = Xil_EmuFindRegion(Addr);
+	u64 Value;
+
+	if (RegionPtr != NULL) {
+		Value = Xil_EmuIn32(Addr);
+		Value |= (u64)Xil_EmuIn32(Addr + 4U) << 32U;
+		return Value;
+	}
+
+	Xil_EmuCnt.MemReads++;
+	Value = *(volatile u64 *)Addr;
+	if (Xil_EmuTrace != NULL) {
+		Xil_EmuTrace(Xil_EmuTraceRef, NULL, Addr, Value, 8U,
+			     XIL_EMU_ACCESS_MEM);
+	}
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Emulates an 8 bit output operation.
+*
+* @param	Addr: contains the address to perform the output operation
+* @param	Value: contains the 8 bit Value to be written at the specified
+*           address.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_EmuOut8(UINTPTR Addr, u8 Value)
+{
+	Xil_EmuRegion *RegionPtr = Xil_EmuFindRegion(Addr);
+	u32 Offset;
+	u32 Shift;
+	u32 Reg;
+
+	if (RegionPtr != NULL) {
+		Offset = (u32)(Addr - RegionPtr->BaseAddr);
+		Shift = (Offset & 0x3U) * 8U;
+		Offset &= ~0x3U;
+		Reg = RegionPtr->Regs[Offset >> 2U] & ~((u32)0xFFU << Shift);
+		Xil_EmuRegWrite(RegionPtr, Offset, Reg | ((u32)Value << Shift));
+	} else {
+		Xil_EmuCnt.MemWrites++;
+		*(volatile u8 *)Addr = Value;
+	}
+
+	if (Xil_EmuTrace != NULL) {
+		Xil_EmuTrace(Xil_EmuTraceRef, RegionPtr, Addr, Value, 1U,
+			     XIL_EMU_ACCESS_WRITE | ((RegionPtr == NULL) ?
+			     XIL_EMU_ACCESS_MEM : 0U));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Emulates a 16 bit output operation.
+*
+* @param	Addr: contains the address to perform the output operation
+* @param	Value: contains the 16 bit Value to be written at the specified
+*           address.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_EmuOut16(UINTPTR Addr, u16 Value)
+{
+	Xil_EmuRegion *RegionPtr = Xil_EmuFindRegion(Addr);
+	u32 Offset;
+	u32 Shift;
+	u32 Reg;
+
+	if (RegionPtr != NULL) {
+		Offset = (u32)(Addr - RegionPtr->BaseAddr);
+		Shift = (Offset & 0x2U) * 8U;
+		Offset &= ~0x3U;
+		Reg = RegionPtr->Regs[Offset >> 2U] & ~((u32)0xFFFFU << Shift);
+		Xil_EmuRegWrite(RegionPtr, Offset, Reg | ((u32)Value << Shift));
+	} else {
+		Xil_EmuCnt.MemWrites++;
+		*(volatile u16 *)Addr = Value;
+	}
+
+	if (Xil_EmuTrace != NULL) {
+		Xil_EmuTrace(Xil_EmuTraceRef, RegionPtr, Addr, Value, 2U,
+			     XIL_EMU_ACCESS_WRITE | ((RegionPtr == NULL) ?
+			     XIL_EMU_ACCESS_MEM : 0U));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Emulates a 32 bit output operation.
+*
+* @param	Addr: contains the address to perform the output operation
+* @param	Value: contains the 32 bit Value to be written at the specified
+*           address.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_EmuOut32(UINTPTR Addr, u32 Value)
+{
+	Xil_EmuRegion *RegionPtr = Xil_EmuFindRegion(Addr);
+
+	if (RegionPtr != NULL) {
+		Xil_EmuRegWrite(RegionPtr,
+				(u32)(Addr - RegionPtr->BaseAddr) & ~0x3U,
+				Value);
+	} else {
+		Xil_EmuCnt.MemWrites++;
+		*(volatile u32 *)Addr = Value;
+	}
+
+	if (Xil_EmuTrace != NULL) {
+		Xil_EmuTrace(Xil_EmuTraceRef, RegionPtr, Addr, Value, 4U,
+			     XIL_EMU_ACCESS_WRITE | ((RegionPtr == NULL) ?
+			     XIL_EMU_ACCESS_MEM : 0U));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Emulates a 64 bit output operation.
+*
+* @param	Addr: contains the address to perform the output operation
+* @param	Value: contains the 64 bit Value to be written at the specified
+*           address.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_EmuOut64(UINTPTR Addr, u64 Value)
+{
+	if (Xil_EmuFindRegion(Addr) != NULL) {
+		Xil_EmuOut32(Addr, (u32)Value);
+		Xil_EmuOut32(Addr + 4U, (u32)(Value >> 32U));
+		return;
+	}
+
+	Xil_EmuCnt.MemWrites++;
+	*(volatile u64 *)Addr = Value;
+	if (Xil_EmuTrace != NULL) {
+		Xil_EmuTrace(Xil_EmuTraceRef, NULL, Addr, Value, 8U,
+			     XIL_EMU_ACCESS_WRITE | XIL_EMU_ACCESS_MEM);
+	}
+}
+#endif /* XIL_IO_EMULATION */
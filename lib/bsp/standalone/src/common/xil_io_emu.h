@@ -0,0 +1,171 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xil_io_emu.h
+*
+* @addtogroup common_io_emulation_apis Register IO emulation APIs
+*
+* The xil_io_emu.h file contains the interface of the register IO emulation,
+* which lets drivers run on a host, for example a Linux build machine.
+*
+* When the BSP and the drivers are built with XIL_IO_EMULATION defined, the
+* Xil_In and Xil_Out functions of xil_io.h call Xil_EmuIn32(), Xil_EmuOut32()
+* and their 8, 16 and 64 bit variants instead of accessing the address.
+*
+* - An access inside a region registered with Xil_EmuAddRegion() goes to the
+*   register file of the region. The read and write handlers of the region
+*   model the side effects of the registers of the IP, like write one to
+*   clear bits, or a DMA engine walking descriptors in host memory when its
+*   tail pointer is written.
+* - Any other access goes to host memory, like the accesses drivers make to
+*   buffer descriptors.
+*
+* All accesses are counted, in total and per region, and can be passed to a
+* trace handler. Comparing the counts before and after a driver API call
+* gives the register accesses of the call.
+*
+* Registers are modeled as 32 bit little endian words. An 8 or 16 bit write
+* to a region writes the value held by the register with the bytes written
+* replaced, and a 64 bit access is done as two 32 bit accesses, low word
+* first.
+*
+* The emulation is not thread safe. Accesses and the interrupts a model
+* raises, by calling the interrupt handler of the driver, are serialized by
+* the caller.
+*
+* @{
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 7.3   mus      11/16/20 First release
+*
+* </pre>
+******************************************************************************/
+
+#ifndef XIL_IO_EMU_H           /* prevent circular inclusions */
+#define XIL_IO_EMU_H           /* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_EMU_MAX_REGIONS	32U	/**< Regions which can be registered */
+
+/* Access flags passed to the trace handler */
+#define XIL_EMU_ACCESS_WRITE	0x1U	/**< Write, read when clear */
+#define XIL_EMU_ACCESS_MEM	0x2U	/**< Host memory, region when clear */
+
+/**************************** Type Definitions *******************************/
+
+typedef struct Xil_EmuRegion_s Xil_EmuRegion;
+
+/**
+ * Read handler of a region. It returns the value read from the register at
+ * Offset of the register file RegsPtr, after applying the side effects of
+ * the read to the register file if any.
+ */
+typedef u32 (*Xil_EmuReadHandler)(void *CallBackRef, u32 Offset,
+				  u32 *RegsPtr);
+
+/**
+ * Write handler of a region. It returns the value to be held by the register
+ * at Offset, computed from the value held before and the value written, and
+ * runs the side effects of the write. Other registers are updated directly
+ * in the register file RegsPtr.
+ */
+typedef u32 (*Xil_EmuWriteHandler)(void *CallBackRef, u32 Offset,
+				   u32 *RegsPtr, u32 Value);
+
+/**
+ * Trace handler, called for every access with the region accessed, or NULL
+ * for host memory, the access width in bytes and the XIL_EMU_ACCESS flags.
+ */
+typedef void (*Xil_EmuTraceHandler)(void *CallBackRef,
+				    const Xil_EmuRegion *RegionPtr,
+				    UINTPTR Addr, u64 Value, u32 Width,
+				    u32 Flags);
+
+/**
+ * A register region, typically the register space of one IP instance.
+ */
+struct Xil_EmuRegion_s {
+	const char *Name;		/**< Name used by trace handlers */
+	UINTPTR BaseAddr;		/**< Address of the first register */
+	u32 Size;			/**< Size of the region in bytes */
+	u32 *Regs;			/**< Register file, Size / 4 words */
+	Xil_EmuReadHandler ReadHandler;	/**< NULL to read the register file */
+	Xil_EmuWriteHandler WriteHandler; /**< NULL to store the value */
+	void *CallBackRef;		/**< Passed to the handlers */
+	u32 ReadCnt;			/**< Reads of the region */
+	u32 WriteCnt;			/**< Writes to the region */
+};
+
+/**
+ * Access counts of all regions and of host memory.
+ */
+typedef struct {
+	u32 RegReads;		/**< Reads of registered regions */
+	u32 RegWrites;		/**< Writes to registered regions */
+	u32 MemReads;		/**< Reads of host memory */
+	u32 MemWrites;		/**< Writes to host memory */
+} Xil_EmuStats;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Barriers only need to order the accesses of the compiler on the host. They
+ * replace the ones of xpseudo_asm.h, which is not included by xil_io.h in an
+ * emulation build.
+ */
+#ifndef dmb
+#define dmb()		__asm__ __volatile__ ("" : : : "memory")
+#endif
+#ifndef dsb
+#define dsb()		__asm__ __volatile__ ("" : : : "memory")
+#endif
+#ifndef isb
+#define isb()		__asm__ __volatile__ ("" : : : "memory")
+#endif
+
+/************************** Function Prototypes ******************************/
+
+s32 Xil_EmuAddRegion(Xil_EmuRegion *RegionPtr, const char *Name,
+		     UINTPTR BaseAddr, u32 Size, u32 *Regs);
+void Xil_EmuSetHandlers(Xil_EmuRegion *RegionPtr,
+			Xil_EmuReadHandler ReadHandler,
+			Xil_EmuWriteHandler WriteHandler, void *CallBackRef);
+void Xil_EmuRemoveRegion(Xil_EmuRegion *RegionPtr);
+void Xil_EmuSetTraceHandler(Xil_EmuTraceHandler Handler, void *CallBackRef);
+void Xil_EmuGetStats(Xil_EmuStats *StatsPtr);
+void Xil_EmuResetStats(void);
+
+u8 Xil_EmuIn8(UINTPTR Addr);
+u16 Xil_EmuIn16(UINTPTR Addr);
+u32 Xil_EmuIn32(UINTPTR Addr);
+u64 Xil_EmuIn64(UINTPTR Addr);
+void Xil_EmuOut8(UINTPTR Addr, u8 Value);
+void Xil_EmuOut16(UINTPTR Addr, u16 Value);
+void Xil_EmuOut32(UINTPTR Addr, u32 Value);
+void Xil_EmuOut64(UINTPTR Addr, u64 Value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/**
+* @} End of "addtogroup common_io_emulation_apis".
+*/
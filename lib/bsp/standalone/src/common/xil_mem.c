@@ -8,8 +8,9 @@
 /**
 * @file xil_mem.c
 *
-* This file contains xil mem copy function to use in case of word aligned
-* data copies.
+* This file contains xil mem copy, set and compare functions. They only
+* perform naturally aligned accesses, so they can be used on memory regions
+* which do not support unaligned accesses.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -17,6 +18,11 @@
 * Ver   Who      Date     Changes
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
+* 7.3   mus      11/16/20 Updated Xil_MemCpy to copy in aligned native words,
+*                         merging misaligned source words with shifts, and
+*                         with NEON for Cortex-A53/A72 64 bit. Added
+*                         Xil_MemSet.
+*       mus      11/16/20 Added Xil_MemCmpFast
 *
 * </pre>
 *
@@ -25,11 +31,175 @@
 /***************************** Include Files ********************************/
 
 #include "xil_types.h"
+#include "xil_mem.h"
+#if defined (__aarch64__) && defined (__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/************************** Constant Definitions *****************************/
+
+/*
+ * Word used for the bulk of the copies, the widest general purpose
+ * register of the processor.
+ */
+#if defined (__aarch64__) || defined (__arch64__)
+#define XIL_MEM_WORD_BITS	64U
+#else
+#define XIL_MEM_WORD_BITS	32U
+#endif
+#define XIL_MEM_WORD_SIZE	(XIL_MEM_WORD_BITS / 8U)
+#define XIL_MEM_WORD_MASK	(XIL_MEM_WORD_SIZE - 1U)
+
+/* Copies shorter than this are done byte by byte */
+#define XIL_MEM_MIN_WORD_CNT	(2U * XIL_MEM_WORD_SIZE)
+
+/**************************** Type Definitions *******************************/
+
+/*
+ * The buffers are accessed through this type whatever their declared type
+ * is, so it may alias any object.
+ */
+#if defined (__aarch64__) || defined (__arch64__)
+#if defined (__GNUC__)
+typedef u64 __attribute__((__may_alias__)) XilMem_Word;
+#else
+typedef u64 XilMem_Word;
+#endif
+#else
+#if defined (__GNUC__)
+typedef u32 __attribute__((__may_alias__)) XilMem_Word;
+#else
+typedef u32 XilMem_Word;
+#endif
+#endif
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Merges the tail of word W0 with the head of word W1, where the wanted
+ * word starts Shift bits into W0 in memory order.
+ */
+#if defined (__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define XIL_MEM_MERGE(W0, W1, Shift) \
+	(((W0) << (Shift)) | ((W1) >> (XIL_MEM_WORD_BITS - (Shift))))
+#else
+#define XIL_MEM_MERGE(W0, W1, Shift) \
+	(((W0) >> (Shift)) | ((W1) << (XIL_MEM_WORD_BITS - (Shift))))
+#endif
+
+/************************** Function Prototypes ******************************/
+
+static u32 Xil_MemCpyAligned(XilMem_Word *d, const XilMem_Word *s, u32 cnt);
+static u32 Xil_MemCpyMerge(XilMem_Word *d, const u8 *s, u32 cnt);
+
+/*****************************************************************************/
+/**
+* @brief       This function copies whole words between word aligned buffers.
+*
+* @param       d: pointer pointing to word aligned destination memory
+*
+* @param       s: pointer pointing to word aligned source memory
+*
+* @param       cnt: 32 bit length of bytes to be copied
+*
+* @return      Number of bytes copied, cnt rounded down to whole words.
+*
+*****************************************************************************/
+static u32 Xil_MemCpyAligned(XilMem_Word *d, const XilMem_Word *s, u32 cnt)
+{
+	u32 Len = cnt;
+
+#if defined (__aarch64__) && defined (__ARM_NEON)
+	/* 64 bytes per iteration in NEON registers */
+	if ((((UINTPTR)d | (UINTPTR)s) & 0xFU) == 0U) {
+		while (Len >= 64U) {
+			uint64x2_t Q0 = vld1q_u64((const u64 *)s);
+			uint64x2_t Q1 = vld1q_u64((const u64 *)s + 2U);
+			uint64x2_t Q2 = vld1q_u64((const u64 *)s + 4U);
+			uint64x2_t Q3 = vld1q_u64((const u64 *)s + 6U);
+			vst1q_u64((u64 *)d, Q0);
+			vst1q_u64((u64 *)d + 2U, Q1);
+			vst1q_u64((u64 *)d + 4U, Q2);
+			vst1q_u64((u64 *)d + 6U, Q3);
+			d += 8U;
+			s += 8U;
+			Len -= 64U;
+		}
+	}
+#endif
+
+	while (Len >= (4U * XIL_MEM_WORD_SIZE)) {
+		XilMem_Word W0 = s[0];
+		XilMem_Word W1 = s[1];
+		XilMem_Word W2 = s[2];
+		XilMem_Word W3 = s[3];
+		d[0] = W0;
+		d[1] = W1;
+		d[2] = W2;
+		d[3] = W3;
+		d += 4U;
+		s += 4U;
+		Len -= 4U * XIL_MEM_WORD_SIZE;
+	}
+	while (Len >= XIL_MEM_WORD_SIZE) {
+		*d = *s;
+		d++;
+		s++;
+		Len -= XIL_MEM_WORD_SIZE;
+	}
+
+	return cnt - Len;
+}
+
+/*****************************************************************************/
+/**
+* @brief       This function copies whole words to a word aligned destination
+*              from a source which is not word aligned. Aligned source words
+*              are read and merged with shifts, so no unaligned access is
+*              done and no word without source bytes is read.
+*
+* @param       d: pointer pointing to word aligned destination memory
+*
+* @param       s: pointer pointing to source memory, not word aligned
+*
+* @param       cnt: 32 bit length of bytes to be copied
+*
+* @return      Number of bytes copied, cnt rounded down to whole words.
+*
+*****************************************************************************/
+static u32 Xil_MemCpyMerge(XilMem_Word *d, const u8 *s, u32 cnt)
+{
+	u32 Shift = ((u32)(UINTPTR)s & XIL_MEM_WORD_MASK) * 8U;
+	const XilMem_Word *Ws = (const XilMem_Word *)(const void *)
+			(s - ((UINTPTR)s & XIL_MEM_WORD_MASK));
+	XilMem_Word W0 = *Ws;
+	XilMem_Word W1;
+	u32 Len = cnt;
+
+	Ws++;
+	while (Len >= (2U * XIL_MEM_WORD_SIZE)) {
+		W1 = Ws[0];
+		d[0] = XIL_MEM_MERGE(W0, W1, Shift);
+		W0 = Ws[1];
+		d[1] = XIL_MEM_MERGE(W1, W0, Shift);
+		d += 2U;
+		Ws += 2U;
+		Len -= 2U * XIL_MEM_WORD_SIZE;
+	}
+	if (Len >= XIL_MEM_WORD_SIZE) {
+		W1 = *Ws;
+		*d = XIL_MEM_MERGE(W0, W1, Shift);
+		Len -= XIL_MEM_WORD_SIZE;
+	}
+
+	return cnt - Len;
+}
 
-/***************** Inline Functions Definitions ********************/
 /*****************************************************************************/
 /**
 * @brief       This  function copies memory from once location to other.
+*              The destination is aligned with byte copies, and the bulk of
+*              the data is copied in aligned native words.
 *
 * @param       dst: pointer pointing to destination memory
 *
@@ -40,25 +210,159 @@
 *****************************************************************************/
 void Xil_MemCpy(void* dst, const void* src, u32 cnt)
 {
-	char *d = (char*)(void *)dst;
-	const char *s = src;
-
-	while (cnt >= sizeof (int)) {
-		*(int*)d = *(int*)s;
-		d += sizeof (int);
-		s += sizeof (int);
-		cnt -= sizeof (int);
-	}
-	while (cnt >= sizeof (u16)) {
-		*(u16*)d = *(u16*)s;
-		d += sizeof (u16);
-		s += sizeof (u16);
-		cnt -= sizeof (u16);
+	u8 *d = (u8 *)dst;
+	const u8 *s = (const u8 *)src;
+	u32 Len = cnt;
+	u32 Done;
+
+	if (Len >= XIL_MEM_MIN_WORD_CNT) {
+		while (((UINTPTR)d & XIL_MEM_WORD_MASK) != 0U) {
+			*d = *s;
+			d++;
+			s++;
+			Len--;
+		}
+
+		if (((UINTPTR)s & XIL_MEM_WORD_MASK) == 0U) {
+			Done = Xil_MemCpyAligned((XilMem_Word *)(void *)d,
+					(const XilMem_Word *)(const void *)s, Len);
+		} else {
+			Done = Xil_MemCpyMerge((XilMem_Word *)(void *)d, s, Len);
+		}
+		d += Done;
+		s += Done;
+		Len -= Done;
 	}
-	while ((cnt) > 0U){
+
+	while (Len > 0U) {
 		*d = *s;
-		d += 1U;
-		s += 1U;
-		cnt -= 1U;
+		d++;
+		s++;
+		Len--;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief       This function fills memory with a constant byte. The
+*              destination is aligned with byte writes, and the bulk of the
+*              memory is written in aligned native words.
+*
+* @param       dst: pointer pointing to destination memory
+*
+* @param       val: value to be written to every byte, converted to u8
+*
+* @param       cnt: 32 bit length of bytes to be written
+*
+*****************************************************************************/
+void Xil_MemSet(void* dst, s32 val, u32 cnt)
+{
+	u8 *d = (u8 *)dst;
+	u8 Byte = (u8)val;
+	XilMem_Word Word;
+	XilMem_Word *Wd;
+	u32 Len = cnt;
+
+	if (Len >= XIL_MEM_MIN_WORD_CNT) {
+		while (((UINTPTR)d & XIL_MEM_WORD_MASK) != 0U) {
+			*d = Byte;
+			d++;
+			Len--;
+		}
+
+		Word = Byte;
+		Word |= Word << 8U;
+		Word |= Word << 16U;
+#if (XIL_MEM_WORD_BITS == 64U)
+		Word |= Word << 32U;
+#endif
+
+		Wd = (XilMem_Word *)(void *)d;
+		while (Len >= (4U * XIL_MEM_WORD_SIZE)) {
+			Wd[0] = Word;
+			Wd[1] = Word;
+			Wd[2] = Word;
+			Wd[3] = Word;
+			Wd += 4U;
+			Len -= 4U * XIL_MEM_WORD_SIZE;
+		}
+		while (Len >= XIL_MEM_WORD_SIZE) {
+			*Wd = Word;
+			Wd++;
+			Len -= XIL_MEM_WORD_SIZE;
+		}
+		d = (u8 *)(void *)Wd;
 	}
+
+	while (Len > 0U) {
+		*d = Byte;
+		d++;
+		Len--;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief       This function compares memory. When both buffers have the same
+*              alignment, the equal bytes are skipped in aligned native
+*              words, and the first mismatching word is compared byte by
+*              byte.
+*
+* @param       Buf1: pointer pointing to first memory
+*
+* @param       Buf2: pointer pointing to second memory
+*
+* @param       cnt: 32 bit length of bytes to be compared
+*
+* @return      0 if both memories are the same,
+*              -1 if the first mismatching byte is lower in Buf1,
+*              1 if the first mismatching byte is greater in Buf1.
+*
+* @note        The compare stops at the first mismatching word, so its
+*              duration depends on the data and it is not hardened against
+*              fault injection. Use Xil_MemCmp() for secrets, keys and
+*              hashes.
+*
+*****************************************************************************/
+s32 Xil_MemCmpFast(const void* Buf1, const void* Buf2, u32 cnt)
+{
+	const u8 *b1 = (const u8 *)Buf1;
+	const u8 *b2 = (const u8 *)Buf2;
+	const XilMem_Word *W1;
+	const XilMem_Word *W2;
+	u32 Len = cnt;
+	s32 Ret = 0;
+
+	if ((Len >= XIL_MEM_MIN_WORD_CNT) &&
+	    ((((UINTPTR)b1 ^ (UINTPTR)b2) & XIL_MEM_WORD_MASK) == 0U)) {
+		while ((((UINTPTR)b1 & XIL_MEM_WORD_MASK) != 0U) &&
+		       (*b1 == *b2)) {
+			b1++;
+			b2++;
+			Len--;
+		}
+
+		if (((UINTPTR)b1 & XIL_MEM_WORD_MASK) == 0U) {
+			W1 = (const XilMem_Word *)(const void *)b1;
+			W2 = (const XilMem_Word *)(const void *)b2;
+			while ((Len >= XIL_MEM_WORD_SIZE) && (*W1 == *W2)) {
+				W1++;
+				W2++;
+				Len -= XIL_MEM_WORD_SIZE;
+			}
+			b1 = (const u8 *)(const void *)W1;
+			b2 = (const u8 *)(const void *)W2;
+		}
+	}
+
+	while ((Len > 0U) && (*b1 == *b2)) {
+		b1++;
+		b2++;
+		Len--;
+	}
+	if (Len > 0U) {
+		Ret = (*b1 > *b2) ? 1 : -1;
+	}
+
+	return Ret;
 }
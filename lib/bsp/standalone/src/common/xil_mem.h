@@ -22,6 +22,8 @@
 * ----- -------- -------- -----------------------------------------------
 * 6.1   nsk      11/07/16 First release.
 * 7.0   mus      01/07/19 Add cpp extern macro
+* 7.3   mus      11/16/20 Added Xil_MemSet
+*       mus      11/16/20 Added Xil_MemCmpFast
 *
 * </pre>
 *
@@ -36,6 +38,8 @@ extern "C" {
 /************************** Function Prototypes *****************************/
 
 void Xil_MemCpy(void* dst, const void* src, u32 cnt);
+void Xil_MemSet(void* dst, s32 val, u32 cnt);
+s32 Xil_MemCmpFast(const void* Buf1, const void* Buf2, u32 cnt);
 
 #ifdef __cplusplus
 }
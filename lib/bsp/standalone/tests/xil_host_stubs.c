@@ -0,0 +1,82 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xil_host_stubs.c
+*
+* Host implementations of the BSP functions which need the processor, shared
+* by the host tests of the BSP, the drivers and the libraries. The host tests
+* of a component are in its tests directory and are built with the Makefile
+* of that directory against the include directory of a BSP, with this file
+* added to the sources.
+*
+* - outbyte() writes to the standard output, for xil_printf.
+* - The data cache range operations do nothing. The prototypes are the ones
+*   of the xil_cache.h of the BSP: with ARMv8 64 bit Xil_DCacheFlushRange is
+*   a macro, with MicroBlaze both operations are macros.
+* - XTime_GetTime() returns the host monotonic time in COUNTS_PER_SECOND
+*   units, when the BSP has a xtime_l.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.3   mus  11/16/20 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <time.h>
+#include "xil_types.h"
+#include "xil_printf.h"
+#include "xil_cache.h"
+#if __has_include("xtime_l.h")
+#include "xtime_l.h"
+#define XIL_HOST_XTIME
+#endif
+
+/************************** Function Definitions *****************************/
+
+void outbyte(char8 c)
+{
+	(void)putchar(c);
+}
+
+#if defined(Xil_DCacheFlushRange) && !defined(Xil_DCacheInvalidateRange)
+void Xil_DCacheInvalidateRange(INTPTR adr, INTPTR len)
+{
+	(void)adr;
+	(void)len;
+}
+#elif !defined(Xil_DCacheInvalidateRange)
+void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
+{
+	(void)adr;
+	(void)len;
+}
+
+void Xil_DCacheFlushRange(INTPTR adr, u32 len)
+{
+	(void)adr;
+	(void)len;
+}
+#endif
+
+#ifdef XIL_HOST_XTIME
+void XTime_GetTime(XTime *Xtime_Global)
+{
+	struct timespec Ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &Ts);
+	*Xtime_Global = ((XTime)Ts.tv_sec * COUNTS_PER_SECOND) +
+			(((XTime)Ts.tv_nsec * COUNTS_PER_SECOND) / 1000000000U);
+}
+#endif
@@ -0,0 +1,340 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/**
+*
+* @file xil_io_emu_test.c
+*
+* Implements test that runs driver code on a host with the register IO
+* emulation. A descriptor based DMA engine is modeled by a register region
+* whose write handler walks the descriptors in host memory when the tail
+* descriptor register is written. A small driver submits copies through
+* Xil_Out32 and Xil_In32, and the test checks the copied data and prints
+* the register and descriptor accesses of each driver call.
+*
+* The test is built with -DXIL_IO_EMULATION by the Makefile of this directory.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.3   mus  11/16/20  First release of test which uses the register IO
+*                      emulation.
+* </pre>
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xil_io.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Address of the modeled DMA engine, never accessed as host memory */
+#define DMA_BASEADDR		0xA0000000U
+
+#define DMA_CR_OFFSET		0x00U	/* Control */
+#define DMA_SR_OFFSET		0x04U	/* Status */
+#define DMA_CURDESC_OFFSET	0x08U	/* Current descriptor, low word */
+#define DMA_CURDESC_MSB_OFFSET	0x0CU	/* Current descriptor, high word */
+#define DMA_TAILDESC_OFFSET	0x10U	/* Tail descriptor, low word */
+#define DMA_TAILDESC_MSB_OFFSET	0x14U	/* Tail descriptor, high word */
+#define DMA_REGS_SIZE		0x18U
+
+#define DMA_CR_RUN_MASK		0x1U
+#define DMA_SR_IDLE_MASK	0x1U	/* Read only */
+#define DMA_SR_IOC_MASK		0x2U	/* Write one to clear */
+
+#define DMA_BD_CMPLT_MASK	0x80000000U
+#define DMA_BD_LEN_MASK		0x00FFFFFFU
+
+#define DMA_NUM_BDS		8U
+#define DMA_COPY_LEN		256U
+
+/**************************** Type Definitions *******************************/
+
+/* Descriptor in host memory, accessed by the driver through Xil_In/Out */
+typedef struct {
+	u64 Next;
+	u64 Src;
+	u64 Dst;
+	u32 Len;
+	u32 Status;
+} DmaBd;
+
+/************************** Function Prototypes ******************************/
+
+static u32 Dma_Write(void *CallBackRef, u32 Offset, u32 *RegsPtr, u32 Value);
+static void Dma_Walk(u32 *RegsPtr);
+static void Dma_Start(DmaBd *Ring);
+static void Dma_Submit(DmaBd *Ring, u32 First, u32 Cnt);
+static u32 Dma_Reap(DmaBd *Ring, u32 First, u32 Cnt);
+static void Test_PrintStats(const char *Call, const Xil_EmuStats *Before);
+
+/************************** Variable Definitions *****************************/
+
+static Xil_EmuRegion DmaRegion;
+static u32 DmaRegs[DMA_REGS_SIZE / 4U];
+static DmaBd BdRing[DMA_NUM_BDS] __attribute__ ((aligned(64)));
+static u8 SrcBuf[DMA_NUM_BDS][DMA_COPY_LEN];
+static u8 DstBuf[DMA_NUM_BDS][DMA_COPY_LEN];
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the register IO emulation test.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+int main(void)
+{
+	Xil_EmuStats Before;
+	u32 Bd, Idx;
+	u32 Done;
+
+	printf("Register IO emulation test\r\n");
+
+	DmaRegs[DMA_SR_OFFSET >> 2U] = DMA_SR_IDLE_MASK;
+	if (Xil_EmuAddRegion(&DmaRegion, "dma", DMA_BASEADDR, DMA_REGS_SIZE,
+			     DmaRegs) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Xil_EmuSetHandlers(&DmaRegion, NULL, Dma_Write, NULL);
+
+	for (Bd = 0U; Bd < DMA_NUM_BDS; Bd++) {
+		for (Idx = 0U; Idx < DMA_COPY_LEN; Idx++) {
+			SrcBuf[Bd][Idx] = (u8)(Bd + Idx);
+		}
+	}
+
+	Xil_EmuResetStats();
+	Xil_EmuGetStats(&Before);
+	Dma_Start(BdRing);
+	Test_PrintStats("Dma_Start", &Before);
+
+	Xil_EmuGetStats(&Before);
+	Dma_Submit(BdRing, 0U, DMA_NUM_BDS);
+	Test_PrintStats("Dma_Submit", &Before);
+
+	Xil_EmuGetStats(&Before);
+	Done = Dma_Reap(BdRing, 0U, DMA_NUM_BDS);
+	Test_PrintStats("Dma_Reap", &Before);
+
+	if (Done != DMA_NUM_BDS) {
+		printf("Register IO emulation test failed, %u copies done\r\n",
+		       (unsigned int)Done);
+		return XST_FAILURE;
+	}
+	for (Bd = 0U; Bd < DMA_NUM_BDS; Bd++) {
+		for (Idx = 0U; Idx < DMA_COPY_LEN; Idx++) {
+			if (DstBuf[Bd][Idx] != SrcBuf[Bd][Idx]) {
+				printf("Register IO emulation test failed, "
+				       "copy %u differs at %u\r\n",
+				       (unsigned int)Bd, (unsigned int)Idx);
+				return XST_FAILURE;
+			}
+		}
+	}
+
+	printf("Successfully ran register IO emulation test\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Write handler of the DMA engine model. The status bits are write one to
+* clear, and a write to the tail descriptor starts the engine on the
+* descriptors from the current descriptor to the tail descriptor.
+*
+* @param	CallBackRef is not used.
+* @param	Offset is the offset of the register written.
+* @param	RegsPtr is the register file of the engine.
+* @param	Value is the value written.
+*
+* @return	The value held by the register after the write.
+*
+******************************************************************************/
+static u32 Dma_Write(void *CallBackRef, u32 Offset, u32 *RegsPtr, u32 Value)
+{
+	(void)CallBackRef;
+
+	switch (Offset) {
+	case DMA_SR_OFFSET:
+		return RegsPtr[DMA_SR_OFFSET >> 2U] &
+			~(Value & DMA_SR_IOC_MASK);
+	case DMA_TAILDESC_OFFSET:
+		RegsPtr[DMA_TAILDESC_OFFSET >> 2U] = Value;
+		if ((RegsPtr[DMA_CR_OFFSET >> 2U] & DMA_CR_RUN_MASK) != 0U) {
+			Dma_Walk(RegsPtr);
+		}
+		return Value;
+	default:
+		return Value;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Processes the descriptors from the current descriptor to the tail
+* descriptor, the way the engine fetches them from memory. The model accesses
+* the descriptors directly, so only the accesses of the driver are counted.
+*
+* @param	RegsPtr is the register file of the engine.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Dma_Walk(u32 *RegsPtr)
+{
+	DmaBd *Bd;
+	DmaBd *Tail;
+	u32 Len;
+	u32 Idx;
+
+	Bd = (DmaBd *)(UINTPTR)(((u64)RegsPtr[DMA_CURDESC_MSB_OFFSET >> 2U]
+			<< 32U) | RegsPtr[DMA_CURDESC_OFFSET >> 2U]);
+	Tail = (DmaBd *)(UINTPTR)(((u64)RegsPtr[DMA_TAILDESC_MSB_OFFSET >> 2U]
+			<< 32U) | RegsPtr[DMA_TAILDESC_OFFSET >> 2U]);
+
+	RegsPtr[DMA_SR_OFFSET >> 2U] &= ~DMA_SR_IDLE_MASK;
+	while (1) {
+		Len = Bd->Len & DMA_BD_LEN_MASK;
+		for (Idx = 0U; Idx < Len; Idx++) {
+			((u8 *)(UINTPTR)Bd->Dst)[Idx] =
+				((const u8 *)(UINTPTR)Bd->Src)[Idx];
+		}
+		Bd->Status = DMA_BD_CMPLT_MASK | Len;
+		if (Bd == Tail) {
+			break;
+		}
+		Bd = (DmaBd *)(UINTPTR)Bd->Next;
+	}
+
+	/* The next submission starts after the tail */
+	RegsPtr[DMA_CURDESC_OFFSET >> 2U] = (u32)(UINTPTR)Bd->Next;
+	RegsPtr[DMA_CURDESC_MSB_OFFSET >> 2U] = (u32)((u64)Bd->Next >> 32U);
+	RegsPtr[DMA_SR_OFFSET >> 2U] |= DMA_SR_IDLE_MASK | DMA_SR_IOC_MASK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Links the descriptors of the ring and starts the engine.
+*
+* @param	Ring is the descriptor ring.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Dma_Start(DmaBd *Ring)
+{
+	u32 Bd;
+
+	for (Bd = 0U; Bd < DMA_NUM_BDS; Bd++) {
+		Xil_Out64((UINTPTR)&Ring[Bd].Next,
+			  (UINTPTR)&Ring[(Bd + 1U) % DMA_NUM_BDS]);
+	}
+
+	Xil_Out32(DMA_BASEADDR + DMA_CURDESC_OFFSET, (u32)(UINTPTR)Ring);
+	Xil_Out32(DMA_BASEADDR + DMA_CURDESC_MSB_OFFSET,
+		  (u32)((u64)(UINTPTR)Ring >> 32U));
+	Xil_Out32(DMA_BASEADDR + DMA_CR_OFFSET,
+		  Xil_In32(DMA_BASEADDR + DMA_CR_OFFSET) | DMA_CR_RUN_MASK);
+}
+
+/*****************************************************************************/
+/**
+*
+* Submits a copy on each of Cnt descriptors starting at First, and starts
+* the engine on them with a single tail descriptor write.
+*
+* @param	Ring is the descriptor ring.
+* @param	First is the first descriptor.
+* @param	Cnt is the number of descriptors.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Dma_Submit(DmaBd *Ring, u32 First, u32 Cnt)
+{
+	DmaBd *Bd = NULL;
+	u32 Idx;
+
+	for (Idx = First; Idx < (First + Cnt); Idx++) {
+		Bd = &Ring[Idx % DMA_NUM_BDS];
+		Xil_Out64((UINTPTR)&Bd->Src, (UINTPTR)SrcBuf[Idx]);
+		Xil_Out64((UINTPTR)&Bd->Dst, (UINTPTR)DstBuf[Idx]);
+		Xil_Out32((UINTPTR)&Bd->Len, DMA_COPY_LEN);
+		Xil_Out32((UINTPTR)&Bd->Status, 0U);
+	}
+
+	Xil_Out32(DMA_BASEADDR + DMA_TAILDESC_MSB_OFFSET,
+		  (u32)((u64)(UINTPTR)Bd >> 32U));
+	Xil_Out32(DMA_BASEADDR + DMA_TAILDESC_OFFSET, (u32)(UINTPTR)Bd);
+}
+
+/*****************************************************************************/
+/**
+*
+* Waits for the engine to be idle, clears the completion interrupt and
+* counts the completed descriptors.
+*
+* @param	Ring is the descriptor ring.
+* @param	First is the first descriptor submitted.
+* @param	Cnt is the number of descriptors submitted.
+*
+* @return	Number of completed descriptors.
+*
+******************************************************************************/
+static u32 Dma_Reap(DmaBd *Ring, u32 First, u32 Cnt)
+{
+	u32 Done = 0U;
+	u32 Idx;
+
+	while ((Xil_In32(DMA_BASEADDR + DMA_SR_OFFSET) &
+		DMA_SR_IDLE_MASK) == 0U) {
+		;
+	}
+	Xil_Out32(DMA_BASEADDR + DMA_SR_OFFSET, DMA_SR_IOC_MASK);
+
+	for (Idx = First; Idx < (First + Cnt); Idx++) {
+		if ((Xil_In32((UINTPTR)&Ring[Idx % DMA_NUM_BDS].Status) &
+		     DMA_BD_CMPLT_MASK) != 0U) {
+			Done++;
+		}
+	}
+
+	return Done;
+}
+
+/*****************************************************************************/
+/**
+*
+* Prints the accesses made since the counts were read in Before.
+*
+* @param	Call is the name of the call measured.
+* @param	Before is the access counts before the call.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Test_PrintStats(const char *Call, const Xil_EmuStats *Before)
+{
+	Xil_EmuStats After;
+
+	Xil_EmuGetStats(&After);
+	printf("%s: %u register reads, %u register writes, "
+	       "%u descriptor reads, %u descriptor writes\r\n", Call,
+	       (unsigned int)(After.RegReads - Before->RegReads),
+	       (unsigned int)(After.RegWrites - Before->RegWrites),
+	       (unsigned int)(After.MemReads - Before->MemReads),
+	       (unsigned int)(After.MemWrites - Before->MemWrites));
+}
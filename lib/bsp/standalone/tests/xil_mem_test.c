@@ -0,0 +1,307 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/**
+*
+* @file xil_mem_test.c
+*
+* Implements test that checks Xil_MemCpy, Xil_MemSet, Xil_MemCmpFast and
+* Xil_MemCmp against byte by byte reference loops, for every combination of
+* source and destination alignment and for lengths up to MEM_MAX_LEN bytes.
+* The checks run on the build machine, see the Makefile of this directory,
+* and on any processor. On Cortex-A9, Cortex-A53, Cortex-A72 and Cortex-R5
+* based platforms the bandwidth of Xil_MemCpy and Xil_MemSet is reported too.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.3   mus  11/16/20  First release of test which checks and measures the
+*                      memory operation APIs.
+* </pre>
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xil_mem.h"
+#include "xil_util.h"
+#include "xil_printf.h"
+#if defined (__arm__) || defined (__aarch64__)
+#include "xtime_l.h"
+#define MEM_TIMING_EN
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define MEM_MAX_OFFSET		16U	/* Alignments checked */
+#define MEM_MAX_LEN		300U	/* Lengths checked */
+#define MEM_GUARD		16U	/* Bytes checked around the buffers */
+#define MEM_BUF_SIZE		(MEM_GUARD + MEM_MAX_OFFSET + MEM_MAX_LEN + \
+				 MEM_GUARD)
+#define MEM_GUARD_BYTE		0xA5U
+
+#define MEM_BENCH_SIZE		(64U * 1024U)
+#define MEM_BENCH_PASSES	100U
+
+/**************************** Type Definitions *******************************/
+
+typedef s32 (*Mem_CmpFunc)(const void *Buf1, const void *Buf2, u32 Len);
+
+/************************** Function Prototypes ******************************/
+
+static u32 Mem_CheckCpy(void);
+static u32 Mem_CheckSet(void);
+static u32 Mem_CheckCmp(Mem_CmpFunc Cmp, const char *Name);
+static s32 Mem_SecureCmp(const void *Buf1, const void *Buf2, u32 Len);
+#ifdef MEM_TIMING_EN
+static void Mem_Bench(void);
+#endif
+
+/************************** Variable Definitions *****************************/
+
+static u8 SrcBuf[MEM_BUF_SIZE] __attribute__ ((aligned(64)));
+static u8 DstBuf[MEM_BUF_SIZE] __attribute__ ((aligned(64)));
+static u8 RefBuf[MEM_BUF_SIZE] __attribute__ ((aligned(64)));
+#ifdef MEM_TIMING_EN
+static u8 BenchSrc[MEM_BENCH_SIZE + 64U] __attribute__ ((aligned(64)));
+static u8 BenchDst[MEM_BENCH_SIZE + 64U] __attribute__ ((aligned(64)));
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the memory operations test.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+******************************************************************************/
+int main(void)
+{
+	u32 Errors;
+
+	xil_printf("Memory operations test\r\n");
+
+	Errors = Mem_CheckCpy();
+	Errors += Mem_CheckSet();
+	Errors += Mem_CheckCmp(Xil_MemCmpFast, "Xil_MemCmpFast");
+	Errors += Mem_CheckCmp(Mem_SecureCmp, "Xil_MemCmp");
+	if (Errors != 0U) {
+		xil_printf("Memory operations test failed, %d errors\r\n",
+			   Errors);
+		return XST_FAILURE;
+	}
+
+#ifdef MEM_TIMING_EN
+	Mem_Bench();
+#endif
+
+	xil_printf("Successfully ran memory operations test\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks Xil_MemCpy for every source and destination alignment and length,
+* including that the bytes around the destination are not modified.
+*
+* @return	Number of failing copies.
+*
+******************************************************************************/
+static u32 Mem_CheckCpy(void)
+{
+	u32 SrcOff, DstOff, Len, Idx;
+	u32 Errors = 0U;
+
+	for (Idx = 0U; Idx < MEM_BUF_SIZE; Idx++) {
+		SrcBuf[Idx] = (u8)((Idx * 7U) + 1U);
+	}
+
+	for (SrcOff = 0U; SrcOff < MEM_MAX_OFFSET; SrcOff++) {
+		for (DstOff = 0U; DstOff < MEM_MAX_OFFSET; DstOff++) {
+			for (Len = 0U; Len <= MEM_MAX_LEN; Len++) {
+				for (Idx = 0U; Idx < MEM_BUF_SIZE; Idx++) {
+					DstBuf[Idx] = MEM_GUARD_BYTE;
+					RefBuf[Idx] = MEM_GUARD_BYTE;
+				}
+				for (Idx = 0U; Idx < Len; Idx++) {
+					RefBuf[MEM_GUARD + DstOff + Idx] =
+						SrcBuf[MEM_GUARD + SrcOff + Idx];
+				}
+
+				Xil_MemCpy(&DstBuf[MEM_GUARD + DstOff],
+					   &SrcBuf[MEM_GUARD + SrcOff], Len);
+
+				for (Idx = 0U; Idx < MEM_BUF_SIZE; Idx++) {
+					if (DstBuf[Idx] != RefBuf[Idx]) {
+						break;
+					}
+				}
+				if (Idx != MEM_BUF_SIZE) {
+					xil_printf("Xil_MemCpy src +%d dst +%d "
+						   "len %d failed at %d\r\n",
+						   SrcOff, DstOff, Len, Idx);
+					Errors++;
+				}
+			}
+		}
+	}
+
+	return Errors;
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks Xil_MemSet for every destination alignment and length, including
+* that the bytes around the destination are not modified.
+*
+* @return	Number of failing fills.
+*
+******************************************************************************/
+static u32 Mem_CheckSet(void)
+{
+	u32 DstOff, Len, Idx;
+	u32 Errors = 0U;
+	s32 Val = 0x15A;
+
+	for (DstOff = 0U; DstOff < MEM_MAX_OFFSET; DstOff++) {
+		for (Len = 0U; Len <= MEM_MAX_LEN; Len++) {
+			for (Idx = 0U; Idx < MEM_BUF_SIZE; Idx++) {
+				DstBuf[Idx] = MEM_GUARD_BYTE;
+				RefBuf[Idx] = MEM_GUARD_BYTE;
+			}
+			for (Idx = 0U; Idx < Len; Idx++) {
+				RefBuf[MEM_GUARD + DstOff + Idx] = (u8)Val;
+			}
+
+			Xil_MemSet(&DstBuf[MEM_GUARD + DstOff], Val, Len);
+
+			for (Idx = 0U; Idx < MEM_BUF_SIZE; Idx++) {
+				if (DstBuf[Idx] != RefBuf[Idx]) {
+					break;
+				}
+			}
+			if (Idx != MEM_BUF_SIZE) {
+				xil_printf("Xil_MemSet dst +%d len %d failed "
+					   "at %d\r\n", DstOff, Len, Idx);
+				Errors++;
+			}
+		}
+	}
+
+	return Errors;
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks a compare function for every alignment of both buffers and every
+* length, with equal buffers and with a single different byte at each
+* position.
+*
+* @param	Cmp is the compare function.
+* @param	Name is the name of the compare function.
+*
+* @return	Number of failing compares.
+*
+******************************************************************************/
+static u32 Mem_CheckCmp(Mem_CmpFunc Cmp, const char *Name)
+{
+	u32 Off1, Off2, Len, Pos;
+	u32 Errors = 0U;
+	int Ret;
+	int Expected;
+	u8 *Buf1;
+	u8 *Buf2;
+
+	for (Off1 = 0U; Off1 < MEM_MAX_OFFSET; Off1++) {
+		for (Off2 = 0U; Off2 < MEM_MAX_OFFSET; Off2++) {
+			Buf1 = &SrcBuf[MEM_GUARD + Off1];
+			Buf2 = &DstBuf[MEM_GUARD + Off2];
+			for (Len = 1U; Len <= MEM_MAX_LEN; Len += 7U) {
+				Xil_MemCpy(Buf2, Buf1, Len);
+				if (Cmp(Buf1, Buf2, Len) != 0) {
+					xil_printf("%s +%d +%d len %d "
+						   "equal failed\r\n", Name,
+						   Off1, Off2, Len);
+					Errors++;
+				}
+				for (Pos = 0U; Pos < Len; Pos++) {
+					Buf2[Pos] ^= (u8)(1U << (Pos & 7U));
+					Expected = (Buf1[Pos] > Buf2[Pos]) ?
+						   1 : -1;
+					Ret = Cmp(Buf1, Buf2, Len);
+					Buf2[Pos] = Buf1[Pos];
+					if (Ret != Expected) {
+						xil_printf("%s +%d +%d "
+							   "len %d pos %d failed"
+							   "\r\n", Name, Off1,
+							   Off2, Len, Pos);
+						Errors++;
+					}
+				}
+			}
+		}
+	}
+
+	return Errors;
+}
+
+/*****************************************************************************/
+/**
+*
+* Calls Xil_MemCmp with the prototype of Xil_MemCmpFast.
+*
+******************************************************************************/
+static s32 Mem_SecureCmp(const void *Buf1, const void *Buf2, u32 Len)
+{
+	return (s32)Xil_MemCmp(Buf1, Buf2, Len);
+}
+
+#ifdef MEM_TIMING_EN
+/*****************************************************************************/
+/**
+*
+* Prints the bandwidth of Xil_MemCpy with aligned and misaligned buffers and
+* of Xil_MemSet, for MEM_BENCH_SIZE byte buffers.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Mem_Bench(void)
+{
+	static const u32 SrcOff[] = { 0U, 0U, 1U, 3U };
+	static const u32 DstOff[] = { 0U, 4U, 0U, 5U };
+	XTime Start, End;
+	u32 Test, Pass;
+	u64 Bytes = (u64)MEM_BENCH_SIZE * MEM_BENCH_PASSES;
+
+	for (Test = 0U; Test < (sizeof(SrcOff) / sizeof(SrcOff[0])); Test++) {
+		XTime_GetTime(&Start);
+		for (Pass = 0U; Pass < MEM_BENCH_PASSES; Pass++) {
+			Xil_MemCpy(&BenchDst[DstOff[Test]],
+				   &BenchSrc[SrcOff[Test]], MEM_BENCH_SIZE);
+		}
+		XTime_GetTime(&End);
+		xil_printf("Xil_MemCpy src +%d dst +%d: %d MB/s\r\n",
+			   SrcOff[Test], DstOff[Test],
+			   (u32)((Bytes * COUNTS_PER_SECOND) /
+				 ((End - Start) * 1000000U)));
+	}
+
+	XTime_GetTime(&Start);
+	for (Pass = 0U; Pass < MEM_BENCH_PASSES; Pass++) {
+		Xil_MemSet(BenchDst, (s32)Pass, MEM_BENCH_SIZE);
+	}
+	XTime_GetTime(&End);
+	xil_printf("Xil_MemSet: %d MB/s\r\n",
+		   (u32)((Bytes * COUNTS_PER_SECOND) /
+			 ((End - Start) * 1000000U)));
+}
+#endif
@@ -9,6 +9,10 @@
 # 1.00a hk/sg 10/17/13 First release
 # 2.0   hk    12/13/13 Modified to use new TCL API's
 # 4.1   hk    11/21/18 Use additional LFN options
+# 4.4   mn    10/18/20 Add block cache options
+#       mn    10/18/20 Add fast seek option
+#       mn    10/18/20 Add re-entrancy and file lock options
+#       mn    10/18/20 Add NAND interface with flash translation layer
 #
 ##############################################################################
 
@@ -32,6 +36,11 @@ proc ffs_drc {libhandle} {
 		puts "WARNING : No interface that uses file system is available \n"
 	}
 
+	global ffs_periphs_name_list
+	if {$fs_interface == 3 && [lsearch -exact $ffs_periphs_name_list "psu_nand"] < 0} {
+		puts "WARNING : NAND interface selected but no NAND controller is available \n"
+	}
+
 }
 
 proc get_ffs_periphs {processor} {
@@ -45,7 +54,8 @@ proc get_ffs_periphs {processor} {
 		set periphname [common::get_property IP_NAME $periph]
 		# Checks if SD instance is present
 		# This can be expanded to add more instances.
-		if {$periphname == "ps7_sdio" || $periphname == "psu_sd" || $periphname == "psv_pmc_sd"} {
+		if {$periphname == "ps7_sdio" || $periphname == "psu_sd" || $periphname == "psv_pmc_sd" ||
+		    $periphname == "psu_nand"} {
 			lappend ffs_periphs_list $periph
 			lappend ffs_periphs_name_list $periphname
 		}
@@ -93,6 +103,10 @@ proc xgen_opts_file {libhandle} {
 	set set_fs_rpath [common::get_property CONFIG.set_fs_rpath $libhandle]
 	set word_access [common::get_property CONFIG.word_access $libhandle]
 	set use_chmod [common::get_property CONFIG.use_chmod $libhandle]
+	set enable_block_cache [common::get_property CONFIG.enable_block_cache $libhandle]
+	set use_fastseek [common::get_property CONFIG.use_fastseek $libhandle]
+	set enable_reentrant [common::get_property CONFIG.enable_reentrant $libhandle]
+	set fs_lock [common::get_property CONFIG.fs_lock $libhandle]
 
 	# do processor specific checks
 	set proc  [hsi::get_sw_processor];
@@ -133,9 +147,33 @@ proc xgen_opts_file {libhandle} {
 				break
 			}
 		}
+		if {$periph == "psu_nand" && $fs_interface == 3} {
+			set ftl_start [common::get_property CONFIG.nand_ftl_start_block $libhandle]
+			set ftl_blocks [common::get_property CONFIG.nand_ftl_blocks $libhandle]
+			set ftl_ppb [common::get_property CONFIG.nand_ftl_max_pages_per_block $libhandle]
+			set ftl_page [common::get_property CONFIG.nand_ftl_max_page_size $libhandle]
+			set ftl_op [common::get_property CONFIG.nand_ftl_over_provision $libhandle]
+			set ftl_wbuf [common::get_property CONFIG.nand_ftl_write_buffer_pages $libhandle]
+
+			if {$ftl_op < 0 || $ftl_op > 50} {
+				puts "WARNING : Invalid nand_ftl_over_provision, \
+						setting back to 5\n"
+				set ftl_op 5
+			}
+			if {$ftl_wbuf < 1} {
+				set ftl_wbuf 1
+			}
+			puts $file_handle "\#define FILE_SYSTEM_INTERFACE_NAND"
+			puts $file_handle "\#define FILE_SYSTEM_NAND_FTL_START_BLOCK $ftl_start"
+			puts $file_handle "\#define FILE_SYSTEM_NAND_FTL_BLOCKS $ftl_blocks"
+			puts $file_handle "\#define FILE_SYSTEM_NAND_FTL_MAX_PAGES_PER_BLOCK $ftl_ppb"
+			puts $file_handle "\#define FILE_SYSTEM_NAND_FTL_MAX_PAGE_SIZE $ftl_page"
+			puts $file_handle "\#define FILE_SYSTEM_NAND_FTL_OVER_PROVISION $ftl_op"
+			puts $file_handle "\#define FILE_SYSTEM_NAND_FTL_WBUF_PAGES $ftl_wbuf"
+		}
 	}
 
-	if {$fs_interface == 1 || $fs_interface == 2} {
+	if {$fs_interface == 1 || $fs_interface == 2 || $fs_interface == 3} {
 		if {$read_only == true} {
 			puts $file_handle "\#define FILE_SYSTEM_READ_ONLY"
 		}
@@ -143,6 +181,22 @@ proc xgen_opts_file {libhandle} {
 			puts $file_handle "\#define FILE_SYSTEM_FS_EXFAT"
 			set use_lfn 1
 		}
+		if {$enable_reentrant == true} {
+			set os_name [common::get_property NAME [hsi::get_os]]
+			if { [string compare -nocase "freertos10_xilinx" $os_name] == 0} {
+				puts $file_handle "\#define FILE_SYSTEM_REENTRANT"
+				puts $file_handle "\#define FILE_SYSTEM_OS_IS_FREERTOS"
+				# Static LFN working buffer is not thread-safe
+				if {$use_lfn == 1} {
+					puts "WARNING : LFN with static working buffer \
+							is not thread-safe, using the stack\n"
+					set use_lfn 2
+				}
+			} else {
+				puts "WARNING : Re-entrancy requires freertos, \
+						disabling it\n"
+			}
+		}
 		if {$use_lfn > 0 && $use_lfn < 4} {
 			puts $file_handle "\#define FILE_SYSTEM_USE_LFN $use_lfn"
 		}
@@ -160,6 +214,14 @@ proc xgen_opts_file {libhandle} {
 						Read Only Mode"
 			}
 		}
+		if {$fs_lock > 0} {
+			if {$read_only == false} {
+				puts $file_handle "\#define FILE_SYSTEM_FS_LOCK $fs_lock"
+			} else {
+				puts "WARNING : Cannot Enable file lock in \
+						Read Only Mode"
+			}
+		}
 		if {$num_logical_vol > 10} {
 			puts "WARNING : File System supports only up to 10 logical drives\
 					Setting back the num of vol to 10\n"
@@ -179,6 +241,28 @@ proc xgen_opts_file {libhandle} {
 		}
 		puts $file_handle "\#define FILE_SYSTEM_SET_FS_RPATH $set_fs_rpath"
 
+		if {$use_fastseek == true} {
+			puts $file_handle "\#define FILE_SYSTEM_USE_FASTSEEK"
+		}
+		if {$enable_block_cache == true} {
+			set cache_sectors [common::get_property CONFIG.block_cache_sectors $libhandle]
+			set cache_ways [common::get_property CONFIG.block_cache_ways $libhandle]
+			set cache_xfer [common::get_property CONFIG.block_cache_xfer_sectors $libhandle]
+
+			if {$cache_ways < 1 || [expr $cache_sectors % $cache_ways] != 0} {
+				puts "WARNING : block_cache_ways must divide \
+						block_cache_sectors, setting back to 1\n"
+				set cache_ways 1
+			}
+			if {$cache_xfer < 1} {
+				set cache_xfer 1
+			}
+			puts $file_handle "\#define FILE_SYSTEM_BLOCK_CACHE"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_SECTORS $cache_sectors"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_WAYS $cache_ways"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_XFER_SECTORS $cache_xfer"
+		}
+
 		# MB does not allow word access from RAM
 		if {$proc_type != "microblaze" && $word_access == true} {
 			puts $file_handle "\#define FILE_SYSTEM_WORD_ACCESS"
@@ -0,0 +1,641 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xilffs_nand_ftl_example.c
+*
+*
+* @note This example runs the NAND flash translation layer of the file
+* system (diskftl.c) on a NAND flash simulated in memory, and checks that
+* no data is lost when the power fails.
+* To test this example the file system must be built with "fs_interface"
+* set to 3, and should not be in Read Only mode.
+*
+* The simulated flash has 128 blocks of 32 pages of 2048 bytes, with 64 spare
+* bytes per page and an ECC correcting 4 bits per page. It models:
+*	- factory bad blocks, and blocks wearing out and failing to erase or
+*	  program after a random number of erase cycles,
+*	- bit flips in the data, transient ones and ones caused by the reads
+*	  of the other pages of a block (read disturb), the page being
+*	  uncorrectable when more than 4 bits flipped,
+*	- bit flips in the spare area, which is not ECC protected,
+*	- power loss after a random number of operations, leaving the page
+*	  being programmed or the block being erased half done. Every
+*	  operation fails until the next power on.
+* A page programmed twice without an erase, or a bad block used, is
+* reported as a violation.
+*
+* The test writes sectors with a generation number, mostly to a small hot
+* area, and reads them back. After each power loss the volume is mounted
+* again and every sector must hold a generation which is at least the one
+* of the last sync and at most the last one written.
+* Finally FatFs is run on the simulated flash through
+* disk_nand_set_device(), when USE_MKFS is enabled.
+*
+* None.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 4.4   mn  10/18/20 First release
+*
+*</pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xparameters.h"	/* SDK generated parameters */
+#include "xil_printf.h"
+#include "xstatus.h"
+#include "ff.h"
+#include "diskftl.h"
+
+/************************** Constant Definitions *****************************/
+
+#define SIM_PAGE_SIZE	2048U
+#define SIM_SPARE_SIZE	64U
+#define SIM_PPB		32U
+#define SIM_BLOCKS	128U
+#define SIM_ECC_BITS	4U	/* Bits corrected per page */
+#define SIM_DISTURB	1000U	/* Block reads flipping a bit in the others */
+
+#define SIM_SECTORS	(SIM_BLOCKS * SIM_PPB * (SIM_PAGE_SIZE / 512U))
+#define WORK_WORDS	FTL_WORK_WORDS(SIM_BLOCKS, SIM_PPB, SIM_PAGE_SIZE)
+
+#define POWER_CYCLES	150U	/* Power losses of the test */
+#define HOT_PERCENT	95U	/* Writes to the hot area */
+#define HOT_SECTORS	512U
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u32 EraseCnt;
+	u32 Endurance;		/* Erase count from which the block fails */
+	u32 Reads;		/* Page reads since the erase */
+	u8 Bad;			/* Marked bad */
+	u8 Programmed[SIM_PPB];
+	u8 Flips[SIM_PPB];	/* Read disturb flips of each page */
+} SIM_BLOCK;
+
+/************************** Function Prototypes ******************************/
+
+int FfsNandFtlExample(void);
+
+/************************** Variable Definitions *****************************/
+
+static u8 SimData[SIM_BLOCKS][SIM_PPB][SIM_PAGE_SIZE];
+static u8 SimSpare[SIM_BLOCKS][SIM_PPB][SIM_SPARE_SIZE];
+static SIM_BLOCK SimBlock[SIM_BLOCKS];
+static u32 SimOpsLeft;		/* Operations before the power fails */
+static u32 SimPowerLost;
+static u32 SimViolations;
+static u32 SimRandState = 0x2545F491U;
+
+static FTL_DEVICE SimDevice;
+static FTL_VOLUME Volume;
+static u32 Work[WORK_WORDS];
+
+static u32 Latest[SIM_SECTORS];	/* Generation last written */
+static u32 Synced[SIM_SECTORS];	/* Generation at the last sync */
+static u8 Buf[16U * 512U];
+static u32 NumSectors;
+static u32 Errors;
+static FTL_STATS Total;		/* Statistics of all the power cycles */
+
+/*****************************************************************************/
+/**
+*
+* Pseudo random number generator (xorshift).
+*
+******************************************************************************/
+static u32 Rand(void)
+{
+	SimRandState ^= SimRandState << 13;
+	SimRandState ^= SimRandState >> 17;
+	SimRandState ^= SimRandState << 5;
+	return SimRandState;
+}
+
+/*****************************************************************************/
+/**
+*
+* Counts an operation of the simulated flash and cuts the power when the
+* count expires.
+*
+* @return	1 if the power is cut during this operation, 0 otherwise.
+*
+******************************************************************************/
+static u32 SimCut(void)
+{
+	if (SimOpsLeft > 0U) {
+		SimOpsLeft--;
+		if (SimOpsLeft == 0U) {
+			SimPowerLost = 1U;
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+static INT SimReadPage(void *ctx, u32 page, BYTE *data, BYTE *tag)
+{
+	u32 Blk = page / SIM_PPB;
+	u32 Pg = page % SIM_PPB;
+	u32 Bits, Idx;
+
+	(void)ctx;
+	if (SimPowerLost != 0U) {
+		return -1;
+	}
+	if (SimBlock[Blk].Bad != 0U) {
+		SimViolations++;
+	}
+
+	if (tag != NULL) {
+		(void)memcpy(tag, &SimSpare[Blk][Pg][2], FTL_TAG_SIZE);
+		/* The spare area is read raw */
+		if ((Rand() % 2000U) == 0U) {
+			tag[Rand() % FTL_TAG_SIZE] ^= (BYTE)(1U << (Rand() % 8U));
+		}
+	}
+	if (data == NULL) {
+		return 0;
+	}
+
+	/* Read disturb of the other pages of the block */
+	SimBlock[Blk].Reads++;
+	if ((SimBlock[Blk].Reads % SIM_DISTURB) == 0U) {
+		Idx = Rand() % SIM_PPB;
+		if ((Idx != Pg) && (SimBlock[Blk].Flips[Idx] < 0xFFU)) {
+			SimBlock[Blk].Flips[Idx]++;
+		}
+	}
+
+	Bits = SimBlock[Blk].Flips[Pg];
+	if ((Rand() % 50U) == 0U) {
+		Bits += 1U + (Rand() % 3U);
+	}
+	if (SimBlock[Blk].Programmed[Pg] == 0U) {
+		Bits = 0U;
+	}
+	if (Bits > SIM_ECC_BITS) {
+		return -1;
+	}
+
+	(void)memcpy(data, SimData[Blk][Pg], SIM_PAGE_SIZE);
+	return (INT)Bits;
+}
+
+static INT SimProgramPage(void *ctx, u32 page, const BYTE *data, const BYTE *tag)
+{
+	u32 Blk = page / SIM_PPB;
+	u32 Pg = page % SIM_PPB;
+	u32 Len;
+
+	(void)ctx;
+	if (SimPowerLost != 0U) {
+		return -1;
+	}
+	if ((SimBlock[Blk].Bad != 0U) || (SimBlock[Blk].Programmed[Pg] != 0U)) {
+		SimViolations++;
+		return -1;
+	}
+	SimBlock[Blk].Programmed[Pg] = 1U;
+
+	if (SimCut() != 0U) {
+		/*
+		 * The tag is programmed after the data: either the data is
+		 * partial and the tag missing, or the tag is partial.
+		 */
+		if ((Rand() % 2U) == 0U) {
+			Len = Rand() % SIM_PAGE_SIZE;
+			(void)memcpy(SimData[Blk][Pg], data, Len);
+		} else {
+			(void)memcpy(SimData[Blk][Pg], data, SIM_PAGE_SIZE);
+			Len = Rand() % FTL_TAG_SIZE;
+			(void)memcpy(&SimSpare[Blk][Pg][2], tag, Len);
+		}
+		return -1;
+	}
+
+	if ((SimBlock[Blk].EraseCnt >= SimBlock[Blk].Endurance) &&
+			((Rand() % 8U) == 0U)) {
+		Len = Rand() % SIM_PAGE_SIZE;
+		(void)memcpy(SimData[Blk][Pg], data, Len);
+		return -1;
+	}
+
+	(void)memcpy(SimData[Blk][Pg], data, SIM_PAGE_SIZE);
+	(void)memcpy(&SimSpare[Blk][Pg][2], tag, FTL_TAG_SIZE);
+	SimBlock[Blk].Flips[Pg] = 0U;
+	return 0;
+}
+
+static INT SimEraseBlock(void *ctx, u32 block)
+{
+	SIM_BLOCK *Blk = &SimBlock[block];
+	u32 Pg;
+
+	(void)ctx;
+	if (SimPowerLost != 0U) {
+		return -1;
+	}
+	if (Blk->Bad != 0U) {
+		SimViolations++;
+		return -1;
+	}
+
+	if (SimCut() != 0U) {
+		/* Some pages are erased, others left garbled */
+		for (Pg = 0U; Pg < SIM_PPB; Pg++) {
+			if ((Rand() % 2U) == 0U) {
+				(void)memset(SimData[block][Pg], 0xFF, SIM_PAGE_SIZE);
+				(void)memset(SimSpare[block][Pg], 0xFF, SIM_SPARE_SIZE);
+				Blk->Programmed[Pg] = 0U;
+			} else {
+				SimData[block][Pg][Rand() % SIM_PAGE_SIZE] ^= 0x10U;
+				SimSpare[block][Pg][2U + (Rand() % FTL_TAG_SIZE)] ^= 0x01U;
+				Blk->Programmed[Pg] = 1U;
+			}
+		}
+		return -1;
+	}
+
+	Blk->EraseCnt++;
+	if ((Blk->EraseCnt > Blk->Endurance) && ((Rand() % 4U) == 0U)) {
+		return -1;
+	}
+
+	(void)memset(SimData[block], 0xFF, sizeof(SimData[block]));
+	(void)memset(SimSpare[block], 0xFF, sizeof(SimSpare[block]));
+	(void)memset(Blk->Programmed, 0, sizeof(Blk->Programmed));
+	(void)memset(Blk->Flips, 0, sizeof(Blk->Flips));
+	Blk->Reads = 0U;
+	return 0;
+}
+
+static INT SimIsBad(void *ctx, u32 block)
+{
+	(void)ctx;
+	return (SimBlock[block].Bad != 0U) ? 1 : 0;
+}
+
+static INT SimMarkBad(void *ctx, u32 block)
+{
+	(void)ctx;
+	if (SimPowerLost != 0U) {
+		return -1;
+	}
+	SimBlock[block].Bad = 1U;
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Initializes the simulated flash: erased, with a few factory bad blocks and
+* a few weak blocks.
+*
+******************************************************************************/
+static void SimInit(void)
+{
+	u32 Blk;
+
+	(void)memset(SimData, 0xFF, sizeof(SimData));
+	(void)memset(SimSpare, 0xFF, sizeof(SimSpare));
+	(void)memset(SimBlock, 0, sizeof(SimBlock));
+	for (Blk = 0U; Blk < SIM_BLOCKS; Blk++) {
+		SimBlock[Blk].Endurance = 3000U + (Rand() % 3000U);
+		if ((Rand() % 64U) == 0U) {
+			SimBlock[Blk].Endurance = 50U + (Rand() % 150U);
+		}
+		if ((Rand() % 64U) == 0U) {
+			SimBlock[Blk].Bad = 1U;
+		}
+	}
+
+	SimDevice.ctx = NULL;
+	SimDevice.page_size = SIM_PAGE_SIZE;
+	SimDevice.pages_per_block = SIM_PPB;
+	SimDevice.num_blocks = SIM_BLOCKS;
+	SimDevice.scrub_bits = SIM_ECC_BITS - 1U;
+	SimDevice.read_page = SimReadPage;
+	SimDevice.read_pages = NULL;
+	SimDevice.program_page = SimProgramPage;
+	SimDevice.erase_block = SimEraseBlock;
+	SimDevice.is_bad = SimIsBad;
+	SimDevice.mark_bad = SimMarkBad;
+}
+
+/*****************************************************************************/
+/**
+*
+* Fills and checks the content of a sector for a generation. Generation 0 is
+* a sector never written, which reads as erased.
+*
+******************************************************************************/
+static void FillSector(u8 *Ptr, u32 Sector, u32 Gen)
+{
+	u32 Idx;
+
+	if (Gen == 0U) {
+		(void)memset(Ptr, 0xFF, 512U);
+		return;
+	}
+	for (Idx = 0U; Idx < 512U; Idx += 4U) {
+		u32 Val = (Idx == 0U) ? Sector : ((Idx == 4U) ? Gen :
+				((Sector * 2654435761U) ^ (Gen * 40503U) ^ Idx));
+		(void)memcpy(&Ptr[Idx], &Val, 4U);
+	}
+}
+
+static u32 SectorGen(const u8 *Ptr, u32 Sector)
+{
+	u8 Expect[512];
+	u32 Gen;
+
+	(void)memcpy(&Gen, &Ptr[4], 4U);
+	if ((Ptr[0] == 0xFFU) && (Ptr[4] == 0xFFU) && (Ptr[511] == 0xFFU)) {
+		Gen = 0U;
+	}
+	FillSector(Expect, Sector, Gen);
+	if (memcmp(Expect, Ptr, 512U) != 0) {
+		return 0xFFFFFFFFU;
+	}
+
+	return Gen;
+}
+
+/*****************************************************************************/
+/**
+*
+* Adds the statistics of the volume before a power loss to the totals.
+*
+******************************************************************************/
+static void AddStats(void)
+{
+	FTL_STATS Stats;
+
+	disk_ftl_stats(&Volume, &Stats);
+	Total.HostPages += Stats.HostPages;
+	Total.GcPages += Stats.GcPages;
+	Total.CkptPages += Stats.CkptPages;
+	Total.StaticMoves += Stats.StaticMoves;
+	Total.Scrubs += Stats.Scrubs;
+	Total.ReadErrors += Stats.ReadErrors;
+	Total.ReplayPages += Stats.ReplayPages;
+	Total.BadBlocks = Stats.BadBlocks;
+	Total.MinErase = Stats.MinErase;
+	Total.MaxErase = Stats.MaxErase;
+}
+
+/*****************************************************************************/
+/**
+*
+* Mounts the volume after a power loss and checks every sector against the
+* reference model.
+*
+******************************************************************************/
+static int CheckVolume(void)
+{
+	u32 Sector, Gen;
+
+	if (disk_ftl_mount(&Volume, &SimDevice, Work, WORK_WORDS) != FTL_OK) {
+		xil_printf("Mount failed\r\n");
+		return XST_FAILURE;
+	}
+
+	for (Sector = 0U; Sector < NumSectors; Sector++) {
+		if (disk_ftl_read(&Volume, Buf, Sector, 1U) != RES_OK) {
+			xil_printf("Sector %d unreadable\r\n", (int)Sector);
+			Errors++;
+			continue;
+		}
+		Gen = SectorGen(Buf, Sector);
+		if ((Gen < Synced[Sector]) || (Gen > Latest[Sector])) {
+			xil_printf("Sector %d generation %d, expected %d to %d\r\n",
+				(int)Sector, (int)Gen, (int)Synced[Sector],
+				(int)Latest[Sector]);
+			Errors++;
+			continue;
+		}
+		Latest[Sector] = Gen;
+		Synced[Sector] = Gen;
+	}
+
+	return (Errors == 0U) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes and reads sectors until the power fails.
+*
+******************************************************************************/
+static void RunWorkload(void)
+{
+	u32 Sector, Count, Idx, Gen;
+	u32 Op;
+
+	for (Op = 0U; SimPowerLost == 0U; Op++) {
+		Count = 1U + (Rand() % 16U);
+		if ((Rand() % 100U) < HOT_PERCENT) {
+			Sector = Rand() % (HOT_SECTORS - Count);
+		} else {
+			Sector = Rand() % (NumSectors - Count);
+		}
+
+		if ((Rand() % 3U) == 0U) {
+			if (disk_ftl_read(&Volume, Buf, Sector, Count) != RES_OK) {
+				if (SimPowerLost == 0U) {
+					xil_printf("Read of sector %d failed\r\n",
+						(int)Sector);
+					Errors++;
+				}
+				continue;
+			}
+			for (Idx = 0U; Idx < Count; Idx++) {
+				Gen = SectorGen(&Buf[Idx * 512U], Sector + Idx);
+				if ((SimPowerLost == 0U) &&
+						(Gen != Latest[Sector + Idx])) {
+					xil_printf("Sector %d reads generation %d, "
+						"expected %d\r\n", (int)(Sector + Idx),
+						(int)Gen, (int)Latest[Sector + Idx]);
+					Errors++;
+				}
+			}
+		} else {
+			for (Idx = 0U; Idx < Count; Idx++) {
+				FillSector(&Buf[Idx * 512U], Sector + Idx,
+					Latest[Sector + Idx] + 1U);
+			}
+			if (disk_ftl_write(&Volume, Buf, Sector, Count) == RES_OK) {
+				for (Idx = 0U; Idx < Count; Idx++) {
+					Latest[Sector + Idx]++;
+				}
+			} else if (SimPowerLost == 0U) {
+				xil_printf("Write of sector %d failed\r\n", (int)Sector);
+				Errors++;
+			} else {
+				/* Any of the sectors may have been written */
+				for (Idx = 0U; Idx < Count; Idx++) {
+					Latest[Sector + Idx]++;
+				}
+			}
+		}
+
+		/* A sync after the power loss may succeed with nothing to write */
+		if ((SimPowerLost == 0U) && ((Rand() % 40U) == 0U)) {
+			if (disk_ftl_sync(&Volume) == RES_OK) {
+				(void)memcpy(Synced, Latest, sizeof(Synced));
+			} else if (SimPowerLost == 0U) {
+				xil_printf("Sync failed\r\n");
+				Errors++;
+			}
+		}
+		if (Errors != 0U) {
+			break;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the NAND FTL example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+
+	xil_printf("NAND FTL File System Example Test \r\n");
+
+	Status = FfsNandFtlExample();
+	if (Status != XST_SUCCESS) {
+		xil_printf("NAND FTL File System Example Test failed \r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran NAND FTL File System Example Test \r\n");
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Formats an FTL volume on the simulated flash, cuts the power POWER_CYCLES
+* times while writing it and checks the volume after each power loss, then
+* runs FatFs on it.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int FfsNandFtlExample(void)
+{
+	u32 Cycle;
+#ifdef FILE_SYSTEM_USE_MKFS
+	static FATFS FatFs;
+	static FIL Fil;
+	BYTE WorkBuf[FF_MAX_SS];
+	UINT Done;
+	FRESULT Res;
+#endif
+
+	SimInit();
+	if (disk_ftl_format(&Volume, &SimDevice, Work, WORK_WORDS) != FTL_OK) {
+		xil_printf("Format failed\r\n");
+		return XST_FAILURE;
+	}
+	NumSectors = disk_ftl_sector_count(&Volume);
+
+	for (Cycle = 0U; Cycle < POWER_CYCLES; Cycle++) {
+		SimOpsLeft = 1U + (Rand() % 20000U);
+		RunWorkload();
+		if (Errors != 0U) {
+			return XST_FAILURE;
+		}
+		AddStats();
+
+		/* Power on */
+		SimPowerLost = 0U;
+		SimOpsLeft = 0U;
+		if (CheckVolume() != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	AddStats();
+	xil_printf("Pages written %d, copied %d, checkpoint %d, "
+		"write amplification %d.%02d\r\n",
+		(int)Total.HostPages, (int)Total.GcPages, (int)Total.CkptPages,
+		(int)((Total.HostPages + Total.GcPages + Total.CkptPages) /
+			Total.HostPages),
+		(int)((((Total.HostPages + Total.GcPages + Total.CkptPages) *
+			100U) / Total.HostPages) % 100U));
+	xil_printf("Erase count %d to %d, bad blocks %d, blocks moved %d, "
+		"pages scrubbed %d, replayed %d\r\n",
+		(int)Total.MinErase, (int)Total.MaxErase, (int)Total.BadBlocks,
+		(int)Total.StaticMoves, (int)Total.Scrubs, (int)Total.ReplayPages);
+	if (SimViolations != 0U) {
+		xil_printf("%d flash protocol violations\r\n", (int)SimViolations);
+		return XST_FAILURE;
+	}
+
+#ifdef FILE_SYSTEM_USE_MKFS
+	disk_nand_set_device(0U, &SimDevice);
+	Res = f_mkfs("0:/", FM_FAT | FM_SFD, 0U, WorkBuf, sizeof(WorkBuf));
+	if (Res == FR_OK) {
+		Res = f_mount(&FatFs, "0:/", 1U);
+	}
+	if (Res == FR_OK) {
+		Res = f_open(&Fil, "0:/test.bin", FA_CREATE_ALWAYS | FA_WRITE);
+	}
+	for (Cycle = 0U; (Res == FR_OK) && (Cycle < 64U); Cycle++) {
+		FillSector(Buf, Cycle, 1U);
+		Res = f_write(&Fil, Buf, 512U, &Done);
+	}
+	if (Res == FR_OK) {
+		Res = f_close(&Fil);
+	}
+	if (Res == FR_OK) {
+		Res = f_open(&Fil, "0:/test.bin", FA_READ);
+	}
+	for (Cycle = 0U; (Res == FR_OK) && (Cycle < 64U); Cycle++) {
+		Res = f_read(&Fil, Buf, 512U, &Done);
+		if ((Res == FR_OK) && (SectorGen(Buf, Cycle) != 1U)) {
+			Res = FR_INT_ERR;
+		}
+	}
+	if (Res == FR_OK) {
+		Res = f_close(&Fil);
+	}
+	(void)f_mount(NULL, "0:/", 0U);
+	disk_nand_set_device(0U, NULL);
+	if (Res != FR_OK) {
+		xil_printf("File system test failed %d\r\n", (int)Res);
+		return XST_FAILURE;
+	}
+#endif
+
+	return XST_SUCCESS;
+}
@@ -0,0 +1,242 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xilffs_stream_example.c
+*
+*
+* @note This example measures the read throughput of the file system for
+* sequential and random-seek workloads, once with the normal cluster chain
+* walk and once with a file opened by f_openstream(), which builds the cluster
+* link map and reads whole fragments directly into the user buffer.
+*
+* To test this example File System should not be in Read Only mode.
+* To test this example USE_MKFS and USE_FASTSEEK options should be true.
+* The example runs on any interface; with fs_interface set to RAM it measures
+* the file system overhead alone. The RAM FS size must be larger than
+* FILE_SIZE.
+*
+* Time is measured with XTime_GetTime(), so this example is for ARM
+* processors.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 4.4   mn  10/18/20 First release
+*
+*</pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"	/* SDK generated parameters */
+#include "xil_printf.h"
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xtime_l.h"
+#include "ff.h"
+
+/************************** Constant Definitions *****************************/
+#define FILE_SIZE	(2U * 1024U * 1024U)
+#define SEQ_CHUNK	(64U * 1024U)
+#define RAND_CHUNK	(4U * 1024U)
+#define RAND_READS	256U
+#define CLMT_ITEMS	64U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+int FfsStreamExample(void);
+static int FfsReadBench(const char *Name, u8 Stream, u8 Random);
+
+/************************** Variable Definitions *****************************/
+static FIL fil;		/* File object */
+static FATFS fatfs;
+static char FileName[32] = "Stream.bin";
+static DWORD Clmt[CLMT_ITEMS];	/* Cluster link map table */
+
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+u8 Buffer[SEQ_CHUNK];
+#else
+u8 Buffer[SEQ_CHUNK] __attribute__ ((aligned(32)));
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the streaming example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+
+	xil_printf("File System Streaming Example Test \r\n");
+
+	Status = FfsStreamExample();
+	if (Status != XST_SUCCESS) {
+		xil_printf("File System Streaming Example Test failed \r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran File System Streaming Example Test \r\n");
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Formats the drive, writes a test file and runs the read benchmarks.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int FfsStreamExample(void)
+{
+	FRESULT Res;
+	UINT NumBytesWritten;
+	u32 Offset, BuffCnt;
+	BYTE work[FF_MAX_SS];
+	TCHAR *Path = "0:/";
+
+	Res = f_mount(&fatfs, Path, 0);
+	if (Res != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	Res = f_mkfs(Path, FM_ANY, 0, work, sizeof work);
+	if (Res != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	Res = f_open(&fil, FileName, FA_CREATE_ALWAYS | FA_WRITE);
+	if (Res) {
+		return XST_FAILURE;
+	}
+
+	for (Offset = 0U; Offset < FILE_SIZE; Offset += SEQ_CHUNK) {
+		for (BuffCnt = 0U; BuffCnt < SEQ_CHUNK; BuffCnt++) {
+			Buffer[BuffCnt] = (u8)(Offset + BuffCnt);
+		}
+		Res = f_write(&fil, Buffer, SEQ_CHUNK, &NumBytesWritten);
+		if ((Res != FR_OK) || (NumBytesWritten != SEQ_CHUNK)) {
+			return XST_FAILURE;
+		}
+	}
+
+	Res = f_close(&fil);
+	if (Res) {
+		return XST_FAILURE;
+	}
+
+	if ((FfsReadBench("sequential", 0U, 0U) != XST_SUCCESS) ||
+		(FfsReadBench("sequential, stream", 1U, 0U) != XST_SUCCESS) ||
+		(FfsReadBench("random seek", 0U, 1U) != XST_SUCCESS) ||
+		(FfsReadBench("random seek, stream", 1U, 1U) != XST_SUCCESS)) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads the test file and prints the throughput.
+*
+* @param	Name is the name of the workload.
+* @param	Stream selects f_openstream() instead of f_open().
+* @param	Random selects reads at pseudo random offsets instead of a
+*		sequential read of the whole file.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int FfsReadBench(const char *Name, u8 Stream, u8 Random)
+{
+	FRESULT Res;
+	UINT NumBytesRead;
+	XTime Start, End;
+	u64 Bytes = 0U;
+	u64 Usec;
+	u32 Seed = 1U;
+	u32 Cnt, Offset;
+
+	XTime_GetTime(&Start);
+
+	if (Stream != 0U) {
+		Res = f_openstream(&fil, FileName, Clmt, CLMT_ITEMS);
+	} else {
+		Res = f_open(&fil, FileName, FA_READ);
+	}
+	if (Res != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	if (Random == 0U) {
+		do {
+			Res = f_read(&fil, Buffer, SEQ_CHUNK, &NumBytesRead);
+			if (Res != FR_OK) {
+				return XST_FAILURE;
+			}
+			/* Check the pattern at the start of each chunk */
+			if ((NumBytesRead != 0U) && (Buffer[1] != (u8)(Bytes + 1U))) {
+				return XST_FAILURE;
+			}
+			Bytes += NumBytesRead;
+		} while (NumBytesRead == SEQ_CHUNK);
+	} else {
+		for (Cnt = 0U; Cnt < RAND_READS; Cnt++) {
+			Seed = (Seed * 1103515245U) + 12345U;
+			Offset = (Seed % (FILE_SIZE / RAND_CHUNK)) * RAND_CHUNK;
+			Res = f_lseek(&fil, Offset);
+			if (Res != FR_OK) {
+				return XST_FAILURE;
+			}
+			Res = f_read(&fil, Buffer, RAND_CHUNK, &NumBytesRead);
+			if ((Res != FR_OK) || (Buffer[1] != (u8)(Offset + 1U))) {
+				return XST_FAILURE;
+			}
+			Bytes += NumBytesRead;
+		}
+	}
+
+	Res = f_close(&fil);
+	if (Res != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	XTime_GetTime(&End);
+
+	Usec = ((End - Start) * 1000000U) / COUNTS_PER_SECOND;
+	if (Usec == 0U) {
+		Usec = 1U;
+	}
+	xil_printf("%s: %d KB in %d us, %d KB/s\r\n", Name, (u32)(Bytes / 1024U),
+			(u32)Usec, (u32)((Bytes * 1000000U) / 1024U / Usec));
+
+	return XST_SUCCESS;
+}
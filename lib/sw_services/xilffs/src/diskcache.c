@@ -0,0 +1,721 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file diskcache.c
+*		This file implements a set associative sector cache between
+*		the file system and the disk backend (SD or RAM).
+*		Select "enable_block_cache" in the library settings to use it.
+*
+*		Description:
+*		The cache holds FILE_SYSTEM_CACHE_SECTORS sectors of the
+*		drives, organized in sets of FILE_SYSTEM_CACHE_WAYS ways with
+*		LRU replacement.
+*		Reads which continue the previous read of the drive fetch up
+*		to FILE_SYSTEM_CACHE_XFER_SECTORS sectors in one transfer, so
+*		that sequential small reads hit the cache.
+*		Writes are held in the cache until the file system syncs or
+*		the sector is evicted. Dirty sectors are then written back
+*		together with their dirty neighbours in one multi-block
+*		transfer.
+*		The file system pins the FAT area after mounting a volume.
+*		Pinned sectors are evicted only after all unpinned sectors of
+*		the set, so FAT walks do not go to the disk again.
+*		Requests of FILE_SYSTEM_CACHE_XFER_SECTORS or more sectors,
+*		as issued by f_read/f_write for whole clusters, bypass the
+*		cache and keep the cached copies coherent.
+*		In the thread-safe configuration (enable_reentrant) the sets
+*		are split between the drives, and each drive has its own
+*		staging buffers and sync object. A transfer on one drive
+*		does not hold up the cache of the other drive.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.4   mn   10/18/20 First release
+*       mn   10/18/20 Bound read ahead by the drive size, write back dirty
+*                     sectors on init and pin the cached FAT sectors
+*       mn   10/18/20 Split the cache between the drives in the thread-safe
+*                     configuration, with one sync object per drive
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#include <string.h>
+#include "diskcache.h"
+#include "ff.h"
+#include "xil_types.h"
+
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+
+#define CACHE_DRIVES	2U
+#define CACHE_SETS	(FILE_SYSTEM_CACHE_SECTORS / FILE_SYSTEM_CACHE_WAYS)
+
+#define LINE_VALID	0x01U
+#define LINE_DIRTY	0x02U
+#define LINE_PINNED	0x04U
+
+#if (CACHE_SETS * FILE_SYSTEM_CACHE_WAYS) != FILE_SYSTEM_CACHE_SECTORS
+#error "FILE_SYSTEM_CACHE_WAYS must divide FILE_SYSTEM_CACHE_SECTORS"
+#endif
+
+/* Each drive has its own part of the cache in the thread-safe configuration */
+#if FF_FS_REENTRANT
+#define CACHE_PARTS	CACHE_DRIVES
+#else
+#define CACHE_PARTS	1U
+#endif
+#define PART_SETS	(CACHE_SETS / CACHE_PARTS)
+#define PART_LINES	(PART_SETS * FILE_SYSTEM_CACHE_WAYS)
+#define PART(pdrv)	((CACHE_PARTS > 1U) ? (UINT)(pdrv) : 0U)
+/* First line of the part of a drive and of the set of a sector */
+#define PART_BASE(pdrv)	(PART(pdrv) * PART_LINES)
+#define SET_BASE(pdrv, sector)	(PART_BASE(pdrv) + \
+		((UINT)(((sector) + (pdrv)) % PART_SETS) * FILE_SYSTEM_CACHE_WAYS))
+
+#if PART_SETS == 0
+#error "FILE_SYSTEM_CACHE_SECTORS is too small for one set per drive"
+#endif
+
+typedef struct {
+	DWORD Sector;	/* Cached sector */
+	DWORD Stamp;	/* Last access, for LRU replacement */
+	BYTE Drive;	/* Physical drive of the sector */
+	BYTE Flags;	/* LINE_* */
+} CACHE_LINE;
+
+static CACHE_LINE Lines[FILE_SYSTEM_CACHE_SECTORS];
+static BYTE LineData[FILE_SYSTEM_CACHE_SECTORS][FF_MAX_SS]
+	__attribute__ ((aligned(64)));
+/* Staging buffers for multi-sector fills and write backs */
+static BYTE FillBuf[CACHE_PARTS][FILE_SYSTEM_CACHE_XFER_SECTORS * FF_MAX_SS]
+	__attribute__ ((aligned(64)));
+static BYTE WbBuf[CACHE_PARTS][FILE_SYSTEM_CACHE_XFER_SECTORS * FF_MAX_SS]
+	__attribute__ ((aligned(64)));
+
+static DWORD Clock[CACHE_PARTS];
+static DWORD NextRead[CACHE_DRIVES];	/* Sector following the last read */
+static DWORD NumSectors[CACHE_DRIVES];	/* Size of the drive, 0 if unknown */
+static DWORD PinStart[CACHE_DRIVES];
+static DWORD PinCount[CACHE_DRIVES];
+static DISK_CACHE_STATS Stats[CACHE_PARTS];
+#if FF_FS_REENTRANT
+static FF_SYNC_t CacheSobj[CACHE_PARTS];	/* Serializes the part of a drive */
+static BYTE CacheSobjValid;
+#endif
+
+/* Lock the part of a drive, evaluates to 0 on timeout */
+#if FF_FS_REENTRANT
+#define CACHE_LOCK(pdrv)	((CacheSobjValid == 0U) || \
+		(ff_req_grant(CacheSobj[PART(pdrv)]) != 0))
+#define CACHE_UNLOCK(pdrv)	do { if (CacheSobjValid != 0U) { \
+		ff_rel_grant(CacheSobj[PART(pdrv)]); } } while (0)
+#else
+#define CACHE_LOCK(pdrv)	(1)
+#define CACHE_UNLOCK(pdrv)	do { } while (0)
+#endif
+
+static DRESULT cache_sync (BYTE pdrv);
+
+/*****************************************************************************/
+/**
+*
+* Looks up a sector in the cache.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number
+*
+* @return	Index of the cache line, -1 if the sector is not cached.
+*
+******************************************************************************/
+static INT cache_lookup (BYTE pdrv, DWORD sector)
+{
+	UINT Base = SET_BASE(pdrv, sector);
+	UINT Way;
+
+	for (Way = 0U; Way < FILE_SYSTEM_CACHE_WAYS; Way++) {
+		const CACHE_LINE *Line = &Lines[Base + Way];
+
+		if (((Line->Flags & LINE_VALID) != 0U) &&
+				(Line->Sector == sector) && (Line->Drive == pdrv)) {
+			return (INT)(Base + Way);
+		}
+	}
+
+	return -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes back a dirty cache line together with the dirty lines of the
+* neighbouring sectors in one transfer.
+*
+* @param	Idx - Index of a dirty cache line
+*
+* @return	RES_OK on success, error code of the backend on failure.
+*
+******************************************************************************/
+static DRESULT cache_write_back (INT Idx)
+{
+	BYTE pdrv = Lines[Idx].Drive;
+	DWORD Start = Lines[Idx].Sector;
+	UINT Count = 0U;
+	INT Run[FILE_SYSTEM_CACHE_XFER_SECTORS];
+	INT Prev;
+	DRESULT res;
+
+	/* Extend the run backwards over dirty sectors */
+	while ((Start > 0U) &&
+			((Lines[Idx].Sector - Start) < (FILE_SYSTEM_CACHE_XFER_SECTORS - 1U))) {
+		Prev = cache_lookup(pdrv, Start - 1U);
+		if ((Prev < 0) || ((Lines[Prev].Flags & LINE_DIRTY) == 0U)) {
+			break;
+		}
+		Start--;
+	}
+
+	/* Gather the run forward */
+	while (Count < FILE_SYSTEM_CACHE_XFER_SECTORS) {
+		INT Cur = cache_lookup(pdrv, Start + Count);
+
+		if ((Cur < 0) || ((Lines[Cur].Flags & LINE_DIRTY) == 0U)) {
+			break;
+		}
+		(void)memcpy(&WbBuf[PART(pdrv)][Count * FF_MAX_SS], LineData[Cur],
+				FF_MAX_SS);
+		Run[Count] = Cur;
+		Count++;
+	}
+
+	res = disk_write_dev(pdrv, WbBuf[PART(pdrv)], Start, Count);
+	if (res != RES_OK) {
+		return res;
+	}
+
+	while (Count > 0U) {
+		Count--;
+		Lines[Run[Count]].Flags &= (BYTE)~LINE_DIRTY;
+		Stats[PART(pdrv)].WrittenSectors++;
+	}
+	Stats[PART(pdrv)].WriteBacks++;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Allocates a cache line for a sector which is not cached. An invalid way of
+* the set is used if there is one, otherwise the least recently used way,
+* preferring unpinned ways. A dirty victim is written back first.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number
+*
+* @return	Index of the cache line, -1 if the victim could not be written
+*		back.
+*
+******************************************************************************/
+static INT cache_alloc (BYTE pdrv, DWORD sector)
+{
+	UINT Base = SET_BASE(pdrv, sector);
+	UINT Way, NumPinned = 0U;
+	INT Victim = -1;
+	INT PinnedVictim = -1;
+	INT Invalid = -1;
+	CACHE_LINE *Line;
+
+	for (Way = 0U; Way < FILE_SYSTEM_CACHE_WAYS; Way++) {
+		INT Idx = (INT)(Base + Way);
+
+		Line = &Lines[Idx];
+		if ((Line->Flags & LINE_VALID) == 0U) {
+			if (Invalid < 0) {
+				Invalid = Idx;
+			}
+		} else if ((Line->Flags & LINE_PINNED) != 0U) {
+			NumPinned++;
+			if ((PinnedVictim < 0) ||
+					(Line->Stamp < Lines[PinnedVictim].Stamp)) {
+				PinnedVictim = Idx;
+			}
+		} else if ((Victim < 0) || (Line->Stamp < Lines[Victim].Stamp)) {
+			Victim = Idx;
+		}
+	}
+
+	if (Invalid >= 0) {
+		Victim = Invalid;
+	} else if (Victim < 0) {
+		Victim = PinnedVictim;
+	}
+
+	Line = &Lines[Victim];
+	if ((Line->Flags & (LINE_VALID | LINE_DIRTY)) == (LINE_VALID | LINE_DIRTY)) {
+		if (cache_write_back(Victim) != RES_OK) {
+			return -1;
+		}
+	}
+	if ((Line->Flags & LINE_PINNED) != 0U) {
+		NumPinned--;
+	}
+
+	Line->Sector = sector;
+	Line->Drive = pdrv;
+	Line->Flags = LINE_VALID;
+	/* Keep at least one unpinned way per set */
+	if (((sector - PinStart[pdrv]) < PinCount[pdrv]) &&
+			(NumPinned < (FILE_SYSTEM_CACHE_WAYS - 1U))) {
+		Line->Flags |= LINE_PINNED;
+	}
+
+	return Victim;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes back and invalidates the cached sectors of a drive and reads the
+* drive size. Called when the drive is initialized.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK on success, RES_NOTRDY if the cache could not be locked,
+*		error code of the backend if dirty sectors could not be written
+*		back. The cached sectors are kept on failure.
+*
+******************************************************************************/
+DRESULT disk_cache_init (BYTE pdrv)
+{
+	UINT Idx;
+	DRESULT res;
+
+	if (pdrv >= CACHE_DRIVES) {
+		return RES_OK;
+	}
+
+	if (!CACHE_LOCK(pdrv)) {
+		return RES_NOTRDY;
+	}
+	res = cache_sync(pdrv);
+	if (res != RES_OK) {
+		CACHE_UNLOCK(pdrv);
+		return res;
+	}
+	for (Idx = PART_BASE(pdrv); Idx < (PART_BASE(pdrv) + PART_LINES); Idx++) {
+		if (Lines[Idx].Drive == pdrv) {
+			Lines[Idx].Flags = 0U;
+		}
+	}
+
+	NextRead[pdrv] = 0xFFFFFFFFU;
+	PinStart[pdrv] = 0U;
+	PinCount[pdrv] = 0U;
+	if (disk_ioctl(pdrv, (BYTE)GET_SECTOR_COUNT, &NumSectors[pdrv]) != RES_OK) {
+		NumSectors[pdrv] = 0U;
+	}
+	CACHE_UNLOCK(pdrv);
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors through the cache. Called with the part of the drive locked.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK on success, error code of the backend on failure.
+*
+******************************************************************************/
+static DRESULT cache_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
+{
+	BYTE *Fill = FillBuf[PART(pdrv)];
+	DISK_CACHE_STATS *St = &Stats[PART(pdrv)];
+	UINT Done = 0U;
+	UINT Num, Req, Fetch;
+	INT Idx;
+	DRESULT res;
+
+	if (count >= FILE_SYSTEM_CACHE_XFER_SECTORS) {
+		res = disk_read_dev(pdrv, buff, sector, count);
+		if (res != RES_OK) {
+			return res;
+		}
+
+		/* Dirty sectors in the cache are newer than the disk */
+		for (Num = 0U; Num < count; Num++) {
+			Idx = cache_lookup(pdrv, sector + Num);
+			if ((Idx >= 0) && ((Lines[Idx].Flags & LINE_DIRTY) != 0U)) {
+				(void)memcpy(&buff[Num * FF_MAX_SS], LineData[Idx],
+						FF_MAX_SS);
+			}
+		}
+		St->Bypassed += count;
+		NextRead[pdrv] = sector + count;
+		return RES_OK;
+	}
+
+	while (Done < count) {
+		Idx = cache_lookup(pdrv, sector + Done);
+		if (Idx >= 0) {
+			(void)memcpy(&buff[Done * FF_MAX_SS], LineData[Idx], FF_MAX_SS);
+			Lines[Idx].Stamp = ++Clock[PART(pdrv)];
+			St->ReadHits++;
+			Done++;
+			continue;
+		}
+
+		/* Miss: fetch the rest of the request, and ahead if sequential */
+		Req = count - Done;
+		Fetch = Req;
+		if ((sector == NextRead[pdrv]) &&
+				((sector + Done) < NumSectors[pdrv])) {
+			/* Not beyond the end of the drive or FillBuf */
+			Fetch = FILE_SYSTEM_CACHE_XFER_SECTORS;
+			if ((NumSectors[pdrv] - (sector + Done)) < Fetch) {
+				Fetch = (UINT)(NumSectors[pdrv] - (sector + Done));
+			}
+			if (Fetch < Req) {
+				Fetch = Req;
+			}
+		}
+
+		res = disk_read_dev(pdrv, Fill, sector + Done, Fetch);
+		if (res != RES_OK) {
+			return res;
+		}
+
+		for (Num = 0U; Num < Fetch; Num++) {
+			const BYTE *Src = &Fill[Num * FF_MAX_SS];
+
+			Idx = cache_lookup(pdrv, sector + Done + Num);
+			if (Idx >= 0) {
+				/* Cached copy may be dirty, it wins */
+				Src = LineData[Idx];
+			} else {
+				Idx = cache_alloc(pdrv, sector + Done + Num);
+				if (Idx < 0) {
+					return RES_ERROR;
+				}
+				(void)memcpy(LineData[Idx], Src, FF_MAX_SS);
+			}
+			Lines[Idx].Stamp = ++Clock[PART(pdrv)];
+
+			if (Num < Req) {
+				(void)memcpy(&buff[(Done + Num) * FF_MAX_SS], Src, FF_MAX_SS);
+			}
+		}
+
+		St->ReadMisses += Req;
+		St->ReadAhead += Fetch - Req;
+		Done += Req;
+	}
+
+	NextRead[pdrv] = sector + count;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors through the cache. Small writes are held in the cache until
+* disk_cache_sync() or eviction. Called with the part of the drive locked.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK on success, error code of the backend on failure.
+*
+******************************************************************************/
+static DRESULT cache_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
+{
+	UINT Num;
+	INT Idx;
+	DRESULT res;
+
+	if (count >= FILE_SYSTEM_CACHE_XFER_SECTORS) {
+		res = disk_write_dev(pdrv, buff, sector, count);
+		if (res != RES_OK) {
+			return res;
+		}
+
+		/* Refresh cached copies, they are clean now */
+		for (Num = 0U; Num < count; Num++) {
+			Idx = cache_lookup(pdrv, sector + Num);
+			if (Idx >= 0) {
+				(void)memcpy(LineData[Idx], &buff[Num * FF_MAX_SS],
+						FF_MAX_SS);
+				Lines[Idx].Flags &= (BYTE)~LINE_DIRTY;
+			}
+		}
+		Stats[PART(pdrv)].Bypassed += count;
+		return RES_OK;
+	}
+
+	for (Num = 0U; Num < count; Num++) {
+		Idx = cache_lookup(pdrv, sector + Num);
+		if (Idx < 0) {
+			Idx = cache_alloc(pdrv, sector + Num);
+			if (Idx < 0) {
+				return RES_ERROR;
+			}
+		}
+
+		(void)memcpy(LineData[Idx], &buff[Num * FF_MAX_SS], FF_MAX_SS);
+		Lines[Idx].Flags |= LINE_DIRTY;
+		Lines[Idx].Stamp = ++Clock[PART(pdrv)];
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes back all dirty sectors of a drive. Called with the part of the drive
+* locked.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK on success, error code of the backend on failure.
+*
+******************************************************************************/
+static DRESULT cache_sync (BYTE pdrv)
+{
+	UINT Idx;
+	DRESULT res;
+
+	for (Idx = PART_BASE(pdrv); Idx < (PART_BASE(pdrv) + PART_LINES); Idx++) {
+		if ((Lines[Idx].Drive == pdrv) &&
+				((Lines[Idx].Flags & (LINE_VALID | LINE_DIRTY)) ==
+				 (LINE_VALID | LINE_DIRTY))) {
+			res = cache_write_back((INT)Idx);
+			if (res != RES_OK) {
+				return res;
+			}
+		}
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors through the cache. See cache_read().
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK on success, RES_NOTRDY if the cache could not be locked,
+*		error code of the backend on failure.
+*
+******************************************************************************/
+DRESULT disk_cache_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
+{
+	DRESULT res;
+
+	if (pdrv >= CACHE_DRIVES) {
+		return disk_read_dev(pdrv, buff, sector, count);
+	}
+
+	if (!CACHE_LOCK(pdrv)) {
+		return RES_NOTRDY;
+	}
+	res = cache_read(pdrv, buff, sector, count);
+	CACHE_UNLOCK(pdrv);
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors through the cache. See cache_write().
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK on success, RES_NOTRDY if the cache could not be locked,
+*		error code of the backend on failure.
+*
+******************************************************************************/
+DRESULT disk_cache_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
+{
+	DRESULT res;
+
+	if (pdrv >= CACHE_DRIVES) {
+		return disk_write_dev(pdrv, buff, sector, count);
+	}
+
+	if (!CACHE_LOCK(pdrv)) {
+		return RES_NOTRDY;
+	}
+	res = cache_write(pdrv, buff, sector, count);
+	CACHE_UNLOCK(pdrv);
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes back all dirty sectors of a drive. See cache_sync().
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK on success, RES_NOTRDY if the cache could not be locked,
+*		error code of the backend on failure.
+*
+******************************************************************************/
+DRESULT disk_cache_sync (BYTE pdrv)
+{
+	DRESULT res;
+
+	if (pdrv >= CACHE_DRIVES) {
+		return RES_OK;
+	}
+
+	if (!CACHE_LOCK(pdrv)) {
+		return RES_NOTRDY;
+	}
+	res = cache_sync(pdrv);
+	CACHE_UNLOCK(pdrv);
+
+	return res;
+}
+
+#if FF_FS_REENTRANT
+/*****************************************************************************/
+/**
+*
+* Creates the sync objects of the drives. Called once through ff_init_once()
+* by the first f_mount().
+*
+* @param	None
+*
+* @return	1 on success, 0 if a sync object could not be created.
+*
+******************************************************************************/
+int disk_cache_cre_lock (void)
+{
+	UINT Part;
+
+	for (Part = 0U; Part < CACHE_PARTS; Part++) {
+		if (ff_cre_syncobj(FF_VOLUMES, &CacheSobj[Part]) == 0) {
+			while (Part > 0U) {
+				Part--;
+				(void)ff_del_syncobj(CacheSobj[Part]);
+			}
+			return 0;
+		}
+	}
+	CacheSobjValid = 1U;
+
+	return 1;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Pins a range of sectors of a drive, typically the FAT, in the cache.
+* Sectors of the range which are already cached, e.g. read while mounting
+* the volume, are pinned too. The previous range of the drive is unpinned.
+*
+* @param	pdrv - Drive number
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	None
+*
+******************************************************************************/
+void disk_cache_pin (BYTE pdrv, DWORD sector, DWORD count)
+{
+	UINT Base, Way, NumPinned;
+	CACHE_LINE *Line;
+
+	if (pdrv >= CACHE_DRIVES) {
+		return;
+	}
+
+	if (!CACHE_LOCK(pdrv)) {
+		return;
+	}
+	PinStart[pdrv] = sector;
+	PinCount[pdrv] = count;
+
+	for (Base = PART_BASE(pdrv); Base < (PART_BASE(pdrv) + PART_LINES);
+			Base += FILE_SYSTEM_CACHE_WAYS) {
+		NumPinned = 0U;
+		for (Way = 0U; Way < FILE_SYSTEM_CACHE_WAYS; Way++) {
+			Line = &Lines[Base + Way];
+			if (Line->Drive == pdrv) {
+				Line->Flags &= (BYTE)~LINE_PINNED;
+			} else if ((Line->Flags & LINE_PINNED) != 0U) {
+				NumPinned++;
+			}
+		}
+
+		/* Keep at least one unpinned way per set */
+		for (Way = 0U; Way < FILE_SYSTEM_CACHE_WAYS; Way++) {
+			Line = &Lines[Base + Way];
+			if ((NumPinned < (FILE_SYSTEM_CACHE_WAYS - 1U)) &&
+					((Line->Flags & LINE_VALID) != 0U) &&
+					(Line->Drive == pdrv) &&
+					((Line->Sector - sector) < count)) {
+				Line->Flags |= LINE_PINNED;
+				NumPinned++;
+			}
+		}
+	}
+	CACHE_UNLOCK(pdrv);
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the cache statistics, summed over the drives.
+*
+* @param	stats - Pointer to store the statistics
+*
+* @return	None
+*
+******************************************************************************/
+void disk_cache_stats (DISK_CACHE_STATS* stats)
+{
+	UINT Part;
+
+	(void)memset(stats, 0, sizeof(*stats));
+	for (Part = 0U; Part < CACHE_PARTS; Part++) {
+		stats->ReadHits += Stats[Part].ReadHits;
+		stats->ReadMisses += Stats[Part].ReadMisses;
+		stats->ReadAhead += Stats[Part].ReadAhead;
+		stats->WriteBacks += Stats[Part].WriteBacks;
+		stats->WrittenSectors += Stats[Part].WrittenSectors;
+		stats->Bypassed += Stats[Part].Bypassed;
+	}
+}
+
+#endif	/* FILE_SYSTEM_BLOCK_CACHE */
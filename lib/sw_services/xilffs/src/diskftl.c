@@ -0,0 +1,1662 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file diskftl.c
+*		This file implements a log structured flash translation layer
+*		which lets the file system use raw NAND flash.
+*		Set "fs_interface" to 3 in the library settings to use it.
+*
+*		Description:
+*		The volume exports 512 byte sectors grouped in logical pages
+*		of the size of a NAND page. A logical page is never
+*		programmed in place, it is written to the next free page of
+*		the open block and the page holding its previous content
+*		becomes garbage. The spare area of every page holds a tag
+*		with the logical page, a sequence number incremented at
+*		every program and the erase count of the block, stored
+*		twice with a CRC as the spare area is not ECC protected.
+*		Partial page writes are merged in a write buffer of
+*		FILE_SYSTEM_NAND_FTL_WBUF_PAGES pages, which is written
+*		back when an entry is evicted or the file system syncs.
+*
+*		Garbage collection reclaims the block with the fewest valid
+*		pages when the number of free blocks drops to the reserve
+*		kept for checkpoints. Valid pages are copied to a second
+*		open block, so that data rewritten by the file system and
+*		data moved by the collection are not mixed.
+*		Blocks are erased when they are allocated. New data goes to
+*		the free block with the lowest erase count and moved data to
+*		the one with the highest (dynamic wear leveling). When the
+*		spread of the erase counts exceeds
+*		FILE_SYSTEM_NAND_FTL_WL_THRESHOLD, the data of the least worn
+*		block is moved so that the block is reused (static wear
+*		leveling).
+*
+*		The device bad block table is read when mounting. A block
+*		which fails to erase is marked bad. A block which fails to
+*		program is retired, its valid pages are moved before it is
+*		marked bad. Pages read with at least scrub_bits corrected
+*		bits are rewritten.
+*
+*		The mapping table and the erase counts are saved in a
+*		checkpoint written to free blocks when the file system syncs
+*		after FILE_SYSTEM_NAND_FTL_CKPT_INTERVAL blocks were opened.
+*		Mounting loads the newest complete checkpoint and replays
+*		the tags of the blocks written after it, so that everything
+*		programmed before a power loss is found again. The previous
+*		checkpoint is kept until the new one is complete, and a
+*		block which was being written when the power was lost is not
+*		written again.
+*
+*		The FTL is not thread-safe, the volume must be used by one
+*		thread at a time.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.4   mn   10/18/20 First release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#include <string.h>
+#include "diskftl.h"
+
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+
+#define FTL_LOST	0xFFFFFFFEU	/* Map entry of a page lost to a read error */
+
+#define TAG_DATA	0x5AD7U		/* Tag of a logical page */
+#define TAG_CKPT	0xC35AU		/* Tag of a checkpoint page */
+#define TAG_COPY	16U		/* Bytes of one copy of the tag */
+
+/* Results of tag_decode() */
+#define TAG_ERASED	0
+#define TAG_VALID	1
+#define TAG_INVALID	2
+
+/* Block states */
+#define BLK_FREE	0U	/* No valid data, erased before use */
+#define BLK_OPEN	1U	/* Being written */
+#define BLK_FULL	2U	/* Holds data */
+#define BLK_CKPT	3U	/* Holds the checkpoint */
+#define BLK_RETIRE	4U	/* Failed to program, data to move */
+#define BLK_BAD		5U
+
+#define STREAM_HOST	0U
+#define STREAM_GC	1U
+
+#define CKPT_MAGIC	0x4B435446U	/* "FTCK" */
+#define CKPT_VERSION	1U
+#define CKPT_HDR_WORDS	16U
+
+#define PROGRAM_TRIES	4U
+
+typedef struct {
+	u32 Seq;	/* Sequence number of the program */
+	u32 Lpn;	/* Logical page, or index of the checkpoint page */
+	u32 Ec;		/* Erase count of the block */
+	u16 Type;	/* TAG_DATA or TAG_CKPT */
+} FTL_TAG;
+
+static INT ftl_collect (FTL_VOLUME* vol, u32 blk);
+static INT ftl_write_page (FTL_VOLUME* vol, u32 stream, u32 lpn, const BYTE* data);
+
+static u32 get32 (const BYTE* p)
+{
+	return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) |
+		((u32)p[3] << 24);
+}
+
+static void put32 (BYTE* p, u32 v)
+{
+	p[0] = (BYTE)v;
+	p[1] = (BYTE)(v >> 8);
+	p[2] = (BYTE)(v >> 16);
+	p[3] = (BYTE)(v >> 24);
+}
+
+/* CRC-16/CCITT of the tags */
+static u16 crc16 (const BYTE* p, UINT len)
+{
+	u16 Crc = 0xFFFFU;
+	UINT Bit;
+
+	while (len-- > 0U) {
+		Crc ^= (u16)((u16)*p++ << 8);
+		for (Bit = 0U; Bit < 8U; Bit++) {
+			Crc = ((Crc & 0x8000U) != 0U) ?
+				(u16)((u16)(Crc << 1) ^ 0x1021U) : (u16)(Crc << 1);
+		}
+	}
+
+	return Crc;
+}
+
+/* CRC-32 of the checkpoint pages, four bits at a time */
+static u32 crc32 (const BYTE* p, UINT len)
+{
+	static const u32 Nibble[16] = {
+		0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+		0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+		0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+		0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+	};
+	u32 Crc = 0xFFFFFFFFU;
+
+	while (len-- > 0U) {
+		Crc ^= *p++;
+		Crc = (Crc >> 4) ^ Nibble[Crc & 0xFU];
+		Crc = (Crc >> 4) ^ Nibble[Crc & 0xFU];
+	}
+
+	return ~Crc;
+}
+
+/*****************************************************************************/
+/**
+*
+* Encodes a tag in the FTL_TAG_SIZE bytes of the spare area, as two copies
+* with a CRC each.
+*
+* @param	*tag - Tag to encode
+* @param	*buf - Spare bytes to fill in
+*
+* @return	None
+*
+******************************************************************************/
+static void tag_encode (const FTL_TAG* tag, BYTE* buf)
+{
+	put32(&buf[0], tag->Seq);
+	put32(&buf[4], tag->Lpn);
+	put32(&buf[8], tag->Ec);
+	buf[12] = (BYTE)tag->Type;
+	buf[13] = (BYTE)(tag->Type >> 8);
+	put32(&buf[12], ((u32)crc16(buf, 14U) << 16) | tag->Type);
+	(void)memcpy(&buf[TAG_COPY], buf, TAG_COPY);
+}
+
+/*****************************************************************************/
+/**
+*
+* Decodes the tag of a page from the first copy with a valid CRC.
+*
+* @param	*buf - Spare bytes read
+* @param	*tag - Tag to fill in
+*
+* @return	TAG_VALID, TAG_ERASED if the page was not programmed, TAG_INVALID
+*		if no copy is valid.
+*
+******************************************************************************/
+static INT tag_decode (const BYTE* buf, FTL_TAG* tag)
+{
+	UINT Copy, Idx;
+
+	for (Copy = 0U; Copy < 2U; Copy++) {
+		const BYTE* p = &buf[Copy * TAG_COPY];
+
+		if (crc16(p, 14U) == (u16)(get32(&p[12]) >> 16)) {
+			tag->Seq = get32(&p[0]);
+			tag->Lpn = get32(&p[4]);
+			tag->Ec = get32(&p[8]);
+			tag->Type = (u16)get32(&p[12]);
+			if ((tag->Type == TAG_DATA) || (tag->Type == TAG_CKPT)) {
+				return TAG_VALID;
+			}
+		}
+	}
+
+	for (Idx = 0U; Idx < FTL_TAG_SIZE; Idx++) {
+		if (buf[Idx] != 0xFFU) {
+			return TAG_INVALID;
+		}
+	}
+
+	return TAG_ERASED;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads the tag of a page. An invalid tag is read again once, as the spare
+* area is not ECC protected.
+*
+* @param	*vol - Volume
+* @param	page - Physical page
+* @param	*tag - Tag to fill in
+*
+* @return	TAG_VALID, TAG_ERASED or TAG_INVALID.
+*
+******************************************************************************/
+static INT ftl_read_tag (FTL_VOLUME* vol, u32 page, FTL_TAG* tag)
+{
+	const FTL_DEVICE* Dev = vol->Dev;
+	BYTE Buf[FTL_TAG_SIZE];
+	INT Res = TAG_INVALID;
+	UINT Try;
+
+	for (Try = 0U; (Try < 2U) && (Res == TAG_INVALID); Try++) {
+		if (Dev->read_page(Dev->ctx, page, NULL, Buf) < 0) {
+			continue;
+		}
+		Res = tag_decode(Buf, tag);
+	}
+
+	return Res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads the data of a page and accounts for the bits corrected. A page which
+* is uncorrectable is read again once, as bit errors can be transient.
+*
+* @param	*vol - Volume
+* @param	page - Physical page
+* @param	*buf - Page buffer to fill in
+*
+* @return	Number of bits corrected, -1 if the page is uncorrectable.
+*
+******************************************************************************/
+static INT ftl_read_data (FTL_VOLUME* vol, u32 page, BYTE* buf)
+{
+	const FTL_DEVICE* Dev = vol->Dev;
+	INT Bits;
+
+	Bits = Dev->read_page(Dev->ctx, page, buf, NULL);
+	if (Bits < 0) {
+		Bits = Dev->read_page(Dev->ctx, page, buf, NULL);
+	}
+	if (Bits < 0) {
+		vol->Stats.ReadErrors++;
+	} else {
+		vol->Stats.CorrectedBits += (DWORD)Bits;
+	}
+
+	return Bits;
+}
+
+/*****************************************************************************/
+/**
+*
+* Marks a block bad in the device and stops using it.
+*
+* @param	*vol - Volume
+* @param	blk - Block
+*
+* @return	None
+*
+******************************************************************************/
+static void ftl_mark_bad (FTL_VOLUME* vol, u32 blk)
+{
+	(void)vol->Dev->mark_bad(vol->Dev->ctx, blk);
+	vol->State[blk] = BLK_BAD;
+	vol->Stats.BadBlocks++;
+}
+
+/*****************************************************************************/
+/**
+*
+* Erases a block. A block which fails to erase is marked bad.
+*
+* @param	*vol - Volume
+* @param	blk - Block
+*
+* @return	0 on success, -1 if the block was marked bad.
+*
+******************************************************************************/
+static INT ftl_erase (FTL_VOLUME* vol, u32 blk)
+{
+	if ((vol->RdPage != FTL_NONE) &&
+			((vol->RdPage / vol->PagesPerBlock) == blk)) {
+		vol->RdPage = FTL_NONE;
+	}
+
+	vol->Stats.Erases++;
+	vol->Ec[blk]++;
+	if (vol->Dev->erase_block(vol->Dev->ctx, blk) != 0) {
+		ftl_mark_bad(vol, blk);
+		return -1;
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Updates the mapping of a logical page and the valid page counts. A full
+* block left without valid pages becomes free.
+*
+* @param	*vol - Volume
+* @param	lpn - Logical page
+* @param	page - New physical page, FTL_NONE or FTL_LOST
+*
+* @return	None
+*
+******************************************************************************/
+static void ftl_map (FTL_VOLUME* vol, u32 lpn, u32 page)
+{
+	u32 Old = vol->Map[lpn];
+	u32 Blk;
+
+	if (Old < FTL_LOST) {
+		Blk = Old / vol->PagesPerBlock;
+		vol->Valid[Blk]--;
+		if ((vol->Valid[Blk] == 0U) && (vol->State[Blk] == BLK_FULL)) {
+			vol->State[Blk] = BLK_FREE;
+			vol->FreeBlocks++;
+		}
+	}
+
+	vol->Map[lpn] = page;
+	if (page < FTL_LOST) {
+		vol->Valid[page / vol->PagesPerBlock]++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Selects a free block, the least worn one for new data and checkpoints and
+* the most worn one for data moved by the garbage collection.
+*
+* @param	*vol - Volume
+* @param	most_worn - Non zero to select the most worn block
+*
+* @return	Block, FTL_NONE if there is no free block.
+*
+******************************************************************************/
+static u32 ftl_pick_free (const FTL_VOLUME* vol, UINT most_worn)
+{
+	u32 Best = FTL_NONE;
+	u32 Blk;
+
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if (vol->State[Blk] != BLK_FREE) {
+			continue;
+		}
+		if ((Best == FTL_NONE) ||
+				((most_worn != 0U) && (vol->Ec[Blk] > vol->Ec[Best])) ||
+				((most_worn == 0U) && (vol->Ec[Blk] < vol->Ec[Best]))) {
+			Best = Blk;
+		}
+	}
+
+	return Best;
+}
+
+/*****************************************************************************/
+/**
+*
+* Selects the victim of the garbage collection, the full block with the
+* fewest valid pages.
+*
+* @param	*vol - Volume
+*
+* @return	Block, FTL_NONE if no block has garbage.
+*
+******************************************************************************/
+static u32 ftl_pick_victim (const FTL_VOLUME* vol)
+{
+	u32 Best = FTL_NONE;
+	u32 Blk;
+
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if (vol->State[Blk] != BLK_FULL) {
+			continue;
+		}
+		if ((Best == FTL_NONE) || (vol->Valid[Blk] < vol->Valid[Best]) ||
+				((vol->Valid[Blk] == vol->Valid[Best]) &&
+				 (vol->Ec[Blk] < vol->Ec[Best]))) {
+			Best = Blk;
+		}
+	}
+
+	if ((Best != FTL_NONE) && (vol->Valid[Best] >= vol->PagesPerBlock)) {
+		Best = FTL_NONE;
+	}
+
+	return Best;
+}
+
+/*****************************************************************************/
+/**
+*
+* Moves the data of the least worn full block when the spread of the erase
+* counts exceeds FILE_SYSTEM_NAND_FTL_WL_THRESHOLD. The block then returns
+* to the free blocks and takes new data.
+*
+* @param	*vol - Volume
+*
+* @return	None
+*
+******************************************************************************/
+static void ftl_wear_level (FTL_VOLUME* vol)
+{
+	u32 MaxEc = 0U;
+	u32 Cold = FTL_NONE;
+	u32 Blk;
+
+	/* Moving a block takes at most one free block until it is freed */
+	if (vol->FreeBlocks < vol->MinFree) {
+		return;
+	}
+
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if (vol->State[Blk] == BLK_BAD) {
+			continue;
+		}
+		if (vol->Ec[Blk] > MaxEc) {
+			MaxEc = vol->Ec[Blk];
+		}
+		if ((vol->State[Blk] == BLK_FULL) &&
+				((Cold == FTL_NONE) || (vol->Ec[Blk] < vol->Ec[Cold]))) {
+			Cold = Blk;
+		}
+	}
+
+	if ((Cold != FTL_NONE) &&
+			((MaxEc - vol->Ec[Cold]) > FILE_SYSTEM_NAND_FTL_WL_THRESHOLD)) {
+		if (ftl_collect(vol, Cold) == 0) {
+			vol->Stats.StaticMoves++;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Closes the open block of a stream.
+*
+* @param	*vol - Volume
+* @param	stream - STREAM_HOST or STREAM_GC
+*
+* @return	None
+*
+******************************************************************************/
+static void ftl_close (FTL_VOLUME* vol, u32 stream)
+{
+	u32 Blk = vol->Front[stream].Block;
+
+	vol->Front[stream].Block = FTL_NONE;
+	if ((Blk != FTL_NONE) && (vol->State[Blk] == BLK_OPEN)) {
+		if (vol->Valid[Blk] == 0U) {
+			vol->State[Blk] = BLK_FREE;
+			vol->FreeBlocks++;
+		} else {
+			vol->State[Blk] = BLK_FULL;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Opens a new block for a stream. For new data, blocks are collected first
+* until more than the reserve of free blocks is left.
+*
+* @param	*vol - Volume
+* @param	stream - STREAM_HOST or STREAM_GC
+*
+* @return	0 on success, -1 if there is no free block.
+*
+******************************************************************************/
+static INT ftl_open (FTL_VOLUME* vol, u32 stream)
+{
+	u32 Blk;
+
+	if (stream == STREAM_HOST) {
+		while (vol->FreeBlocks <= vol->MinFree) {
+			Blk = ftl_pick_victim(vol);
+			if ((Blk == FTL_NONE) || (ftl_collect(vol, Blk) != 0)) {
+				return -1;
+			}
+		}
+	}
+
+	do {
+		Blk = ftl_pick_free(vol, stream);
+		if (Blk == FTL_NONE) {
+			return -1;
+		}
+		vol->FreeBlocks--;
+		vol->State[Blk] = BLK_OPEN;
+	} while (ftl_erase(vol, Blk) != 0);
+
+	vol->Front[stream].Block = Blk;
+	vol->Front[stream].Page = 0U;
+	vol->SinceCkpt++;
+
+	if ((stream == STREAM_HOST) && (vol->InGc == 0U)) {
+		ftl_wear_level(vol);
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Programs a logical page to the open block of a stream and maps it. When the
+* program fails, the block is closed and queued to be retired, and the page
+* is programmed to another block.
+*
+* @param	*vol - Volume
+* @param	stream - STREAM_HOST or STREAM_GC
+* @param	lpn - Logical page
+* @param	*data - Page data
+*
+* @return	0 on success, -1 on failure.
+*
+******************************************************************************/
+static INT ftl_write_page (FTL_VOLUME* vol, u32 stream, u32 lpn, const BYTE* data)
+{
+	const FTL_DEVICE* Dev = vol->Dev;
+	FTL_FRONT* Front = &vol->Front[stream];
+	BYTE TagBuf[FTL_TAG_SIZE];
+	FTL_TAG Tag;
+	u32 Try, Blk, Page;
+	INT Status;
+
+	for (Try = 0U; Try < PROGRAM_TRIES; Try++) {
+		if ((Front->Block == FTL_NONE) && (ftl_open(vol, stream) != 0)) {
+			return -1;
+		}
+		Blk = Front->Block;
+		Page = (Blk * vol->PagesPerBlock) + Front->Page;
+
+		Tag.Seq = vol->NextSeq++;
+		Tag.Lpn = lpn;
+		Tag.Ec = vol->Ec[Blk];
+		Tag.Type = TAG_DATA;
+		tag_encode(&Tag, TagBuf);
+
+		Front->Page++;
+		Status = Dev->program_page(Dev->ctx, Page, data, TagBuf);
+		if (Status == 0) {
+			ftl_map(vol, lpn, Page);
+			if (Front->Page == vol->PagesPerBlock) {
+				ftl_close(vol, stream);
+			}
+			return 0;
+		}
+
+		ftl_close(vol, stream);
+		if (vol->State[Blk] == BLK_FREE) {
+			vol->FreeBlocks--;
+			ftl_mark_bad(vol, Blk);
+		} else {
+			vol->State[Blk] = BLK_RETIRE;
+			vol->NumRetire++;
+		}
+	}
+
+	return -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* Moves a valid page to the garbage collection stream. A page which cannot
+* be read is unmapped and reads of it fail until it is written again.
+*
+* @param	*vol - Volume
+* @param	lpn - Logical page
+* @param	page - Physical page holding it
+*
+* @return	0 on success, -1 if the page could not be programmed.
+*
+******************************************************************************/
+static INT ftl_move (FTL_VOLUME* vol, u32 lpn, u32 page)
+{
+	if (ftl_read_data(vol, page, vol->GcBuf) < 0) {
+		ftl_map(vol, lpn, FTL_LOST);
+		return 0;
+	}
+	if (ftl_write_page(vol, STREAM_GC, lpn, vol->GcBuf) != 0) {
+		return -1;
+	}
+	vol->Stats.GcPages++;
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Moves the valid pages of a block to the garbage collection stream. The
+* block becomes free when its last valid page is moved. The pages are found
+* from their tags, and from the mapping table when a tag cannot be read.
+*
+* @param	*vol - Volume
+* @param	blk - Block to collect
+*
+* @return	0 on success, -1 if a page could not be moved.
+*
+******************************************************************************/
+static INT ftl_collect (FTL_VOLUME* vol, u32 blk)
+{
+	u32 First = blk * vol->PagesPerBlock;
+	u32 Idx;
+	FTL_TAG Tag;
+	INT Status = 0;
+
+	vol->InGc = 1U;
+	for (Idx = 0U; (Idx < vol->PagesPerBlock) && (vol->Valid[blk] > 0U) &&
+			(Status == 0); Idx++) {
+		if ((ftl_read_tag(vol, First + Idx, &Tag) == TAG_VALID) &&
+				(Tag.Type == TAG_DATA) && (Tag.Lpn < vol->NumLpn) &&
+				(vol->Map[Tag.Lpn] == (First + Idx))) {
+			Status = ftl_move(vol, Tag.Lpn, First + Idx);
+		}
+	}
+	for (Idx = 0U; (Idx < vol->NumLpn) && (vol->Valid[blk] > 0U) &&
+			(Status == 0); Idx++) {
+		if ((vol->Map[Idx] < FTL_LOST) &&
+				((vol->Map[Idx] / vol->PagesPerBlock) == blk)) {
+			Status = ftl_move(vol, Idx, vol->Map[Idx]);
+		}
+	}
+	vol->InGc = 0U;
+
+	if (Status == 0) {
+		vol->Stats.Collections++;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Retires the blocks which failed to program, once their valid pages are
+* moved.
+*
+* @param	*vol - Volume
+*
+* @return	None
+*
+******************************************************************************/
+static void ftl_retire (FTL_VOLUME* vol)
+{
+	u32 Blk;
+
+	for (Blk = 0U; (Blk < vol->NumBlocks) && (vol->NumRetire > 0U); Blk++) {
+		if (vol->State[Blk] != BLK_RETIRE) {
+			continue;
+		}
+		if ((vol->Valid[Blk] > 0U) && (ftl_collect(vol, Blk) != 0)) {
+			return;
+		}
+		if (vol->Valid[Blk] == 0U) {
+			ftl_mark_bad(vol, Blk);
+			vol->NumRetire--;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the word of index idx of the checkpoint stream: the header, the
+* mapping table and the erase counts.
+*
+******************************************************************************/
+static u32 ckpt_word (const FTL_VOLUME* vol, const u32* hdr, u32 idx)
+{
+	if (idx < CKPT_HDR_WORDS) {
+		return hdr[idx];
+	}
+	idx -= CKPT_HDR_WORDS;
+	if (idx < vol->NumLpn) {
+		return vol->Map[idx];
+	}
+	idx -= vol->NumLpn;
+	if (idx < vol->NumBlocks) {
+		return vol->Ec[idx];
+	}
+
+	return 0xFFFFFFFFU;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes a checkpoint of the mapping table, the erase counts and the open
+* blocks to free blocks. The previous checkpoint is released once the new one
+* is complete.
+*
+* @param	*vol - Volume
+*
+* @return	0 on success, -1 on failure.
+*
+******************************************************************************/
+static INT ftl_write_ckpt (FTL_VOLUME* vol)
+{
+	const FTL_DEVICE* Dev = vol->Dev;
+	u32 Words = vol->PageSize / 4U;
+	u32 Payload = Words - 2U;
+	u32 Hdr[CKPT_HDR_WORDS];
+	u32 New[FTL_MAX_CKPT_BLOCKS];
+	BYTE TagBuf[FTL_TAG_SIZE];
+	FTL_TAG Tag;
+	u32 Try, Pg, Idx, Blk, Seq;
+	INT Status = -1;
+
+	for (Try = 0U; (Try < PROGRAM_TRIES) && (Status != 0); Try++) {
+		while (vol->FreeBlocks < vol->CkptBlockCnt) {
+			Blk = ftl_pick_victim(vol);
+			if ((Blk == FTL_NONE) || (ftl_collect(vol, Blk) != 0)) {
+				return -1;
+			}
+		}
+
+		Seq = vol->NextSeq++;
+		(void)memset(Hdr, 0, sizeof(Hdr));
+		Hdr[0] = CKPT_MAGIC;
+		Hdr[1] = CKPT_VERSION;
+		Hdr[2] = Seq;
+		Hdr[3] = vol->CkptPages;
+		Hdr[4] = vol->PageSize;
+		Hdr[5] = vol->PagesPerBlock;
+		Hdr[6] = vol->NumBlocks;
+		Hdr[7] = vol->NumLpn;
+		Hdr[8] = vol->Front[STREAM_HOST].Block;
+		Hdr[9] = vol->Front[STREAM_HOST].Page;
+		Hdr[10] = vol->Front[STREAM_GC].Block;
+		Hdr[11] = vol->Front[STREAM_GC].Page;
+
+		for (Idx = 0U; Idx < FTL_MAX_CKPT_BLOCKS; Idx++) {
+			New[Idx] = FTL_NONE;
+		}
+
+		Status = 0;
+		for (Pg = 0U; (Pg < vol->CkptPages) && (Status == 0); Pg++) {
+			Idx = Pg / vol->PagesPerBlock;
+			if (New[Idx] == FTL_NONE) {
+				do {
+					Blk = ftl_pick_free(vol, 0U);
+					if (Blk == FTL_NONE) {
+						Status = -1;
+						break;
+					}
+					vol->FreeBlocks--;
+					vol->State[Blk] = BLK_OPEN;
+				} while (ftl_erase(vol, Blk) != 0);
+				if (Status != 0) {
+					break;
+				}
+				New[Idx] = Blk;
+			}
+			Blk = New[Idx];
+
+			for (Idx = 0U; Idx < Payload; Idx++) {
+				put32(&vol->GcBuf[Idx * 4U],
+					ckpt_word(vol, Hdr, (Pg * Payload) + Idx));
+			}
+			put32(&vol->GcBuf[Payload * 4U], Seq);
+			put32(&vol->GcBuf[(Words - 1U) * 4U],
+				crc32(vol->GcBuf, (Words - 1U) * 4U));
+
+			Tag.Seq = Seq;
+			Tag.Lpn = Pg;
+			Tag.Ec = vol->Ec[Blk];
+			Tag.Type = TAG_CKPT;
+			tag_encode(&Tag, TagBuf);
+			if (Dev->program_page(Dev->ctx,
+					(Blk * vol->PagesPerBlock) + (Pg % vol->PagesPerBlock),
+					vol->GcBuf, TagBuf) != 0) {
+				ftl_mark_bad(vol, Blk);
+				New[Pg / vol->PagesPerBlock] = FTL_NONE;
+				Status = -1;
+			}
+			vol->Stats.CkptPages++;
+		}
+
+		/* Release the blocks of a failed checkpoint */
+		for (Idx = 0U; Idx < FTL_MAX_CKPT_BLOCKS; Idx++) {
+			Blk = New[Idx];
+			if ((Blk == FTL_NONE) || (vol->State[Blk] != BLK_OPEN)) {
+				continue;
+			}
+			if (Status != 0) {
+				vol->State[Blk] = BLK_FREE;
+				vol->FreeBlocks++;
+			}
+		}
+	}
+	if (Status != 0) {
+		return -1;
+	}
+
+	for (Idx = 0U; Idx < FTL_MAX_CKPT_BLOCKS; Idx++) {
+		Blk = vol->CkptBlock[Idx];
+		if ((Blk != FTL_NONE) && (vol->State[Blk] == BLK_CKPT)) {
+			vol->State[Blk] = BLK_FREE;
+			vol->FreeBlocks++;
+		}
+		vol->CkptBlock[Idx] = New[Idx];
+		if (New[Idx] != FTL_NONE) {
+			vol->State[New[Idx]] = BLK_CKPT;
+		}
+	}
+	vol->CkptSeq = Seq;
+	vol->SinceCkpt = 0U;
+	vol->Stats.Checkpoints++;
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Loads the checkpoint with sequence number seq into the mapping table and
+* the erase counts. The erase counts read from the tags of the blocks
+* written after the checkpoint are kept.
+*
+* @param	*vol - Volume
+* @param	seq - Sequence number of the checkpoint
+* @param	*hdr - Header of the checkpoint to fill in
+*
+* @return	0 on success, -1 if the checkpoint is incomplete or corrupted.
+*
+******************************************************************************/
+static INT ftl_load_ckpt (FTL_VOLUME* vol, u32 seq, u32* hdr)
+{
+	u32 Words = vol->PageSize / 4U;
+	u32 Payload = Words - 2U;
+	u32 Blocks[FTL_MAX_CKPT_BLOCKS];
+	u32 Blk, Idx, Pg, Word, Val, Pages;
+	FTL_TAG Tag;
+
+	for (Idx = 0U; Idx < FTL_MAX_CKPT_BLOCKS; Idx++) {
+		Blocks[Idx] = FTL_NONE;
+	}
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if ((vol->State[Blk] != BLK_CKPT) || (vol->Seq[Blk] != seq)) {
+			continue;
+		}
+		if ((ftl_read_tag(vol, Blk * vol->PagesPerBlock, &Tag) != TAG_VALID) ||
+				((Tag.Lpn % vol->PagesPerBlock) != 0U)) {
+			continue;
+		}
+		Idx = Tag.Lpn / vol->PagesPerBlock;
+		if (Idx < FTL_MAX_CKPT_BLOCKS) {
+			Blocks[Idx] = Blk;
+		}
+	}
+
+	Pages = 1U;
+	for (Pg = 0U; Pg < Pages; Pg++) {
+		Blk = Blocks[Pg / vol->PagesPerBlock];
+		if ((Blk == FTL_NONE) ||
+				(ftl_read_data(vol, (Blk * vol->PagesPerBlock) +
+					(Pg % vol->PagesPerBlock), vol->GcBuf) < 0) ||
+				(get32(&vol->GcBuf[Payload * 4U]) != seq) ||
+				(get32(&vol->GcBuf[(Words - 1U) * 4U]) !=
+					crc32(vol->GcBuf, (Words - 1U) * 4U))) {
+			return -1;
+		}
+
+		for (Idx = 0U; Idx < Payload; Idx++) {
+			Word = (Pg * Payload) + Idx;
+			Val = get32(&vol->GcBuf[Idx * 4U]);
+			if (Word < CKPT_HDR_WORDS) {
+				hdr[Word] = Val;
+				continue;
+			}
+			if (Word == CKPT_HDR_WORDS) {
+				/* Header complete */
+				if ((hdr[0] != CKPT_MAGIC) || (hdr[1] != CKPT_VERSION) ||
+						(hdr[2] != seq) ||
+						(hdr[4] != vol->PageSize) ||
+						(hdr[5] != vol->PagesPerBlock) ||
+						(hdr[6] != vol->NumBlocks) ||
+						(hdr[7] > (vol->NumBlocks * vol->PagesPerBlock)) ||
+						(hdr[3] != vol->CkptPages)) {
+					return -1;
+				}
+				vol->NumLpn = hdr[7];
+				Pages = hdr[3];
+			}
+			Word -= CKPT_HDR_WORDS;
+			if (Word < vol->NumLpn) {
+				vol->Map[Word] = Val;
+				continue;
+			}
+			Word -= vol->NumLpn;
+			if ((Word < vol->NumBlocks) && (Val > vol->Ec[Word])) {
+				vol->Ec[Word] = Val;
+			}
+		}
+	}
+
+	for (Idx = 0U; Idx < FTL_MAX_CKPT_BLOCKS; Idx++) {
+		vol->CkptBlock[Idx] = (Idx < ((Pages + vol->PagesPerBlock - 1U) /
+					vol->PagesPerBlock)) ? Blocks[Idx] : FTL_NONE;
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets up a volume for a device and carves its tables and buffers out of the
+* work area.
+*
+* @param	*vol - Volume
+* @param	*dev - Device
+* @param	*work - Work area
+* @param	words - Size of the work area in words
+*
+* @return	FTL_OK, FTL_INVALID or FTL_NOT_ENOUGH_CORE.
+*
+******************************************************************************/
+static FTL_RESULT ftl_setup (FTL_VOLUME* vol, const FTL_DEVICE* dev, u32* work,
+			     UINT words)
+{
+	u32 Blocks = dev->num_blocks;
+	u32 Ppb = dev->pages_per_block;
+	u32 Need, Idx;
+	BYTE* Buf;
+
+	if (((dev->page_size % FTL_SECTOR_SIZE) != 0U) ||
+			((dev->page_size / FTL_SECTOR_SIZE) > 32U) ||
+			(dev->page_size == 0U) || (Ppb == 0U) ||
+			(Ppb > 0xFFFFU) || (Blocks < 8U)) {
+		return FTL_INVALID;
+	}
+	if (words < FTL_WORK_WORDS(Blocks, Ppb, dev->page_size)) {
+		return FTL_NOT_ENOUGH_CORE;
+	}
+
+	(void)memset(vol, 0, sizeof(*vol));
+	vol->Dev = dev;
+	vol->NumBlocks = Blocks;
+	vol->PagesPerBlock = Ppb;
+	vol->PageSize = dev->page_size;
+	vol->SectorsPerPage = dev->page_size / FTL_SECTOR_SIZE;
+
+	/* Size the checkpoint for the largest mapping table */
+	Need = CKPT_HDR_WORDS + (Blocks * Ppb) + Blocks;
+	vol->CkptPages = (Need + (vol->PageSize / 4U) - 3U) / ((vol->PageSize / 4U) - 2U);
+	vol->CkptBlockCnt = (vol->CkptPages + Ppb - 1U) / Ppb;
+	if (vol->CkptBlockCnt > FTL_MAX_CKPT_BLOCKS) {
+		return FTL_INVALID;
+	}
+	/*
+	 * Collection keeps room for the next checkpoint, a block for the
+	 * moved pages and one more for a block which fails to erase.
+	 */
+	vol->MinFree = vol->CkptBlockCnt + 2U;
+
+	vol->Map = work;
+	vol->Ec = &work[Blocks * Ppb];
+	vol->Seq = &vol->Ec[Blocks];
+	vol->Valid = (u16*)(void*)&vol->Seq[Blocks];
+	vol->State = (BYTE*)(void*)&vol->Valid[Blocks];
+	/* Page buffers, aligned for the cache maintenance of DMA transfers */
+	Buf = (BYTE*)(void*)(((UINTPTR)&vol->State[Blocks] + 63U) & ~(UINTPTR)63U);
+	vol->GcBuf = Buf;
+	vol->RdBuf = &Buf[vol->PageSize];
+	for (Idx = 0U; Idx < FILE_SYSTEM_NAND_FTL_WBUF_PAGES; Idx++) {
+		vol->Wbuf[Idx].Lpn = FTL_NONE;
+		vol->Wbuf[Idx].Data = &Buf[(Idx + 2U) * vol->PageSize];
+	}
+
+	for (Idx = 0U; Idx < (Blocks * Ppb); Idx++) {
+		vol->Map[Idx] = FTL_NONE;
+	}
+	for (Idx = 0U; Idx < Blocks; Idx++) {
+		vol->Ec[Idx] = 0U;
+		vol->Seq[Idx] = FTL_NONE;
+		vol->Valid[Idx] = 0U;
+		vol->State[Idx] = BLK_FREE;
+	}
+	for (Idx = 0U; Idx < FTL_MAX_CKPT_BLOCKS; Idx++) {
+		vol->CkptBlock[Idx] = FTL_NONE;
+	}
+	vol->RdPage = FTL_NONE;
+	vol->Front[STREAM_HOST].Block = FTL_NONE;
+	vol->Front[STREAM_GC].Block = FTL_NONE;
+	vol->NextSeq = 1U;
+
+	return FTL_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns non zero if a physical page was programmed after the checkpoint,
+* in a block written after it or after the open page of a block open when it
+* was written.
+*
+******************************************************************************/
+static UINT ftl_replayed (const FTL_VOLUME* vol, const u32* hdr, u32 page)
+{
+	u32 Blk = page / vol->PagesPerBlock;
+	UINT Stream;
+
+	if ((vol->Seq[Blk] != FTL_NONE) && (vol->Seq[Blk] > vol->CkptSeq)) {
+		return 1U;
+	}
+	for (Stream = 0U; Stream < 2U; Stream++) {
+		if ((hdr[8U + (2U * Stream)] == Blk) &&
+				((page % vol->PagesPerBlock) >= hdr[9U + (2U * Stream)])) {
+			return 1U;
+		}
+	}
+
+	return 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Mounts an FTL volume. The newest complete checkpoint is loaded and the tags
+* of the pages programmed after it are replayed.
+*
+* @param	*vol - Volume
+* @param	*dev - Device
+* @param	*work - Work area, FTL_WORK_WORDS() words
+* @param	words - Size of the work area in words
+*
+* @return	FTL_OK on success, FTL_NO_FTL if the device holds no FTL, see
+*		FTL_RESULT for the other errors.
+*
+* @note		A device holding data but no valid checkpoint is reported as
+*		FTL_ERROR, it is only formatted on request.
+*
+******************************************************************************/
+FTL_RESULT disk_ftl_mount (FTL_VOLUME* vol, const FTL_DEVICE* dev, u32* work, UINT words)
+{
+	u32 Hdr[CKPT_HDR_WORDS];
+	u32 MaxSeq = 0U;
+	u32 Blk, Idx, Page, Cur, Below;
+	UINT HasData = 0U;
+	FTL_RESULT Res;
+	FTL_TAG Tag, CurTag;
+	INT Status = TAG_ERASED;
+
+	Res = ftl_setup(vol, dev, work, words);
+	if (Res != FTL_OK) {
+		return Res;
+	}
+
+	/* Identify the blocks from the tag of their first programmed page */
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if (dev->is_bad(dev->ctx, Blk) != 0) {
+			vol->State[Blk] = BLK_BAD;
+			vol->Stats.BadBlocks++;
+			continue;
+		}
+		for (Idx = 0U; Idx < vol->PagesPerBlock; Idx++) {
+			Status = ftl_read_tag(vol, (Blk * vol->PagesPerBlock) + Idx, &Tag);
+			if (Status != TAG_INVALID) {
+				break;
+			}
+		}
+		if (Status != TAG_VALID) {
+			continue;
+		}
+		vol->Seq[Blk] = Tag.Seq;
+		vol->Ec[Blk] = Tag.Ec;
+		vol->State[Blk] = (Tag.Type == TAG_CKPT) ? BLK_CKPT : BLK_FULL;
+		if (Tag.Type == TAG_DATA) {
+			HasData = 1U;
+		}
+		if (Tag.Seq > MaxSeq) {
+			MaxSeq = Tag.Seq;
+		}
+	}
+
+	/* Load the newest complete checkpoint */
+	Below = FTL_NONE;
+	do {
+		vol->CkptSeq = 0U;
+		for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+			if ((vol->State[Blk] == BLK_CKPT) && (vol->Seq[Blk] < Below) &&
+					(vol->Seq[Blk] > vol->CkptSeq)) {
+				vol->CkptSeq = vol->Seq[Blk];
+			}
+		}
+		if (vol->CkptSeq == 0U) {
+			return (HasData != 0U) ? FTL_ERROR : FTL_NO_FTL;
+		}
+		Below = vol->CkptSeq;
+	} while (ftl_load_ckpt(vol, vol->CkptSeq, Hdr) != 0);
+
+	/*
+	 * Drop the entries of the blocks erased since the checkpoint, the
+	 * replay maps the pages moved out of them again.
+	 */
+	for (Idx = 0U; Idx < vol->NumLpn; Idx++) {
+		Cur = vol->Map[Idx];
+		if (Cur >= FTL_LOST) {
+			continue;
+		}
+		Blk = Cur / vol->PagesPerBlock;
+		if ((Blk >= vol->NumBlocks) || (vol->State[Blk] != BLK_FULL) ||
+				(vol->Seq[Blk] > vol->CkptSeq)) {
+			vol->Map[Idx] = FTL_NONE;
+		}
+	}
+
+	/* Replay the pages programmed after the checkpoint */
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if (vol->State[Blk] != BLK_FULL) {
+			continue;
+		}
+		for (Idx = 0U; Idx < vol->PagesPerBlock; Idx++) {
+			Page = (Blk * vol->PagesPerBlock) + Idx;
+			if (ftl_replayed(vol, Hdr, Page) == 0U) {
+				continue;
+			}
+			if ((ftl_read_tag(vol, Page, &Tag) != TAG_VALID) ||
+					(Tag.Type != TAG_DATA) || (Tag.Seq <= vol->CkptSeq)) {
+				continue;
+			}
+			if (Tag.Seq > MaxSeq) {
+				MaxSeq = Tag.Seq;
+			}
+			if (Tag.Lpn >= vol->NumLpn) {
+				continue;
+			}
+			Cur = vol->Map[Tag.Lpn];
+			if ((Cur < FTL_LOST) && (ftl_replayed(vol, Hdr, Cur) != 0U) &&
+					(ftl_read_tag(vol, Cur, &CurTag) == TAG_VALID) &&
+					(CurTag.Seq > Tag.Seq)) {
+				continue;
+			}
+			vol->Map[Tag.Lpn] = Page;
+			vol->Stats.ReplayPages++;
+		}
+		if (vol->Seq[Blk] > vol->CkptSeq) {
+			vol->SinceCkpt++;
+		}
+	}
+
+	/* Count the valid pages and settle the block states */
+	for (Idx = 0U; Idx < vol->NumLpn; Idx++) {
+		if (vol->Map[Idx] < FTL_LOST) {
+			vol->Valid[vol->Map[Idx] / vol->PagesPerBlock]++;
+		}
+	}
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if (vol->State[Blk] == BLK_CKPT) {
+			vol->State[Blk] = BLK_FREE;
+		}
+	}
+	for (Idx = 0U; Idx < FTL_MAX_CKPT_BLOCKS; Idx++) {
+		if (vol->CkptBlock[Idx] != FTL_NONE) {
+			vol->State[vol->CkptBlock[Idx]] = BLK_CKPT;
+		}
+	}
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if ((vol->State[Blk] == BLK_FULL) && (vol->Valid[Blk] == 0U)) {
+			vol->State[Blk] = BLK_FREE;
+		}
+		if (vol->State[Blk] == BLK_FREE) {
+			vol->FreeBlocks++;
+		}
+	}
+
+	vol->NextSeq = ((MaxSeq > vol->CkptSeq) ? MaxSeq : vol->CkptSeq) + 1U;
+
+	return FTL_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Formats an FTL volume. All good blocks are erased, keeping the erase counts
+* found in their tags, and an empty checkpoint is written.
+*
+* @param	*vol - Volume
+* @param	*dev - Device
+* @param	*work - Work area, FTL_WORK_WORDS() words
+* @param	words - Size of the work area in words
+*
+* @return	FTL_OK on success, see FTL_RESULT for the errors. The volume is
+*		mounted on success.
+*
+******************************************************************************/
+FTL_RESULT disk_ftl_format (FTL_VOLUME* vol, const FTL_DEVICE* dev, u32* work, UINT words)
+{
+	u32 Good = 0U;
+	u32 Reserve;
+	u32 Blk;
+	FTL_RESULT Res;
+	FTL_TAG Tag;
+
+	Res = ftl_setup(vol, dev, work, words);
+	if (Res != FTL_OK) {
+		return Res;
+	}
+
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if (dev->is_bad(dev->ctx, Blk) != 0) {
+			vol->State[Blk] = BLK_BAD;
+			vol->Stats.BadBlocks++;
+			continue;
+		}
+		if (ftl_read_tag(vol, Blk * vol->PagesPerBlock, &Tag) == TAG_VALID) {
+			vol->Ec[Blk] = Tag.Ec;
+		}
+		if (ftl_erase(vol, Blk) == 0) {
+			Good++;
+		}
+	}
+
+	Reserve = (2U * vol->CkptBlockCnt) + 5U +
+		((Good * FILE_SYSTEM_NAND_FTL_OVER_PROVISION) / 100U);
+	if (Good <= Reserve) {
+		return FTL_ERROR;
+	}
+	vol->NumLpn = (Good - Reserve) * vol->PagesPerBlock;
+	vol->FreeBlocks = Good;
+
+	if (ftl_write_ckpt(vol) != 0) {
+		return FTL_ERROR;
+	}
+
+	return FTL_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Looks up a logical page in the write buffer.
+*
+******************************************************************************/
+static INT wbuf_find (const FTL_VOLUME* vol, u32 lpn)
+{
+	UINT Idx;
+
+	for (Idx = 0U; Idx < FILE_SYSTEM_NAND_FTL_WBUF_PAGES; Idx++) {
+		if (vol->Wbuf[Idx].Lpn == lpn) {
+			return (INT)Idx;
+		}
+	}
+
+	return -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes a write buffer entry to the flash. The sectors of the logical page
+* which are not held by the entry are read from the flash first.
+*
+* @param	*vol - Volume
+* @param	idx - Write buffer entry
+*
+* @return	0 on success, -1 on failure. The entry is kept on failure.
+*
+******************************************************************************/
+static INT wbuf_flush (FTL_VOLUME* vol, UINT idx)
+{
+	FTL_WBUF* Entry = &vol->Wbuf[idx];
+	u32 Full = (vol->SectorsPerPage == 32U) ? 0xFFFFFFFFU :
+			((1U << vol->SectorsPerPage) - 1U);
+	u32 Old, Sect;
+
+	if (Entry->Lpn == FTL_NONE) {
+		return 0;
+	}
+
+	if (Entry->Mask != Full) {
+		Old = vol->Map[Entry->Lpn];
+		if (Old < FTL_LOST) {
+			if (ftl_read_data(vol, Old, vol->GcBuf) < 0) {
+				return -1;
+			}
+		} else {
+			/* Never written, or lost to a read error */
+			(void)memset(vol->GcBuf, 0xFF, vol->PageSize);
+		}
+		for (Sect = 0U; Sect < vol->SectorsPerPage; Sect++) {
+			if ((Entry->Mask & (1U << Sect)) == 0U) {
+				(void)memcpy(&Entry->Data[Sect * FTL_SECTOR_SIZE],
+					&vol->GcBuf[Sect * FTL_SECTOR_SIZE],
+					FTL_SECTOR_SIZE);
+			}
+		}
+		Entry->Mask = Full;
+	}
+
+	if (ftl_write_page(vol, STREAM_HOST, Entry->Lpn, Entry->Data) != 0) {
+		return -1;
+	}
+	vol->Stats.HostPages++;
+	Entry->Lpn = FTL_NONE;
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the write buffer entry of a logical page, allocating the least
+* recently written entry if the page is not buffered.
+*
+******************************************************************************/
+static INT wbuf_get (FTL_VOLUME* vol, u32 lpn)
+{
+	INT Idx = wbuf_find(vol, lpn);
+	UINT Way;
+
+	if (Idx >= 0) {
+		return Idx;
+	}
+
+	Idx = wbuf_find(vol, FTL_NONE);
+	if (Idx < 0) {
+		Idx = 0;
+		for (Way = 1U; Way < FILE_SYSTEM_NAND_FTL_WBUF_PAGES; Way++) {
+			if (vol->Wbuf[Way].Stamp < vol->Wbuf[Idx].Stamp) {
+				Idx = (INT)Way;
+			}
+		}
+		if (wbuf_flush(vol, (UINT)Idx) != 0) {
+			return -1;
+		}
+	}
+
+	vol->Wbuf[Idx].Lpn = lpn;
+	vol->Wbuf[Idx].Mask = 0U;
+
+	return Idx;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads a mapped logical page into a page buffer. A page read with at least
+* scrub_bits corrected bits is rewritten, when free blocks are left.
+*
+* @param	*vol - Volume
+* @param	lpn - Logical page
+* @param	*buf - Page buffer
+*
+* @return	0 on success, -1 if the page is uncorrectable or lost.
+*
+******************************************************************************/
+static INT ftl_read_lpn (FTL_VOLUME* vol, u32 lpn, BYTE* buf)
+{
+	u32 Page = vol->Map[lpn];
+	INT Bits;
+
+	if (Page == FTL_LOST) {
+		return -1;
+	}
+
+	Bits = ftl_read_data(vol, Page, buf);
+	if (Bits < 0) {
+		return -1;
+	}
+
+	if ((vol->Dev->scrub_bits != 0U) && ((u32)Bits >= vol->Dev->scrub_bits) &&
+			((vol->Front[STREAM_GC].Block != FTL_NONE) ||
+			 (vol->FreeBlocks > vol->MinFree))) {
+		if (ftl_write_page(vol, STREAM_GC, lpn, buf) == 0) {
+			vol->Stats.Scrubs++;
+		}
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors of the volume.
+*
+* @param	*vol - Volume
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK on success, RES_ERROR on an uncorrectable page,
+*		RES_PARERR if the sectors are out of the volume.
+*
+* @note		Sectors never written read as 0xFF.
+*
+******************************************************************************/
+DRESULT disk_ftl_read (FTL_VOLUME* vol, BYTE* buff, DWORD sector, UINT count)
+{
+	const FTL_DEVICE* Dev = vol->Dev;
+	u32 Run[FTL_MAX_RUN_PAGES];
+	u32 Lpn, Sect, Num, Idx;
+	INT Entry;
+
+	if (((DWORD)count > ((DWORD)vol->NumLpn * vol->SectorsPerPage)) ||
+			(sector > (((DWORD)vol->NumLpn * vol->SectorsPerPage) - count))) {
+		return RES_PARERR;
+	}
+
+	while (count > 0U) {
+		Lpn = (u32)(sector / vol->SectorsPerPage);
+		Sect = (u32)(sector % vol->SectorsPerPage);
+
+		/* Gather whole pages mapped on the flash */
+		Num = 0U;
+		while ((Sect == 0U) && (Num < FTL_MAX_RUN_PAGES) &&
+				(((Num + 1U) * vol->SectorsPerPage) <= count) &&
+				(vol->Map[Lpn + Num] < FTL_LOST) &&
+				(wbuf_find(vol, Lpn + Num) < 0)) {
+			Run[Num] = vol->Map[Lpn + Num];
+			Num++;
+		}
+		if (Num > 0U) {
+			if ((Num == 1U) || (Dev->read_pages == NULL) ||
+					(Dev->read_pages(Dev->ctx, Run, Num, buff) != 0)) {
+				/* Read page by page to account for the bits corrected */
+				for (Idx = 0U; Idx < Num; Idx++) {
+					if (ftl_read_lpn(vol, Lpn + Idx,
+							&buff[Idx * vol->PageSize]) != 0) {
+						return RES_ERROR;
+					}
+				}
+			}
+			buff += Num * vol->PageSize;
+			sector += (DWORD)Num * vol->SectorsPerPage;
+			count -= Num * vol->SectorsPerPage;
+			continue;
+		}
+
+		Entry = wbuf_find(vol, Lpn);
+		for (; (Sect < vol->SectorsPerPage) && (count > 0U); Sect++) {
+			if ((Entry >= 0) && ((vol->Wbuf[Entry].Mask & (1U << Sect)) != 0U)) {
+				(void)memcpy(buff, &vol->Wbuf[Entry].Data[Sect * FTL_SECTOR_SIZE],
+					FTL_SECTOR_SIZE);
+			} else if (vol->Map[Lpn] == FTL_NONE) {
+				(void)memset(buff, 0xFF, FTL_SECTOR_SIZE);
+			} else {
+				if ((vol->RdPage == FTL_NONE) || (vol->RdPage != vol->Map[Lpn])) {
+					vol->RdPage = FTL_NONE;
+					if (ftl_read_lpn(vol, Lpn, vol->RdBuf) != 0) {
+						return RES_ERROR;
+					}
+					vol->RdPage = vol->Map[Lpn];
+				}
+				(void)memcpy(buff, &vol->RdBuf[Sect * FTL_SECTOR_SIZE],
+					FTL_SECTOR_SIZE);
+			}
+			buff += FTL_SECTOR_SIZE;
+			sector++;
+			count--;
+		}
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors of the volume. Whole pages are programmed at once, other
+* sectors are merged in the write buffer.
+*
+* @param	*vol - Volume
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK on success, RES_ERROR on a device failure or when the
+*		volume is full, RES_PARERR if the sectors are out of the volume.
+*
+******************************************************************************/
+DRESULT disk_ftl_write (FTL_VOLUME* vol, const BYTE* buff, DWORD sector, UINT count)
+{
+	u32 Lpn, Sect;
+	INT Entry;
+
+	if (((DWORD)count > ((DWORD)vol->NumLpn * vol->SectorsPerPage)) ||
+			(sector > (((DWORD)vol->NumLpn * vol->SectorsPerPage) - count))) {
+		return RES_PARERR;
+	}
+
+	while (count > 0U) {
+		Lpn = (u32)(sector / vol->SectorsPerPage);
+		Sect = (u32)(sector % vol->SectorsPerPage);
+
+		if ((Sect == 0U) && (count >= vol->SectorsPerPage)) {
+			/* The page replaces any buffered sectors */
+			Entry = wbuf_find(vol, Lpn);
+			if (Entry >= 0) {
+				vol->Wbuf[Entry].Lpn = FTL_NONE;
+			}
+			if (ftl_write_page(vol, STREAM_HOST, Lpn, buff) != 0) {
+				return RES_ERROR;
+			}
+			vol->Stats.HostPages++;
+			buff += vol->PageSize;
+			sector += vol->SectorsPerPage;
+			count -= vol->SectorsPerPage;
+			continue;
+		}
+
+		Entry = wbuf_get(vol, Lpn);
+		if (Entry < 0) {
+			return RES_ERROR;
+		}
+		for (; (Sect < vol->SectorsPerPage) && (count > 0U); Sect++) {
+			(void)memcpy(&vol->Wbuf[Entry].Data[Sect * FTL_SECTOR_SIZE], buff,
+				FTL_SECTOR_SIZE);
+			vol->Wbuf[Entry].Mask |= 1U << Sect;
+			buff += FTL_SECTOR_SIZE;
+			sector++;
+			count--;
+		}
+		vol->Wbuf[Entry].Stamp = ++vol->Clock;
+	}
+
+	if ((vol->NumRetire > 0U) && (vol->InGc == 0U)) {
+		ftl_retire(vol);
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the write buffer to the flash, so that the sectors written so far
+* survive a power loss, and writes a checkpoint once
+* FILE_SYSTEM_NAND_FTL_CKPT_INTERVAL blocks were opened since the previous
+* one.
+*
+* @param	*vol - Volume
+*
+* @return	RES_OK on success, RES_ERROR on failure.
+*
+******************************************************************************/
+DRESULT disk_ftl_sync (FTL_VOLUME* vol)
+{
+	UINT Idx;
+
+	for (Idx = 0U; Idx < FILE_SYSTEM_NAND_FTL_WBUF_PAGES; Idx++) {
+		if (wbuf_flush(vol, Idx) != 0) {
+			return RES_ERROR;
+		}
+	}
+
+	if (vol->NumRetire > 0U) {
+		ftl_retire(vol);
+	}
+
+	if (vol->SinceCkpt >= FILE_SYSTEM_NAND_FTL_CKPT_INTERVAL) {
+		return disk_ftl_checkpoint(vol);
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes a checkpoint, so that the next mount does not replay the blocks
+* written so far. Sectors held in the write buffer are not flushed.
+*
+* @param	*vol - Volume
+*
+* @return	RES_OK on success, RES_ERROR on failure.
+*
+******************************************************************************/
+DRESULT disk_ftl_checkpoint (FTL_VOLUME* vol)
+{
+	return (ftl_write_ckpt(vol) == 0) ? RES_OK : RES_ERROR;
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the number of sectors of the volume.
+*
+******************************************************************************/
+DWORD disk_ftl_sector_count (const FTL_VOLUME* vol)
+{
+	return (DWORD)vol->NumLpn * vol->SectorsPerPage;
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the statistics of the volume, with the free blocks and the erase
+* count range of the good blocks.
+*
+******************************************************************************/
+void disk_ftl_stats (const FTL_VOLUME* vol, FTL_STATS* stats)
+{
+	u32 Blk;
+
+	*stats = vol->Stats;
+	stats->FreeBlocks = vol->FreeBlocks;
+	stats->MinErase = 0xFFFFFFFFU;
+	stats->MaxErase = 0U;
+	for (Blk = 0U; Blk < vol->NumBlocks; Blk++) {
+		if (vol->State[Blk] == BLK_BAD) {
+			continue;
+		}
+		if (vol->Ec[Blk] < stats->MinErase) {
+			stats->MinErase = vol->Ec[Blk];
+		}
+		if (vol->Ec[Blk] > stats->MaxErase) {
+			stats->MaxErase = vol->Ec[Blk];
+		}
+	}
+}
+
+#endif	/* FILE_SYSTEM_INTERFACE_NAND */
@@ -27,6 +27,16 @@
 *		The file system can be used to read from and write to an
 *		SD card that is already formatted as FATFS.
 *
+*		Description related to NAND:
+*		In SDK, set "fs_interface" to 3 to select the NAND interface.
+*		Drive 0 is a flash translation layer volume (diskftl.c) on
+*		the nand_ftl_blocks blocks of the NAND flash starting at
+*		nand_ftl_start_block. disk_initialize formats the blocks
+*		when they hold no volume. CTRL_FORMAT formats them again.
+*		The FTL keeps 32 bytes of the spare area of every page,
+*		from offset 2, which are programmed after the page data.
+*		The flash must allow two partial programs of a page.
+*
 * <pre>
 * MODIFICATION HISTORY:
 *
@@ -60,6 +70,11 @@
 *       mn   09/25/19 Check if the SD is powered on or not in disk_status()
 * 4.3   mn   02/24/20 Remove unused macro defines
 *       mn   04/08/20 Set IsReady to '0' before calling XSdPs_CfgInitialize
+* 4.4   mn   10/18/20 Route disk_read/disk_write through the optional block
+*                     cache (diskcache.c)
+*       mn   10/18/20 Keep SD base address, card detect and write protect
+*                     per drive so that both SD slots can be used at once
+*       mn   10/18/20 Add NAND interface through a flash translation layer
 *
 * </pre>
 *
@@ -67,12 +82,18 @@
 *
 ******************************************************************************/
 #include "diskio.h"
+#include "diskcache.h"
 #include "ff.h"
 #include "xil_types.h"
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
 #include "xsdps.h"		/* SD device driver */
 #endif
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+#include "xnandpsu.h"		/* NAND device driver */
+#include "xnandpsu_bbm.h"
+#include "diskftl.h"
+#endif
 #include "sleep.h"
 #include "xil_printf.h"
 
@@ -88,6 +109,27 @@ static char *dataramfs = NULL;
 #define SECTORCNT       (RAMFS_SIZE / SECTORSIZE)
 #endif
 
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+#ifndef FILE_SYSTEM_NAND_FTL_START_BLOCK
+#define FILE_SYSTEM_NAND_FTL_START_BLOCK	0U
+#endif
+#ifndef FILE_SYSTEM_NAND_FTL_BLOCKS
+#define FILE_SYSTEM_NAND_FTL_BLOCKS		1024U
+#endif
+#ifndef FILE_SYSTEM_NAND_FTL_MAX_PAGES_PER_BLOCK
+#define FILE_SYSTEM_NAND_FTL_MAX_PAGES_PER_BLOCK	64U
+#endif
+#ifndef FILE_SYSTEM_NAND_FTL_MAX_PAGE_SIZE
+#define FILE_SYSTEM_NAND_FTL_MAX_PAGE_SIZE	4096U
+#endif
+
+#define NAND_TAG_OFFSET		2U	/* Spare offset of the FTL tag, after the
+					   bad block marker */
+#define FTL_WORK_SIZE	FTL_WORK_WORDS(FILE_SYSTEM_NAND_FTL_BLOCKS, \
+				FILE_SYSTEM_NAND_FTL_MAX_PAGES_PER_BLOCK, \
+				FILE_SYSTEM_NAND_FTL_MAX_PAGE_SIZE)
+#endif
+
 /*--------------------------------------------------------------------------
 
 	Public Functions
@@ -101,13 +143,242 @@ static DSTATUS Stat[2] = {STA_NOINIT, STA_NOINIT};	/* Disk status */
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
 static XSdPs SdInstance[2];
-static u32 BaseAddress;
-static u32 CardDetect;
-static u32 WriteProtect;
+static u32 BaseAddress[2];
+static u32 CardDetect[2];
+static u32 WriteProtect[2];
 static u32 SlotType[2];
 static u8 HostCntrlrVer[2];
 #endif
 
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+static XNandPsu NandInstance;
+static FTL_DEVICE NandDevice;			/* NAND controller */
+static const FTL_DEVICE *FtlDevice = NULL;	/* Device of drive 0 */
+static FTL_VOLUME FtlVolume;
+static u32 FtlWork[FTL_WORK_SIZE] __attribute__ ((aligned(64)));
+static u8 NandSpare[XNANDPSU_MAX_SPARE_SIZE] __attribute__ ((aligned(64)));
+static u32 NandFirstPage;	/* First page of the FTL blocks */
+
+/*****************************************************************************/
+/**
+*
+* FTL device functions on the NAND controller. Pages and blocks are relative
+* to FILE_SYSTEM_NAND_FTL_START_BLOCK.
+*
+******************************************************************************/
+static INT nand_read_page (void *ctx, u32 page, BYTE *data, BYTE *tag)
+{
+	XNandPsu *Nand = (XNandPsu *)ctx;
+	u32 Page = NandFirstPage + page;
+	INT Bits = 0;
+
+	if (data != NULL) {
+		Nand->Ecc_Stat_PerPage_flips = 0U;
+		if (XNandPsu_Read(Nand, (u64)Page * Nand->Geometry.BytesPerPage,
+				Nand->Geometry.BytesPerPage, data) != XST_SUCCESS) {
+			return -1;
+		}
+		Bits = (INT)Nand->Ecc_Stat_PerPage_flips;
+	}
+
+	if (tag != NULL) {
+		if (XNandPsu_ReadSpareBytes(Nand, Page, NandSpare) != XST_SUCCESS) {
+			return -1;
+		}
+		(void)memcpy(tag, &NandSpare[NAND_TAG_OFFSET], FTL_TAG_SIZE);
+	}
+
+	return Bits;
+}
+
+static INT nand_read_pages (void *ctx, const u32 *pages, UINT count, BYTE *data)
+{
+	u32 Pages[FTL_MAX_RUN_PAGES];
+	UINT Idx;
+
+	for (Idx = 0U; Idx < count; Idx++) {
+		Pages[Idx] = NandFirstPage + pages[Idx];
+	}
+
+	return (XNandPsu_ReadPages((XNandPsu *)ctx, Pages, count, data) ==
+			XST_SUCCESS) ? 0 : -1;
+}
+
+static INT nand_program_page (void *ctx, u32 page, const BYTE *data,
+			      const BYTE *tag)
+{
+	XNandPsu *Nand = (XNandPsu *)ctx;
+	u32 Page = NandFirstPage + page;
+
+	if (XNandPsu_Write(Nand, (u64)Page * Nand->Geometry.BytesPerPage,
+			Nand->Geometry.BytesPerPage,
+			(u8 *)(UINTPTR)data) != XST_SUCCESS) {
+		return -1;
+	}
+
+	/* Second partial program of the page, bad block marker left erased */
+	(void)memset(NandSpare, 0xFF, Nand->Geometry.SpareBytesPerPage);
+	(void)memcpy(&NandSpare[NAND_TAG_OFFSET], tag, FTL_TAG_SIZE);
+	if (XNandPsu_WriteSpareBytes(Nand, Page, NandSpare) != XST_SUCCESS) {
+		return -1;
+	}
+
+	return 0;
+}
+
+static INT nand_erase_block (void *ctx, u32 block)
+{
+	XNandPsu *Nand = (XNandPsu *)ctx;
+
+	return (XNandPsu_Erase(Nand, (u64)(FILE_SYSTEM_NAND_FTL_START_BLOCK + block) *
+			Nand->Geometry.BlockSize,
+			Nand->Geometry.BlockSize) == XST_SUCCESS) ? 0 : -1;
+}
+
+static INT nand_is_bad (void *ctx, u32 block)
+{
+	XNandPsu *Nand = (XNandPsu *)ctx;
+	u32 Block = FILE_SYSTEM_NAND_FTL_START_BLOCK + block;
+	u8 Type;
+
+	/* Blocks reserved for the bad block table are not used either */
+	Type = (Nand->Bbt[Block >> XNANDPSU_BBT_BLOCK_SHIFT] >>
+			XNandPsu_BbtBlockShift(Block)) & XNANDPSU_BLOCK_TYPE_MASK;
+
+	return (Type != XNANDPSU_BLOCK_GOOD) ? 1 : 0;
+}
+
+static INT nand_mark_bad (void *ctx, u32 block)
+{
+	return (XNandPsu_MarkBlockBad((XNandPsu *)ctx,
+			FILE_SYSTEM_NAND_FTL_START_BLOCK + block) ==
+			XST_SUCCESS) ? 0 : -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* Initializes the NAND controller, on first use, and describes the blocks
+* managed by the FTL.
+*
+* @return	NAND FTL device, NULL on failure.
+*
+******************************************************************************/
+static const FTL_DEVICE *disk_nand_device (void)
+{
+	XNandPsu_Config *NandConfig;
+	XNandPsu_Geometry *Geo = &NandInstance.Geometry;
+	u32 Blocks;
+
+	if (NandDevice.ctx != NULL) {
+		return &NandDevice;
+	}
+
+	NandConfig = XNandPsu_LookupConfig(XPAR_XNANDPSU_0_DEVICE_ID);
+	if (NandConfig == NULL) {
+		return NULL;
+	}
+	if (XNandPsu_CfgInitialize(&NandInstance, NandConfig,
+			NandConfig->BaseAddress) != XST_SUCCESS) {
+		return NULL;
+	}
+
+	if ((Geo->NumBlocks <= FILE_SYSTEM_NAND_FTL_START_BLOCK) ||
+			(Geo->PagesPerBlock > FILE_SYSTEM_NAND_FTL_MAX_PAGES_PER_BLOCK) ||
+			(Geo->BytesPerPage > FILE_SYSTEM_NAND_FTL_MAX_PAGE_SIZE)) {
+		xil_printf("NAND geometry exceeds the FTL settings\r\n");
+		return NULL;
+	}
+	/*
+	 * The tag must fit in the free spare bytes before the ECC, which
+	 * XNandPsu_WriteSpareBytes() writes in multiples of 4 bytes
+	 */
+	if ((NandInstance.EccMode == XNANDPSU_HWECC) &&
+			(((u32)(NandInstance.EccCfg.EccAddr - Geo->BytesPerPage) & ~3U) <
+			 (NAND_TAG_OFFSET + FTL_TAG_SIZE))) {
+		xil_printf("NAND spare area too small for the FTL\r\n");
+		return NULL;
+	}
+
+	Blocks = Geo->NumBlocks - FILE_SYSTEM_NAND_FTL_START_BLOCK;
+	if (Blocks > FILE_SYSTEM_NAND_FTL_BLOCKS) {
+		Blocks = FILE_SYSTEM_NAND_FTL_BLOCKS;
+	}
+	NandFirstPage = FILE_SYSTEM_NAND_FTL_START_BLOCK * Geo->PagesPerBlock;
+
+	NandDevice.page_size = Geo->BytesPerPage;
+	NandDevice.pages_per_block = Geo->PagesPerBlock;
+	NandDevice.num_blocks = Blocks;
+	/* Rewrite pages once three quarters of the ECC strength is used */
+	NandDevice.scrub_bits = NandInstance.EccCfg.NumEccBits -
+			(NandInstance.EccCfg.NumEccBits / 4U);
+	NandDevice.read_page = nand_read_page;
+	NandDevice.read_pages = nand_read_pages;
+	NandDevice.program_page = nand_program_page;
+	NandDevice.erase_block = nand_erase_block;
+	NandDevice.is_bad = nand_is_bad;
+	NandDevice.mark_bad = nand_mark_bad;
+	NandDevice.ctx = &NandInstance;
+
+	return &NandDevice;
+}
+
+/*****************************************************************************/
+/**
+*
+* Mounts or formats the FTL volume of drive 0.
+*
+* @param	format - Non zero to format the volume
+*
+* @return	FTL_OK on success, see FTL_RESULT for the errors.
+*
+******************************************************************************/
+static FTL_RESULT disk_nand_mount (u32 format)
+{
+	const FTL_DEVICE *Dev = FtlDevice;
+	FTL_RESULT Res;
+
+	if (Dev == NULL) {
+		Dev = disk_nand_device();
+		if (Dev == NULL) {
+			return FTL_ERROR;
+		}
+	}
+
+	if (format != 0U) {
+		Res = disk_ftl_format(&FtlVolume, Dev, FtlWork, FTL_WORK_SIZE);
+	} else {
+		Res = disk_ftl_mount(&FtlVolume, Dev, FtlWork, FTL_WORK_SIZE);
+		if (Res == FTL_NO_FTL) {
+			Res = disk_ftl_format(&FtlVolume, Dev, FtlWork,
+					FTL_WORK_SIZE);
+		}
+	}
+
+	return Res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets the device of the FTL volume of a drive, to use another NAND driver or
+* a NAND simulator. The drive must be initialized again.
+*
+* @param	pdrv - Drive number, only drive 0 is supported
+* @param	*dev - Device, NULL for the NAND controller
+*
+* @return	None
+*
+******************************************************************************/
+void disk_nand_set_device (BYTE pdrv, const FTL_DEVICE *dev)
+{
+	if (pdrv == 0U) {
+		FtlDevice = dev;
+		Stat[pdrv] = STA_NOINIT;
+	}
+}
+#endif
+
 /*-----------------------------------------------------------------------*/
 /* Get Disk Status							*/
 /*-----------------------------------------------------------------------*/
@@ -148,14 +419,14 @@ DSTATUS disk_status (
 					return s;
 				}
 
-				BaseAddress = SdConfig->BaseAddress;
-				CardDetect = SdConfig->CardDetect;
-				WriteProtect = SdConfig->WriteProtect;
+				BaseAddress[pdrv] = SdConfig->BaseAddress;
+				CardDetect[pdrv] = SdConfig->CardDetect;
+				WriteProtect[pdrv] = SdConfig->WriteProtect;
 
-				HostCntrlrVer[pdrv] = (u8)(XSdPs_ReadReg16(BaseAddress,
+				HostCntrlrVer[pdrv] = (u8)(XSdPs_ReadReg16(BaseAddress[pdrv],
 						XSDPS_HOST_CTRL_VER_OFFSET) & XSDPS_HC_SPEC_VER_MASK);
 				if (HostCntrlrVer[pdrv] == XSDPS_HC_SPEC_V3) {
-					SlotType[pdrv] = XSdPs_ReadReg(BaseAddress,
+					SlotType[pdrv] = XSdPs_ReadReg(BaseAddress[pdrv],
 							XSDPS_CAPS_OFFSET) & XSDPS_CAPS_SLOT_TYPE_MASK;
 				} else {
 					SlotType[pdrv] = 0;
@@ -163,14 +434,14 @@ DSTATUS disk_status (
 		}
 
 		/* If SD is not powered up then mark it as not initialized */
-		if ((XSdPs_ReadReg8((u32)BaseAddress, XSDPS_POWER_CTRL_OFFSET) &
+		if ((XSdPs_ReadReg8((u32)BaseAddress[pdrv], XSDPS_POWER_CTRL_OFFSET) &
 			XSDPS_PC_BUS_PWR_MASK) == 0U) {
 			s |= STA_NOINIT;
 		}
 
-		StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress);
+		StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress[pdrv]);
 		if (SlotType[pdrv] != XSDPS_CAPS_EMB_SLOT) {
-			if (CardDetect) {
+			if (CardDetect[pdrv] != 0U) {
 				while ((StatusReg & XSDPS_PSR_CARD_INSRT_MASK) == 0U) {
 					if (DelayCount == 500U) {
 						s = STA_NODISK | STA_NOINIT;
@@ -179,12 +450,12 @@ DSTATUS disk_status (
 						/* Wait for 10 msec */
 						usleep(SD_CD_DELAY);
 						DelayCount++;
-						StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress);
+						StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress[pdrv]);
 					}
 				}
 			}
 			s &= ~STA_NODISK;
-			if (WriteProtect) {
+			if (WriteProtect[pdrv] != 0U) {
 					if ((StatusReg & XSDPS_PSR_WPS_PL_MASK) == 0U){
 						s |= STA_PROTECT;
 						goto Label;
@@ -246,7 +517,7 @@ DSTATUS disk_initialize (
 	}
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
-	if (CardDetect) {
+	if (CardDetect[pdrv] != 0U) {
 			/*
 			 * Card detection check
 			 * If the HC detects the No Card State, power will be cleared
@@ -254,7 +525,7 @@ DSTATUS disk_initialize (
 			while(!((XSDPS_PSR_CARD_DPL_MASK |
 					XSDPS_PSR_CARD_STABLE_MASK |
 					XSDPS_PSR_CARD_INSRT_MASK) ==
-					( XSdPs_GetPresentStatusReg((u32)BaseAddress) &
+					( XSdPs_GetPresentStatusReg((u32)BaseAddress[pdrv]) &
 					(XSDPS_PSR_CARD_DPL_MASK |
 					XSDPS_PSR_CARD_STABLE_MASK |
 					XSDPS_PSR_CARD_INSRT_MASK))));
@@ -294,6 +565,16 @@ DSTATUS disk_initialize (
 	Stat[pdrv] = s;
 #endif
 
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+	if ((pdrv != 0U) || (disk_nand_mount(0U) != FTL_OK)) {
+		s |= STA_NOINIT;
+		return s;
+	}
+
+	s &= (~STA_NOINIT);
+	Stat[pdrv] = s;
+#endif
+
 #ifdef FILE_SYSTEM_INTERFACE_RAM
 	/* Assign RAMFS address value from xparameters.h */
 	dataramfs = (char *)RAMFS_START_ADDR;
@@ -303,6 +584,13 @@ DSTATUS disk_initialize (
 	Stat[pdrv] = s;
 #endif
 
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+	if (((s & STA_NOINIT) == 0U) && (disk_cache_init(pdrv) != RES_OK)) {
+		s |= STA_NOINIT;
+		Stat[pdrv] = s;
+	}
+#endif
+
 	return s;
 }
 
@@ -337,10 +625,6 @@ DRESULT disk_read (
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status = XST_FAILURE;
-	DWORD LocSector = sector;
-#endif
 
 	s = disk_status(pdrv);
 
@@ -351,7 +635,42 @@ DRESULT disk_read (
 		return RES_PARERR;
 	}
 
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+	return disk_cache_read(pdrv, buff, sector, count);
+#else
+	return disk_read_dev(pdrv, buff, sector, count);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads the drive without going through the block cache.
+* In case of SD, it reads the SD card using ADMA2 in polled mode.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Read successful
+*		RES_ERROR	Read not successful
+*
+* @note		Drive status is checked by the caller.
+*
+******************************************************************************/
+DRESULT disk_read_dev (
+		BYTE pdrv,	/* Physical drive number (0) */
+		BYTE *buff,	/* Pointer to the data buffer to store read data */
+		DWORD sector,	/* Start sector number (LBA) */
+		UINT count	/* Sector count */
+)
+{
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	s32 Status = XST_FAILURE;
+	DWORD LocSector = sector;
+
 	/* Convert LBA to byte address if needed */
 	if ((SdInstance[pdrv].HCS) == 0U) {
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
@@ -367,10 +686,17 @@ DRESULT disk_read (
 	memcpy(buff, dataramfs + (sector * SECTORSIZE), count * SECTORSIZE);
 #endif
 
-#if !defined(FILE_SYSTEM_INTERFACE_SD) && !defined(FILE_SYSTEM_INTERFACE_RAM)
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+	return disk_ftl_read(&FtlVolume, buff, sector, count);
+#endif
+
+#if !defined(FILE_SYSTEM_INTERFACE_SD) && !defined(FILE_SYSTEM_INTERFACE_RAM) && \
+	!defined(FILE_SYSTEM_INTERFACE_NAND)
 	(void)buff;
 	(void)sector;
 #endif
+	(void)pdrv;
+	(void)count;
 
     return RES_OK;
 }
@@ -395,7 +721,11 @@ DRESULT disk_ioctl (
 
 	switch (cmd) {
 		case (BYTE)CTRL_SYNC :	/* Make sure that no pending write process */
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+			res = disk_cache_sync(pdrv);
+#else
 			res = RES_OK;
+#endif
 			break;
 
 		case (BYTE)GET_SECTOR_COUNT : /* Get number of sectors on the disk (DWORD) */
@@ -408,6 +738,14 @@ DRESULT disk_ioctl (
 			res = RES_OK;
 			break;
 
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+		case (BYTE)CTRL_CACHE_PIN : /* Pin a sector range (DWORD[2]) */
+			disk_cache_pin(pdrv, ((DWORD *)LocBuff)[0],
+					((DWORD *)LocBuff)[1]);
+			res = RES_OK;
+			break;
+#endif
+
 		default:
 			res = RES_PARERR;
 			break;
@@ -417,7 +755,11 @@ DRESULT disk_ioctl (
 #ifdef FILE_SYSTEM_INTERFACE_RAM
 	switch (cmd) {
 	case (BYTE)CTRL_SYNC:
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+		res = disk_cache_sync(pdrv);
+#else
 		res = RES_OK;
+#endif
 		break;
 	case (BYTE)GET_BLOCK_SIZE:
 		*(WORD *)buff = BLOCKSIZE;
@@ -431,13 +773,76 @@ DRESULT disk_ioctl (
 		*(DWORD *)buff = SECTORCNT;
 		res = RES_OK;
 		break;
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+	case (BYTE)CTRL_CACHE_PIN:
+		disk_cache_pin(pdrv, ((DWORD *)buff)[0], ((DWORD *)buff)[1]);
+		res = RES_OK;
+		break;
+#endif
 	default:
 		res = RES_PARERR;
 		break;
 	}
 #endif
 
-#if !defined(FILE_SYSTEM_INTERFACE_SD) && !defined(FILE_SYSTEM_INTERFACE_RAM)
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+	if (pdrv != 0U) {
+		return RES_PARERR;
+	}
+	/* Formatting is allowed on a volume which failed to mount */
+	if (cmd == (BYTE)CTRL_FORMAT) {
+		Stat[pdrv] |= STA_NOINIT;
+		if (disk_nand_mount(1U) != FTL_OK) {
+			return RES_ERROR;
+		}
+		Stat[pdrv] &= ~STA_NOINIT;
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+		return disk_cache_init(pdrv);
+#else
+		return RES_OK;
+#endif
+	}
+	if ((Stat[pdrv] & STA_NOINIT) != 0U) {
+		return RES_NOTRDY;
+	}
+
+	switch (cmd) {
+	case (BYTE)CTRL_SYNC:
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+		res = disk_cache_sync(pdrv);
+		if (res == RES_OK) {
+			res = disk_ftl_sync(&FtlVolume);
+		}
+#else
+		res = disk_ftl_sync(&FtlVolume);
+#endif
+		break;
+	case (BYTE)GET_BLOCK_SIZE:
+		*(DWORD *)buff = FtlVolume.PagesPerBlock * FtlVolume.SectorsPerPage;
+		res = RES_OK;
+		break;
+	case (BYTE)GET_SECTOR_SIZE:
+		*(WORD *)buff = (WORD)FTL_SECTOR_SIZE;
+		res = RES_OK;
+		break;
+	case (BYTE)GET_SECTOR_COUNT:
+		*(DWORD *)buff = disk_ftl_sector_count(&FtlVolume);
+		res = RES_OK;
+		break;
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+	case (BYTE)CTRL_CACHE_PIN:
+		disk_cache_pin(pdrv, ((DWORD *)buff)[0], ((DWORD *)buff)[1]);
+		res = RES_OK;
+		break;
+#endif
+	default:
+		res = RES_PARERR;
+		break;
+	}
+#endif
+
+#if !defined(FILE_SYSTEM_INTERFACE_SD) && !defined(FILE_SYSTEM_INTERFACE_RAM) && \
+	!defined(FILE_SYSTEM_INTERFACE_NAND)
 	(void)pdrv;
 	(void)cmd;
 	(void)buff;
@@ -494,10 +899,6 @@ DRESULT disk_write (
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status = XST_FAILURE;
-	DWORD LocSector = sector;
-#endif
 
 	s = disk_status(pdrv);
 	if ((s & STA_NOINIT) != 0U) {
@@ -507,7 +908,42 @@ DRESULT disk_write (
 		return RES_PARERR;
 	}
 
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+	return disk_cache_write(pdrv, buff, sector, count);
+#else
+	return disk_write_dev(pdrv, buff, sector, count);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the drive without going through the block cache.
+* In case of SD, it writes the SD card using ADMA2 in polled mode.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Sector address
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Write successful
+*		RES_ERROR	Write not successful
+*
+* @note		Drive status is checked by the caller.
+*
+******************************************************************************/
+DRESULT disk_write_dev (
+	BYTE pdrv,			/* Physical drive nmuber (0..) */
+	const BYTE *buff,	/* Data to be written */
+	DWORD sector,		/* Sector address (LBA) */
+	UINT count			/* Number of sectors to write */
+)
+{
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	s32 Status = XST_FAILURE;
+	DWORD LocSector = sector;
+
 	/* Convert LBA to byte address if needed */
 	if ((SdInstance[pdrv].HCS) == 0U) {
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
@@ -524,10 +960,17 @@ DRESULT disk_write (
 	memcpy(dataramfs + (sector * SECTORSIZE), buff, count * SECTORSIZE);
 #endif
 
-#if !defined(FILE_SYSTEM_INTERFACE_SD) && !defined(FILE_SYSTEM_INTERFACE_RAM)
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+	return disk_ftl_write(&FtlVolume, buff, sector, count);
+#endif
+
+#if !defined(FILE_SYSTEM_INTERFACE_SD) && !defined(FILE_SYSTEM_INTERFACE_RAM) && \
+	!defined(FILE_SYSTEM_INTERFACE_NAND)
 	(void)buff;
 	(void)sector;
 #endif
+	(void)pdrv;
+	(void)count;
 
 	return RES_OK;
 }
@@ -29,11 +29,19 @@
 *       mn   08/16/19 Initialize Status variables with failure values
 * 4.3   mn   02/05/20 Add support for Multi Partitions
 *       mn   04/23/20 Add partition 0 for supporting default partition
+* 4.4   mn   10/18/20 Pin the FAT in the block cache after mounting a volume
+*       mn   10/18/20 Read whole fragments directly in fast seek mode and add
+*                     f_openstream
+*       mn   10/18/20 Guard the shared open object table with its own sync
+*                     object in the thread-safe configuration
+*       mn   10/18/20 Build with the NAND interface
 ******************************************************************************/
 #include "xparameters.h"
-#if (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM)
+#if (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM) || \
+	(defined FILE_SYSTEM_INTERFACE_NAND)
 #include "ff.h"			/* Declarations of FatFs API */
 #include "diskio.h"		/* Declarations of device I/O functions */
+#include "diskcache.h"	/* Declarations of the block cache */
 #include "xil_printf.h"
 
 
@@ -449,6 +457,9 @@ static BYTE CurrVol;				/* Current drive */
 
 #if FF_FS_LOCK != 0
 static FILESEM Files[FF_FS_LOCK];	/* Open object lock semaphores */
+#if FF_FS_REENTRANT
+static FF_SYNC_t FilesSobj;		/* Sync object of Files[], shared by all volumes */
+#endif
 #endif
 
 #if FF_STR_VOLUME_ID
@@ -947,6 +958,21 @@ static void unlock_fs (
 	}
 }
 
+
+/*-----------------------------------------------------------------------*/
+/* Create the sync objects shared by all volumes                         */
+/*-----------------------------------------------------------------------*/
+static int cre_shared_syncobj (void)	/* 1:Ok, 0:Could not create (called once by ff_init_once) */
+{
+#if FF_FS_LOCK != 0
+	if (!ff_cre_syncobj(FF_VOLUMES, &FilesSobj)) return 0;	/* Open object table */
+#endif
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+	if (!disk_cache_cre_lock()) return 0;	/* Block cache */
+#endif
+	return 1;
+}
+
 #endif
 
 
@@ -962,7 +988,11 @@ static FRESULT chk_lock (	/* Check if the file can be accessed */
 )
 {
 	UINT i, be;
+	FRESULT res;
 
+#if FF_FS_REENTRANT
+	if (!ff_req_grant(FilesSobj)) return FR_TIMEOUT;
+#endif
 	/* Search open object table for the object */
 	be = 0;
 	for (i = 0; i < FF_FS_LOCK; i++) {
@@ -975,11 +1005,15 @@ static FRESULT chk_lock (	/* Check if the file can be accessed */
 		}
 	}
 	if (i == FF_FS_LOCK) {	/* The object has not been opened */
-		return (!be && acc != 2) ? FR_TOO_MANY_OPEN_FILES : FR_OK;	/* Is there a blank entry for new object? */
+		res = (!be && acc != 2) ? FR_TOO_MANY_OPEN_FILES : FR_OK;	/* Is there a blank entry for new object? */
+	} else {
+		/* The object was opened. Reject any open against writing file and all write mode open */
+		res = (acc != 0 || Files[i].ctr == 0x100) ? FR_LOCKED : FR_OK;
 	}
-
-	/* The object was opened. Reject any open against writing file and all write mode open */
-	return (acc != 0 || Files[i].ctr == 0x100) ? FR_LOCKED : FR_OK;
+#if FF_FS_REENTRANT
+	ff_rel_grant(FilesSobj);
+#endif
+	return res;
 }
 
 
@@ -987,7 +1021,13 @@ static int enq_lock (void)	/* Check if an entry is available for a new object */
 {
 	UINT i;
 
+#if FF_FS_REENTRANT
+	if (!ff_req_grant(FilesSobj)) return 0;
+#endif
 	for (i = 0; i < FF_FS_LOCK && Files[i].fs; i++) ;
+#if FF_FS_REENTRANT
+	ff_rel_grant(FilesSobj);
+#endif
 	return (i == FF_FS_LOCK) ? 0 : 1;
 }
 
@@ -997,9 +1037,12 @@ static UINT inc_lock (	/* Increment object open counter and returns its index (0
 	int acc		/* Desired access (0:Read, 1:Write, 2:Delete/Rename) */
 )
 {
-	UINT i;
+	UINT i, r = 0;
 
 
+#if FF_FS_REENTRANT
+	if (!ff_req_grant(FilesSobj)) return 0;
+#endif
 	for (i = 0; i < FF_FS_LOCK; i++) {	/* Find the object */
 		if (Files[i].fs == dp->obj.fs &&
 			Files[i].clu == dp->obj.sclust &&
@@ -1008,18 +1051,22 @@ static UINT inc_lock (	/* Increment object open counter and returns its index (0
 
 	if (i == FF_FS_LOCK) {				/* Not opened. Register it as new. */
 		for (i = 0; i < FF_FS_LOCK && Files[i].fs; i++) ;
-		if (i == FF_FS_LOCK) return 0;	/* No free entry to register (int err) */
-		Files[i].fs = dp->obj.fs;
-		Files[i].clu = dp->obj.sclust;
-		Files[i].ofs = dp->dptr;
-		Files[i].ctr = 0;
+		if (i < FF_FS_LOCK) {			/* Else no free entry to register (int err) */
+			Files[i].fs = dp->obj.fs;
+			Files[i].clu = dp->obj.sclust;
+			Files[i].ofs = dp->dptr;
+			Files[i].ctr = 0;
+		}
 	}
 
-	if (acc >= 1 && Files[i].ctr) return 0;	/* Access violation (int err) */
-
-	Files[i].ctr = acc ? 0x100 : Files[i].ctr + 1;	/* Set semaphore value */
-
-	return i + 1;	/* Index number origin from 1 */
+	if (i < FF_FS_LOCK && !(acc >= 1 && Files[i].ctr)) {	/* Else access violation (int err) */
+		Files[i].ctr = acc ? 0x100 : Files[i].ctr + 1;	/* Set semaphore value */
+		r = i + 1;	/* Index number origin from 1 */
+	}
+#if FF_FS_REENTRANT
+	ff_rel_grant(FilesSobj);
+#endif
+	return r;
 }
 
 
@@ -1032,11 +1079,17 @@ static FRESULT dec_lock (	/* Decrement object open counter */
 
 
 	if (--i < FF_FS_LOCK) {	/* Index number origin from 0 */
+#if FF_FS_REENTRANT
+		if (!ff_req_grant(FilesSobj)) return FR_TIMEOUT;
+#endif
 		n = Files[i].ctr;
 		if (n == 0x100) n = 0;		/* If write mode open, delete the entry */
 		if (n > 0) n--;				/* Decrement read mode open count */
 		Files[i].ctr = n;
 		if (n == 0) Files[i].fs = 0;	/* Delete the entry if open count gets zero */
+#if FF_FS_REENTRANT
+		ff_rel_grant(FilesSobj);
+#endif
 		res = FR_OK;
 	} else {
 		res = FR_INT_ERR;			/* Invalid index number */
@@ -1051,9 +1104,15 @@ static void clear_lock (	/* Clear lock entries of the volume */
 {
 	UINT i;
 
+#if FF_FS_REENTRANT
+	if (!ff_req_grant(FilesSobj)) return;
+#endif
 	for (i = 0; i < FF_FS_LOCK; i++) {
 		if (Files[i].fs == fs) Files[i].fs = 0;
 	}
+#if FF_FS_REENTRANT
+	ff_rel_grant(FilesSobj);
+#endif
 }
 
 #endif	/* FF_FS_LOCK != 0 */
@@ -1663,6 +1722,33 @@ static DWORD clmt_clust (	/* <2:Error, >=2:Cluster number */
 	return cl + *tbl;	/* Return the cluster number */
 }
 
+
+
+
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Get contiguous clusters from an offset with link map   */
+/*-----------------------------------------------------------------------*/
+
+static DWORD clmt_contig (	/* 0:Error, >=1:Number of clusters to the end of the fragment */
+	FIL* fp,		/* Pointer to the file object */
+	FSIZE_t ofs		/* File offset in the first cluster */
+)
+{
+	DWORD cl, ncl, *tbl;
+	FATFS *fs = fp->obj.fs;
+
+
+	tbl = fp->cltbl + 1;	/* Top of CLMT */
+	cl = (DWORD)(ofs / SS(fs) / fs->csize);	/* Cluster order from top of the file */
+	for (;;) {
+		ncl = *tbl++;			/* Number of cluters in the fragment */
+		if (ncl == 0) return 0;	/* End of table? (error) */
+		if (cl < ncl) break;	/* In this fragment? */
+		cl -= ncl; tbl++;		/* Next fragment */
+	}
+	return ncl - cl;	/* Return the remaining clusters in the fragment */
+}
+
 #endif	/* FF_USE_FASTSEEK */
 
 
@@ -3444,6 +3530,15 @@ static FRESULT find_volume (	/* FR_OK(0): successful, !=0: an error occurred */
 
 	fs->fs_type = fmt;		/* FAT sub-type */
 	fs->id = ++Fsid;		/* Volume mount ID */
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+	{
+		DWORD pin[2];
+
+		pin[0] = fs->fatbase;					/* Keep the FAT in the block cache */
+		pin[1] = fs->fsize * fs->n_fats;
+		(void)disk_ioctl(fs->pdrv, CTRL_CACHE_PIN, pin);
+	}
+#endif
 #if FF_USE_LFN == 1
 	fs->lfnbuf = LfnBuf;	/* Static LFN working buffer */
 #if FF_FS_EXFAT
@@ -3525,6 +3620,9 @@ FRESULT f_mount (
 	/* Get logical drive number */
 	vol = get_ldnumber(&rp);
 	if (vol < 0) return FR_INVALID_DRIVE;
+#if FF_FS_REENTRANT						/* Create the sync objects shared by the volumes */
+	if (!ff_init_once(cre_shared_syncobj)) return FR_INT_ERR;
+#endif
 	cfs = FatFs[vol];					/* Pointer to fs object */
 
 	if (cfs) {
@@ -3796,6 +3894,18 @@ FRESULT f_read (
 			sect += csect;
 			cc = btr / SS(fs);					/* When remaining bytes >= sector size, */
 			if (cc > 0) {						/* Read maximum contiguous sectors directly */
+#if FF_USE_FASTSEEK
+				if (fp->cltbl && csect + cc > fs->csize) {	/* Clip at the end of the fragment */
+					DWORD ncl = clmt_contig(fp, fp->fptr);
+
+					if (ncl == 0) ABORT(fs, FR_INT_ERR);
+					if (cc > FF_MAX_XFER_SECT) cc = FF_MAX_XFER_SECT;
+					if (csect + cc > ncl * fs->csize) cc = (UINT)(ncl * fs->csize) - csect;
+					if (csect + cc > fs->csize) {	/* Keep fp->clust at the cluster of the last sector */
+						fp->clust += (csect + cc - 1) / fs->csize;
+					}
+				} else
+#endif
 				if (csect + cc > fs->csize) {	/* Clip at cluster boundary */
 					cc = fs->csize - csect;
 				}
@@ -4421,6 +4531,44 @@ FRESULT f_lseek (
 
 
 
+#if FF_USE_FASTSEEK
+/*-----------------------------------------------------------------------*/
+/* Open a File for Streaming                                             */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_openstream (
+	FIL* fp,			/* Pointer to the blank file object */
+	const TCHAR* path,	/* Pointer to the file name */
+	DWORD* clmt,		/* Buffer for the cluster link map table */
+	UINT len			/* Number of items in clmt */
+)
+{
+	FRESULT res;
+
+
+	if (!clmt || len < 4) return FR_INVALID_PARAMETER;
+
+	res = f_open(fp, path, FA_READ);
+	if (res != FR_OK) return res;
+
+	/* Build the link map, f_read then transfers whole fragments directly */
+	fp->cltbl = clmt;
+	clmt[0] = len;
+	res = f_lseek(fp, CREATE_LINKMAP);
+	if (res == FR_NOT_ENOUGH_CORE) {	/* Too fragmented for the table, clmt[0] holds the required size */
+		fp->cltbl = 0;
+		res = FR_OK;
+	}
+	if (res != FR_OK) {
+		(void)f_close(fp);
+	}
+
+	return res;
+}
+#endif
+
+
+
 #if FF_FS_MINIMIZE <= 1
 /*-----------------------------------------------------------------------*/
 /* Create a Directory Object                                             */
@@ -6577,4 +6725,5 @@ FRESULT f_setcp (
 }
 #endif	/* FF_CODE_PAGE == 0 */
 
-#endif /* (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM) */
+#endif /* (defined FILE_SYSTEM_INTERFACE_SD) || (defined FILE_SYSTEM_INTERFACE_RAM) ||
+	  (defined FILE_SYSTEM_INTERFACE_NAND) */
@@ -39,6 +39,13 @@ void ff_memfree (
 
 #if FF_FS_REENTRANT	/* Mutal exclusion */
 
+#ifdef FILE_SYSTEM_OS_IS_FREERTOS
+#include "task.h"
+#else
+#include <stdlib.h>
+#include <time.h>
+#endif
+
 /*------------------------------------------------------------------------*/
 /* Create a Synchronization Object                                        */
 /*------------------------------------------------------------------------*/
@@ -47,35 +54,28 @@ void ff_memfree (
 /  When a 0 is returned, the f_mount() function fails with FR_INT_ERR.
 */
 
-//const osMutexDef_t Mutex[FF_VOLUMES];	/* CMSIS-RTOS */
-
-
 int ff_cre_syncobj (	/* 1:Function succeeded, 0:Could not create the sync object */
 	BYTE vol,			/* Corresponding volume (logical drive number) */
 	FF_SYNC_t* sobj		/* Pointer to return the created sync object */
 )
 {
-	/* Win32 */
-	*sobj = CreateMutex(NULL, FALSE, NULL);
-	return (int)(*sobj != INVALID_HANDLE_VALUE);
-
-	/* uITRON */
-//	T_CSEM csem = {TA_TPRI,1,1};
-//	*sobj = acre_sem(&csem);
-//	return (int)(*sobj > 0);
-
-	/* uC/OS-II */
-//	OS_ERR err;
-//	*sobj = OSMutexCreate(0, &err);
-//	return (int)(err == OS_NO_ERR);
+	(void)vol;
 
+#ifdef FILE_SYSTEM_OS_IS_FREERTOS
 	/* FreeRTOS */
-//	*sobj = xSemaphoreCreateMutex();
-//	return (int)(*sobj != NULL);
-
-	/* CMSIS-RTOS */
-//	*sobj = osMutexCreate(Mutex + vol);
-//	return (int)(*sobj != NULL);
+	*sobj = xSemaphoreCreateMutex();
+	return (int)(*sobj != NULL);
+#else
+	/* POSIX */
+	*sobj = malloc(sizeof(pthread_mutex_t));
+	if (*sobj == NULL) return 0;
+	if (pthread_mutex_init(*sobj, NULL) != 0) {
+		free(*sobj);
+		*sobj = NULL;
+		return 0;
+	}
+	return 1;
+#endif
 }
 
 
@@ -91,23 +91,16 @@ int ff_del_syncobj (	/* 1:Function succeeded, 0:Could not delete due to an error
 	FF_SYNC_t sobj		/* Sync object tied to the logical drive to be deleted */
 )
 {
-	/* Win32 */
-	return (int)CloseHandle(sobj);
-
-	/* uITRON */
-//	return (int)(del_sem(sobj) == E_OK);
-
-	/* uC/OS-II */
-//	OS_ERR err;
-//	OSMutexDel(sobj, OS_DEL_ALWAYS, &err);
-//	return (int)(err == OS_NO_ERR);
-
+#ifdef FILE_SYSTEM_OS_IS_FREERTOS
 	/* FreeRTOS */
-//  vSemaphoreDelete(sobj);
-//	return 1;
-
-	/* CMSIS-RTOS */
-//	return (int)(osMutexDelete(sobj) == osOK);
+	vSemaphoreDelete(sobj);
+	return 1;
+#else
+	/* POSIX */
+	if (pthread_mutex_destroy(sobj) != 0) return 0;
+	free(sobj);
+	return 1;
+#endif
 }
 
 
@@ -122,22 +115,22 @@ int ff_req_grant (	/* 1:Got a grant to access the volume, 0:Could not get a gran
 	FF_SYNC_t sobj	/* Sync object to wait */
 )
 {
-	/* Win32 */
-	return (int)(WaitForSingleObject(sobj, FF_FS_TIMEOUT) == WAIT_OBJECT_0);
-
-	/* uITRON */
-//	return (int)(wai_sem(sobj) == E_OK);
-
-	/* uC/OS-II */
-//	OS_ERR err;
-//	OSMutexPend(sobj, FF_FS_TIMEOUT, &err));
-//	return (int)(err == OS_NO_ERR);
-
+#ifdef FILE_SYSTEM_OS_IS_FREERTOS
 	/* FreeRTOS */
-//	return (int)(xSemaphoreTake(sobj, FF_FS_TIMEOUT) == pdTRUE);
-
-	/* CMSIS-RTOS */
-//	return (int)(osMutexWait(sobj, FF_FS_TIMEOUT) == osOK);
+	return (int)(xSemaphoreTake(sobj, FF_FS_TIMEOUT) == pdTRUE);
+#else
+	/* POSIX, FF_FS_TIMEOUT is in milliseconds */
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec += FF_FS_TIMEOUT / 1000;
+	ts.tv_nsec += (long)(FF_FS_TIMEOUT % 1000) * 1000000L;
+	if (ts.tv_nsec >= 1000000000L) {
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+	return (int)(pthread_mutex_timedlock(sobj, &ts) == 0);
+#endif
 }
 
 
@@ -151,21 +144,59 @@ void ff_rel_grant (
 	FF_SYNC_t sobj	/* Sync object to be signaled */
 )
 {
-	/* Win32 */
-	ReleaseMutex(sobj);
+#ifdef FILE_SYSTEM_OS_IS_FREERTOS
+	/* FreeRTOS */
+	xSemaphoreGive(sobj);
+#else
+	/* POSIX */
+	pthread_mutex_unlock(sobj);
+#endif
+}
 
-	/* uITRON */
-//	sig_sem(sobj);
 
-	/* uC/OS-II */
-//	OSMutexPost(sobj);
+/*------------------------------------------------------------------------*/
+/* Run an Initializer Once                                                */
+/*------------------------------------------------------------------------*/
+/* This function is called in f_mount() function to create the sync objects
+/  shared by all volumes. The initializer runs only once, also when several
+/  tasks mount volumes at the same time, and its result is returned to all
+/  callers. When a 0 is returned, the f_mount() function fails with
+/  FR_INT_ERR.
+*/
 
-	/* FreeRTOS */
-//	xSemaphoreGive(sobj);
+#ifndef FILE_SYSTEM_OS_IS_FREERTOS
+static int (*OnceInit)(void);
+static int OnceRes;
+static pthread_once_t OnceCtrl = PTHREAD_ONCE_INIT;
 
-	/* CMSIS-RTOS */
-//	osMutexRelease(sobj);
+static void once_run (void)
+{
+	OnceRes = OnceInit();
 }
+#endif
 
+int ff_init_once (	/* Result of the initializer */
+	int (*init)(void)	/* Initializer, the same on every call */
+)
+{
+#ifdef FILE_SYSTEM_OS_IS_FREERTOS
+	/* FreeRTOS, no task switch while the initializer runs */
+	static BYTE Done;
+	static int Res;
+
+	vTaskSuspendAll();
+	if (!Done) {
+		Res = init();
+		Done = 1;
+	}
+	(void)xTaskResumeAll();
+	return Res;
+#else
+	/* POSIX */
+	OnceInit = init;
+	if (pthread_once(&OnceCtrl, once_run) != 0) return 0;
+	return OnceRes;
 #endif
+}
 
+#endif
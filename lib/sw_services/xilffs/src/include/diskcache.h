@@ -0,0 +1,84 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file diskcache.h
+*		Block cache between the file system and the disk backend.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.4   mn   10/18/20 First release
+*
+* </pre>
+*
+******************************************************************************/
+#ifndef DISKCACHE_DEFINED
+#define DISKCACHE_DEFINED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "diskio.h"
+#include "ff.h"
+#include "xparameters.h"
+
+#ifdef FILE_SYSTEM_BLOCK_CACHE
+
+/* Number of cached sectors, split between the drives if enable_reentrant */
+#ifndef FILE_SYSTEM_CACHE_SECTORS
+#define FILE_SYSTEM_CACHE_SECTORS	128U
+#endif
+
+/* Associativity of the cache, must divide FILE_SYSTEM_CACHE_SECTORS */
+#ifndef FILE_SYSTEM_CACHE_WAYS
+#define FILE_SYSTEM_CACHE_WAYS		4U
+#endif
+
+/*
+ * Largest transfer issued by the cache in sectors. Sequential read misses
+ * fetch this many sectors ahead, dirty sectors are written back in runs of up
+ * to this many sectors, and requests of at least this size bypass the cache.
+ */
+#ifndef FILE_SYSTEM_CACHE_XFER_SECTORS
+#define FILE_SYSTEM_CACHE_XFER_SECTORS	32U
+#endif
+
+/* Cache statistics, see disk_cache_stats() */
+typedef struct {
+	DWORD ReadHits;		/* Sectors served from the cache */
+	DWORD ReadMisses;	/* Sectors read from the disk */
+	DWORD ReadAhead;	/* Sectors fetched ahead of the request */
+	DWORD WriteBacks;	/* Write transfers issued for dirty sectors */
+	DWORD WrittenSectors;	/* Dirty sectors written back */
+	DWORD Bypassed;		/* Sectors transferred around the cache */
+} DISK_CACHE_STATS;
+
+DRESULT disk_cache_init (BYTE pdrv);
+DRESULT disk_cache_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
+DRESULT disk_cache_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
+DRESULT disk_cache_sync (BYTE pdrv);
+void disk_cache_pin (BYTE pdrv, DWORD sector, DWORD count);
+void disk_cache_stats (DISK_CACHE_STATS* stats);
+#if FF_FS_REENTRANT
+int disk_cache_cre_lock (void);
+#endif
+
+#endif	/* FILE_SYSTEM_BLOCK_CACHE */
+
+/* Uncached transfers, provided by diskio.c */
+DRESULT disk_read_dev (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
+DRESULT disk_write_dev (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,202 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file diskftl.h
+*		Flash translation layer between the file system and raw NAND.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.4   mn   10/18/20 First release
+*
+* </pre>
+*
+******************************************************************************/
+#ifndef DISKFTL_DEFINED
+#define DISKFTL_DEFINED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "diskio.h"
+#include "xil_types.h"
+#include "xparameters.h"
+
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+
+/* Logical pages held in the write buffer of a volume */
+#ifndef FILE_SYSTEM_NAND_FTL_WBUF_PAGES
+#define FILE_SYSTEM_NAND_FTL_WBUF_PAGES	4U
+#endif
+
+/* Percentage of the good blocks kept out of the exported capacity */
+#ifndef FILE_SYSTEM_NAND_FTL_OVER_PROVISION
+#define FILE_SYSTEM_NAND_FTL_OVER_PROVISION	5U
+#endif
+
+/*
+ * Blocks written since the last checkpoint after which a sync writes a new
+ * checkpoint. It bounds the number of blocks scanned when mounting.
+ */
+#ifndef FILE_SYSTEM_NAND_FTL_CKPT_INTERVAL
+#define FILE_SYSTEM_NAND_FTL_CKPT_INTERVAL	16U
+#endif
+
+/*
+ * Erase count spread between the most worn block and the least worn block
+ * holding data above which static wear leveling moves the data of the least
+ * worn block.
+ */
+#ifndef FILE_SYSTEM_NAND_FTL_WL_THRESHOLD
+#define FILE_SYSTEM_NAND_FTL_WL_THRESHOLD	64U
+#endif
+
+#define FTL_SECTOR_SIZE		512U	/* Size of the sectors exported */
+#define FTL_TAG_SIZE		32U	/* Spare bytes per page used by the FTL */
+#define FTL_MAX_RUN_PAGES	16U	/* Largest page list of read_pages */
+#define FTL_MAX_CKPT_BLOCKS	16U	/* Largest checkpoint in blocks */
+#define FTL_NONE		0xFFFFFFFFU	/* No page or block */
+
+/*
+ * Size in 32 bit words of the work area of a volume managing blocks blocks of
+ * ppb pages of page_size bytes.
+ */
+#define FTL_WORK_WORDS(blocks, ppb, page_size) \
+	(((blocks) * (ppb)) + (3U * (blocks)) + \
+	 (((FILE_SYSTEM_NAND_FTL_WBUF_PAGES + 2U) * (page_size)) / 4U) + 16U)
+
+/* Results of the mount and format functions */
+typedef enum {
+	FTL_OK = 0,		/* 0: Succeeded */
+	FTL_NO_FTL,		/* 1: No checkpoint found, not formatted */
+	FTL_ERROR,		/* 2: Device error or no usable block */
+	FTL_NOT_ENOUGH_CORE,	/* 3: Work area too small for the device */
+	FTL_INVALID		/* 4: Unsupported geometry */
+} FTL_RESULT;
+
+/*
+ * NAND device managed by the FTL. Pages are numbered from the first page of
+ * the first block managed, page p of block b is b * pages_per_block + p.
+ * Every function returns 0 on success and -1 on failure unless noted.
+ */
+typedef struct {
+	void* ctx;		/* Passed to the functions */
+	u32 page_size;		/* Data bytes per page, multiple of 512 */
+	u32 pages_per_block;	/* Pages per erase block */
+	u32 num_blocks;		/* Erase blocks managed */
+	u32 scrub_bits;		/* Corrected bits from which a page is
+				   rewritten, 0 to never rewrite */
+	/*
+	 * Reads the data of a page, when data is not NULL, and the
+	 * FTL_TAG_SIZE bytes of the spare area reserved for the FTL, when
+	 * tag is not NULL. The tag is not ECC protected. Returns the number
+	 * of bits corrected in the data, -1 if the data is uncorrectable.
+	 */
+	INT (*read_page)(void* ctx, u32 page, BYTE* data, BYTE* tag);
+	/*
+	 * Reads the data of up to FTL_MAX_RUN_PAGES pages, in the order of
+	 * the list, into consecutive page buffers. Optional, NULL to read
+	 * page by page.
+	 */
+	INT (*read_pages)(void* ctx, const u32* pages, UINT count, BYTE* data);
+	/* Programs the data and the tag of an erased page */
+	INT (*program_page)(void* ctx, u32 page, const BYTE* data,
+			    const BYTE* tag);
+	INT (*erase_block)(void* ctx, u32 block);
+	/* Returns 1 if the block must not be used, 0 otherwise */
+	INT (*is_bad)(void* ctx, u32 block);
+	INT (*mark_bad)(void* ctx, u32 block);
+} FTL_DEVICE;
+
+/* FTL statistics, see disk_ftl_stats() */
+typedef struct {
+	DWORD HostPages;	/* Pages programmed for the file system */
+	DWORD GcPages;		/* Pages copied by garbage collection */
+	DWORD CkptPages;	/* Pages programmed for checkpoints */
+	DWORD Erases;		/* Blocks erased */
+	DWORD Collections;	/* Blocks reclaimed by garbage collection */
+	DWORD StaticMoves;	/* Blocks moved by static wear leveling */
+	DWORD Scrubs;		/* Pages rewritten after corrected errors */
+	DWORD Checkpoints;	/* Checkpoints written */
+	DWORD CorrectedBits;	/* Bits corrected by the device ECC */
+	DWORD ReadErrors;	/* Uncorrectable page reads */
+	DWORD ReplayPages;	/* Pages replayed by the last mount */
+	DWORD BadBlocks;	/* Blocks which are bad or were retired */
+	DWORD FreeBlocks;	/* Blocks which can be erased and written */
+	DWORD MinErase;		/* Lowest erase count of the good blocks */
+	DWORD MaxErase;		/* Highest erase count of the good blocks */
+} FTL_STATS;
+
+/* Block being written */
+typedef struct {
+	u32 Block;		/* FTL_NONE if no block is open */
+	u32 Page;		/* Next page of the block */
+} FTL_FRONT;
+
+/* Write buffer entry */
+typedef struct {
+	u32 Lpn;		/* Logical page, FTL_NONE if unused */
+	u32 Mask;		/* Sectors of the page held */
+	u32 Stamp;		/* Last write, for LRU replacement */
+	BYTE* Data;
+} FTL_WBUF;
+
+/* FTL volume, see diskftl.c */
+typedef struct {
+	const FTL_DEVICE* Dev;
+	u32 NumBlocks;
+	u32 PagesPerBlock;
+	u32 PageSize;
+	u32 SectorsPerPage;
+	u32 NumLpn;		/* Logical pages exported */
+	u32 CkptPages;		/* Pages of a checkpoint */
+	u32 CkptBlockCnt;	/* Blocks of a checkpoint */
+	u32* Map;		/* Physical page of each logical page */
+	u32* Ec;		/* Erase count of each block */
+	u32* Seq;		/* Sequence number of the first page, mount only */
+	u16* Valid;		/* Mapped pages of each block */
+	BYTE* State;		/* State of each block */
+	BYTE* GcBuf;		/* Relocation and checkpoint buffer */
+	BYTE* RdBuf;		/* Last page read */
+	u32 RdPage;		/* Physical page held by RdBuf */
+	FTL_WBUF Wbuf[FILE_SYSTEM_NAND_FTL_WBUF_PAGES];
+	u32 Clock;
+	FTL_FRONT Front[2];	/* Host and garbage collection blocks */
+	u32 NextSeq;		/* Sequence number of the next program */
+	u32 CkptSeq;		/* Sequence number of the checkpoint */
+	u32 CkptBlock[FTL_MAX_CKPT_BLOCKS];
+	u32 SinceCkpt;		/* Blocks opened since the checkpoint */
+	u32 FreeBlocks;
+	u32 MinFree;		/* Free blocks kept for collection */
+	u32 NumRetire;		/* Blocks to retire after a failure */
+	BYTE InGc;
+	FTL_STATS Stats;
+} FTL_VOLUME;
+
+FTL_RESULT disk_ftl_mount (FTL_VOLUME* vol, const FTL_DEVICE* dev, u32* work, UINT words);
+FTL_RESULT disk_ftl_format (FTL_VOLUME* vol, const FTL_DEVICE* dev, u32* work, UINT words);
+DRESULT disk_ftl_read (FTL_VOLUME* vol, BYTE* buff, DWORD sector, UINT count);
+DRESULT disk_ftl_write (FTL_VOLUME* vol, const BYTE* buff, DWORD sector, UINT count);
+DRESULT disk_ftl_sync (FTL_VOLUME* vol);
+DRESULT disk_ftl_checkpoint (FTL_VOLUME* vol);
+DWORD disk_ftl_sector_count (const FTL_VOLUME* vol);
+void disk_ftl_stats (const FTL_VOLUME* vol, FTL_STATS* stats);
+
+/* Device of a drive to use instead of the NAND controller, provided by diskio.c */
+void disk_nand_set_device (BYTE pdrv, const FTL_DEVICE* dev);
+
+#endif	/* FILE_SYSTEM_INTERFACE_NAND */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -67,6 +67,9 @@ DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 #define MMC_GET_OCR			13U	/* Get OCR */
 #define MMC_GET_SDSTAT		14U	/* Get SD status */
 
+/* Block cache specific ioctl command */
+#define CTRL_CACHE_PIN		30U	/* Pin a sector range (DWORD[2]: start, count) in the block cache */
+
 /* ATA/CF specific ioctl command */
 #define ATA_GET_REV			20U	/* Get F/W revision */
 #define ATA_GET_MODEL		21U	/* Get model name */
@@ -62,8 +62,19 @@ extern "C" {
 /* This option switches f_mkfs() function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_FASTSEEK	0
-/* This option switches fast seek function. (0:Disable or 1:Enable) */
+#ifdef FILE_SYSTEM_USE_FASTSEEK
+#define FF_USE_FASTSEEK	1	/* 1:Enable */
+#else
+#define FF_USE_FASTSEEK	0	/* 0:Disable */
+#endif
+/* This option switches fast seek function and f_openstream(). (0:Disable or
+/  1:Enable) In fast seek mode, f_read() transfers contiguous clusters of the
+/  file directly to the user buffer in one disk_read() call. */
+
+
+#define FF_MAX_XFER_SECT	4096
+/* Largest number of sectors passed to one disk_read() call in fast seek mode.
+/  The SD glue layer describes a transfer with 32 ADMA2 descriptors of 64 KB. */
 
 
 #define FF_USE_EXPAND	0
@@ -312,7 +323,11 @@ extern "C" {
 /  These options have no effect at read-only configuration (FF_FS_READONLY = 1). */
 
 
+#ifdef FILE_SYSTEM_FS_LOCK
+#define FF_FS_LOCK		FILE_SYSTEM_FS_LOCK
+#else
 #define FF_FS_LOCK		0
+#endif
 /* The option FF_FS_LOCK switches file lock function to control duplicated file open
 /  and illegal operation to open objects. This option must be 0 when FF_FS_READONLY
 /  is 1.
@@ -324,9 +339,17 @@ extern "C" {
 /      lock control is independent of re-entrancy. */
 
 
+#ifdef FILE_SYSTEM_REENTRANT
+#define FF_FS_REENTRANT	1
+#else
 #define FF_FS_REENTRANT	0
+#endif
 #define FF_FS_TIMEOUT	1000
-#define FF_SYNC_t		HANDLE
+#ifdef FILE_SYSTEM_OS_IS_FREERTOS
+#define FF_SYNC_t		SemaphoreHandle_t
+#else
+#define FF_SYNC_t		pthread_mutex_t*
+#endif
 /* The option FF_FS_REENTRANT switches the re-entrancy (thread safe) of the FatFs
 /  module itself. Note that regardless of this option, file access to different
 /  volume is always re-entrant and volume control functions, f_mount(), f_mkfs()
@@ -342,9 +365,21 @@ extern "C" {
 /  The FF_FS_TIMEOUT defines timeout period in unit of time tick.
 /  The FF_SYNC_t defines O/S dependent sync object type. e.g. HANDLE, ID, OS_EVENT*,
 /  SemaphoreHandle_t and etc. A header file for O/S definitions needs to be
-/  included somewhere in the scope of ff.h. */
+/  included somewhere in the scope of ff.h.
+/
+/  With FreeRTOS the sync object is a mutex semaphore and FF_FS_TIMEOUT is in
+/  ticks. Otherwise POSIX threads are used (e.g. host builds of the library) and
+/  FF_FS_TIMEOUT is in milliseconds.
+*/
 
-/* #include <windows.h>	// O/S definitions  */
+#if FF_FS_REENTRANT
+#ifdef FILE_SYSTEM_OS_IS_FREERTOS
+#include "FreeRTOS.h"
+#include "semphr.h"
+#else
+#include <pthread.h>
+#endif
+#endif
 
 #ifdef FILE_SYSTEM_WORD_ACCESS
 #define FF_WORD_ACCESS	1
@@ -39,6 +39,9 @@
 # 5.3   Nava  06/16/20  Modified the date format from dd/mm to mm/dd.
 # 5.3   Nava  09/16/20  Added user configurable Enable/Disable Options for
 #                       readback operations
+# 5.3   Nava  11/16/20  Added XFPGA_SECURE_CHUNK_SIZE and XFPGA_PERF_MODE
+#                       flags to tune and profile the secure Bitstream loading,
+#                       and a DRC keeping the chunks within the OCM
 #
 ##############################################################################
 
@@ -52,6 +55,19 @@ proc fpga_drc {libhandle} {
 
 	set proc_type [common::get_property IP_NAME [hsi::get_cells -hier $hw_processor]];
 
+	# The OCM Bitstream authentication keeps one chunk, which also holds the
+	# authentication certificate, followed by the hashes of the chunks of
+	# an 8 MB partition in the OCM from ocm_address.
+	set ocm_address [common::get_property CONFIG.ocm_address $libhandle]
+	set chunk_size [common::get_property CONFIG.secure_chunk_size $libhandle]
+	if {$chunk_size < 0xec0 || [expr {$chunk_size % 4}] != 0} {
+		error "secure_chunk_size must be a multiple of 4 bytes and at least 0xec0 bytes."
+	}
+	set num_chunks [expr {(0x800000 + $chunk_size - 1) / $chunk_size}]
+	set ocm_end [expr {$ocm_address + $chunk_size + $num_chunks * 48}]
+	if {$ocm_end > 0x100000000} {
+		error "secure_chunk_size is too large, the chunk buffer and the chunk hashes do not fit in the OCM from ocm_address."
+	}
 }
 
 proc xfpga_open_include_file {file_name} {
@@ -172,6 +188,18 @@ proc generate {lib_handle} {
    if {$value == true} {
        puts $conffile "#define XFPGA_READ_CONFIG_DATA"
    }
+   set value  [common::get_property CONFIG.secure_chunk_size $lib_handle]
+   puts $conffile "#define XFPGA_SECURE_CHUNK_SIZE ${value}U"
+
+   set value  [common::get_property CONFIG.perf_mode $lib_handle]
+   if {$value == true} {
+       if {$proc_type != "psu_pmu"} {
+           puts $conffile "#define XFPGA_PERF_MODE"
+       } else {
+           puts "\nperf_mode is not supported on PMU, the secure Bitstream loading is not timed."
+       }
+   }
+
    set value  [common::get_property CONFIG.debug_mode $lib_handle]
 
    if {$value == true} {
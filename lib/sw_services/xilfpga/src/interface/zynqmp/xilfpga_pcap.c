@@ -95,6 +95,9 @@
  *                     API's.
  * 5.3 Nava  09/16/20  Added user configurable Enable/Disable Options for
  *                     readback operations.
+ * 5.3 Nava  11/16/20  Made the chunk size of the OCM Bitstream
+ *                     authentication configurable and added per stage
+ *                     timing reports for the OCM and DDR authentication.
  * </pre>
  *
  * @note
@@ -102,6 +105,9 @@
  ******************************************************************************/
 /***************************** Include Files *********************************/
 #include "xilfpga.h"
+#if defined(XFPGA_SECURE_MODE) && defined(XFPGA_PERF_MODE)
+#include "xtime_l.h"
+#endif
 
 /************************** Constant Definitions *****************************/
 #ifdef __MICROBLAZE__
@@ -122,8 +128,29 @@
 #define OCM_PL_ADDR			XFPGA_OCM_ADDRESS
 #define AC_LEN				(0xEC0U)
 #define PL_PARTATION_SIZE		(0x800000U)
+#ifdef XFPGA_SECURE_CHUNK_SIZE
+#define PL_CHUNK_SIZE_BYTES		(XFPGA_SECURE_CHUNK_SIZE)
+#else
 #define PL_CHUNK_SIZE_BYTES		(1024U * 56U)
+#endif
 #define NUM_OF_PL_CHUNKS(Size)	((Size) / PL_CHUNK_SIZE_BYTES)
+#define OCM_END_ADDR			(0xFFFFFFFFU)
+/* OCM layout: the chunk buffer followed by the chunk hashes */
+#define OCM_PL_HASH_ADDR		(OCM_PL_ADDR + PL_CHUNK_SIZE_BYTES)
+#define OCM_PL_HASH_LEN			(((PL_PARTATION_SIZE + \
+					PL_CHUNK_SIZE_BYTES - 1U) / \
+					PL_CHUNK_SIZE_BYTES) * HASH_LEN)
+
+#if ((PL_CHUNK_SIZE_BYTES == 0U) || ((PL_CHUNK_SIZE_BYTES % WORD_LEN) != 0U))
+#error "The secure chunk size must be a non-zero multiple of the word length"
+#endif
+/* The chunk buffer also holds the authentication certificate */
+#if (PL_CHUNK_SIZE_BYTES < AC_LEN)
+#error "The secure chunk size must not be smaller than the authentication certificate"
+#endif
+#if ((OCM_PL_HASH_ADDR + OCM_PL_HASH_LEN - 1U) > OCM_END_ADDR)
+#error "The secure chunk buffer and the chunk hashes do not fit in the OCM from ocm_address"
+#endif
 #endif
 
 /**
@@ -164,6 +191,29 @@
 typedef u32 (*XpbrServHndlr_t) (void);
 #endif
 
+#if defined(XFPGA_SECURE_MODE) && defined(XFPGA_PERF_MODE)
+/**
+ * Time spent in each stage of a secure Bitstream load, in timer counts.
+ *
+ * @Flags Flags of the load, which select the OCM or DDR authentication
+ * @AuthTime Authentication of the partitions
+ * @CopyTime Copying the chunks into the OCM for re-authentication
+ * @HashTime Re-authentication of the chunks held in the OCM
+ * @WriteTime Writing the chunks to the PL
+ * @TotalTime Whole secure Bitstream load
+ * @NumChunks Number of chunks written to the PL
+ */
+typedef struct {
+	u32 Flags;
+	XTime AuthTime;
+	XTime CopyTime;
+	XTime HashTime;
+	XTime WriteTime;
+	XTime TotalTime;
+	u32 NumChunks;
+} XFpga_PerfInfo;
+#endif
+
 /***************** Macros (Inline Functions) Definitions *********************/
 #define ARRAY_LENGTH(array) (sizeof((array))/sizeof((array)[0]))
 #ifdef XFPGA_SECURE_READBACK_MODE
@@ -172,6 +222,15 @@ typedef u32 (*XpbrServHndlr_t) (void);
 #define XFPGA_SECURE_READBACK_MODE_EN	0U
 #endif
 
+#if defined(XFPGA_SECURE_MODE) && defined(XFPGA_PERF_MODE)
+#define XFPGA_PERF_GET_TIME(Time)	XTime_GetTime(&(Time))
+#define XFPGA_PERF_ADD_TIME(Stage, Start)	\
+		XFpga_PerfAddTime(&PerfInfo.Stage, (Start))
+#else
+#define XFPGA_PERF_GET_TIME(Time)
+#define XFPGA_PERF_ADD_TIME(Stage, Start)
+#endif
+
 /************************** Function Prototypes ******************************/
 static u32 XFpga_PcapWaitForDone(void);
 static u32 XFpga_WriteToPcap(u32 Size, UINTPTR BitstreamAddr);
@@ -221,12 +280,19 @@ static u32 XFpga_DecrptPl(XFpgaPs_PlPartition *PartitionParams,
 static u32 XFpga_DecrypSecureHdr(XSecure_Aes *InstancePtr, u64 SrcAddr);
 static u32 XFpga_AesInit(XSecure_Aes *InstancePtr, u32 *AesKupKey,
 			 u32* IvPtr, char *KeyPtr, u32 Flags);
+#ifdef XFPGA_PERF_MODE
+static void XFpga_PerfAddTime(XTime *StageTime, XTime StartTime);
+static void XFpga_PerfReport(void);
+#endif
 #endif
 #ifdef __MICROBLAZE__
 extern const XpbrServHndlr_t XpbrServHndlrTbl[XPBR_SERV_EXT_TBL_MAX];
 #endif
 /************************** Variable Definitions *****************************/
 static XCsuDma *CsuDmaPtr;
+#if defined(XFPGA_SECURE_MODE) && defined(XFPGA_PERF_MODE)
+static XFpga_PerfInfo PerfInfo;
+#endif
 
 /* Xilinx ZynqMp Vivado generated Bitstream header format */
 static const u8 VivadoBinFormat[] = {
@@ -844,9 +910,18 @@ static u32 XFpga_SecureBitstreamLoad(XFpga *InstancePtr)
 	u32 PartationOffset;
 	u32 PartationAcOffset;
 	u32 AesKupKey[XSECURE_KEY_LEN];
+#ifdef XFPGA_PERF_MODE
+	XTime PerfStart;
+#endif
+
+	XFPGA_PERF_GET_TIME(PerfStart);
 
 	/* Authenticate the PL Partation's */
 	if ( InstancePtr->PLInfo.SecureOcmState == 0U) {
+#ifdef XFPGA_PERF_MODE
+		(void)memset(&PerfInfo, 0, sizeof(PerfInfo));
+		PerfInfo.Flags = InstancePtr->WriteInfo.Flags;
+#endif
 		PartationOffset = ImageInfo->PartitionHdr->DataWordOffset
 						* XSECURE_WORD_LEN;
 		PartationAcOffset =
@@ -909,6 +984,10 @@ static u32 XFpga_SecureBitstreamLoad(XFpga *InstancePtr)
 	}
 
 END:
+	XFPGA_PERF_ADD_TIME(TotalTime, PerfStart);
+#ifdef XFPGA_PERF_MODE
+	XFpga_PerfReport();
+#endif
 	/* Clear local user key */
 	(void)memset(AesKupKey, 0U, XSECURE_KEY_LEN * XSECURE_WORD_LEN);
 	/* Zeroize the Secure data*/
@@ -939,6 +1018,11 @@ static u32 XFpga_AuthPlChunksDdrOcm(XFpga *InstancePtr, u32 Size)
 	u32 Status = XFPGA_FAILURE;
 	XFpgaPs_PlPartition *PlAesInfoPtr = &InstancePtr->PLInfo.PlAesInfo;
 	XSecure_ImageInfo *ImageInfo = &InstancePtr->PLInfo.SecureImageInfo;
+#ifdef XFPGA_PERF_MODE
+	XTime PerfStart;
+#endif
+
+	XFPGA_PERF_GET_TIME(PerfStart);
 
 	/* Copy authentication certificate to internal memory */
 	Status = XSecure_MemCopy((u8 *)AcBuf, (u8 *)InstancePtr->PLInfo.AcPtr,
@@ -967,6 +1051,8 @@ static u32 XFpga_AuthPlChunksDdrOcm(XFpga *InstancePtr, u32 Size)
 					Status);
 				goto END;
 		}
+		XFPGA_PERF_ADD_TIME(AuthTime, PerfStart);
+		XFPGA_PERF_GET_TIME(PerfStart);
 
 		if (((InstancePtr->WriteInfo.Flags &
 			XFPGA_ENCRYPTION_USERKEY_EN)!= 0U)||
@@ -979,6 +1065,7 @@ static u32 XFpga_AuthPlChunksDdrOcm(XFpga *InstancePtr, u32 Size)
 			Status = XFpga_WriteToPcap(Size/WORD_LEN,
 					InstancePtr->PLInfo.BitAddr);
 		}
+		XFPGA_PERF_ADD_TIME(WriteTime, PerfStart);
 
 		if (Status != XFPGA_SUCCESS) {
 			Status = XFPGA_PCAP_UPDATE_ERR(
@@ -994,6 +1081,7 @@ static u32 XFpga_AuthPlChunksDdrOcm(XFpga *InstancePtr, u32 Size)
 					XFPGA_ERROR_OCM_AUTH_PARTITION, Status);
 			goto END;
 		}
+		XFPGA_PERF_ADD_TIME(AuthTime, PerfStart);
 
 		Status = XFpga_ReAuthPlChunksWriteToPl(PlAesInfoPtr,
 					(UINTPTR)InstancePtr->PLInfo.BitAddr,
@@ -1040,7 +1128,7 @@ static u32 XFpga_AuthPlChunks(UINTPTR BitstreamAddr, u32 Size, UINTPTR AcAddr)
 	XSecure_Sha3 Secure_Sha3 = {0U};
 	u64 OcmAddr = OCM_PL_ADDR;
 	u32 ChunkSize;
-	u32 OcmChunkAddr = (u32)OCM_PL_ADDR + PL_CHUNK_SIZE_BYTES;
+	u32 OcmChunkAddr = (u32)OCM_PL_HASH_ADDR;
 	u32 RemainingBytes;
 	XSecure_RsaKey Key;
 	u8 *AcPtr = (u8 *)(UINTPTR)AcAddr;
@@ -1136,6 +1224,14 @@ END:
  *		- XFPGA_SUCCESS on success
  *		- Error code on failure
  *
+ * @note The copy into the OCM, the SHA3 hashing and the PCAP write all use
+ * the CSUDMA source channel, so they are done one after the other for each
+ * chunk. A chunk can not be hashed in DDR while the previous one is written
+ * from the OCM either: the hash has to cover the copy which is written to
+ * the PL. The time of each stage is reported in perf mode, the DDR
+ * authentication, selected by XFPGA_AUTHENTICATION_DDR_EN, is the faster
+ * placement when the DDR is trusted.
+ *
  *****************************************************************************/
 static u32 XFpga_ReAuthPlChunksWriteToPl(XFpgaPs_PlPartition *PlAesInfo,
 					 UINTPTR BitstreamAddr,
@@ -1145,10 +1241,13 @@ static u32 XFpga_ReAuthPlChunksWriteToPl(XFpgaPs_PlPartition *PlAesInfo,
 	XSecure_Sha3 Secure_Sha3;
 	u64 OcmAddr = OCM_PL_ADDR;
 	u32 ChunkSize;
-	u32 OcmChunkAddr = (u32)OCM_PL_ADDR + PL_CHUNK_SIZE_BYTES;
+	u32 OcmChunkAddr = (u32)OCM_PL_HASH_ADDR;
 	u32 RemainingBytes;
 	u8 Sha3Hash[HASH_LEN] = {0U};
 	UINTPTR Temp_BitstreamAddr = BitstreamAddr;
+#ifdef XFPGA_PERF_MODE
+	XTime PerfStart;
+#endif
 
 	Status = XSecure_Sha3Initialize(&Secure_Sha3, CsuDmaPtr);
 	if (Status != XST_SUCCESS) {
@@ -1165,6 +1264,7 @@ static u32 XFpga_ReAuthPlChunksWriteToPl(XFpgaPs_PlPartition *PlAesInfo,
 			ChunkSize = RemainingBytes;
 		}
 
+		XFPGA_PERF_GET_TIME(PerfStart);
 		Status = XSecure_MemCopy((u8 *)(UINTPTR)OcmAddr,
 					 (u8 *)(UINTPTR)Temp_BitstreamAddr,
 					 ChunkSize/WORD_LEN);
@@ -1172,6 +1272,9 @@ static u32 XFpga_ReAuthPlChunksWriteToPl(XFpgaPs_PlPartition *PlAesInfo,
 			Status = XFPGA_FAILURE;
 			goto END;
 		}
+		XFPGA_PERF_ADD_TIME(CopyTime, PerfStart);
+
+		XFPGA_PERF_GET_TIME(PerfStart);
 		/* Generating SHA3 hash */
 		Status = XSecure_Sha3Update(&Secure_Sha3,
 				(u8 *)(UINTPTR)OcmAddr, ChunkSize);
@@ -1192,7 +1295,9 @@ static u32 XFpga_ReAuthPlChunksWriteToPl(XFpgaPs_PlPartition *PlAesInfo,
 		if (Status == XFPGA_FAILURE) {
 			goto END;
 		}
+		XFPGA_PERF_ADD_TIME(HashTime, PerfStart);
 
+		XFPGA_PERF_GET_TIME(PerfStart);
 		if (((Flags & XFPGA_ENCRYPTION_USERKEY_EN) != 0U)
 				|| ((Flags & XFPGA_ENCRYPTION_DEVKEY_EN) != 0U)) {
 			Status = XFpga_DecrptPlChunks(PlAesInfo, OcmAddr,
@@ -1205,6 +1310,10 @@ static u32 XFpga_ReAuthPlChunksWriteToPl(XFpgaPs_PlPartition *PlAesInfo,
 			Status = XFPGA_FAILURE;
 			goto END;
 		}
+		XFPGA_PERF_ADD_TIME(WriteTime, PerfStart);
+#ifdef XFPGA_PERF_MODE
+		PerfInfo.NumChunks++;
+#endif
 
 		Temp_BitstreamAddr = Temp_BitstreamAddr + ChunkSize;
 		RemainingBytes = RemainingBytes - ChunkSize;
@@ -1808,6 +1917,59 @@ END:
 	return Status;
 }
 
+#ifdef XFPGA_PERF_MODE
+/*****************************************************************************/
+/* This function adds the time elapsed since the given start time to the
+ * time of a secure Bitstream load stage.
+ *
+ * @param StageTime is a pointer to the time of the stage
+ * @param StartTime is the time at which the stage was entered
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XFpga_PerfAddTime(XTime *StageTime, XTime StartTime)
+{
+	XTime EndTime;
+
+	XTime_GetTime(&EndTime);
+	*StageTime += EndTime - StartTime;
+}
+
+/*****************************************************************************/
+/* This function prints the time spent in each stage of the secure Bitstream
+ * load, in microseconds.
+ *
+ * @param	None
+ *
+ * @return None
+ *
+ *****************************************************************************/
+static void XFpga_PerfReport(void)
+{
+	if ((PerfInfo.Flags & XFPGA_AUTHENTICATION_DDR_EN) != 0U) {
+		xil_printf("XFpga secure load: DDR authentication\r\n");
+	} else {
+		xil_printf("XFpga secure load: OCM authentication, "
+			   "%d chunks of %d bytes\r\n",
+			   PerfInfo.NumChunks, PL_CHUNK_SIZE_BYTES);
+	}
+	xil_printf("  Authenticate %d us\r\n", (u32)((PerfInfo.AuthTime *
+		   1000000U) / COUNTS_PER_SECOND));
+	if ((PerfInfo.Flags & XFPGA_AUTHENTICATION_DDR_EN) == 0U) {
+		xil_printf("  Copy to OCM  %d us\r\n",
+			   (u32)((PerfInfo.CopyTime * 1000000U) /
+			   COUNTS_PER_SECOND));
+		xil_printf("  Re-auth      %d us\r\n",
+			   (u32)((PerfInfo.HashTime * 1000000U) /
+			   COUNTS_PER_SECOND));
+	}
+	xil_printf("  Write to PL  %d us\r\n", (u32)((PerfInfo.WriteTime *
+		   1000000U) / COUNTS_PER_SECOND));
+	xil_printf("  Total        %d us\r\n", (u32)((PerfInfo.TotalTime *
+		   1000000U) / COUNTS_PER_SECOND));
+}
+#endif
 #endif
 
 /****************************************************************************/
@@ -30,6 +30,8 @@
 *                       boot modes
 *       bm   10/14/2020 Code clean up
 *       td	 10/19/2020 MISRA C Fixes
+*       kc   10/22/2020 Added fast path for runs of Write, MaskWrite and
+*                       DmaWrite commands
 *
 * </pre>
 *
@@ -40,11 +42,33 @@
 /***************************** Include Files *********************************/
 #include "xplmi_cdo.h"
 #include "xplmi_proc.h"
+#include "xplmi_hw.h"
+#include "xplmi_dma.h"
+#include "xplmi_util.h"
+#include "xplmi_modules.h"
 #include "xil_util.h"
 
 /************************** Constant Definitions *****************************/
 #define XPLMI_CMD_LEN_TEMPBUF		(0x8U)
 
+/*
+ * The fast path skips the detailed prints of the command handlers, so it is
+ * not used with PLM_DEBUG_DETAILED
+ */
+#if !defined(PLM_DEBUG_DETAILED) && !defined(PLM_CDO_FAST_PATH_EXCLUDE)
+#define XPLMI_CDO_FAST_PATH
+#endif
+
+/* Generic module commands executed by the fast path */
+#define XPLMI_CMD_ID_MASK		(XPLMI_CMD_MODULE_ID_MASK | \
+					 XPLMI_CMD_API_ID_MASK)
+#define XPLMI_CMD_ID_MASK_WRITE		(0x102U)
+#define XPLMI_CMD_ID_WRITE		(0x103U)
+#define XPLMI_CMD_ID_DMA_WRITE		(0x105U)
+#define XPLMI_MASK_WRITE_LEN		(3U)
+#define XPLMI_WRITE_LEN			(2U)
+#define XPLMI_DMA_WRITE_ADDR_LEN	(2U)
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -394,6 +418,144 @@ END:
 	return Status;
 }
 
+#ifdef XPLMI_CDO_FAST_PATH
+/*****************************************************************************/
+/**
+ * @brief	This function scans the buffer for a run of Write, MaskWrite and
+ * DmaWrite commands which are completely available in the buffer. The run
+ * ends at the first other command, at a command with an unexpected length
+ * or at a command which continues in the next chunk.
+ *
+ * @param	BufPtr is pointer to the buffer
+ * @param	BufLen is length of the buffer
+ *
+ * @return	Length of the run in words, 0 if the buffer does not start
+ *		with a fast path command
+ *
+ *****************************************************************************/
+static u32 XPlmi_CdoScanFastCmds(const u32 *BufPtr, u32 BufLen)
+{
+	u32 Offset = 0U;
+	u32 CmdId;
+	u32 Len;
+	u32 HdrLen;
+
+	if (Modules[XPLMI_MODULE_GENERIC_ID] == NULL) {
+		goto END;
+	}
+
+	while (Offset < BufLen) {
+		CmdId = BufPtr[Offset];
+		Len = (CmdId & XPLMI_CMD_LEN_MASK) >> XPLMI_SHORT_CMD_LEN_SHIFT;
+		HdrLen = 1U;
+		switch (CmdId & XPLMI_CMD_ID_MASK) {
+		case XPLMI_CMD_ID_WRITE:
+			if (Len != XPLMI_WRITE_LEN) {
+				goto END;
+			}
+			break;
+		case XPLMI_CMD_ID_MASK_WRITE:
+			if (Len != XPLMI_MASK_WRITE_LEN) {
+				goto END;
+			}
+			break;
+		case XPLMI_CMD_ID_DMA_WRITE:
+			if (Len == XPLMI_MAX_SHORT_CMD_LEN) {
+				if ((BufLen - Offset) < XPLMI_LONG_CMD_HDR_LEN) {
+					goto END;
+				}
+				HdrLen = XPLMI_LONG_CMD_HDR_LEN;
+				Len = BufPtr[Offset + 1U];
+			}
+			if (Len <= XPLMI_DMA_WRITE_ADDR_LEN) {
+				goto END;
+			}
+			break;
+		default:
+			goto END;
+		}
+		/* Stop at a command which is not completely in the buffer */
+		if (Len > (BufLen - Offset - HdrLen)) {
+			goto END;
+		}
+		Offset += HdrLen + Len;
+	}
+
+END:
+	return Offset;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function executes a run of commands validated by
+ * XPlmi_CdoScanFastCmds. Write and MaskWrite are done in place without
+ * copying the command or looking up the handler.
+ *
+ * @param	CdoPtr is pointer to the CDO structure
+ * @param	BufPtr is pointer to the buffer
+ * @param	RunLen is length of the run in words
+ * @param	CdoOffset is offset of the run in the CDO, used in error prints
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_CdoExecFastCmds(XPlmiCdo *CdoPtr, const u32 *BufPtr,
+	u32 RunLen, u32 CdoOffset)
+{
+	int Status = XST_FAILURE;
+	const u32 *Cmd = BufPtr;
+	const u32 *End = BufPtr + RunLen;
+	const u32 *Payload;
+	u32 Len;
+	u64 DestAddr;
+	u32 CdoErr;
+
+	while (Cmd < End) {
+		switch (Cmd[0U] & XPLMI_CMD_ID_MASK) {
+		case XPLMI_CMD_ID_WRITE:
+			XPlmi_Out32(Cmd[1U], Cmd[2U]);
+			Cmd += 1U + XPLMI_WRITE_LEN;
+			break;
+		case XPLMI_CMD_ID_MASK_WRITE:
+			XPlmi_UtilRMW(Cmd[1U], Cmd[2U], Cmd[3U]);
+			Cmd += 1U + XPLMI_MASK_WRITE_LEN;
+			break;
+		default:
+			/* DmaWrite */
+			Len = (Cmd[0U] & XPLMI_CMD_LEN_MASK) >>
+				XPLMI_SHORT_CMD_LEN_SHIFT;
+			Payload = &Cmd[1U];
+			if (Len == XPLMI_MAX_SHORT_CMD_LEN) {
+				Len = Cmd[1U];
+				Payload = &Cmd[XPLMI_LONG_CMD_HDR_LEN];
+			}
+			DestAddr = ((u64)Payload[0U] << 32U) | (u64)Payload[1U];
+			Status = XPlmi_DmaXfr((u64)(UINTPTR)&Payload[2U], DestAddr,
+				Len - XPLMI_DMA_WRITE_ADDR_LEN, XPLMI_PMCDMA_0);
+			if (Status != XST_SUCCESS) {
+				XPlmi_Printf(DEBUG_GENERAL, "DMA WRITE Failed\n\r");
+				CdoPtr->Cmd.CmdId = Cmd[0U];
+				CdoErr = (u32)XPLMI_ERR_CDO_CMD +
+					(Cmd[0U] & XPLMI_ERR_CDO_CMD_MASK);
+				Status = XPlmi_UpdateStatus((XPlmiStatus_t)CdoErr,
+					Status);
+				XPlmi_Printf(DEBUG_GENERAL,
+					"CMD: 0x%08x execute failed, Processed Cdo Length 0x%0x\n\r",
+					CdoPtr->Cmd.CmdId,
+					CdoOffset + (u32)(Cmd - BufPtr));
+				goto END;
+			}
+			Cmd = Payload + Len;
+			break;
+		}
+	}
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
+#endif
+
 /*****************************************************************************/
 /**
  * @brief	This function process the CDO file.
@@ -471,8 +633,19 @@ int XPlmi_ProcessCdo(XPlmiCdo *CdoPtr)
 			Status =
 				XPlmi_CdoCmdResume(CdoPtr, BufPtr, BufLen, &Size);
 		} else {
-			Status =
-				XPlmi_CdoCmdExecute(CdoPtr, BufPtr, BufLen, &Size);
+#ifdef XPLMI_CDO_FAST_PATH
+			/* Execute a run of register writes in place */
+			Size = XPlmi_CdoScanFastCmds(BufPtr, BufLen);
+			if (Size != 0U) {
+				Status = XPlmi_CdoExecFastCmds(CdoPtr, BufPtr, Size,
+					CdoPtr->ProcessedCdoLen + CdoPtr->BufLen - BufLen);
+				CdoPtr->Cmd.DeferredError = (u8)FALSE;
+			} else
+#endif
+			{
+				Status = XPlmi_CdoCmdExecute(CdoPtr, BufPtr,
+					BufLen, &Size);
+			}
 		}
 		CdoPtr->DeferredError |= CdoPtr->Cmd.DeferredError;
 		/*
@@ -26,6 +26,7 @@
 * 1.04  kc   01/07/2020 Added MACRO to get performance number for keyhole
 * 1.05  rama 08/12/2020 Added macro to exclude STL by default
 *       bm   10/14/2020 Code clean up
+*       kc   10/22/2020 Added macro to exclude CDO fast path
 *
 * </pre>
 *
@@ -108,12 +109,17 @@ extern "C" {
  *		- PLM_QSPI_EXCLUDE QSPI code will be excluded
  *		- PLM_SD_EXCLUDE SD code will be excluded
  *		- PLM_SEM_EXCLUDE SEM code will be excluded
+ *		- PLM_CDO_FAST_PATH_EXCLUDE Runs of Write, MaskWrite and DmaWrite
+ *		  CDO commands are executed through the command handlers
+ *		  instead of in place. The fast path is also excluded with
+ *		  PLM_DEBUG_DETAILED to keep the per command prints.
  */
 //#define PLM_QSPI_EXCLUDE
 //#define PLM_SD_EXCLUDE
 //#define PLM_OSPI_EXCLUDE
 //#define PLM_USB_EXCLUDE
 //#define PLM_SEM_EXCLUDE
+//#define PLM_CDO_FAST_PATH_EXCLUDE
 /**
  * @name PLM DEBUG MODE options
  *
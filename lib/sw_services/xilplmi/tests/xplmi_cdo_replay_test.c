@@ -0,0 +1,610 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xplmi_cdo_replay_test.c
+*
+* Replay of a CDO through XPlmi_ProcessCdo against an emulated register space,
+* run on a host. The CDO is read from the file given as argument. Without
+* argument, two generated CDOs are replayed, with commands to the addresses
+* of a 4 MB register region:
+*  - a mix of Write (60%), MaskWrite (30%), short DmaWrite (5%), long
+*    DmaWrite (2%) and Nop (3%) commands;
+*  - register writes only, Write (67%) and MaskWrite (33%) commands.
+*
+* The 32 bit address space is a single region of the register IO emulation.
+* The generic module handles Write, MaskWrite and DmaWrite like the handlers
+* of xplmi_generic.c, with a DMA model which writes the words to the region.
+* The other commands of the generic module and the commands of the other
+* modules are accepted and not executed.
+*
+* The CDO is replayed in chunks of 7, 100, 4096 and XPLMI_CHUNK_SIZE bytes,
+* which covers the commands split across chunks, copied to the temporary
+* buffer and resumed. After each replay, the registers and the count of
+* register writes are compared to the ones of a reference interpreter of the
+* CDO, and the replay rate is printed in commands per second.
+*
+* The Makefile of this directory builds the test with the CDO fast path and
+* with PLM_CDO_FAST_PATH_EXCLUDE, and runs them on the build machine.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.03  kc   10/22/2020 Initial release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "xil_io_emu.h"
+#include "xplmi_cdo.h"
+#include "xplmi_dma.h"
+#include "xplmi_hw.h"
+#include "xplmi_modules.h"
+#include "xplmi_util.h"
+
+/************************** Constant Definitions *****************************/
+#define TEST_NUM_CMDS		(500000U)
+#define TEST_REG_BASE		(0xF1000000U)
+#define TEST_REG_MASK		(0x3FFFFCU)
+#define TEST_CHUNK_SIZE		(0x10000U)	/* XPLMI_CHUNK_SIZE */
+#define TEST_NUM_API_IDS	(XPLMI_CMD_API_ID_MASK + 1U)
+
+/* Ranges of the random command type of the generated CDOs */
+#define TEST_MIX_ALL		(100U)
+#define TEST_MIX_WRITES		(90U)
+
+/* Register space emulated, the 32 bit addresses but the last one */
+#define TEST_REG_SPACE_SIZE	(0xFFFFFFFCU)
+
+/* Generic module commands executed by the test */
+#define TEST_CMD_MASK_WRITE	(0x102U)
+#define TEST_CMD_WRITE		(0x103U)
+#define TEST_CMD_DMA_WRITE	(0x105U)
+#define TEST_CMD_NOP		(0x111U)
+#define TEST_CMD_ID_MASK	(XPLMI_CMD_MODULE_ID_MASK | \
+				 XPLMI_CMD_API_ID_MASK)
+
+/************************** Function Prototypes ******************************/
+static int TestMaskWrite(XPlmi_Cmd *Cmd);
+static int TestWrite(XPlmi_Cmd *Cmd);
+static int TestDmaWrite(XPlmi_Cmd *Cmd);
+static int TestSkip(XPlmi_Cmd *Cmd);
+
+/************************** Variable Definitions *****************************/
+static XPlmi_ModuleCmd GenericCmds[TEST_NUM_API_IDS];
+static XPlmi_ModuleCmd OtherCmds[TEST_NUM_API_IDS];
+static XPlmi_Module TestModules[XPLMI_MAX_MODULES];
+static Xil_EmuRegion RegSpace;
+static u32 *Regs;
+static u32 *RefRegs;
+static u32 *Cdo;
+static u32 CdoLen;
+
+/* Addresses written by the reference interpreter, with repeats */
+static u32 *RefAddrs;
+static u32 RefNumAddrs;
+static u32 RefMaxAddrs;
+static u32 RefNumCmds;
+
+static u32 Seed = 1U;
+
+/*****************************************************************************/
+/**
+ * @brief	Handlers of the generic module, like the ones of
+ * xplmi_generic.c.
+ *
+ * @param	Cmd is pointer to the command structure
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int TestMaskWrite(XPlmi_Cmd *Cmd)
+{
+	XPlmi_UtilRMW(Cmd->Payload[0U], Cmd->Payload[1U], Cmd->Payload[2U]);
+
+	return XST_SUCCESS;
+}
+
+static int TestWrite(XPlmi_Cmd *Cmd)
+{
+	XPlmi_Out32(Cmd->Payload[0U], Cmd->Payload[1U]);
+
+	return XST_SUCCESS;
+}
+
+static int TestDmaWrite(XPlmi_Cmd *Cmd)
+{
+	u64 DestAddr;
+	u64 SrcAddr;
+	u32 Len = Cmd->PayloadLen;
+	u32 DestOffset = 0U;
+
+	if (Cmd->ProcessedLen == 0U) {
+		Cmd->ResumeData[0U] = Cmd->Payload[0U];
+		Cmd->ResumeData[1U] = Cmd->Payload[1U];
+		SrcAddr = (u64)(UINTPTR) &Cmd->Payload[2U];
+		Len -= 2U;
+	} else {
+		SrcAddr = (u64)(UINTPTR) &Cmd->Payload[0U];
+		DestOffset = 2U;
+	}
+
+	DestAddr = (u64) Cmd->ResumeData[0U];
+	DestAddr = ((u64)Cmd->ResumeData[1U] | (DestAddr << 32U));
+	DestAddr += (((u64)Cmd->ProcessedLen - DestOffset) * XPLMI_WORD_LEN);
+
+	return XPlmi_DmaXfr(SrcAddr, DestAddr, Len, XPLMI_PMCDMA_0);
+}
+
+static int TestSkip(XPlmi_Cmd *Cmd)
+{
+	(void)Cmd;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	DMA model: the words are written to the emulated register space.
+ *
+ * @param	SrcAddr is the host address of the words
+ * @param	DestAddr is the register address
+ * @param	Len is the number of words
+ * @param	Flags are the DMA flags, only the incrementing transfer of
+ *		XPLMI_PMCDMA_0 is modeled
+ *
+ * @return	XST_SUCCESS on success, XST_FAILURE for a 64 bit destination
+ *
+ *****************************************************************************/
+int XPlmi_DmaXfr(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags)
+{
+	const u32 *Src = (const u32 *)(UINTPTR)SrcAddr;
+	u32 Index;
+
+	(void)Flags;
+	if ((DestAddr + ((u64)Len * XPLMI_WORD_LEN)) > TEST_REG_SPACE_SIZE) {
+		return XST_FAILURE;
+	}
+
+	for (Index = 0U; Index < Len; Index++) {
+		Xil_Out32((UINTPTR)DestAddr + (Index * XPLMI_WORD_LEN),
+			  Src[Index]);
+	}
+
+	return XST_SUCCESS;
+}
+
+static u32 Random(void)
+{
+	Seed = (Seed * 1103515245U) + 12345U;
+
+	return Seed >> 8U;
+}
+
+static u32 RandomAddr(void)
+{
+	return TEST_REG_BASE | ((Random() << 2U) & TEST_REG_MASK);
+}
+
+/*****************************************************************************/
+/**
+ * @brief	Generates a CDO replayed when no file is given.
+ *
+ * @param	Mix is TEST_MIX_ALL for all the commands, TEST_MIX_WRITES for
+ *		Write and MaskWrite commands only
+ *
+ * @return	XST_SUCCESS on success, XST_FAILURE if the memory of the CDO
+ *		can not be allocated
+ *
+ *****************************************************************************/
+static int GenerateCdo(u32 Mix)
+{
+	/* Words of the longest command: a long DmaWrite of 515 words */
+	u32 MaxLen = XPLMI_CDO_HDR_LEN + (TEST_NUM_CMDS * 519U) + 1U;
+	u32 Offset = XPLMI_CDO_HDR_LEN;
+	u32 CheckSum = 0U;
+	u32 Index;
+	u32 Cmd;
+	u32 Len;
+	u32 Type;
+
+	free(Cdo);
+	Cdo = malloc((size_t)MaxLen * XPLMI_WORD_LEN);
+	if (Cdo == NULL) {
+		return XST_FAILURE;
+	}
+
+	for (Cmd = 0U; Cmd < TEST_NUM_CMDS; Cmd++) {
+		Type = Random() % Mix;
+		if (Type < 60U) {
+			Cdo[Offset++] = (2U << XPLMI_SHORT_CMD_LEN_SHIFT) |
+				TEST_CMD_WRITE;
+			Cdo[Offset++] = RandomAddr();
+			Cdo[Offset++] = Random();
+		} else if (Type < 90U) {
+			Cdo[Offset++] = (3U << XPLMI_SHORT_CMD_LEN_SHIFT) |
+				TEST_CMD_MASK_WRITE;
+			Cdo[Offset++] = RandomAddr();
+			Cdo[Offset++] = Random();
+			Cdo[Offset++] = Random();
+		} else if (Type < 97U) {
+			if (Type < 95U) {
+				Len = (Random() % 20U) + 1U;
+				Cdo[Offset++] = ((Len + 2U) <<
+					XPLMI_SHORT_CMD_LEN_SHIFT) |
+					TEST_CMD_DMA_WRITE;
+			} else {
+				Len = (Random() % 256U) + XPLMI_MAX_SHORT_CMD_LEN;
+				Cdo[Offset++] = (XPLMI_MAX_SHORT_CMD_LEN <<
+					XPLMI_SHORT_CMD_LEN_SHIFT) |
+					TEST_CMD_DMA_WRITE;
+				Cdo[Offset++] = Len + 2U;
+			}
+			Cdo[Offset++] = 0U;
+			Cdo[Offset++] = RandomAddr();
+			for (Index = 0U; Index < Len; Index++) {
+				Cdo[Offset++] = Random();
+			}
+		} else {
+			Len = Random() % 4U;
+			Cdo[Offset++] = (Len << XPLMI_SHORT_CMD_LEN_SHIFT) |
+				TEST_CMD_NOP;
+			for (Index = 0U; Index < Len; Index++) {
+				Cdo[Offset++] = Random();
+			}
+		}
+	}
+	Cdo[Offset++] = XPLMI_CMD_END;
+
+	Cdo[0U] = XPLMI_CDO_HDR_LEN - 1U;
+	Cdo[1U] = XPLMI_CDO_HDR_IDN_WRD;
+	Cdo[2U] = 0x200U;
+	Cdo[3U] = Offset - XPLMI_CDO_HDR_LEN;
+	for (Index = 0U; Index < (XPLMI_CDO_HDR_LEN - 1U); Index++) {
+		CheckSum += Cdo[Index];
+	}
+	Cdo[4U] = ~CheckSum;
+	CdoLen = Offset;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	Reads the CDO from a file.
+ *
+ * @param	FileName is the name of the file
+ *
+ * @return	XST_SUCCESS on success, XST_FAILURE if the file can not be read
+ *
+ *****************************************************************************/
+static int ReadCdo(const char *FileName)
+{
+	int Status = XST_FAILURE;
+	FILE *File;
+	long Size;
+
+	File = fopen(FileName, "rb");
+	if (File == NULL) {
+		goto END;
+	}
+	if ((fseek(File, 0L, SEEK_END) != 0) || ((Size = ftell(File)) <
+		(long)(XPLMI_CDO_HDR_LEN * XPLMI_WORD_LEN)) ||
+		(fseek(File, 0L, SEEK_SET) != 0)) {
+		goto CLOSE;
+	}
+
+	CdoLen = (u32)(Size / XPLMI_WORD_LEN);
+	Cdo = malloc((size_t)CdoLen * XPLMI_WORD_LEN);
+	if ((Cdo != NULL) &&
+	    (fread(Cdo, XPLMI_WORD_LEN, CdoLen, File) == CdoLen)) {
+		Status = XST_SUCCESS;
+	}
+
+CLOSE:
+	(void)fclose(File);
+END:
+	return Status;
+}
+
+static int RefWrite(u32 Addr, u32 Value)
+{
+	u32 *NewAddrs;
+
+	if (Addr >= TEST_REG_SPACE_SIZE) {
+		return XST_FAILURE;
+	}
+	if (RefNumAddrs == RefMaxAddrs) {
+		RefMaxAddrs = (RefMaxAddrs * 2U) + 1024U;
+		NewAddrs = realloc(RefAddrs,
+			(size_t)RefMaxAddrs * sizeof(*RefAddrs));
+		if (NewAddrs == NULL) {
+			return XST_FAILURE;
+		}
+		RefAddrs = NewAddrs;
+	}
+	RefAddrs[RefNumAddrs++] = Addr;
+	RefRegs[Addr >> 2U] = Value;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	Reference interpreter of the CDO: applies the Write, MaskWrite
+ * and DmaWrite commands to RefRegs, and records the addresses written.
+ *
+ * @return	XST_SUCCESS on success, XST_FAILURE if a command is truncated
+ *		or writes outside the emulated register space
+ *
+ *****************************************************************************/
+static int RefReplay(void)
+{
+	int Status = XST_SUCCESS;
+	u32 End = XPLMI_CDO_HDR_LEN + Cdo[3U];
+	u32 Offset = XPLMI_CDO_HDR_LEN;
+	const u32 *Payload;
+	u32 HdrLen;
+	u32 Len;
+	u32 Index;
+
+	if (End > CdoLen) {
+		End = CdoLen;
+	}
+
+	/* Clear the registers written for the previous CDO */
+	for (Index = 0U; Index < RefNumAddrs; Index++) {
+		RefRegs[RefAddrs[Index] >> 2U] = 0U;
+		Regs[RefAddrs[Index] >> 2U] = 0U;
+	}
+	RefNumAddrs = 0U;
+	RefNumCmds = 0U;
+
+	while ((Offset < End) && (Cdo[Offset] != XPLMI_CMD_END) &&
+	       (Status == XST_SUCCESS)) {
+		Len = (Cdo[Offset] & XPLMI_CMD_LEN_MASK) >>
+			XPLMI_SHORT_CMD_LEN_SHIFT;
+		HdrLen = 1U;
+		if (Len == XPLMI_MAX_SHORT_CMD_LEN) {
+			HdrLen = XPLMI_LONG_CMD_HDR_LEN;
+			Len = Cdo[Offset + 1U];
+		}
+		if ((Offset + HdrLen + Len) > End) {
+			printf("Command 0x%08x at word %u is truncated\r\n",
+			       Cdo[Offset], Offset);
+			return XST_FAILURE;
+		}
+		Payload = &Cdo[Offset + HdrLen];
+
+		switch (Cdo[Offset] & TEST_CMD_ID_MASK) {
+		case TEST_CMD_WRITE:
+			Status = RefWrite(Payload[0U], Payload[1U]);
+			break;
+		case TEST_CMD_MASK_WRITE:
+			Status = RefWrite(Payload[0U],
+				(RefRegs[Payload[0U] >> 2U] & ~Payload[1U]) |
+				(Payload[1U] & Payload[2U]));
+			break;
+		case TEST_CMD_DMA_WRITE:
+			if (Payload[0U] != 0U) {
+				Status = XST_FAILURE;
+			}
+			for (Index = 2U; (Index < Len) &&
+			     (Status == XST_SUCCESS); Index++) {
+				Status = RefWrite(Payload[1U] +
+					((Index - 2U) * XPLMI_WORD_LEN),
+					Payload[Index]);
+			}
+			break;
+		default:
+			break;
+		}
+		if (Status != XST_SUCCESS) {
+			printf("Command 0x%08x at word %u writes outside the "
+			       "emulated registers\r\n", Cdo[Offset], Offset);
+		}
+		RefNumCmds++;
+		Offset += HdrLen + Len;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	Replays the CDO in chunks and checks the registers.
+ *
+ * @param	ChunkLen is the length of the chunks in words
+ *
+ * @return	XST_SUCCESS if the registers match the reference, XST_FAILURE
+ *		otherwise
+ *
+ *****************************************************************************/
+static int Replay(u32 ChunkLen)
+{
+	int Status;
+	XPlmiCdo CdoCtx;
+	Xil_EmuStats Stats;
+	struct timespec Start;
+	struct timespec End;
+	u64 Usec;
+	u32 Offset = 0U;
+	u32 Errors = 0U;
+	u32 Index;
+	u32 Addr;
+
+	for (Index = 0U; Index < RefNumAddrs; Index++) {
+		Regs[RefAddrs[Index] >> 2U] = 0U;
+	}
+	(void)memset(&CdoCtx, 0, sizeof(CdoCtx));
+	Status = XPlmi_InitCdo(&CdoCtx);
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+	Xil_EmuResetStats();
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &Start);
+	while ((CdoCtx.CmdEndDetected == (u8)FALSE) && (Offset < CdoLen)) {
+		CdoCtx.BufPtr = &Cdo[Offset];
+		CdoCtx.BufLen = CdoLen - Offset;
+		if (CdoCtx.BufLen > ChunkLen) {
+			CdoCtx.BufLen = ChunkLen;
+		}
+		Offset += CdoCtx.BufLen;
+		Status = XPlmi_ProcessCdo(&CdoCtx);
+		if (Status != XST_SUCCESS) {
+			printf("Chunk of %u words: processing failed with "
+			       "0x%x\r\n", ChunkLen, (u32)Status);
+			goto END;
+		}
+	}
+	(void)clock_gettime(CLOCK_MONOTONIC, &End);
+
+	Xil_EmuGetStats(&Stats);
+	if (Stats.RegWrites != RefNumAddrs) {
+		printf("Chunk of %u words: %u register writes, %u expected\r\n",
+		       ChunkLen, Stats.RegWrites, RefNumAddrs);
+		Errors++;
+	}
+	for (Index = 0U; Index < RefNumAddrs; Index++) {
+		Addr = RefAddrs[Index];
+		if (Regs[Addr >> 2U] != RefRegs[Addr >> 2U]) {
+			Errors++;
+		}
+	}
+
+	Usec = ((u64)(End.tv_sec - Start.tv_sec) * 1000000U) +
+		(u64)((End.tv_nsec - Start.tv_nsec) / 1000);
+	if (Usec == 0U) {
+		Usec = 1U;
+	}
+	printf("Chunk of %u words: %u commands in %u us, %u commands/s\r\n",
+	       ChunkLen, RefNumCmds, (u32)Usec,
+	       (u32)(((u64)RefNumCmds * 1000000U) / Usec));
+
+	if (Errors != 0U) {
+		printf("Chunk of %u words: %u registers differ from the "
+		       "reference\r\n", ChunkLen, Errors);
+		Status = XST_FAILURE;
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	Replays the CDO read or generated in all the chunk lengths.
+ *
+ * @return	XST_SUCCESS if the registers match the reference for all the
+ *		chunk lengths, XST_FAILURE otherwise
+ *
+ *****************************************************************************/
+static int ReplayCdo(void)
+{
+	static const u32 ChunkLens[] = {
+		7U, 100U, 4096U, TEST_CHUNK_SIZE / XPLMI_WORD_LEN,
+	};
+	int Status;
+	u32 Index;
+
+	Status = RefReplay();
+	if (Status != XST_SUCCESS) {
+		goto END;
+	}
+#ifdef PLM_CDO_FAST_PATH_EXCLUDE
+	printf("CDO of %u words, without the fast path\r\n", CdoLen);
+#else
+	printf("CDO of %u words, with the fast path\r\n", CdoLen);
+#endif
+
+	for (Index = 0U; Index < (sizeof(ChunkLens) / sizeof(ChunkLens[0U]));
+	     Index++) {
+		if (Replay(ChunkLens[Index]) != XST_SUCCESS) {
+			Status = XST_FAILURE;
+		}
+	}
+
+END:
+	return Status;
+}
+
+int main(int argc, char *argv[])
+{
+	int Status = XST_FAILURE;
+	u32 Index;
+
+	Regs = mmap(NULL, (size_t)TEST_REG_SPACE_SIZE, PROT_READ | PROT_WRITE,
+		    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	RefRegs = mmap(NULL, (size_t)TEST_REG_SPACE_SIZE, PROT_READ | PROT_WRITE,
+		       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if ((Regs == MAP_FAILED) || (RefRegs == MAP_FAILED) ||
+	    (Xil_EmuAddRegion(&RegSpace, "regs", 0U, TEST_REG_SPACE_SIZE,
+			      Regs) != XST_SUCCESS)) {
+		printf("The register space can not be emulated\r\n");
+		goto END;
+	}
+
+	for (Index = 0U; Index < TEST_NUM_API_IDS; Index++) {
+		GenericCmds[Index].Handler = TestSkip;
+		OtherCmds[Index].Handler = TestSkip;
+	}
+	GenericCmds[TEST_CMD_MASK_WRITE & XPLMI_CMD_API_ID_MASK].Handler =
+		TestMaskWrite;
+	GenericCmds[TEST_CMD_WRITE & XPLMI_CMD_API_ID_MASK].Handler =
+		TestWrite;
+	GenericCmds[TEST_CMD_DMA_WRITE & XPLMI_CMD_API_ID_MASK].Handler =
+		TestDmaWrite;
+	for (Index = 0U; Index < XPLMI_MAX_MODULES; Index++) {
+		TestModules[Index].Id = Index;
+		TestModules[Index].CmdAry = OtherCmds;
+		if (Index == XPLMI_MODULE_GENERIC_ID) {
+			TestModules[Index].CmdAry = GenericCmds;
+		}
+		TestModules[Index].CmdCnt = TEST_NUM_API_IDS;
+		XPlmi_ModuleRegister(&TestModules[Index]);
+	}
+
+	if (argc > 1) {
+		Status = ReadCdo(argv[1]);
+		if (Status != XST_SUCCESS) {
+			printf("The CDO can not be read\r\n");
+			goto END;
+		}
+		Status = ReplayCdo();
+		goto END;
+	}
+
+	Status = GenerateCdo(TEST_MIX_ALL);
+	if (Status == XST_SUCCESS) {
+		Status = ReplayCdo();
+	}
+	if (Status == XST_SUCCESS) {
+		Status = GenerateCdo(TEST_MIX_WRITES);
+	}
+	if (Status == XST_SUCCESS) {
+		Status = ReplayCdo();
+	}
+
+END:
+	if (Status != XST_SUCCESS) {
+		printf("CDO replay test failed\r\n");
+		return 1;
+	}
+
+	printf("Successfully ran CDO replay test\r\n");
+	return 0;
+}
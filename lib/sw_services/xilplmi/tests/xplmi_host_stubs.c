@@ -0,0 +1,87 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xplmi_host_stubs.c
+*
+* Host implementations of the PLM functions which need the PMC, shared by the
+* host tests of xilplmi and of the libraries which run in the PLM, like the
+* versal PM server. They are added to the sources of a test together with the
+* shared host stubs of the standalone BSP.
+*
+* - DebugLog disables the prints, so that the error prints of the commands a
+*   test expects to fail do not flood the output or the timings.
+* - XPlmi_PrintPlmTimeStamp() prints nothing.
+* - XPlmi_UtilRMW() is the one of xplmi_util.c, which can not be built on the
+*   host because of the 64 bit accesses of the MicroBlaze.
+* - XPlmi_PrintArray() prints nothing.
+* - XPlmi_MemSetBytes() sets host memory, with the length check of the one of
+*   xplmi_dma.c, which casts pointers to 32 bits.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date        Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.03  kc   10/22/2020 Initial release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "xplmi_dma.h"
+#include "xplmi_event_logging.h"
+#include "xplmi_hw.h"
+#include "xplmi_proc.h"
+#include "xplmi_util.h"
+
+/************************** Variable Definitions *****************************/
+XPlmi_LogInfo DebugLog;
+
+/************************** Function Definitions *****************************/
+void XPlmi_PrintPlmTimeStamp(void)
+{
+}
+
+void XPlmi_UtilRMW(u32 RegAddr, u32 Mask, u32 Value)
+{
+	u32 Val;
+
+	Val = XPlmi_In32(RegAddr);
+	Val = (Val & (~Mask)) | (Mask & Value);
+	XPlmi_Out32(RegAddr, Val);
+}
+
+void XPlmi_PrintArray (u32 DebugType, const u64 BufAddr, u32 Len, const char *Str)
+{
+	(void)DebugType;
+	(void)BufAddr;
+	(void)Len;
+	(void)Str;
+}
+
+int XPlmi_MemSetBytes(void * DestPtr, u32 DestLen, u8 Val, u32 Len)
+{
+	int Status = XST_FAILURE;
+
+	if (DestPtr == NULL) {
+		goto END;
+	}
+
+	if (Len > DestLen) {
+		(void)memset(DestPtr, Val, DestLen);
+		goto END;
+	}
+
+	(void)memset(DestPtr, Val, Len);
+	Status = XST_SUCCESS;
+
+END:
+	return Status;
+}
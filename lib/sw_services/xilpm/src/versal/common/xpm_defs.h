@@ -128,6 +128,21 @@ enum pm_query_id {
 	XPM_QID_CLOCK_GET_NUM_CLOCKS,
 	XPM_QID_CLOCK_GET_MAX_DIVISOR,
 	XPM_QID_PLD_GET_PARENT,
+	XPM_QID_MEM_POOL_STATS,
+};
+
+/**
+ * Memory pools of the PM server, queried with XPM_QID_MEM_POOL_STATS.
+ * XPM_MEM_POOL_MAX queries the statistics of the whole memory.
+ */
+enum XPmMemPoolId {
+	XPM_MEM_POOL_GENERIC,
+	XPM_MEM_POOL_SUBSYSTEM,
+	XPM_MEM_POOL_REQUIREMENT,
+	XPM_MEM_POOL_DEVICE,
+	XPM_MEM_POOL_CLOCK,
+	XPM_MEM_POOL_RESET,
+	XPM_MEM_POOL_MAX,
 };
 
 enum PmPinFunIds {
@@ -2007,6 +2007,9 @@ XStatus XPm_Query(const u32 Qid, const u32 Arg1, const u32 Arg2,
 	case (u32)XPM_QID_PLD_GET_PARENT:
 		Status = XPmPlDevice_GetParent(Arg1, Output);
 		break;
+	case (u32)XPM_QID_MEM_POOL_STATS:
+		Status = XPm_GetMemPoolStats(Arg1, Output);
+		break;
 	default:
 		Status = XST_INVALID_PARAM;
 		break;
@@ -3288,7 +3291,7 @@ static XStatus AddProcDevice(u32 *Args, u32 PowerId)
 
 	switch (Type) {
 	case (u32)XPM_NODETYPE_DEV_CORE_PSM:
-		Psm = (XPm_Psm *)XPm_AllocBytes(sizeof(XPm_Psm));
+		Psm = (XPm_Psm *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE, sizeof(XPm_Psm));
 		if (NULL == Psm) {
 			Status = XST_BUFFER_TOO_SMALL;
 			goto done;
@@ -3296,7 +3299,7 @@ static XStatus AddProcDevice(u32 *Args, u32 PowerId)
 		Status = XPmPsm_Init(Psm, Ipi, BaseAddr, Power, NULL, NULL);
 		break;
 	case (u32)XPM_NODETYPE_DEV_CORE_APU:
-		ApuCore = (XPm_ApuCore *)XPm_AllocBytes(sizeof(XPm_ApuCore));
+		ApuCore = (XPm_ApuCore *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE, sizeof(XPm_ApuCore));
 		if (NULL == ApuCore) {
 			Status = XST_BUFFER_TOO_SMALL;
 			goto done;
@@ -3304,7 +3307,7 @@ static XStatus AddProcDevice(u32 *Args, u32 PowerId)
 		Status = XPmApuCore_Init(ApuCore, DeviceId, Ipi, BaseAddr, Power, NULL, NULL);
 		break;
 	case (u32)XPM_NODETYPE_DEV_CORE_RPU:
-		RpuCore = (XPm_RpuCore *)XPm_AllocBytes(sizeof(XPm_RpuCore));
+		RpuCore = (XPm_RpuCore *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE, sizeof(XPm_RpuCore));
 		if (NULL == RpuCore) {
 			Status = XST_BUFFER_TOO_SMALL;
 			goto done;
@@ -3312,7 +3315,7 @@ static XStatus AddProcDevice(u32 *Args, u32 PowerId)
 		Status = XPmRpuCore_Init(RpuCore, DeviceId, Ipi, BaseAddr, Power, NULL, NULL);
 		break;
 	case (u32)XPM_NODETYPE_DEV_CORE_PMC:
-		Pmc = (XPm_Pmc *)XPm_AllocBytes(sizeof(XPm_Pmc));
+		Pmc = (XPm_Pmc *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE, sizeof(XPm_Pmc));
 		if (NULL == Pmc) {
 			Status = XST_BUFFER_TOO_SMALL;
 			goto done;
@@ -3363,7 +3366,7 @@ static XStatus AddPeriphDevice(u32 *Args, u32 PowerId)
 		goto done;
 	}
 
-	Device = (XPm_Periph *)XPm_AllocBytes(sizeof(XPm_Periph));
+	Device = (XPm_Periph *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE, sizeof(XPm_Periph));
 	if (NULL == Device) {
 		Status = XST_BUFFER_TOO_SMALL;
 		goto done;
@@ -3434,7 +3437,7 @@ static XStatus AddMemDevice(u32 *Args, u32 PowerId)
 	case (u32)XPM_NODETYPE_DEV_OCM_REGN:
 	case (u32)XPM_NODETYPE_DEV_DDR_REGN:
 	case (u32)XPM_NODETYPE_DEV_HBM:
-		Device = (XPm_MemDevice *)XPm_AllocBytes(sizeof(XPm_MemDevice));
+		Device = (XPm_MemDevice *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE, sizeof(XPm_MemDevice));
 		if (NULL == Device) {
 			Status = XST_BUFFER_TOO_SMALL;
 			goto done;
@@ -3478,7 +3481,7 @@ static XStatus AddMemCtrlrDevice(u32 *Args, u32 PowerId)
 	switch (Type) {
 	case (u32)XPM_NODETYPE_DEV_DDR:
 	case (u32)XPM_NODETYPE_DEV_HBM:
-		Device = (XPm_Device *)XPm_AllocBytes(sizeof(XPm_Device));
+		Device = (XPm_Device *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE, sizeof(XPm_Device));
 		if (NULL == Device) {
 			Status = XST_BUFFER_TOO_SMALL;
 			goto done;
@@ -3523,7 +3526,7 @@ static XStatus AddPhyDevice(u32 *Args, u32 PowerId)
 	switch (Type) {
 	case (u32)XPM_NODETYPE_DEV_GT:
 	case (u32)XPM_NODETYPE_DEV_VDU:
-		Device = (XPm_Device *)XPm_AllocBytes(sizeof(XPm_Device));
+		Device = (XPm_Device *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE, sizeof(XPm_Device));
 		if (NULL == Device) {
 			Status = XST_BUFFER_TOO_SMALL;
 			goto done;
@@ -3571,7 +3574,7 @@ static int AddPlDevice(u32 *Args, u32 PowerId)
 	 */
 	PlDevice = (XPm_PlDevice *)XPmDevice_GetById(DeviceId);
 	if (NULL == PlDevice) {
-		PlDevice = (XPm_PlDevice *)XPm_AllocBytes(sizeof(XPm_PlDevice));
+		PlDevice = (XPm_PlDevice *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE, sizeof(XPm_PlDevice));
 		if (NULL == PlDevice) {
 			Status = XST_BUFFER_TOO_SMALL;
 			goto done;
@@ -111,13 +111,14 @@ static XStatus XPmClock_Init(XPm_ClockNode *Clk, u32 Id, u32 ControlReg,
 		XPmNode_Init(&OutClkPtr->ClkNode.Node, Id, (u8)XPM_CLK_STATE_OFF, 0);
 		OutClkPtr->ClkNode.Node.BaseAddress = ControlReg;
 		OutClkPtr->ClkNode.ClkHandles = NULL;
+		OutClkPtr->ClkNode.AllocSubsysMask = 0U;
 		OutClkPtr->ClkNode.UseCount = 0;
 		OutClkPtr->ClkNode.NumParents = NumParents;
 		OutClkPtr->ClkNode.Flags = ClkFlags;
 		if (TopologyType == TOPOLOGY_CUSTOM) {
 			OutClkPtr->Topology.Id = TOPOLOGY_CUSTOM;
 			OutClkPtr->Topology.NumNodes = NumCustomNodes;
-			OutClkPtr->Topology.Nodes = XPm_AllocBytes((u32)NumCustomNodes * sizeof(struct XPm_ClkTopologyNode));
+			OutClkPtr->Topology.Nodes = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_CLOCK, (u32)NumCustomNodes * sizeof(struct XPm_ClkTopologyNode));
 			if (OutClkPtr->Topology.Nodes == NULL) {
 				DbgErr = XPM_INT_ERR_BUFFER_TOO_SMALL;
 				Status = XST_BUFFER_TOO_SMALL;
@@ -172,7 +173,7 @@ XStatus XPmClock_AddNode(u32 Id, u32 ControlReg, u8 TopologyType,
 		goto done;
 	}
 	if (Subclass == (u32)XPM_NODETYPE_CLOCK_REF) {
-		Clk = XPm_AllocBytes(sizeof(XPm_ClockNode));
+		Clk = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_CLOCK, sizeof(XPm_ClockNode));
 		if (Clk==NULL) {
 			DbgErr = XPM_INT_ERR_BUFFER_TOO_SMALL;
 			Status = XST_BUFFER_TOO_SMALL;
@@ -184,7 +185,7 @@ XStatus XPmClock_AddNode(u32 Id, u32 ControlReg, u8 TopologyType,
 			Status = XST_INVALID_PARAM;
 			goto done;
 		}
-		Clk = XPm_AllocBytes(sizeof(XPm_OutClockNode));
+		Clk = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_CLOCK, sizeof(XPm_OutClockNode));
 		if (Clk == NULL) {
 			DbgErr = XPM_INT_ERR_BUFFER_TOO_SMALL;
 			Status = XST_BUFFER_TOO_SMALL;
@@ -1024,12 +1025,44 @@ XStatus XPmClock_GetNumClocks(u32 *Resp)
 	return XST_SUCCESS;
 }
 
+/****************************************************************************/
+/**
+ * @brief  Rebuild the mask of subsystems which have a device of the clock
+ * allocated
+ *
+ * @param  Clk	Clock to update
+ *
+ * @return None
+ *
+ * @note   Called whenever a device of the clock is allocated or released, so
+ * that XPmClock_CheckPermissions() does not walk the devices of the clock.
+ *
+ ****************************************************************************/
+void XPmClock_UpdateSubsysMask(XPm_ClockNode *Clk)
+{
+	XPm_ClockHandle *DevHandle;
+	u32 Mask = 0U;
+
+	if (NULL == Clk) {
+		goto done;
+	}
+
+	DevHandle = Clk->ClkHandles;
+	while (NULL != DevHandle) {
+		Mask |= DevHandle->Device->AllocSubsysMask;
+		DevHandle = DevHandle->NextDevice;
+	}
+	Clk->AllocSubsysMask = Mask;
+
+done:
+	return;
+}
+
 XStatus XPmClock_CheckPermissions(u32 SubsystemIdx, u32 ClockId)
 {
 	XStatus Status = XST_FAILURE;
 	XPm_ClockNode *Clk;
-	XPm_ClockHandle *DevHandle;
-	u32 PermissionMask = 0U;
+	u32 PermissionMask;
 	u16 DbgErr = XPM_INT_ERR_UNDEFINED;
 
 	Clk = XPmClock_GetById(ClockId);
@@ -1061,18 +1094,8 @@ XStatus XPmClock_CheckPermissions(u32 SubsystemIdx, u32 ClockId)
 		goto done;
 	}
 
-	DevHandle = Clk->ClkHandles;
-	while (NULL != DevHandle) {
-		/* Get permission mask which indicates permission for each subsystem */
-		Status = XPmDevice_GetPermissions(DevHandle->Device,
-						  &PermissionMask);
-		if (XST_SUCCESS != Status) {
-			DbgErr = XPM_INT_ERR_GET_DEVICE_PERMISSION;
-			goto done;
-		}
-
-		DevHandle = DevHandle->NextDevice;
-	}
+	/* Permission mask which indicates permission for each subsystem */
+	PermissionMask = Clk->AllocSubsysMask;
 
 	/* Check permission for given subsystem */
 	if (0U == (PermissionMask & ((u32)1U << SubsystemIdx))) {
@@ -75,6 +75,7 @@ struct XPm_ClockNode {
 	XPm_ClockHandle *ClkHandles; /**< Pointer to the clock/device pairs */
 	XPm_Power *PwrDomain;
 	u32 ClkRate;
+	u32 AllocSubsysMask; /**< Subsystems a device of the clock is allocated to */
 };
 
 /**
@@ -174,6 +175,7 @@ XStatus XPmClock_QueryFFParams(u32 ClockId, u32 *Resp);
 XStatus XPmClock_QueryMuxSources(u32 ClockId, u32 Index, u32 *Resp);
 XStatus XPmClock_QueryAttributes(u32 ClockIndex, u32 *Resp);
 XStatus XPmClock_GetNumClocks(u32 *Resp);
+void XPmClock_UpdateSubsysMask(XPm_ClockNode *Clk);
 XStatus XPmClock_CheckPermissions(u32 SubsystemIdx, u32 ClockId);
 XStatus XPmClock_GetMaxDivisor(u32 ClockId, u32 DivType, u32 *Resp);
 int XPmClock_SetRate(XPm_ClockNode *Clk, const u32 ClkRate);
@@ -14,31 +14,108 @@
 
 #define MAX_BYTEBUFFER_SIZE	(32U * 1024U)
 #define NOT_INITIALIZED	0xFFFFFFFFU
+
+/*
+ * Header written into a freed block while it is on a free list. Each pool
+ * keeps one list of the sizes it has freed blocks of, and the first block of
+ * each size heads the list of all freed blocks of that size.
+ */
+typedef struct XPm_FreeBlock {
+	struct XPm_FreeBlock *Next; /* Next freed block of the same size */
+	struct XPm_FreeBlock *NextSize; /* First freed block of the next size */
+	u32 Size; /* Block size in bytes */
+} XPm_FreeBlock;
+
 static u8 ByteBuffer[MAX_BYTEBUFFER_SIZE];
 static u8 *FreeBytes = ByteBuffer;
+static XPm_FreeBlock *FreeSizes[XPM_MEM_POOL_MAX];
+static u32 FreeListBytes;
+static u32 FailedAllocs;
+static XPm_MemPoolStats PoolStats[XPM_MEM_POOL_MAX];
 static u32 Platform = NOT_INITIALIZED;
 static u32 PlatformVersion = NOT_INITIALIZED;
 static u32 SlrType = NOT_INITIALIZED;
 static u32 IdCode = NOT_INITIALIZED;
 
-void *XPm_AllocBytes(u32 Size)
+/* Round a size to a multiple of 4 which can hold the free block header */
+static u32 XPm_PoolBlockSize(u32 Size)
+{
+	u32 BlockSize = (Size + 3U) & ~0x3U;
+
+	if (BlockSize < (u32)sizeof(XPm_FreeBlock)) {
+		BlockSize = (u32)sizeof(XPm_FreeBlock);
+	}
+
+	return BlockSize;
+}
+
+/* Find the link to the first freed block of a size in a pool */
+static XPm_FreeBlock **XPm_GetFreeSize(u32 PoolId, u32 Size)
+{
+	XPm_FreeBlock **Link = &FreeSizes[PoolId];
+
+	while ((NULL != *Link) && (Size != (*Link)->Size)) {
+		Link = &(*Link)->NextSize;
+	}
+
+	return Link;
+}
+
+/****************************************************************************/
+/**
+ * @brief  Allocate zeroed memory from the PM byte buffer. A block of the same
+ * size freed to the same pool with XPm_FreePoolBytes() is reused, otherwise
+ * the memory is taken from the unused end of the buffer.
+ *
+ * @param  PoolId	Pool accounting the allocation, see XPmMemPoolId
+ * @param  Size		Size in bytes
+ *
+ * @return Pointer to the memory, NULL if there is not enough memory left
+ *
+ * @note   Each pool only holds a few object types, so the search of the
+ * freed block sizes of a pool is bounded by the number of types allocated
+ * from it. The block is then taken in constant time.
+ *
+ ****************************************************************************/
+void *XPm_AllocPoolBytes(u32 PoolId, u32 Size)
 {
 	void *Bytes = NULL;
 	u32 BytesLeft = (u32)ByteBuffer + MAX_BYTEBUFFER_SIZE - (u32)FreeBytes;
+	XPm_FreeBlock **Link;
+	XPm_FreeBlock *Block;
+	XPm_MemPoolStats *Stats;
 	u32 i;
 	u32 NumWords;
 	u32 *Words;
 
-	/* Round size to the next multiple of 4 */
-	Size += 3U;
-	Size &= ~0x3U;
-
-	if (Size > BytesLeft) {
+	if ((u32)XPM_MEM_POOL_MAX <= PoolId) {
 		goto done;
 	}
 
-	Bytes = FreeBytes;
-	FreeBytes += Size;
+	Size = XPm_PoolBlockSize(Size);
+
+	Link = XPm_GetFreeSize(PoolId, Size);
+	Block = *Link;
+	if (NULL != Block) {
+		/* The next block of this size, if any, heads the size now */
+		if (NULL != Block->Next) {
+			Block->Next->NextSize = Block->NextSize;
+			Block->Next->Size = Size;
+			*Link = Block->Next;
+		} else {
+			*Link = Block->NextSize;
+		}
+		FreeListBytes -= Size;
+		Bytes = Block;
+	} else {
+		if (Size > BytesLeft) {
+			FailedAllocs++;
+			goto done;
+		}
+
+		Bytes = FreeBytes;
+		FreeBytes += Size;
+	}
 
 	/* Zero the bytes */
 	NumWords = Size / 4U;
@@ -47,15 +124,118 @@ void *XPm_AllocBytes(u32 Size)
 		Words[i] = 0U;
 	}
 
+	Stats = &PoolStats[PoolId];
+	Stats->Allocs++;
+	Stats->InUse += Size;
+	if (Stats->InUse > Stats->Peak) {
+		Stats->Peak = Stats->InUse;
+	}
+
 done:
 	return Bytes;
 }
 
+/****************************************************************************/
+/**
+ * @brief  Return memory allocated with XPm_AllocPoolBytes() to its pool
+ *
+ * @param  PoolId	Pool the memory was allocated from
+ * @param  Bytes	Pointer to the memory
+ * @param  Size		Size in bytes as passed to XPm_AllocPoolBytes()
+ *
+ * @return None
+ *
+ ****************************************************************************/
+void XPm_FreePoolBytes(u32 PoolId, void *Bytes, u32 Size)
+{
+	XPm_FreeBlock **Link;
+	XPm_FreeBlock *Block = (XPm_FreeBlock *)Bytes;
+
+	if ((NULL == Bytes) || ((u32)XPM_MEM_POOL_MAX <= PoolId)) {
+		goto done;
+	}
+
+	Size = XPm_PoolBlockSize(Size);
+
+	PoolStats[PoolId].Frees++;
+	PoolStats[PoolId].InUse -= Size;
+
+	/* The freed block heads its size, a new size is added in front */
+	Link = XPm_GetFreeSize(PoolId, Size);
+	if (NULL != *Link) {
+		Block->Next = *Link;
+		Block->NextSize = (*Link)->NextSize;
+	} else {
+		Block->Next = NULL;
+		Block->NextSize = FreeSizes[PoolId];
+		Link = &FreeSizes[PoolId];
+	}
+	Block->Size = Size;
+	*Link = Block;
+	FreeListBytes += Size;
+
+done:
+	return;
+}
+
+void *XPm_AllocBytes(u32 Size)
+{
+	return XPm_AllocPoolBytes((u32)XPM_MEM_POOL_GENERIC, Size);
+}
+
+/****************************************************************************/
+/**
+ * @brief  Get the memory statistics of a pool or of the whole byte buffer
+ *
+ * @param  PoolId	Pool ID, XPM_MEM_POOL_MAX for the byte buffer
+ * @param  Output	Pointer to the statistics:
+ *			pool: allocated bytes, peak allocated bytes,
+ *			allocations, frees;
+ *			buffer: total bytes, high-water mark in bytes,
+ *			bytes on free lists, failed allocations
+ *
+ * @return XST_SUCCESS if successful else XST_INVALID_PARAM
+ *
+ ****************************************************************************/
+XStatus XPm_GetMemPoolStats(u32 PoolId, u32 *Output)
+{
+	XStatus Status = XST_INVALID_PARAM;
+
+	if ((u32)XPM_MEM_POOL_MAX < PoolId) {
+		goto done;
+	}
+
+	if ((u32)XPM_MEM_POOL_MAX == PoolId) {
+		Output[0] = MAX_BYTEBUFFER_SIZE;
+		Output[1] = (u32)FreeBytes - (u32)ByteBuffer;
+		Output[2] = FreeListBytes;
+		Output[3] = FailedAllocs;
+	} else {
+		Output[0] = PoolStats[PoolId].InUse;
+		Output[1] = PoolStats[PoolId].Peak;
+		Output[2] = PoolStats[PoolId].Allocs;
+		Output[3] = PoolStats[PoolId].Frees;
+	}
+	Status = XST_SUCCESS;
+
+done:
+	return Status;
+}
+
 void XPm_DumpMemUsage(void)
 {
+	u32 i;
+
 	xil_printf("Total buffer size = %d bytes\n\r", MAX_BYTEBUFFER_SIZE);
 	xil_printf("Used = %d bytes\n\r", FreeBytes - ByteBuffer);
-	xil_printf("Free = %d bytes\n\r", MAX_BYTEBUFFER_SIZE - (u32)FreeBytes - (u32)ByteBuffer);
+	xil_printf("Free = %d bytes\n\r", MAX_BYTEBUFFER_SIZE - ((u32)FreeBytes - (u32)ByteBuffer) + FreeListBytes);
+	xil_printf("Reusable = %d bytes\n\r", FreeListBytes);
+	xil_printf("Failed allocations = %d\n\r", FailedAllocs);
+	for (i = 0U; i < (u32)XPM_MEM_POOL_MAX; i++) {
+		xil_printf("Pool %d: %d bytes, peak %d bytes, %d allocs, %d frees\n\r",
+			   i, PoolStats[i].InUse, PoolStats[i].Peak,
+			   PoolStats[i].Allocs, PoolStats[i].Frees);
+	}
 	xil_printf("\n\r");
 }
 
@@ -78,7 +258,11 @@ u32 XPm_In32(u32 RegAddress)
  ****************************************************************************/
 u32 XPm_In64(u64 RegAddress)
 {
+#ifdef XIL_IO_EMULATION
+	return Xil_In32((UINTPTR)RegAddress);
+#else
 	return lwea(RegAddress);
+#endif
 }
 
 void XPm_Out32(u32 RegAddress, u32 l_Val)
@@ -133,7 +317,11 @@ void XPm_Out32(u32 RegAddress, u32 l_Val)
  ****************************************************************************/
 void XPm_Out64(u64 RegAddress, u32 Value)
 {
+#ifdef XIL_IO_EMULATION
+	Xil_Out32((UINTPTR)RegAddress, Value);
+#else
 	swea(RegAddress, Value);
+#endif
 }
 
 void XPm_RMW32(u32 RegAddress, u32 Mask, u32 Value)
@@ -12,6 +12,7 @@
 #include "xil_util.h"
 #include "xpm_err.h"
 #include "xplmi_debug.h"
+#include "xpm_defs.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -167,7 +168,20 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * Memory statistics of one pool of the PM byte buffer
+ */
+typedef struct {
+	u32 Allocs; /**< Number of allocations */
+	u32 Frees; /**< Number of frees */
+	u32 InUse; /**< Allocated bytes */
+	u32 Peak; /**< Highest number of allocated bytes */
+} XPm_MemPoolStats;
+
 void *XPm_AllocBytes(u32 Size);
+void *XPm_AllocPoolBytes(u32 PoolId, u32 Size);
+void XPm_FreePoolBytes(u32 PoolId, void *Bytes, u32 Size);
+XStatus XPm_GetMemPoolStats(u32 PoolId, u32 *Output);
 
 void XPm_Out32(u32 RegAddress, u32 l_Val);
 
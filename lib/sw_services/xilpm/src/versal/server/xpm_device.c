@@ -671,7 +671,7 @@ static XStatus HandleDeviceEvent(XPm_Node *Node, u32 Event)
 				Device->Node.Flags &= (u8)(~NODE_IDLE_DONE);
 				if (Device->WfPwrUseCnt == Device->Power->UseCount) {
 					if (1U == Device->WfDealloc) {
-						Device->PendingReqm->Allocated = 0;
+						XPmRequirement_SetAllocated(Device->PendingReqm, 0U);
 						Device->WfDealloc = 0;
 					}
 					if(Device->PendingReqm != NULL) {
@@ -827,7 +827,7 @@ static XStatus Request(XPm_Device *Device, XPm_Subsystem *Subsystem,
 	}
 
 	/* Allocated device for the subsystem */
-	Reqm->Allocated = 1U;
+	XPmRequirement_SetAllocated(Reqm, 1U);
 
 	Status = Device->DeviceOps->SetRequirement(Device, Subsystem,
 						   Capabilities, QoS);
@@ -1055,7 +1055,18 @@ XStatus XPmDevice_AddClock(XPm_Device *Device, XPm_ClockNode *Clock)
 		goto done;
 	}
 
-	ClkHandle = (XPm_ClockHandle *)XPm_AllocBytes(sizeof(XPm_ClockHandle));
+	/* Clock may already be linked if the device is initialized again */
+	ClkHandle = Device->ClkHandles;
+	while (NULL != ClkHandle) {
+		if (Clock == ClkHandle->Clock) {
+			Status = XST_SUCCESS;
+			goto done;
+		}
+		ClkHandle = ClkHandle->NextClock;
+	}
+
+	ClkHandle = (XPm_ClockHandle *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_CLOCK,
+							  sizeof(XPm_ClockHandle));
 	if (NULL == ClkHandle) {
 		Status = XST_BUFFER_TOO_SMALL;
 		goto done;
@@ -1071,6 +1082,7 @@ XStatus XPmDevice_AddClock(XPm_Device *Device, XPm_ClockNode *Clock)
 	/* Prepend the new handle to the clock's device handle list */
 	ClkHandle->NextDevice = Clock->ClkHandles;
 	Clock->ClkHandles = ClkHandle;
+	Clock->AllocSubsysMask |= Device->AllocSubsysMask;
 
 	Status = XST_SUCCESS;
 
@@ -1096,7 +1108,18 @@ XStatus XPmDevice_AddReset(XPm_Device *Device, XPm_ResetNode *Reset)
 		goto done;
 	}
 
-	RstHandle = (XPm_ResetHandle *)XPm_AllocBytes(sizeof(XPm_ResetHandle));
+	/* Reset may already be linked if the device is initialized again */
+	RstHandle = Device->RstHandles;
+	while (NULL != RstHandle) {
+		if (Reset == RstHandle->Reset) {
+			Status = XST_SUCCESS;
+			goto done;
+		}
+		RstHandle = RstHandle->NextReset;
+	}
+
+	RstHandle = (XPm_ResetHandle *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_RESET,
+							  sizeof(XPm_ResetHandle));
 	if (NULL == RstHandle) {
 		Status = XST_BUFFER_TOO_SMALL;
 		goto done;
@@ -1202,6 +1225,19 @@ int XPmDevice_CheckPermissions(XPm_Subsystem *Subsystem, u32 DeviceId)
 		goto done;
 	}
 
+	if (NULL == Subsystem) {
+		goto done;
+	}
+
+	/* Allocation mask is kept in sync by XPmRequirement_SetAllocated() */
+	if (NODEINDEX(Subsystem->Id) <= MAX_ALLOC_MASK_SUBSYS_IDX) {
+		if (0U != (Device->AllocSubsysMask &
+			   ((u32)1U << NODEINDEX(Subsystem->Id)))) {
+			Status = XST_SUCCESS;
+		}
+		goto done;
+	}
+
 	Reqm = FindReqm(Device, Subsystem);
 	if (NULL == Reqm) {
 		goto done;
@@ -1603,26 +1639,13 @@ done:
 XStatus XPmDevice_GetPermissions(XPm_Device *Device, u32 *PermissionMask)
 {
 	XStatus Status = XST_FAILURE;
-	XPm_Requirement *Reqm;
-	u32 Idx;
-	u32 MaxSubsysIdx = XPmSubsystem_GetMaxSubsysIdx();
 
 	if ((NULL == Device) || (NULL == PermissionMask)) {
 		Status = XST_INVALID_PARAM;
 		goto done;
 	}
 
-	Reqm = Device->Requirements;
-	while (NULL != Reqm) {
-		if (1U == Reqm->Allocated) {
-			for (Idx = 0; Idx <= MaxSubsysIdx; Idx++) {
-				if (Reqm->Subsystem == XPmSubsystem_GetByIndex(Idx)) {
-					*PermissionMask |= ((u32)1U << Idx);
-				}
-			}
-		}
-		Reqm = Reqm->NextSubsystem;
-	}
+	*PermissionMask |= Device->AllocSubsysMask;
 
 	Status = XST_SUCCESS;
 
@@ -33,6 +33,9 @@ extern "C" {
 #define DEVICE_NO_IDLE_REQ	(0U)
 #define DEVICE_IDLE_REQ		(1U)
 
+/* Highest subsystem index tracked in the device allocation mask */
+#define MAX_ALLOC_MASK_SUBSYS_IDX	(31U)
+
 /* Device states */
 typedef enum {
 	XPM_DEVSTATE_UNUSED,
@@ -112,6 +115,7 @@ struct XPm_DeviceNode {
 		/**< Head of the list of requirements for all subsystems */
 
 	struct XPm_Reqm *PendingReqm; /**< Requirement being updated */
+	u32 AllocSubsysMask; /**< Indexes of subsystems the device is allocated to */
 	u8 WfDealloc; /**< Deallocation is pending */
 	u8 WfPwrUseCnt; /**< Pending power use count */
 	XPm_DeviceOps *DeviceOps; /**< Device operations */
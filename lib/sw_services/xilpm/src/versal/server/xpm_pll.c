@@ -36,7 +36,7 @@ XStatus XPmClockPll_AddNode(u32 Id, u32 ControlReg, u8 TopologyType,
 		goto done;
 	}
 
-	PllClkPtr = XPm_AllocBytes(sizeof(XPm_PllClockNode));
+	PllClkPtr = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_CLOCK, sizeof(XPm_PllClockNode));
 	if (PllClkPtr == NULL) {
 		Status = XST_BUFFER_TOO_SMALL;
 		goto done;
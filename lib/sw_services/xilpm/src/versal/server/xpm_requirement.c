@@ -24,7 +24,7 @@ static XStatus XPmRequirement_Init(XPm_Requirement *Reqm,
 	Device->Requirements = Reqm;
 	Reqm->Device = Device;
 
-	Reqm->Allocated = 0;
+	XPmRequirement_SetAllocated(Reqm, 0U);
 	Reqm->SetLatReq = 0;
 
 	Reqm->Flags = (u16)(Flags & REG_FLAGS_MASK);
@@ -59,7 +59,33 @@ XStatus XPmRequirement_Add(XPm_Subsystem *Subsystem, XPm_Device *Device, u32 Fla
 	XStatus Status = XST_FAILURE;
 	XPm_Requirement *Reqm;
 
-	Reqm = (XPm_Requirement *)XPm_AllocBytes(sizeof(XPm_Requirement));
+	/*
+	 * A CDO which is loaded again, e.g. for a PL reconfiguration, adds the
+	 * same requirements again. Update the existing requirement instead of
+	 * allocating a duplicate.
+	 */
+	Reqm = Device->Requirements;
+	while (NULL != Reqm) {
+		if (Reqm->Subsystem == Subsystem) {
+			Reqm->Flags = (u16)(Flags & REG_FLAGS_MASK);
+			if ((NULL != Params) && (0U != NumParams) &&
+			    (NumParams <= MAX_REQ_PARAMS)) {
+				Status = Xil_SecureMemCpy(Reqm->Params,
+						NumParams * sizeof(*Params),
+						Params, NumParams * sizeof(*Params));
+				Reqm->NumParams = (u8)NumParams;
+			} else {
+				(void)memset(Reqm->Params, 0, sizeof(Reqm->Params));
+				Reqm->NumParams = 0;
+				Status = XST_SUCCESS;
+			}
+			goto done;
+		}
+		Reqm = Reqm->NextSubsystem;
+	}
+
+	Reqm = (XPm_Requirement *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_REQUIREMENT,
+							 sizeof(XPm_Requirement));
 	if (NULL == Reqm) {
 		Status = XST_BUFFER_TOO_SMALL;
 		goto done;
@@ -70,6 +96,55 @@ done:
 	return Status;
 }
 
+/****************************************************************************/
+/**
+ * @brief  Remove a requirement from the requirement lists of its subsystem
+ * and device and free it
+ *
+ * @param Reqm	Requirement to free
+ *
+ * @return None
+ *
+ * @note   The device must have been released by the subsystem.
+ *
+ ****************************************************************************/
+void XPmRequirement_Free(XPm_Requirement *Reqm)
+{
+	XPm_Requirement **Link;
+
+	if (NULL == Reqm) {
+		goto done;
+	}
+
+	Link = &Reqm->Subsystem->Requirements;
+	while ((NULL != *Link) && (Reqm != *Link)) {
+		Link = &(*Link)->NextDevice;
+	}
+	if (NULL != *Link) {
+		*Link = Reqm->NextDevice;
+	}
+
+	Link = &Reqm->Device->Requirements;
+	while ((NULL != *Link) && (Reqm != *Link)) {
+		Link = &(*Link)->NextSubsystem;
+	}
+	if (NULL != *Link) {
+		*Link = Reqm->NextSubsystem;
+	}
+
+	if (Reqm == Reqm->Device->PendingReqm) {
+		Reqm->Device->PendingReqm = NULL;
+	}
+
+	XPmRequirement_SetAllocated(Reqm, 0U);
+
+	XPm_FreePoolBytes((u32)XPM_MEM_POOL_REQUIREMENT, Reqm,
+			  sizeof(XPm_Requirement));
+
+done:
+	return;
+}
+
 void XPm_RequiremntUpdate(XPm_Requirement *Reqm)
 {
 	if(NULL != Reqm)
@@ -80,11 +155,61 @@ void XPm_RequiremntUpdate(XPm_Requirement *Reqm)
 	}
 }
 
+/****************************************************************************/
+/**
+ * @brief  Set or clear the allocation flag of a requirement
+ *
+ * @param Reqm		Requirement to update
+ * @param Allocated	1 if the device is allocated to the subsystem, else 0
+ *
+ * @note The device keeps a mask of the subsystem indexes it is allocated to,
+ * and each clock the combined masks of its devices, so permission checks do
+ * not have to walk the requirement or clock handle lists. All updates of the
+ * Allocated flag must go through this function to keep the masks in sync.
+ *
+ ****************************************************************************/
+void XPmRequirement_SetAllocated(XPm_Requirement *Reqm, u8 Allocated)
+{
+	u32 SubsysIdx;
+	u32 Mask;
+	XPm_ClockHandle *ClkHandle;
+
+	if (NULL == Reqm) {
+		goto done;
+	}
+
+	Reqm->Allocated = Allocated;
+
+	SubsysIdx = NODEINDEX(Reqm->Subsystem->Id);
+	if (SubsysIdx > MAX_ALLOC_MASK_SUBSYS_IDX) {
+		goto done;
+	}
+
+	Mask = Reqm->Device->AllocSubsysMask;
+	if (1U == Allocated) {
+		Reqm->Device->AllocSubsysMask |= ((u32)1U << SubsysIdx);
+	} else {
+		Reqm->Device->AllocSubsysMask &= ~((u32)1U << SubsysIdx);
+	}
+
+	/* The clocks of the device keep the masks of their devices combined */
+	if (Mask != Reqm->Device->AllocSubsysMask) {
+		ClkHandle = Reqm->Device->ClkHandles;
+		while (NULL != ClkHandle) {
+			XPmClock_UpdateSubsysMask(ClkHandle->Clock);
+			ClkHandle = ClkHandle->NextClock;
+		}
+	}
+
+done:
+	return;
+}
+
 void XPmRequirement_Clear(XPm_Requirement* Reqm)
 {
 	if(NULL != Reqm) {
 		/* Clear flag - master is not using slave anymore */
-		Reqm->Allocated = 0;
+		XPmRequirement_SetAllocated(Reqm, 0U);
 		/* Release current and next requirements */
 		Reqm->Curr.Capabilities = XPM_MIN_CAPABILITY;
 		Reqm->Curr.Latency = XPM_MAX_LATENCY;
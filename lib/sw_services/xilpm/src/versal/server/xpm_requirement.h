@@ -149,7 +149,9 @@ struct XPm_Reqm {
 XStatus XPmRequirement_Add(XPm_Subsystem *Subsystem, XPm_Device *Device, u32 Flags, u32 *Params, u32 NumParams);
 void XPm_RequiremntUpdate(XPm_Requirement *Reqm);
 XStatus XPmRequirement_Release(XPm_Requirement *Reqm, XPm_ReleaseScope Scope);
+void XPmRequirement_Free(XPm_Requirement *Reqm);
 void XPmRequirement_Clear(XPm_Requirement* Reqm);
+void XPmRequirement_SetAllocated(XPm_Requirement *Reqm, u8 Allocated);
 XStatus XPmRequirement_UpdateScheduled(XPm_Subsystem *Subsystem, u32 Swap);
 XStatus XPmRequirement_IsExclusive(XPm_Requirement *Reqm);
 
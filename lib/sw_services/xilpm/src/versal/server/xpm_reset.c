@@ -100,7 +100,7 @@ XStatus XPmReset_AddNode(u32 Id, u32 ControlReg, u8 Shift, u8 Width, u8 ResetTyp
 		goto done;
 	}
 
-	Rst = XPm_AllocBytes(sizeof(XPm_ResetNode));
+	Rst = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_RESET, sizeof(XPm_ResetNode));
 	if (Rst == NULL) {
 		DbgErr = XPM_INT_ERR_BUFFER_TOO_SMALL;
 		Status = XST_BUFFER_TOO_SMALL;
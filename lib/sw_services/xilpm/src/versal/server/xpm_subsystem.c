@@ -571,6 +571,13 @@ done:
 	return Status;
 }
 
+static void XPmSubsystem_FreeRequirements(XPm_Subsystem *Subsystem)
+{
+	while (NULL != Subsystem->Requirements) {
+		XPmRequirement_Free(Subsystem->Requirements);
+	}
+}
+
 XStatus XPmSubsystem_Add(u32 SubsystemId)
 {
 	XStatus Status = XST_FAILURE;
@@ -621,14 +628,27 @@ XStatus XPmSubsystem_Add(u32 SubsystemId)
 		goto done;
 	}
 
-	Subsystem = (XPm_Subsystem *)XPm_AllocBytes(sizeof(XPm_Subsystem));
-	if (NULL == Subsystem) {
-		DbgErr = XPM_INT_ERR_BUFFER_TOO_SMALL;
-		Status = XST_BUFFER_TOO_SMALL;
-		goto done;
+	if (NULL != Subsystem) {
+		/*
+		 * Reuse the destroyed subsystem. Notifiers registered by its
+		 * previous instance are dropped.
+		 */
+		XPmNotifier_UnregisterAll(Subsystem);
+		XPmSubsystem_FreeRequirements(Subsystem);
+		Subsystem->NotifyCb = NULL;
+	} else {
+		Subsystem = (XPm_Subsystem *)XPm_AllocPoolBytes((u32)XPM_MEM_POOL_SUBSYSTEM,
+							     sizeof(XPm_Subsystem));
+		if (NULL == Subsystem) {
+			DbgErr = XPM_INT_ERR_BUFFER_TOO_SMALL;
+			Status = XST_BUFFER_TOO_SMALL;
+			goto done;
+		}
+
+		Subsystem->NextSubsystem = PmSubsystems;
+		PmSubsystems = Subsystem;
 	}
 
-	Subsystem->NextSubsystem = PmSubsystems;
 	Subsystem->Id = SubsystemId;
 	if (PM_SUBSYS_PMC == SubsystemId) {
 		Subsystem->Flags = SUBSYSTEM_INIT_FINALIZED;
@@ -637,7 +657,6 @@ XStatus XPmSubsystem_Add(u32 SubsystemId)
 		Subsystem->Flags = 0U;
 		Subsystem->IpiMask = 0U;
 	}
-	PmSubsystems = Subsystem;
 
 	if (NODEINDEX(SubsystemId) > MaxSubsysIdx) {
 		MaxSubsysIdx = NODEINDEX(SubsystemId);
@@ -735,6 +754,13 @@ XStatus XPmSubsystem_Destroy(u32 SubsystemId)
 	}
 
 	Status = XPmSubsystem_SetState(SubsystemId, (u32)OFFLINE);
+	if (XST_SUCCESS != Status) {
+		goto done;
+	}
+
+	/* The requirements of a destroyed subsystem are not used anymore */
+	XPmSubsystem_FreeRequirements(Subsystem);
+
 done:
 	return Status;
 }
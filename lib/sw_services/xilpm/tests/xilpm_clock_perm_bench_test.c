@@ -0,0 +1,314 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*
+ *
+ * CONTENT
+ * Benchmark of the clock permission check of the versal PM server, run on a
+ * host.
+ * 1) Clocks and devices are added, each device is linked to a few clocks and
+ *    every subsystem requires a part of the devices, like at boot.
+ * 2) A trace of IPI requests is generated: device requests and releases,
+ *    which change the allocation flags, and clock control requests, which
+ *    check the permission of the subsystem for the clock.
+ * 3) The trace is replayed once with XPmClock_CheckPermissions() and once
+ *    with a reference check which walks the devices of the clock and their
+ *    requirements, like the server did before the clocks kept a subsystem
+ *    mask.
+ * The test fails if the two checks disagree for any request. It prints the
+ * time per request of both replays.
+ *
+ * The trace is synthetic: it is generated from a fixed seed so that the
+ * replays and the runs are the same.
+ *
+ * The clocks of the benchmark have no power domain and are never enabled, so
+ * the device, power and PLL functions of xpm_host_stubs.c are not reached.
+ *
+ * The test is built and run on the build machine by the Makefile of this
+ * directory.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "xpm_clock.h"
+#include "xpm_common.h"
+#include "xpm_device.h"
+#include "xpm_pll.h"
+#include "xpm_requirement.h"
+#include "xpm_subsystem.h"
+
+#define NUM_SUBSYSTEMS		8U
+#define NUM_DEVICES		96U
+#define NUM_CLOCKS		48U
+#define CLOCKS_PER_DEVICE	2U
+#define NUM_REQUESTS		200000U
+/* One request in eight is a device request or release */
+#define DEVICE_REQ_RATIO	8U
+/* One requirement in four is allocated */
+#define ALLOCATED_RATIO		4U
+#define TRACE_SEED		0x2545F491U
+
+#define BENCH_SUBSYS_ID(Idx)	(0x1C000000U + (Idx))
+#define BENCH_DEVICE_ID(Idx)	(0x18220000U + (Idx))
+#define BENCH_CLOCK_ID(Idx)	NODEID((u32)XPM_NODECLASS_CLOCK, \
+				       (u32)XPM_NODESUBCL_CLOCK_OUT, \
+				       (u32)XPM_NODETYPE_CLOCK_OUT, \
+				       (u32)XPM_NODEIDX_CLK_MIN + 1U + (Idx))
+
+typedef struct {
+	u8 IsDeviceReq;
+	u8 Allocated;
+	u16 Index;
+	u32 SubsysIdx;
+} BenchRequest;
+
+static XPm_Subsystem *Subsystems[NUM_SUBSYSTEMS];
+static XPm_Device *Devices[NUM_DEVICES];
+static XPm_Requirement *Reqms[NUM_SUBSYSTEMS * NUM_DEVICES];
+static u32 NumReqms;
+static BenchRequest Trace[NUM_REQUESTS];
+static u8 Granted[NUM_REQUESTS];
+static u8 InitAllocated[NUM_SUBSYSTEMS * NUM_DEVICES];
+
+static u32 NextRandom(u32 *Seed)
+{
+	*Seed = (*Seed * 1664525U) + 1013904223U;
+	return *Seed >> 8U;
+}
+
+/* Links a clock to a device the same way as XPmDevice_AddClock() */
+static XStatus LinkClock(XPm_Device *Device, XPm_ClockNode *Clock)
+{
+	XStatus Status = XST_FAILURE;
+	XPm_ClockHandle *ClkHandle;
+
+	ClkHandle = Device->ClkHandles;
+	while (NULL != ClkHandle) {
+		if (Clock == ClkHandle->Clock) {
+			Status = XST_SUCCESS;
+			goto done;
+		}
+		ClkHandle = ClkHandle->NextClock;
+	}
+
+	ClkHandle = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_CLOCK,
+				       sizeof(XPm_ClockHandle));
+	if (NULL == ClkHandle) {
+		goto done;
+	}
+	ClkHandle->Clock = Clock;
+	ClkHandle->Device = Device;
+	ClkHandle->NextClock = Device->ClkHandles;
+	Device->ClkHandles = ClkHandle;
+	ClkHandle->NextDevice = Clock->ClkHandles;
+	Clock->ClkHandles = ClkHandle;
+	Clock->AllocSubsysMask |= Device->AllocSubsysMask;
+	Status = XST_SUCCESS;
+
+done:
+	return Status;
+}
+
+static XStatus AddTopology(void)
+{
+	XStatus Status = XST_FAILURE;
+	XPm_Requirement *Reqm;
+	u32 Seed = TRACE_SEED;
+	u32 i, j;
+
+	for (i = 0U; i < NUM_CLOCKS; i++) {
+		Status = XPmClock_AddNode(BENCH_CLOCK_ID(i), 0U,
+					  (u8)TOPOLOGY_GENERIC_MUX_DIV, 0U, 1U,
+					  0U, 0U);
+		if (XST_SUCCESS != Status) {
+			goto done;
+		}
+	}
+
+	for (i = 0U; i < NUM_DEVICES; i++) {
+		Devices[i] = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE,
+						sizeof(XPm_Device));
+		if (NULL == Devices[i]) {
+			Status = XST_FAILURE;
+			goto done;
+		}
+		Devices[i]->Node.Id = BENCH_DEVICE_ID(i);
+		for (j = 0U; j < CLOCKS_PER_DEVICE; j++) {
+			Status = LinkClock(Devices[i], XPmClock_GetById(
+				BENCH_CLOCK_ID(NextRandom(&Seed) % NUM_CLOCKS)));
+			if (XST_SUCCESS != Status) {
+				goto done;
+			}
+		}
+	}
+
+	for (i = 0U; i < NUM_SUBSYSTEMS; i++) {
+		Subsystems[i] = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_SUBSYSTEM,
+						   sizeof(XPm_Subsystem));
+		if (NULL == Subsystems[i]) {
+			Status = XST_FAILURE;
+			goto done;
+		}
+		Subsystems[i]->Id = BENCH_SUBSYS_ID(i);
+	}
+
+	/* Every device is required by one to three subsystems */
+	for (i = 0U; i < NUM_DEVICES; i++) {
+		for (j = 0U; j <= (NextRandom(&Seed) % 3U); j++) {
+			Status = XPmRequirement_Add(
+				Subsystems[NextRandom(&Seed) % NUM_SUBSYSTEMS],
+				Devices[i], 0U, NULL, 0U);
+			if (XST_SUCCESS != Status) {
+				goto done;
+			}
+		}
+	}
+
+	NumReqms = 0U;
+	for (i = 0U; i < NUM_SUBSYSTEMS; i++) {
+		Reqm = Subsystems[i]->Requirements;
+		while (NULL != Reqm) {
+			InitAllocated[NumReqms] =
+				(u8)(0U == (NextRandom(&Seed) % ALLOCATED_RATIO));
+			XPmRequirement_SetAllocated(Reqm, InitAllocated[NumReqms]);
+			Reqms[NumReqms] = Reqm;
+			NumReqms++;
+			Reqm = Reqm->NextDevice;
+		}
+	}
+	Status = XST_SUCCESS;
+
+done:
+	return Status;
+}
+
+static void GenerateTrace(void)
+{
+	u32 Seed = TRACE_SEED ^ 0xFFFFFFFFU;
+	u32 i;
+
+	for (i = 0U; i < NUM_REQUESTS; i++) {
+		Trace[i].IsDeviceReq =
+			(u8)(0U == (NextRandom(&Seed) % DEVICE_REQ_RATIO));
+		if (0U != Trace[i].IsDeviceReq) {
+			Trace[i].Index = (u16)(NextRandom(&Seed) % NumReqms);
+			Trace[i].Allocated =
+				(u8)(0U == (NextRandom(&Seed) % ALLOCATED_RATIO));
+		} else {
+			Trace[i].Index = (u16)(NextRandom(&Seed) % NUM_CLOCKS);
+			Trace[i].SubsysIdx = NextRandom(&Seed) % NUM_SUBSYSTEMS;
+		}
+	}
+}
+
+static void ResetAllocation(void)
+{
+	u32 i;
+
+	for (i = 0U; i < NumReqms; i++) {
+		XPmRequirement_SetAllocated(Reqms[i], InitAllocated[i]);
+	}
+}
+
+/* Permission check as done before the clocks kept a subsystem mask */
+static u8 ReferenceCheck(u32 SubsystemIdx, u32 ClockId)
+{
+	XPm_ClockNode *Clk = XPmClock_GetById(ClockId);
+	XPm_ClockHandle *DevHandle;
+	XPm_Requirement *Reqm;
+	u32 PermissionMask = 0U;
+	u32 Idx;
+
+	DevHandle = Clk->ClkHandles;
+	while (NULL != DevHandle) {
+		Reqm = DevHandle->Device->Requirements;
+		while (NULL != Reqm) {
+			if (1U == Reqm->Allocated) {
+				for (Idx = 0U; Idx < NUM_SUBSYSTEMS; Idx++) {
+					if (Reqm->Subsystem == Subsystems[Idx]) {
+						PermissionMask |= ((u32)1U << Idx);
+					}
+				}
+			}
+			Reqm = Reqm->NextSubsystem;
+		}
+		DevHandle = DevHandle->NextDevice;
+	}
+
+	return (u8)((0U != (PermissionMask & ((u32)1U << SubsystemIdx))) &&
+		    (1 == __builtin_popcount(PermissionMask)));
+}
+
+static double Replay(u32 UseReference, u32 *Mismatches)
+{
+	struct timespec Start, End;
+	u32 i;
+	u8 Result;
+
+	ResetAllocation();
+	*Mismatches = 0U;
+	(void)clock_gettime(CLOCK_MONOTONIC, &Start);
+	for (i = 0U; i < NUM_REQUESTS; i++) {
+		if (0U != Trace[i].IsDeviceReq) {
+			XPmRequirement_SetAllocated(Reqms[Trace[i].Index],
+						    Trace[i].Allocated);
+			continue;
+		}
+		if (0U != UseReference) {
+			Result = ReferenceCheck(Trace[i].SubsysIdx,
+						BENCH_CLOCK_ID(Trace[i].Index));
+			if (Result != Granted[i]) {
+				(*Mismatches)++;
+			}
+		} else {
+			Granted[i] = (u8)(XST_SUCCESS ==
+				XPmClock_CheckPermissions(Trace[i].SubsysIdx,
+					BENCH_CLOCK_ID(Trace[i].Index)));
+		}
+	}
+	(void)clock_gettime(CLOCK_MONOTONIC, &End);
+
+	return (((double)(End.tv_sec - Start.tv_sec) * 1e9) +
+		(double)(End.tv_nsec - Start.tv_nsec)) / (double)NUM_REQUESTS;
+}
+
+int main(void)
+{
+	XStatus Status;
+	double MaskNs, WalkNs;
+	u32 Mismatches;
+	u32 i, NumGranted = 0U;
+
+	Status = AddTopology();
+	if (XST_SUCCESS != Status) {
+		printf("Adding the topology failed\r\n");
+		goto done;
+	}
+	GenerateTrace();
+
+	MaskNs = Replay(0U, &Mismatches);
+	WalkNs = Replay(1U, &Mismatches);
+	for (i = 0U; i < NUM_REQUESTS; i++) {
+		NumGranted += Granted[i];
+	}
+
+	printf("%u requests, %u requirements, %u clock requests granted\r\n",
+	       NUM_REQUESTS, NumReqms, NumGranted);
+	printf("subsystem mask: %.1f ns/request, device walk: %.1f ns/request\r\n",
+	       MaskNs, WalkNs);
+	if (0U != Mismatches) {
+		printf("%u permission checks differ\r\n", Mismatches);
+		Status = XST_FAILURE;
+	}
+
+done:
+	if (XST_SUCCESS == Status) {
+		printf("Successfully ran clock permission benchmark\r\n");
+	} else {
+		printf("Clock permission benchmark failed\r\n");
+	}
+	return (XST_SUCCESS == Status) ? 0 : 1;
+}
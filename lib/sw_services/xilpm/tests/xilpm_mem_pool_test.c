@@ -0,0 +1,213 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*
+ *
+ * CONTENT
+ * Churn test of the memory pools of the versal PM server, run on a host.
+ * 1) Devices are allocated from the device pool once, like at boot.
+ * 2) A subsystem is added, requires every device, and requires every device
+ *    again without parameters, like a CDO which is loaded again.
+ * 3) The subsystem is destroyed: its requirements and its object are freed.
+ * 4) Blocks of more sizes than the device pool holds are allocated and freed
+ *    from the generic pool.
+ * Steps 2 to 4 are repeated thousands of times. The test fails if the byte
+ * buffer grows after the first cycle, if an allocation fails, if a
+ * requirement is duplicated or keeps old parameters, or if a pool does not
+ * return to zero bytes in use.
+ *
+ * The requirement code calls into the device code when a requirement is
+ * released. The test devices are not running and have no clocks, so the
+ * device, power and PLL functions of xpm_host_stubs.c are enough.
+ *
+ * The test is built and run on the build machine by the Makefile of this
+ * directory.
+ */
+
+#include <stdio.h>
+#include "xpm_common.h"
+#include "xpm_device.h"
+#include "xpm_requirement.h"
+#include "xpm_subsystem.h"
+
+#define NUM_DEVICES		64U
+#define NUM_CYCLES		10000U
+#define NUM_GENERIC_SIZES	12U
+#define TEST_SUBSYS_ID		0x1C000003U
+#define TEST_FLAGS		0x1U
+
+/* Object sizes allocated from the device pool, like the device classes */
+static const u32 DeviceSizes[] = {
+	sizeof(XPm_Device), sizeof(XPm_Device) + 8U, sizeof(XPm_Device) + 24U,
+};
+
+static XPm_Device *Devices[NUM_DEVICES];
+
+static XStatus AddSubsystem(XPm_Subsystem **SubsystemPtr)
+{
+	XStatus Status = XST_FAILURE;
+	XPm_Subsystem *Subsystem;
+	XPm_Requirement *Reqm;
+	u32 Params[MAX_REQ_PARAMS] = {0x12U};
+	u32 i;
+	u32 Count;
+
+	Subsystem = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_SUBSYSTEM,
+				       sizeof(XPm_Subsystem));
+	if (NULL == Subsystem) {
+		goto done;
+	}
+	Subsystem->Id = TEST_SUBSYS_ID;
+
+	for (i = 0U; i < NUM_DEVICES; i++) {
+		Status = XPmRequirement_Add(Subsystem, Devices[i], TEST_FLAGS,
+					    Params, MAX_REQ_PARAMS);
+		if (XST_SUCCESS != Status) {
+			goto done;
+		}
+		/* Loaded again without parameters */
+		Status = XPmRequirement_Add(Subsystem, Devices[i], TEST_FLAGS,
+					    NULL, 0U);
+		if (XST_SUCCESS != Status) {
+			goto done;
+		}
+	}
+
+	Status = XST_FAILURE;
+	Count = 0U;
+	Reqm = Subsystem->Requirements;
+	while (NULL != Reqm) {
+		if ((0U != Reqm->NumParams) || (0U != Reqm->Params[0])) {
+			printf("Requirement kept old parameters\r\n");
+			goto done;
+		}
+		Count++;
+		Reqm = Reqm->NextDevice;
+	}
+	if (NUM_DEVICES != Count) {
+		printf("%u requirements for %u devices\r\n", Count, NUM_DEVICES);
+		goto done;
+	}
+
+	*SubsystemPtr = Subsystem;
+	Status = XST_SUCCESS;
+
+done:
+	return Status;
+}
+
+static void DestroySubsystem(XPm_Subsystem *Subsystem)
+{
+	while (NULL != Subsystem->Requirements) {
+		XPmRequirement_Free(Subsystem->Requirements);
+	}
+	XPm_FreePoolBytes((u32)XPM_MEM_POOL_SUBSYSTEM, Subsystem,
+			  sizeof(XPm_Subsystem));
+}
+
+static XStatus ChurnGenericSizes(void)
+{
+	XStatus Status = XST_FAILURE;
+	void *Blocks[NUM_GENERIC_SIZES];
+	u32 i;
+
+	for (i = 0U; i < NUM_GENERIC_SIZES; i++) {
+		Blocks[i] = XPm_AllocBytes(16U + (i * 12U));
+		if (NULL == Blocks[i]) {
+			goto done;
+		}
+	}
+	for (i = 0U; i < NUM_GENERIC_SIZES; i++) {
+		XPm_FreePoolBytes((u32)XPM_MEM_POOL_GENERIC, Blocks[i],
+				  16U + (i * 12U));
+	}
+	Status = XST_SUCCESS;
+
+done:
+	return Status;
+}
+
+static XStatus CheckPoolEmpty(u32 PoolId)
+{
+	XStatus Status = XST_FAILURE;
+	u32 Stats[4];
+
+	(void)XPm_GetMemPoolStats(PoolId, Stats);
+	if ((0U != Stats[0]) || (Stats[2] != Stats[3])) {
+		printf("Pool %u: %u bytes in use, %u allocs, %u frees\r\n",
+		       PoolId, Stats[0], Stats[2], Stats[3]);
+		goto done;
+	}
+	Status = XST_SUCCESS;
+
+done:
+	return Status;
+}
+
+int main(void)
+{
+	XStatus Status = XST_FAILURE;
+	XPm_Subsystem *Subsystem = NULL;
+	u32 Stats[4];
+	u32 HighWater = 0U;
+	u32 i;
+
+	for (i = 0U; i < NUM_DEVICES; i++) {
+		Devices[i] = XPm_AllocPoolBytes((u32)XPM_MEM_POOL_DEVICE,
+				DeviceSizes[i % ARRAY_SIZE(DeviceSizes)]);
+		if (NULL == Devices[i]) {
+			goto done;
+		}
+		Devices[i]->Node.Id = 0x18220000U + i;
+	}
+
+	for (i = 0U; i < NUM_CYCLES; i++) {
+		Status = AddSubsystem(&Subsystem);
+		if (XST_SUCCESS != Status) {
+			printf("Adding the subsystem failed in cycle %u\r\n", i);
+			goto done;
+		}
+		DestroySubsystem(Subsystem);
+
+		Status = ChurnGenericSizes();
+		if (XST_SUCCESS != Status) {
+			printf("Generic allocation failed in cycle %u\r\n", i);
+			goto done;
+		}
+
+		(void)XPm_GetMemPoolStats((u32)XPM_MEM_POOL_MAX, Stats);
+		if (0U == i) {
+			HighWater = Stats[1];
+		} else if (Stats[1] != HighWater) {
+			printf("Buffer grew from %u to %u bytes in cycle %u\r\n",
+			       HighWater, Stats[1], i);
+			Status = XST_FAILURE;
+			goto done;
+		}
+	}
+
+	Status = XST_FAILURE;
+	(void)XPm_GetMemPoolStats((u32)XPM_MEM_POOL_MAX, Stats);
+	printf("%u cycles: %u of %u bytes used, %u reusable, %u failed allocations\r\n",
+	       NUM_CYCLES, Stats[1], Stats[0], Stats[2], Stats[3]);
+	if (0U != Stats[3]) {
+		goto done;
+	}
+	if ((XST_SUCCESS != CheckPoolEmpty((u32)XPM_MEM_POOL_SUBSYSTEM)) ||
+	    (XST_SUCCESS != CheckPoolEmpty((u32)XPM_MEM_POOL_REQUIREMENT)) ||
+	    (XST_SUCCESS != CheckPoolEmpty((u32)XPM_MEM_POOL_GENERIC))) {
+		goto done;
+	}
+	Status = XST_SUCCESS;
+
+done:
+	if (XST_SUCCESS == Status) {
+		printf("Successfully ran memory pool churn test\r\n");
+	} else {
+		printf("Memory pool churn test failed\r\n");
+	}
+	return (XST_SUCCESS == Status) ? 0 : 1;
+}
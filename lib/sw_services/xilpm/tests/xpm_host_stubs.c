@@ -0,0 +1,54 @@
+/******************************************************************************
+* Copyright (c) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*
+ * Host implementations of the versal PM server functions which the host tests
+ * of this directory reach but do not build: the devices, power domains and
+ * PLLs of the tests are not running, so requests and releases only report
+ * success and lookups find nothing. They are added to the sources of a test
+ * together with the shared host stubs of the standalone BSP and of xilplmi.
+ */
+
+#include "xpm_device.h"
+#include "xpm_pll.h"
+#include "xpm_power.h"
+
+XStatus XPmDevice_Release(const u32 SubsystemId, const u32 DeviceId)
+{
+	(void)SubsystemId;
+	(void)DeviceId;
+	return XST_SUCCESS;
+}
+
+XStatus XPmDevice_UpdateStatus(XPm_Device *Device)
+{
+	(void)Device;
+	return XST_SUCCESS;
+}
+
+XPm_Device *XPmDevice_GetById(const u32 DeviceId)
+{
+	(void)DeviceId;
+	return NULL;
+}
+
+XPm_Power *XPmPower_GetById(u32 Id)
+{
+	(void)Id;
+	return NULL;
+}
+
+XStatus XPmClockPll_Request(u32 PllId)
+{
+	(void)PllId;
+	return XST_SUCCESS;
+}
+
+XStatus XPmClockPll_Release(u32 PllId)
+{
+	(void)PllId;
+	return XST_SUCCESS;
+}